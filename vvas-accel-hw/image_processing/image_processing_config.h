@@ -62,6 +62,12 @@
 #define HAS_R_G_B8              0
 #define HAS_Y_U_V8_420          1
 
+/* Luma histogram and block means of the input in the scaler pass. The
+ * kernel then reads a statistics buffer address from descriptor word 34 and
+ * writes to it when not 0, so only enable it with a host driver which zeroes
+ * or populates that word in every descriptor. */
+#define HAS_FRAME_STATS         0
+
 /* Memory Ports */
 #define AXIMM_NUM_OUTSTANDING       4
 #define AXIMM_BURST_LENGTH          16
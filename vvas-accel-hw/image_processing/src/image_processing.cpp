@@ -59,6 +59,9 @@ static void v_scaler_top(
 #endif
 #if (NORMALIZATION == 1)
 		int params[2 * 3],
+#endif
+#if (HAS_FRAME_STATS == 1)
+		U32 frameStats[FRAME_STATS_WORDS],
 #endif
 		HSC_PHASE_CTRL blkmm_phasesH[HSC_MAX_WIDTH / HSC_SAMPLES_PER_CLOCK]);
 
@@ -268,6 +271,9 @@ static void GetMultiScAndCoeff(HSC_HW_STRUCT_REG &HwReg, V_SCALER_TOP_STRUCT &Mu
 	Multi_Sc.params_beta_2 = U32_VALUE_FROM_AXIMM_ARRAY(31);
 #endif
 	Multi_Sc.msc_nxtaddr = U64_VALUE_FROM_AXIMM_ARRAY(32);
+#if (HAS_FRAME_STATS == 1)
+	Multi_Sc.msc_statsBuf = U64_VALUE_FROM_AXIMM_ARRAY(34);
+#endif
 #if (NORMALIZATION==1)
 	params[0] = Multi_Sc.params_alpha_0;
 	params[1] = Multi_Sc.params_alpha_1;
@@ -314,6 +320,29 @@ static void GetMultiScAndCoeff(HSC_HW_STRUCT_REG &HwReg, V_SCALER_TOP_STRUCT &Mu
 #endif
 }
 
+#if (HAS_FRAME_STATS == 1)
+/*********************************************************************************
+ * Function:    WriteFrameStats
+ * Parameters:  Output memory port, buffer address, statistics of v_frame_stats
+ * Return:
+ * Description: Writes the statistics of one frame as little endian 32 bit words
+ **********************************************************************************/
+static void WriteFrameStats(AXIMM dstbuf, U64 statsBuf, U32 frameStats[FRAME_STATS_WORDS])
+{
+	U64 writeOffset = statsBuf / AXIMM_DATA_WIDTH8;
+	ap_uint<AXIMM_DATA_WIDTH> aximmTemp;
+	U32 i, j;
+
+	for (i = 0; i < FRAME_STATS_WORDS / (AXIMM_DATA_WIDTH8 / 4); i++)
+	{
+#pragma HLS PIPELINE
+		for (j = 0; j < (AXIMM_DATA_WIDTH8 / 4); j++)
+			aximmTemp(j * 32 + 31, j * 32) = frameStats[i * (AXIMM_DATA_WIDTH8 / 4) + j];
+		dstbuf[writeOffset + i] = aximmTemp;
+	}
+}
+#endif
+
 /*********************************************************************************
  * Function:    hscale_top
  * Parameters:  Stream of input/output pixels, image resolution, type of scaling etc
@@ -404,6 +433,9 @@ void image_processing(U8 num_outs, U64 start_addr, AXIMM ms_maxi_srcbuf,
 #pragma HLS ARRAY_PARTITION variable=vfltCoeff complete dim=2
 
 	HSC_PHASE_CTRL blkmm_phasesH[HSC_MAX_WIDTH / HSC_SAMPLES_PER_CLOCK];
+#if (HAS_FRAME_STATS == 1)
+	U32 frameStats[FRAME_STATS_WORDS];
+#endif
 	ap_uint<1> done_flag;
 	U8 stats = 0;
 	U8 dummy = 0;
@@ -687,8 +719,16 @@ void image_processing(U8 num_outs, U64 start_addr, AXIMM ms_maxi_srcbuf,
 #endif
 #if(NORMALIZATION == 1)
 				params,
+#endif
+#if (HAS_FRAME_STATS == 1)
+				frameStats,
 #endif
 				blkmm_phasesH);
+#if (HAS_FRAME_STATS == 1)
+		/* Statistics are only written for descriptors asking for them */
+		if (Multi_Sc.msc_statsBuf != 0)
+			WriteFrameStats(HwReg.ms_maxi_dstbuf, Multi_Sc.msc_statsBuf, frameStats);
+#endif
 #if DEBUG
 		Multi_Sc.debug_var[17] = DEBUG_OUTSIDE_DATAFLOW
 				//unused or disabled debug vars
@@ -748,6 +788,9 @@ static void v_scaler_top(
 #endif
 #if (NORMALIZATION == 1)
 		int params[2 * 3],
+#endif
+#if (HAS_FRAME_STATS == 1)
+		U32 frameStats[FRAME_STATS_WORDS],
 #endif
 		HSC_PHASE_CTRL blkmm_phasesH[HSC_MAX_WIDTH / HSC_SAMPLES_PER_CLOCK])
 {
@@ -801,6 +844,9 @@ static void v_scaler_top(
 #endif
 
 	HSC_STREAM_MULTIPIX stream_in;
+#if (HAS_FRAME_STATS == 1)
+	HSC_STREAM_MULTIPIX stream_stats;
+#endif
 	HSC_STREAM_MULTIPIX stream_1;
 	HSC_STREAM_MULTIPIX stream_2;
 	HSC_STREAM_MULTIPIX stream_3;
@@ -815,6 +861,9 @@ static void v_scaler_top(
 #pragma HLS DATAFLOW
 
 #pragma HLS stream depth=16 variable=stream_in
+#if (HAS_FRAME_STATS == 1)
+#pragma HLS stream depth=16 variable=stream_stats
+#endif
 #pragma HLS stream depth=16 variable=stream_1
 #pragma HLS stream depth=16 variable=stream_2
 #pragma HLS stream depth=4096 variable=stream_3
@@ -896,7 +945,13 @@ static void v_scaler_top(
 
 #endif
 
+#if (HAS_FRAME_STATS == 1)
+	v_frame_stats(stream_in, HeightIn, WidthIn, ColorModeIn, stream_stats, frameStats);
+
+	v_vcresampler(stream_stats, HeightIn, WidthIn, yuv420, bPassThruVcrUp, stream_1);
+#else
 	v_vcresampler(stream_in, HeightIn, WidthIn, yuv420, bPassThruVcrUp, stream_1);
+#endif
 
 	v_hcresampler(stream_1, HeightIn, WidthIn, yuv422, bPassThruHcrUp, stream_2);
 
@@ -77,6 +77,15 @@
 #define AXIMM_DATA_WIDTH            (HSC_SAMPLES_PER_CLOCK*64)
 #define AXIMM_DATA_WIDTH8           (AXIMM_DATA_WIDTH/8)
 
+/* Frame statistics of the input, luma histogram and block luma sums */
+#ifndef HAS_FRAME_STATS
+#define HAS_FRAME_STATS             0
+#endif
+#include "v_frame_stats.h"
+#if ((HAS_FRAME_STATS == 1) && (OUTPUT_INTERFACE != AXIMM_INTERFACE))
+#error "Frame statistics are written through the output memory port"
+#endif
+
 /* Planes configuration */
 #define PLANE0_STREAM_DEPTH    	(((HSC_MAX_WIDTH/2)+AXIMM_DATA_WIDTH8-1)/AXIMM_DATA_WIDTH8)
 
@@ -368,8 +377,15 @@ typedef struct
 	int params_beta_2;
 #endif
 	U64 msc_nxtaddr;
+#if (HAS_FRAME_STATS == 1)
+	U64 msc_statsBuf; // first reserved word, 0 when no statistics are wanted
+#endif
 #if DEBUG
+#if (HAS_FRAME_STATS == 1)
+	U64 reserved[1];
+#else
 	U64 reserved[2];
+#endif
 	U32 debug_var[DEBUG_VARS];
 #endif
 } V_SCALER_TOP_STRUCT;
@@ -457,6 +473,12 @@ void v_vscaler(HSC_STREAM_MULTIPIX &stream_in, U16 HeightIn, U16 WidthIn, U16 He
 void v_csc(HSC_STREAM_MULTIPIX &srcImg, U16 height, U16 width, U8 colorMode, bool bPassThru,
 		HSC_STREAM_MULTIPIX &outImg);
 
+#if (HAS_FRAME_STATS == 1)
+// top level function for frame statistics, passes the input through
+void v_frame_stats(HSC_STREAM_MULTIPIX &srcImg, U16 height, U16 width, U8 colorMode,
+		HSC_STREAM_MULTIPIX &outImg, U32 stats[FRAME_STATS_WORDS]);
+#endif
+
 // top level function for HW synthesis
 extern void image_processing(U8 num_outs, U64 start_addr, AXIMM ms_maxi_srcbuf,
 #if(INPUT_INTERFACE == AXI_STREAM_INTERFACE)
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __SYNTHESIS__
+#include <stdio.h>
+#endif
+#include <assert.h>
+#include "image_processing.h"
+
+#if (HAS_FRAME_STATS == 1)
+
+#define STATS_SHIFT             (HSC_BITS_PER_COMPONENT - 8)
+
+const U8 stats_rgb = 0;
+
+/*
+ * Computes the luma histogram and the luma sums of FRAME_STATS_BLOCKS_X x
+ * FRAME_STATS_BLOCKS_Y blocks of the input while passing it to the scaler.
+ * Luma is reduced to 8 bits. Column x belongs to block (x * BLOCKS_X) / width,
+ * line y to block (y * BLOCKS_Y) / height. Layout of stats:
+ *   [0, FRAME_STATS_BINS)                 histogram
+ *   [FRAME_STATS_BINS, FRAME_STATS_WORDS) block sums, row major
+ * Per sample steps are in v_frame_stats.h, shared with the host checks.
+ */
+void v_frame_stats(
+	HSC_STREAM_MULTIPIX& srcImg,
+	U16 height,
+	U16 width,
+	U8 colorMode,
+	HSC_STREAM_MULTIPIX& outImg,
+	U32 stats[FRAME_STATS_WORDS])
+{
+	// One histogram bank per sample, merged at the end of the frame
+	U32 hist[HSC_SAMPLES_PER_CLOCK][FRAME_STATS_BINS];
+#pragma HLS ARRAY_PARTITION variable=hist dim=1 complete
+	U32 blockSum[FRAME_STATS_BLOCKS_Y][FRAME_STATS_BLOCKS_X];
+#pragma HLS ARRAY_PARTITION variable=blockSum dim=2 complete
+	U32 lineSum[FRAME_STATS_BLOCKS_X];
+#pragma HLS ARRAY_PARTITION variable=lineSum complete
+	U8 lastBin[HSC_SAMPLES_PER_CLOCK][FRAME_STATS_NUM_STATES];
+#pragma HLS ARRAY_PARTITION variable=lastBin complete dim=0
+	U32 lastCnt[HSC_SAMPLES_PER_CLOCK][FRAME_STATS_NUM_STATES];
+#pragma HLS ARRAY_PARTITION variable=lastCnt complete dim=0
+
+	YUV_MULTI_PIXEL pix;
+	U16 y, x, i, k;
+	U8 by, bx;
+	U32 lineEdge, colEdge;
+
+	assert(width <= HSC_MAX_WIDTH);
+	assert(height <= HSC_MAX_HEIGHT);
+
+	for (i = 0; i < FRAME_STATS_BINS; ++i)
+	{
+#pragma HLS PIPELINE
+		for (k = 0; k < HSC_SAMPLES_PER_CLOCK; ++k)
+			hist[k][i] = 0;
+	}
+	for (i = 0; i < FRAME_STATS_BLOCKS_Y; ++i)
+	{
+#pragma HLS PIPELINE
+		for (k = 0; k < FRAME_STATS_BLOCKS_X; ++k)
+			blockSum[i][k] = 0;
+	}
+	for (k = 0; k < HSC_SAMPLES_PER_CLOCK; ++k)
+	{
+#pragma HLS UNROLL
+		frame_stats_window_init(lastBin[k], lastCnt[k]);
+	}
+
+	by = 0;
+	lineEdge = height;
+	for (y = 0; y < height; ++y)
+	{
+		frame_stats_block_step(y, FRAME_STATS_BLOCKS_Y, height, &lineEdge, &by);
+		for (k = 0; k < FRAME_STATS_BLOCKS_X; ++k)
+		{
+#pragma HLS UNROLL
+			lineSum[k] = 0;
+		}
+
+		bx = 0;
+		colEdge = width;
+		for (x = 0; x < (width) / HSC_SAMPLES_PER_CLOCK; ++x)
+		{
+#pragma HLS LOOP_FLATTEN OFF
+#pragma HLS PIPELINE
+#pragma HLS DEPENDENCE variable=hist inter false
+			srcImg >> pix;
+
+			for (k = 0; k < HSC_SAMPLES_PER_CLOCK; ++k)
+			{
+				U32 col = (U32) x * HSC_SAMPLES_PER_CLOCK + k;
+				U32 bin;
+
+				bin = frame_stats_bin(colorMode == stats_rgb,
+						pix.val[k*HSC_NR_COMPONENTS + 0],
+						pix.val[k*HSC_NR_COMPONENTS + 1],
+						pix.val[k*HSC_NR_COMPONENTS + 2], STATS_SHIFT);
+
+				// blocks are at least 8 columns wide, one edge per clock at most
+				frame_stats_block_step(col, FRAME_STATS_BLOCKS_X, width, &colEdge, &bx);
+				lineSum[bx] += bin;
+
+				frame_stats_count(hist[k], lastBin[k], lastCnt[k], bin);
+			}
+			outImg << pix;
+		}
+
+		for (k = 0; k < FRAME_STATS_BLOCKS_X; ++k)
+		{
+#pragma HLS UNROLL
+			blockSum[by][k] += lineSum[k];
+		}
+	}
+
+	for (i = 0; i < FRAME_STATS_BINS; ++i)
+	{
+#pragma HLS PIPELINE
+		U32 sum = 0;
+
+		for (k = 0; k < HSC_SAMPLES_PER_CLOCK; ++k)
+			sum += hist[k][i];
+		stats[i] = sum;
+	}
+	for (i = 0; i < FRAME_STATS_BLOCKS_Y; ++i)
+	{
+		for (k = 0; k < FRAME_STATS_BLOCKS_X; ++k)
+		{
+#pragma HLS PIPELINE
+			stats[FRAME_STATS_BINS + i * FRAME_STATS_BLOCKS_X + k] = blockSum[i][k];
+		}
+	}
+}
+#endif
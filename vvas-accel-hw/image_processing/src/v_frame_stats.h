@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Per sample steps of v_frame_stats(). Plain C without HLS types, so that
+ * host side checks run the very code the kernel is synthesized from.
+ */
+
+#ifndef _V_FRAME_STATS_H_
+#define _V_FRAME_STATS_H_
+
+/* Frame statistics of the input, luma histogram and block luma sums */
+#define FRAME_STATS_BINS            256
+#define FRAME_STATS_BLOCKS_X        8
+#define FRAME_STATS_BLOCKS_Y        8
+#define FRAME_STATS_WORDS           (FRAME_STATS_BINS + FRAME_STATS_BLOCKS_X * FRAME_STATS_BLOCKS_Y)
+// Histogram updates in flight, same scheme as hls::Equalize
+#define FRAME_STATS_NUM_STATES      2
+
+#ifdef __SYNTHESIS__
+#define FRAME_STATS_INLINE          _Pragma("HLS INLINE")
+#else
+#define FRAME_STATS_INLINE
+#endif
+
+/*
+ * Histogram bin of one sample. RGB uses the same weights as v_csc, luma is
+ * reduced to 8 bits by shift.
+ */
+static inline unsigned int frame_stats_bin(unsigned char rgb, unsigned int c0,
+		unsigned int c1, unsigned int c2, unsigned int shift)
+{
+FRAME_STATS_INLINE
+	unsigned int luma = c0;
+
+	if (rgb)
+		luma = (306 * c0 + 601 * c1 + 117 * c2) >> 10;
+
+	return luma >> shift;
+}
+
+/*
+ * Moves *index to the next of blocks blocks when pos reaches its first
+ * column or line. *edge starts at size and *index at 0.
+ */
+static inline void frame_stats_block_step(unsigned int pos, unsigned int blocks,
+		unsigned int size, unsigned int *edge, unsigned char *index)
+{
+FRAME_STATS_INLINE
+	if (pos * blocks >= *edge)
+	{
+		(*index)++;
+		*edge += size;
+	}
+}
+
+/*
+ * Sets the update window of one histogram bank to distinct bins, so that a
+ * hit always returns the latest count.
+ */
+static inline void frame_stats_window_init(unsigned char lastBin[FRAME_STATS_NUM_STATES],
+		unsigned int lastCnt[FRAME_STATS_NUM_STATES])
+{
+FRAME_STATS_INLINE
+	unsigned int m;
+
+	for (m = 0; m < FRAME_STATS_NUM_STATES; ++m)
+	{
+		lastBin[m] = m;
+		lastCnt[m] = 0;
+	}
+}
+
+/*
+ * Counts bin in one histogram bank. Counts of the last updates are taken
+ * from the window, newest entry first, as the bank may not have them yet.
+ */
+static inline void frame_stats_count(unsigned int hist[FRAME_STATS_BINS],
+		unsigned char lastBin[FRAME_STATS_NUM_STATES],
+		unsigned int lastCnt[FRAME_STATS_NUM_STATES], unsigned int bin)
+{
+FRAME_STATS_INLINE
+	unsigned int cnt = hist[bin];
+	unsigned int m;
+
+	for (m = 0; m < FRAME_STATS_NUM_STATES; ++m)
+	{
+		if (bin == lastBin[m])
+		{
+			cnt = lastCnt[m];
+			break;
+		}
+	}
+	cnt++;
+	hist[bin] = cnt;
+
+	for (m = FRAME_STATS_NUM_STATES - 1; m > 0; --m)
+	{
+		lastBin[m] = lastBin[m - 1];
+		lastCnt[m] = lastCnt[m - 1];
+	}
+	lastBin[0] = bin;
+	lastCnt[0] = cnt;
+}
+
+#endif
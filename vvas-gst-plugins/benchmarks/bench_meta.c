@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * Benchmark cases for metadata consuming elements: vvas_xmetaaffixer and
+ * vvas_xtracker.
+ */
+
+#include "vvas_bench.h"
+
+/**
+ *  @fn static gboolean bench_metaaffixer_setup (VvasBench * bench)
+ *  @param [in] bench - Running benchmark
+ *  @return TRUE on success
+ *  @brief  First stream is master, all others are slaves carrying inference
+ *          metadata
+ */
+static gboolean
+bench_metaaffixer_setup (VvasBench * bench)
+{
+  guint s;
+
+  bench->num_streams = MAX (2, bench->num_streams);
+  bench->expected = (guint64) bench->num_streams * bench->config->num_buffers;
+
+  vvas_bench_add_input (bench, "sink_master", "src_master");
+  for (s = 1; s < bench->num_streams; s++) {
+    gchar *sinkpad = g_strdup_printf ("sink_slave_%u", s - 1);
+    gchar *srcpad = g_strdup_printf ("src_slave_%u", s - 1);
+
+    vvas_bench_add_input (bench, sinkpad, srcpad);
+    g_free (sinkpad);
+    g_free (srcpad);
+  }
+
+  return TRUE;
+}
+
+/**
+ *  @fn static gboolean bench_tracker_setup (VvasBench * bench)
+ *  @param [in] bench - Running benchmark
+ *  @return TRUE on success
+ *  @brief  Muxed streams with moving detections on single sink pad
+ */
+static gboolean
+bench_tracker_setup (VvasBench * bench)
+{
+  vvas_bench_add_input (bench, "sink", "src");
+
+  return TRUE;
+}
+
+/** @brief Metadata consuming benchmark cases */
+const VvasBenchCase vvas_bench_meta_cases[] = {
+  {"metaaffixer", "vvas_xmetaaffixer", VVAS_BENCH_META_INFER, TRUE, NULL,
+      bench_metaaffixer_setup},
+  {"tracker", "vvas_xtracker",
+        VVAS_BENCH_META_SRCID | VVAS_BENCH_META_INFER, TRUE, NULL,
+      bench_tracker_setup},
+  {"tracker-workers", "vvas_xtracker",
+        VVAS_BENCH_META_SRCID | VVAS_BENCH_META_INFER, TRUE, "num-workers=4",
+      bench_tracker_setup},
+  {NULL}
+};
@@ -0,0 +1,652 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * Micro benchmarks of gst_inference_prediction_merge() and
+ * gst_inference_prediction_scale_batch(). Synthetic prediction trees are
+ * merged with the library implementation and with a reference copy of the
+ * previous algorithm, which searched the whole destination tree for every
+ * source child and appended classifications one by one. They are scaled to
+ * several renditions in one batch and with one
+ * gst_inference_prediction_scale() call per rendition, both must give the
+ * same boxes.
+ */
+
+#include <stdio.h>
+#include <gst/gst.h>
+#include <gst/vvas/gstinferenceprediction.h>
+
+/* Children per prediction of the synthetic trees */
+#define BENCH_FANOUT 8
+/* Classifications per prediction of the synthetic trees */
+#define BENCH_CLASSES 4
+/* Number of tree nodes visited per size, sets the iteration count */
+#define BENCH_WORK 200000
+/* Number of renditions predictions are scaled to */
+#define BENCH_RENDITIONS 4
+
+typedef struct
+{
+  GstInferencePrediction *prediction;
+  guint64 prediction_id;
+} RefFindData;
+
+/**
+ *  @fn static gboolean ref_node_find (VvasTreeNode * node, gpointer data)
+ *  @param [in] node - Tree node being visited
+ *  @param [inout] data - RefFindData with the id to search
+ *  @return TRUE to stop the traversal once found
+ *  @brief  Reference full tree search of the previous merge implementation
+ */
+static gboolean
+ref_node_find (VvasTreeNode * node, gpointer data)
+{
+  RefFindData *found = (RefFindData *) data;
+  GstInferencePrediction *current = (GstInferencePrediction *) node->data;
+
+  if (current->prediction.prediction_id == found->prediction_id) {
+    found->prediction = current;
+    return TRUE;
+  }
+
+  return FALSE;
+}
+
+/**
+ *  @fn static gint ref_classification_compare (gconstpointer a,
+ *                                              gconstpointer b)
+ *  @param [in] a - First classification
+ *  @param [in] b - Second classification
+ *  @return 0 when both have the same classification id
+ *  @brief  Reference classification comparison
+ */
+static gint
+ref_classification_compare (gconstpointer a, gconstpointer b)
+{
+  GstInferenceClassification *ca = (GstInferenceClassification *) a;
+  GstInferenceClassification *cb = (GstInferenceClassification *) b;
+
+  return ca->classification.classification_id ==
+      cb->classification.classification_id ? 0 : 1;
+}
+
+/**
+ *  @fn static gboolean ref_prediction_merge (GstInferencePrediction * src,
+ *                                            GstInferencePrediction * dst)
+ *  @param [in] src - Prediction to merge from
+ *  @param [inout] dst - Prediction to merge into
+ *  @return TRUE if new predictions were added to dst
+ *  @brief  Reference copy of the previous merge algorithm
+ */
+static gboolean
+ref_prediction_merge (GstInferencePrediction * src, GstInferencePrediction * dst)
+{
+  GSList *src_children = gst_inference_prediction_get_children (src);
+  GSList *new_children = NULL;
+  GList **classes = (GList **) & dst->prediction.classifications;
+  GList *citer;
+  GSList *iter;
+  gboolean new_added = FALSE;
+
+  for (citer = (GList *) src->prediction.classifications; citer;
+      citer = g_list_next (citer)) {
+    if (!g_list_find_custom (*classes, citer->data,
+            ref_classification_compare))
+      *classes = g_list_append (*classes,
+          gst_inference_classification_copy (citer->data));
+  }
+
+  for (iter = src_children; iter; iter = g_slist_next (iter)) {
+    GstInferencePrediction *current = (GstInferencePrediction *) iter->data;
+    RefFindData found = { NULL, current->prediction.prediction_id };
+
+    vvas_treenode_traverse (dst->prediction.node, IN_ORDER, TRAVERSE_ALL, -1,
+        (vvas_treenode_traverse_func) ref_node_find, &found);
+
+    if (!found.prediction) {
+      new_children = g_slist_append (new_children, current);
+      continue;
+    }
+
+    new_added |= ref_prediction_merge (current, found.prediction);
+  }
+
+  for (iter = new_children; iter; iter = g_slist_next (iter))
+    gst_inference_prediction_append (dst,
+        gst_inference_prediction_copy (iter->data));
+
+  new_added |= new_children ? TRUE : FALSE;
+
+  g_slist_free (src_children);
+  g_slist_free (new_children);
+
+  return new_added;
+}
+
+/**
+ *  @fn static void bench_add_classes (GstInferencePrediction * pred,
+ *                                     guint num)
+ *  @param [inout] pred - Prediction to add classifications to
+ *  @param [in] num - Number of classifications to add
+ *  @return None
+ *  @brief  Appends num new classifications to pred
+ */
+static void
+bench_add_classes (GstInferencePrediction * pred, guint num)
+{
+  guint c;
+
+  for (c = 0; c < num; c++) {
+    GstInferenceClassification *cls =
+        gst_inference_classification_new_full (c, 0.5, NULL, 0, NULL, NULL,
+        NULL);
+
+    gst_inference_prediction_append_classification (pred, cls);
+  }
+}
+
+/**
+ *  @fn static GstInferencePrediction * bench_build_tree (guint num_nodes)
+ *  @param [in] num_nodes - Number of predictions in the tree
+ *  @return Root of the tree
+ *  @brief  Builds a tree filled breadth first with BENCH_FANOUT children per
+ *          prediction and BENCH_CLASSES classifications each
+ */
+static GstInferencePrediction *
+bench_build_tree (guint num_nodes)
+{
+  GstInferencePrediction **nodes = g_new0 (GstInferencePrediction *, num_nodes);
+  GstInferencePrediction *root;
+  guint n;
+
+  for (n = 0; n < num_nodes; n++) {
+    nodes[n] = gst_inference_prediction_new ();
+    bench_add_classes (nodes[n], BENCH_CLASSES);
+    if (n)
+      gst_inference_prediction_append (nodes[(n - 1) / BENCH_FANOUT],
+          nodes[n]);
+  }
+
+  root = nodes[0];
+  g_free (nodes);
+
+  return root;
+}
+
+/**
+ *  @fn static gboolean bench_node_collect (VvasTreeNode * node, gpointer data)
+ *  @param [in] node - Tree node being visited
+ *  @param [inout] data - GSList of predictions visited
+ *  @return FALSE to visit every node
+ *  @brief  Collects every prediction of a tree
+ */
+static gboolean
+bench_node_collect (VvasTreeNode * node, gpointer data)
+{
+  GSList **list = (GSList **) data;
+
+  *list = g_slist_prepend (*list, node->data);
+
+  return FALSE;
+}
+
+/**
+ *  @fn static guint bench_count (GstInferencePrediction * root,
+ *                                guint * num_classes)
+ *  @param [in] root - Root of the tree
+ *  @param [out] num_classes - Number of classifications in the tree
+ *  @return Number of predictions in the tree
+ *  @brief  Counts predictions and classifications to compare merge results
+ */
+static guint
+bench_count (GstInferencePrediction * root, guint * num_classes)
+{
+  GSList *all = NULL, *iter;
+  guint count = 0;
+
+  vvas_treenode_traverse (root->prediction.node, IN_ORDER, TRAVERSE_ALL, -1,
+      (vvas_treenode_traverse_func) bench_node_collect, &all);
+
+  *num_classes = 0;
+  for (iter = all; iter; iter = g_slist_next (iter)) {
+    GstInferencePrediction *pred = (GstInferencePrediction *) iter->data;
+
+    *num_classes += g_list_length ((GList *) pred->prediction.classifications);
+    count++;
+  }
+  g_slist_free (all);
+
+  return count;
+}
+
+/**
+ *  @fn static GstInferencePrediction * bench_build_src (
+ *                                        GstInferencePrediction * dst)
+ *  @param [in] dst - Tree the source is derived from
+ *  @return Source tree to merge into copies of dst
+ *  @brief  Copies dst, adds a new class to every prediction and a new child
+ *          to every tenth one, like a second inference stage would
+ */
+static GstInferencePrediction *
+bench_build_src (GstInferencePrediction * dst)
+{
+  GstInferencePrediction *src = gst_inference_prediction_copy (dst);
+  GSList *all = NULL, *iter;
+  guint n = 0;
+
+  vvas_treenode_traverse (src->prediction.node, IN_ORDER, TRAVERSE_ALL, -1,
+      (vvas_treenode_traverse_func) bench_node_collect, &all);
+
+  for (iter = all; iter; iter = g_slist_next (iter), n++) {
+    GstInferencePrediction *pred = (GstInferencePrediction *) iter->data;
+
+    bench_add_classes (pred, 1);
+    if (n % 10 == 0) {
+      GstInferencePrediction *child = gst_inference_prediction_new ();
+
+      bench_add_classes (child, BENCH_CLASSES);
+      gst_inference_prediction_append (pred, child);
+    }
+  }
+  g_slist_free (all);
+
+  return src;
+}
+
+/**
+ *  @fn static gboolean bench_merge (guint num_nodes, FILE * out)
+ *  @param [in] num_nodes - Number of predictions of the destination tree
+ *  @param [in] out - File the JSON result is written to
+ *  @return TRUE when both implementations produced the same tree
+ *  @brief  Times merging a source tree into fresh copies of a destination
+ *          tree. Only the merge itself is timed.
+ */
+static gboolean
+bench_merge (guint num_nodes, FILE * out)
+{
+  GstInferencePrediction *dst = bench_build_tree (num_nodes);
+  GstInferencePrediction *src = bench_build_src (dst);
+  guint iterations = MAX (5, BENCH_WORK / num_nodes);
+  guint old_nodes = 0, new_nodes = 0, old_classes = 0, new_classes = 0, i;
+  gint64 old_us = 0, new_us = 0;
+
+  for (i = 0; i < iterations; i++) {
+    GstInferencePrediction *copy = gst_inference_prediction_copy (dst);
+    gint64 start = g_get_monotonic_time ();
+
+    ref_prediction_merge (src, copy);
+    old_us += g_get_monotonic_time () - start;
+    if (!i)
+      old_nodes = bench_count (copy, &old_classes);
+    gst_inference_prediction_unref (copy);
+
+    copy = gst_inference_prediction_copy (dst);
+    start = g_get_monotonic_time ();
+    gst_inference_prediction_merge (src, copy);
+    new_us += g_get_monotonic_time () - start;
+    if (!i)
+      new_nodes = bench_count (copy, &new_classes);
+    gst_inference_prediction_unref (copy);
+  }
+
+  fprintf (out, "{\"benchmark\": \"prediction-merge\", \"nodes\": %u, "
+      "\"iterations\": %u, \"merged_nodes\": %u, \"merged_classes\": %u, "
+      "\"old_us\": %.2f, \"new_us\": %.2f, \"speedup\": %.2f}\n", num_nodes,
+      iterations, new_nodes, new_classes, (gdouble) old_us / iterations,
+      (gdouble) new_us / iterations,
+      new_us ? (gdouble) old_us / new_us : 0.0);
+
+  gst_inference_prediction_unref (src);
+  gst_inference_prediction_unref (dst);
+
+  if (old_nodes != new_nodes || old_classes != new_classes) {
+    g_printerr ("prediction-merge: %u nodes, results differ (%u/%u nodes, "
+        "%u/%u classes)\n", num_nodes, old_nodes, new_nodes, old_classes,
+        new_classes);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ *  @fn static void bench_set_boxes (GstInferencePrediction * root,
+ *                                   guint width, guint height)
+ *  @param [inout] root - Root of the tree
+ *  @param [in] width - Width of the frame of the tree
+ *  @param [in] height - Height of the frame of the tree
+ *  @return None
+ *  @brief  Gives every prediction of a tree a random box inside the frame
+ */
+static void
+bench_set_boxes (GstInferencePrediction * root, guint width, guint height)
+{
+  GRand *rand = g_rand_new_with_seed (width * height);
+  GSList *all = NULL, *iter;
+
+  vvas_treenode_traverse (root->prediction.node, IN_ORDER, TRAVERSE_ALL, -1,
+      (vvas_treenode_traverse_func) bench_node_collect, &all);
+
+  for (iter = all; iter; iter = g_slist_next (iter)) {
+    GstInferencePrediction *pred = (GstInferencePrediction *) iter->data;
+
+    pred->prediction.bbox.x = g_rand_int_range (rand, 0, width - 1);
+    pred->prediction.bbox.y = g_rand_int_range (rand, 0, height - 1);
+    pred->prediction.bbox.width =
+        g_rand_int_range (rand, 1, width - pred->prediction.bbox.x + 1);
+    pred->prediction.bbox.height =
+        g_rand_int_range (rand, 1, height - pred->prediction.bbox.y + 1);
+  }
+  g_slist_free (all);
+  g_rand_free (rand);
+}
+
+/**
+ *  @fn static gboolean bench_same_boxes (GstInferencePrediction * a,
+ *                                        GstInferencePrediction * b)
+ *  @param [in] a - Root of the first tree
+ *  @param [in] b - Root of the second tree
+ *  @return TRUE when both trees have the same shape and boxes
+ *  @brief  Compares the boxes of two scaled trees node by node
+ */
+static gboolean
+bench_same_boxes (GstInferencePrediction * a, GstInferencePrediction * b)
+{
+  GSList *all_a = NULL, *all_b = NULL, *ia, *ib;
+  gboolean same = TRUE;
+
+  vvas_treenode_traverse (a->prediction.node, IN_ORDER, TRAVERSE_ALL, -1,
+      (vvas_treenode_traverse_func) bench_node_collect, &all_a);
+  vvas_treenode_traverse (b->prediction.node, IN_ORDER, TRAVERSE_ALL, -1,
+      (vvas_treenode_traverse_func) bench_node_collect, &all_b);
+
+  for (ia = all_a, ib = all_b; ia && ib && same;
+      ia = g_slist_next (ia), ib = g_slist_next (ib)) {
+    GstInferencePrediction *pa = (GstInferencePrediction *) ia->data;
+    GstInferencePrediction *pb = (GstInferencePrediction *) ib->data;
+
+    same = pa->prediction.bbox.x == pb->prediction.bbox.x &&
+        pa->prediction.bbox.y == pb->prediction.bbox.y &&
+        pa->prediction.bbox.width == pb->prediction.bbox.width &&
+        pa->prediction.bbox.height == pb->prediction.bbox.height;
+  }
+  same &= !ia && !ib;
+
+  g_slist_free (all_a);
+  g_slist_free (all_b);
+
+  return same;
+}
+
+/**
+ *  @fn static gboolean bench_scale (guint num_nodes, FILE * out)
+ *  @param [in] num_nodes - Number of predictions of the tree
+ *  @param [in] out - File the JSON result is written to
+ *  @return TRUE when both paths produced the same boxes
+ *  @brief  Times scaling a 1080p tree to BENCH_RENDITIONS renditions, with
+ *          one gst_inference_prediction_scale() per rendition and with
+ *          gst_inference_prediction_scale_batch(), like vvas_xabrscaler
+ */
+static gboolean
+bench_scale (guint num_nodes, FILE * out)
+{
+  const guint sizes[BENCH_RENDITIONS][2] = {
+    {1280, 720}, {854, 480}, {640, 360}, {426, 240}
+  };
+  GstInferencePrediction *root = bench_build_tree (num_nodes);
+  GstInferencePrediction *single[BENCH_RENDITIONS];
+  GstInferencePrediction *batch[BENCH_RENDITIONS];
+  GstVideoInfo from, to[BENCH_RENDITIONS];
+  GstVideoInfo *to_ptrs[BENCH_RENDITIONS];
+  guint iterations = MAX (5, BENCH_WORK / num_nodes);
+  gint64 single_us = 0, batch_us = 0;
+  gboolean same = TRUE;
+  guint i, r;
+
+  gst_video_info_set_format (&from, GST_VIDEO_FORMAT_NV12, 1920, 1080);
+  for (r = 0; r < BENCH_RENDITIONS; r++) {
+    gst_video_info_set_format (&to[r], GST_VIDEO_FORMAT_NV12, sizes[r][0],
+        sizes[r][1]);
+    to_ptrs[r] = &to[r];
+  }
+  bench_set_boxes (root, 1920, 1080);
+
+  for (i = 0; i < iterations; i++) {
+    gint64 start = g_get_monotonic_time ();
+
+    for (r = 0; r < BENCH_RENDITIONS; r++)
+      single[r] = gst_inference_prediction_scale (root, &to[r], &from);
+    single_us += g_get_monotonic_time () - start;
+
+    start = g_get_monotonic_time ();
+    gst_inference_prediction_scale_batch (root, &from, to_ptrs,
+        BENCH_RENDITIONS, batch);
+    batch_us += g_get_monotonic_time () - start;
+
+    for (r = 0; r < BENCH_RENDITIONS; r++) {
+      if (!i)
+        same &= bench_same_boxes (single[r], batch[r]);
+      gst_inference_prediction_unref (single[r]);
+      gst_inference_prediction_unref (batch[r]);
+    }
+  }
+
+  fprintf (out, "{\"benchmark\": \"prediction-scale\", \"nodes\": %u, "
+      "\"renditions\": %u, \"iterations\": %u, \"same_boxes\": %s, "
+      "\"single_us\": %.2f, \"batch_us\": %.2f, \"speedup\": %.2f}\n",
+      num_nodes, BENCH_RENDITIONS, iterations, same ? "true" : "false",
+      (gdouble) single_us / iterations, (gdouble) batch_us / iterations,
+      batch_us ? (gdouble) single_us / batch_us : 0.0);
+
+  gst_inference_prediction_unref (root);
+
+  if (!same)
+    g_printerr ("prediction-scale: %u nodes, batch and single scaling give "
+        "different boxes\n", num_nodes);
+
+  return same;
+}
+
+/**
+ *  @fn static gboolean bench_same_finds (GstInferencePrediction * root,
+ *                                        GSList * all, GstInferencePrediction * removed)
+ *  @param [in] root - Root of the tree
+ *  @param [in] all - Every prediction the tree had when built
+ *  @param [in] removed - Child removed from the tree with its descendants, or NULL
+ *  @return TRUE when gst_inference_prediction_find() agrees with a full
+ *          traversal for every prediction
+ *  @brief  Checks that the index follows removals and appends
+ */
+static gboolean
+bench_same_finds (GstInferencePrediction * root, GSList * all,
+    GstInferencePrediction * removed)
+{
+  GSList *iter;
+  gboolean same = TRUE;
+
+  for (iter = all; iter && same; iter = g_slist_next (iter)) {
+    GstInferencePrediction *pred = (GstInferencePrediction *) iter->data;
+    RefFindData ref = { NULL, pred->prediction.prediction_id };
+    GstInferencePrediction *found;
+
+    vvas_treenode_traverse (root->prediction.node, IN_ORDER, TRAVERSE_ALL, -1,
+        (vvas_treenode_traverse_func) ref_node_find, &ref);
+    found = gst_inference_prediction_find (root,
+        pred->prediction.prediction_id);
+    same = found == ref.prediction;
+    if (found)
+      gst_inference_prediction_unref (found);
+
+    /* searching the removed subtree on its own still works */
+    if (same && removed && !ref.prediction) {
+      found = gst_inference_prediction_find (removed,
+          pred->prediction.prediction_id);
+      same = found == pred;
+      if (found)
+        gst_inference_prediction_unref (found);
+    }
+  }
+
+  return same;
+}
+
+/**
+ *  @fn static gboolean bench_find (guint num_nodes, FILE * out)
+ *  @param [in] num_nodes - Number of predictions of the tree
+ *  @param [in] out - File the JSON result is written to
+ *  @return TRUE when the index gives the same results as a full traversal
+ *  @brief  Times looking up every prediction of a tree by id with a full
+ *          traversal and with gst_inference_prediction_find(), then removes
+ *          and appends back a subtree checking the lookups after each step
+ */
+static gboolean
+bench_find (guint num_nodes, FILE * out)
+{
+  GstInferencePrediction *root = bench_build_tree (num_nodes);
+  GstInferencePrediction *child = NULL;
+  GSList *all = NULL, *iter;
+  guint iterations = MAX (3, BENCH_WORK / (num_nodes * num_nodes));
+  gint64 ref_us = 0, index_us = 0;
+  gboolean consistent = TRUE;
+  guint i;
+
+  vvas_treenode_traverse (root->prediction.node, IN_ORDER, TRAVERSE_ALL, -1,
+      (vvas_treenode_traverse_func) bench_node_collect, &all);
+
+  for (i = 0; i < iterations; i++) {
+    gint64 start = g_get_monotonic_time ();
+
+    for (iter = all; iter; iter = g_slist_next (iter)) {
+      GstInferencePrediction *pred = (GstInferencePrediction *) iter->data;
+      RefFindData ref = { NULL, pred->prediction.prediction_id };
+
+      vvas_treenode_traverse (root->prediction.node, IN_ORDER, TRAVERSE_ALL,
+          -1, (vvas_treenode_traverse_func) ref_node_find, &ref);
+      consistent &= ref.prediction == pred;
+    }
+    ref_us += g_get_monotonic_time () - start;
+
+    /* the first pass includes indexing the tree */
+    start = g_get_monotonic_time ();
+    for (iter = all; iter; iter = g_slist_next (iter)) {
+      GstInferencePrediction *pred = (GstInferencePrediction *) iter->data;
+      GstInferencePrediction *found = gst_inference_prediction_find (root,
+          pred->prediction.prediction_id);
+
+      consistent &= found == pred;
+      if (found)
+        gst_inference_prediction_unref (found);
+    }
+    index_us += g_get_monotonic_time () - start;
+  }
+
+  if (root->prediction.node->children)
+    child = (GstInferencePrediction *) root->prediction.node->children->data;
+
+  if (child) {
+    gst_inference_prediction_ref (child);
+    consistent &= gst_inference_prediction_remove (root, child);
+    consistent &= bench_same_finds (root, all, child);
+    /* not a child anymore */
+    consistent &= !gst_inference_prediction_remove (root, child);
+
+    /* the tree takes the reference back */
+    gst_inference_prediction_append (root, child);
+    consistent &= bench_same_finds (root, all, NULL);
+  }
+
+  fprintf (out, "{\"benchmark\": \"prediction-find\", \"nodes\": %u, "
+      "\"iterations\": %u, \"consistent\": %s, \"ref_us\": %.2f, "
+      "\"index_us\": %.2f, \"speedup\": %.2f}\n", num_nodes, iterations,
+      consistent ? "true" : "false", (gdouble) ref_us / iterations,
+      (gdouble) index_us / iterations,
+      index_us ? (gdouble) ref_us / index_us : 0.0);
+
+  g_slist_free (all);
+  gst_inference_prediction_unref (root);
+
+  if (!consistent)
+    g_printerr ("prediction-find: %u nodes, index and traversal give "
+        "different predictions\n", num_nodes);
+
+  return consistent;
+}
+
+int
+main (int argc, char *argv[])
+{
+  const guint sizes[] = { 10, 100, 1000 };
+  gchar *output = NULL;
+  gboolean failed = FALSE;
+  GOptionContext *ctx;
+  GError *error = NULL;
+  FILE *out = stdout;
+  guint s;
+  GOptionEntry entries[] = {
+    {"output", 'o', 0, G_OPTION_ARG_FILENAME, &output,
+        "Write JSON results to file instead of stdout", "FILE"},
+    {NULL}
+  };
+
+  ctx = g_option_context_new ("- GstInferencePrediction merge, scale and "
+      "find benchmark");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_clear_error (&error);
+    g_option_context_free (ctx);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  if (output) {
+    out = fopen (output, "w");
+    if (!out) {
+      g_printerr ("failed to open %s\n", output);
+      g_free (output);
+      return 1;
+    }
+  }
+
+  for (s = 0; s < G_N_ELEMENTS (sizes); s++) {
+    if (!bench_merge (sizes[s], out))
+      failed = TRUE;
+  }
+
+  for (s = 0; s < G_N_ELEMENTS (sizes); s++) {
+    if (!bench_scale (sizes[s], out))
+      failed = TRUE;
+  }
+
+  for (s = 0; s < G_N_ELEMENTS (sizes); s++) {
+    if (!bench_find (sizes[s], out))
+      failed = TRUE;
+  }
+
+  if (out != stdout)
+    fclose (out);
+  g_free (output);
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * Benchmark cases for scaling elements running with software-scaling
+ * enabled: vvas_xmulticrop (with software pre-processing when built with
+ * PPE support), vvas_xabrscaler and vvas_xcompositor.
+ */
+
+#include <math.h>
+#include "vvas_bench.h"
+
+/** @def BENCH_ABR_NUM_OUTPUTS
+ *  @brief Number of renditions produced by vvas_xabrscaler
+ */
+#define BENCH_ABR_NUM_OUTPUTS 3
+
+/**
+ *  @fn static void bench_set_output_caps (GstHarness * h, const gchar * format, guint width,
+ *                                         guint height)
+ *  @param [in] h - Output harness
+ *  @param [in] format - Video format
+ *  @param [in] width - Output width
+ *  @param [in] height - Output height
+ *  @return None
+ *  @brief  Sets caps accepted downstream of an element source pad
+ */
+static void
+bench_set_output_caps (GstHarness * h, const gchar * format, guint width,
+    guint height)
+{
+  gchar *caps = g_strdup_printf ("video/x-raw, format=%s, width=%u, "
+      "height=%u", format, width, height);
+
+  gst_harness_set_sink_caps_str (h, caps);
+  g_free (caps);
+}
+
+/**
+ *  @fn static void bench_set_ppe (GstElement * element)
+ *  @param [in] element - Scaling element
+ *  @return None
+ *  @brief  Enables mean/scale pre-processing when element is built with
+ *          PPE support
+ */
+static void
+bench_set_ppe (GstElement * element)
+{
+  if (!g_object_class_find_property (G_OBJECT_GET_CLASS (element), "alpha-r"))
+    return;
+
+  g_object_set (element, "alpha-r", 104.0f, "alpha-g", 117.0f,
+      "alpha-b", 123.0f, "beta-r", 0.5f, "beta-g", 0.5f, "beta-b", 0.5f, NULL);
+}
+
+/**
+ *  @fn static gboolean bench_multicrop_setup (VvasBench * bench)
+ *  @param [in] bench - Running benchmark
+ *  @return TRUE on success
+ *  @brief  Main buffer is scaled and converted, every detection is cropped
+ *          to an inference sized sub buffer
+ */
+static gboolean
+bench_multicrop_setup (VvasBench * bench)
+{
+  GstHarness *h;
+
+  bench_set_ppe (bench->element);
+
+  h = vvas_bench_add_input (bench, "sink", "src");
+  bench_set_output_caps (h, "BGR", bench->config->width / 2,
+      bench->config->height / 2);
+
+  return TRUE;
+}
+
+/**
+ *  @fn static gboolean bench_abrscaler_setup (VvasBench * bench)
+ *  @param [in] bench - Running benchmark
+ *  @return TRUE on success
+ *  @brief  One input scaled to a ladder of lower resolutions
+ */
+static gboolean
+bench_abrscaler_setup (VvasBench * bench)
+{
+  GstHarness *h;
+  guint i;
+
+  bench->expected = (guint64) BENCH_ABR_NUM_OUTPUTS *
+      bench->config->num_buffers;
+
+  for (i = 0; i < BENCH_ABR_NUM_OUTPUTS; i++) {
+    gchar *srcpad = g_strdup_printf ("src_%u", i);
+
+    if (i == 0)
+      h = vvas_bench_add_input (bench, "sink", srcpad);
+    else
+      h = vvas_bench_add_output (bench, srcpad);
+    g_free (srcpad);
+
+    /* 1/2, 1/4 and 1/8 of input resolution, kept even for NV12 */
+    bench_set_output_caps (h, "NV12",
+        ((bench->config->width >> (i + 1)) + 1) & ~1u,
+        ((bench->config->height >> (i + 1)) + 1) & ~1u);
+  }
+
+  return TRUE;
+}
+
+/**
+ *  @fn static gboolean bench_compositor_setup (VvasBench * bench)
+ *  @param [in] bench - Running benchmark
+ *  @return TRUE on success
+ *  @brief  All streams are composed into a grid of tiles
+ */
+static gboolean
+bench_compositor_setup (VvasBench * bench)
+{
+  guint cols, rows, tile_w, tile_h, s;
+  GstHarness *h;
+
+  bench->expected = bench->config->num_buffers;
+
+  cols = (guint) ceil (sqrt (bench->num_streams));
+  rows = (bench->num_streams + cols - 1) / cols;
+  tile_w = (bench->config->width / cols) & ~1u;
+  tile_h = (bench->config->height / rows) & ~1u;
+
+  for (s = 0; s < bench->num_streams; s++) {
+    GstPad *pad;
+
+    h = vvas_bench_add_input (bench, "sink_%u", s ? NULL : "src");
+    if (!s)
+      bench_set_output_caps (h, "NV12", bench->config->width,
+          bench->config->height);
+
+    pad = vvas_bench_get_element_sinkpad (h);
+    if (!pad)
+      return FALSE;
+    g_object_set (pad, "xpos", (guint) ((s % cols) * tile_w),
+        "ypos", (guint) ((s / cols) * tile_h), "width", (gint) tile_w,
+        "height", (gint) tile_h, NULL);
+    gst_object_unref (pad);
+  }
+
+  return TRUE;
+}
+
+/** @brief Scaling benchmark cases */
+const VvasBenchCase vvas_bench_scaler_cases[] = {
+  {"multicrop-ppe", "vvas_xmulticrop", VVAS_BENCH_META_INFER, FALSE,
+        "software-scaling=true ppe-on-main-buffer=true d-width=224 "
+        "d-height=224", bench_multicrop_setup},
+  {"abrscaler", "vvas_xabrscaler", VVAS_BENCH_META_NONE, FALSE,
+      "software-scaling=true", bench_abrscaler_setup},
+  {"compositor", "vvas_xcompositor", VVAS_BENCH_META_NONE, TRUE,
+      "software-scaling=true", bench_compositor_setup},
+  {NULL}
+};
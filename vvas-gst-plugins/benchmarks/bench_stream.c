@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * Benchmark cases for stream management elements: vvas_xfunnel,
+ * vvas_xdefunnel, vvas_xskipframe and vvas_xreorderframe.
+ */
+
+#include "vvas_bench.h"
+
+/**
+ *  @fn static gboolean bench_funnel_setup (VvasBench * bench)
+ *  @param [in] bench - Running benchmark
+ *  @return TRUE on success
+ *  @brief  One request sink pad per stream, all muxed to single source pad
+ */
+static gboolean
+bench_funnel_setup (VvasBench * bench)
+{
+  guint s;
+
+  for (s = 0; s < bench->num_streams; s++)
+    vvas_bench_add_input (bench, "sink_%u", s ? NULL : "src");
+
+  return TRUE;
+}
+
+/**
+ *  @fn static void bench_defunnel_pad_added (GstElement * element, GstPad * pad, VvasBench * bench)
+ *  @param [in] element - vvas_xdefunnel instance
+ *  @param [in] pad - Newly added pad
+ *  @param [in] bench - Running benchmark
+ *  @return None
+ *  @brief  Drains every source pad created by vvas_xdefunnel
+ */
+static void
+bench_defunnel_pad_added (GstElement * element, GstPad * pad,
+    VvasBench * bench)
+{
+  if (GST_PAD_IS_SRC (pad))
+    vvas_bench_add_output (bench, GST_PAD_NAME (pad));
+}
+
+/**
+ *  @fn static gboolean bench_defunnel_setup (VvasBench * bench)
+ *  @param [in] bench - Running benchmark
+ *  @return TRUE on success
+ *  @brief  Muxed streams on single sink pad, source pads are created on
+ *          stream-start of every stream
+ */
+static gboolean
+bench_defunnel_setup (VvasBench * bench)
+{
+  g_signal_connect (bench->element, "pad-added",
+      G_CALLBACK (bench_defunnel_pad_added), bench);
+  vvas_bench_add_input (bench, "sink", NULL);
+
+  return TRUE;
+}
+
+/**
+ *  @fn static gboolean bench_skipframe_setup (VvasBench * bench)
+ *  @param [in] bench - Running benchmark
+ *  @return TRUE on success
+ *  @brief  Drains both inference and skip source pads
+ */
+static gboolean
+bench_skipframe_setup (VvasBench * bench)
+{
+  vvas_bench_add_input (bench, "sink", "src_0");
+  vvas_bench_add_output (bench, "src_1");
+
+  return TRUE;
+}
+
+/**
+ *  @fn static gboolean bench_reorderframe_setup (VvasBench * bench)
+ *  @param [in] bench - Running benchmark
+ *  @return TRUE on success
+ *  @brief  vvas_xreorderframe needs both of its inputs split by
+ *          vvas_xskipframe, so both are benchmarked together in a bin
+ */
+static gboolean
+bench_reorderframe_setup (VvasBench * bench)
+{
+  GstElement *bin, *skipframe;
+  GstPad *pad;
+
+  skipframe = gst_element_factory_make ("vvas_xskipframe", NULL);
+  if (!skipframe)
+    return FALSE;
+  g_object_set (skipframe, "infer-interval", 3, NULL);
+
+  bin = gst_bin_new (NULL);
+  gst_bin_add_many (GST_BIN (bin), skipframe, bench->element, NULL);
+  if (!gst_element_link_pads (skipframe, "src_0", bench->element,
+          "infer_sink")
+      || !gst_element_link_pads (skipframe, "src_1", bench->element,
+          "skip_sink")) {
+    gst_object_unref (bin);
+    return FALSE;
+  }
+
+  pad = gst_element_get_static_pad (skipframe, "sink");
+  gst_element_add_pad (bin, gst_ghost_pad_new ("sink", pad));
+  gst_object_unref (pad);
+  pad = gst_element_get_static_pad (bench->element, "src");
+  gst_element_add_pad (bin, gst_ghost_pad_new ("src", pad));
+  gst_object_unref (pad);
+
+  /* bin holds its own reference on element under test now */
+  gst_object_unref (bench->element);
+  bench->element = gst_object_ref_sink (bin);
+
+  vvas_bench_add_input (bench, "sink", "src");
+
+  return TRUE;
+}
+
+/** @brief Stream management benchmark cases */
+const VvasBenchCase vvas_bench_stream_cases[] = {
+  {"funnel", "vvas_xfunnel", VVAS_BENCH_META_NONE, TRUE, NULL,
+      bench_funnel_setup},
+  {"defunnel", "vvas_xdefunnel", VVAS_BENCH_META_SRCID, TRUE, NULL,
+      bench_defunnel_setup},
+  {"skipframe", "vvas_xskipframe", VVAS_BENCH_META_SRCID, TRUE,
+      "infer-interval=3", bench_skipframe_setup},
+  {"reorderframe", "vvas_xreorderframe", VVAS_BENCH_META_SRCID, TRUE, NULL,
+      bench_reorderframe_setup},
+  {NULL}
+};
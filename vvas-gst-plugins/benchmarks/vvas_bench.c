@@ -0,0 +1,710 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * Hardware free benchmark runner for VVAS GStreamer plug-ins.
+ *
+ * Every case wraps one element (or a small bin) in GstHarness instances,
+ * pushes synthetic multi-stream video through it and reports throughput,
+ * per buffer latency percentiles and heap allocations as one JSON object
+ * per case.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <gst/vvas/gstinferencemeta.h>
+#include <gst/vvas/gstvvassrcidmeta.h>
+#include "vvas_bench.h"
+
+/** @def VVAS_BENCH_NUM_FRAMES
+ *  @brief Number of distinct frame memories cycled through input buffers
+ */
+#define VVAS_BENCH_NUM_FRAMES 8
+
+/** @def VVAS_BENCH_FPS
+ *  @brief Frame rate of synthetic streams
+ */
+#define VVAS_BENCH_FPS 30
+
+/** Exit code reported to meson for skipped benchmarks */
+#define VVAS_BENCH_EXIT_SKIP 77
+
+/** @struct VvasBenchStats
+ *  @brief  Measurements of one benchmark run
+ */
+typedef struct
+{
+  /** Buffers pushed into element */
+  guint64 pushed;
+  /** Buffers pulled out of element */
+  guint64 pulled;
+  /** Output buffers not backed by an input frame memory */
+  guint64 new_buffers;
+  /** Push timestamp of each frame number */
+  GstClockTime *push_ts;
+  /** Latency of every output buffer in nanoseconds */
+  GArray *latencies;
+  /** Input frame memories */
+  GstMemory *frames[VVAS_BENCH_NUM_FRAMES];
+} VvasBenchStats;
+
+/**
+ *  @fn static GstPadProbeReturn vvas_bench_tag_stream_start (GstPad * pad, GstPadProbeInfo * info,
+ *                                                            gpointer user_data)
+ *  @param [in] pad - Element sink pad
+ *  @param [in] info - Probe information
+ *  @param [in] user_data - Unused
+ *  @return GST_PAD_PROBE_OK
+ *  @brief  Adds pad-index to stream-start events sent by harness itself, as
+ *          elements behind vvas_xfunnel rely on it to identify streams
+ */
+static GstPadProbeReturn
+vvas_bench_tag_stream_start (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  GstEvent *event = GST_PAD_PROBE_INFO_EVENT (info);
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_STREAM_START
+      && !gst_structure_has_field (gst_event_get_structure (event),
+          "pad-index")) {
+    event = gst_event_make_writable (event);
+    gst_structure_set (gst_event_writable_structure (event), "pad-index",
+        G_TYPE_UINT, 0, NULL);
+    GST_PAD_PROBE_INFO_DATA (info) = event;
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ *  @fn GstHarness * vvas_bench_add_input (VvasBench * bench, const gchar * sinkpad, const gchar * srcpad)
+ *  @param [in] bench - Running benchmark
+ *  @param [in] sinkpad - Name or template of element sink pad to feed
+ *  @param [in] srcpad - Name of element source pad to drain, may be NULL
+ *  @return Harness attached to element
+ *  @brief  Attaches a harness pushing input buffers to element
+ */
+GstHarness *
+vvas_bench_add_input (VvasBench * bench, const gchar * sinkpad,
+    const gchar * srcpad)
+{
+  GstHarness *h;
+
+  if (bench->bcase->metas & VVAS_BENCH_META_SRCID) {
+    GstPad *pad = gst_element_get_static_pad (bench->element, sinkpad);
+
+    if (pad) {
+      gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM,
+          vvas_bench_tag_stream_start, NULL, NULL);
+      gst_object_unref (pad);
+    }
+  }
+
+  h = gst_harness_new_with_element (bench->element, sinkpad, srcpad);
+  g_ptr_array_add (bench->harnesses, h);
+  g_ptr_array_add (bench->inputs, h);
+  if (srcpad)
+    g_ptr_array_add (bench->outputs, h);
+
+  return h;
+}
+
+/**
+ *  @fn GstHarness * vvas_bench_add_output (VvasBench * bench, const gchar * srcpad)
+ *  @param [in] bench - Running benchmark
+ *  @param [in] srcpad - Name or template of element source pad to drain
+ *  @return Harness attached to element
+ *  @brief  Attaches a harness pulling output buffers from element
+ */
+GstHarness *
+vvas_bench_add_output (VvasBench * bench, const gchar * srcpad)
+{
+  GstHarness *h;
+
+  h = gst_harness_new_with_element (bench->element, NULL, srcpad);
+  g_ptr_array_add (bench->harnesses, h);
+  g_ptr_array_add (bench->outputs, h);
+
+  return h;
+}
+
+/**
+ *  @fn GstPad * vvas_bench_get_element_sinkpad (GstHarness * h)
+ *  @param [in] h - Input harness
+ *  @return Element pad fed by harness, unref after usage
+ *  @brief  Gets element sink pad, used to set pad properties
+ */
+GstPad *
+vvas_bench_get_element_sinkpad (GstHarness * h)
+{
+  return gst_pad_get_peer (h->srcpad);
+}
+
+/**
+ *  @fn static void vvas_bench_fill_frames (VvasBench * bench, VvasBenchStats * stats)
+ *  @param [in] bench - Running benchmark
+ *  @param [out] stats - Frame memories are stored here
+ *  @return None
+ *  @brief  Allocates input frames filled with a moving gradient
+ */
+static void
+vvas_bench_fill_frames (VvasBench * bench, VvasBenchStats * stats)
+{
+  guint i, j;
+
+  for (i = 0; i < VVAS_BENCH_NUM_FRAMES; i++) {
+    GstMapInfo info;
+
+    stats->frames[i] =
+        gst_allocator_alloc (NULL, GST_VIDEO_INFO_SIZE (&bench->vinfo), NULL);
+    gst_memory_map (stats->frames[i], &info, GST_MAP_WRITE);
+    for (j = 0; j < info.size; j++)
+      info.data[j] = (guint8) ((j % GST_VIDEO_INFO_WIDTH (&bench->vinfo))
+          + i * 16);
+    gst_memory_unmap (stats->frames[i], &info);
+  }
+}
+
+/**
+ *  @fn static void vvas_bench_add_detections (VvasBench * bench, GstBuffer * buf, guint64 n)
+ *  @param [in] bench - Running benchmark
+ *  @param [in] buf - Buffer to attach inference metadata to
+ *  @param [in] n - Frame number, used to move detections
+ *  @return None
+ *  @brief  Attaches GstInferenceMeta with objects moving across the frame
+ */
+static void
+vvas_bench_add_detections (VvasBench * bench, GstBuffer * buf, guint64 n)
+{
+  guint width = GST_VIDEO_INFO_WIDTH (&bench->vinfo);
+  guint height = GST_VIDEO_INFO_HEIGHT (&bench->vinfo);
+  GstInferenceMeta *meta;
+  guint i;
+
+  meta = (GstInferenceMeta *) gst_buffer_add_meta (buf,
+      gst_inference_meta_get_info (), NULL);
+  meta->prediction->prediction.bbox.width = width;
+  meta->prediction->prediction.bbox.height = height;
+
+  for (i = 0; i < bench->config->num_objects; i++) {
+    VvasBoundingBox bbox = { 0 };
+
+    bbox.width = width / 8;
+    bbox.height = height / 8;
+    bbox.x = (i * 211 + n * 4) % (width - bbox.width);
+    bbox.y = (i * 127 + n * 2) % (height - bbox.height);
+    gst_inference_prediction_append (meta->prediction,
+        gst_inference_prediction_new_full (&bbox));
+  }
+}
+
+/**
+ *  @fn static GstBuffer * vvas_bench_make_buffer (VvasBench * bench, VvasBenchStats * stats,
+ *                                                 guint stream, guint64 n)
+ *  @param [in] bench - Running benchmark
+ *  @param [in] stats - Measurements holding input frames
+ *  @param [in] stream - Stream index
+ *  @param [in] n - Frame number
+ *  @return Input buffer
+ *  @brief  Creates input buffer wrapping one of preallocated frames
+ */
+static GstBuffer *
+vvas_bench_make_buffer (VvasBench * bench, VvasBenchStats * stats,
+    guint stream, guint64 n)
+{
+  GstBuffer *buf = gst_buffer_new ();
+
+  gst_buffer_append_memory (buf,
+      gst_memory_ref (stats->frames[(n + stream) % VVAS_BENCH_NUM_FRAMES]));
+  GST_BUFFER_PTS (buf) = gst_util_uint64_scale (n, GST_SECOND, VVAS_BENCH_FPS);
+  GST_BUFFER_DURATION (buf) = GST_SECOND / VVAS_BENCH_FPS;
+  GST_BUFFER_OFFSET (buf) = n;
+
+  if (bench->bcase->metas & VVAS_BENCH_META_SRCID) {
+    GstVvasSrcIDMeta *meta = gst_buffer_add_vvas_srcid_meta (buf);
+
+    meta->src_id = stream;
+    meta->frame_id = n;
+  }
+
+  if (bench->bcase->metas & VVAS_BENCH_META_INFER)
+    vvas_bench_add_detections (bench, buf, n);
+
+  return buf;
+}
+
+/**
+ *  @fn static void vvas_bench_start_streams (VvasBench * bench)
+ *  @param [in] bench - Running benchmark
+ *  @return None
+ *  @brief  Sends caps to all inputs. When several streams share one input,
+ *          every stream is announced like vvas_xfunnel does, with a
+ *          stream-start event carrying its pad-index.
+ */
+static void
+vvas_bench_start_streams (VvasBench * bench)
+{
+  guint i, s;
+
+  for (i = 0; i < bench->inputs->len; i++)
+    gst_harness_set_src_caps (g_ptr_array_index (bench->inputs, i),
+        gst_caps_ref (bench->caps));
+
+  if (bench->inputs->len != 1 || bench->num_streams == 1
+      || !(bench->bcase->metas & VVAS_BENCH_META_SRCID))
+    return;
+
+  for (s = 0; s < bench->num_streams; s++) {
+    GstHarness *h = g_ptr_array_index (bench->inputs, 0);
+    GstSegment segment;
+    GstEvent *event;
+    gchar *stream_id;
+
+    stream_id = g_strdup_printf ("vvas-bench-%u", s);
+    event = gst_event_new_stream_start (stream_id);
+    gst_structure_set (gst_event_writable_structure (event), "pad-index",
+        G_TYPE_UINT, s, NULL);
+    g_free (stream_id);
+    gst_harness_push_event (h, event);
+
+    gst_harness_push_event (h, gst_event_new_caps (bench->caps));
+
+    gst_segment_init (&segment, GST_FORMAT_TIME);
+    gst_harness_push_event (h, gst_event_new_segment (&segment));
+  }
+}
+
+/**
+ *  @fn static gboolean vvas_bench_is_input_frame (VvasBenchStats * stats, GstBuffer * buf)
+ *  @param [in] stats - Measurements holding input frames
+ *  @param [in] buf - Output buffer
+ *  @return TRUE if output buffer is backed by an input frame
+ *  @brief  Detects output buffers which were allocated or copied by element
+ */
+static gboolean
+vvas_bench_is_input_frame (VvasBenchStats * stats, GstBuffer * buf)
+{
+  GstMemory *mem;
+  guint i;
+
+  if (!gst_buffer_n_memory (buf))
+    return FALSE;
+
+  mem = gst_buffer_peek_memory (buf, 0);
+  for (i = 0; i < VVAS_BENCH_NUM_FRAMES; i++) {
+    if (mem == stats->frames[i] || mem->parent == stats->frames[i])
+      return TRUE;
+  }
+  return FALSE;
+}
+
+/**
+ *  @fn static guint vvas_bench_drain (VvasBench * bench, VvasBenchStats * stats)
+ *  @param [in] bench - Running benchmark
+ *  @param [inout] stats - Measurements to update
+ *  @return Number of buffers pulled
+ *  @brief  Pulls all buffers available on outputs without blocking
+ */
+static guint
+vvas_bench_drain (VvasBench * bench, VvasBenchStats * stats)
+{
+  guint i, count = 0;
+
+  for (i = 0; i < bench->outputs->len; i++) {
+    GstHarness *h = g_ptr_array_index (bench->outputs, i);
+    GstBuffer *buf;
+
+    while ((buf = gst_harness_try_pull (h))) {
+      GstClockTime now = gst_util_get_timestamp ();
+      guint64 n;
+
+      if (GST_BUFFER_PTS_IS_VALID (buf)) {
+        n = gst_util_uint64_scale_round (GST_BUFFER_PTS (buf), VVAS_BENCH_FPS,
+            GST_SECOND);
+        if (n < bench->config->num_buffers && stats->push_ts[n] != 0) {
+          guint64 latency = now - stats->push_ts[n];
+          g_array_append_val (stats->latencies, latency);
+        }
+      }
+
+      if (!vvas_bench_is_input_frame (stats, buf))
+        stats->new_buffers++;
+
+      gst_buffer_unref (buf);
+      stats->pulled++;
+      count++;
+    }
+  }
+  return count;
+}
+
+/**
+ *  @fn static gint vvas_bench_compare_u64 (gconstpointer a, gconstpointer b)
+ *  @param [in] a - first value
+ *  @param [in] b - second value
+ *  @return Ordering of values
+ *  @brief  Sort function for latencies
+ */
+static gint
+vvas_bench_compare_u64 (gconstpointer a, gconstpointer b)
+{
+  guint64 va = *(const guint64 *) a;
+  guint64 vb = *(const guint64 *) b;
+
+  return va < vb ? -1 : (va > vb ? 1 : 0);
+}
+
+/**
+ *  @fn static gdouble vvas_bench_percentile (GArray * sorted, gdouble p)
+ *  @param [in] sorted - Sorted latencies in nanoseconds
+ *  @param [in] p - Percentile in range [0, 100]
+ *  @return Latency in microseconds
+ *  @brief  Nearest rank percentile of latencies
+ */
+static gdouble
+vvas_bench_percentile (GArray * sorted, gdouble p)
+{
+  guint rank;
+
+  if (!sorted->len)
+    return 0;
+
+  rank = (guint) ((p / 100.0) * (sorted->len - 1) + 0.5);
+  return g_array_index (sorted, guint64, rank) / 1000.0;
+}
+
+/**
+ *  @fn static void vvas_bench_report (FILE * out, const VvasBench * bench, const gchar * status,
+ *                                     const gchar * reason, VvasBenchStats * stats,
+ *                                     GstClockTime elapsed, VvasBenchAllocStats * allocs,
+ *                                     gboolean have_allocs)
+ *  @param [in] out - Output stream
+ *  @param [in] bench - Benchmark which ran
+ *  @param [in] status - "ok", "skipped" or "failed"
+ *  @param [in] reason - Explanation when status is not "ok", may be NULL
+ *  @param [in] stats - Measurements, may be NULL when benchmark did not run
+ *  @param [in] elapsed - Wall clock time of the run
+ *  @param [in] allocs - Heap allocations done during the run
+ *  @param [in] have_allocs - Whether heap allocations were counted
+ *  @return None
+ *  @brief  Writes benchmark result as one line of JSON
+ */
+static void
+vvas_bench_report (FILE * out, const VvasBench * bench, const gchar * status,
+    const gchar * reason, VvasBenchStats * stats, GstClockTime elapsed,
+    VvasBenchAllocStats * allocs, gboolean have_allocs)
+{
+  const VvasBenchConfig *config = bench->config;
+
+  fprintf (out, "{\"benchmark\": \"%s\", \"element\": \"%s\", "
+      "\"status\": \"%s\", \"streams\": %u, \"buffers_per_stream\": %u, "
+      "\"width\": %u, \"height\": %u, \"objects\": %u",
+      bench->bcase->name, bench->bcase->factory, status, bench->num_streams,
+      config->num_buffers, config->width, config->height, config->num_objects);
+
+  if (reason)
+    fprintf (out, ", \"reason\": \"%s\"", reason);
+
+  if (stats) {
+    gdouble secs = (gdouble) elapsed / GST_SECOND;
+
+    g_array_sort (stats->latencies, vvas_bench_compare_u64);
+    fprintf (out, ", \"pushed\": %" G_GUINT64_FORMAT ", \"pulled\": %"
+        G_GUINT64_FORMAT ", \"expected\": %" G_GUINT64_FORMAT
+        ", \"elapsed_ms\": %.3f, \"input_fps\": %.2f, \"output_fps\": %.2f",
+        stats->pushed, stats->pulled, bench->expected, secs * 1000.0,
+        secs > 0 ? stats->pushed / secs : 0.0,
+        secs > 0 ? stats->pulled / secs : 0.0);
+    fprintf (out, ", \"latency_us\": {\"p50\": %.1f, \"p90\": %.1f, "
+        "\"p99\": %.1f, \"max\": %.1f}",
+        vvas_bench_percentile (stats->latencies, 50),
+        vvas_bench_percentile (stats->latencies, 90),
+        vvas_bench_percentile (stats->latencies, 99),
+        vvas_bench_percentile (stats->latencies, 100));
+    fprintf (out, ", \"new_output_buffers\": %" G_GUINT64_FORMAT,
+        stats->new_buffers);
+    if (have_allocs && stats->pushed) {
+      fprintf (out, ", \"allocs\": %" G_GUINT64_FORMAT ", \"alloc_bytes\": %"
+          G_GUINT64_FORMAT ", \"allocs_per_buffer\": %.2f, "
+          "\"alloc_bytes_per_buffer\": %.1f", allocs->calls, allocs->bytes,
+          (gdouble) allocs->calls / stats->pushed,
+          (gdouble) allocs->bytes / stats->pushed);
+    }
+  }
+  fprintf (out, "}\n");
+  fflush (out);
+}
+
+/**
+ *  @fn static gboolean vvas_bench_run (const VvasBenchConfig * config, const VvasBenchCase * bcase,
+ *                                      FILE * out, gboolean * skipped)
+ *  @param [in] config - Benchmark parameters
+ *  @param [in] bcase - Case to run
+ *  @param [in] out - Where to write results
+ *  @param [out] skipped - Set when case could not run on this host
+ *  @return FALSE if benchmark failed, TRUE otherwise
+ *  @brief  Runs one benchmark case and reports its results
+ */
+static gboolean
+vvas_bench_run (const VvasBenchConfig * config, const VvasBenchCase * bcase,
+    FILE * out, gboolean * skipped)
+{
+  VvasBench bench = { 0 };
+  VvasBenchStats stats = { 0 };
+  VvasBenchAllocStats allocs_start, allocs_end;
+  GstStateChangeReturn sret;
+  GstClockTime start, deadline, elapsed;
+  gboolean have_allocs, bret = TRUE;
+  guint64 n;
+  guint i, s;
+
+  bench.config = config;
+  bench.bcase = bcase;
+  bench.num_streams = bcase->multi_stream ? config->num_streams : 1;
+  *skipped = FALSE;
+
+  bench.element = gst_element_factory_make (bcase->factory, NULL);
+  if (!bench.element) {
+    vvas_bench_report (out, &bench, "skipped", "element not available", NULL,
+        0, NULL, FALSE);
+    *skipped = TRUE;
+    return TRUE;
+  }
+  gst_object_ref_sink (bench.element);
+
+  if (bcase->properties) {
+    gchar **props = g_strsplit (bcase->properties, " ", -1);
+
+    for (i = 0; props[i]; i++) {
+      gchar **kv = g_strsplit (props[i], "=", 2);
+
+      if (kv[0] && kv[1])
+        gst_util_set_object_arg (G_OBJECT (bench.element), kv[0], kv[1]);
+      g_strfreev (kv);
+    }
+    g_strfreev (props);
+  }
+
+  /* Harness asserts on state change failures, so check upfront whether
+   * element can run on this host at all */
+  sret = gst_element_set_state (bench.element, GST_STATE_PAUSED);
+  gst_element_set_state (bench.element, GST_STATE_NULL);
+  if (sret == GST_STATE_CHANGE_FAILURE) {
+    vvas_bench_report (out, &bench, "skipped", "element failed to start",
+        NULL, 0, NULL, FALSE);
+    gst_object_unref (bench.element);
+    *skipped = TRUE;
+    return TRUE;
+  }
+
+  gst_video_info_set_format (&bench.vinfo, GST_VIDEO_FORMAT_NV12,
+      config->width, config->height);
+  GST_VIDEO_INFO_FPS_N (&bench.vinfo) = VVAS_BENCH_FPS;
+  GST_VIDEO_INFO_FPS_D (&bench.vinfo) = 1;
+  bench.caps = gst_video_info_to_caps (&bench.vinfo);
+  bench.harnesses = g_ptr_array_new_with_free_func ((GDestroyNotify)
+      gst_harness_teardown);
+  bench.inputs = g_ptr_array_new ();
+  bench.outputs = g_ptr_array_new ();
+  bench.expected = (guint64) bench.num_streams * config->num_buffers;
+
+  if (!bcase->setup (&bench) || !bench.inputs->len) {
+    vvas_bench_report (out, &bench, "failed", "setup failed", NULL, 0, NULL,
+        FALSE);
+    bret = FALSE;
+    goto exit;
+  }
+
+  vvas_bench_fill_frames (&bench, &stats);
+  stats.push_ts = g_new0 (GstClockTime, config->num_buffers);
+  stats.latencies = g_array_sized_new (FALSE, FALSE, sizeof (guint64),
+      bench.expected);
+  vvas_bench_start_streams (&bench);
+
+  have_allocs = vvas_bench_alloc_get_stats (&allocs_start);
+  start = gst_util_get_timestamp ();
+
+  for (n = 0; n < config->num_buffers && bret; n++) {
+    stats.push_ts[n] = gst_util_get_timestamp ();
+
+    for (s = 0; s < bench.num_streams; s++) {
+      GstHarness *h = g_ptr_array_index (bench.inputs, s % bench.inputs->len);
+      GstFlowReturn fret;
+
+      fret = gst_harness_push (h, vvas_bench_make_buffer (&bench, &stats, s,
+              n));
+      if (fret != GST_FLOW_OK) {
+        gchar *reason = g_strdup_printf ("push returned %s",
+            gst_flow_get_name (fret));
+
+        vvas_bench_report (out, &bench, "failed", reason, NULL, 0, NULL,
+            FALSE);
+        g_free (reason);
+        bret = FALSE;
+        break;
+      }
+      stats.pushed++;
+    }
+    vvas_bench_drain (&bench, &stats);
+  }
+
+  /* Collect buffers still queued inside element */
+  deadline = gst_util_get_timestamp () + config->timeout_ms * GST_MSECOND;
+  while (bret && stats.pulled < bench.expected
+      && gst_util_get_timestamp () < deadline) {
+    if (!vvas_bench_drain (&bench, &stats))
+      g_usleep (100);
+  }
+
+  elapsed = gst_util_get_timestamp () - start;
+  vvas_bench_alloc_get_stats (&allocs_end);
+  allocs_end.calls -= allocs_start.calls;
+  allocs_end.bytes -= allocs_start.bytes;
+
+  if (bret) {
+    if (stats.pulled < bench.expected) {
+      vvas_bench_report (out, &bench, "failed", "missing output buffers",
+          &stats, elapsed, &allocs_end, have_allocs);
+      bret = FALSE;
+    } else {
+      vvas_bench_report (out, &bench, "ok", NULL, &stats, elapsed,
+          &allocs_end, have_allocs);
+    }
+  }
+
+  for (i = 0; i < bench.inputs->len; i++)
+    gst_harness_push_event (g_ptr_array_index (bench.inputs, i),
+        gst_event_new_eos ());
+
+exit:
+  g_ptr_array_free (bench.inputs, TRUE);
+  g_ptr_array_free (bench.outputs, TRUE);
+  g_ptr_array_free (bench.harnesses, TRUE);
+  gst_element_set_state (bench.element, GST_STATE_NULL);
+  gst_object_unref (bench.element);
+  gst_caps_unref (bench.caps);
+  for (i = 0; i < VVAS_BENCH_NUM_FRAMES; i++) {
+    if (stats.frames[i])
+      gst_memory_unref (stats.frames[i]);
+  }
+  g_free (stats.push_ts);
+  if (stats.latencies)
+    g_array_free (stats.latencies, TRUE);
+
+  return bret;
+}
+
+int
+main (int argc, char *argv[])
+{
+  const VvasBenchCase *case_lists[] = { vvas_bench_stream_cases,
+    vvas_bench_meta_cases, vvas_bench_scaler_cases, NULL
+  };
+  VvasBenchConfig config = { 4, 300, 1920, 1080, 8, 10000 };
+  gchar *case_name = NULL, *output = NULL;
+  gboolean list = FALSE, failed = FALSE;
+  guint num_run = 0, num_skipped = 0, l;
+  GOptionContext *ctx;
+  GError *error = NULL;
+  FILE *out = stdout;
+  GOptionEntry entries[] = {
+    {"case", 'c', 0, G_OPTION_ARG_STRING, &case_name,
+        "Benchmark case to run (default: all)", "NAME"},
+    {"list", 'l', 0, G_OPTION_ARG_NONE, &list, "List benchmark cases", NULL},
+    {"streams", 's', 0, G_OPTION_ARG_INT, &config.num_streams,
+        "Number of input streams", "N"},
+    {"buffers", 'n', 0, G_OPTION_ARG_INT, &config.num_buffers,
+        "Number of buffers per stream", "N"},
+    {"width", 0, 0, G_OPTION_ARG_INT, &config.width, "Frame width", "W"},
+    {"height", 0, 0, G_OPTION_ARG_INT, &config.height, "Frame height", "H"},
+    {"objects", 0, 0, G_OPTION_ARG_INT, &config.num_objects,
+        "Detections per frame for metadata consuming elements", "N"},
+    {"timeout", 0, 0, G_OPTION_ARG_INT, &config.timeout_ms,
+        "Time to wait for pending outputs in milliseconds", "MS"},
+    {"output", 'o', 0, G_OPTION_ARG_FILENAME, &output,
+        "Write JSON results to file instead of stdout", "FILE"},
+    {NULL}
+  };
+
+  ctx = g_option_context_new ("- VVAS plug-in benchmarks");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_clear_error (&error);
+    g_option_context_free (ctx);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  if (!config.num_streams || !config.num_buffers || config.width < 64
+      || config.height < 64) {
+    g_printerr ("invalid benchmark parameters\n");
+    return 1;
+  }
+
+  if (output) {
+    out = fopen (output, "w");
+    if (!out) {
+      g_printerr ("failed to open %s\n", output);
+      return 1;
+    }
+  }
+
+  for (l = 0; case_lists[l]; l++) {
+    const VvasBenchCase *bcase;
+
+    for (bcase = case_lists[l]; bcase->name; bcase++) {
+      gboolean skipped;
+
+      if (list) {
+        g_print ("%s (%s)\n", bcase->name, bcase->factory);
+        continue;
+      }
+      if (case_name && g_strcmp0 (case_name, "all")
+          && g_strcmp0 (case_name, bcase->name))
+        continue;
+
+      if (!vvas_bench_run (&config, bcase, out, &skipped))
+        failed = TRUE;
+      num_run++;
+      if (skipped)
+        num_skipped++;
+    }
+  }
+
+  if (out != stdout)
+    fclose (out);
+  g_free (output);
+
+  if (!list && !num_run) {
+    g_printerr ("unknown benchmark case %s\n", case_name);
+    g_free (case_name);
+    return 1;
+  }
+  g_free (case_name);
+
+  if (failed)
+    return 1;
+  return (num_run && num_run == num_skipped) ? VVAS_BENCH_EXIT_SKIP : 0;
+}
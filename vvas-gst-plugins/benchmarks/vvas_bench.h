@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+#ifndef _VVAS_BENCH_H_
+#define _VVAS_BENCH_H_
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include <gst/check/gstharness.h>
+
+G_BEGIN_DECLS
+
+typedef struct _VvasBenchConfig VvasBenchConfig;
+typedef struct _VvasBench VvasBench;
+typedef struct _VvasBenchCase VvasBenchCase;
+
+/** @enum VvasBenchMeta
+ *  @brief Metadata attached to synthetic input buffers
+ */
+typedef enum
+{
+  /** Plain video frames */
+  VVAS_BENCH_META_NONE = 0,
+  /** GstVvasSrcIDMeta carrying stream index and frame number */
+  VVAS_BENCH_META_SRCID = 1 << 0,
+  /** GstInferenceMeta with moving detections */
+  VVAS_BENCH_META_INFER = 1 << 1,
+} VvasBenchMeta;
+
+/** @struct _VvasBenchConfig
+ *  @brief  Benchmark parameters common to all cases
+ */
+struct _VvasBenchConfig
+{
+  /** Number of synthetic input streams */
+  guint num_streams;
+  /** Number of buffers pushed per stream */
+  guint num_buffers;
+  /** Width of input frames */
+  guint width;
+  /** Height of input frames */
+  guint height;
+  /** Number of detections per frame when inference metadata is attached */
+  guint num_objects;
+  /** Time to wait for pending output buffers in milliseconds */
+  guint timeout_ms;
+};
+
+/** @struct _VvasBench
+ *  @brief  State of one running benchmark case
+ */
+struct _VvasBench
+{
+  /** Benchmark parameters */
+  const VvasBenchConfig *config;
+  /** Case being run */
+  const VvasBenchCase *bcase;
+  /** Element (or bin) under test */
+  GstElement *element;
+  /** All harnesses attached to element, owned */
+  GPtrArray *harnesses;
+  /** Harnesses used to push input buffers */
+  GPtrArray *inputs;
+  /** Harnesses used to pull output buffers */
+  GPtrArray *outputs;
+  /** Video info of input frames */
+  GstVideoInfo vinfo;
+  /** Caps of input frames */
+  GstCaps *caps;
+  /** Number of streams generated for this case */
+  guint num_streams;
+  /** Number of output buffers expected for whole run */
+  guint64 expected;
+};
+
+/** @struct _VvasBenchCase
+ *  @brief  Description of a benchmark case
+ */
+struct _VvasBenchCase
+{
+  /** Case name used on command line and in results */
+  const gchar *name;
+  /** Factory name of element under test */
+  const gchar *factory;
+  /** Metadata to attach to input buffers */
+  VvasBenchMeta metas;
+  /** Whether case consumes more than one input stream */
+  gboolean multi_stream;
+  /** Space separated name=value element properties, may be NULL */
+  const gchar *properties;
+  /** Creates harnesses and configures element, returns FALSE on failure */
+  gboolean (*setup) (VvasBench * bench);
+};
+
+GstHarness *vvas_bench_add_input (VvasBench * bench, const gchar * sinkpad,
+    const gchar * srcpad);
+GstHarness *vvas_bench_add_output (VvasBench * bench, const gchar * srcpad);
+GstPad *vvas_bench_get_element_sinkpad (GstHarness * h);
+
+extern const VvasBenchCase vvas_bench_stream_cases[];
+extern const VvasBenchCase vvas_bench_meta_cases[];
+extern const VvasBenchCase vvas_bench_scaler_cases[];
+
+/** @struct VvasBenchAllocStats
+ *  @brief  Heap allocation counters of whole process
+ */
+typedef struct
+{
+  /** Number of malloc, calloc and realloc calls */
+  guint64 calls;
+  /** Number of bytes requested */
+  guint64 bytes;
+} VvasBenchAllocStats;
+
+gboolean vvas_bench_alloc_get_stats (VvasBenchAllocStats * stats);
+
+G_END_DECLS
+#endif /* _VVAS_BENCH_H_ */
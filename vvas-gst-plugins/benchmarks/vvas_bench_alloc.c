@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * Counts heap allocations of the whole process by interposing glibc
+ * allocator entry points. Plug-ins, GLib and GStreamer are all resolved
+ * against these definitions, so the counters include allocations done in
+ * streaming threads of the element under test.
+ */
+
+#include <stdlib.h>
+#include "vvas_bench.h"
+
+#ifdef HAVE_LIBC_MALLOC
+
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t nmemb, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+
+/** Number of allocation calls */
+static guint64 alloc_calls;
+/** Number of bytes requested */
+static guint64 alloc_bytes;
+
+void *
+malloc (size_t size)
+{
+  __atomic_add_fetch (&alloc_calls, 1, __ATOMIC_RELAXED);
+  __atomic_add_fetch (&alloc_bytes, size, __ATOMIC_RELAXED);
+  return __libc_malloc (size);
+}
+
+void *
+calloc (size_t nmemb, size_t size)
+{
+  __atomic_add_fetch (&alloc_calls, 1, __ATOMIC_RELAXED);
+  __atomic_add_fetch (&alloc_bytes, nmemb * size, __ATOMIC_RELAXED);
+  return __libc_calloc (nmemb, size);
+}
+
+void *
+realloc (void *ptr, size_t size)
+{
+  __atomic_add_fetch (&alloc_calls, 1, __ATOMIC_RELAXED);
+  __atomic_add_fetch (&alloc_bytes, size, __ATOMIC_RELAXED);
+  return __libc_realloc (ptr, size);
+}
+
+/**
+ *  @fn gboolean vvas_bench_alloc_get_stats (VvasBenchAllocStats * stats)
+ *  @param [out] stats - Current allocation counters
+ *  @return TRUE when allocations are being counted, FALSE otherwise
+ *  @brief  Reads process wide heap allocation counters
+ */
+gboolean
+vvas_bench_alloc_get_stats (VvasBenchAllocStats * stats)
+{
+  stats->calls = __atomic_load_n (&alloc_calls, __ATOMIC_RELAXED);
+  stats->bytes = __atomic_load_n (&alloc_bytes, __ATOMIC_RELAXED);
+  return TRUE;
+}
+
+#else
+
+gboolean
+vvas_bench_alloc_get_stats (VvasBenchAllocStats * stats)
+{
+  stats->calls = 0;
+  stats->bytes = 0;
+  return FALSE;
+}
+
+#endif
@@ -27,14 +27,33 @@
 
 #include "gstinferenceprediction.h"
 
+#if defined(__GNUC__) && defined(__SSE2__)
+#define PREDICTION_SCALE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#define PREDICTION_SCALE_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* Below this number of entries a linear search is faster than hashing */
+#define MERGE_HASH_MIN_ENTRIES 8
+
+/* prediction_id -> prediction index of a tree, kept in the root of the
+ * tree once gst_inference_prediction_find was called on it */
+#define PREDICTION_INDEX(p) ((PredictionIndex *) (p)->reserved_1)
+
 static GType gst_inference_prediction_get_type (void);
 GST_DEFINE_MINI_OBJECT_TYPE (GstInferencePrediction, gst_inference_prediction);
 
-typedef struct _PredictionScaleData PredictionScaleData;
-struct _PredictionScaleData
+typedef struct _PredictionIndex PredictionIndex;
+struct _PredictionIndex
 {
-  GstVideoInfo *from;
-  GstVideoInfo *to;
+  /* Protects ids. Predictions of a tree are locked parent before child, so
+   * updates from any node of the tree can't take the lock of the root */
+  GMutex lock;
+  /* Predictions are not referenced, they are removed from the index before
+   * they leave the tree */
+  GHashTable *ids;
 };
 
 typedef struct _PredictionFindData PredictionFindData;
@@ -44,12 +63,19 @@ struct _PredictionFindData
   guint64 prediction_id;
 };
 
+typedef struct _PredictionScaleData PredictionScaleData;
+struct _PredictionScaleData
+{
+  GstVideoInfo *from;
+  GstVideoInfo *to;
+};
+
 static void gst_inference_prediction_free (GstInferencePrediction * self);
+static GstInferencePrediction *prediction_copy_full (const
+    GstInferencePrediction * self, gboolean share_classifications);
 static GstInferencePrediction *prediction_copy (const GstInferencePrediction *
     self);
 static void prediction_free (GstInferencePrediction * obj);
-static gboolean prediction_find (GstInferencePrediction * obj,
-    PredictionFindData * found);
 static GstInferencePrediction *prediction_find_unlocked (GstInferencePrediction
     * self, guint64 id);
 static void prediction_reset (GstInferencePrediction * self);
@@ -85,8 +111,17 @@ static gpointer node_copy (gconstpointer node, gpointer data);
 static gboolean node_scale_ip (VvasTreeNode * node, gpointer data);
 static gpointer node_scale (gconstpointer, gpointer data);
 static gboolean node_assign (VvasTreeNode * node, gpointer data);
-static gboolean node_find (VvasTreeNode * node, gpointer data);
 static gboolean node_get_enabled (VvasTreeNode * node, gpointer data);
+static gboolean node_index (VvasTreeNode * node, gpointer data);
+static gboolean node_unindex (VvasTreeNode * node, gpointer data);
+static gboolean node_find (VvasTreeNode * node, gpointer data);
+static PredictionIndex *prediction_get_index (GstInferencePrediction * self);
+static void prediction_index_free (PredictionIndex * index);
+static void prediction_index_update (PredictionIndex * index,
+    GstInferencePrediction * subtree, gboolean add);
+
+static void prediction_append_unlocked (GstInferencePrediction * self,
+    GstInferencePrediction * child);
 
 static void compute_factors (GstVideoInfo * from, GstVideoInfo * to,
     gdouble * hfactor, gdouble * vfactor);
@@ -112,6 +147,7 @@ gst_inference_prediction_new (void)
   self->prediction.model_name = NULL;
   self->prediction.model_class = VVAS_XCLASS_NOTFOUND;
   self->prediction.tb = NULL;
+  self->reserved_1 = NULL;
 
   prediction_reset (self);
 
@@ -160,9 +196,62 @@ gst_inference_prediction_append (GstInferencePrediction * self,
 
   GST_INFERENCE_PREDICTION_LOCK (self);
   GST_INFERENCE_PREDICTION_LOCK (child);
+  prediction_append_unlocked (self, child);
+  GST_INFERENCE_PREDICTION_UNLOCK (child);
+  GST_INFERENCE_PREDICTION_UNLOCK (self);
+}
+
+static void
+prediction_append_unlocked (GstInferencePrediction * self,
+    GstInferencePrediction * child)
+{
+  PredictionIndex *index;
+
+  /* Child is no longer a root, the tree it joins indexes it instead */
+  if (child->reserved_1) {
+    prediction_index_free (PREDICTION_INDEX (child));
+    child->reserved_1 = NULL;
+  }
+
   vvas_treenode_append (self->prediction.node, child->prediction.node);
+
+  index = prediction_get_index (self);
+  if (index)
+    prediction_index_update (index, child, TRUE);
+}
+
+gboolean
+gst_inference_prediction_remove (GstInferencePrediction * self,
+    GstInferencePrediction * child)
+{
+  PredictionIndex *index;
+
+  g_return_val_if_fail (self, FALSE);
+  g_return_val_if_fail (child, FALSE);
+
+  GST_INFERENCE_PREDICTION_LOCK (self);
+  GST_INFERENCE_PREDICTION_LOCK (child);
+
+  if (child->prediction.node->parent != self->prediction.node) {
+    GST_INFERENCE_PREDICTION_UNLOCK (child);
+    GST_INFERENCE_PREDICTION_UNLOCK (self);
+    return FALSE;
+  }
+
+  index = prediction_get_index (self);
+  if (index)
+    prediction_index_update (index, child, FALSE);
+
+  /* VvasTreeNode has the layout of GNode */
+  g_node_unlink ((GNode *) child->prediction.node);
+
   GST_INFERENCE_PREDICTION_UNLOCK (child);
   GST_INFERENCE_PREDICTION_UNLOCK (self);
+
+  /* Drop the reference the tree held */
+  gst_inference_prediction_unref (child);
+
+  return TRUE;
 }
 
 static GstInferenceClassification *
@@ -196,8 +285,15 @@ tb_copy (const GstInferencePrediction * self, GstInferencePrediction * other)
         (void **) &other->prediction.tb);
 }
 
+static GstInferenceClassification *
+classification_share (GstInferenceClassification * from, gpointer data)
+{
+  return gst_inference_classification_ref (from);
+}
+
 static GstInferencePrediction *
-prediction_copy (const GstInferencePrediction * self)
+prediction_copy_full (const GstInferencePrediction * self,
+    gboolean share_classifications)
 {
   GstInferencePrediction *other = NULL;
 
@@ -229,7 +325,7 @@ prediction_copy (const GstInferencePrediction * self)
   if (self->prediction.model_name)
     other->prediction.model_name = g_strdup (self->prediction.model_name);
 
-  other->reserved_1 = self->reserved_1;
+  /* reserved_1 is the index of the tree of self, it is not shared */
   other->reserved_2 = self->reserved_2;
   other->reserved_3 = self->reserved_3;
   other->reserved_4 = self->reserved_4;
@@ -237,11 +333,18 @@ prediction_copy (const GstInferencePrediction * self)
 
   other->prediction.classifications =
       vvas_list_copy_deep (self->prediction.classifications,
+      share_classifications ? (vvas_list_copy_func) classification_share :
       (vvas_list_copy_func) classification_copy, NULL);
 
   return other;
 }
 
+static GstInferencePrediction *
+prediction_copy (const GstInferencePrediction * self)
+{
+  return prediction_copy_full (self, FALSE);
+}
+
 static gpointer
 node_copy (gconstpointer node, gpointer data)
 {
@@ -424,7 +527,7 @@ node_get_children (VvasTreeNode * node, gpointer data)
 
   prediction = (GstInferencePrediction *) node->data;
 
-  *children = g_slist_append (*children, prediction);
+  *children = g_slist_prepend (*children, prediction);
 }
 
 static GSList *
@@ -439,7 +542,7 @@ prediction_get_children_unlocked (GstInferencePrediction * self)
         node_get_children, &children);
   }
 
-  return children;
+  return g_slist_reverse (children);
 }
 
 GSList *
@@ -480,8 +583,18 @@ bounding_box_reset (VvasBoundingBox * bbox)
 static void
 prediction_reset (GstInferencePrediction * self)
 {
+  PredictionIndex *index;
+
   g_return_if_fail (self);
 
+  /* Ids are about to change and children to be freed, the tree self is
+   * part of must forget them first */
+  if (self->prediction.node && self->prediction.node->parent) {
+    index = prediction_get_index (self);
+    if (index)
+      prediction_index_update (index, self, FALSE);
+  }
+
   self->prediction.prediction_id = vvas_inferprediction_get_prediction_id ();
   self->prediction.enabled = TRUE;
   self->prediction.bbox_scaled = FALSE;
@@ -501,7 +614,14 @@ prediction_reset (GstInferencePrediction * self)
 static void
 prediction_free (GstInferencePrediction * self)
 {
-  GSList *children = prediction_get_children_unlocked (self);
+  GSList *children = NULL;
+
+  if (self->reserved_1) {
+    prediction_index_free (PREDICTION_INDEX (self));
+    self->reserved_1 = NULL;
+  }
+
+  children = prediction_get_children_unlocked (self);
 
   /* Free all children recursively */
   g_slist_free_full (children, (GDestroyNotify) gst_inference_prediction_unref);
@@ -709,44 +829,251 @@ gst_inference_prediction_scale (GstInferencePrediction * self,
   return (GstInferencePrediction *) other->data;
 }
 
-static gboolean
-prediction_find (GstInferencePrediction * obj, PredictionFindData * found)
+/* Scales @bbox by the @num horizontal and vertical factors of @hfactor and
+ * @vfactor into the @num entries of @x, @y, @width and @height. Rounding is
+ * the one of prediction_scale(): offsets are truncated from the double
+ * product, sizes are rounded to nearest even from the float product. Two
+ * outputs are computed per vector, the last one of an odd @num in scalar */
+static void
+bbox_scale_batch (const VvasBoundingBox * bbox, const gdouble * hfactor,
+    const gdouble * vfactor, guint num, gint32 * x, gint32 * y,
+    gint32 * width, gint32 * height)
 {
-  gboolean ret = FALSE;
+  guint i = 0;
+#if defined(PREDICTION_SCALE_SSE2)
+  const __m128d bx = _mm_set1_pd (bbox->x);
+  const __m128d by = _mm_set1_pd (bbox->y);
+  const __m128d bw = _mm_set1_pd (bbox->width);
+  const __m128d bh = _mm_set1_pd (bbox->height);
+
+  for (; i + 2 <= num; i += 2) {
+    __m128d hf = _mm_loadu_pd (hfactor + i);
+    __m128d vf = _mm_loadu_pd (vfactor + i);
+
+    _mm_storel_epi64 ((__m128i *) (x + i),
+        _mm_cvttpd_epi32 (_mm_mul_pd (bx, hf)));
+    _mm_storel_epi64 ((__m128i *) (y + i),
+        _mm_cvttpd_epi32 (_mm_mul_pd (by, vf)));
+    _mm_storel_epi64 ((__m128i *) (width + i),
+        _mm_cvtps_epi32 (_mm_cvtpd_ps (_mm_mul_pd (bw, hf))));
+    _mm_storel_epi64 ((__m128i *) (height + i),
+        _mm_cvtps_epi32 (_mm_cvtpd_ps (_mm_mul_pd (bh, vf))));
+  }
+#elif defined(PREDICTION_SCALE_NEON)
+  const float64x2_t bx = vdupq_n_f64 (bbox->x);
+  const float64x2_t by = vdupq_n_f64 (bbox->y);
+  const float64x2_t bw = vdupq_n_f64 (bbox->width);
+  const float64x2_t bh = vdupq_n_f64 (bbox->height);
+
+  for (; i + 2 <= num; i += 2) {
+    float64x2_t hf = vld1q_f64 (hfactor + i);
+    float64x2_t vf = vld1q_f64 (vfactor + i);
+
+    vst1_s32 (x + i, vmovn_s64 (vcvtq_s64_f64 (vmulq_f64 (bx, hf))));
+    vst1_s32 (y + i, vmovn_s64 (vcvtq_s64_f64 (vmulq_f64 (by, vf))));
+    vst1_s32 (width + i, vcvtn_s32_f32 (vcvt_f32_f64 (vmulq_f64 (bw, hf))));
+    vst1_s32 (height + i, vcvtn_s32_f32 (vcvt_f32_f64 (vmulq_f64 (bh,
+                    vf))));
+  }
+#endif
 
-  g_return_val_if_fail (obj, TRUE);
-  g_return_val_if_fail (found, TRUE);
+  for (; i < num; i++) {
+    x[i] = bbox->x * hfactor[i];
+    y[i] = bbox->y * vfactor[i];
+    width[i] = nearbyintf (bbox->width * hfactor[i]);
+    height[i] = nearbyintf (bbox->height * vfactor[i]);
+  }
+}
 
-  if (obj->prediction.prediction_id == found->prediction_id) {
-    found->prediction = gst_inference_prediction_ref (obj);
-    ret = TRUE;
+/* Scales @self for all @num factors at once and appends the copies to
+ * @parents (when not NULL), recursing into the children of @self */
+static void
+prediction_scale_batch (const GstInferencePrediction * self,
+    const gdouble * hfactor, const gdouble * vfactor, guint num,
+    GstInferencePrediction ** parents, GstInferencePrediction ** dest)
+{
+  GstInferencePrediction **children = g_newa (GstInferencePrediction *, num);
+  gint32 *x = g_newa (gint32, num);
+  gint32 *y = g_newa (gint32, num);
+  gint32 *width = g_newa (gint32, num);
+  gint32 *height = g_newa (gint32, num);
+  VvasTreeNode *child;
+  guint i;
+
+  bbox_scale_batch (&self->prediction.bbox, hfactor, vfactor, num, x, y,
+      width, height);
+
+  for (i = 0; i < num; i++) {
+    dest[i] = prediction_copy_full (self, TRUE);
+    dest[i]->prediction.bbox.x = x[i];
+    dest[i]->prediction.bbox.y = y[i];
+    dest[i]->prediction.bbox.width = width[i];
+    dest[i]->prediction.bbox.height = height[i];
+
+    if (parents)
+      vvas_treenode_append (parents[i]->prediction.node,
+          dest[i]->prediction.node);
   }
 
-  return ret;
+  for (child = self->prediction.node->children; child != NULL;
+      child = child->next) {
+    prediction_scale_batch ((GstInferencePrediction *) child->data, hfactor,
+        vfactor, num, dest, children);
+  }
 }
 
+void
+gst_inference_prediction_scale_batch (GstInferencePrediction * self,
+    GstVideoInfo * from, GstVideoInfo ** to, guint num,
+    GstInferencePrediction ** dest)
+{
+  gdouble *hfactor, *vfactor;
+  guint i;
+
+  g_return_if_fail (self);
+  g_return_if_fail (from);
+  g_return_if_fail (to);
+  g_return_if_fail (dest);
+
+  if (!num)
+    return;
+
+  hfactor = g_newa (gdouble, num);
+  vfactor = g_newa (gdouble, num);
+  for (i = 0; i < num; i++)
+    compute_factors (from, to[i], &hfactor[i], &vfactor[i]);
+
+  GST_INFERENCE_PREDICTION_LOCK (self);
+  prediction_scale_batch (self, hfactor, vfactor, num, NULL, dest);
+  GST_INFERENCE_PREDICTION_UNLOCK (self);
+}
+
+/* Adds the prediction of node to the index data */
+static gboolean
+node_index (VvasTreeNode * node, gpointer data)
+{
+  PredictionIndex *index = (PredictionIndex *) data;
+  GstInferencePrediction *current = (GstInferencePrediction *) node->data;
+
+  g_hash_table_replace (index->ids, &current->prediction.prediction_id,
+      current);
+
+  return FALSE;
+}
+
+/* Removes the prediction of node from the index data, unless the id is
+ * indexed for another prediction */
+static gboolean
+node_unindex (VvasTreeNode * node, gpointer data)
+{
+  PredictionIndex *index = (PredictionIndex *) data;
+  GstInferencePrediction *current = (GstInferencePrediction *) node->data;
+
+  if (g_hash_table_lookup (index->ids,
+          &current->prediction.prediction_id) == current)
+    g_hash_table_remove (index->ids, &current->prediction.prediction_id);
+
+  return FALSE;
+}
+
+/* Stops the traversal at the prediction with the id data looks for */
 static gboolean
 node_find (VvasTreeNode * node, gpointer data)
 {
   PredictionFindData *found = (PredictionFindData *) data;
   GstInferencePrediction *current = (GstInferencePrediction *) node->data;
 
-  g_return_val_if_fail (found, TRUE);
+  if (current->prediction.prediction_id != found->prediction_id)
+    return FALSE;
+
+  found->prediction = current;
+  return TRUE;
+}
+
+/* Gets the index of the tree self is part of, NULL if the tree is not
+ * indexed */
+static PredictionIndex *
+prediction_get_index (GstInferencePrediction * self)
+{
+  VvasTreeNode *node = self->prediction.node;
+  GstInferencePrediction *root;
+
+  while (node->parent)
+    node = node->parent;
+  root = (GstInferencePrediction *) node->data;
 
-  return prediction_find (current, found);
+  return g_atomic_pointer_get (&root->reserved_1);
+}
+
+static void
+prediction_index_free (PredictionIndex * index)
+{
+  g_hash_table_unref (index->ids);
+  g_mutex_clear (&index->lock);
+  g_slice_free (PredictionIndex, index);
+}
+
+/* Adds or removes subtree and all of its descendants */
+static void
+prediction_index_update (PredictionIndex * index,
+    GstInferencePrediction * subtree, gboolean add)
+{
+  g_mutex_lock (&index->lock);
+  vvas_treenode_traverse (subtree->prediction.node, IN_ORDER, TRAVERSE_ALL,
+      -1, (vvas_treenode_traverse_func) (add ? node_index : node_unindex),
+      index);
+  g_mutex_unlock (&index->lock);
 }
 
 static GstInferencePrediction *
 prediction_find_unlocked (GstInferencePrediction * self, guint64 id)
 {
-  PredictionFindData found = { 0, id };
+  GstInferencePrediction *found = NULL;
+  PredictionIndex *index;
+  VvasTreeNode *node;
 
   g_return_val_if_fail (self, NULL);
 
-  vvas_treenode_traverse (self->prediction.node, IN_ORDER, TRAVERSE_ALL, -1,
-      (vvas_treenode_traverse_func) node_find, &found);
+  if (self->prediction.prediction_id == id)
+    return gst_inference_prediction_ref (self);
+
+  index = prediction_get_index (self);
+  if (!index && !self->prediction.node->parent) {
+    /* Index the tree once, it is kept in sync from then on. Appends which
+     * missed the index are seen by the traversal after it is published */
+    index = g_slice_new (PredictionIndex);
+    g_mutex_init (&index->lock);
+    index->ids = g_hash_table_new (g_int64_hash, g_int64_equal);
+    g_mutex_lock (&index->lock);
+    g_atomic_pointer_set (&self->reserved_1, index);
+    vvas_treenode_traverse (self->prediction.node, IN_ORDER, TRAVERSE_ALL, -1,
+        (vvas_treenode_traverse_func) node_index, index);
+    g_mutex_unlock (&index->lock);
+  }
+
+  if (!index) {
+    /* Subtree of a tree which is not indexed */
+    PredictionFindData data = { NULL, id };
+
+    vvas_treenode_traverse (self->prediction.node, IN_ORDER, TRAVERSE_ALL, -1,
+        (vvas_treenode_traverse_func) node_find, &data);
+    return data.prediction ? gst_inference_prediction_ref (data.prediction) :
+        NULL;
+  }
 
-  return found.prediction;
+  g_mutex_lock (&index->lock);
+  found = g_hash_table_lookup (index->ids, &id);
+  if (found) {
+    /* The index covers the whole tree, self may be any node of it */
+    for (node = found->prediction.node; node; node = node->parent) {
+      if (node == self->prediction.node)
+        break;
+    }
+    found = node ? gst_inference_prediction_ref (found) : NULL;
+  }
+  g_mutex_unlock (&index->lock);
+
+  return found;
 }
 
 GstInferencePrediction *
@@ -778,31 +1105,68 @@ classification_compare (gconstpointer a, gconstpointer b)
 static void
 classification_merge (GList * src, GList ** dst)
 {
+  GHashTable *ids = NULL;
   GList *iter = NULL;
+  GList *tail = NULL;
+  guint length = 0;
 
   g_return_if_fail (dst);
 
+  if (!src)
+    return;
+
+  /* Find the tail once, new classes are appended there */
+  for (tail = *dst; tail; tail = g_list_next (tail)) {
+    length++;
+    if (!tail->next)
+      break;
+  }
+
+  if (length >= MERGE_HASH_MIN_ENTRIES) {
+    ids = g_hash_table_new (g_int64_hash, g_int64_equal);
+    for (iter = *dst; iter; iter = g_list_next (iter)) {
+      GstInferenceClassification *c =
+          (GstInferenceClassification *) iter->data;
+      g_hash_table_add (ids, &c->classification.classification_id);
+    }
+  }
+
   /* For each classification in the src, see if it exists in the dst */
   for (iter = src; iter; iter = g_list_next (iter)) {
-    GList *exists =
-        g_list_find_custom (*dst, iter->data, classification_compare);
+    GstInferenceClassification *c = (GstInferenceClassification *) iter->data;
+    gboolean exists = ids ?
+        g_hash_table_contains (ids, &c->classification.classification_id) :
+        g_list_find_custom (*dst, c, classification_compare) != NULL;
 
     /* Copy and append it to the dst if it doesn't exist */
     if (!exists) {
       GstInferenceClassification *child =
-          gst_inference_classification_copy (iter->data);
-      *dst = g_list_append (*dst, child);
+          gst_inference_classification_copy (c);
+
+      if (tail) {
+        g_list_append (tail, child);
+        tail = tail->next;
+      } else {
+        *dst = tail = g_list_append (NULL, child);
+      }
+      if (ids)
+        g_hash_table_add (ids, &child->classification.classification_id);
     }
   }
+
+  if (ids)
+    g_hash_table_unref (ids);
 }
 
 static gboolean
 prediction_merge (GstInferencePrediction * src, GstInferencePrediction * dst)
 {
-  GSList *src_children = prediction_get_children_unlocked (src);
+  GHashTable *dst_children = NULL;
+  VvasTreeNode *child = NULL;
   GSList *iter = NULL;
   GSList *new_children = NULL;
   gboolean new_added = FALSE;
+  guint num_children = 0;
 
   g_return_val_if_fail (src, FALSE);
   g_return_val_if_fail (dst, FALSE);
@@ -818,39 +1182,68 @@ prediction_merge (GstInferencePrediction * src, GstInferencePrediction * dst)
   classification_merge ((GList *) src->prediction.classifications,
       (GList **) & dst->prediction.classifications);
 
-  /* Handle 2) here */
-  for (iter = src_children; iter; iter = g_slist_next (iter)) {
-    GstInferencePrediction *current = (GstInferencePrediction *) iter->data;
+  /* Handle 2) here. A child of src can only match an immediate child of
+   * dst, index them once when there are many */
+  for (child = dst->prediction.node->children; child; child = child->next)
+    num_children++;
+
+  if (num_children >= MERGE_HASH_MIN_ENTRIES) {
+    dst_children = g_hash_table_new (g_int64_hash, g_int64_equal);
+    for (child = dst->prediction.node->children; child; child = child->next) {
+      GstInferencePrediction *pred = (GstInferencePrediction *) child->data;
+      g_hash_table_insert (dst_children, &pred->prediction.prediction_id,
+          pred);
+    }
+  }
 
-    /* TODO: Optimize this by only searching the immediate children */
-    GstInferencePrediction *found =
-        prediction_find_unlocked (dst, current->prediction.prediction_id);
+  for (child = src->prediction.node->children; child; child = child->next) {
+    GstInferencePrediction *current = (GstInferencePrediction *) child->data;
+    GstInferencePrediction *found = NULL;
+
+    if (dst_children) {
+      found = g_hash_table_lookup (dst_children,
+          &current->prediction.prediction_id);
+    } else {
+      VvasTreeNode *dchild;
+
+      for (dchild = dst->prediction.node->children; dchild;
+          dchild = dchild->next) {
+        GstInferencePrediction *pred = (GstInferencePrediction *) dchild->data;
+
+        if (pred->prediction.prediction_id ==
+            current->prediction.prediction_id) {
+          found = pred;
+          break;
+        }
+      }
+    }
 
     /* No matching prediction, save it to append it later */
     if (!found) {
-      new_children = g_slist_append (new_children, current);
+      new_children = g_slist_prepend (new_children, current);
       continue;
     }
 
     /* Recurse into the children */
-    new_added = prediction_merge (current, found);
-
-    gst_inference_prediction_unref (found);
+    new_added |= prediction_merge (current, found);
   }
 
+  if (dst_children)
+    g_hash_table_unref (dst_children);
+
   /* Finally append all the new children to dst. Do it after all
      children have been processed */
+  new_children = g_slist_reverse (new_children);
   for (iter = new_children; iter; iter = g_slist_next (iter)) {
     GstInferencePrediction *prediction =
         gst_inference_prediction_copy ((GstInferencePrediction *) iter->data);
-    gst_inference_prediction_append (dst, prediction);
+    prediction_append_unlocked (dst, prediction);
   }
 
   new_added |= new_children ? TRUE : FALSE;
 
-  g_slist_free (src_children);
-  g_slist_free_full (new_children,
-      (GDestroyNotify) gst_inference_prediction_unref);
+  /* Children of src are not referenced by the list */
+  g_slist_free (new_children);
 
   return new_added;
 }
@@ -918,3 +1311,35 @@ gst_inference_prediction_get_enabled (GstInferencePrediction * self)
 
   return found;
 }
+
+static void
+prediction_get_boxes (GstInferencePrediction * self, gboolean enabled_only,
+    GSList ** found)
+{
+  GSList *children = gst_inference_prediction_get_children (self);
+  GSList *iter;
+
+  for (iter = children; iter; iter = g_slist_next (iter)) {
+    GstInferencePrediction *child = (GstInferencePrediction *) iter->data;
+
+    if ((!enabled_only || child->prediction.enabled) &&
+        child->prediction.bbox.width && child->prediction.bbox.height)
+      *found = g_slist_prepend (*found, child);
+    prediction_get_boxes (child, enabled_only, found);
+  }
+
+  g_slist_free (children);
+}
+
+GSList *
+gst_inference_prediction_get_boxes (GstInferencePrediction * self,
+    gboolean enabled_only)
+{
+  GSList *found = NULL;
+
+  g_return_val_if_fail (self, NULL);
+
+  prediction_get_boxes (self, enabled_only, &found);
+
+  return found;
+}
@@ -72,8 +72,9 @@ struct _GstInferencePrediction
   /** buffer contains cropped images for cascade usecase */
   GstBuffer *sub_buffer;
   
-	/** for future extension */
+  /** prediction_id index of the tree, built by gst_inference_prediction_find */
   void *reserved_1;
+	/** for future extension */
   void *reserved_2;
   void *reserved_3;
   void *reserved_4;
@@ -173,6 +174,20 @@ gchar *gst_inference_prediction_to_string (GstInferencePrediction * self);
 void gst_inference_prediction_append (GstInferencePrediction * self,
     GstInferencePrediction * child);
 
+/**
+ * gst_inference_prediction_remove:
+ * @self: the parent prediction
+ * @child: the immediate child prediction to remove
+ *
+ * Removes a child prediction, along with its own children, from the
+ * parent prediction. The reference the parent held is dropped, use
+ * gst_inference_prediction_ref() before if you wish to keep the child.
+ *
+ * Returns: TRUE if @child was removed, FALSE if it is not a child of @self.
+ */
+gboolean gst_inference_prediction_remove (GstInferencePrediction * self,
+    GstInferencePrediction * child);
+
 /**
  * gst_inference_prediction_get_children:
  * @self: the parent prediction
@@ -226,6 +241,25 @@ GstInferencePrediction *gst_inference_prediction_scale (GstInferencePrediction *
 void gst_inference_prediction_scale_ip (GstInferencePrediction * self,
     GstVideoInfo * to, GstVideoInfo * from);
 
+/**
+ * gst_inference_prediction_scale_batch:
+ * @self: the prediction to scale
+ * @from: the original image size
+ * @to: array of @num resulting image sizes
+ * @num: number of resulting image sizes
+ * @dest: array of @num, filled with a newly allocated scaled prediction
+ * for each of @to
+ *
+ * Same as calling gst_inference_prediction_scale() for each of @to, but
+ * the prediction tree is walked only once. This is meant for elements
+ * producing multiple resolutions of the same frame. Classifications are
+ * shared between @self and the scaled predictions instead of being
+ * copied, so they must not be modified.
+ */
+void gst_inference_prediction_scale_batch (GstInferencePrediction * self,
+    GstVideoInfo * from, GstVideoInfo ** to, guint num,
+    GstInferencePrediction ** dest);
+
 /**
  * gst_inference_prediction_find:
  * @self: the root prediction
@@ -250,6 +284,21 @@ GstInferencePrediction *gst_inference_prediction_find (GstInferencePrediction *
  */
 GList *gst_inference_prediction_get_enabled (GstInferencePrediction * self);
 
+/**
+ * gst_inference_prediction_get_boxes:
+ * @self: the root prediction
+ * @enabled_only: leave out disabled predictions, their children are still
+ * visited
+ *
+ * Traverses the prediction tree below @self saving the predictions that
+ * have a bounding box, i.e. a non zero width and height. @self itself is
+ * not part of the result. The references are still owned by the tree.
+ *
+ * Returns: a GSList of predictions with a bounding box.
+ */
+GSList *gst_inference_prediction_get_boxes (GstInferencePrediction * self,
+    gboolean enabled_only);
+
 /**
  * gst_inference_prediction_merge:
  * @src: the source prediction
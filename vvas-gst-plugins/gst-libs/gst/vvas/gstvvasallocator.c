@@ -21,8 +21,10 @@
 
 #include <vvas_core/vvas_device.h>
 #include "gstvvasallocator.h"
+#include "gstvvastrace.h"
 #include <sys/mman.h>
 #include <string.h>
+#include <unistd.h>
 #include <gst/allocators/gstdmabuf.h>
 #include <gst/gstpoll.h>
 
@@ -56,6 +58,11 @@ GST_DEBUG_CATEGORY_STATIC (GST_CAT_DEFAULT);
  */
 #define DEFAULT_INIT_VALUE 0
 
+/** @def VVAS_HUGEPAGE_SIZE
+ *  @brief Size of a transparent huge page, memories smaller than this are not advised
+ */
+#define VVAS_HUGEPAGE_SIZE (2 * 1024 * 1024)
+
 /**  @brief  Contains properties related to VVAS allocator
  */
 enum
@@ -68,7 +75,9 @@ enum
   /** Memory bank index property ID */
   PROP_MEM_BANK,
   /** Initial buffer value property ID*/
-  PROP_INIT_VALUE
+  PROP_INIT_VALUE,
+  /** DMA transfer statistics property ID */
+  PROP_STATS
 };
 
 /** @brief  Contains signals those will be emitted by VVAS allocator
@@ -109,6 +118,8 @@ struct _GstVvasAllocatorPrivate
   guint max_mem;
   /** Initial Buffer value */
   gint init_value;
+  /** DMA transfers of memories allocated by this allocator */
+  GstVvasMemStats stats;
 };
 
 /** @struct GstVvasMemory
@@ -135,6 +146,10 @@ typedef struct _GstVvasMemory
   gboolean do_free;
   /** Sync flags to device whether data need to synced (DMA transfer) between FPGA device and Host */
   VvasSyncFlags sync_flags;
+  /** Host mapping created at allocation with GST_VVAS_ALLOCATOR_FLAG_PREFAULT, kept until free */
+  gpointer prefault_data;
+  /** TRUE if \p prefault_data is locked in RAM */
+  gboolean pinned;
 } GstVvasMemory;
 
 static guint gst_vvas_allocator_signals[LAST_SIGNAL] = { 0 };
@@ -216,6 +231,86 @@ vvas_allocator_memory_dispose (GstMiniObject * obj)
   return TRUE;
 }
 
+/**
+ *  @fn static void gst_vvas_allocator_prefault (GstVvasAllocator * vvas_alloc,
+ *                                               GstVvasMemory * vvasmem,
+ *                                               gpointer data)
+ *  @param [in] vvas_alloc - Pointer allocator object
+ *  @param [in] vvasmem - Memory to be pre-faulted
+ *  @param [in] data - Host mapping of \p vvasmem if already mapped, else NULL
+ *  @return None
+ *  @brief  Maps \p vvasmem to host and populates page tables of the mapping
+ *  @details Mapping is advised to use huge pages when large enough, populated and locked
+ *           in RAM. Device memory mappings (VM_IO/VM_PFNMAP) can neither be populated by
+ *           madvise nor locked, every page is touched for them instead. The mapping is
+ *           kept until memory is freed, so CPU accesses of new frames do not fault.
+ */
+static void
+gst_vvas_allocator_prefault (GstVvasAllocator * vvas_alloc,
+    GstVvasMemory * vvasmem, gpointer data)
+{
+  GstVvasMemStats *stats = &vvas_alloc->priv->stats;
+  GstClockTime start = gst_util_get_timestamp ();
+  gsize hugepage_bytes = 0;
+  gsize page_size, offset;
+  gboolean populated = FALSE;
+
+  if (!data)
+    data = vvas_xrt_map_bo (vvasmem->bo, true);
+  if (!data) {
+    GST_WARNING_OBJECT (vvas_alloc, "failed to map bo %p to pre-fault it",
+        vvasmem->bo);
+    return;
+  }
+
+#ifdef MADV_HUGEPAGE
+  /* only the huge page aligned part of the mapping can be backed by them.
+   * Device memory mappings refuse the advice, which is fine */
+  if (vvasmem->size >= VVAS_HUGEPAGE_SIZE) {
+    guintptr begin = GST_ROUND_UP_N ((guintptr) data, VVAS_HUGEPAGE_SIZE);
+    guintptr end =
+        GST_ROUND_DOWN_N ((guintptr) data + vvasmem->size, VVAS_HUGEPAGE_SIZE);
+
+    if (end > begin && !madvise ((void *) begin, end - begin, MADV_HUGEPAGE))
+      hugepage_bytes = end - begin;
+  }
+#endif
+
+#ifdef MADV_POPULATE_WRITE
+  /* refused for device memory mappings and by kernels older than 5.14 */
+  populated = !madvise (data, vvasmem->size, MADV_POPULATE_WRITE);
+#endif
+  if (!populated) {
+    GST_LOG_OBJECT (vvas_alloc, "failed to populate %p, touching pages",
+        data);
+    page_size = sysconf (_SC_PAGESIZE);
+    for (offset = 0; offset < vvasmem->size; offset += page_size)
+      (void) ((volatile guint8 *) data)[offset];
+  }
+
+  /* mlock silently skips device memory mappings, so it is only trusted for
+   * memory madvise could populate */
+  vvasmem->pinned = !mlock (data, vvasmem->size);
+  if (!vvasmem->pinned)
+    GST_LOG_OBJECT (vvas_alloc, "failed to pin %p: %s", data,
+        strerror (errno));
+
+  vvasmem->prefault_data = data;
+
+  g_mutex_lock (&stats->lock);
+  stats->prefaulted++;
+  stats->prefaulted_bytes += vvasmem->size;
+  if (vvasmem->pinned && populated)
+    stats->pinned_bytes += vvasmem->size;
+  stats->hugepage_bytes += hugepage_bytes;
+  stats->prefault_time += gst_util_get_timestamp () - start;
+  g_mutex_unlock (&stats->lock);
+
+  GST_DEBUG_OBJECT (vvas_alloc, "pre-faulted %p of size %lu, populated %d, "
+      "pinned %d, huge pages %lu bytes", data, vvasmem->size, populated,
+      vvasmem->pinned, hugepage_bytes);
+}
+
 /**
  *  @fn static GstMemory *gst_vvas_allocator_alloc (GstAllocator * allocator,
  *                                                  gsize size,
@@ -341,10 +436,17 @@ gst_vvas_allocator_alloc (GstAllocator * allocator, gsize size,
         //vvas_xrt_unmap_bo(priv->handle, vvasmem->bo, data);
         return NULL;
       }
+      gst_vvas_trace_value (GST_OBJECT (vvas_alloc),
+          GST_VVAS_TRACE_SYNC_TO_DEVICE, size);
+      gst_vvas_mem_stats_add_sync (&priv->stats, VVAS_SYNC_TO_DEVICE, size);
       //vvas_xrt_unmap_bo(priv->handle, vvasmem->bo, data);
     }
   }
 
+  /* reuses the mapping made for initialization, if any */
+  if (params->flags & GST_VVAS_ALLOCATOR_FLAG_PREFAULT)
+    gst_vvas_allocator_prefault (vvas_alloc, vvasmem, data);
+
   /* Creates DMA fd corresponding to XRT BO.
    * Currently DMA fd is supported only in Embedded platforms only */
   if (priv->need_dma) {
@@ -409,8 +511,24 @@ gst_vvas_mem_map (GstMemory * mem, gsize maxsize, GstMapFlags flags)
     return NULL;
   }
 
-  /* Mapping memory to user space on host */
-  vvasmem->data = vvas_xrt_map_bo (vvasmem->bo, flags & GST_MAP_WRITE);
+  /* Mapping memory to user space on host, pre-faulted mapping is mapped
+   * for write already */
+  if (vvasmem->prefault_data) {
+    vvasmem->data = vvasmem->prefault_data;
+  } else {
+    vvasmem->data = vvas_xrt_map_bo (vvasmem->bo, flags & GST_MAP_WRITE);
+  }
+
+  if (vvasmem->data) {
+    GstVvasMemStats *stats = &alloc->priv->stats;
+
+    g_mutex_lock (&stats->lock);
+    if (vvasmem->prefault_data)
+      stats->prefaulted_maps++;
+    else
+      stats->maps++;
+    g_mutex_unlock (&stats->lock);
+  }
   GST_DEBUG_OBJECT (alloc, "mapped pointer %p with size %lu do_write %d",
       vvasmem->data, maxsize, flags & GST_MAP_WRITE);
 
@@ -465,6 +583,7 @@ gst_vvas_mem_share (GstMemory * mem, gssize offset, gssize size)
   sub->size = vvasmem->size;
 
   sub->sync_flags = vvasmem->sync_flags;
+  sub->prefault_data = vvasmem->prefault_data;
 
   GST_DEBUG ("%p: share mem created", sub);
 
@@ -491,10 +610,12 @@ gst_vvas_mem_unmap (GstMemory * mem)
   g_mutex_lock (&vvasmem->lock);
   /* unmap memory only if there is no references to it */
   if (vvasmem->data && !(--vvasmem->mmap_count)) {
-    /* unmap memory using XRT API */
-    ret = vvas_xrt_unmap_bo (vvasmem->bo, vvasmem->data);
-    if (ret) {
-      GST_ERROR ("failed to unmap %p", vvasmem->data);
+    /* unmap memory using XRT API, pre-faulted mapping is kept until free */
+    if (vvasmem->data != vvasmem->prefault_data) {
+      ret = vvas_xrt_unmap_bo (vvasmem->bo, vvasmem->data);
+      if (ret) {
+        GST_ERROR ("failed to unmap %p", vvasmem->data);
+      }
     }
     vvasmem->data = NULL;
     vvasmem->mmapping_flags = 0;
@@ -517,8 +638,14 @@ gst_vvas_allocator_free (GstAllocator * allocator, GstMemory * mem)
   GstVvasAllocator *alloc = GST_VVAS_ALLOCATOR (allocator);
 
   /* free memory using XRT API if its not a sub buffer */
-  if (vvasmem->bo != NULL && mem->parent == NULL)
+  if (vvasmem->bo != NULL && mem->parent == NULL) {
+    if (vvasmem->prefault_data) {
+      if (vvasmem->pinned)
+        munlock (vvasmem->prefault_data, vvasmem->size);
+      vvas_xrt_unmap_bo (vvasmem->bo, vvasmem->prefault_data);
+    }
     vvas_xrt_free_bo (vvasmem->bo);
+  }
 
   GST_DEBUG ("freeing mem: %p", mem);
 
@@ -544,6 +671,12 @@ static void
 gst_vvas_allocator_finalize (GObject * obj)
 {
   GstVvasAllocator *alloc = GST_VVAS_ALLOCATOR (obj);
+  GstStructure *stats;
+
+  stats = gst_vvas_mem_stats_to_structure (&alloc->priv->stats);
+  GST_CAT_INFO_OBJECT (GST_CAT_PERFORMANCE, alloc, "%" GST_PTR_FORMAT, stats);
+  gst_structure_free (stats);
+  gst_vvas_mem_stats_clear (&alloc->priv->stats);
 
   if (alloc->priv->dmabuf_alloc)
     gst_object_unref (alloc->priv->dmabuf_alloc);
@@ -599,6 +732,37 @@ gst_vvas_allocator_set_property (GObject * object, guint prop_id,
   }
 }
 
+/**
+ *  @fn static void gst_vvas_allocator_get_property (GObject * object,
+ *                                                   guint prop_id,
+ *                                                   GValue * value,
+ *                                                   GParamSpec * pspec)
+ *  @param [in] object - Handle to GstVvasAllocator typecasted to GObject
+ *  @param [in] prop_id - Property ID value
+ *  @param [out] value - GValue which holds property value
+ *  @param [in] pspec - Handle to metadata of a property with property ID \p prop_id
+ *  @return None
+ *  @brief This API gives out values of readable GstVvasAllocator properties.
+ *  @details This API is registered with GObjectClass by overriding GObjectClass::get_property function
+ *           pointer and this will be invoked when developer gets properties on GstVvasAllocator object.
+ */
+static void
+gst_vvas_allocator_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstVvasAllocator *alloc = GST_VVAS_ALLOCATOR (object);
+
+  switch (prop_id) {
+    case PROP_STATS:
+      g_value_take_boxed (value,
+          gst_vvas_mem_stats_to_structure (&alloc->priv->stats));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
 /**
  *  @fn static void gst_vvas_allocator_class_init (GstVvasAllocatorClass * klass)
  *  @param [in]klass  - Handle to GstVvasAllocatorClass
@@ -621,6 +785,7 @@ gst_vvas_allocator_class_init (GstVvasAllocatorClass * klass)
 
   gobject_class->finalize = gst_vvas_allocator_finalize;
   gobject_class->set_property = gst_vvas_allocator_set_property;
+  gobject_class->get_property = gst_vvas_allocator_get_property;
 
   allocator_class->free = gst_vvas_allocator_free;
   allocator_class->alloc = gst_vvas_allocator_alloc;
@@ -646,6 +811,12 @@ gst_vvas_allocator_class_init (GstVvasAllocatorClass * klass)
           G_MAXINT, DEFAULT_INIT_VALUE,
           G_PARAM_WRITABLE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "DMA transfer statistics",
+          "Number and bytes of DMA transfers between host and device and "
+          "of host mappings",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gst_vvas_allocator_signals[VVAS_MEM_RELEASED] =
       g_signal_new ("vvas-mem-released", G_TYPE_FROM_CLASS (gobject_class),
       G_SIGNAL_RUN_LAST, 0, NULL, NULL, NULL, G_TYPE_NONE, 1, GST_TYPE_MEMORY);
@@ -684,6 +855,7 @@ gst_vvas_allocator_init (GstVvasAllocator * allocator)
   allocator->priv->active = FALSE;
   allocator->priv->free_queue = NULL;
   allocator->priv->init_value = DEFAULT_INIT_VALUE;
+  gst_vvas_mem_stats_init (&allocator->priv->stats);
 
   GST_OBJECT_FLAG_SET (allocator, GST_ALLOCATOR_FLAG_CUSTOM_ALLOC);
 }
@@ -795,6 +967,11 @@ gst_vvas_allocator_start (GstVvasAllocator * vvas_alloc, guint min_mem,
 
   gst_poll_write_control (priv->poll);
 
+  if (params->flags & GST_VVAS_ALLOCATOR_FLAG_PREFAULT) {
+    GST_INFO_OBJECT (vvas_alloc, "pre-faulted %u memories in %" GST_TIME_FORMAT,
+        min_mem, GST_TIME_ARGS (priv->stats.prefault_time));
+  }
+
   /* activate memory free queue */
   g_atomic_int_set (&priv->active, TRUE);
 
@@ -1047,6 +1224,10 @@ gst_vvas_memory_sync_with_flags (GstMemory * mem, GstMapFlags flags)
           iret, strerror (errno));
       return FALSE;
     }
+    gst_vvas_trace_value (GST_OBJECT (alloc), GST_VVAS_TRACE_SYNC_FROM_DEVICE,
+        vvasmem->size);
+    gst_vvas_mem_stats_add_sync (&alloc->priv->stats, VVAS_SYNC_FROM_DEVICE,
+        vvasmem->size);
     /* disable the sync flag after sync operation is completed */
     vvasmem->sync_flags &= ~VVAS_SYNC_FROM_DEVICE;
   }
@@ -1072,6 +1253,19 @@ gst_vvas_memory_sync_with_flags (GstMemory * mem, GstMapFlags flags)
  */
 gboolean
 gst_vvas_memory_sync_bo (GstMemory * mem)
+{
+  return gst_vvas_memory_sync_bo_full (mem, NULL);
+}
+
+/**
+ *  @fn gboolean gst_vvas_memory_sync_bo_full (GstMemory * mem, GstVvasMemStats * stats)
+ *  @param [in] mem - Pointer to GstMemory object
+ *  @param [in] stats - Counters of the caller to account the transfer in, may be NULL
+ *  @return TRUE on success.\n FALSE on failure
+ *  @brief Same as gst_vvas_memory_sync_bo, additionally accounting the transfer in \p stats
+ */
+gboolean
+gst_vvas_memory_sync_bo_full (GstMemory * mem, GstVvasMemStats * stats)
 {
   GstVvasMemory *vvasmem;
   GstVvasAllocator *alloc;
@@ -1112,6 +1306,12 @@ gst_vvas_memory_sync_bo (GstMemory * mem)
           strerror (errno));
       return FALSE;
     }
+    gst_vvas_trace_value (GST_OBJECT (alloc), GST_VVAS_TRACE_SYNC_TO_DEVICE,
+        vvasmem->size);
+    gst_vvas_mem_stats_add_sync (&alloc->priv->stats, VVAS_SYNC_TO_DEVICE,
+        vvasmem->size);
+    if (stats)
+      gst_vvas_mem_stats_add_sync (stats, VVAS_SYNC_TO_DEVICE, vvasmem->size);
     /* unset flag after successful transfer */
     vvasmem->sync_flags &= ~VVAS_SYNC_TO_DEVICE;
   }
@@ -1180,3 +1380,158 @@ gst_vvas_memory_reset_sync_flag (GstMemory * mem)
 
   vvasmem->sync_flags = VVAS_SYNC_NONE;
 }
+
+/** Names of copy reasons used in statistics, indexed by GstVvasCopyReason */
+static const gchar *copy_reason_names[GST_VVAS_COPY_REASON_COUNT] = {
+  "stride",
+  "foreign-memory",
+  "bank-mismatch",
+};
+
+/**
+ *  @fn void gst_vvas_mem_stats_init (GstVvasMemStats * stats)
+ *  @param [in] stats - Counters to be initialized
+ *  @return None
+ *  @brief Initializes counters to zero
+ */
+void
+gst_vvas_mem_stats_init (GstVvasMemStats * stats)
+{
+  memset (stats, 0x0, sizeof (GstVvasMemStats));
+  g_mutex_init (&stats->lock);
+}
+
+/**
+ *  @fn void gst_vvas_mem_stats_clear (GstVvasMemStats * stats)
+ *  @param [in] stats - Counters initialized by gst_vvas_mem_stats_init
+ *  @return None
+ *  @brief Frees resources held by counters
+ */
+void
+gst_vvas_mem_stats_clear (GstVvasMemStats * stats)
+{
+  g_mutex_clear (&stats->lock);
+}
+
+/**
+ *  @fn void gst_vvas_mem_stats_add_copy (GstVvasMemStats * stats, GstVvasCopyReason reason, gsize bytes)
+ *  @param [in] stats - Counters to be updated
+ *  @param [in] reason - Reason of the copy
+ *  @param [in] bytes - Number of bytes copied
+ *  @return None
+ *  @brief Accounts a slow copy of a frame
+ */
+void
+gst_vvas_mem_stats_add_copy (GstVvasMemStats * stats,
+    GstVvasCopyReason reason, gsize bytes)
+{
+  g_return_if_fail (reason < GST_VVAS_COPY_REASON_COUNT);
+
+  g_mutex_lock (&stats->lock);
+  stats->copies[reason]++;
+  stats->copy_bytes[reason] += bytes;
+  g_mutex_unlock (&stats->lock);
+}
+
+/**
+ *  @fn void gst_vvas_mem_stats_add_sync (GstVvasMemStats * stats, VvasSyncFlags direction, gsize bytes)
+ *  @param [in] stats - Counters to be updated
+ *  @param [in] direction - VVAS_SYNC_TO_DEVICE or VVAS_SYNC_FROM_DEVICE
+ *  @param [in] bytes - Number of bytes transferred
+ *  @return None
+ *  @brief Accounts a DMA transfer between host and device
+ */
+void
+gst_vvas_mem_stats_add_sync (GstVvasMemStats * stats,
+    VvasSyncFlags direction, gsize bytes)
+{
+  g_mutex_lock (&stats->lock);
+  if (direction & VVAS_SYNC_TO_DEVICE) {
+    stats->sync_to_dev++;
+    stats->sync_to_dev_bytes += bytes;
+  }
+  if (direction & VVAS_SYNC_FROM_DEVICE) {
+    stats->sync_from_dev++;
+    stats->sync_from_dev_bytes += bytes;
+  }
+  g_mutex_unlock (&stats->lock);
+}
+
+/**
+ *  @fn GstStructure * gst_vvas_mem_stats_to_structure (GstVvasMemStats * stats)
+ *  @param [in] stats - Counters to be read
+ *  @return New GstStructure "vvas-mem-stats" holding all counters
+ *  @brief Snapshot of counters, used by "stats" properties
+ *  @details Besides transfers and copies, reports host mappings created on map and
+ *           pre-faulted at allocation with GST_VVAS_ALLOCATOR_FLAG_PREFAULT
+ */
+GstStructure *
+gst_vvas_mem_stats_to_structure (GstVvasMemStats * stats)
+{
+  GstStructure *s;
+  guint64 copies = 0, copy_bytes = 0;
+  guint i;
+
+  g_mutex_lock (&stats->lock);
+  s = gst_structure_new ("vvas-mem-stats",
+      "sync-to-device", G_TYPE_UINT64, stats->sync_to_dev,
+      "sync-to-device-bytes", G_TYPE_UINT64, stats->sync_to_dev_bytes,
+      "sync-from-device", G_TYPE_UINT64, stats->sync_from_dev,
+      "sync-from-device-bytes", G_TYPE_UINT64, stats->sync_from_dev_bytes,
+      NULL);
+
+  for (i = 0; i < GST_VVAS_COPY_REASON_COUNT; i++) {
+    gchar *field;
+
+    field = g_strdup_printf ("copies-%s", copy_reason_names[i]);
+    gst_structure_set (s, field, G_TYPE_UINT64, stats->copies[i], NULL);
+    g_free (field);
+    field = g_strdup_printf ("copy-bytes-%s", copy_reason_names[i]);
+    gst_structure_set (s, field, G_TYPE_UINT64, stats->copy_bytes[i], NULL);
+    g_free (field);
+
+    copies += stats->copies[i];
+    copy_bytes += stats->copy_bytes[i];
+  }
+  gst_structure_set (s, "maps", G_TYPE_UINT64, stats->maps,
+      "prefaulted-maps", G_TYPE_UINT64, stats->prefaulted_maps,
+      "prefaulted", G_TYPE_UINT64, stats->prefaulted,
+      "prefaulted-bytes", G_TYPE_UINT64, stats->prefaulted_bytes,
+      "pinned-bytes", G_TYPE_UINT64, stats->pinned_bytes,
+      "hugepage-bytes", G_TYPE_UINT64, stats->hugepage_bytes,
+      "prefault-time", G_TYPE_UINT64, stats->prefault_time, NULL);
+  g_mutex_unlock (&stats->lock);
+
+  gst_structure_set (s, "copies", G_TYPE_UINT64, copies,
+      "copy-bytes", G_TYPE_UINT64, copy_bytes, NULL);
+
+  return s;
+}
+
+/**
+ *  @fn void gst_vvas_mem_stats_dump (GstVvasMemStats * stats, GstElement * element)
+ *  @param [in] stats - Counters to be reported
+ *  @param [in] element - Element owning \p stats
+ *  @return None
+ *  @brief Logs counters and posts them as "vvas-mem-stats" element message on the bus,
+ *         elements call this on EOS
+ */
+void
+gst_vvas_mem_stats_dump (GstVvasMemStats * stats, GstElement * element)
+{
+  GstStructure *s = gst_vvas_mem_stats_to_structure (stats);
+  guint64 copies = 0;
+
+  /* element may be software only and never have created an allocator */
+  GST_DEBUG_CATEGORY_GET (GST_CAT_PERFORMANCE, "GST_PERFORMANCE");
+
+  gst_structure_get_uint64 (s, "copies", &copies);
+  if (copies)
+    GST_CAT_WARNING_OBJECT (GST_CAT_PERFORMANCE, element,
+        "%" G_GUINT64_FORMAT " slow copies: %" GST_PTR_FORMAT, copies, s);
+  else
+    GST_CAT_INFO_OBJECT (GST_CAT_PERFORMANCE, element, "%" GST_PTR_FORMAT, s);
+
+  gst_element_post_message (element,
+      gst_message_new_element (GST_OBJECT (element), s));
+}
@@ -75,6 +75,10 @@ enum _GstVvasAllocatorFlags
   /** Return from alloc function without wait, when number of memory objects limit is reached &
    * memory objects are not present in free queue */
   GST_VVAS_ALLOCATOR_FLAG_DONTWAIT = (GST_ALLOCATOR_FLAG_LAST << 1),
+  /** Map memory to host at allocation, advise huge pages for large memories, pin and
+   * pre-fault the mapping and keep it until memory is freed. Useful for memories
+   * accessed by CPU, as first access does not take page faults */
+  GST_VVAS_ALLOCATOR_FLAG_PREFAULT = (GST_ALLOCATOR_FLAG_LAST << 2),
 };
 
 struct _GstVvasAllocator
@@ -284,6 +288,126 @@ VvasSyncFlags gst_vvas_memory_get_sync_flag (GstMemory * mem);
 GST_EXPORT
 void gst_vvas_memory_reset_sync_flag (GstMemory * mem);
 
+/** @enum GstVvasCopyReason
+ *  @brief Reasons for copying a frame instead of handing it to the device
+ */
+typedef enum {
+  /** Stride or padding of the buffer does not match the IP requirement */
+  GST_VVAS_COPY_REASON_STRIDE,
+  /** Buffer is not backed by memory the device can access */
+  GST_VVAS_COPY_REASON_FOREIGN_MEMORY,
+  /** Buffer is allocated on another device or memory bank */
+  GST_VVAS_COPY_REASON_BANK_MISMATCH,
+  /** Number of copy reasons */
+  GST_VVAS_COPY_REASON_COUNT
+} GstVvasCopyReason;
+
+/** @struct GstVvasMemStats
+ *  @brief Counters of DMA transfers and slow copies of an allocator or element
+ */
+typedef struct {
+  /** Protects the counters */
+  GMutex lock;
+  /** Number of host to device transfers */
+  guint64 sync_to_dev;
+  /** Bytes transferred from host to device */
+  guint64 sync_to_dev_bytes;
+  /** Number of device to host transfers */
+  guint64 sync_from_dev;
+  /** Bytes transferred from device to host */
+  guint64 sync_from_dev_bytes;
+  /** Number of slow copies, indexed by GstVvasCopyReason */
+  guint64 copies[GST_VVAS_COPY_REASON_COUNT];
+  /** Bytes copied, indexed by GstVvasCopyReason */
+  guint64 copy_bytes[GST_VVAS_COPY_REASON_COUNT];
+  /** Number of host mappings created on map */
+  guint64 maps;
+  /** Number of maps served by a pre-faulted mapping */
+  guint64 prefaulted_maps;
+  /** Number of memories pre-faulted at allocation */
+  guint64 prefaulted;
+  /** Bytes pre-faulted at allocation */
+  guint64 prefaulted_bytes;
+  /** Bytes of pre-faulted mappings populated and pinned in RAM */
+  guint64 pinned_bytes;
+  /** Bytes of pre-faulted mappings advised to be backed by huge pages */
+  guint64 hugepage_bytes;
+  /** Time spent pre-faulting mappings */
+  GstClockTime prefault_time;
+} GstVvasMemStats;
+
+/**
+ *  @fn void gst_vvas_mem_stats_init (GstVvasMemStats * stats)
+ *  @param [in] stats - Counters to be initialized
+ *  @return None
+ *  @brief Initializes counters to zero
+ */
+GST_EXPORT
+void gst_vvas_mem_stats_init (GstVvasMemStats * stats);
+
+/**
+ *  @fn void gst_vvas_mem_stats_clear (GstVvasMemStats * stats)
+ *  @param [in] stats - Counters initialized by gst_vvas_mem_stats_init
+ *  @return None
+ *  @brief Frees resources held by counters
+ */
+GST_EXPORT
+void gst_vvas_mem_stats_clear (GstVvasMemStats * stats);
+
+/**
+ *  @fn void gst_vvas_mem_stats_add_copy (GstVvasMemStats * stats, GstVvasCopyReason reason, gsize bytes)
+ *  @param [in] stats - Counters to be updated
+ *  @param [in] reason - Reason of the copy
+ *  @param [in] bytes - Number of bytes copied
+ *  @return None
+ *  @brief Accounts a slow copy of a frame
+ */
+GST_EXPORT
+void gst_vvas_mem_stats_add_copy (GstVvasMemStats * stats,
+    GstVvasCopyReason reason, gsize bytes);
+
+/**
+ *  @fn void gst_vvas_mem_stats_add_sync (GstVvasMemStats * stats, VvasSyncFlags direction, gsize bytes)
+ *  @param [in] stats - Counters to be updated
+ *  @param [in] direction - VVAS_SYNC_TO_DEVICE or VVAS_SYNC_FROM_DEVICE
+ *  @param [in] bytes - Number of bytes transferred
+ *  @return None
+ *  @brief Accounts a DMA transfer between host and device
+ */
+GST_EXPORT
+void gst_vvas_mem_stats_add_sync (GstVvasMemStats * stats,
+    VvasSyncFlags direction, gsize bytes);
+
+/**
+ *  @fn GstStructure * gst_vvas_mem_stats_to_structure (GstVvasMemStats * stats)
+ *  @param [in] stats - Counters to be read
+ *  @return New GstStructure "vvas-mem-stats" holding all counters
+ *  @brief Snapshot of counters, used by "stats" properties
+ */
+GST_EXPORT
+GstStructure * gst_vvas_mem_stats_to_structure (GstVvasMemStats * stats);
+
+/**
+ *  @fn void gst_vvas_mem_stats_dump (GstVvasMemStats * stats, GstElement * element)
+ *  @param [in] stats - Counters to be reported
+ *  @param [in] element - Element owning \p stats
+ *  @return None
+ *  @brief Logs counters and posts them as "vvas-mem-stats" element message on the bus,
+ *         elements call this on EOS
+ */
+GST_EXPORT
+void gst_vvas_mem_stats_dump (GstVvasMemStats * stats, GstElement * element);
+
+/**
+ *  @fn gboolean gst_vvas_memory_sync_bo_full (GstMemory * mem, GstVvasMemStats * stats)
+ *  @param [in] mem Pointer to GstMemory object
+ *  @param [in] stats Counters of the caller to account the transfer in, may be NULL
+ *  @return TRUE on success\n FALSE on failure
+ *  @brief Same as gst_vvas_memory_sync_bo, additionally accounting the transfer in \p stats
+ */
+GST_EXPORT
+gboolean gst_vvas_memory_sync_bo_full (GstMemory *mem, GstVvasMemStats * stats);
+
 G_END_DECLS
 
 #endif /* __GST_VVAS_ALLOCATOR_H__ */
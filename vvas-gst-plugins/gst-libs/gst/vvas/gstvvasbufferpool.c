@@ -21,6 +21,7 @@
 
 #include <gst/video/gstvideometa.h>
 #include <gst/vvas/gstvvasallocator.h>
+#include <gst/vvas/gstvvastrace.h>
 #include "gstvvasbufferpool.h"
 
 /**
@@ -40,6 +41,11 @@ GST_DEBUG_CATEGORY_STATIC (gst_vvas_buffer_pool_debug);
  */
 #define ALIGN(size,align) ((((size) + (align) - 1) / align) * align)
 
+/** @def VVAS_POOL_FREE_QUEUE_SIZE
+ *  @brief Initial size of the free buffer queue, it grows as needed
+ */
+#define VVAS_POOL_FREE_QUEUE_SIZE 16
+
 enum
 {
   PROP_0,
@@ -70,6 +76,13 @@ struct _GstVvasBufferPoolPrivate
   guint elevation_align;
   /**Video Alignment Info */
   GstVideoAlignment video_align;
+  /**Size of each buffer as configured on the pool */
+  gsize size;
+  /**Released buffers ready for reuse, lock-free */
+  GstAtomicQueue *free_buffers;
+  /**Number of acquirers served by the parent GstBufferPool. While non-zero,
+   * released buffers are handed to the parent so that waiters get woken up */
+  gint parent_waiters;
 };
 
 #define parent_class gst_vvas_buffer_pool_parent_class
@@ -184,6 +197,7 @@ gst_vvas_buffer_pool_set_config (GstBufferPool * pool, GstStructure * config)
       max_buffers);
 
   priv->vinfo = vinfo;
+  priv->size = vinfo.size;
 
   /* call parent GstVideoBufferPool to configure parameters */
   return GST_BUFFER_POOL_CLASS (parent_class)->set_config (pool, config);
@@ -225,23 +239,42 @@ failed_to_align:
  *  @param [out] buffer - Handle to buffer upon successful allocation
  *  @param [in] params - Parameters to be used while acquiring buffer from pool
  *  @return GST_FLOW_OK on success\nGST_FLOW_ERROR on failure
- *  @brief Acquires a buffer from pool. Invoke the parent class implementation of acquire_buffer.
- *         Resets the sync flags of the GstMemory object.
+ *  @brief Acquires a buffer from pool. Resets the sync flags of the GstMemory object.
+ *  @details Buffers are taken from the pool's own free list first. Only when it is empty,
+ *           the parent class implementation is invoked to allocate a new buffer or to
+ *           wait for one to be released.
  */
 static GstFlowReturn
 gst_vvas_buffer_pool_acquire_buffer (GstBufferPool * pool, GstBuffer ** buffer,
     GstBufferPoolAcquireParams * params)
 {
+  GstVvasBufferPoolPrivate *priv = GST_VVAS_BUFFER_POOL_CAST (pool)->priv;
   GstBufferPoolClass *pclass = GST_BUFFER_POOL_CLASS (parent_class);
   GstFlowReturn fret = GST_FLOW_OK;
   GstMemory *mem = NULL;
-
-  /* call parent GstVideoBufferPool to acquire buffer */
-  fret = pclass->acquire_buffer (pool, buffer, params);
+  GstClockTime trace_ts = gst_vvas_trace_start ();
+
+  if (G_UNLIKELY (GST_BUFFER_POOL_IS_FLUSHING (pool)))
+    return GST_FLOW_FLUSHING;
+
+  *buffer = gst_atomic_queue_pop (priv->free_buffers);
+  if (!*buffer) {
+    /* announce the waiter before checking again, a concurrent release then
+     * either is seen here or sees the waiter and feeds the parent */
+    g_atomic_int_inc (&priv->parent_waiters);
+    *buffer = gst_atomic_queue_pop (priv->free_buffers);
+    if (!*buffer) {
+      /* call parent GstVideoBufferPool to allocate or wait for a buffer */
+      fret = pclass->acquire_buffer (pool, buffer, params);
+    }
+    g_atomic_int_add (&priv->parent_waiters, -1);
+  }
+  /* includes time blocked waiting for a buffer to be released */
+  gst_vvas_trace_stop (GST_OBJECT (pool), GST_VVAS_TRACE_POOL_WAIT, trace_ts);
   if (fret != GST_FLOW_OK)
     return fret;
 
-  mem = gst_buffer_get_memory (*buffer, 0);
+  mem = gst_buffer_peek_memory (*buffer, 0);
   if (!mem) {
     GST_ERROR_OBJECT (pool, "failed to get memory");
     return GST_FLOW_ERROR;
@@ -250,7 +283,6 @@ gst_vvas_buffer_pool_acquire_buffer (GstBufferPool * pool, GstBuffer ** buffer,
   if (GST_IS_VVAS_ALLOCATOR (mem->allocator)) {
     gst_vvas_memory_reset_sync_flag (mem);
   }
-  gst_memory_unref (mem);
 
   return fret;
 }
@@ -330,6 +362,43 @@ no_memory:
   }
 }
 
+/**
+ *  @fn static gboolean gst_vvas_buffer_pool_recycle (GstVvasBufferPool * xpool, GstBuffer * buffer)
+ *  @param [in] xpool - VVAS buffer pool instance handle
+ *  @param [in] buffer - Buffer going back to the pool
+ *  @return TRUE if @buffer was added to the free list\n FALSE if it must be handed to the parent
+ *  @brief Adds a reusable buffer to the pool's free list.
+ *  @details The checks are the ones GstBufferPool does before queuing a released buffer,
+ *           buffers failing them are discarded by the parent class.
+ */
+static gboolean
+gst_vvas_buffer_pool_recycle (GstVvasBufferPool * xpool, GstBuffer * buffer)
+{
+  GstBufferPool *pool = GST_BUFFER_POOL_CAST (xpool);
+  GstVvasBufferPoolPrivate *priv = xpool->priv;
+  GstBuffer *waited;
+
+  if (G_UNLIKELY (GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_TAG_MEMORY)
+          || gst_buffer_get_size (buffer) != priv->size
+          || !gst_buffer_is_all_memory_writable (buffer)))
+    return FALSE;
+
+  if (g_atomic_int_get (&priv->parent_waiters))
+    return FALSE;
+
+  gst_atomic_queue_push (priv->free_buffers, buffer);
+
+  /* an acquirer may have started waiting in the parent meanwhile, wake it
+   * up with a free buffer, whichever one it is */
+  if (G_UNLIKELY (g_atomic_int_get (&priv->parent_waiters))) {
+    waited = gst_atomic_queue_pop (priv->free_buffers);
+    if (waited)
+      GST_BUFFER_POOL_CLASS (parent_class)->release_buffer (pool, waited);
+  }
+
+  return TRUE;
+}
+
 /**
  *  @fn static void gst_vvas_buffer_pool_release_buffer (GstBufferPool * pool, GstBuffer * buffer)
  *  @param [in] pool - VVAS buffer pool instance handle
@@ -349,7 +418,9 @@ gst_vvas_buffer_pool_release_buffer (GstBufferPool * pool, GstBuffer * buffer)
   if (xpool->pre_release_cb)
     xpool->pre_release_cb (buffer, xpool->pre_cb_user_data);
 
-  GST_BUFFER_POOL_CLASS (parent_class)->release_buffer (pool, buffer);
+  /* keep the buffer in our free list, parent queues or discards the rest */
+  if (!gst_vvas_buffer_pool_recycle (xpool, buffer))
+    GST_BUFFER_POOL_CLASS (parent_class)->release_buffer (pool, buffer);
 
   /* invokes user callback after buffer sent back to pool or after freeing.
    * Note : This callback is mainly useful for VCU decoder plugin to do some operations
@@ -451,17 +522,24 @@ error:
  *  @fn static gboolean gst_vvas_buffer_pool_stop (GstBufferPool * bpool)
  *  @param [in] bpool - VVAS buffer pool instance handle
  *  @return TRUE on success\n FALSE on failure
- *  @brief Invokes parent GstBufferPool's stop and stop on vvas allocator instance
+ *  @brief Returns free listed buffers to parent GstBufferPool, invokes its stop and stop on
+ *         vvas allocator instance
  */
 static gboolean
 gst_vvas_buffer_pool_stop (GstBufferPool * bpool)
 {
   GstVvasBufferPool *vvas_pool = GST_VVAS_BUFFER_POOL_CAST (bpool);
+  GstVvasBufferPoolPrivate *priv = vvas_pool->priv;
   GstBufferPoolClass *pclass = GST_BUFFER_POOL_CLASS (parent_class);
+  GstBuffer *buffer;
   gboolean bret;
 
   GST_DEBUG_OBJECT (bpool, "stopping pool");
 
+  /* hand buffers of the free list to the parent, which frees them on stop */
+  while ((buffer = gst_atomic_queue_pop (priv->free_buffers)))
+    pclass->release_buffer (bpool, buffer);
+
   bret = pclass->stop (bpool);
   if (bret && vvas_pool->priv->allocator) {
     bret =
@@ -498,6 +576,8 @@ static void
 gst_vvas_buffer_pool_init (GstVvasBufferPool * pool)
 {
   pool->priv = gst_vvas_buffer_pool_get_instance_private (pool);
+  pool->priv->free_buffers =
+      gst_atomic_queue_new (VVAS_POOL_FREE_QUEUE_SIZE);
 }
 
 /**
@@ -519,6 +599,9 @@ gst_vvas_buffer_pool_finalize (GObject * object)
   if (pool->priv->allocator)
     gst_object_unref (pool->priv->allocator);
 
+  /* free list is drained on stop */
+  gst_atomic_queue_unref (pool->priv->free_buffers);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -622,3 +705,48 @@ gst_vvas_buffer_pool_set_post_release_buffer_cb (GstVvasBufferPool * xpool,
   xpool->post_release_cb = release_buf_cb;
   xpool->post_cb_user_data = user_data;
 }
+
+/**
+ *  @fn GstFlowReturn gst_vvas_buffer_pool_acquire_buffers (GstBufferPool * pool,
+ *                                                          GstBuffer ** buffers,
+ *                                                          guint n_buffers,
+ *                                                          GstBufferPoolAcquireParams * params)
+ *  @param [in] pool - Buffer pool instance handle
+ *  @param [out] buffers - Array of at least @n_buffers entries receiving the buffers
+ *  @param [in] n_buffers - Number of buffers to acquire
+ *  @param [in] params - Parameters to be used while acquiring buffers from pool
+ *  @return GST_FLOW_OK when all @n_buffers buffers are acquired\n
+ *          flow return of the failing acquire otherwise, no buffer is returned then
+ *  @brief Acquires @n_buffers buffers from @pool in one call.
+ *  @details On GstVvasBufferPool every buffer is popped from the lock-free free list, the
+ *           parent pool is only entered when it runs empty. Other pools are served by
+ *           gst_buffer_pool_acquire_buffer().
+ */
+GstFlowReturn
+gst_vvas_buffer_pool_acquire_buffers (GstBufferPool * pool,
+    GstBuffer ** buffers, guint n_buffers, GstBufferPoolAcquireParams * params)
+{
+  GstFlowReturn fret = GST_FLOW_OK;
+  guint i;
+
+  g_return_val_if_fail (GST_IS_BUFFER_POOL (pool), GST_FLOW_ERROR);
+  g_return_val_if_fail (buffers != NULL || n_buffers == 0, GST_FLOW_ERROR);
+
+  for (i = 0; i < n_buffers; i++) {
+    /* buffers are still accounted and reset by the base class per buffer */
+    fret = gst_buffer_pool_acquire_buffer (pool, &buffers[i], params);
+    if (fret != GST_FLOW_OK)
+      break;
+  }
+
+  if (fret != GST_FLOW_OK) {
+    GST_DEBUG_OBJECT (pool, "acquired only %u of %u buffers: %s", i,
+        n_buffers, gst_flow_get_name (fret));
+    while (i--) {
+      gst_buffer_unref (buffers[i]);
+      buffers[i] = NULL;
+    }
+  }
+
+  return fret;
+}
@@ -130,6 +130,21 @@ void gst_vvas_buffer_pool_set_pre_release_buffer_cb (GstVvasBufferPool *xpool, P
 GST_EXPORT
 void gst_vvas_buffer_pool_set_post_release_buffer_cb (GstVvasBufferPool *xpool, PostReleaseBufferCallback post_release_cb, gpointer user_data);
 
+/**
+ *  @fn GstFlowReturn gst_vvas_buffer_pool_acquire_buffers (GstBufferPool * pool,
+ *                                                          GstBuffer ** buffers,
+ *                                                          guint n_buffers,
+ *                                                          GstBufferPoolAcquireParams * params)
+ *  @param [in] pool Buffer pool instance handle
+ *  @param [out] buffers Array of at least @n_buffers entries receiving the buffers
+ *  @param [in] n_buffers Number of buffers to acquire
+ *  @param [in] params Parameters to be used while acquiring buffers from pool
+ *  @return GST_FLOW_OK when all buffers are acquired\n  flow return of the failing acquire otherwise
+ *  @brief Acquires @n_buffers buffers from @pool in one call. On failure no buffer is returned.
+ */
+GST_EXPORT
+GstFlowReturn gst_vvas_buffer_pool_acquire_buffers (GstBufferPool *pool, GstBuffer **buffers, guint n_buffers, GstBufferPoolAcquireParams *params);
+
 G_END_DECLS
 
 #endif /* __GST_VVAS_BUFFER_POOL_H__ */
@@ -25,6 +25,16 @@
 #ifndef __GST_VVAS_COMMON_H__
 #define __GST_VVAS_COMMON_H__
 
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+/** @def GST_VVAS_BUFFER_FLAG_INFER_SKIPPED
+ *  @brief Set by vvas_xinfer on buffers it passed downstream without running
+ *         inference, because the result would have missed the latency budget.
+ *         Placed after the GstVideoBufferFlags, which VVAS buffers carry too.
+ */
+#define GST_VVAS_BUFFER_FLAG_INFER_SKIPPED (GST_VIDEO_BUFFER_FLAG_LAST << 0)
+
 typedef enum _vvas_codec_type{
   VVAS_CODEC_NONE = -1,
   VVAS_CODEC_H264,
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gstvvasframestatsmeta.h>
+#include <string.h>
+
+GType
+gst_vvas_frame_stats_meta_api_get_type (void)
+{
+  static GType type = 0;
+  static const gchar *tags[] = { GST_META_TAG_VIDEO_STR, NULL };
+
+  if (g_once_init_enter (&type)) {
+    GType _type = gst_meta_api_type_register ("GstVvasFrameStatsMetaAPI", tags);
+    g_once_init_leave (&type, _type);
+  }
+
+  return type;
+}
+
+static gboolean
+gst_vvas_frame_stats_meta_init (GstMeta * meta, gpointer params,
+    GstBuffer * buffer)
+{
+  GstVvasFrameStatsMeta *vvasmeta = (GstVvasFrameStatsMeta *) meta;
+
+  memset (&vvasmeta->stats, 0, sizeof (vvasmeta->stats));
+  return TRUE;
+}
+
+static gboolean
+gst_vvas_frame_stats_meta_transform (GstBuffer * dest, GstMeta * meta,
+    GstBuffer * buffer, GQuark type, gpointer data)
+{
+  GstVvasFrameStatsMeta *dmeta, *smeta;
+
+  /* Statistics describe the content of the source frame, scaled copies
+   * keep them */
+  if (GST_META_TRANSFORM_IS_COPY (type) ||
+      GST_VIDEO_META_TRANSFORM_IS_SCALE (type)) {
+
+    smeta = (GstVvasFrameStatsMeta *) meta;
+    dmeta = gst_buffer_add_vvas_frame_stats_meta (dest);
+
+    if (!dmeta)
+      return FALSE;
+
+    GST_LOG ("copy frame statistics buffer %p -> %p", buffer, dest);
+
+    dmeta->stats = smeta->stats;
+  } else {
+    GST_ERROR ("unsupported transform type : %s", g_quark_to_string (type));
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+const GstMetaInfo *
+gst_vvas_frame_stats_meta_get_info (void)
+{
+  static const GstMetaInfo *vvas_frame_stats_meta_info = NULL;
+
+  if (g_once_init_enter ((GstMetaInfo **) & vvas_frame_stats_meta_info)) {
+    const GstMetaInfo *meta =
+        gst_meta_register (GST_VVAS_FRAME_STATS_META_API_TYPE,
+        "GstVvasFrameStatsMeta",
+        sizeof (GstVvasFrameStatsMeta),
+        (GstMetaInitFunction) gst_vvas_frame_stats_meta_init,
+        NULL,
+        gst_vvas_frame_stats_meta_transform);
+    g_once_init_leave ((GstMetaInfo **) & vvas_frame_stats_meta_info,
+        (GstMetaInfo *) meta);
+  }
+  return vvas_frame_stats_meta_info;
+}
+
+/**
+ *  @fn gboolean gst_vvas_frame_stats_format_supported (GstVideoFormat format)
+ *  @param [in] format - Video format
+ *  @return TRUE if gst_vvas_frame_stats_compute() supports \p format
+ *  @brief  8 bit formats with a luma plane, RGB and BGR
+ */
+gboolean
+gst_vvas_frame_stats_format_supported (GstVideoFormat format)
+{
+  switch (format) {
+    case GST_VIDEO_FORMAT_GRAY8:
+    case GST_VIDEO_FORMAT_NV12:
+    case GST_VIDEO_FORMAT_NV16:
+    case GST_VIDEO_FORMAT_I420:
+    case GST_VIDEO_FORMAT_RGB:
+    case GST_VIDEO_FORMAT_BGR:
+      return TRUE;
+    default:
+      return FALSE;
+  }
+}
+
+/**
+ *  @fn static guint frame_stats_block_start (guint block, guint size, guint blocks)
+ *  @param [in] block - Block index
+ *  @param [in] size - Width or height of the frame
+ *  @param [in] blocks - Number of blocks along \p size
+ *  @return First column or line of \p block, the smallest x with
+ *          (x * blocks) / size == block
+ */
+static guint
+frame_stats_block_start (guint block, guint size, guint blocks)
+{
+  return (block * size + blocks - 1) / blocks;
+}
+
+/**
+ *  @fn gboolean gst_vvas_frame_stats_compute (GstVvasFrameStats * stats,
+ *                                            const GstVideoFrame * frame)
+ *  @param [out] stats - Statistics of \p frame
+ *  @param [in] frame - Mapped video frame
+ *  @return FALSE if the format of \p frame is not supported
+ *  @brief  CPU reference of the statistics of the image_processing kernel.
+ *  @details RGB is converted to luma with the weights of the kernel colour
+ *           space converter, (306 R + 601 G + 117 B) >> 10. The result is
+ *           bit exact with the statistics read back from the kernel.
+ */
+gboolean
+gst_vvas_frame_stats_compute (GstVvasFrameStats * stats,
+    const GstVideoFrame * frame)
+{
+  GstVideoFormat format = GST_VIDEO_FRAME_FORMAT (frame);
+  guint width = GST_VIDEO_FRAME_WIDTH (frame);
+  guint height = GST_VIDEO_FRAME_HEIGHT (frame);
+  guint32 words[GST_VVAS_FRAME_STATS_WORDS] = { 0 };
+  guint32 *block_sum = words + GST_VVAS_FRAME_STATS_BINS;
+  const guint8 *line;
+  guint8 *block_x;
+  guint x, y, stride, r = 0, b = 2;
+
+  if (!gst_vvas_frame_stats_format_supported (format))
+    return FALSE;
+
+  if (format == GST_VIDEO_FORMAT_BGR) {
+    r = 2;
+    b = 0;
+  }
+
+  block_x = g_new (guint8, width);
+  for (x = 0; x < width; x++)
+    block_x[x] = x * GST_VVAS_FRAME_STATS_BLOCKS_X / width;
+
+  line = GST_VIDEO_FRAME_PLANE_DATA (frame, 0);
+  stride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0);
+
+  for (y = 0; y < height; y++, line += stride) {
+    guint32 *row = block_sum +
+        (y * GST_VVAS_FRAME_STATS_BLOCKS_Y / height) *
+        GST_VVAS_FRAME_STATS_BLOCKS_X;
+
+    if (format == GST_VIDEO_FORMAT_RGB || format == GST_VIDEO_FORMAT_BGR) {
+      for (x = 0; x < width; x++) {
+        const guint8 *pix = line + 3 * x;
+        guint luma = (306 * pix[r] + 601 * pix[1] + 117 * pix[b]) >> 10;
+
+        words[luma]++;
+        row[block_x[x]] += luma;
+      }
+    } else {
+      for (x = 0; x < width; x++) {
+        words[line[x]]++;
+        row[block_x[x]] += line[x];
+      }
+    }
+  }
+
+  g_free (block_x);
+  gst_vvas_frame_stats_from_words (stats, words, width, height);
+
+  return TRUE;
+}
+
+/**
+ *  @fn void gst_vvas_frame_stats_from_words (GstVvasFrameStats * stats,
+ *                                           const guint32 * words,
+ *                                           guint width, guint height)
+ *  @param [out] stats - Statistics
+ *  @param [in] words - GST_VVAS_FRAME_STATS_WORDS words written by the
+ *                      image_processing kernel, histogram and block sums
+ *  @param [in] width - Width of the kernel input
+ *  @param [in] height - Height of the kernel input
+ *  @return None
+ *  @brief  Fills \p stats from the statistics buffer of the kernel.
+ */
+void
+gst_vvas_frame_stats_from_words (GstVvasFrameStats * stats,
+    const guint32 * words, guint width, guint height)
+{
+  const guint32 *block_sum = words + GST_VVAS_FRAME_STATS_BINS;
+  guint64 total = 0, pixels = 0;
+  guint i, bx, by;
+
+  stats->width = width;
+  stats->height = height;
+  memcpy (stats->histogram, words, sizeof (stats->histogram));
+
+  for (i = 0; i < GST_VVAS_FRAME_STATS_BINS; i++) {
+    total += (guint64) i * words[i];
+    pixels += words[i];
+  }
+  stats->mean = pixels ? (gdouble) total / pixels : 0.0;
+
+  for (by = 0; by < GST_VVAS_FRAME_STATS_BLOCKS_Y; by++) {
+    guint lines = frame_stats_block_start (by + 1, height,
+        GST_VVAS_FRAME_STATS_BLOCKS_Y) -
+        frame_stats_block_start (by, height, GST_VVAS_FRAME_STATS_BLOCKS_Y);
+
+    for (bx = 0; bx < GST_VVAS_FRAME_STATS_BLOCKS_X; bx++) {
+      guint cols = frame_stats_block_start (bx + 1, width,
+          GST_VVAS_FRAME_STATS_BLOCKS_X) -
+          frame_stats_block_start (bx, width, GST_VVAS_FRAME_STATS_BLOCKS_X);
+      guint64 count = (guint64) lines * cols;
+      guint64 sum = block_sum[by * GST_VVAS_FRAME_STATS_BLOCKS_X + bx];
+
+      stats->block_mean[by][bx] = count ? (sum + count / 2) / count : 0;
+    }
+  }
+}
+
+/**
+ *  @fn gdouble gst_vvas_frame_stats_distance (const GstVvasFrameStats * a,
+ *                                            const GstVvasFrameStats * b)
+ *  @param [in] a - Statistics of a frame
+ *  @param [in] b - Statistics of another frame
+ *  @return Distance of the luma histograms from 0.0, identical, to 1.0,
+ *          disjoint
+ *  @brief  Half the L1 distance of the normalized histograms. Scene cuts
+ *          typically score well above 0.5, fades and exposure changes of
+ *          the same scene stay far below.
+ */
+gdouble
+gst_vvas_frame_stats_distance (const GstVvasFrameStats * a,
+    const GstVvasFrameStats * b)
+{
+  guint64 pixels_a = 0, pixels_b = 0;
+  gdouble dist = 0.0;
+  guint i;
+
+  for (i = 0; i < GST_VVAS_FRAME_STATS_BINS; i++) {
+    pixels_a += a->histogram[i];
+    pixels_b += b->histogram[i];
+  }
+  if (!pixels_a || !pixels_b)
+    return (pixels_a == pixels_b) ? 0.0 : 1.0;
+
+  for (i = 0; i < GST_VVAS_FRAME_STATS_BINS; i++) {
+    gdouble diff = (gdouble) a->histogram[i] / pixels_a -
+        (gdouble) b->histogram[i] / pixels_b;
+
+    dist += diff < 0 ? -diff : diff;
+  }
+
+  return dist / 2;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __GST_VVAS_FRAME_STATS_META_H__
+#define __GST_VVAS_FRAME_STATS_META_H__
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+G_BEGIN_DECLS
+
+#define GST_VVAS_FRAME_STATS_META_API_TYPE  (gst_vvas_frame_stats_meta_api_get_type())
+#define GST_VVAS_FRAME_STATS_META_INFO  (gst_vvas_frame_stats_meta_get_info())
+
+/* Same layout as the statistics of the image_processing kernel */
+#define GST_VVAS_FRAME_STATS_BINS 256
+#define GST_VVAS_FRAME_STATS_BLOCKS_X 8
+#define GST_VVAS_FRAME_STATS_BLOCKS_Y 8
+#define GST_VVAS_FRAME_STATS_WORDS (GST_VVAS_FRAME_STATS_BINS + \
+    GST_VVAS_FRAME_STATS_BLOCKS_X * GST_VVAS_FRAME_STATS_BLOCKS_Y)
+
+typedef struct _GstVvasFrameStats GstVvasFrameStats;
+typedef struct _GstVvasFrameStatsMeta GstVvasFrameStatsMeta;
+
+/**
+ * GstVvasFrameStats:
+ *
+ * Luma statistics of a frame. Luma is reduced to 8 bits, column x belongs
+ * to block column (x * BLOCKS_X) / width and line y to block row
+ * (y * BLOCKS_Y) / height.
+ */
+struct _GstVvasFrameStats {
+  /** Width of the frame the statistics were computed on */
+  guint width;
+  /** Height of the frame the statistics were computed on */
+  guint height;
+  /** Number of pixels per luma value */
+  guint32 histogram[GST_VVAS_FRAME_STATS_BINS];
+  /** Rounded mean luma of each block */
+  guint8 block_mean[GST_VVAS_FRAME_STATS_BLOCKS_Y][GST_VVAS_FRAME_STATS_BLOCKS_X];
+  /** Mean luma of the frame */
+  gdouble mean;
+};
+
+struct _GstVvasFrameStatsMeta {
+  GstMeta meta;
+
+  /** Statistics of the frame the buffer was produced from */
+  GstVvasFrameStats stats;
+};
+
+GST_EXPORT
+GType gst_vvas_frame_stats_meta_api_get_type (void);
+
+GST_EXPORT
+const GstMetaInfo * gst_vvas_frame_stats_meta_get_info (void);
+
+#define gst_buffer_get_vvas_frame_stats_meta(b) ((GstVvasFrameStatsMeta*)gst_buffer_get_meta((b), GST_VVAS_FRAME_STATS_META_API_TYPE))
+#define gst_buffer_add_vvas_frame_stats_meta(b) ((GstVvasFrameStatsMeta*)gst_buffer_add_meta((b), GST_VVAS_FRAME_STATS_META_INFO, NULL))
+
+GST_EXPORT
+gboolean gst_vvas_frame_stats_format_supported (GstVideoFormat format);
+
+GST_EXPORT
+gboolean gst_vvas_frame_stats_compute (GstVvasFrameStats * stats,
+    const GstVideoFrame * frame);
+
+GST_EXPORT
+void gst_vvas_frame_stats_from_words (GstVvasFrameStats * stats,
+    const guint32 * words, guint width, guint height);
+
+GST_EXPORT
+gdouble gst_vvas_frame_stats_distance (const GstVvasFrameStats * a,
+    const GstVvasFrameStats * b);
+
+G_END_DECLS
+
+#endif /* __GST_VVAS_FRAME_STATS_META_H__ */
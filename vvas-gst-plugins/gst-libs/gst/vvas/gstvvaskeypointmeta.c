@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gstvvaskeypointmeta.h>
+#include <string.h>
+
+GType
+gst_vvas_keypoint_meta_api_get_type (void)
+{
+  static GType type = 0;
+  static const gchar *tags[] =
+      { GST_META_TAG_VIDEO_STR, GST_META_TAG_VIDEO_SIZE_STR, NULL };
+
+  if (g_once_init_enter (&type)) {
+    GType _type = gst_meta_api_type_register ("GstVvasKeypointMetaAPI", tags);
+    g_once_init_leave (&type, _type);
+  }
+
+  return type;
+}
+
+static gboolean
+gst_vvas_keypoint_meta_init (GstMeta * meta, gpointer params,
+    GstBuffer * buffer)
+{
+  GstVvasKeypointMeta *vvasmeta = (GstVvasKeypointMeta *) meta;
+
+  vvasmeta->detector = GST_VVAS_KEYPOINT_DETECTOR_FAST;
+  vvasmeta->width = 0;
+  vvasmeta->height = 0;
+  vvasmeta->num_keypoints = 0;
+  vvasmeta->keypoints = NULL;
+  return TRUE;
+}
+
+static void
+gst_vvas_keypoint_meta_free (GstMeta * meta, GstBuffer * buffer)
+{
+  GstVvasKeypointMeta *vvasmeta = (GstVvasKeypointMeta *) meta;
+
+  g_free (vvasmeta->keypoints);
+  vvasmeta->keypoints = NULL;
+  vvasmeta->num_keypoints = 0;
+}
+
+static gboolean
+gst_vvas_keypoint_meta_transform (GstBuffer * dest, GstMeta * meta,
+    GstBuffer * buffer, GQuark type, gpointer data)
+{
+  GstVvasKeypointMeta *dmeta, *smeta = (GstVvasKeypointMeta *) meta;
+  GstVideoMetaTransform *trans = data;
+  guint i;
+
+  if (!GST_META_TRANSFORM_IS_COPY (type) &&
+      !GST_VIDEO_META_TRANSFORM_IS_SCALE (type)) {
+    GST_ERROR ("unsupported transform type : %s", g_quark_to_string (type));
+    return FALSE;
+  }
+
+  dmeta = gst_buffer_add_vvas_keypoint_meta (dest);
+  if (!dmeta)
+    return FALSE;
+
+  GST_LOG ("copy %u keypoints buffer %p -> %p", smeta->num_keypoints, buffer,
+      dest);
+
+  dmeta->detector = smeta->detector;
+  dmeta->width = smeta->width;
+  dmeta->height = smeta->height;
+  gst_vvas_keypoint_meta_set_keypoints (dmeta, smeta->keypoints,
+      smeta->num_keypoints);
+
+  /* Keypoints follow the frame to its new size */
+  if (GST_VIDEO_META_TRANSFORM_IS_SCALE (type) && smeta->width &&
+      smeta->height) {
+    guint width = GST_VIDEO_INFO_WIDTH (trans->out_info);
+    guint height = GST_VIDEO_INFO_HEIGHT (trans->out_info);
+
+    for (i = 0; i < dmeta->num_keypoints; i++) {
+      GstVvasKeypoint *kp = &dmeta->keypoints[i];
+
+      kp->x = MIN ((guint64) kp->x * width / smeta->width, width - 1);
+      kp->y = MIN ((guint64) kp->y * height / smeta->height, height - 1);
+    }
+    dmeta->width = width;
+    dmeta->height = height;
+  }
+
+  return TRUE;
+}
+
+const GstMetaInfo *
+gst_vvas_keypoint_meta_get_info (void)
+{
+  static const GstMetaInfo *vvas_keypoint_meta_info = NULL;
+
+  if (g_once_init_enter ((GstMetaInfo **) & vvas_keypoint_meta_info)) {
+    const GstMetaInfo *meta =
+        gst_meta_register (GST_VVAS_KEYPOINT_META_API_TYPE,
+        "GstVvasKeypointMeta",
+        sizeof (GstVvasKeypointMeta),
+        (GstMetaInitFunction) gst_vvas_keypoint_meta_init,
+        (GstMetaFreeFunction) gst_vvas_keypoint_meta_free,
+        gst_vvas_keypoint_meta_transform);
+    g_once_init_leave ((GstMetaInfo **) & vvas_keypoint_meta_info,
+        (GstMetaInfo *) meta);
+  }
+  return vvas_keypoint_meta_info;
+}
+
+/**
+ *  @fn void gst_vvas_keypoint_meta_set_keypoints (GstVvasKeypointMeta * meta,
+ *                                                const GstVvasKeypoint * keypoints,
+ *                                                guint num_keypoints)
+ *  @param [in] meta - Keypoint meta
+ *  @param [in] keypoints - Keypoints to copy
+ *  @param [in] num_keypoints - Number of keypoints
+ *  @return None
+ *  @brief  Replaces the keypoints of \p meta by a copy of \p keypoints
+ */
+void
+gst_vvas_keypoint_meta_set_keypoints (GstVvasKeypointMeta * meta,
+    const GstVvasKeypoint * keypoints, guint num_keypoints)
+{
+  meta->keypoints = g_renew (GstVvasKeypoint, meta->keypoints, num_keypoints);
+  if (num_keypoints)
+    memcpy (meta->keypoints, keypoints,
+        num_keypoints * sizeof (GstVvasKeypoint));
+  meta->num_keypoints = num_keypoints;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __GST_VVAS_KEYPOINT_META_H__
+#define __GST_VVAS_KEYPOINT_META_H__
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+G_BEGIN_DECLS
+
+#define GST_VVAS_KEYPOINT_META_API_TYPE  (gst_vvas_keypoint_meta_api_get_type())
+#define GST_VVAS_KEYPOINT_META_INFO  (gst_vvas_keypoint_meta_get_info())
+
+typedef struct _GstVvasKeypoint GstVvasKeypoint;
+typedef struct _GstVvasKeypointMeta GstVvasKeypointMeta;
+
+/**
+ * GstVvasKeypointDetector:
+ * @GST_VVAS_KEYPOINT_DETECTOR_FAST: FAST-9 segment test, score is the
+ *   smallest difference of the arc with the centre
+ * @GST_VVAS_KEYPOINT_DETECTOR_HARRIS: Harris corner response
+ *
+ * Detector the keypoints were found with, scores of different detectors are
+ * not comparable.
+ */
+typedef enum
+{
+  GST_VVAS_KEYPOINT_DETECTOR_FAST,
+  GST_VVAS_KEYPOINT_DETECTOR_HARRIS,
+} GstVvasKeypointDetector;
+
+/**
+ * GstVvasKeypoint:
+ *
+ * Corner position in pixels of the frame the meta is attached to.
+ */
+struct _GstVvasKeypoint {
+  /** Column */
+  guint16 x;
+  /** Line */
+  guint16 y;
+  /** Corner strength, larger is stronger */
+  gint32 score;
+};
+
+struct _GstVvasKeypointMeta {
+  GstMeta meta;
+
+  /** Detector the keypoints were found with */
+  GstVvasKeypointDetector detector;
+  /** Width of the frame the keypoints refer to */
+  guint width;
+  /** Height of the frame the keypoints refer to */
+  guint height;
+  /** Number of keypoints */
+  guint num_keypoints;
+  /** Keypoints in raster order */
+  GstVvasKeypoint *keypoints;
+};
+
+GST_EXPORT
+GType gst_vvas_keypoint_meta_api_get_type (void);
+
+GST_EXPORT
+const GstMetaInfo * gst_vvas_keypoint_meta_get_info (void);
+
+#define gst_buffer_get_vvas_keypoint_meta(b) ((GstVvasKeypointMeta*)gst_buffer_get_meta((b), GST_VVAS_KEYPOINT_META_API_TYPE))
+#define gst_buffer_add_vvas_keypoint_meta(b) ((GstVvasKeypointMeta*)gst_buffer_add_meta((b), GST_VVAS_KEYPOINT_META_INFO, NULL))
+
+GST_EXPORT
+void gst_vvas_keypoint_meta_set_keypoints (GstVvasKeypointMeta * meta,
+    const GstVvasKeypoint * keypoints, guint num_keypoints);
+
+G_END_DECLS
+
+#endif /* __GST_VVAS_KEYPOINT_META_H__ */
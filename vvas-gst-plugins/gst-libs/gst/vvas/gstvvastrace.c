@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Hook points used by VVAS elements and libraries to report accelerator
+ * timings, DMA transfers and queue depths. Values are dropped unless a
+ * tracer (see gst/tracers) registered a consumer, so an inactive hook costs
+ * a single atomic load.
+ */
+
+#include <gstvvastrace.h>
+
+/** @struct GstVvasTraceHook
+ *  @brief  Consumer of reported values
+ */
+typedef struct
+{
+  /** Function receiving values */
+  GstVvasTraceFunc func;
+  /** User data passed to func */
+  gpointer user_data;
+} GstVvasTraceHook;
+
+/** Currently registered consumer, NULL when tracing is inactive */
+static GstVvasTraceHook *trace_hook = NULL;
+/** Number of threads currently calling into the registered consumer */
+static gint trace_users = 0;
+
+/** Names of measurement points, indexed by GstVvasTracePoint */
+static const gchar *trace_point_names[GST_VVAS_TRACE_NUM_POINTS] = {
+  "ppe-time",
+  "infer-time",
+  "postproc-time",
+  "batch-fill",
+  "kernel-time",
+  "sync-to-device",
+  "sync-from-device",
+  "pool-wait",
+  "queue-depth",
+};
+
+/**
+ *  @fn const gchar * gst_vvas_trace_point_get_name (GstVvasTracePoint point)
+ *  @param [in] point - Measurement point
+ *  @return Name of measurement point
+ *  @brief  Gets name used for a measurement point in tracer records
+ */
+const gchar *
+gst_vvas_trace_point_get_name (GstVvasTracePoint point)
+{
+  g_return_val_if_fail (point < GST_VVAS_TRACE_NUM_POINTS, NULL);
+
+  return trace_point_names[point];
+}
+
+/**
+ *  @fn gboolean gst_vvas_trace_set_func (GstVvasTraceFunc func, gpointer user_data)
+ *  @param [in] func - Consumer of values, NULL to stop tracing
+ *  @param [in] user_data - Data passed to @func
+ *  @return TRUE on success, FALSE if another consumer is already registered
+ *  @brief  Registers the consumer of all reported values. Only one consumer
+ *          can be active at a time.
+ *  @note   Unsetting the consumer waits until no streaming thread runs it
+ *          anymore, so @user_data can be freed once this returns.
+ */
+gboolean
+gst_vvas_trace_set_func (GstVvasTraceFunc func, gpointer user_data)
+{
+  GstVvasTraceHook *hook = NULL;
+
+  if (func) {
+    hook = g_new (GstVvasTraceHook, 1);
+    hook->func = func;
+    hook->user_data = user_data;
+    if (!g_atomic_pointer_compare_and_exchange (&trace_hook, NULL, hook)) {
+      g_free (hook);
+      return FALSE;
+    }
+  } else {
+    do {
+      hook = g_atomic_pointer_get (&trace_hook);
+    } while (hook && !g_atomic_pointer_compare_and_exchange (&trace_hook,
+            hook, NULL));
+
+    if (!hook)
+      return TRUE;
+
+    /* callers increment trace_users before loading trace_hook, once the
+     * count drops to zero nobody can still reference the old hook */
+    while (g_atomic_int_get (&trace_users))
+      g_thread_yield ();
+
+    g_free (hook);
+  }
+
+  return TRUE;
+}
+
+/**
+ *  @fn gboolean gst_vvas_trace_is_active (void)
+ *  @return TRUE if a consumer is registered
+ *  @brief  Lets callers skip preparing values nobody consumes
+ */
+gboolean
+gst_vvas_trace_is_active (void)
+{
+  return g_atomic_pointer_get (&trace_hook) != NULL;
+}
+
+/**
+ *  @fn void gst_vvas_trace_value (GstObject * object, GstVvasTracePoint point, guint64 value)
+ *  @param [in] object - Object reporting the value
+ *  @param [in] point - Measurement point
+ *  @param [in] value - Measured value
+ *  @return None
+ *  @brief  Reports a value to the registered consumer, if any
+ */
+void
+gst_vvas_trace_value (GstObject * object, GstVvasTracePoint point,
+    guint64 value)
+{
+  GstVvasTraceHook *hook;
+
+  if (G_LIKELY (!g_atomic_pointer_get (&trace_hook)))
+    return;
+
+  g_atomic_int_inc (&trace_users);
+  hook = g_atomic_pointer_get (&trace_hook);
+  if (hook)
+    hook->func (object, point, value, hook->user_data);
+  g_atomic_int_dec_and_test (&trace_users);
+}
+
+/**
+ *  @fn GstClockTime gst_vvas_trace_start (void)
+ *  @return Current time, or GST_CLOCK_TIME_NONE when tracing is inactive
+ *  @brief  Starts measuring a duration finished by gst_vvas_trace_stop()
+ */
+GstClockTime
+gst_vvas_trace_start (void)
+{
+  if (G_LIKELY (!g_atomic_pointer_get (&trace_hook)))
+    return GST_CLOCK_TIME_NONE;
+
+  return gst_util_get_timestamp ();
+}
+
+/**
+ *  @fn void gst_vvas_trace_stop (GstObject * object, GstVvasTracePoint point, GstClockTime start)
+ *  @param [in] object - Object reporting the duration
+ *  @param [in] point - Measurement point
+ *  @param [in] start - Value returned by gst_vvas_trace_start()
+ *  @return None
+ *  @brief  Reports time elapsed since @start
+ */
+void
+gst_vvas_trace_stop (GstObject * object, GstVvasTracePoint point,
+    GstClockTime start)
+{
+  if (G_LIKELY (!GST_CLOCK_TIME_IS_VALID (start)))
+    return;
+
+  gst_vvas_trace_value (object, point, gst_util_get_timestamp () - start);
+}
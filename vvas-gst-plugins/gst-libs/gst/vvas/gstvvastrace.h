@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __GST_VVAS_TRACE_H__
+#define __GST_VVAS_TRACE_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GstVvasTracePoint:
+ * @GST_VVAS_TRACE_PPE_TIME: time spent in pre-processing of a batch (ns)
+ * @GST_VVAS_TRACE_INFER_TIME: time spent in DPU inference of a batch (ns)
+ * @GST_VVAS_TRACE_POSTPROC_TIME: time spent attaching inference results (ns)
+ * @GST_VVAS_TRACE_BATCH_FILL: number of frames in a submitted batch
+ * @GST_VVAS_TRACE_KERNEL_TIME: time from kernel start to kernel done (ns)
+ * @GST_VVAS_TRACE_SYNC_TO_DEVICE: bytes synchronized from host to device
+ * @GST_VVAS_TRACE_SYNC_FROM_DEVICE: bytes synchronized from device to host
+ * @GST_VVAS_TRACE_POOL_WAIT: time spent acquiring a buffer from pool (ns)
+ * @GST_VVAS_TRACE_QUEUE_DEPTH: number of buffers held in an internal queue
+ *
+ * Measurement points VVAS elements and libraries report to a tracer.
+ */
+typedef enum
+{
+  GST_VVAS_TRACE_PPE_TIME,
+  GST_VVAS_TRACE_INFER_TIME,
+  GST_VVAS_TRACE_POSTPROC_TIME,
+  GST_VVAS_TRACE_BATCH_FILL,
+  GST_VVAS_TRACE_KERNEL_TIME,
+  GST_VVAS_TRACE_SYNC_TO_DEVICE,
+  GST_VVAS_TRACE_SYNC_FROM_DEVICE,
+  GST_VVAS_TRACE_POOL_WAIT,
+  GST_VVAS_TRACE_QUEUE_DEPTH,
+  GST_VVAS_TRACE_NUM_POINTS
+} GstVvasTracePoint;
+
+/**
+ * GstVvasTraceFunc:
+ * @object: object reporting the value
+ * @point: measurement point
+ * @value: measured value
+ * @user_data: data passed to gst_vvas_trace_set_func()
+ *
+ * Receives values reported through gst_vvas_trace_value(). Called from
+ * streaming threads, so it must be thread safe.
+ */
+typedef void (*GstVvasTraceFunc) (GstObject * object, GstVvasTracePoint point,
+    guint64 value, gpointer user_data);
+
+GST_EXPORT
+const gchar * gst_vvas_trace_point_get_name (GstVvasTracePoint point);
+
+GST_EXPORT
+gboolean gst_vvas_trace_set_func (GstVvasTraceFunc func, gpointer user_data);
+
+GST_EXPORT
+gboolean gst_vvas_trace_is_active (void);
+
+GST_EXPORT
+void gst_vvas_trace_value (GstObject * object, GstVvasTracePoint point,
+    guint64 value);
+
+GST_EXPORT
+GstClockTime gst_vvas_trace_start (void);
+
+GST_EXPORT
+void gst_vvas_trace_stop (GstObject * object, GstVvasTracePoint point,
+    GstClockTime start);
+
+G_END_DECLS
+
+#endif /* __GST_VVAS_TRACE_H__ */
@@ -484,3 +484,169 @@ done:
 
   return othercaps;
 }
+
+/**
+ *  @brief Bands of a frame computed on a pool of threads
+ */
+struct _GstVvasBandWorker
+{
+  /** Threads besides the caller of gst_vvas_band_worker_run (), NULL when
+   *  the caller is the only one */
+  GThreadPool *pool;
+  /** Computes one band */
+  GstVvasBandFunc func;
+  /** Passed to func */
+  gpointer user_data;
+  /** Threads computing bands, caller included */
+  guint num_threads;
+  /** Protects pending */
+  GMutex lock;
+  /** Signalled when the last band is done */
+  GCond cond;
+  /** Bands of the current run not done yet */
+  guint pending;
+};
+
+/**
+ *  @fn static void gst_vvas_band_worker_func (gpointer data,
+ *                                             gpointer user_data)
+ *  @param [in] data - Band to compute
+ *  @param [in] user_data - GstVvasBandWorker
+ *  @return None
+ */
+static void
+gst_vvas_band_worker_func (gpointer data, gpointer user_data)
+{
+  GstVvasBandWorker *worker = (GstVvasBandWorker *) user_data;
+
+  worker->func (data, worker->user_data);
+
+  g_mutex_lock (&worker->lock);
+  if (!--worker->pending)
+    g_cond_signal (&worker->cond);
+  g_mutex_unlock (&worker->lock);
+}
+
+/**
+ *  @fn GstVvasBandWorker * gst_vvas_band_worker_new (guint num_threads,
+ *                                                   GstVvasBandFunc func,
+ *                                                   gpointer user_data,
+ *                                                   GError ** error)
+ *  @param [in] num_threads - Threads computing bands, 0 for one per CPU
+ *  @param [in] func - Computes one band
+ *  @param [in] user_data - Passed to \p func
+ *  @param [out] error - Set when threads can not be created
+ *  @return New worker, NULL on error
+ *  @brief  The thread calling gst_vvas_band_worker_run () computes one band
+ *          itself, so num_threads - 1 threads are created.
+ */
+GstVvasBandWorker *
+gst_vvas_band_worker_new (guint num_threads, GstVvasBandFunc func,
+    gpointer user_data, GError ** error)
+{
+  GstVvasBandWorker *worker;
+
+  if (!num_threads)
+    num_threads = MIN (g_get_num_processors (),
+        GST_VVAS_BAND_WORKER_MAX_THREADS);
+
+  worker = g_new0 (GstVvasBandWorker, 1);
+  worker->func = func;
+  worker->user_data = user_data;
+  worker->num_threads = num_threads;
+  g_mutex_init (&worker->lock);
+  g_cond_init (&worker->cond);
+
+  if (num_threads > 1) {
+    worker->pool = g_thread_pool_new (gst_vvas_band_worker_func, worker,
+        num_threads - 1, TRUE, error);
+    if (!worker->pool) {
+      gst_vvas_band_worker_free (worker);
+      return NULL;
+    }
+  }
+
+  return worker;
+}
+
+/**
+ *  @fn guint gst_vvas_band_worker_get_num_threads (GstVvasBandWorker * worker)
+ *  @param [in] worker - Worker
+ *  @return Threads computing bands, caller of gst_vvas_band_worker_run ()
+ *          included
+ */
+guint
+gst_vvas_band_worker_get_num_threads (GstVvasBandWorker * worker)
+{
+  return worker->num_threads;
+}
+
+/**
+ *  @fn guint gst_vvas_band_worker_num_bands (GstVvasBandWorker * worker,
+ *                                           guint lines, guint min_lines)
+ *  @param [in] worker - Worker
+ *  @param [in] lines - Lines to split
+ *  @param [in] min_lines - Lines of a band at least, keeps thread overhead
+ *                          low on small areas
+ *  @return Number of bands \p lines are split in, one per thread at most
+ */
+guint
+gst_vvas_band_worker_num_bands (GstVvasBandWorker * worker, guint lines,
+    guint min_lines)
+{
+  return CLAMP (lines / MAX (min_lines, 1), 1, worker->num_threads);
+}
+
+/**
+ *  @fn void gst_vvas_band_worker_run (GstVvasBandWorker * worker,
+ *                                     gpointer bands, gsize band_size,
+ *                                     guint num_bands)
+ *  @param [in] worker - Worker
+ *  @param [in] bands - Array of bands passed to the band function
+ *  @param [in] band_size - Size of an element of \p bands
+ *  @param [in] num_bands - Number of bands
+ *  @return None
+ *  @brief  Computes all bands and returns when they are done. The calling
+ *          thread computes the last band, and any band the pool refuses.
+ */
+void
+gst_vvas_band_worker_run (GstVvasBandWorker * worker, gpointer bands,
+    gsize band_size, guint num_bands)
+{
+  guint8 *band = (guint8 *) bands;
+  guint b;
+
+  if (!num_bands)
+    return;
+
+  worker->pending = num_bands;
+
+  for (b = 0; b < num_bands; b++, band += band_size) {
+    if (b + 1 == num_bands || !worker->pool ||
+        !g_thread_pool_push (worker->pool, band, NULL))
+      gst_vvas_band_worker_func (band, worker);
+  }
+
+  g_mutex_lock (&worker->lock);
+  while (worker->pending)
+    g_cond_wait (&worker->cond, &worker->lock);
+  g_mutex_unlock (&worker->lock);
+}
+
+/**
+ *  @fn void gst_vvas_band_worker_free (GstVvasBandWorker * worker)
+ *  @param [in] worker - Worker, no run in progress
+ *  @return None
+ */
+void
+gst_vvas_band_worker_free (GstVvasBandWorker * worker)
+{
+  if (!worker)
+    return;
+
+  if (worker->pool)
+    g_thread_pool_free (worker->pool, FALSE, TRUE);
+  g_mutex_clear (&worker->lock);
+  g_cond_clear (&worker->cond);
+  g_free (worker);
+}
@@ -23,3 +23,28 @@
 GST_EXPORT
 GstCaps * gst_vvas_utils_fixate_caps (GstElement * self,
     GstPadDirection direction, GstCaps * caps, GstCaps * othercaps);
+
+/* Threads a GstVvasBandWorker uses at most when given 0 */
+#define GST_VVAS_BAND_WORKER_MAX_THREADS 64
+
+typedef void (*GstVvasBandFunc) (gpointer band, gpointer user_data);
+
+typedef struct _GstVvasBandWorker GstVvasBandWorker;
+
+GST_EXPORT
+GstVvasBandWorker * gst_vvas_band_worker_new (guint num_threads,
+    GstVvasBandFunc func, gpointer user_data, GError ** error);
+
+GST_EXPORT
+guint gst_vvas_band_worker_get_num_threads (GstVvasBandWorker * worker);
+
+GST_EXPORT
+guint gst_vvas_band_worker_num_bands (GstVvasBandWorker * worker,
+    guint lines, guint min_lines);
+
+GST_EXPORT
+void gst_vvas_band_worker_run (GstVvasBandWorker * worker, gpointer bands,
+    gsize band_size, guint num_bands);
+
+GST_EXPORT
+void gst_vvas_band_worker_free (GstVvasBandWorker * worker);
@@ -0,0 +1,509 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * vvas_xdewarp removes lens distortion of wide angle and fisheye cameras
+ * ahead of scaling and inference, e.g.
+ *
+ *   ... ! vvas_xdewarp intrinsics="<1100.0, 1100.0, 960.0, 540.0>" \
+ *         distortion-coefficients="<-0.3, 0.09, 0.0, 0.0>" ! \
+ *         vvas_xabrscaler ...
+ *
+ * The camera model is the one of hls::InitUndistortRectifyMap and OpenCV.
+ * A remap LUT per plane is computed once per caps or property change, frames
+ * are then remapped by bands of lines on a pool of threads. Without
+ * distortion coefficients the element is passthrough.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include <string.h>
+#include "gstvvas_xdewarp.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_vvas_xdewarp_debug_category);
+#define GST_CAT_DEFAULT gst_vvas_xdewarp_debug_category
+
+#define gst_vvas_xdewarp_parent_class parent_class
+
+static GstFlowReturn gst_vvas_xdewarp_transform (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer * outbuf);
+static void gst_vvas_xdewarp_before_transform (GstBaseTransform * trans,
+    GstBuffer * buffer);
+static gboolean gst_vvas_xdewarp_set_caps (GstBaseTransform * trans,
+    GstCaps * incaps, GstCaps * outcaps);
+static gboolean gst_vvas_xdewarp_start (GstBaseTransform * trans);
+static gboolean gst_vvas_xdewarp_stop (GstBaseTransform * trans);
+static void gst_vvas_xdewarp_finalize (GObject * gobject);
+
+enum
+{
+  PROP_0,
+  PROP_INTRINSICS,
+  PROP_DISTORTION_COEFFS,
+  PROP_NUM_THREADS
+};
+
+G_DEFINE_TYPE_WITH_CODE (GstVvas_XDewarp, gst_vvas_xdewarp,
+    GST_TYPE_BASE_TRANSFORM,
+    GST_DEBUG_CATEGORY_INIT (gst_vvas_xdewarp_debug_category, "vvas_xdewarp",
+        0, "debug category for VVAS dewarp element"));
+
+#define VVAS_XDEWARP_CAPS \
+    GST_VIDEO_CAPS_MAKE ("{ GRAY8, NV12, NV16, I420, RGB, BGR }")
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VVAS_XDEWARP_CAPS));
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VVAS_XDEWARP_CAPS));
+
+#define GSTVVAS_XDEWARP_DEFAULT_NUM_THREADS 0
+/* Lines remapped by a band at least, keeps thread overhead low on small
+ * chroma planes */
+#define GSTVVAS_XDEWARP_MIN_BAND_LINES 16
+
+static void
+gst_vvas_xdewarp_set_property (GObject * object,
+    guint prop_id, const GValue * value, GParamSpec * pspec)
+{
+  GstVvas_XDewarp *self = GST_VVAS_XDEWARP (object);
+  guint i, size;
+
+  GST_OBJECT_LOCK (self);
+  switch (prop_id) {
+    case PROP_INTRINSICS:
+      size = gst_value_array_get_size (value);
+      if (size != 4) {
+        g_warning ("intrinsics must be <fx, fy, cx, cy>");
+        break;
+      }
+      for (i = 0; i < size; i++)
+        self->intrinsics[i] =
+            g_value_get_double (gst_value_array_get_value (value, i));
+      self->maps_dirty = TRUE;
+      break;
+    case PROP_DISTORTION_COEFFS:
+      size = gst_value_array_get_size (value);
+      if (size != 0 && size != 4 && size != 5 && size != 8) {
+        g_warning ("distortion-coefficients takes 4, 5 or 8 values");
+        break;
+      }
+      memset (self->coeffs, 0, sizeof (self->coeffs));
+      for (i = 0; i < size; i++)
+        self->coeffs[i] =
+            g_value_get_double (gst_value_array_get_value (value, i));
+      self->maps_dirty = TRUE;
+      break;
+    case PROP_NUM_THREADS:
+      self->num_threads = g_value_get_uint (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gst_vvas_xdewarp_get_property (GObject * object,
+    guint prop_id, GValue * value, GParamSpec * pspec)
+{
+  GstVvas_XDewarp *self = GST_VVAS_XDEWARP (object);
+  GValue val = G_VALUE_INIT;
+  guint i;
+
+  GST_OBJECT_LOCK (self);
+  switch (prop_id) {
+    case PROP_INTRINSICS:
+      g_value_init (&val, G_TYPE_DOUBLE);
+      for (i = 0; i < 4; i++) {
+        g_value_set_double (&val, self->intrinsics[i]);
+        gst_value_array_append_value (value, &val);
+      }
+      g_value_unset (&val);
+      break;
+    case PROP_DISTORTION_COEFFS:
+      g_value_init (&val, G_TYPE_DOUBLE);
+      for (i = 0; i < VVAS_XDEWARP_MAX_COEFFS; i++) {
+        g_value_set_double (&val, self->coeffs[i]);
+        gst_value_array_append_value (value, &val);
+      }
+      g_value_unset (&val);
+      break;
+    case PROP_NUM_THREADS:
+      g_value_set_uint (value, self->num_threads);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gst_vvas_xdewarp_class_init (GstVvas_XDewarpClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstBaseTransformClass *transform_class = GST_BASE_TRANSFORM_CLASS (klass);
+
+  gobject_class->set_property = gst_vvas_xdewarp_set_property;
+  gobject_class->get_property = gst_vvas_xdewarp_get_property;
+  gobject_class->finalize = gst_vvas_xdewarp_finalize;
+
+  gst_element_class_add_pad_template (GST_ELEMENT_CLASS (klass),
+      gst_static_pad_template_get (&src_template));
+  gst_element_class_add_pad_template (GST_ELEMENT_CLASS (klass),
+      gst_static_pad_template_get (&sink_template));
+
+  g_object_class_install_property (gobject_class, PROP_INTRINSICS,
+      gst_param_spec_array ("intrinsics", "Camera intrinsics",
+          "Focal lengths and principal point in pixels of the negotiated "
+          "resolution ('<fx, fy, cx, cy>'), all 0 for a focal length of the "
+          "frame width and the frame centre",
+          g_param_spec_double ("intrinsic", "Intrinsic",
+              "One of fx, fy, cx or cy", 0, G_MAXDOUBLE, 0,
+              G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS),
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_DISTORTION_COEFFS,
+      gst_param_spec_array ("distortion-coefficients",
+          "Distortion coefficients",
+          "Lens distortion in OpenCV order ('<k1, k2, p1, p2[, k3[, k4, k5, "
+          "k6]]>'), empty or all 0 for passthrough",
+          g_param_spec_double ("coefficient", "Coefficient",
+              "One distortion coefficient", -G_MAXDOUBLE, G_MAXDOUBLE, 0,
+              G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS),
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_NUM_THREADS,
+      g_param_spec_uint ("num-threads", "Number of threads",
+          "Threads remapping a frame, 0 for one per CPU",
+          0, GST_VVAS_BAND_WORKER_MAX_THREADS,
+          GSTVVAS_XDEWARP_DEFAULT_NUM_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  gst_element_class_set_static_metadata (GST_ELEMENT_CLASS (klass),
+      "VVAS lens undistortion",
+      "Filter/Effect/Video", "Removes lens distortion with a precomputed "
+      "remap table", "Xilinx Inc");
+
+  transform_class->set_caps = GST_DEBUG_FUNCPTR (gst_vvas_xdewarp_set_caps);
+  transform_class->start = GST_DEBUG_FUNCPTR (gst_vvas_xdewarp_start);
+  transform_class->stop = GST_DEBUG_FUNCPTR (gst_vvas_xdewarp_stop);
+  transform_class->before_transform =
+      GST_DEBUG_FUNCPTR (gst_vvas_xdewarp_before_transform);
+  transform_class->transform = GST_DEBUG_FUNCPTR (gst_vvas_xdewarp_transform);
+}
+
+static void
+gst_vvas_xdewarp_init (GstVvas_XDewarp * self)
+{
+  memset (self->intrinsics, 0, sizeof (self->intrinsics));
+  memset (self->coeffs, 0, sizeof (self->coeffs));
+  memset (self->maps, 0, sizeof (self->maps));
+  self->num_threads = GSTVVAS_XDEWARP_DEFAULT_NUM_THREADS;
+  self->maps_dirty = TRUE;
+  gst_video_info_init (&self->vinfo);
+  self->worker = NULL;
+  self->bands = NULL;
+  self->num_bands = 0;
+}
+
+/**
+ *  @fn static void vvas_xdewarp_clear_maps (GstVvas_XDewarp * self)
+ *  @param [in] self - Element
+ *  @return None
+ */
+static void
+vvas_xdewarp_clear_maps (GstVvas_XDewarp * self)
+{
+  guint i;
+
+  for (i = 0; i < GST_VIDEO_MAX_PLANES; i++)
+    vvas_xdewarp_map_clear (&self->maps[i]);
+  g_free (self->bands);
+  self->bands = NULL;
+  self->num_bands = 0;
+}
+
+static void
+gst_vvas_xdewarp_finalize (GObject * gobject)
+{
+  GstVvas_XDewarp *self = GST_VVAS_XDEWARP (gobject);
+
+  vvas_xdewarp_clear_maps (self);
+
+  G_OBJECT_CLASS (parent_class)->finalize (gobject);
+}
+
+/**
+ *  @fn static void vvas_xdewarp_band_func (gpointer data, gpointer user_data)
+ *  @param [in] data - GstVvasXDewarpBand to remap
+ *  @param [in] user_data - Element
+ *  @return None
+ */
+static void
+vvas_xdewarp_band_func (gpointer data, gpointer user_data)
+{
+  GstVvasXDewarpBand *band = (GstVvasXDewarpBand *) data;
+  GstVvas_XDewarp *self = GST_VVAS_XDEWARP (user_data);
+  guint p = band->plane;
+
+  vvas_xdewarp_remap (&self->maps[p],
+      GST_VIDEO_FRAME_PLANE_DATA (self->in_frame, p),
+      GST_VIDEO_FRAME_PLANE_STRIDE (self->in_frame, p),
+      GST_VIDEO_FRAME_PLANE_DATA (self->out_frame, p),
+      GST_VIDEO_FRAME_PLANE_STRIDE (self->out_frame, p), self->channels[p],
+      self->border[p], band->first_line, band->num_lines);
+}
+
+static gboolean
+gst_vvas_xdewarp_start (GstBaseTransform * trans)
+{
+  GstVvas_XDewarp *self = GST_VVAS_XDEWARP (trans);
+  GError *error = NULL;
+  guint num_threads;
+
+  GST_OBJECT_LOCK (self);
+  num_threads = self->num_threads;
+  GST_OBJECT_UNLOCK (self);
+
+  /* The streaming thread remaps the last band itself */
+  self->worker = gst_vvas_band_worker_new (num_threads,
+      vvas_xdewarp_band_func, self, &error);
+  if (!self->worker) {
+    GST_ERROR_OBJECT (self, "failed to create remap threads: %s",
+        error->message);
+    g_error_free (error);
+    return FALSE;
+  }
+
+  GST_DEBUG_OBJECT (self, "remapping on %u threads",
+      gst_vvas_band_worker_get_num_threads (self->worker));
+
+  return TRUE;
+}
+
+static gboolean
+gst_vvas_xdewarp_stop (GstBaseTransform * trans)
+{
+  GstVvas_XDewarp *self = GST_VVAS_XDEWARP (trans);
+
+  gst_vvas_band_worker_free (self->worker);
+  self->worker = NULL;
+  vvas_xdewarp_clear_maps (self);
+  self->maps_dirty = TRUE;
+
+  return TRUE;
+}
+
+static gboolean
+gst_vvas_xdewarp_set_caps (GstBaseTransform * trans, GstCaps * incaps,
+    GstCaps * outcaps)
+{
+  GstVvas_XDewarp *self = GST_VVAS_XDEWARP (trans);
+  GstVideoInfo vinfo;
+
+  if (!gst_video_info_from_caps (&vinfo, incaps)) {
+    GST_ERROR_OBJECT (self, "Failed to parse input caps");
+    return FALSE;
+  }
+
+  if (GST_VIDEO_INFO_WIDTH (&vinfo) > G_MAXINT16 ||
+      GST_VIDEO_INFO_HEIGHT (&vinfo) > G_MAXINT16) {
+    GST_ERROR_OBJECT (self, "resolution %dx%d not supported",
+        GST_VIDEO_INFO_WIDTH (&vinfo), GST_VIDEO_INFO_HEIGHT (&vinfo));
+    return FALSE;
+  }
+
+  self->vinfo = vinfo;
+
+  GST_OBJECT_LOCK (self);
+  self->maps_dirty = TRUE;
+  GST_OBJECT_UNLOCK (self);
+
+  return TRUE;
+}
+
+/**
+ *  @fn static void vvas_xdewarp_update_maps (GstVvas_XDewarp * self)
+ *  @param [in] self - Element
+ *  @return None
+ *  @brief  Computes the remap LUT and the bands of every plane for the
+ *          negotiated video info, passthrough without distortion
+ */
+static void
+vvas_xdewarp_update_maps (GstVvas_XDewarp * self)
+{
+  const GstVideoFormatInfo *finfo = self->vinfo.finfo;
+  guint width = GST_VIDEO_INFO_WIDTH (&self->vinfo);
+  guint height = GST_VIDEO_INFO_HEIGHT (&self->vinfo);
+  guint num_threads = gst_vvas_band_worker_get_num_threads (self->worker);
+  VvasXDewarpCamera cam;
+  gboolean identity;
+  guint p, c, b;
+
+  GST_OBJECT_LOCK (self);
+  cam.fx = self->intrinsics[0];
+  cam.fy = self->intrinsics[1];
+  cam.cx = self->intrinsics[2];
+  cam.cy = self->intrinsics[3];
+  memcpy (cam.coeffs, self->coeffs, sizeof (cam.coeffs));
+  self->maps_dirty = FALSE;
+  GST_OBJECT_UNLOCK (self);
+
+  if (cam.fx <= 0 || cam.fy <= 0) {
+    cam.fx = cam.fy = width;
+    cam.cx = (width - 1) / 2.0;
+    cam.cy = (height - 1) / 2.0;
+  }
+
+  vvas_xdewarp_clear_maps (self);
+  identity = vvas_xdewarp_camera_is_identity (&cam);
+  gst_base_transform_set_passthrough (GST_BASE_TRANSFORM (self), identity);
+  if (identity) {
+    GST_DEBUG_OBJECT (self, "no distortion, passthrough");
+    return;
+  }
+
+  self->bands = g_new (GstVvasXDewarpBand,
+      GST_VIDEO_INFO_N_PLANES (&self->vinfo) * num_threads);
+
+  for (p = 0; p < GST_VIDEO_INFO_N_PLANES (&self->vinfo); p++) {
+    VvasXDewarpCamera plane_cam;
+    guint plane_width = 0, plane_height = 0, lines, bands, first = 0;
+    guint sub_x = 1, sub_y = 1;
+
+    /* First component of the plane gives its size and sample layout */
+    for (c = 0; c < GST_VIDEO_INFO_N_COMPONENTS (&self->vinfo); c++) {
+      if (GST_VIDEO_FORMAT_INFO_PLANE (finfo, c) == p) {
+        plane_width = GST_VIDEO_INFO_COMP_WIDTH (&self->vinfo, c);
+        plane_height = GST_VIDEO_INFO_COMP_HEIGHT (&self->vinfo, c);
+        /* Not width / plane_width, which is wrong for odd sizes */
+        sub_x = 1 << GST_VIDEO_FORMAT_INFO_W_SUB (finfo, c);
+        sub_y = 1 << GST_VIDEO_FORMAT_INFO_H_SUB (finfo, c);
+        self->channels[p] = GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, c);
+        self->border[p] = GST_VIDEO_FORMAT_INFO_IS_YUV (finfo) ?
+            (c ? 128 : 16) : 0;
+        break;
+      }
+    }
+
+    vvas_xdewarp_camera_scale (&cam, sub_x, sub_y, &plane_cam);
+    vvas_xdewarp_map_init (&self->maps[p], &plane_cam, plane_width,
+        plane_height);
+
+    bands = gst_vvas_band_worker_num_bands (self->worker, plane_height,
+        GSTVVAS_XDEWARP_MIN_BAND_LINES);
+    for (b = 0; b < bands; b++) {
+      GstVvasXDewarpBand *band = &self->bands[self->num_bands++];
+
+      lines = (b + 1) * plane_height / bands;
+      band->plane = p;
+      band->first_line = first;
+      band->num_lines = lines - first;
+      first = lines;
+    }
+  }
+
+  GST_DEBUG_OBJECT (self, "remap maps of %ux%u computed, %u bands", width,
+      height, self->num_bands);
+}
+
+static void
+gst_vvas_xdewarp_before_transform (GstBaseTransform * trans,
+    GstBuffer * buffer)
+{
+  GstVvas_XDewarp *self = GST_VVAS_XDEWARP (trans);
+  gboolean dirty;
+
+  GST_OBJECT_LOCK (self);
+  dirty = self->maps_dirty;
+  GST_OBJECT_UNLOCK (self);
+
+  if (dirty)
+    vvas_xdewarp_update_maps (self);
+}
+
+static GstFlowReturn
+gst_vvas_xdewarp_transform (GstBaseTransform * trans, GstBuffer * inbuf,
+    GstBuffer * outbuf)
+{
+  GstVvas_XDewarp *self = GST_VVAS_XDEWARP (trans);
+  GstVideoFrame in_frame, out_frame;
+
+  if (!gst_video_frame_map (&in_frame, &self->vinfo, inbuf, GST_MAP_READ)) {
+    GST_ELEMENT_ERROR (self, RESOURCE, READ, (NULL),
+        ("failed to map input frame"));
+    return GST_FLOW_ERROR;
+  }
+  if (!gst_video_frame_map (&out_frame, &self->vinfo, outbuf, GST_MAP_WRITE)) {
+    gst_video_frame_unmap (&in_frame);
+    GST_ELEMENT_ERROR (self, RESOURCE, WRITE, (NULL),
+        ("failed to map output frame"));
+    return GST_FLOW_ERROR;
+  }
+
+  self->in_frame = &in_frame;
+  self->out_frame = &out_frame;
+  gst_vvas_band_worker_run (self->worker, self->bands,
+      sizeof (GstVvasXDewarpBand), self->num_bands);
+
+  self->in_frame = NULL;
+  self->out_frame = NULL;
+  gst_video_frame_unmap (&out_frame);
+  gst_video_frame_unmap (&in_frame);
+
+  return GST_FLOW_OK;
+}
+
+static gboolean
+vvas_xdewarp_init (GstPlugin * vvas_xdewarp)
+{
+  return gst_element_register (vvas_xdewarp, "vvas_xdewarp",
+      GST_RANK_PRIMARY, GST_TYPE_VVAS_XDEWARP);
+}
+
+/* PACKAGE: this is usually set by autotools depending on some _INIT macro
+ * in configure.ac and then written into and defined in config.h, but we can
+ * just set it ourselves here in case someone doesn't use autotools to
+ * compile this code. GST_PLUGIN_DEFINE needs PACKAGE to be defined.
+ */
+#ifndef PACKAGE
+#define PACKAGE "vvas_xdewarp"
+#endif
+
+GST_PLUGIN_DEFINE (GST_VERSION_MAJOR, GST_VERSION_MINOR, vvas_xdewarp,
+    "Xilinx VVAS SDK plugin to remove lens distortion", vvas_xdewarp_init,
+    VVAS_API_VERSION, "MIT/X11", "Xilinx VVAS SDK plugin", "http://xilinx.com/")
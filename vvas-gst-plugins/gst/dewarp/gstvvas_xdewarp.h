@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+#ifndef _GST_VVAS_XDEWARP_H_
+#define _GST_VVAS_XDEWARP_H_
+
+#include <gst/base/gstbasetransform.h>
+#include <gst/video/video.h>
+#include <gst/vvas/gstvvasutils.h>
+#include "vvas_xdewarp_remap.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_VVAS_XDEWARP   (gst_vvas_xdewarp_get_type())
+#define GST_VVAS_XDEWARP(obj)   (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_VVAS_XDEWARP,GstVvas_XDewarp))
+#define GST_VVAS_XDEWARP_CLASS(klass)   (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_VVAS_XDEWARP,GstVvas_XDewarpClass))
+#define GST_IS_VVAS_XDEWARP(obj)   (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_VVAS_XDEWARP))
+#define GST_IS_VVAS_XDEWARP_CLASS(obj)   (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_VVAS_XDEWARP))
+
+typedef struct _GstVvas_XDewarp GstVvas_XDewarp;
+typedef struct _GstVvas_XDewarpClass GstVvas_XDewarpClass;
+
+/**
+ *  @brief Band of a plane remapped by one thread
+ */
+typedef struct
+{
+  /** Plane index */
+  guint plane;
+  /** First output line */
+  guint first_line;
+  /** Number of output lines */
+  guint num_lines;
+} GstVvasXDewarpBand;
+
+struct _GstVvas_XDewarp
+{
+  GstBaseTransform parent;
+  /** fx, fy, cx, cy of the negotiated resolution, fx 0 for defaults */
+  gdouble intrinsics[4];
+  /** k1, k2, p1, p2, k3, k4, k5, k6 */
+  gdouble coeffs[VVAS_XDEWARP_MAX_COEFFS];
+  /** Remap threads, 0 for one per CPU */
+  guint num_threads;
+  /** Maps must be computed again before the next frame */
+  gboolean maps_dirty;
+  /** Negotiated video info, input and output are the same */
+  GstVideoInfo vinfo;
+  /** Remap LUT per plane */
+  VvasXDewarpMap maps[GST_VIDEO_MAX_PLANES];
+  /** Interleaved samples per pixel of each plane */
+  guint channels[GST_VIDEO_MAX_PLANES];
+  /** Value of pixels without source in each plane */
+  guint8 border[GST_VIDEO_MAX_PLANES];
+  /** Remap threads */
+  GstVvasBandWorker *worker;
+  /** Bands of all planes, run on worker for each frame */
+  GstVvasXDewarpBand *bands;
+  /** Number of bands */
+  guint num_bands;
+  /** Frames being remapped */
+  GstVideoFrame *in_frame;
+  GstVideoFrame *out_frame;
+};
+
+struct _GstVvas_XDewarpClass
+{
+  GstBaseTransformClass parentclass;
+};
+
+GType gst_vvas_xdewarp_get_type (void);
+
+G_END_DECLS
+
+#endif
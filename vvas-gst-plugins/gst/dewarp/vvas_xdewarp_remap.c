@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Lens undistortion by table lookup, the CPU counterpart of
+ * hls::InitUndistortRectifyMap and hls::Remap with HLS_INTER_LINEAR. The map
+ * holds, for each output pixel, the position in the distorted input in
+ * fixed point with 5 fraction bits. It is computed once in double precision,
+ * remapping then only needs integer arithmetic: bilinear weights are products
+ * of 5 bit fractions and sum up to exactly 1024.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <math.h>
+#include "vvas_xdewarp_remap.h"
+
+/**
+ *  @fn gboolean vvas_xdewarp_camera_is_identity (const VvasXDewarpCamera * cam)
+ *  @param [in] cam - Camera
+ *  @return TRUE if \p cam has no distortion, remapping copies the frame
+ */
+gboolean
+vvas_xdewarp_camera_is_identity (const VvasXDewarpCamera * cam)
+{
+  guint i;
+
+  for (i = 0; i < VVAS_XDEWARP_MAX_COEFFS; i++)
+    if (cam->coeffs[i] != 0.0)
+      return FALSE;
+
+  return TRUE;
+}
+
+/**
+ *  @fn void vvas_xdewarp_camera_scale (const VvasXDewarpCamera * cam,
+ *                                      guint sx, guint sy,
+ *                                      VvasXDewarpCamera * out)
+ *  @param [in] cam - Camera of the full resolution plane
+ *  @param [in] sx - Horizontal subsampling of the plane
+ *  @param [in] sy - Vertical subsampling of the plane
+ *  @param [out] out - Camera of the subsampled plane
+ *  @return None
+ *  @brief  Pixel centres of subsampled chroma are assumed in the middle of
+ *          the luma pixels they cover
+ */
+void
+vvas_xdewarp_camera_scale (const VvasXDewarpCamera * cam, guint sx, guint sy,
+    VvasXDewarpCamera * out)
+{
+  *out = *cam;
+  out->fx = cam->fx / sx;
+  out->fy = cam->fy / sy;
+  out->cx = (cam->cx + 0.5) / sx - 0.5;
+  out->cy = (cam->cy + 0.5) / sy - 0.5;
+}
+
+/**
+ *  @fn void vvas_xdewarp_distort_point (const VvasXDewarpCamera * cam,
+ *                                       gdouble x, gdouble y,
+ *                                       gdouble * u, gdouble * v)
+ *  @param [in] cam - Camera
+ *  @param [in] x - Column in the undistorted frame
+ *  @param [in] y - Line in the undistorted frame
+ *  @param [out] u - Column in the distorted frame
+ *  @param [out] v - Line in the distorted frame
+ *  @return None
+ */
+void
+vvas_xdewarp_distort_point (const VvasXDewarpCamera * cam, gdouble x,
+    gdouble y, gdouble * u, gdouble * v)
+{
+  const gdouble *k = cam->coeffs;
+  gdouble nx = (x - cam->cx) / cam->fx;
+  gdouble ny = (y - cam->cy) / cam->fy;
+  gdouble r2 = nx * nx + ny * ny;
+  gdouble kr = (1 + ((k[4] * r2 + k[1]) * r2 + k[0]) * r2) /
+      (1 + ((k[7] * r2 + k[6]) * r2 + k[5]) * r2);
+  gdouble dx = nx * kr + 2 * k[2] * nx * ny + k[3] * (r2 + 2 * nx * nx);
+  gdouble dy = ny * kr + k[2] * (r2 + 2 * ny * ny) + 2 * k[3] * nx * ny;
+
+  *u = cam->fx * dx + cam->cx;
+  *v = cam->fy * dy + cam->cy;
+}
+
+/**
+ *  @fn void vvas_xdewarp_map_init (VvasXDewarpMap * map,
+ *                                  const VvasXDewarpCamera * cam,
+ *                                  guint width, guint height)
+ *  @param [out] map - Map to compute
+ *  @param [in] cam - Camera of the plane
+ *  @param [in] width - Plane width, at most G_MAXINT16
+ *  @param [in] height - Plane height, at most G_MAXINT16
+ *  @return None
+ *  @brief  The undistorted frame has the intrinsics of the distorted one
+ */
+void
+vvas_xdewarp_map_init (VvasXDewarpMap * map, const VvasXDewarpCamera * cam,
+    guint width, guint height)
+{
+  const gdouble max_u = (gdouble) width - 1;
+  const gdouble max_v = (gdouble) height - 1;
+  guint x, y;
+
+  map->width = width;
+  map->height = height;
+  map->xy = g_new (gint16, (gsize) 2 * width * height);
+  map->frac = g_new (guint16, (gsize) width * height);
+
+  for (y = 0; y < height; y++) {
+    gint16 *xy = map->xy + (gsize) 2 * y * width;
+    guint16 *frac = map->frac + (gsize) y * width;
+
+    for (x = 0; x < width; x++) {
+      gdouble u, v;
+      gint iu, iv;
+
+      vvas_xdewarp_distort_point (cam, x, y, &u, &v);
+      if (!(u >= 0 && u <= max_u && v >= 0 && v <= max_v)) {
+        xy[2 * x] = -1;
+        xy[2 * x + 1] = -1;
+        frac[x] = 0;
+        continue;
+      }
+
+      /* Rounding can reach the last column or line, never beyond */
+      iu = (gint) lround (u * VVAS_XDEWARP_INTER_TAB_SIZE);
+      iv = (gint) lround (v * VVAS_XDEWARP_INTER_TAB_SIZE);
+      xy[2 * x] = iu >> VVAS_XDEWARP_INTER_BITS;
+      xy[2 * x + 1] = iv >> VVAS_XDEWARP_INTER_BITS;
+      frac[x] = (iu & (VVAS_XDEWARP_INTER_TAB_SIZE - 1)) |
+          ((iv & (VVAS_XDEWARP_INTER_TAB_SIZE - 1)) <<
+          VVAS_XDEWARP_INTER_BITS);
+    }
+  }
+}
+
+/**
+ *  @fn void vvas_xdewarp_map_clear (VvasXDewarpMap * map)
+ *  @param [in] map - Map to free
+ *  @return None
+ */
+void
+vvas_xdewarp_map_clear (VvasXDewarpMap * map)
+{
+  g_free (map->xy);
+  g_free (map->frac);
+  map->xy = NULL;
+  map->frac = NULL;
+  map->width = map->height = 0;
+}
+
+/**
+ *  @fn void vvas_xdewarp_remap (const VvasXDewarpMap * map,
+ *                               const guint8 * src, guint src_stride,
+ *                               guint8 * dst, guint dst_stride,
+ *                               guint channels, guint8 border,
+ *                               guint first_line, guint num_lines)
+ *  @param [in] map - Map of the plane
+ *  @param [in] src - Distorted plane
+ *  @param [in] src_stride - Line stride of \p src
+ *  @param [out] dst - Undistorted plane
+ *  @param [in] dst_stride - Line stride of \p dst
+ *  @param [in] channels - Interleaved samples per pixel
+ *  @param [in] border - Value of pixels whose source is outside the plane
+ *  @param [in] first_line - First output line to compute
+ *  @param [in] num_lines - Number of output lines to compute
+ *  @return None
+ *  @brief  Bilinear interpolation, output lines are independent so bands
+ *          can be computed on different threads
+ */
+void
+vvas_xdewarp_remap (const VvasXDewarpMap * map, const guint8 * src,
+    guint src_stride, guint8 * dst, guint dst_stride, guint channels,
+    guint8 border, guint first_line, guint num_lines)
+{
+  const guint one = VVAS_XDEWARP_INTER_TAB_SIZE;
+  const guint shift = 2 * VVAS_XDEWARP_INTER_BITS;
+  guint x, y, c;
+
+  for (y = first_line; y < first_line + num_lines; y++) {
+    const gint16 *xy = map->xy + (gsize) 2 * y * map->width;
+    const guint16 *frac = map->frac + (gsize) y * map->width;
+    guint8 *out = dst + (gsize) y * dst_stride;
+
+    for (x = 0; x < map->width; x++, out += channels) {
+      const guint8 *p0, *p1;
+      guint fu, fv, w00, w01, w10, w11, dx;
+
+      if (xy[2 * x] < 0) {
+        for (c = 0; c < channels; c++)
+          out[c] = border;
+        continue;
+      }
+
+      fu = frac[x] & (one - 1);
+      fv = frac[x] >> VVAS_XDEWARP_INTER_BITS;
+      p0 = src + (gsize) xy[2 * x + 1] * src_stride + xy[2 * x] * channels;
+      /* A zero fraction on the last column or line reads no neighbour */
+      p1 = fv ? p0 + src_stride : p0;
+      dx = fu ? channels : 0;
+
+      w00 = (one - fu) * (one - fv);
+      w01 = fu * (one - fv);
+      w10 = (one - fu) * fv;
+      w11 = fu * fv;
+
+      for (c = 0; c < channels; c++)
+        out[c] = (p0[c] * w00 + p0[c + dx] * w01 + p1[c] * w10 +
+            p1[c + dx] * w11 + (1 << (shift - 1))) >> shift;
+    }
+  }
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __VVAS_XDEWARP_REMAP_H__
+#define __VVAS_XDEWARP_REMAP_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/** @def VVAS_XDEWARP_INTER_BITS
+ *  @brief Fraction bits of source coordinates, HLS_INTER_BITS of
+ *         hls_video_undistort.h
+ */
+#define VVAS_XDEWARP_INTER_BITS 5
+/** @def VVAS_XDEWARP_INTER_TAB_SIZE
+ *  @brief Sub-pixel positions per pixel
+ */
+#define VVAS_XDEWARP_INTER_TAB_SIZE (1 << VVAS_XDEWARP_INTER_BITS)
+/** @def VVAS_XDEWARP_MAX_COEFFS
+ *  @brief Distortion coefficients k1, k2, p1, p2, k3, k4, k5, k6
+ */
+#define VVAS_XDEWARP_MAX_COEFFS 8
+
+/**
+ *  @brief Pinhole camera with radial and tangential lens distortion, the
+ *         model of hls::InitUndistortRectifyMap and OpenCV
+ */
+typedef struct
+{
+  /** Focal length along x in pixels */
+  gdouble fx;
+  /** Focal length along y in pixels */
+  gdouble fy;
+  /** Principal point column */
+  gdouble cx;
+  /** Principal point line */
+  gdouble cy;
+  /** k1, k2, p1, p2, k3, k4, k5, k6, unused ones are 0 */
+  gdouble coeffs[VVAS_XDEWARP_MAX_COEFFS];
+} VvasXDewarpCamera;
+
+/**
+ *  @brief Remap LUT of one plane in the map1/map2 layout of hls::Remap
+ */
+typedef struct
+{
+  /** Plane width */
+  guint width;
+  /** Plane height */
+  guint height;
+  /** Integer source column and line of each output pixel, column -1 when
+   *  the source lies outside the plane */
+  gint16 *xy;
+  /** Source fractions, column in bits 0 to 4, line in bits 5 to 9 */
+  guint16 *frac;
+} VvasXDewarpMap;
+
+gboolean vvas_xdewarp_camera_is_identity (const VvasXDewarpCamera * cam);
+void vvas_xdewarp_camera_scale (const VvasXDewarpCamera * cam, guint sx,
+    guint sy, VvasXDewarpCamera * out);
+void vvas_xdewarp_distort_point (const VvasXDewarpCamera * cam, gdouble x,
+    gdouble y, gdouble * u, gdouble * v);
+
+void vvas_xdewarp_map_init (VvasXDewarpMap * map,
+    const VvasXDewarpCamera * cam, guint width, guint height);
+void vvas_xdewarp_map_clear (VvasXDewarpMap * map);
+
+void vvas_xdewarp_remap (const VvasXDewarpMap * map, const guint8 * src,
+    guint src_stride, guint8 * dst, guint dst_stride, guint channels,
+    guint8 border, guint first_line, guint num_lines);
+
+G_END_DECLS
+
+#endif /* __VVAS_XDEWARP_REMAP_H__ */
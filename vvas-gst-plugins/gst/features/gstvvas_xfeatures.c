@@ -0,0 +1,368 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * vvas_xfeatures detects FAST-9 or Harris corners on the luma plane and
+ * attaches them to the buffer as GstVvasKeypointMeta, e.g. for global motion
+ * estimation ahead of a tracker or a stabiliser. Frames pass through
+ * unmodified.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include <string.h>
+#include <gst/vvas/gstvvaskeypointmeta.h>
+#include "gstvvas_xfeatures.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_vvas_xfeatures_debug_category);
+#define GST_CAT_DEFAULT gst_vvas_xfeatures_debug_category
+
+#define gst_vvas_xfeatures_parent_class parent_class
+
+/* Keypoints of the detector are handed to the meta as they are */
+G_STATIC_ASSERT (sizeof (VvasXFeaturesPoint) == sizeof (GstVvasKeypoint));
+
+static GstFlowReturn gst_vvas_xfeatures_transform_ip (GstBaseTransform *
+    trans, GstBuffer * buf);
+static gboolean gst_vvas_xfeatures_set_caps (GstBaseTransform * trans,
+    GstCaps * incaps, GstCaps * outcaps);
+static gboolean gst_vvas_xfeatures_stop (GstBaseTransform * trans);
+static void gst_vvas_xfeatures_finalize (GObject * gobject);
+
+enum
+{
+  PROP_0,
+  PROP_DETECTOR,
+  PROP_THRESHOLD,
+  PROP_NMS_RADIUS,
+  PROP_MAX_KEYPOINTS
+};
+
+G_DEFINE_TYPE_WITH_CODE (GstVvas_XFeatures, gst_vvas_xfeatures,
+    GST_TYPE_BASE_TRANSFORM,
+    GST_DEBUG_CATEGORY_INIT (gst_vvas_xfeatures_debug_category,
+        "vvas_xfeatures", 0, "debug category for VVAS features element"));
+
+#define VVAS_XFEATURES_CAPS GST_VIDEO_CAPS_MAKE ("{ GRAY8, NV12, NV16, I420 }")
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VVAS_XFEATURES_CAPS));
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VVAS_XFEATURES_CAPS));
+
+#define GST_TYPE_VVAS_XFEATURES_DETECTOR (gst_vvas_xfeatures_detector_type ())
+static GType
+gst_vvas_xfeatures_detector_type (void)
+{
+  static const GEnumValue values[] = {
+    {GST_VVAS_KEYPOINT_DETECTOR_FAST, "FAST-9 segment test", "fast"},
+    {GST_VVAS_KEYPOINT_DETECTOR_HARRIS, "Harris corner response", "harris"},
+    {0, NULL, NULL}
+  };
+  static GType id = 0;
+
+  if (g_once_init_enter ((gsize *) & id)) {
+    GType _id;
+
+    _id = g_enum_register_static ("GstVvasXFeaturesDetector", values);
+
+    g_once_init_leave ((gsize *) & id, _id);
+  }
+
+  return id;
+}
+
+#define GSTVVAS_XFEATURES_DEFAULT_DETECTOR GST_VVAS_KEYPOINT_DETECTOR_FAST
+#define GSTVVAS_XFEATURES_DEFAULT_THRESHOLD 20
+#define GSTVVAS_XFEATURES_DEFAULT_NMS_RADIUS 3
+#define GSTVVAS_XFEATURES_DEFAULT_MAX_KEYPOINTS 0
+#define GSTVVAS_XFEATURES_MAX_NMS_RADIUS 64
+
+static void
+gst_vvas_xfeatures_set_property (GObject * object,
+    guint prop_id, const GValue * value, GParamSpec * pspec)
+{
+  GstVvas_XFeatures *features = GST_VVAS_XFEATURES (object);
+
+  GST_OBJECT_LOCK (features);
+  switch (prop_id) {
+    case PROP_DETECTOR:
+      features->detector = g_value_get_enum (value);
+      break;
+    case PROP_THRESHOLD:
+      features->threshold = g_value_get_uint (value);
+      break;
+    case PROP_NMS_RADIUS:
+      features->nms_radius = g_value_get_uint (value);
+      break;
+    case PROP_MAX_KEYPOINTS:
+      features->max_keypoints = g_value_get_uint (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (features);
+}
+
+static void
+gst_vvas_xfeatures_get_property (GObject * object,
+    guint prop_id, GValue * value, GParamSpec * pspec)
+{
+  GstVvas_XFeatures *features = GST_VVAS_XFEATURES (object);
+
+  GST_OBJECT_LOCK (features);
+  switch (prop_id) {
+    case PROP_DETECTOR:
+      g_value_set_enum (value, features->detector);
+      break;
+    case PROP_THRESHOLD:
+      g_value_set_uint (value, features->threshold);
+      break;
+    case PROP_NMS_RADIUS:
+      g_value_set_uint (value, features->nms_radius);
+      break;
+    case PROP_MAX_KEYPOINTS:
+      g_value_set_uint (value, features->max_keypoints);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (features);
+}
+
+static void
+gst_vvas_xfeatures_class_init (GstVvas_XFeaturesClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstBaseTransformClass *transform_class = GST_BASE_TRANSFORM_CLASS (klass);
+
+  gobject_class->set_property = gst_vvas_xfeatures_set_property;
+  gobject_class->get_property = gst_vvas_xfeatures_get_property;
+  gobject_class->finalize = gst_vvas_xfeatures_finalize;
+
+  gst_element_class_add_pad_template (GST_ELEMENT_CLASS (klass),
+      gst_static_pad_template_get (&src_template));
+  gst_element_class_add_pad_template (GST_ELEMENT_CLASS (klass),
+      gst_static_pad_template_get (&sink_template));
+
+  g_object_class_install_property (gobject_class, PROP_DETECTOR,
+      g_param_spec_enum ("detector", "Detector",
+          "Corner detector run on the luma plane",
+          GST_TYPE_VVAS_XFEATURES_DETECTOR,
+          GSTVVAS_XFEATURES_DEFAULT_DETECTOR,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_THRESHOLD,
+      g_param_spec_uint ("threshold", "Threshold",
+          "FAST: minimum luma difference of the arc with the centre, "
+          "at most 255. Harris: minimum corner response",
+          0, G_MAXINT32, GSTVVAS_XFEATURES_DEFAULT_THRESHOLD,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_NMS_RADIUS,
+      g_param_spec_uint ("nms-radius", "NMS radius",
+          "Keep only keypoints with the largest score within this distance, "
+          "0 keeps all",
+          0, GSTVVAS_XFEATURES_MAX_NMS_RADIUS,
+          GSTVVAS_XFEATURES_DEFAULT_NMS_RADIUS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_MAX_KEYPOINTS,
+      g_param_spec_uint ("max-keypoints", "Maximum number of keypoints",
+          "Attach only the strongest keypoints of a frame, 0 attaches all",
+          0, G_MAXUINT16, GSTVVAS_XFEATURES_DEFAULT_MAX_KEYPOINTS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  gst_element_class_set_static_metadata (GST_ELEMENT_CLASS (klass),
+      "VVAS keypoint detector",
+      "Video/Filter", "Detects FAST or Harris corners and attaches them as "
+      "keypoint metadata", "Xilinx Inc");
+
+  transform_class->set_caps = GST_DEBUG_FUNCPTR (gst_vvas_xfeatures_set_caps);
+  transform_class->stop = GST_DEBUG_FUNCPTR (gst_vvas_xfeatures_stop);
+  transform_class->transform_ip =
+      GST_DEBUG_FUNCPTR (gst_vvas_xfeatures_transform_ip);
+}
+
+static void
+gst_vvas_xfeatures_init (GstVvas_XFeatures * features)
+{
+  features->detector = GSTVVAS_XFEATURES_DEFAULT_DETECTOR;
+  features->threshold = GSTVVAS_XFEATURES_DEFAULT_THRESHOLD;
+  features->nms_radius = GSTVVAS_XFEATURES_DEFAULT_NMS_RADIUS;
+  features->max_keypoints = GSTVVAS_XFEATURES_DEFAULT_MAX_KEYPOINTS;
+  gst_video_info_init (&features->vinfo);
+  memset (&features->scratch, 0, sizeof (features->scratch));
+  vvas_xfeatures_points_init (&features->points);
+  gst_base_transform_set_in_place (GST_BASE_TRANSFORM (features), TRUE);
+}
+
+static void
+gst_vvas_xfeatures_finalize (GObject * gobject)
+{
+  GstVvas_XFeatures *features = GST_VVAS_XFEATURES (gobject);
+
+  vvas_xfeatures_scratch_clear (&features->scratch);
+  vvas_xfeatures_points_clear (&features->points);
+
+  G_OBJECT_CLASS (parent_class)->finalize (gobject);
+}
+
+static gboolean
+gst_vvas_xfeatures_stop (GstBaseTransform * trans)
+{
+  GstVvas_XFeatures *features = GST_VVAS_XFEATURES (trans);
+
+  vvas_xfeatures_scratch_clear (&features->scratch);
+  vvas_xfeatures_points_clear (&features->points);
+
+  return TRUE;
+}
+
+static gboolean
+gst_vvas_xfeatures_set_caps (GstBaseTransform * trans, GstCaps * incaps,
+    GstCaps * outcaps)
+{
+  GstVvas_XFeatures *features = GST_VVAS_XFEATURES (trans);
+  GstVideoInfo vinfo;
+
+  if (!gst_video_info_from_caps (&vinfo, incaps)) {
+    GST_ERROR_OBJECT (features, "Failed to parse input caps");
+    return FALSE;
+  }
+
+  if (GST_VIDEO_INFO_WIDTH (&vinfo) > G_MAXUINT16 + 1 ||
+      GST_VIDEO_INFO_HEIGHT (&vinfo) > G_MAXUINT16 + 1) {
+    GST_ERROR_OBJECT (features, "resolution %dx%d not supported",
+        GST_VIDEO_INFO_WIDTH (&vinfo), GST_VIDEO_INFO_HEIGHT (&vinfo));
+    return FALSE;
+  }
+
+  /* Scratch buffers only depend on the resolution */
+  if ((guint) GST_VIDEO_INFO_WIDTH (&vinfo) != features->scratch.width ||
+      (guint) GST_VIDEO_INFO_HEIGHT (&vinfo) != features->scratch.height) {
+    vvas_xfeatures_scratch_clear (&features->scratch);
+    vvas_xfeatures_scratch_init (&features->scratch,
+        GST_VIDEO_INFO_WIDTH (&vinfo), GST_VIDEO_INFO_HEIGHT (&vinfo));
+  }
+
+  features->vinfo = vinfo;
+
+  GST_DEBUG_OBJECT (features, "detecting on %dx%d luma, %s FAST",
+      GST_VIDEO_INFO_WIDTH (&vinfo), GST_VIDEO_INFO_HEIGHT (&vinfo),
+      vvas_xfeatures_impl ());
+
+  return TRUE;
+}
+
+static GstFlowReturn
+gst_vvas_xfeatures_transform_ip (GstBaseTransform * trans, GstBuffer * buf)
+{
+  GstVvas_XFeatures *features = GST_VVAS_XFEATURES (trans);
+  VvasXFeaturesPoints *pts = &features->points;
+  GstVvasKeypointMeta *meta;
+  GstVideoFrame frame;
+  guint width = GST_VIDEO_INFO_WIDTH (&features->vinfo);
+  guint height = GST_VIDEO_INFO_HEIGHT (&features->vinfo);
+  guint threshold, nms_radius, max_keypoints;
+  gint detector;
+
+  GST_OBJECT_LOCK (features);
+  detector = features->detector;
+  threshold = features->threshold;
+  nms_radius = features->nms_radius;
+  max_keypoints = features->max_keypoints;
+  GST_OBJECT_UNLOCK (features);
+
+  if (!gst_video_frame_map (&frame, &features->vinfo, buf, GST_MAP_READ)) {
+    GST_ELEMENT_ERROR (features, RESOURCE, READ, (NULL),
+        ("failed to map input frame"));
+    return GST_FLOW_ERROR;
+  }
+
+  if (detector == GST_VVAS_KEYPOINT_DETECTOR_HARRIS)
+    vvas_xfeatures_harris (GST_VIDEO_FRAME_PLANE_DATA (&frame, 0), width,
+        height, GST_VIDEO_FRAME_PLANE_STRIDE (&frame, 0), threshold,
+        &features->scratch, pts);
+  else
+    vvas_xfeatures_fast (GST_VIDEO_FRAME_PLANE_DATA (&frame, 0), width,
+        height, GST_VIDEO_FRAME_PLANE_STRIDE (&frame, 0), MIN (threshold,
+            G_MAXUINT8), pts);
+
+  gst_video_frame_unmap (&frame);
+
+  vvas_xfeatures_nms (pts, nms_radius, &features->scratch);
+  vvas_xfeatures_keep_strongest (pts, max_keypoints);
+
+  meta = gst_buffer_add_vvas_keypoint_meta (buf);
+  if (!meta) {
+    GST_ERROR_OBJECT (features, "failed to add keypoint meta");
+    return GST_FLOW_ERROR;
+  }
+
+  meta->detector = detector;
+  meta->width = width;
+  meta->height = height;
+  gst_vvas_keypoint_meta_set_keypoints (meta,
+      (const GstVvasKeypoint *) pts->points, pts->len);
+
+  GST_LOG_OBJECT (features, "attached %u keypoints to buffer %p", pts->len,
+      buf);
+
+  return GST_FLOW_OK;
+}
+
+static gboolean
+vvas_xfeatures_init (GstPlugin * vvas_xfeatures)
+{
+  return gst_element_register (vvas_xfeatures, "vvas_xfeatures",
+      GST_RANK_PRIMARY, GST_TYPE_VVAS_XFEATURES);
+}
+
+/* PACKAGE: this is usually set by autotools depending on some _INIT macro
+ * in configure.ac and then written into and defined in config.h, but we can
+ * just set it ourselves here in case someone doesn't use autotools to
+ * compile this code. GST_PLUGIN_DEFINE needs PACKAGE to be defined.
+ */
+#ifndef PACKAGE
+#define PACKAGE "vvas_xfeatures"
+#endif
+
+GST_PLUGIN_DEFINE (GST_VERSION_MAJOR, GST_VERSION_MINOR, vvas_xfeatures,
+    "Xilinx VVAS SDK plugin to detect keypoints", vvas_xfeatures_init,
+    VVAS_API_VERSION, "MIT/X11", "Xilinx VVAS SDK plugin", "http://xilinx.com/")
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+#ifndef _GST_VVAS_XFEATURES_H_
+#define _GST_VVAS_XFEATURES_H_
+
+#include <gst/base/gstbasetransform.h>
+#include <gst/video/video.h>
+#include "vvas_xfeatures_detect.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_VVAS_XFEATURES   (gst_vvas_xfeatures_get_type())
+#define GST_VVAS_XFEATURES(obj)   (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_VVAS_XFEATURES,GstVvas_XFeatures))
+#define GST_VVAS_XFEATURES_CLASS(klass)   (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_VVAS_XFEATURES,GstVvas_XFeaturesClass))
+#define GST_IS_VVAS_XFEATURES(obj)   (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_VVAS_XFEATURES))
+#define GST_IS_VVAS_XFEATURES_CLASS(obj)   (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_VVAS_XFEATURES))
+
+typedef struct _GstVvas_XFeatures GstVvas_XFeatures;
+typedef struct _GstVvas_XFeaturesClass GstVvas_XFeaturesClass;
+
+struct _GstVvas_XFeatures
+{
+  GstBaseTransform parent;
+  /** Detector, GstVvasKeypointDetector */
+  gint detector;
+  /** FAST intensity difference or Harris response threshold */
+  guint threshold;
+  /** Half size of the non maximum suppression window, 0 disables it */
+  guint nms_radius;
+  /** Keypoints attached per frame, 0 for all */
+  guint max_keypoints;
+  /** Negotiated input video info */
+  GstVideoInfo vinfo;
+  /** Detector buffers sized for the negotiated caps */
+  VvasXFeaturesScratch scratch;
+  /** Keypoints of the current frame, reused from frame to frame */
+  VvasXFeaturesPoints points;
+};
+
+struct _GstVvas_XFeaturesClass
+{
+  GstBaseTransformClass parentclass;
+};
+
+GType gst_vvas_xfeatures_get_type (void);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,598 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * FAST-9 and Harris corner detection on a luma plane, the CPU counterparts of
+ * hls::FASTX and hls::Harris. FAST rejects most pixels with the four compass
+ * points of its circle, any arc of 9 contiguous pixels holds at least two of
+ * them. On x86 (SSE2) and aarch64 (NEON) this test runs on 16 pixels at once
+ * and only the survivors get the full segment test of the scalar code, so
+ * both paths return the same keypoints. Harris uses integer Sobel gradients
+ * and an integer response, R = 25 det - trace^2, i.e. k = 0.04, scaled down
+ * by 2^24.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include "vvas_xfeatures_detect.h"
+
+#if defined(__GNUC__) && defined(__SSE2__)
+#define VVAS_XFEATURES_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#define VVAS_XFEATURES_NEON 1
+#include <arm_neon.h>
+#endif
+
+/** @def VVAS_XFEATURES_POINTS_MIN_ALLOC
+ *  @brief Number of keypoints allocated at first add
+ */
+#define VVAS_XFEATURES_POINTS_MIN_ALLOC 256
+/** @def VVAS_XFEATURES_FAST_ARC
+ *  @brief Contiguous circle pixels of a FAST corner
+ */
+#define VVAS_XFEATURES_FAST_ARC 9
+/** @def VVAS_XFEATURES_HARRIS_SHIFT
+ *  @brief Scale of the Harris response
+ */
+#define VVAS_XFEATURES_HARRIS_SHIFT 24
+
+/** Bresenham circle of radius 3, clockwise from the top */
+static const gint8 fast_circle[16][2] = {
+  {0, -3}, {1, -3}, {2, -2}, {3, -1}, {3, 0}, {3, 1}, {2, 2}, {1, 3},
+  {0, 3}, {-1, 3}, {-2, 2}, {-3, 1}, {-3, 0}, {-3, -1}, {-2, -2}, {-1, -3}
+};
+
+/**
+ *  @fn void vvas_xfeatures_points_init (VvasXFeaturesPoints * pts)
+ *  @param [out] pts - Array to initialize
+ *  @return None
+ */
+void
+vvas_xfeatures_points_init (VvasXFeaturesPoints * pts)
+{
+  pts->len = 0;
+  pts->allocated = 0;
+  pts->points = NULL;
+}
+
+/**
+ *  @fn void vvas_xfeatures_points_clear (VvasXFeaturesPoints * pts)
+ *  @param [in] pts - Array to free
+ *  @return None
+ */
+void
+vvas_xfeatures_points_clear (VvasXFeaturesPoints * pts)
+{
+  g_free (pts->points);
+  vvas_xfeatures_points_init (pts);
+}
+
+/**
+ *  @fn static void vvas_xfeatures_points_add (VvasXFeaturesPoints * pts,
+ *                                             guint x, guint y, gint32 score)
+ *  @param [in] pts - Array to append to
+ *  @param [in] x - Column
+ *  @param [in] y - Line
+ *  @param [in] score - Corner strength
+ *  @return None
+ */
+static void
+vvas_xfeatures_points_add (VvasXFeaturesPoints * pts, guint x, guint y,
+    gint32 score)
+{
+  VvasXFeaturesPoint *pt;
+
+  if (pts->len == pts->allocated) {
+    pts->allocated = MAX (VVAS_XFEATURES_POINTS_MIN_ALLOC, 2 * pts->allocated);
+    pts->points = g_renew (VvasXFeaturesPoint, pts->points, pts->allocated);
+  }
+
+  pt = &pts->points[pts->len++];
+  pt->x = x;
+  pt->y = y;
+  pt->score = score;
+}
+
+/**
+ *  @fn void vvas_xfeatures_scratch_init (VvasXFeaturesScratch * scratch,
+ *                                        guint width, guint height)
+ *  @param [out] scratch - Buffers to allocate
+ *  @param [in] width - Frame width
+ *  @param [in] height - Frame height
+ *  @return None
+ */
+void
+vvas_xfeatures_scratch_init (VvasXFeaturesScratch * scratch, guint width,
+    guint height)
+{
+  scratch->width = width;
+  scratch->height = height;
+  scratch->map = g_new0 (gint32, (gsize) width * height);
+  /* 3 lines of the 3 gradient products and their vertical sums */
+  scratch->rows = g_new0 (gint32, (gsize) 12 * width);
+}
+
+/**
+ *  @fn void vvas_xfeatures_scratch_clear (VvasXFeaturesScratch * scratch)
+ *  @param [in] scratch - Buffers to free
+ *  @return None
+ */
+void
+vvas_xfeatures_scratch_clear (VvasXFeaturesScratch * scratch)
+{
+  g_free (scratch->map);
+  g_free (scratch->rows);
+  scratch->map = NULL;
+  scratch->rows = NULL;
+  scratch->width = scratch->height = 0;
+}
+
+/**
+ *  @fn static gint vvas_xfeatures_fast_score (const guint8 * p, guint stride,
+ *                                             gint threshold)
+ *  @param [in] p - Pixel to test
+ *  @param [in] stride - Line stride
+ *  @param [in] threshold - Minimum difference with the centre
+ *  @return Smallest absolute difference along the best arc of 9 pixels all
+ *          brighter or all darker than the centre, 0 if \p p is no corner
+ */
+static gint
+vvas_xfeatures_fast_score (const guint8 * p, guint stride, gint threshold)
+{
+  gint d[16 + VVAS_XFEATURES_FAST_ARC - 1];
+  gint i, j, best = 0;
+
+  for (i = 0; i < 16; i++)
+    d[i] = (gint) p[fast_circle[i][1] * (gint) stride + fast_circle[i][0]] -
+        (gint) p[0];
+  for (i = 16; i < 16 + VVAS_XFEATURES_FAST_ARC - 1; i++)
+    d[i] = d[i - 16];
+
+  for (i = 0; i < 16; i++) {
+    gint lo = G_MAXINT, hi = G_MAXINT;
+
+    for (j = 0; j < VVAS_XFEATURES_FAST_ARC; j++) {
+      lo = MIN (lo, d[i + j]);
+      hi = MIN (hi, -d[i + j]);
+    }
+    best = MAX (best, MAX (lo, hi));
+  }
+
+  return best > threshold ? best : 0;
+}
+
+/**
+ *  @fn static gboolean vvas_xfeatures_fast_candidate (const guint8 * p,
+ *                                                     guint stride,
+ *                                                     gint threshold)
+ *  @param [in] p - Pixel to test
+ *  @param [in] stride - Line stride
+ *  @param [in] threshold - Minimum difference with the centre
+ *  @return TRUE if at least 2 compass points are brighter or 2 are darker
+ */
+static gboolean
+vvas_xfeatures_fast_candidate (const guint8 * p, guint stride, gint threshold)
+{
+  const guint8 c[4] = { p[-3 * (gint) stride], p[3], p[3 * stride], p[-3] };
+  gint i, brighter = 0, darker = 0;
+
+  for (i = 0; i < 4; i++) {
+    brighter += c[i] > p[0] + threshold;
+    darker += c[i] < p[0] - threshold;
+  }
+
+  return brighter >= 2 || darker >= 2;
+}
+
+/**
+ *  @fn static void vvas_xfeatures_fast_test (const guint8 * line, guint x,
+ *                                            guint y, guint stride,
+ *                                            gint threshold,
+ *                                            VvasXFeaturesPoints * pts)
+ *  @param [in] line - First pixel of line \p y
+ *  @param [in] x - Column to test
+ *  @param [in] y - Line to test
+ *  @param [in] stride - Line stride
+ *  @param [in] threshold - Minimum difference with the centre
+ *  @param [out] pts - Keypoints, appended to when (x, y) is a corner
+ *  @return None
+ */
+static inline void
+vvas_xfeatures_fast_test (const guint8 * line, guint x, guint y, guint stride,
+    gint threshold, VvasXFeaturesPoints * pts)
+{
+  gint score;
+
+  if (!vvas_xfeatures_fast_candidate (line + x, stride, threshold))
+    return;
+  score = vvas_xfeatures_fast_score (line + x, stride, threshold);
+  if (score)
+    vvas_xfeatures_points_add (pts, x, y, score);
+}
+
+/**
+ *  @fn void vvas_xfeatures_fast_scalar (const guint8 * luma, guint width,
+ *                                       guint height, guint stride,
+ *                                       guint8 threshold,
+ *                                       VvasXFeaturesPoints * pts)
+ *  @param [in] luma - Luma plane
+ *  @param [in] width - Frame width
+ *  @param [in] height - Frame height
+ *  @param [in] stride - Line stride
+ *  @param [in] threshold - Minimum difference of the arc with the centre
+ *  @param [out] pts - FAST-9 corners in raster order, replaces content
+ *  @return None
+ *  @brief  Scalar reference of vvas_xfeatures_fast()
+ */
+void
+vvas_xfeatures_fast_scalar (const guint8 * luma, guint width, guint height,
+    guint stride, guint8 threshold, VvasXFeaturesPoints * pts)
+{
+  guint x, y;
+
+  pts->len = 0;
+  if (width <= 2 * VVAS_XFEATURES_FAST_BORDER ||
+      height <= 2 * VVAS_XFEATURES_FAST_BORDER)
+    return;
+
+  for (y = VVAS_XFEATURES_FAST_BORDER;
+      y < height - VVAS_XFEATURES_FAST_BORDER; y++) {
+    const guint8 *line = luma + (gsize) y * stride;
+
+    for (x = VVAS_XFEATURES_FAST_BORDER;
+        x < width - VVAS_XFEATURES_FAST_BORDER; x++)
+      vvas_xfeatures_fast_test (line, x, y, stride, threshold, pts);
+  }
+}
+
+/**
+ *  @fn void vvas_xfeatures_fast (const guint8 * luma, guint width,
+ *                                guint height, guint stride, guint8 threshold,
+ *                                VvasXFeaturesPoints * pts)
+ *  @param [in] luma - Luma plane
+ *  @param [in] width - Frame width
+ *  @param [in] height - Frame height
+ *  @param [in] stride - Line stride
+ *  @param [in] threshold - Minimum difference of the arc with the centre
+ *  @param [out] pts - FAST-9 corners in raster order, replaces content
+ *  @return None
+ *  @brief  Same keypoints as vvas_xfeatures_fast_scalar(), the compass test
+ *          runs on 16 pixels per vector where SIMD is available
+ */
+void
+vvas_xfeatures_fast (const guint8 * luma, guint width, guint height,
+    guint stride, guint8 threshold, VvasXFeaturesPoints * pts)
+{
+#if defined(VVAS_XFEATURES_SSE2) || defined(VVAS_XFEATURES_NEON)
+  guint x, y, end;
+
+  pts->len = 0;
+  if (width <= 2 * VVAS_XFEATURES_FAST_BORDER ||
+      height <= 2 * VVAS_XFEATURES_FAST_BORDER)
+    return;
+
+  end = width - VVAS_XFEATURES_FAST_BORDER;
+  for (y = VVAS_XFEATURES_FAST_BORDER;
+      y < height - VVAS_XFEATURES_FAST_BORDER; y++) {
+    const guint8 *line = luma + (gsize) y * stride;
+
+    for (x = VVAS_XFEATURES_FAST_BORDER; x + 16 <= end; x += 16) {
+      const guint8 *p = line + x;
+      guint i;
+#if defined(VVAS_XFEATURES_SSE2)
+      const __m128i one = _mm_set1_epi8 (1);
+      const __m128i t = _mm_set1_epi8 ((gchar) threshold);
+      __m128i c = _mm_loadu_si128 ((const __m128i *) p);
+      __m128i hi = _mm_adds_epu8 (c, t);
+      __m128i lo = _mm_subs_epu8 (c, t);
+      __m128i n = _mm_loadu_si128 ((const __m128i *) (p - 3 * stride));
+      __m128i e = _mm_loadu_si128 ((const __m128i *) (p + 3));
+      __m128i s = _mm_loadu_si128 ((const __m128i *) (p + 3 * stride));
+      __m128i w = _mm_loadu_si128 ((const __m128i *) (p - 3));
+      /* 1 per compass point above c + t, resp. below c - t */
+      __m128i brighter =
+          _mm_add_epi8 (_mm_add_epi8 (_mm_min_epu8 (_mm_subs_epu8 (n, hi),
+                  one), _mm_min_epu8 (_mm_subs_epu8 (e, hi), one)),
+          _mm_add_epi8 (_mm_min_epu8 (_mm_subs_epu8 (s, hi), one),
+              _mm_min_epu8 (_mm_subs_epu8 (w, hi), one)));
+      __m128i darker =
+          _mm_add_epi8 (_mm_add_epi8 (_mm_min_epu8 (_mm_subs_epu8 (lo, n),
+                  one), _mm_min_epu8 (_mm_subs_epu8 (lo, e), one)),
+          _mm_add_epi8 (_mm_min_epu8 (_mm_subs_epu8 (lo, s), one),
+              _mm_min_epu8 (_mm_subs_epu8 (lo, w), one)));
+      __m128i pass = _mm_or_si128 (_mm_subs_epu8 (brighter, one),
+          _mm_subs_epu8 (darker, one));
+      guint mask = ~_mm_movemask_epi8 (_mm_cmpeq_epi8 (pass,
+              _mm_setzero_si128 ())) & 0xffff;
+
+      for (i = 0; mask; i++, mask >>= 1) {
+        if (mask & 1) {
+          gint score = vvas_xfeatures_fast_score (p + i, stride, threshold);
+
+          if (score)
+            vvas_xfeatures_points_add (pts, x + i, y, score);
+        }
+      }
+#else
+      const uint8x16_t one = vdupq_n_u8 (1);
+      const uint8x16_t t = vdupq_n_u8 (threshold);
+      uint8x16_t c = vld1q_u8 (p);
+      uint8x16_t hi = vqaddq_u8 (c, t);
+      uint8x16_t lo = vqsubq_u8 (c, t);
+      uint8x16_t n = vld1q_u8 (p - 3 * stride);
+      uint8x16_t e = vld1q_u8 (p + 3);
+      uint8x16_t s = vld1q_u8 (p + 3 * stride);
+      uint8x16_t w = vld1q_u8 (p - 3);
+      uint8x16_t brighter =
+          vaddq_u8 (vaddq_u8 (vandq_u8 (vcgtq_u8 (n, hi), one),
+              vandq_u8 (vcgtq_u8 (e, hi), one)),
+          vaddq_u8 (vandq_u8 (vcgtq_u8 (s, hi), one),
+              vandq_u8 (vcgtq_u8 (w, hi), one)));
+      uint8x16_t darker =
+          vaddq_u8 (vaddq_u8 (vandq_u8 (vcltq_u8 (n, lo), one),
+              vandq_u8 (vcltq_u8 (e, lo), one)),
+          vaddq_u8 (vandq_u8 (vcltq_u8 (s, lo), one),
+              vandq_u8 (vcltq_u8 (w, lo), one)));
+      uint8x16_t pass = vorrq_u8 (vqsubq_u8 (brighter, one),
+          vqsubq_u8 (darker, one));
+      guint8 lanes[16];
+
+      if (!vmaxvq_u8 (pass))
+        continue;
+      vst1q_u8 (lanes, pass);
+      for (i = 0; i < 16; i++) {
+        if (lanes[i]) {
+          gint score = vvas_xfeatures_fast_score (p + i, stride, threshold);
+
+          if (score)
+            vvas_xfeatures_points_add (pts, x + i, y, score);
+        }
+      }
+#endif
+    }
+
+    for (; x < end; x++)
+      vvas_xfeatures_fast_test (line, x, y, stride, threshold, pts);
+  }
+#else
+  vvas_xfeatures_fast_scalar (luma, width, height, stride, threshold, pts);
+#endif
+}
+
+/**
+ *  @fn void vvas_xfeatures_harris (const guint8 * luma, guint width,
+ *                                  guint height, guint stride,
+ *                                  gint32 threshold,
+ *                                  VvasXFeaturesScratch * scratch,
+ *                                  VvasXFeaturesPoints * pts)
+ *  @param [in] luma - Luma plane
+ *  @param [in] width - Frame width, same as \p scratch
+ *  @param [in] height - Frame height, same as \p scratch
+ *  @param [in] stride - Line stride
+ *  @param [in] threshold - Minimum response
+ *  @param [in] scratch - Buffers of the frame size
+ *  @param [out] pts - Harris corners in raster order, replaces content
+ *  @return None
+ *  @brief  3x3 Sobel gradients, structure tensor summed over 3x3 pixels
+ */
+void
+vvas_xfeatures_harris (const guint8 * luma, guint width, guint height,
+    guint stride, gint32 threshold, VvasXFeaturesScratch * scratch,
+    VvasXFeaturesPoints * pts)
+{
+  gint32 *vxx = scratch->rows + 9 * width;
+  gint32 *vyy = vxx + width;
+  gint32 *vxy = vyy + width;
+  guint x, y;
+
+  pts->len = 0;
+  if (width <= 2 * VVAS_XFEATURES_HARRIS_BORDER ||
+      height <= 2 * VVAS_XFEATURES_HARRIS_BORDER)
+    return;
+
+  for (y = 1; y < height - 1; y++) {
+    const guint8 *up = luma + (gsize) (y - 1) * stride;
+    const guint8 *mid = up + stride;
+    const guint8 *down = mid + stride;
+    gint32 *xx = scratch->rows + (y % 3) * 3 * width;
+    gint32 *yy = xx + width;
+    gint32 *xy = yy + width;
+    const gint32 *xx0, *xx1, *yy0, *yy1, *xy0, *xy1;
+    guint c;
+
+    for (x = 1; x < width - 1; x++) {
+      gint32 ix = (up[x + 1] + 2 * mid[x + 1] + down[x + 1]) -
+          (up[x - 1] + 2 * mid[x - 1] + down[x - 1]);
+      gint32 iy = (down[x - 1] + 2 * down[x] + down[x + 1]) -
+          (up[x - 1] + 2 * up[x] + up[x + 1]);
+
+      xx[x] = ix * ix;
+      yy[x] = iy * iy;
+      xy[x] = ix * iy;
+    }
+
+    /* Responses of line y - 1 need the products of lines y - 2 to y */
+    if (y < 3)
+      continue;
+
+    c = y - 1;
+    xx0 = scratch->rows + ((y + 1) % 3) * 3 * width;
+    yy0 = xx0 + width;
+    xy0 = yy0 + width;
+    xx1 = scratch->rows + ((y + 2) % 3) * 3 * width;
+    yy1 = xx1 + width;
+    xy1 = yy1 + width;
+    for (x = 1; x < width - 1; x++) {
+      vxx[x] = xx0[x] + xx1[x] + xx[x];
+      vyy[x] = yy0[x] + yy1[x] + yy[x];
+      vxy[x] = xy0[x] + xy1[x] + xy[x];
+    }
+
+    for (x = VVAS_XFEATURES_HARRIS_BORDER;
+        x < width - VVAS_XFEATURES_HARRIS_BORDER; x++) {
+      gint64 sxx = vxx[x - 1] + vxx[x] + vxx[x + 1];
+      gint64 syy = vyy[x - 1] + vyy[x] + vyy[x + 1];
+      gint64 sxy = vxy[x - 1] + vxy[x] + vxy[x + 1];
+      gint64 trace = sxx + syy;
+      gint64 r = 25 * (sxx * syy - sxy * sxy) - trace * trace;
+      gint64 score;
+
+      if (r <= 0)
+        continue;
+      score = MIN (r >> VVAS_XFEATURES_HARRIS_SHIFT, G_MAXINT32);
+      if (score > threshold)
+        vvas_xfeatures_points_add (pts, x, c, (gint32) score);
+    }
+  }
+}
+
+/**
+ *  @fn void vvas_xfeatures_nms (VvasXFeaturesPoints * pts, guint radius,
+ *                               VvasXFeaturesScratch * scratch)
+ *  @param [in,out] pts - Keypoints in raster order, positive scores
+ *  @param [in] radius - Half size of the suppression window, 0 to keep all
+ *  @param [in] scratch - Buffers of the frame size, map must be zero
+ *  @return None
+ *  @brief  Keeps the keypoints whose score is the largest of the
+ *          (2 radius + 1)^2 window around them. Of equal scores the first
+ *          one in raster order is kept.
+ */
+void
+vvas_xfeatures_nms (VvasXFeaturesPoints * pts, guint radius,
+    VvasXFeaturesScratch * scratch)
+{
+  guint width = scratch->width;
+  guint height = scratch->height;
+  guint i, kept = 0;
+
+  if (!radius)
+    return;
+
+  for (i = 0; i < pts->len; i++)
+    scratch->map[pts->points[i].y * width + pts->points[i].x] =
+        pts->points[i].score;
+
+  /* Suppressed keypoints are marked with a negative score, the map keeps
+   * the original scores until all keypoints are decided */
+  for (i = 0; i < pts->len; i++) {
+    VvasXFeaturesPoint *pt = &pts->points[i];
+    guint x0 = pt->x > radius ? pt->x - radius : 0;
+    guint y0 = pt->y > radius ? pt->y - radius : 0;
+    guint x1 = MIN (pt->x + radius, width - 1);
+    guint y1 = MIN (pt->y + radius, height - 1);
+    guint x, y;
+
+    for (y = y0; y <= y1 && pt->score > 0; y++) {
+      const gint32 *row = scratch->map + y * width;
+
+      for (x = x0; x <= x1; x++) {
+        gboolean before = y < pt->y || (y == pt->y && x < pt->x);
+
+        if (row[x] > pt->score || (row[x] == pt->score && before)) {
+          pt->score = -pt->score;
+          break;
+        }
+      }
+    }
+  }
+
+  for (i = 0; i < pts->len; i++) {
+    VvasXFeaturesPoint *pt = &pts->points[i];
+
+    scratch->map[pt->y * width + pt->x] = 0;
+    if (pt->score > 0)
+      pts->points[kept++] = *pt;
+  }
+  pts->len = kept;
+}
+
+/**
+ *  @fn static gint vvas_xfeatures_compare_score (gconstpointer a,
+ *                                                gconstpointer b)
+ *  @param [in] a - Keypoint
+ *  @param [in] b - Keypoint
+ *  @return Order of stronger first, raster order among equal scores
+ */
+static gint
+vvas_xfeatures_compare_score (gconstpointer a, gconstpointer b)
+{
+  const VvasXFeaturesPoint *pa = a, *pb = b;
+
+  if (pa->score != pb->score)
+    return pa->score > pb->score ? -1 : 1;
+  if (pa->y != pb->y)
+    return pa->y < pb->y ? -1 : 1;
+  return (gint) pa->x - (gint) pb->x;
+}
+
+/**
+ *  @fn static gint vvas_xfeatures_compare_raster (gconstpointer a,
+ *                                                 gconstpointer b)
+ *  @param [in] a - Keypoint
+ *  @param [in] b - Keypoint
+ *  @return Raster order
+ */
+static gint
+vvas_xfeatures_compare_raster (gconstpointer a, gconstpointer b)
+{
+  const VvasXFeaturesPoint *pa = a, *pb = b;
+
+  if (pa->y != pb->y)
+    return pa->y < pb->y ? -1 : 1;
+  return (gint) pa->x - (gint) pb->x;
+}
+
+/**
+ *  @fn void vvas_xfeatures_keep_strongest (VvasXFeaturesPoints * pts,
+ *                                          guint max)
+ *  @param [in,out] pts - Keypoints in raster order
+ *  @param [in] max - Number of keypoints to keep, 0 to keep all
+ *  @return None
+ *  @brief  Drops all but the \p max strongest keypoints, raster order is kept
+ */
+void
+vvas_xfeatures_keep_strongest (VvasXFeaturesPoints * pts, guint max)
+{
+  if (!max || pts->len <= max)
+    return;
+
+  qsort (pts->points, pts->len, sizeof (VvasXFeaturesPoint),
+      vvas_xfeatures_compare_score);
+  pts->len = max;
+  qsort (pts->points, pts->len, sizeof (VvasXFeaturesPoint),
+      vvas_xfeatures_compare_raster);
+}
+
+/**
+ *  @fn const gchar * vvas_xfeatures_impl (void)
+ *  @return Name of the FAST compass test implementation
+ */
+const gchar *
+vvas_xfeatures_impl (void)
+{
+#if defined(VVAS_XFEATURES_SSE2)
+  return "sse2";
+#elif defined(VVAS_XFEATURES_NEON)
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
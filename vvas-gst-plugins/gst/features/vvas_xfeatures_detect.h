@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __VVAS_XFEATURES_DETECT_H__
+#define __VVAS_XFEATURES_DETECT_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/** @def VVAS_XFEATURES_FAST_BORDER
+ *  @brief Pixels next to the frame edges FAST does not test
+ */
+#define VVAS_XFEATURES_FAST_BORDER 3
+/** @def VVAS_XFEATURES_HARRIS_BORDER
+ *  @brief Pixels next to the frame edges Harris does not test
+ */
+#define VVAS_XFEATURES_HARRIS_BORDER 2
+
+/**
+ *  @brief Keypoint, same layout as GstVvasKeypoint
+ */
+typedef struct
+{
+  /** Column */
+  guint16 x;
+  /** Line */
+  guint16 y;
+  /** Corner strength, larger is stronger */
+  gint32 score;
+} VvasXFeaturesPoint;
+
+/**
+ *  @brief Growing array of keypoints in raster order
+ */
+typedef struct
+{
+  /** Number of keypoints */
+  guint len;
+  /** Number of keypoints allocated */
+  guint allocated;
+  /** Keypoints */
+  VvasXFeaturesPoint *points;
+} VvasXFeaturesPoints;
+
+/**
+ *  @brief Buffers reused from frame to frame
+ */
+typedef struct
+{
+  /** Frame width */
+  guint width;
+  /** Frame height */
+  guint height;
+  /** Score of every candidate, zero elsewhere, for non maximum suppression */
+  gint32 *map;
+  /** Sliding rows of the Harris structure tensor */
+  gint32 *rows;
+} VvasXFeaturesScratch;
+
+void vvas_xfeatures_points_init (VvasXFeaturesPoints * pts);
+void vvas_xfeatures_points_clear (VvasXFeaturesPoints * pts);
+
+void vvas_xfeatures_scratch_init (VvasXFeaturesScratch * scratch,
+    guint width, guint height);
+void vvas_xfeatures_scratch_clear (VvasXFeaturesScratch * scratch);
+
+void vvas_xfeatures_fast (const guint8 * luma, guint width, guint height,
+    guint stride, guint8 threshold, VvasXFeaturesPoints * pts);
+void vvas_xfeatures_fast_scalar (const guint8 * luma, guint width,
+    guint height, guint stride, guint8 threshold, VvasXFeaturesPoints * pts);
+
+void vvas_xfeatures_harris (const guint8 * luma, guint width, guint height,
+    guint stride, gint32 threshold, VvasXFeaturesScratch * scratch,
+    VvasXFeaturesPoints * pts);
+
+void vvas_xfeatures_nms (VvasXFeaturesPoints * pts, guint radius,
+    VvasXFeaturesScratch * scratch);
+void vvas_xfeatures_keep_strongest (VvasXFeaturesPoints * pts, guint max);
+
+const gchar *vvas_xfeatures_impl (void);
+
+G_END_DECLS
+
+#endif /* __VVAS_XFEATURES_DETECT_H__ */
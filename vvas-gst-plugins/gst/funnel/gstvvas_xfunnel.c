@@ -32,6 +32,7 @@
 
 #include <gst/gst.h>
 #include <gst/vvas/gstvvassrcidmeta.h>
+#include <gst/vvas/gstvvastrace.h>
 #include "gstvvas_xfunnel.h"
 
 /** @def GST_CAT_DEFAULT
@@ -925,6 +926,8 @@ gst_vvas_xfunnel_sink_chain (GstPad * pad, GstObject * parent,
     g_cond_wait (&fpad->cond, &fpad->lock);
   }
   g_queue_push_tail (fpad->queue, buffer);
+  gst_vvas_trace_value (GST_OBJECT (fpad), GST_VVAS_TRACE_QUEUE_DEPTH,
+      queue_len + 1);
   /* If processing thread is waiting for buffer, unblock it */
   g_cond_signal (&fpad->cond);
   g_mutex_unlock (&fpad->lock);
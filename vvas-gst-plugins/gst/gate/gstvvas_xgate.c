@@ -0,0 +1,677 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * vvas_xgate runs a cheap detector ahead of the DPU and skips inference on
+ * the frames or objects where it finds nothing, e.g.
+ *
+ *   ... ! vvas_xgate detector=hough-lines min-votes=120 ! \
+ *         vvas_xskipframe name=skip ...
+ *   ... ! vvas_xgate detector=haar-cascade mode=roi \
+ *         cascade-location=plate.xml ! vvas_xinfer infer-config=level2.json ...
+ *
+ * The decision is the enabled flag of the inference meta data, which
+ * vvas_xinfer already honours: a disabled root prediction skips the frame, a
+ * disabled object skips the inference of its crop. In frame mode buffers
+ * without inference meta data get one when they fail the gate, and
+ * vvas_xskipframe pushes them to its skip pad keeping the inference of their
+ * source pending. Objects too small for the detector pass.
+ *
+ * The detectors are the CPU counterparts of hls::HoughLines2 and of the Haar
+ * cascade of hls_video_haar.h. The "stats" property reports the share of
+ * frames or objects passing and the DPU time saved, from the time per frame
+ * or object measured by the next vvas_xinfer downstream.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include <gst/vvas/gstinferencemeta.h>
+#include "gstvvas_xgate.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_vvas_xgate_debug_category);
+#define GST_CAT_DEFAULT gst_vvas_xgate_debug_category
+
+#define gst_vvas_xgate_parent_class parent_class
+
+static GstFlowReturn gst_vvas_xgate_transform_ip (GstBaseTransform * trans,
+    GstBuffer * buf);
+static gboolean gst_vvas_xgate_set_caps (GstBaseTransform * trans,
+    GstCaps * incaps, GstCaps * outcaps);
+static gboolean gst_vvas_xgate_start (GstBaseTransform * trans);
+static gboolean gst_vvas_xgate_stop (GstBaseTransform * trans);
+static void gst_vvas_xgate_finalize (GObject * gobject);
+
+enum
+{
+  PROP_0,
+  PROP_DETECTOR,
+  PROP_MODE,
+  PROP_EDGE_THRESHOLD,
+  PROP_MIN_VOTES,
+  PROP_CASCADE_LOCATION,
+  PROP_MIN_SIZE,
+  PROP_SCALE_FACTOR,
+  PROP_INFERENCE_TIME,
+  PROP_STATS
+};
+
+G_DEFINE_TYPE_WITH_CODE (GstVvas_XGate, gst_vvas_xgate,
+    GST_TYPE_BASE_TRANSFORM,
+    GST_DEBUG_CATEGORY_INIT (gst_vvas_xgate_debug_category, "vvas_xgate",
+        0, "debug category for VVAS inference gate element"));
+
+#define VVAS_XGATE_CAPS \
+    GST_VIDEO_CAPS_MAKE ("{ GRAY8, NV12, NV16, I420 }")
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VVAS_XGATE_CAPS));
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VVAS_XGATE_CAPS));
+
+#define GSTVVAS_XGATE_DEFAULT_DETECTOR GST_VVAS_XGATE_DETECTOR_HOUGH_LINES
+#define GSTVVAS_XGATE_DEFAULT_MODE GST_VVAS_XGATE_MODE_FRAME
+/* Step edges of contrast 50 */
+#define GSTVVAS_XGATE_DEFAULT_EDGE_THRESHOLD 200
+/* Largest |gx| + |gy| of the 3x3 Sobel */
+#define GSTVVAS_XGATE_MAX_EDGE_THRESHOLD 2040
+#define GSTVVAS_XGATE_DEFAULT_MIN_VOTES 100
+#define GSTVVAS_XGATE_DEFAULT_MIN_SIZE 0
+#define GSTVVAS_XGATE_DEFAULT_SCALE_FACTOR 1.25
+#define GSTVVAS_XGATE_DEFAULT_INFERENCE_TIME 0
+
+#define GST_TYPE_VVAS_XGATE_DETECTOR (gst_vvas_xgate_detector_get_type ())
+#define GST_TYPE_VVAS_XGATE_MODE (gst_vvas_xgate_mode_get_type ())
+
+/**
+ *  @fn static GType gst_vvas_xgate_detector_get_type (void)
+ *  @return GType of GstVvasXGateDetector enum
+ *  @brief  Registers the values of "detector" property
+ */
+static GType
+gst_vvas_xgate_detector_get_type (void)
+{
+  static const GEnumValue values[] = {
+    {GST_VVAS_XGATE_DETECTOR_HOUGH_LINES,
+        "Pass when a straight line gets min-votes Hough votes", "hough-lines"},
+    {GST_VVAS_XGATE_DETECTOR_HAAR_CASCADE,
+        "Pass when a window passes the Haar cascade", "haar-cascade"},
+    {0, NULL, NULL}
+  };
+  static GType id = 0;
+
+  if (g_once_init_enter ((gsize *) & id)) {
+    GType _id;
+
+    _id = g_enum_register_static ("GstVvasXGateDetector", values);
+
+    g_once_init_leave ((gsize *) & id, _id);
+  }
+
+  return id;
+}
+
+/**
+ *  @fn static GType gst_vvas_xgate_mode_get_type (void)
+ *  @return GType of GstVvasXGateMode enum
+ *  @brief  Registers the values of "mode" property
+ */
+static GType
+gst_vvas_xgate_mode_get_type (void)
+{
+  static const GEnumValue values[] = {
+    {GST_VVAS_XGATE_MODE_FRAME, "Gate the inference of whole frames",
+        "frame"},
+    {GST_VVAS_XGATE_MODE_ROI,
+        "Gate the inference of the objects of the meta data", "roi"},
+    {0, NULL, NULL}
+  };
+  static GType id = 0;
+
+  if (g_once_init_enter ((gsize *) & id)) {
+    GType _id;
+
+    _id = g_enum_register_static ("GstVvasXGateMode", values);
+
+    g_once_init_leave ((gsize *) & id, _id);
+  }
+
+  return id;
+}
+
+/**
+ *  @fn static guint64 vvas_xgate_query_inference_time (GstVvas_XGate * self)
+ *  @param [in] self - Element
+ *  @return DPU time of one frame or object in microseconds, 0 if unknown
+ *  @brief  Asks the next vvas_xinfer downstream for the DPU time it measured
+ */
+static guint64
+vvas_xgate_query_inference_time (GstVvas_XGate * self)
+{
+  GstQuery *query;
+  const GstStructure *s;
+  guint64 frame_time = 0;
+
+  query = gst_query_new_custom (GST_QUERY_CUSTOM,
+      gst_structure_new_empty ("vvas-inference-time"));
+
+  if (gst_pad_peer_query (GST_BASE_TRANSFORM_SRC_PAD (self), query)) {
+    s = gst_query_get_structure (query);
+    gst_structure_get_uint64 (s, "frame-time", &frame_time);
+  }
+  gst_query_unref (query);
+
+  return frame_time / GST_USECOND;
+}
+
+/**
+ *  @fn static GstStructure * vvas_xgate_stats_to_structure (GstVvas_XGate *
+ *                                                           self)
+ *  @param [in] self - Element
+ *  @return New "stats" structure
+ *  @brief  Snapshot of the gate counters
+ */
+static GstStructure *
+vvas_xgate_stats_to_structure (GstVvas_XGate * self)
+{
+  GstVvasXGateStats stats;
+  guint64 inference_time;
+  gboolean measured = FALSE;
+
+  GST_OBJECT_LOCK (self);
+  stats = self->stats;
+  inference_time = self->inference_time;
+  GST_OBJECT_UNLOCK (self);
+
+  /* Not overridden by the user, use the time inference actually took */
+  if (!inference_time) {
+    inference_time = vvas_xgate_query_inference_time (self);
+    measured = inference_time != 0;
+  }
+
+  return gst_structure_new ("gate-stats",
+      "evaluated", G_TYPE_UINT64, stats.evaluated,
+      "passed", G_TYPE_UINT64, stats.passed,
+      "skipped", G_TYPE_UINT64, stats.skipped,
+      "hit-rate", G_TYPE_DOUBLE, stats.evaluated ?
+      (gdouble) stats.passed / stats.evaluated : 0.0,
+      "gate-time-us", G_TYPE_UINT64, stats.gate_time,
+      "inference-time-us", G_TYPE_UINT64, inference_time,
+      "inference-time-measured", G_TYPE_BOOLEAN, measured,
+      "saved-dpu-time-us", G_TYPE_UINT64, stats.skipped * inference_time,
+      NULL);
+}
+
+static void
+gst_vvas_xgate_set_property (GObject * object,
+    guint prop_id, const GValue * value, GParamSpec * pspec)
+{
+  GstVvas_XGate *self = GST_VVAS_XGATE (object);
+
+  GST_OBJECT_LOCK (self);
+  switch (prop_id) {
+    case PROP_DETECTOR:
+      self->detector = g_value_get_enum (value);
+      break;
+    case PROP_MODE:
+      self->mode = g_value_get_enum (value);
+      break;
+    case PROP_EDGE_THRESHOLD:
+      self->edge_threshold = g_value_get_uint (value);
+      break;
+    case PROP_MIN_VOTES:
+      self->min_votes = g_value_get_uint (value);
+      break;
+    case PROP_CASCADE_LOCATION:
+      g_free (self->cascade_location);
+      self->cascade_location = g_value_dup_string (value);
+      break;
+    case PROP_MIN_SIZE:
+      self->min_size = g_value_get_uint (value);
+      break;
+    case PROP_SCALE_FACTOR:
+      self->scale_factor = g_value_get_double (value);
+      break;
+    case PROP_INFERENCE_TIME:
+      self->inference_time = g_value_get_uint (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gst_vvas_xgate_get_property (GObject * object,
+    guint prop_id, GValue * value, GParamSpec * pspec)
+{
+  GstVvas_XGate *self = GST_VVAS_XGATE (object);
+
+  if (prop_id == PROP_STATS) {
+    g_value_take_boxed (value, vvas_xgate_stats_to_structure (self));
+    return;
+  }
+
+  GST_OBJECT_LOCK (self);
+  switch (prop_id) {
+    case PROP_DETECTOR:
+      g_value_set_enum (value, self->detector);
+      break;
+    case PROP_MODE:
+      g_value_set_enum (value, self->mode);
+      break;
+    case PROP_EDGE_THRESHOLD:
+      g_value_set_uint (value, self->edge_threshold);
+      break;
+    case PROP_MIN_VOTES:
+      g_value_set_uint (value, self->min_votes);
+      break;
+    case PROP_CASCADE_LOCATION:
+      g_value_set_string (value, self->cascade_location);
+      break;
+    case PROP_MIN_SIZE:
+      g_value_set_uint (value, self->min_size);
+      break;
+    case PROP_SCALE_FACTOR:
+      g_value_set_double (value, self->scale_factor);
+      break;
+    case PROP_INFERENCE_TIME:
+      g_value_set_uint (value, self->inference_time);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gst_vvas_xgate_class_init (GstVvas_XGateClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstBaseTransformClass *transform_class = GST_BASE_TRANSFORM_CLASS (klass);
+
+  gobject_class->set_property = gst_vvas_xgate_set_property;
+  gobject_class->get_property = gst_vvas_xgate_get_property;
+  gobject_class->finalize = gst_vvas_xgate_finalize;
+
+  gst_element_class_add_pad_template (GST_ELEMENT_CLASS (klass),
+      gst_static_pad_template_get (&src_template));
+  gst_element_class_add_pad_template (GST_ELEMENT_CLASS (klass),
+      gst_static_pad_template_get (&sink_template));
+
+  g_object_class_install_property (gobject_class, PROP_DETECTOR,
+      g_param_spec_enum ("detector", "Detector",
+          "Cheap detector deciding whether inference runs",
+          GST_TYPE_VVAS_XGATE_DETECTOR, GSTVVAS_XGATE_DEFAULT_DETECTOR,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_MODE,
+      g_param_spec_enum ("mode", "Mode",
+          "Run the detector on whole frames or on the objects of the "
+          "inference meta data", GST_TYPE_VVAS_XGATE_MODE,
+          GSTVVAS_XGATE_DEFAULT_MODE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_EDGE_THRESHOLD,
+      g_param_spec_uint ("edge-threshold", "Edge threshold",
+          "Smallest |gx| + |gy| of a 3x3 Sobel for a Hough edge point, 4 "
+          "times the contrast of a step edge", 1,
+          GSTVVAS_XGATE_MAX_EDGE_THRESHOLD,
+          GSTVVAS_XGATE_DEFAULT_EDGE_THRESHOLD,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_MIN_VOTES,
+      g_param_spec_uint ("min-votes", "Minimum votes",
+          "Hough votes, about the length in pixels, of the line a frame or "
+          "object needs to pass", 1, G_MAXUINT16,
+          GSTVVAS_XGATE_DEFAULT_MIN_VOTES,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_CASCADE_LOCATION,
+      g_param_spec_string ("cascade-location", "Cascade location",
+          "Haar cascade saved by opencv_traincascade, stages of stumps over "
+          "upright features", NULL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_MIN_SIZE,
+      g_param_spec_uint ("min-size", "Minimum size",
+          "Width of the smallest Haar window, 0 for the cascade window",
+          0, G_MAXUINT16, GSTVVAS_XGATE_DEFAULT_MIN_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_SCALE_FACTOR,
+      g_param_spec_double ("scale-factor", "Scale factor",
+          "Ratio between consecutive Haar window sizes", 1.05, 4.0,
+          GSTVVAS_XGATE_DEFAULT_SCALE_FACTOR,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_INFERENCE_TIME,
+      g_param_spec_uint ("inference-time", "Inference time",
+          "DPU time of one inference of the gated model in microseconds, "
+          "only used to report the time saved, 0 to use the time measured "
+          "by the next vvas_xinfer downstream", 0, G_MAXUINT,
+          GSTVVAS_XGATE_DEFAULT_INFERENCE_TIME,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Gate statistics",
+          "Frames or objects evaluated, passed and skipped since start, "
+          "hit rate, time spent in the detector and DPU time saved",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  gst_element_class_set_static_metadata (GST_ELEMENT_CLASS (klass),
+      "VVAS inference gate",
+      "Filter/Analyzer/Video", "Skips inference on frames or objects where "
+      "a cheap Hough line or Haar cascade detector finds nothing",
+      "Xilinx Inc");
+
+  transform_class->set_caps = GST_DEBUG_FUNCPTR (gst_vvas_xgate_set_caps);
+  transform_class->start = GST_DEBUG_FUNCPTR (gst_vvas_xgate_start);
+  transform_class->stop = GST_DEBUG_FUNCPTR (gst_vvas_xgate_stop);
+  transform_class->transform_ip =
+      GST_DEBUG_FUNCPTR (gst_vvas_xgate_transform_ip);
+}
+
+static void
+gst_vvas_xgate_init (GstVvas_XGate * self)
+{
+  self->detector = GSTVVAS_XGATE_DEFAULT_DETECTOR;
+  self->mode = GSTVVAS_XGATE_DEFAULT_MODE;
+  self->edge_threshold = GSTVVAS_XGATE_DEFAULT_EDGE_THRESHOLD;
+  self->min_votes = GSTVVAS_XGATE_DEFAULT_MIN_VOTES;
+  self->cascade_location = NULL;
+  self->min_size = GSTVVAS_XGATE_DEFAULT_MIN_SIZE;
+  self->scale_factor = GSTVVAS_XGATE_DEFAULT_SCALE_FACTOR;
+  self->inference_time = GSTVVAS_XGATE_DEFAULT_INFERENCE_TIME;
+  gst_video_info_init (&self->vinfo);
+  vvas_xgate_hough_init (&self->hough);
+  vvas_xgate_haar_init (&self->haar);
+  memset (&self->cascade, 0, sizeof (self->cascade));
+  memset (&self->stats, 0, sizeof (self->stats));
+
+  gst_base_transform_set_in_place (GST_BASE_TRANSFORM (self), TRUE);
+}
+
+static void
+gst_vvas_xgate_finalize (GObject * gobject)
+{
+  GstVvas_XGate *self = GST_VVAS_XGATE (gobject);
+
+  vvas_xgate_hough_clear (&self->hough);
+  vvas_xgate_haar_clear (&self->haar);
+  vvas_xgate_haar_cascade_clear (&self->cascade);
+  g_free (self->cascade_location);
+
+  G_OBJECT_CLASS (parent_class)->finalize (gobject);
+}
+
+static gboolean
+gst_vvas_xgate_start (GstBaseTransform * trans)
+{
+  GstVvas_XGate *self = GST_VVAS_XGATE (trans);
+  GError *error = NULL;
+  gchar *location;
+  gchar *xml;
+  gsize length;
+  gboolean ret;
+
+  GST_OBJECT_LOCK (self);
+  memset (&self->stats, 0, sizeof (self->stats));
+  location = g_strdup (self->cascade_location);
+  ret = self->detector != GST_VVAS_XGATE_DETECTOR_HAAR_CASCADE;
+  GST_OBJECT_UNLOCK (self);
+
+  if (ret) {
+    g_free (location);
+    return TRUE;
+  }
+
+  if (!location) {
+    GST_ELEMENT_ERROR (self, RESOURCE, NOT_FOUND, (NULL),
+        ("cascade-location must be set for the haar-cascade detector"));
+    return FALSE;
+  }
+
+  if (!g_file_get_contents (location, &xml, &length, &error)) {
+    GST_ELEMENT_ERROR (self, RESOURCE, OPEN_READ, (NULL),
+        ("failed to read %s: %s", location, error->message));
+    g_error_free (error);
+    g_free (location);
+    return FALSE;
+  }
+
+  vvas_xgate_haar_cascade_clear (&self->cascade);
+  ret = vvas_xgate_haar_cascade_parse (&self->cascade, xml, length, &error);
+  g_free (xml);
+  if (!ret) {
+    GST_ELEMENT_ERROR (self, RESOURCE, READ, (NULL),
+        ("invalid cascade %s: %s", location, error->message));
+    g_error_free (error);
+    g_free (location);
+    return FALSE;
+  }
+
+  GST_DEBUG_OBJECT (self, "cascade %s: %ux%u window, %u stages, %u stumps",
+      location, self->cascade.width, self->cascade.height,
+      self->cascade.num_stages, self->cascade.num_stumps);
+  g_free (location);
+
+  return TRUE;
+}
+
+static gboolean
+gst_vvas_xgate_stop (GstBaseTransform * trans)
+{
+  GstVvas_XGate *self = GST_VVAS_XGATE (trans);
+  GstStructure *stats = vvas_xgate_stats_to_structure (self);
+
+  GST_INFO_OBJECT (self, "%" GST_PTR_FORMAT, stats);
+  gst_structure_free (stats);
+
+  vvas_xgate_hough_clear (&self->hough);
+  vvas_xgate_haar_clear (&self->haar);
+  vvas_xgate_haar_cascade_clear (&self->cascade);
+
+  return TRUE;
+}
+
+static gboolean
+gst_vvas_xgate_set_caps (GstBaseTransform * trans, GstCaps * incaps,
+    GstCaps * outcaps)
+{
+  GstVvas_XGate *self = GST_VVAS_XGATE (trans);
+
+  if (!gst_video_info_from_caps (&self->vinfo, incaps)) {
+    GST_ERROR_OBJECT (self, "Failed to parse input caps");
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ *  @fn static gboolean vvas_xgate_evaluate (GstVvas_XGate * self,
+ *                                           GstVideoFrame * frame,
+ *                                           gint x, gint y,
+ *                                           guint width, guint height)
+ *  @param [in] self - Element
+ *  @param [in] frame - Mapped frame
+ *  @param [in] x - Left of the region, clipped to the frame
+ *  @param [in] y - Top of the region
+ *  @param [in] width - Width of the region
+ *  @param [in] height - Height of the region
+ *  @return TRUE if the detector finds its pattern in the region or the
+ *          region is too small for it
+ *  @brief  Runs the detector on the luma of the region and counts the
+ *          decision
+ */
+static gboolean
+vvas_xgate_evaluate (GstVvas_XGate * self, GstVideoFrame * frame, gint x,
+    gint y, guint width, guint height)
+{
+  guint frame_width = GST_VIDEO_FRAME_WIDTH (frame);
+  guint frame_height = GST_VIDEO_FRAME_HEIGHT (frame);
+  guint stride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0);
+  const guint8 *luma;
+  guint edge_threshold, min_votes, min_size, left, top, right, bottom;
+  gdouble scale_factor;
+  gboolean pass;
+  gint64 start;
+
+  left = CLAMP (x, 0, (gint) frame_width);
+  top = CLAMP (y, 0, (gint) frame_height);
+  right = CLAMP ((gint64) x + width, left, frame_width);
+  bottom = CLAMP ((gint64) y + height, top, frame_height);
+  width = right - left;
+  height = bottom - top;
+  luma = (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA (frame, 0) +
+      (gsize) top * stride + left;
+
+  GST_OBJECT_LOCK (self);
+  edge_threshold = self->edge_threshold;
+  min_votes = self->min_votes;
+  min_size = self->min_size;
+  scale_factor = self->scale_factor;
+  GST_OBJECT_UNLOCK (self);
+
+  start = g_get_monotonic_time ();
+  if (self->detector == GST_VVAS_XGATE_DETECTOR_HAAR_CASCADE) {
+    if (width < self->cascade.width || height < self->cascade.height)
+      return TRUE;
+    pass = vvas_xgate_haar_detect (&self->haar, &self->cascade, luma, stride,
+        width, height, min_size, scale_factor, NULL);
+  } else {
+    if (width < 3 || height < 3)
+      return TRUE;
+    pass = vvas_xgate_hough_votes (&self->hough, luma, stride, width, height,
+        edge_threshold, min_votes, NULL) >= min_votes;
+  }
+
+  GST_OBJECT_LOCK (self);
+  self->stats.gate_time += g_get_monotonic_time () - start;
+  self->stats.evaluated++;
+  if (pass)
+    self->stats.passed++;
+  else
+    self->stats.skipped++;
+  GST_OBJECT_UNLOCK (self);
+
+  GST_LOG_OBJECT (self, "region %u,%u %ux%u %s", left, top, width, height,
+      pass ? "passed" : "skipped");
+
+  return pass;
+}
+
+static GstFlowReturn
+gst_vvas_xgate_transform_ip (GstBaseTransform * trans, GstBuffer * buf)
+{
+  GstVvas_XGate *self = GST_VVAS_XGATE (trans);
+  GstInferenceMeta *infer_meta;
+  GstVideoFrame frame;
+  GSList *preds = NULL, *iter;
+
+  infer_meta = (GstInferenceMeta *) gst_buffer_get_meta (buf,
+      gst_inference_meta_api_get_type ());
+
+  /* Frames skipped upstream are not evaluated again */
+  if (infer_meta && infer_meta->prediction &&
+      !infer_meta->prediction->prediction.enabled)
+    return GST_FLOW_OK;
+
+  if (self->mode == GST_VVAS_XGATE_MODE_ROI) {
+    if (infer_meta && infer_meta->prediction)
+      preds = gst_inference_prediction_get_boxes (infer_meta->prediction,
+          TRUE);
+    if (!preds)
+      return GST_FLOW_OK;
+  }
+
+  if (!gst_video_frame_map (&frame, &self->vinfo, buf, GST_MAP_READ)) {
+    g_slist_free (preds);
+    GST_ELEMENT_ERROR (self, RESOURCE, READ, (NULL),
+        ("failed to map frame"));
+    return GST_FLOW_ERROR;
+  }
+
+  if (self->mode == GST_VVAS_XGATE_MODE_ROI) {
+    for (iter = preds; iter; iter = g_slist_next (iter)) {
+      GstInferencePrediction *pred = (GstInferencePrediction *) iter->data;
+      VvasBoundingBox *bbox = &pred->prediction.bbox;
+
+      if (!vvas_xgate_evaluate (self, &frame, bbox->x, bbox->y, bbox->width,
+              bbox->height))
+        pred->prediction.enabled = FALSE;
+    }
+    g_slist_free (preds);
+  } else if (!vvas_xgate_evaluate (self, &frame, 0, 0,
+          GST_VIDEO_FRAME_WIDTH (&frame), GST_VIDEO_FRAME_HEIGHT (&frame))) {
+    if (!infer_meta)
+      infer_meta = (GstInferenceMeta *) gst_buffer_add_meta (buf,
+          gst_inference_meta_get_info (), NULL);
+    infer_meta->prediction->prediction.enabled = FALSE;
+  }
+
+  gst_video_frame_unmap (&frame);
+
+  return GST_FLOW_OK;
+}
+
+static gboolean
+vvas_xgate_init (GstPlugin * vvas_xgate)
+{
+  return gst_element_register (vvas_xgate, "vvas_xgate", GST_RANK_PRIMARY,
+      GST_TYPE_VVAS_XGATE);
+}
+
+/* PACKAGE: this is usually set by autotools depending on some _INIT macro
+ * in configure.ac and then written into and defined in config.h, but we can
+ * just set it ourselves here in case someone doesn't use autotools to
+ * compile this code. GST_PLUGIN_DEFINE needs PACKAGE to be defined.
+ */
+#ifndef PACKAGE
+#define PACKAGE "vvas_xgate"
+#endif
+
+GST_PLUGIN_DEFINE (GST_VERSION_MAJOR, GST_VERSION_MINOR, vvas_xgate,
+    "Xilinx VVAS SDK plugin to gate inference with a cheap detector",
+    vvas_xgate_init, VVAS_API_VERSION, "MIT/X11", "Xilinx VVAS SDK plugin",
+    "http://xilinx.com/")
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+#ifndef _GST_VVAS_XGATE_H_
+#define _GST_VVAS_XGATE_H_
+
+#include <gst/base/gstbasetransform.h>
+#include <gst/video/video.h>
+#include "vvas_xgate_detect.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_VVAS_XGATE   (gst_vvas_xgate_get_type())
+#define GST_VVAS_XGATE(obj)   (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_VVAS_XGATE,GstVvas_XGate))
+#define GST_VVAS_XGATE_CLASS(klass)   (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_VVAS_XGATE,GstVvas_XGateClass))
+#define GST_IS_VVAS_XGATE(obj)   (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_VVAS_XGATE))
+#define GST_IS_VVAS_XGATE_CLASS(obj)   (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_VVAS_XGATE))
+
+typedef struct _GstVvas_XGate GstVvas_XGate;
+typedef struct _GstVvas_XGateClass GstVvas_XGateClass;
+
+/**
+ *  @brief Cheap detector deciding whether inference runs
+ */
+typedef enum
+{
+  /** A straight line of min-votes pixels at least */
+  GST_VVAS_XGATE_DETECTOR_HOUGH_LINES,
+  /** A window passing the Haar cascade */
+  GST_VVAS_XGATE_DETECTOR_HAAR_CASCADE,
+} GstVvasXGateDetector;
+
+/**
+ *  @brief What the detector is run on
+ */
+typedef enum
+{
+  /** Whole frames, inference of the frames failing is skipped */
+  GST_VVAS_XGATE_MODE_FRAME,
+  /** Objects of the inference meta data, inference of the objects failing
+   *  is skipped */
+  GST_VVAS_XGATE_MODE_ROI,
+} GstVvasXGateMode;
+
+/**
+ *  @brief Gate counters, reported by the "stats" property
+ */
+typedef struct
+{
+  /** Frames or objects the detector ran on */
+  guint64 evaluated;
+  /** Evaluated frames or objects left to inference */
+  guint64 passed;
+  /** Evaluated frames or objects whose inference is skipped */
+  guint64 skipped;
+  /** Time spent in the detector in microseconds */
+  guint64 gate_time;
+} GstVvasXGateStats;
+
+struct _GstVvas_XGate
+{
+  GstBaseTransform parent;
+  /** Detector */
+  GstVvasXGateDetector detector;
+  /** Frames or objects */
+  GstVvasXGateMode mode;
+  /** Smallest |gx| + |gy| of a Hough edge point */
+  guint edge_threshold;
+  /** Votes of the line a frame or object needs to pass */
+  guint min_votes;
+  /** Haar cascade file */
+  gchar *cascade_location;
+  /** Width of the smallest Haar window, 0 for the cascade one */
+  guint min_size;
+  /** Ratio between consecutive Haar window sizes */
+  gdouble scale_factor;
+  /** Time of one inference in microseconds, to report the time saved, 0 to
+   *  query the one measured downstream */
+  guint inference_time;
+  /** Negotiated video info */
+  GstVideoInfo vinfo;
+  /** Hough work buffers */
+  VvasXGateHough hough;
+  /** Haar cascade loaded at start */
+  VvasXGateHaarCascade cascade;
+  /** Haar work buffers */
+  VvasXGateHaar haar;
+  /** Counters since start */
+  GstVvasXGateStats stats;
+};
+
+struct _GstVvas_XGateClass
+{
+  GstBaseTransformClass parentclass;
+};
+
+GType gst_vvas_xgate_get_type (void);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,862 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Cheap detectors deciding whether a frame or a region is worth an
+ * inference, the CPU counterparts of hls::HoughLines2 and of the Haar
+ * cascade of hls_video_haar.h.
+ *
+ * The Hough detector votes with the edge points of a 3x3 Sobel, thinned to
+ * the local maxima across the edge, for lines of 180 angles and 1 pixel
+ * distances. Angles are voted for one after the other so that the votes of an
+ * angle stay in cache, and voting stops as soon as a line reaches the votes
+ * asked for.
+ *
+ * The Haar detector runs an opencv_traincascade cascade of stumps on every
+ * window of a region, scaling the features rather than the image as the
+ * legacy OpenCV detector does, and stops at the first window passing all
+ * stages.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <math.h>
+#include <string.h>
+#include "vvas_xgate_detect.h"
+
+/** @def VVAS_XGATE_TRIG_SHIFT
+ *  @brief Fraction bits of the Hough cos and sin tables
+ */
+#define VVAS_XGATE_TRIG_SHIFT 12
+/** @def VVAS_XGATE_MIN_POINTS
+ *  @brief Edge points allocated at first
+ */
+#define VVAS_XGATE_MIN_POINTS 4096
+/** @def VVAS_XGATE_MAX_NUMBERS
+ *  @brief Numbers of a cascade element parsed at most
+ */
+#define VVAS_XGATE_MAX_NUMBERS 5
+
+/**
+ *  @fn void vvas_xgate_hough_init (VvasXGateHough * hough)
+ *  @param [out] hough - Detector
+ *  @return None
+ */
+void
+vvas_xgate_hough_init (VvasXGateHough * hough)
+{
+  guint t;
+
+  memset (hough, 0, sizeof (*hough));
+  for (t = 0; t < VVAS_XGATE_HOUGH_THETA_BINS; t++) {
+    gdouble theta = t * G_PI / VVAS_XGATE_HOUGH_THETA_BINS;
+
+    hough->cos_tab[t] = (gint32) lround (cos (theta) *
+        (1 << VVAS_XGATE_TRIG_SHIFT));
+    hough->sin_tab[t] = (gint32) lround (sin (theta) *
+        (1 << VVAS_XGATE_TRIG_SHIFT));
+  }
+}
+
+/**
+ *  @fn void vvas_xgate_hough_clear (VvasXGateHough * hough)
+ *  @param [in] hough - Detector
+ *  @return None
+ *  @brief  Frees the work buffers, the detector can be used again
+ */
+void
+vvas_xgate_hough_clear (VvasXGateHough * hough)
+{
+  g_free (hough->xs);
+  g_free (hough->ys);
+  g_free (hough->votes);
+  g_free (hough->mag);
+  g_free (hough->horiz);
+  hough->xs = hough->ys = NULL;
+  hough->votes = NULL;
+  hough->mag = NULL;
+  hough->horiz = NULL;
+  hough->max_points = hough->max_votes = hough->max_width = 0;
+}
+
+/**
+ *  @fn static void vvas_xgate_sobel_line (const guint8 * luma, guint stride,
+ *                                         guint width, guint height, guint y,
+ *                                         guint16 * mag, guint8 * horiz)
+ *  @param [in] luma - First pixel of the region
+ *  @param [in] stride - Bytes between lines
+ *  @param [in] width - Region width
+ *  @param [in] height - Region height
+ *  @param [in] y - Line
+ *  @param [out] mag - |gx| + |gy| of each pixel of the line, 0 on the border
+ *  @param [out] horiz - Whether the gradient of each pixel is mostly
+ *                       horizontal
+ *  @return None
+ */
+static void
+vvas_xgate_sobel_line (const guint8 * luma, guint stride, guint width,
+    guint height, guint y, guint16 * mag, guint8 * horiz)
+{
+  const guint8 *above, *line, *below;
+  guint x;
+
+  if (y == 0 || y + 1 >= height) {
+    memset (mag, 0, width * sizeof (*mag));
+    return;
+  }
+
+  above = luma + (gsize) (y - 1) * stride;
+  line = above + stride;
+  below = line + stride;
+  mag[0] = mag[width - 1] = 0;
+  for (x = 1; x + 1 < width; x++) {
+    gint gx = (above[x + 1] - above[x - 1]) + 2 * (line[x + 1] - line[x - 1])
+        + (below[x + 1] - below[x - 1]);
+    gint gy = (below[x - 1] + 2 * below[x] + below[x + 1]) -
+        (above[x - 1] + 2 * above[x] + above[x + 1]);
+
+    gx = ABS (gx);
+    gy = ABS (gy);
+    mag[x] = gx + gy;
+    horiz[x] = gx >= gy;
+  }
+}
+
+/**
+ *  @fn static void vvas_xgate_hough_add_point (VvasXGateHough * hough,
+ *                                              guint n, gint32 x, gint32 y)
+ *  @param [in] hough - Detector
+ *  @param [in] n - Points already found
+ *  @param [in] x - Column of the new point
+ *  @param [in] y - Line of the new point
+ *  @return None
+ */
+static void
+vvas_xgate_hough_add_point (VvasXGateHough * hough, guint n, gint32 x,
+    gint32 y)
+{
+  if (n == hough->max_points) {
+    hough->max_points = MAX (VVAS_XGATE_MIN_POINTS, 2 * hough->max_points);
+    hough->xs = g_renew (gint32, hough->xs, hough->max_points);
+    hough->ys = g_renew (gint32, hough->ys, hough->max_points);
+  }
+  hough->xs[n] = x;
+  hough->ys[n] = y;
+}
+
+/**
+ *  @fn guint vvas_xgate_hough_votes (VvasXGateHough * hough,
+ *                                    const guint8 * luma, guint stride,
+ *                                    guint width, guint height,
+ *                                    guint edge_threshold, guint stop_votes,
+ *                                    guint * num_points)
+ *  @param [in] hough - Detector
+ *  @param [in] luma - First pixel of the region
+ *  @param [in] stride - Bytes between lines
+ *  @param [in] width - Region width
+ *  @param [in] height - Region height
+ *  @param [in] edge_threshold - Smallest |gx| + |gy| of an edge point,
+ *                               4 times the contrast of a step edge
+ *  @param [in] stop_votes - Votes after which voting stops, 0 for none
+ *  @param [out] num_points - Edge points of the region, may be NULL
+ *  @return Votes of the strongest line, about its length in pixels, at
+ *          least \p stop_votes if voting stopped early
+ */
+guint
+vvas_xgate_hough_votes (VvasXGateHough * hough, const guint8 * luma,
+    guint stride, guint width, guint height, guint edge_threshold,
+    guint stop_votes, guint * num_points)
+{
+  guint num_rho = 2 * (width + height) + 1;
+  gint32 bias = ((gint32) (width + height) << VVAS_XGATE_TRIG_SHIFT) +
+      (1 << (VVAS_XGATE_TRIG_SHIFT - 1));
+  guint n = 0, max = 0, x, y, t, i;
+
+  if (num_points)
+    *num_points = 0;
+  if (width < 3 || height < 3)
+    return 0;
+
+  if (width > hough->max_width) {
+    hough->max_width = width;
+    hough->mag = g_renew (guint16, hough->mag, 3 * width);
+    hough->horiz = g_renew (guint8, hough->horiz, 3 * width);
+  }
+  if (num_rho > hough->max_votes) {
+    hough->max_votes = num_rho;
+    hough->votes = g_renew (guint32, hough->votes, num_rho);
+  }
+
+  /* Line y of the gradients is in slot y % 3 */
+  vvas_xgate_sobel_line (luma, stride, width, height, 0, hough->mag,
+      hough->horiz);
+  vvas_xgate_sobel_line (luma, stride, width, height, 1, hough->mag + width,
+      hough->horiz + width);
+  for (y = 1; y + 1 < height; y++) {
+    guint slot = (y + 1) % 3;
+    const guint16 *above, *line, *below;
+    const guint8 *horiz;
+
+    vvas_xgate_sobel_line (luma, stride, width, height, y + 1,
+        hough->mag + slot * width, hough->horiz + slot * width);
+    above = hough->mag + ((y - 1) % 3) * width;
+    line = hough->mag + (y % 3) * width;
+    below = hough->mag + slot * width;
+    horiz = hough->horiz + (y % 3) * width;
+
+    /* Edges are thinned to the maxima across them, plateaus keep their
+     * last point */
+    for (x = 1; x + 1 < width; x++) {
+      guint m = line[x];
+
+      if (m < edge_threshold)
+        continue;
+      if (horiz[x] ? (m < line[x - 1] || m <= line[x + 1]) :
+          (m < above[x] || m <= below[x]))
+        continue;
+      vvas_xgate_hough_add_point (hough, n++, x, y);
+    }
+  }
+
+  if (num_points)
+    *num_points = n;
+
+  for (t = 0; t < VVAS_XGATE_HOUGH_THETA_BINS; t++) {
+    gint32 c = hough->cos_tab[t];
+    gint32 s = hough->sin_tab[t];
+    guint32 *votes = hough->votes;
+
+    memset (votes, 0, num_rho * sizeof (*votes));
+    for (i = 0; i < n; i++) {
+      guint v = ++votes[(hough->xs[i] * c + hough->ys[i] * s + bias) >>
+          VVAS_XGATE_TRIG_SHIFT];
+
+      if (v > max) {
+        max = v;
+        if (stop_votes && max >= stop_votes)
+          return max;
+      }
+    }
+  }
+
+  return max;
+}
+
+/**
+ *  @brief State of the cascade parser
+ */
+typedef struct
+{
+  /** Cascade element was found */
+  gboolean found;
+  guint width;
+  guint height;
+  GArray *stages;
+  GArray *stumps;
+  GArray *features;
+  /** Text of the current element */
+  GString *text;
+} VvasXGateHaarParser;
+
+/**
+ *  @fn static const gchar * vvas_xgate_element (GMarkupParseContext * context,
+ *                                               guint level)
+ *  @param [in] context - Parser
+ *  @param [in] level - 0 for the current element, 1 for its parent...
+ *  @return Name of the element, NULL above the root
+ */
+static const gchar *
+vvas_xgate_element (GMarkupParseContext * context, guint level)
+{
+  return g_slist_nth_data ((GSList *)
+      g_markup_parse_context_get_element_stack (context), level);
+}
+
+/**
+ *  @fn static guint vvas_xgate_parse_numbers (const gchar * text,
+ *                                             gdouble * values)
+ *  @param [in] text - Numbers separated by spaces
+ *  @param [out] values - First VVAS_XGATE_MAX_NUMBERS numbers
+ *  @return Count of numbers in \p text, G_MAXUINT if it is not only numbers
+ */
+static guint
+vvas_xgate_parse_numbers (const gchar * text, gdouble * values)
+{
+  guint n = 0;
+
+  while (TRUE) {
+    gchar *end;
+    gdouble v;
+
+    while (g_ascii_isspace (*text))
+      text++;
+    if (!*text)
+      return n;
+    v = g_ascii_strtod (text, &end);
+    if (end == text)
+      return G_MAXUINT;
+    if (n < VVAS_XGATE_MAX_NUMBERS)
+      values[n] = v;
+    n++;
+    text = end;
+  }
+}
+
+static void
+vvas_xgate_haar_start_element (GMarkupParseContext * context,
+    const gchar * element_name, const gchar ** attribute_names,
+    const gchar ** attribute_values, gpointer user_data, GError ** error)
+{
+  VvasXGateHaarParser *p = (VvasXGateHaarParser *) user_data;
+  const gchar *parent = vvas_xgate_element (context, 1);
+
+  g_string_truncate (p->text, 0);
+
+  if (!strcmp (element_name, "cascade")) {
+    p->found = TRUE;
+  } else if (!strcmp (element_name, "_") && !g_strcmp0 (parent, "stages")) {
+    VvasXGateHaarStage stage = { p->stumps->len, 0, 0 };
+
+    g_array_append_val (p->stages, stage);
+  } else if (!strcmp (element_name, "_") &&
+      !g_strcmp0 (parent, "weakClassifiers")) {
+    VvasXGateHaarStump stump = { G_MAXUINT, 0, 0, 0 };
+
+    if (!p->stages->len) {
+      g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+          "weak classifier outside of a stage");
+      return;
+    }
+    g_array_append_val (p->stumps, stump);
+    g_array_index (p->stages, VvasXGateHaarStage, p->stages->len - 1).count++;
+  } else if (!strcmp (element_name, "_") && !g_strcmp0 (parent, "features")) {
+    VvasXGateHaarFeature feature;
+
+    memset (&feature, 0, sizeof (feature));
+    g_array_append_val (p->features, feature);
+  }
+}
+
+static void
+vvas_xgate_haar_end_element (GMarkupParseContext * context,
+    const gchar * element_name, gpointer user_data, GError ** error)
+{
+  VvasXGateHaarParser *p = (VvasXGateHaarParser *) user_data;
+  const gchar *parent = vvas_xgate_element (context, 1);
+  gchar *text = g_strstrip (p->text->str);
+  gdouble v[VVAS_XGATE_MAX_NUMBERS];
+  guint n;
+
+  if (!g_strcmp0 (parent, "cascade")) {
+    if (!strcmp (element_name, "stageType") && strcmp (text, "BOOST"))
+      g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+          "stage type %s not supported", text);
+    else if (!strcmp (element_name, "featureType") && strcmp (text, "HAAR"))
+      g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+          "feature type %s not supported", text);
+    else if (!strcmp (element_name, "width"))
+      p->width = g_ascii_strtoull (text, NULL, 10);
+    else if (!strcmp (element_name, "height"))
+      p->height = g_ascii_strtoull (text, NULL, 10);
+  } else if (!strcmp (element_name, "stageThreshold") && p->stages->len) {
+    g_array_index (p->stages, VvasXGateHaarStage,
+        p->stages->len - 1).threshold = g_ascii_strtod (text, NULL);
+  } else if (!strcmp (element_name, "internalNodes") && p->stumps->len) {
+    VvasXGateHaarStump *stump = &g_array_index (p->stumps,
+        VvasXGateHaarStump, p->stumps->len - 1);
+
+    /* Stumps are "0 -1 feature threshold" */
+    n = vvas_xgate_parse_numbers (text, v);
+    if (n != 4 || v[0] != 0 || v[1] != -1 || v[2] < 0) {
+      g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+          "only weak classifiers of depth 1 are supported");
+      return;
+    }
+    stump->feature = v[2];
+    stump->threshold = v[3];
+  } else if (!strcmp (element_name, "leafValues") && p->stumps->len) {
+    VvasXGateHaarStump *stump = &g_array_index (p->stumps,
+        VvasXGateHaarStump, p->stumps->len - 1);
+
+    n = vvas_xgate_parse_numbers (text, v);
+    if (n != 2) {
+      g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+          "weak classifier needs 2 leaf values");
+      return;
+    }
+    stump->left = v[0];
+    stump->right = v[1];
+  } else if (!strcmp (element_name, "_") && !g_strcmp0 (parent, "rects") &&
+      p->features->len) {
+    VvasXGateHaarFeature *feature = &g_array_index (p->features,
+        VvasXGateHaarFeature, p->features->len - 1);
+    VvasXGateHaarRect *rect;
+
+    n = vvas_xgate_parse_numbers (text, v);
+    if (n != 5 || v[0] < 0 || v[1] < 0 || v[2] <= 0 || v[3] <= 0) {
+      g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+          "invalid rectangle '%s'", text);
+      return;
+    }
+    if (feature->num_rects == VVAS_XGATE_HAAR_MAX_RECTS) {
+      g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+          "feature %u has more than %u rectangles", p->features->len - 1,
+          VVAS_XGATE_HAAR_MAX_RECTS);
+      return;
+    }
+    rect = &feature->rects[feature->num_rects++];
+    rect->x = v[0];
+    rect->y = v[1];
+    rect->w = v[2];
+    rect->h = v[3];
+    rect->weight = v[4];
+  } else if (!strcmp (element_name, "tilted") && strcmp (text, "0")) {
+    g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+        "tilted features are not supported");
+  }
+}
+
+static void
+vvas_xgate_haar_text (GMarkupParseContext * context, const gchar * text,
+    gsize text_len, gpointer user_data, GError ** error)
+{
+  VvasXGateHaarParser *p = (VvasXGateHaarParser *) user_data;
+
+  g_string_append_len (p->text, text, text_len);
+}
+
+/**
+ *  @fn static gboolean vvas_xgate_haar_validate (VvasXGateHaarParser * p,
+ *                                                GError ** error)
+ *  @param [in] p - Parsed cascade
+ *  @param [out] error - Set when the cascade cannot be run
+ *  @return TRUE if every stump has a feature inside the window
+ */
+static gboolean
+vvas_xgate_haar_validate (VvasXGateHaarParser * p, GError ** error)
+{
+  guint i, k;
+
+  if (!p->found || !p->width || !p->height || !p->stages->len) {
+    g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+        "no Haar cascade of opencv_traincascade");
+    return FALSE;
+  }
+  /* Variance is computed without the border pixels of the window */
+  if (p->width < 3 || p->height < 3) {
+    g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+        "window %ux%u too small", p->width, p->height);
+    return FALSE;
+  }
+
+  for (i = 0; i < p->stages->len; i++) {
+    if (!g_array_index (p->stages, VvasXGateHaarStage, i).count) {
+      g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+          "stage %u has no weak classifier", i);
+      return FALSE;
+    }
+  }
+
+  for (i = 0; i < p->stumps->len; i++) {
+    if (g_array_index (p->stumps, VvasXGateHaarStump, i).feature >=
+        p->features->len) {
+      g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+          "weak classifier %u has no feature", i);
+      return FALSE;
+    }
+  }
+
+  for (i = 0; i < p->features->len; i++) {
+    VvasXGateHaarFeature *feature = &g_array_index (p->features,
+        VvasXGateHaarFeature, i);
+
+    if (!feature->num_rects) {
+      g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+          "feature %u has no rectangle", i);
+      return FALSE;
+    }
+    for (k = 0; k < feature->num_rects; k++) {
+      VvasXGateHaarRect *rect = &feature->rects[k];
+
+      if (rect->x + rect->w > p->width || rect->y + rect->h > p->height) {
+        g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
+            "feature %u is outside of the %ux%u window", i, p->width,
+            p->height);
+        return FALSE;
+      }
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ *  @fn gboolean vvas_xgate_haar_cascade_parse (VvasXGateHaarCascade * cascade,
+ *                                              const gchar * xml,
+ *                                              gssize length,
+ *                                              GError ** error)
+ *  @param [out] cascade - Cascade, to be freed with
+ *                         vvas_xgate_haar_cascade_clear() on success
+ *  @param [in] xml - Cascade as saved by opencv_traincascade
+ *  @param [in] length - Length of \p xml, -1 if nul-terminated
+ *  @param [out] error - Set on failure
+ *  @return TRUE on success
+ *  @brief  Reads a cascade of BOOST stages of stumps over upright HAAR
+ *          features, the only kind hls_video_haar.h runs
+ */
+gboolean
+vvas_xgate_haar_cascade_parse (VvasXGateHaarCascade * cascade,
+    const gchar * xml, gssize length, GError ** error)
+{
+  static const GMarkupParser parser = {
+    vvas_xgate_haar_start_element,
+    vvas_xgate_haar_end_element,
+    vvas_xgate_haar_text,
+    NULL,
+    NULL
+  };
+  VvasXGateHaarParser p;
+  GMarkupParseContext *context;
+  gboolean ret;
+
+  memset (cascade, 0, sizeof (*cascade));
+  memset (&p, 0, sizeof (p));
+  p.stages = g_array_new (FALSE, FALSE, sizeof (VvasXGateHaarStage));
+  p.stumps = g_array_new (FALSE, FALSE, sizeof (VvasXGateHaarStump));
+  p.features = g_array_new (FALSE, FALSE, sizeof (VvasXGateHaarFeature));
+  p.text = g_string_new (NULL);
+
+  context = g_markup_parse_context_new (&parser, 0, &p, NULL);
+  ret = g_markup_parse_context_parse (context, xml, length, error) &&
+      g_markup_parse_context_end_parse (context, error) &&
+      vvas_xgate_haar_validate (&p, error);
+  g_markup_parse_context_free (context);
+  g_string_free (p.text, TRUE);
+
+  if (!ret) {
+    g_array_free (p.stages, TRUE);
+    g_array_free (p.stumps, TRUE);
+    g_array_free (p.features, TRUE);
+    return FALSE;
+  }
+
+  cascade->width = p.width;
+  cascade->height = p.height;
+  cascade->num_stages = p.stages->len;
+  cascade->num_stumps = p.stumps->len;
+  cascade->num_features = p.features->len;
+  cascade->stages = (VvasXGateHaarStage *) g_array_free (p.stages, FALSE);
+  cascade->stumps = (VvasXGateHaarStump *) g_array_free (p.stumps, FALSE);
+  cascade->features =
+      (VvasXGateHaarFeature *) g_array_free (p.features, FALSE);
+
+  return TRUE;
+}
+
+/**
+ *  @fn void vvas_xgate_haar_cascade_clear (VvasXGateHaarCascade * cascade)
+ *  @param [in] cascade - Cascade
+ *  @return None
+ */
+void
+vvas_xgate_haar_cascade_clear (VvasXGateHaarCascade * cascade)
+{
+  g_free (cascade->stages);
+  g_free (cascade->stumps);
+  g_free (cascade->features);
+  memset (cascade, 0, sizeof (*cascade));
+}
+
+/**
+ *  @fn void vvas_xgate_haar_init (VvasXGateHaar * haar)
+ *  @param [out] haar - Detector
+ *  @return None
+ */
+void
+vvas_xgate_haar_init (VvasXGateHaar * haar)
+{
+  memset (haar, 0, sizeof (*haar));
+}
+
+/**
+ *  @fn void vvas_xgate_haar_clear (VvasXGateHaar * haar)
+ *  @param [in] haar - Detector
+ *  @return None
+ *  @brief  Frees the work buffers, the detector can be used again
+ */
+void
+vvas_xgate_haar_clear (VvasXGateHaar * haar)
+{
+  g_free (haar->sum);
+  g_free (haar->sqsum);
+  g_free (haar->offsets);
+  g_free (haar->weights);
+  memset (haar, 0, sizeof (*haar));
+}
+
+/** @def VVAS_XGATE_RECT_SUM
+ *  @brief Sum of a rectangle from the integral at its 4 corner offsets,
+ *         wrapping unsigned arithmetic gives the exact sum
+ */
+#define VVAS_XGATE_RECT_SUM(type, s, o) \
+  ((type) ((s)[(o)[3]] - (s)[(o)[1]] - (s)[(o)[2]] + (s)[(o)[0]]))
+
+/**
+ *  @fn static void vvas_xgate_rect_offsets (gint x, gint y, gint w, gint h,
+ *                                           guint stride, gint * offsets)
+ *  @param [in] x - Left of the rectangle in the window
+ *  @param [in] y - Top of the rectangle in the window
+ *  @param [in] w - Width
+ *  @param [in] h - Height
+ *  @param [in] stride - Points between lines of the integral
+ *  @param [out] offsets - Top left, top right, bottom left and bottom right
+ *  @return None
+ */
+static void
+vvas_xgate_rect_offsets (gint x, gint y, gint w, gint h, guint stride,
+    gint * offsets)
+{
+  offsets[0] = y * stride + x;
+  offsets[1] = y * stride + x + w;
+  offsets[2] = (y + h) * stride + x;
+  offsets[3] = (y + h) * stride + x + w;
+}
+
+/**
+ *  @fn static gdouble vvas_xgate_haar_scale (VvasXGateHaar * haar,
+ *                                            const VvasXGateHaarCascade *
+ *                                            cascade, gdouble scale,
+ *                                            guint stride, gint * var_offsets)
+ *  @param [in] haar - Detector
+ *  @param [in] cascade - Cascade
+ *  @param [in] scale - Window size over the cascade window size
+ *  @param [in] stride - Points between lines of the integral
+ *  @param [out] var_offsets - Corners of the rectangle the variance of a
+ *                             window is computed on
+ *  @return Inverse of the area of that rectangle
+ *  @brief  Scales the features as cvSetImagesForHaarClassifierCascade did:
+ *          weights are divided by the area so that feature values are means,
+ *          the first one is corrected so that rounding keeps the feature
+ *          balanced
+ */
+static gdouble
+vvas_xgate_haar_scale (VvasXGateHaar * haar,
+    const VvasXGateHaarCascade * cascade, gdouble scale, guint stride,
+    gint * var_offsets)
+{
+  gint win_w = (gint) (cascade->width * scale + 0.5);
+  gint win_h = (gint) (cascade->height * scale + 0.5);
+  gint edge = (gint) (scale + 0.5);
+  gint equ_w = (gint) ((cascade->width - 2) * scale + 0.5);
+  gint equ_h = (gint) ((cascade->height - 2) * scale + 0.5);
+  gdouble inv_area = 1.0 / (equ_w * equ_h);
+  guint f, k;
+
+  vvas_xgate_rect_offsets (edge, edge, equ_w, equ_h, stride, var_offsets);
+
+  for (f = 0; f < cascade->num_features; f++) {
+    const VvasXGateHaarFeature *feature = &cascade->features[f];
+    gint *offsets = haar->offsets + f * VVAS_XGATE_HAAR_MAX_RECTS * 4;
+    gfloat *weights = haar->weights + f * VVAS_XGATE_HAAR_MAX_RECTS;
+    gdouble area0 = 0, sum0 = 0;
+
+    memset (offsets, 0, VVAS_XGATE_HAAR_MAX_RECTS * 4 * sizeof (*offsets));
+    memset (weights, 0, VVAS_XGATE_HAAR_MAX_RECTS * sizeof (*weights));
+    for (k = 0; k < feature->num_rects; k++) {
+      const VvasXGateHaarRect *rect = &feature->rects[k];
+      gint x = (gint) (rect->x * scale + 0.5);
+      gint y = (gint) (rect->y * scale + 0.5);
+      gint w = MIN ((gint) (rect->w * scale + 0.5), win_w - x);
+      gint h = MIN ((gint) (rect->h * scale + 0.5), win_h - y);
+
+      vvas_xgate_rect_offsets (x, y, w, h, stride, offsets + k * 4);
+      weights[k] = rect->weight * inv_area;
+      if (!k)
+        area0 = w * h;
+      else
+        sum0 += weights[k] * w * h;
+    }
+    if (feature->num_rects > 1 && area0 > 0)
+      weights[0] = -sum0 / area0;
+  }
+
+  return inv_area;
+}
+
+/**
+ *  @fn static gboolean vvas_xgate_haar_window (const VvasXGateHaar * haar,
+ *                                              const VvasXGateHaarCascade *
+ *                                              cascade,
+ *                                              const gint * var_offsets,
+ *                                              gdouble inv_area, gsize base)
+ *  @param [in] haar - Detector with the features scaled to the window size
+ *  @param [in] cascade - Cascade
+ *  @param [in] var_offsets - Corners of the variance rectangle
+ *  @param [in] inv_area - Inverse of the area of the variance rectangle
+ *  @param [in] base - Offset of the top left of the window in the integral
+ *  @return TRUE if the window passes every stage
+ */
+static gboolean
+vvas_xgate_haar_window (const VvasXGateHaar * haar,
+    const VvasXGateHaarCascade * cascade, const gint * var_offsets,
+    gdouble inv_area, gsize base)
+{
+  const guint32 *sum = haar->sum + base;
+  const guint64 *sqsum = haar->sqsum + base;
+  gint64 area = (gint64) (1.0 / inv_area + 0.5);
+  gint64 rect_sum = VVAS_XGATE_RECT_SUM (guint32, sum, var_offsets);
+  /* Area squared times the variance, exact so that flat windows are */
+  gint64 var = area * (gint64) VVAS_XGATE_RECT_SUM (guint64, sqsum,
+      var_offsets) - rect_sum * rect_sum;
+  gdouble norm = var > 0 ? sqrt ((gdouble) var) * inv_area : 1.0;
+  guint s, i;
+
+  for (s = 0; s < cascade->num_stages; s++) {
+    const VvasXGateHaarStage *stage = &cascade->stages[s];
+    gdouble stage_sum = 0;
+
+    for (i = stage->first; i < stage->first + stage->count; i++) {
+      const VvasXGateHaarStump *stump = &cascade->stumps[i];
+      const gint *offsets = haar->offsets +
+          stump->feature * VVAS_XGATE_HAAR_MAX_RECTS * 4;
+      const gfloat *weights = haar->weights +
+          stump->feature * VVAS_XGATE_HAAR_MAX_RECTS;
+      gdouble value =
+          weights[0] * VVAS_XGATE_RECT_SUM (guint32, sum, offsets) +
+          weights[1] * VVAS_XGATE_RECT_SUM (guint32, sum, offsets + 4) +
+          weights[2] * VVAS_XGATE_RECT_SUM (guint32, sum, offsets + 8);
+
+      stage_sum += value < stump->threshold * norm ? stump->left :
+          stump->right;
+    }
+
+    if (stage_sum < stage->threshold - 0.0001)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ *  @fn gboolean vvas_xgate_haar_detect (VvasXGateHaar * haar,
+ *                                       const VvasXGateHaarCascade * cascade,
+ *                                       const guint8 * luma, guint stride,
+ *                                       guint width, guint height,
+ *                                       guint min_size,
+ *                                       gdouble scale_factor,
+ *                                       guint * num_windows)
+ *  @param [in] haar - Detector
+ *  @param [in] cascade - Cascade
+ *  @param [in] luma - First pixel of the region
+ *  @param [in] stride - Bytes between lines
+ *  @param [in] width - Region width
+ *  @param [in] height - Region height
+ *  @param [in] min_size - Width of the smallest window, the cascade width
+ *                         when smaller
+ *  @param [in] scale_factor - Ratio between consecutive window sizes, more
+ *                             than 1
+ *  @param [out] num_windows - Windows evaluated, may be NULL
+ *  @return TRUE as soon as a window passes the cascade
+ *  @brief  Windows are moved by 2 pixels of the cascade window
+ */
+gboolean
+vvas_xgate_haar_detect (VvasXGateHaar * haar,
+    const VvasXGateHaarCascade * cascade, const guint8 * luma, guint stride,
+    guint width, guint height, guint min_size, gdouble scale_factor,
+    guint * num_windows)
+{
+  guint int_stride = width + 1;
+  gsize num_points = (gsize) int_stride * (height + 1);
+  gint var_offsets[4];
+  gboolean found = FALSE;
+  guint windows = 0;
+  gdouble scale;
+  guint x, y;
+
+  g_return_val_if_fail (scale_factor > 1.0, FALSE);
+
+  if (num_windows)
+    *num_windows = 0;
+  if (width < cascade->width || height < cascade->height)
+    return FALSE;
+
+  if (num_points > haar->max_points) {
+    haar->max_points = num_points;
+    haar->sum = g_renew (guint32, haar->sum, num_points);
+    haar->sqsum = g_renew (guint64, haar->sqsum, num_points);
+  }
+  if (cascade->num_features > haar->max_features) {
+    haar->max_features = cascade->num_features;
+    haar->offsets = g_renew (gint, haar->offsets,
+        cascade->num_features * VVAS_XGATE_HAAR_MAX_RECTS * 4);
+    haar->weights = g_renew (gfloat, haar->weights,
+        cascade->num_features * VVAS_XGATE_HAAR_MAX_RECTS);
+  }
+
+  memset (haar->sum, 0, int_stride * sizeof (*haar->sum));
+  memset (haar->sqsum, 0, int_stride * sizeof (*haar->sqsum));
+  for (y = 0; y < height; y++) {
+    const guint8 *line = luma + (gsize) y * stride;
+    const guint32 *sum_above = haar->sum + (gsize) y * int_stride;
+    const guint64 *sqsum_above = haar->sqsum + (gsize) y * int_stride;
+    guint32 *sum = haar->sum + (gsize) (y + 1) * int_stride;
+    guint64 *sqsum = haar->sqsum + (gsize) (y + 1) * int_stride;
+    guint32 line_sum = 0;
+    guint64 line_sqsum = 0;
+
+    sum[0] = 0;
+    sqsum[0] = 0;
+    for (x = 0; x < width; x++) {
+      line_sum += line[x];
+      line_sqsum += line[x] * line[x];
+      sum[x + 1] = sum_above[x + 1] + line_sum;
+      sqsum[x + 1] = sqsum_above[x + 1] + line_sqsum;
+    }
+  }
+
+  for (scale = MAX (min_size, cascade->width) / (gdouble) cascade->width;;
+      scale *= scale_factor) {
+    guint win_w = (guint) (cascade->width * scale + 0.5);
+    guint win_h = (guint) (cascade->height * scale + 0.5);
+    guint step = MAX (2, (guint) (2 * scale + 0.5));
+    gdouble inv_area;
+
+    if (win_w > width || win_h > height)
+      break;
+
+    inv_area = vvas_xgate_haar_scale (haar, cascade, scale, int_stride,
+        var_offsets);
+    for (y = 0; y + win_h <= height && !found; y += step) {
+      for (x = 0; x + win_w <= width; x += step) {
+        windows++;
+        if (vvas_xgate_haar_window (haar, cascade, var_offsets, inv_area,
+                (gsize) y * int_stride + x)) {
+          found = TRUE;
+          break;
+        }
+      }
+    }
+    if (found)
+      break;
+  }
+
+  if (num_windows)
+    *num_windows = windows;
+
+  return found;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __VVAS_XGATE_DETECT_H__
+#define __VVAS_XGATE_DETECT_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/** @def VVAS_XGATE_HOUGH_THETA_BINS
+ *  @brief Line angles voted for, one per degree
+ */
+#define VVAS_XGATE_HOUGH_THETA_BINS 180
+/** @def VVAS_XGATE_HAAR_MAX_RECTS
+ *  @brief Rectangles of a Haar feature, HLS_HAAR_FEATURE_MAX
+ */
+#define VVAS_XGATE_HAAR_MAX_RECTS 3
+
+/**
+ *  @brief Hough line detector, the work buffers are kept across calls
+ */
+typedef struct
+{
+  /** cos and sin of each angle, Q12 */
+  gint32 cos_tab[VVAS_XGATE_HOUGH_THETA_BINS];
+  gint32 sin_tab[VVAS_XGATE_HOUGH_THETA_BINS];
+  /** Edge points of the region */
+  gint32 *xs;
+  gint32 *ys;
+  /** Capacity of xs and ys */
+  gsize max_points;
+  /** Votes of one angle for every distance */
+  guint32 *votes;
+  /** Capacity of votes */
+  gsize max_votes;
+  /** Three lines of gradient magnitudes and directions */
+  guint16 *mag;
+  guint8 *horiz;
+  /** Capacity of a line of mag and horiz */
+  gsize max_width;
+} VvasXGateHough;
+
+void vvas_xgate_hough_init (VvasXGateHough * hough);
+void vvas_xgate_hough_clear (VvasXGateHough * hough);
+guint vvas_xgate_hough_votes (VvasXGateHough * hough, const guint8 * luma,
+    guint stride, guint width, guint height, guint edge_threshold,
+    guint stop_votes, guint * num_points);
+
+/**
+ *  @brief Rectangle of a Haar feature, in pixels of the cascade window
+ */
+typedef struct
+{
+  guint x;
+  guint y;
+  guint w;
+  guint h;
+  /** Weight of the pixel sum */
+  gfloat weight;
+} VvasXGateHaarRect;
+
+/**
+ *  @brief Weighted sum of up to VVAS_XGATE_HAAR_MAX_RECTS rectangles
+ */
+typedef struct
+{
+  VvasXGateHaarRect rects[VVAS_XGATE_HAAR_MAX_RECTS];
+  /** Rectangles used */
+  guint num_rects;
+} VvasXGateHaarFeature;
+
+/**
+ *  @brief Weak classifier of depth one
+ */
+typedef struct
+{
+  /** Index of the feature */
+  guint feature;
+  /** Normalized feature values lower than this give left */
+  gfloat threshold;
+  /** Values added to the stage sum */
+  gfloat left;
+  gfloat right;
+} VvasXGateHaarStump;
+
+/**
+ *  @brief Boosted stage, a window passes it when the sum of its stumps
+ *         reaches threshold
+ */
+typedef struct
+{
+  /** Index of the first stump */
+  guint first;
+  /** Number of stumps */
+  guint count;
+  gfloat threshold;
+} VvasXGateHaarStage;
+
+/**
+ *  @brief Haar cascade of opencv_traincascade
+ */
+typedef struct
+{
+  /** Window the cascade was trained on */
+  guint width;
+  guint height;
+  VvasXGateHaarStage *stages;
+  guint num_stages;
+  VvasXGateHaarStump *stumps;
+  guint num_stumps;
+  VvasXGateHaarFeature *features;
+  guint num_features;
+} VvasXGateHaarCascade;
+
+/**
+ *  @brief Integral images of a region and the cascade scaled to a window
+ *         size, kept across calls
+ */
+typedef struct
+{
+  /** Sums and sums of squares of the pixels above and left of each point */
+  guint32 *sum;
+  guint64 *sqsum;
+  /** Capacity of sum and sqsum */
+  gsize max_points;
+  /** Corner offsets and weights of the features at the current scale */
+  gint *offsets;
+  gfloat *weights;
+  /** Capacity of offsets and weights in features */
+  guint max_features;
+} VvasXGateHaar;
+
+gboolean vvas_xgate_haar_cascade_parse (VvasXGateHaarCascade * cascade,
+    const gchar * xml, gssize length, GError ** error);
+void vvas_xgate_haar_cascade_clear (VvasXGateHaarCascade * cascade);
+
+void vvas_xgate_haar_init (VvasXGateHaar * haar);
+void vvas_xgate_haar_clear (VvasXGateHaar * haar);
+gboolean vvas_xgate_haar_detect (VvasXGateHaar * haar,
+    const VvasXGateHaarCascade * cascade, const guint8 * luma, guint stride,
+    guint width, guint height, guint min_size, gdouble scale_factor,
+    guint * num_windows);
+
+G_END_DECLS
+
+#endif /* __VVAS_XGATE_DETECT_H__ */
@@ -57,6 +57,17 @@ GST_DEBUG_CATEGORY_STATIC (gst_vvas_xmetaaffixer_debug);
  */
 #define ENABLE_TEST_CODE 0
 
+/**
+ *  @brief Default number of master buffers whose meta data is kept
+ */
+#define DEFAULT_HISTORY_SIZE 8
+
+/** @def HISTORY_ENTRY
+ *  @brief Macro to get entry at index \p idx of history, 0 being the oldest
+ */
+#define HISTORY_ENTRY(self, idx) \
+  (&(self)->history[((self)->history_start + (idx)) % (self)->history_size])
+
 GQuark _scale_quark;
 
 enum
@@ -70,8 +81,48 @@ enum
    * to arrive on all the input pads. If data does not arrive witin timeout duration, then it is
    * assumed that there is some issue in the dataflow and correstive action is triggered */
   PROP_TIMEOUT,
+  /** Property to select interpolation of meta data attached to slave buffers
+   * lying between two master buffers */
+  PROP_INTERPOLATE,
+  /** Property corresponding to the number of master buffers whose meta data
+   * is kept to be attached to late slave buffers */
+  PROP_HISTORY_SIZE,
+  /** Read only property reporting how meta data was attached to slave
+   * buffers */
+  PROP_ATTACH_STATS,
 };
 
+#define GST_TYPE_VVAS_XMETAAFFIXER_INTERPOLATE \
+  (gst_vvas_xmetaaffixer_interpolate_get_type ())
+
+/**
+ *  @fn static GType gst_vvas_xmetaaffixer_interpolate_get_type (void)
+ *  @return GType of VVAS_XMETAAFFIXER_INTERPOLATE enum
+ *  @brief  Registers the values of "interpolate" property
+ */
+static GType
+gst_vvas_xmetaaffixer_interpolate_get_type (void)
+{
+  static const GEnumValue values[] = {
+    {VVAS_XMETAAFFIXER_INTERPOLATE_NONE,
+        "Attach meta data of the matching master buffer", "none"},
+    {VVAS_XMETAAFFIXER_INTERPOLATE_LINEAR,
+        "Linearly interpolate bounding boxes between master buffers", "linear"},
+    {0, NULL, NULL}
+  };
+  static GType id = 0;
+
+  if (g_once_init_enter ((gsize *) & id)) {
+    GType _id;
+
+    _id = g_enum_register_static ("GstVvasXMetaAffixerInterpolate", values);
+
+    g_once_init_leave ((gsize *) & id, _id);
+  }
+
+  return id;
+}
+
 /**
  *  @brief Defines master sink pad template
  */
@@ -139,6 +190,9 @@ gst_vvas_xmetaaffixer_change_state (GstElement * element,
     GstStateChange transition);
 
 static void gst_vvas_xmetaaffixer_finalize (GObject * obj);
+static void vvas_xmetaaffixer_history_clear (GstVvas_XMetaAffixer * self);
+static GstStructure
+    * vvas_xmetaaffixer_attach_stats_to_structure (GstVvas_XMetaAffixer * self);
 static GstFlowReturn
 gst_vvas_xmetaaffixer_collected (GstCollectPads * pads, gpointer user_data);
 GstFlowReturn vvas_xmetaaffixer_combined_return (GstVvas_XMetaAffixer * self);
@@ -245,6 +299,29 @@ gst_vvas_xmetaaffixer_class_init (GstVvas_XMetaAffixerClass * klass)
           (-1) Disable timeout \
           Increase the timeout if debug logs are enabled", -1, G_MAXINT64, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GST_PARAM_MUTABLE_READY));
 
+  g_object_class_install_property (gobject_class, PROP_INTERPOLATE,
+      g_param_spec_enum ("interpolate", "Interpolate",
+          "Interpolation of meta data attached to slave buffers in sync mode. "
+          "With linear, slave buffers are held until the following master "
+          "buffer arrives, hence slave pads need one master frame duration of "
+          "queueing upstream", GST_TYPE_VVAS_XMETAAFFIXER_INTERPOLATE,
+          VVAS_XMETAAFFIXER_INTERPOLATE_NONE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_HISTORY_SIZE,
+      g_param_spec_uint ("history-size", "History size",
+          "Number of previous master buffers whose meta data is kept for "
+          "slave buffers in sync mode", 1, 256, DEFAULT_HISTORY_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_ATTACH_STATS,
+      g_param_spec_boxed ("attach-stats", "Meta data attachment statistics",
+          "Slave buffers meta data was attached to, in place, by sharing "
+          "their memory or by copying them",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   _scale_quark = gst_video_meta_transform_scale_get_quark ();
 }
 
@@ -270,7 +347,11 @@ gst_vvas_xmetaaffixer_init (GstVvas_XMetaAffixer * self)
   self->sync = TRUE;
   self->flowcombiner = gst_flow_combiner_new ();
   self->prev_m_end_ts = GST_CLOCK_TIME_NONE;
-  self->prev_meta_buf = NULL;
+  self->history = NULL;
+  self->history_size = DEFAULT_HISTORY_SIZE;
+  self->history_start = 0;
+  self->history_len = 0;
+  self->interpolate = VVAS_XMETAAFFIXER_INTERPOLATE_NONE;
   self->timeout_thread = NULL;
   self->retry_timeout = 2000;
   self->timeout_issued = FALSE;
@@ -320,6 +401,12 @@ gst_vvas_xmetaaffixer_set_property (GObject * object,
       /* Set timeout value */
       self->retry_timeout = g_value_get_int64 (value);
       break;
+    case PROP_INTERPOLATE:
+      self->interpolate = g_value_get_enum (value);
+      break;
+    case PROP_HISTORY_SIZE:
+      self->history_size = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -354,6 +441,16 @@ gst_vvas_xmetaaffixer_get_property (GObject * object,
     case PROP_TIMEOUT:
       g_value_set_int64 (value, self->retry_timeout);
       break;
+    case PROP_INTERPOLATE:
+      g_value_set_enum (value, self->interpolate);
+      break;
+    case PROP_HISTORY_SIZE:
+      g_value_set_uint (value, self->history_size);
+      break;
+    case PROP_ATTACH_STATS:
+      g_value_take_boxed (value, vvas_xmetaaffixer_attach_stats_to_structure
+          (self));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -491,9 +588,11 @@ gst_vvas_xmetaaffixer_finalize (GObject * obj)
   g_mutex_clear (&self->timeout_lock);
   g_mutex_clear (&self->collected_lock);
   gst_flow_combiner_free (self->flowcombiner);
-  /* If meta data of previous buffer is stored, free it */
-  if (self->prev_meta_buf)
-    gst_buffer_unref (self->prev_meta_buf);
+  /* If meta data of previous buffers is stored, free it */
+  if (self->history) {
+    vvas_xmetaaffixer_history_clear (self);
+    g_free (self->history);
+  }
   gst_object_unref (self->collect);
 }
 
@@ -825,6 +924,347 @@ vvas_xmetaaffixer_combined_return (GstVvas_XMetaAffixer * self)
   return fret;
 }
 
+/**
+ *  @fn static GstStructure * vvas_xmetaaffixer_attach_stats_to_structure (GstVvas_XMetaAffixer * self)
+ *  @param [in] self - pointer to GstVvas_XMetaAffixer object
+ *  @return New "attach-stats" structure
+ *  @brief  Snapshot of meta data attachment counters
+ */
+static GstStructure *
+vvas_xmetaaffixer_attach_stats_to_structure (GstVvas_XMetaAffixer * self)
+{
+  GstVvas_XMetaAffixerAttachStats stats;
+
+  GST_OBJECT_LOCK (self);
+  stats = self->attach_stats;
+  GST_OBJECT_UNLOCK (self);
+
+  return gst_structure_new ("attach-stats",
+      "attached", G_TYPE_UINT64, stats.attached,
+      "in-place", G_TYPE_UINT64, stats.in_place,
+      "shared", G_TYPE_UINT64, stats.shared,
+      "copied", G_TYPE_UINT64, stats.copied, NULL);
+}
+
+/**
+ *  @fn static GstBuffer * vvas_xmetaaffixer_make_meta_writable (GstVvas_XMetaAffixer * self,
+ *                                                               GstBuffer * sbuffer)
+ *  @param [in] self    - pointer to GstVvas_XMetaAffixer object
+ *  @param [in] sbuffer - slave buffer, ownership is transferred
+ *  @return Buffer with the contents of \p sbuffer whose meta data can be
+ *          changed
+ *  @brief  Only meta data is added to slave buffers. When \p sbuffer is still
+ *          referenced elsewhere (tee, queues, ...), a new buffer referencing
+ *          the same GstMemory blocks is returned instead of the deep copy
+ *          gst_buffer_make_writable () does. Memory flagged
+ *          GST_MEMORY_FLAG_NO_SHARE, or whose allocator can not share it, is
+ *          never shared, such buffers are copied by gst_buffer_make_writable ().
+ */
+static GstBuffer *
+vvas_xmetaaffixer_make_meta_writable (GstVvas_XMetaAffixer * self,
+    GstBuffer * sbuffer)
+{
+  GstBuffer *outbuf;
+  guint idx, n_mem;
+
+  if (gst_buffer_is_writable (sbuffer)) {
+    GST_OBJECT_LOCK (self);
+    self->attach_stats.attached++;
+    self->attach_stats.in_place++;
+    GST_OBJECT_UNLOCK (self);
+    return sbuffer;
+  }
+
+  n_mem = gst_buffer_n_memory (sbuffer);
+  for (idx = 0; idx < n_mem; idx++) {
+    GstMemory *mem = gst_buffer_peek_memory (sbuffer, idx);
+
+    if (GST_MEMORY_IS_NO_SHARE (mem) || !mem->allocator
+        || !mem->allocator->mem_share) {
+      GST_LOG_OBJECT (self, "buffer %p is not writable and memory %u can not "
+          "be shared, copying it", sbuffer, idx);
+      GST_OBJECT_LOCK (self);
+      self->attach_stats.attached++;
+      self->attach_stats.copied++;
+      GST_OBJECT_UNLOCK (self);
+      return gst_buffer_make_writable (sbuffer);
+    }
+  }
+
+  outbuf = gst_buffer_new ();
+  gst_buffer_copy_into (outbuf, sbuffer, GST_BUFFER_COPY_FLAGS |
+      GST_BUFFER_COPY_TIMESTAMPS | GST_BUFFER_COPY_META |
+      GST_BUFFER_COPY_MEMORY, 0, -1);
+
+  GST_LOG_OBJECT (self, "buffer %p is not writable, shared its %u memories "
+      "with %p", sbuffer, n_mem, outbuf);
+
+  GST_OBJECT_LOCK (self);
+  self->attach_stats.attached++;
+  self->attach_stats.shared++;
+  GST_OBJECT_UNLOCK (self);
+
+  gst_buffer_unref (sbuffer);
+
+  return outbuf;
+}
+
+/**
+ *  @fn static void vvas_xmetaaffixer_history_clear (GstVvas_XMetaAffixer * self)
+ *  @param [in] self - pointer to GstVvas_XMetaAffixer object
+ *  @return None
+ *  @brief  Drops meta data of all previous master buffers
+ */
+static void
+vvas_xmetaaffixer_history_clear (GstVvas_XMetaAffixer * self)
+{
+  guint idx;
+
+  for (idx = 0; idx < self->history_len; idx++) {
+    GstVvas_XMetaAffixerHistoryEntry *entry = HISTORY_ENTRY (self, idx);
+
+    gst_buffer_unref (entry->meta_buf);
+    entry->meta_buf = NULL;
+  }
+
+  self->history_start = 0;
+  self->history_len = 0;
+}
+
+/**
+ *  @fn static void vvas_xmetaaffixer_history_push (GstVvas_XMetaAffixer * self,
+ *                                                  GstBuffer * mbuffer)
+ *  @param [in] self    - pointer to GstVvas_XMetaAffixer object
+ *  @param [in] mbuffer - buffer being pushed on master src pad
+ *  @return None
+ *  @brief  Stores meta data of \p mbuffer as newest entry of history, dropping
+ *          the oldest entry when history is full.
+ */
+static void
+vvas_xmetaaffixer_history_push (GstVvas_XMetaAffixer * self,
+    GstBuffer * mbuffer)
+{
+  GstVvas_XMetaAffixerHistoryEntry *entry;
+  GstClockTime pts = GST_BUFFER_PTS (mbuffer);
+
+  /* History is searched by PTS, start over if master timestamps go back */
+  if (self->history_len
+      && pts <= HISTORY_ENTRY (self, self->history_len - 1)->pts) {
+    GST_DEBUG_OBJECT (self, "master pts %" GST_TIME_FORMAT " went back, "
+        "clearing meta data history", GST_TIME_ARGS (pts));
+    vvas_xmetaaffixer_history_clear (self);
+  }
+
+  if (self->history_len == self->history_size) {
+    entry = HISTORY_ENTRY (self, 0);
+    gst_buffer_unref (entry->meta_buf);
+    entry->meta_buf = NULL;
+    self->history_start = (self->history_start + 1) % self->history_size;
+    self->history_len--;
+  }
+
+  entry = HISTORY_ENTRY (self, self->history_len);
+  entry->pts = pts;
+  entry->meta_buf = gst_buffer_new ();
+  gst_buffer_copy_into (entry->meta_buf, mbuffer, GST_BUFFER_COPY_META, 0, -1);
+  self->history_len++;
+}
+
+/**
+ *  @fn static gint vvas_xmetaaffixer_history_find (GstVvas_XMetaAffixer * self,
+ *                                                  GstClockTime ts)
+ *  @param [in] self - pointer to GstVvas_XMetaAffixer object
+ *  @param [in] ts   - timestamp to search
+ *  @return Index of the newest entry with PTS not after \p ts, -1 if all
+ *          entries are after \p ts
+ *  @brief  Binary search of history
+ */
+static gint
+vvas_xmetaaffixer_history_find (GstVvas_XMetaAffixer * self, GstClockTime ts)
+{
+  gint low = 0;
+  gint high = (gint) self->history_len - 1;
+  gint found = -1;
+
+  while (low <= high) {
+    gint mid = low + (high - low) / 2;
+
+    if (HISTORY_ENTRY (self, mid)->pts <= ts) {
+      found = mid;
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+
+  return found;
+}
+
+/**
+ *  @fn static gint vvas_xmetaaffixer_lerp (gint from, gint to, gdouble alpha)
+ *  @param [in] from  - value at alpha 0
+ *  @param [in] to    - value at alpha 1
+ *  @param [in] alpha - position between \p from and \p to
+ *  @return Rounded linear interpolation of \p from and \p to
+ */
+static gint
+vvas_xmetaaffixer_lerp (gint from, gint to, gdouble alpha)
+{
+  gdouble val = from + (to - from) * alpha;
+
+  return (gint) (val < 0 ? val - 0.5 : val + 0.5);
+}
+
+/**
+ *  @fn static void vvas_xmetaaffixer_lerp_predictions (GstInferencePrediction * pred,
+ *                                                      GstInferencePrediction * to,
+ *                                                      gdouble alpha)
+ *  @param [in] pred  - prediction whose children are interpolated in place
+ *  @param [in] to    - root prediction of the following master buffer
+ *  @param [in] alpha - position of the slave buffer between both master buffers
+ *  @return None
+ *  @brief  Moves bounding boxes of all children of \p pred found in \p to by
+ *          their prediction_id towards the box in \p to. Predictions not
+ *          present in \p to are left as they are.
+ */
+static void
+vvas_xmetaaffixer_lerp_predictions (GstInferencePrediction * pred,
+    GstInferencePrediction * to, gdouble alpha)
+{
+  GSList *children = gst_inference_prediction_get_children (pred);
+  GSList *iter;
+
+  for (iter = children; iter; iter = g_slist_next (iter)) {
+    GstInferencePrediction *child = (GstInferencePrediction *) iter->data;
+    VvasBoundingBox *bbox = &child->prediction.bbox;
+    GstInferencePrediction *match;
+
+    match = gst_inference_prediction_find (to, child->prediction.prediction_id);
+    if (match) {
+      VvasBoundingBox *to_bbox = &match->prediction.bbox;
+
+      bbox->x = vvas_xmetaaffixer_lerp (bbox->x, to_bbox->x, alpha);
+      bbox->y = vvas_xmetaaffixer_lerp (bbox->y, to_bbox->y, alpha);
+      bbox->width = vvas_xmetaaffixer_lerp (bbox->width, to_bbox->width,
+          alpha);
+      bbox->height = vvas_xmetaaffixer_lerp (bbox->height, to_bbox->height,
+          alpha);
+      gst_inference_prediction_unref (match);
+    }
+
+    vvas_xmetaaffixer_lerp_predictions (child, to, alpha);
+  }
+
+  g_slist_free (children);
+}
+
+/**
+ *  @fn static GstBuffer * vvas_xmetaaffixer_interpolate (GstVvas_XMetaAffixer * self,
+ *                                                        GstBuffer * from,
+ *                                                        GstClockTime from_ts,
+ *                                                        GstBuffer * to,
+ *                                                        GstClockTime to_ts,
+ *                                                        GstClockTime ts)
+ *  @param [in] self    - pointer to GstVvas_XMetaAffixer object
+ *  @param [in] from    - master buffer before \p ts
+ *  @param [in] from_ts - PTS of \p from
+ *  @param [in] to      - master buffer after \p ts
+ *  @param [in] to_ts   - PTS of \p to
+ *  @param [in] ts      - timestamp of the slave buffer
+ *  @return Buffer holding interpolated meta data only, NULL if either master
+ *          buffer has no inference meta data
+ *  @brief  Interpolates meta data of two master buffers at \p ts
+ */
+static GstBuffer *
+vvas_xmetaaffixer_interpolate (GstVvas_XMetaAffixer * self, GstBuffer * from,
+    GstClockTime from_ts, GstBuffer * to, GstClockTime to_ts, GstClockTime ts)
+{
+  GstInferenceMeta *to_meta, *out_meta;
+  GstBuffer *out;
+  gdouble alpha;
+
+  to_meta = (GstInferenceMeta *) gst_buffer_get_meta (to,
+      gst_inference_meta_api_get_type ());
+  if (!to_meta || !to_meta->prediction || to_ts <= from_ts)
+    return NULL;
+
+  /* Deep copy of the meta data of the previous master buffer */
+  out = gst_buffer_new ();
+  gst_buffer_copy_into (out, from, GST_BUFFER_COPY_META, 0, -1);
+  out_meta = (GstInferenceMeta *) gst_buffer_get_meta (out,
+      gst_inference_meta_api_get_type ());
+  if (!out_meta || !out_meta->prediction) {
+    gst_buffer_unref (out);
+    return NULL;
+  }
+
+  alpha = (gdouble) (ts - from_ts) / (to_ts - from_ts);
+  alpha = CLAMP (alpha, 0.0, 1.0);
+
+  GST_LOG_OBJECT (self, "interpolating meta data at %" GST_TIME_FORMAT
+      " between %" GST_TIME_FORMAT " and %" GST_TIME_FORMAT ", alpha %f",
+      GST_TIME_ARGS (ts), GST_TIME_ARGS (from_ts), GST_TIME_ARGS (to_ts),
+      alpha);
+
+  vvas_xmetaaffixer_lerp_predictions (out_meta->prediction,
+      to_meta->prediction, alpha);
+
+  return out;
+}
+
+/**
+ *  @fn static GstBuffer * vvas_xmetaaffixer_history_lookup (GstVvas_XMetaAffixer * self,
+ *                                                           GstBuffer * mbuffer,
+ *                                                           GstClockTime ts)
+ *  @param [in] self    - pointer to GstVvas_XMetaAffixer object
+ *  @param [in] mbuffer - buffer queued on master sink pad, may be NULL
+ *  @param [in] ts      - middle of the slave buffer
+ *  @return Buffer holding the meta data to attach, NULL if history is empty.
+ *          Unref after use.
+ *  @brief  Finds meta data of the master buffer \p ts falls in. With linear
+ *          interpolation, meta data is interpolated with the following master
+ *          buffer, which is either in history or queued on master sink pad.
+ */
+static GstBuffer *
+vvas_xmetaaffixer_history_lookup (GstVvas_XMetaAffixer * self,
+    GstBuffer * mbuffer, GstClockTime ts)
+{
+  GstVvas_XMetaAffixerHistoryEntry *entry;
+  GstBuffer *next_buf = NULL;
+  GstClockTime next_pts = GST_CLOCK_TIME_NONE;
+  gint idx;
+
+  if (!self->history_len)
+    return NULL;
+
+  idx = vvas_xmetaaffixer_history_find (self, ts);
+  if (idx < 0) {
+    /* Older than all master buffers kept, best possible is the oldest one */
+    return gst_buffer_ref (HISTORY_ENTRY (self, 0)->meta_buf);
+  }
+  entry = HISTORY_ENTRY (self, idx);
+
+  if (self->interpolate == VVAS_XMETAAFFIXER_INTERPOLATE_LINEAR) {
+    if ((guint) idx + 1 < self->history_len) {
+      next_buf = HISTORY_ENTRY (self, idx + 1)->meta_buf;
+      next_pts = HISTORY_ENTRY (self, idx + 1)->pts;
+    } else if (mbuffer && GST_BUFFER_PTS_IS_VALID (mbuffer)) {
+      next_buf = mbuffer;
+      next_pts = GST_BUFFER_PTS (mbuffer);
+    }
+
+    if (next_buf) {
+      GstBuffer *interpolated = vvas_xmetaaffixer_interpolate (self,
+          entry->meta_buf, entry->pts, next_buf, next_pts, ts);
+
+      if (interpolated)
+        return interpolated;
+    }
+  }
+
+  return gst_buffer_ref (entry->meta_buf);
+}
+
 /**
  *  @fn static GstFlowReturn vvas_xmetaaffixer_get_min_end_ts (GstVvas_XMetaAffixer * self,
  *                                                             GstCollectPads * pads,
@@ -983,6 +1423,12 @@ vvas_xmetaaffixer_get_min_end_ts (GstVvas_XMetaAffixer * self,
     /* have valid start_ts and duration */
     cur_end_ts = cur_start_ts + cur_dur;
 
+    /* Interpolation needs the master buffer following a slave buffer, so
+     * release master buffers at their start and hold slave buffers until
+     * then */
+    if (self->interpolate == VVAS_XMETAAFFIXER_INTERPOLATE_LINEAR)
+      cur_end_ts = cur_start_ts;
+
     if (cur_end_ts < *min_end_ts) {
       /* update min end ts */
       *min_end_ts = cur_end_ts;
@@ -1013,9 +1459,9 @@ vvas_xmetaaffixer_process (GstVvas_XMetaAffixer * self, GstCollectPads * pads,
   GstBuffer *mbuffer = NULL;
   guint slave_idx;
   GstMeta *infer_meta = NULL;
-  gboolean pick_prev_meta = FALSE;
   GstClockTime m_cur_start_ts = GST_CLOCK_TIME_NONE;
   GstClockTime m_cur_end_ts = GST_CLOCK_TIME_NONE;
+  GstClockTime m_sync_ts = GST_CLOCK_TIME_NONE;
   GstClockTime m_cur_dur = GST_CLOCK_TIME_NONE;
 #if ENABLE_TEST_CODE
   GstBuffer *tmp_buffer = NULL;
@@ -1087,6 +1533,8 @@ slave:
     GstVvas_XMetaAffixerPad *sink_slave = self->sink_slave[slave_idx];
     GstBuffer *writable_buffer = NULL;
     GstBuffer *sbuffer = NULL;
+    GstBuffer *meta_buf = NULL;
+    GstMeta *slave_meta = infer_meta;
     GstClockTime s_cur_start_ts = GST_CLOCK_TIME_NONE;
     GstClockTime s_cur_end_ts = GST_CLOCK_TIME_NONE;
     GstClockTime s_cur_dur = GST_CLOCK_TIME_NONE;
@@ -1187,15 +1635,16 @@ slave:
 
       if ((s_cur_start_ts + (s_cur_dur >> 1)) <= self->prev_m_end_ts) {
         /* more than 50% of the current frame falls in
-         * previous master buffer duration. Hence attach the meta data
-         * from the previous buffer on the master sink pad*/
-        if (self->prev_meta_buf) {
-          infer_meta =
-              gst_buffer_get_meta (self->prev_meta_buf,
+         * previous master buffers duration. Hence attach the meta data
+         * from the previous buffer on the master sink pad it falls in */
+        meta_buf = vvas_xmetaaffixer_history_lookup (self, mbuffer,
+            s_cur_start_ts + (s_cur_dur >> 1));
+        if (meta_buf) {
+          slave_meta =
+              gst_buffer_get_meta (meta_buf,
               gst_inference_meta_api_get_type ());
-          pick_prev_meta = TRUE;
           GST_DEBUG_OBJECT (sink_slave,
-              "picking previous master buffer metadata %p", infer_meta);
+              "picking previous master buffer metadata %p", slave_meta);
         }
       } else if (self->sink_master->sent_eos
           && s_cur_start_ts < self->prev_m_end_ts) {
@@ -1204,14 +1653,15 @@ slave:
             " < prev master end ts %" GST_TIME_FORMAT,
             GST_TIME_ARGS (s_cur_start_ts),
             GST_TIME_ARGS (self->prev_m_end_ts));
-        if (self->prev_meta_buf) {
-          infer_meta =
-              gst_buffer_get_meta (self->prev_meta_buf,
+        meta_buf = vvas_xmetaaffixer_history_lookup (self, mbuffer,
+            s_cur_start_ts + (s_cur_dur >> 1));
+        if (meta_buf) {
+          slave_meta =
+              gst_buffer_get_meta (meta_buf,
               gst_inference_meta_api_get_type ());
-          pick_prev_meta = TRUE;
           GST_DEBUG_OBJECT (sink_slave,
               "attaching best possible metadata %p as master on EOS",
-              infer_meta);
+              slave_meta);
         }
       }
     } else {
@@ -1230,7 +1680,7 @@ slave:
     g_mutex_unlock (&self->timeout_lock);
 
     /* Check if infer meta data to be attached is available */
-    if (infer_meta) {
+    if (slave_meta) {
       const GstMetaInfo *info;
 
       GstVideoMetaTransform trans = { &self->sink_master->vinfo,
@@ -1238,25 +1688,24 @@ slave:
       };
 
       /* To attach a new meta data, Buffer must be writable */
-      writable_buffer = gst_buffer_make_writable (sbuffer);
+      writable_buffer = vvas_xmetaaffixer_make_meta_writable (self, sbuffer);
 
-      info = infer_meta->info;
+      info = slave_meta->info;
 
       GST_LOG_OBJECT (sink_slave, "attaching infer metadata %p to buffer %p",
-          infer_meta, writable_buffer);
+          slave_meta, writable_buffer);
 
       /* Transform the infer meta data as per the slave sink pad
        * properties */
-      if (!pick_prev_meta)
-        info->transform_func (writable_buffer, infer_meta, mbuffer,
-            _scale_quark, &trans);
-      else
-        info->transform_func (writable_buffer, infer_meta, self->prev_meta_buf,
-            _scale_quark, &trans);
+      info->transform_func (writable_buffer, slave_meta,
+          meta_buf ? meta_buf : mbuffer, _scale_quark, &trans);
     } else {
       writable_buffer = sbuffer;
     }
 
+    if (meta_buf)
+      gst_buffer_unref (meta_buf);
+
     GST_LOG_OBJECT (self, "pushing buffer %p on pad %s with pts %"
         GST_TIME_FORMAT " duration %" GST_TIME_FORMAT " and end ts %"
         GST_TIME_FORMAT, writable_buffer, GST_PAD_NAME (sink_slave->srcpad),
@@ -1281,9 +1730,12 @@ slave:
     m_cur_start_ts = GST_BUFFER_PTS (mbuffer);
     m_cur_dur = GST_BUFFER_DURATION (mbuffer);
     m_cur_end_ts = m_cur_start_ts + m_cur_dur;
+    /* Same time get_min_end_ts () used for master buffer */
+    m_sync_ts = (self->interpolate == VVAS_XMETAAFFIXER_INTERPOLATE_LINEAR) ?
+        m_cur_start_ts : m_cur_end_ts;
 
     if (self->sync && self->num_slaves) {
-      if (m_cur_end_ts != min_end_ts) {
+      if (m_sync_ts != min_end_ts) {
         if (self->sink_master->stream_state ==
             VVAS_XMETAAFFIXER_STATE_PROCESS_BUFFER
             || self->sink_master->stream_state ==
@@ -1348,21 +1800,15 @@ slave:
     g_cond_signal (&self->timeout_cond);
     g_mutex_unlock (&self->timeout_lock);
     if (self->sync && self->num_slaves) {
-      /* If previous buffer meta data is preserved, unref the assiciated
-       * buffer with it */
-      if (self->prev_meta_buf)
-        gst_buffer_unref (self->prev_meta_buf);
-
       /* Store the meta data associated with this buffer in case needed */
-      self->prev_meta_buf = gst_buffer_new ();
-      gst_buffer_copy_into (self->prev_meta_buf, mbuffer,
-          GST_BUFFER_COPY_META, 0, -1);
+      vvas_xmetaaffixer_history_push (self, mbuffer);
 
 #if ENABLE_TEST_CODE
       /* Enable this code if your master buffer does not have meta data and
        * you want to test the plugin. */
       infer_meta =
-          gst_buffer_get_meta (self->prev_meta_buf,
+          gst_buffer_get_meta (HISTORY_ENTRY (self,
+              self->history_len - 1)->meta_buf,
           gst_inference_meta_api_get_type ());
 
       if (infer_meta == NULL) {
@@ -1374,7 +1820,8 @@ slave:
 
         infer_meta =
             create_dummy_infermeta (tmp_buffer, &self->sink_master->vinfo);
-        gst_buffer_copy_into (self->prev_meta_buf, tmp_buffer,
+        gst_buffer_copy_into (HISTORY_ENTRY (self,
+                self->history_len - 1)->meta_buf, tmp_buffer,
             GST_BUFFER_COPY_META, 0, -1);
         gst_buffer_unref (tmp_buffer);
       }
@@ -1527,11 +1974,16 @@ gst_vvas_xmetaaffixer_change_state (GstElement * element,
 {
   GstStateChangeReturn ret;
   GstVvas_XMetaAffixer *self = GST_VVAS_XMETAAFFIXER (element);
+  GstStructure *stats;
 
   switch (transition) {
     case GST_STATE_CHANGE_NULL_TO_READY:
       break;
     case GST_STATE_CHANGE_READY_TO_PAUSED:
+      self->history = g_new0 (GstVvas_XMetaAffixerHistoryEntry,
+          self->history_size);
+      self->history_start = 0;
+      self->history_len = 0;
       gst_collect_pads_start (self->collect);
       if (self->retry_timeout != -1) {
         g_mutex_lock (&self->timeout_lock);
@@ -1573,6 +2025,12 @@ gst_vvas_xmetaaffixer_change_state (GstElement * element,
         self->stop_thread = FALSE;
       }
       gst_collect_pads_stop (self->collect);
+      vvas_xmetaaffixer_history_clear (self);
+      stats = vvas_xmetaaffixer_attach_stats_to_structure (self);
+      GST_INFO_OBJECT (self, "%" GST_PTR_FORMAT, stats);
+      gst_structure_free (stats);
+      g_free (self->history);
+      self->history = NULL;
       break;
     default:
       break;
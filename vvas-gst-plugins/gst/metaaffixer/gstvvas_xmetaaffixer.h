@@ -95,6 +95,37 @@ typedef enum
   VVAS_XMETAAFFIXER_STATE_PROCESS_BUFFER,
 } VVAS_XMETAAFFIXER_STREAM_STATE;
 
+typedef enum
+{
+  /** Attach metadata of the master frame matching the slave frame */
+  VVAS_XMETAAFFIXER_INTERPOLATE_NONE,
+  /** Linearly interpolate bounding boxes of the same prediction_id between
+   *  the master frames around the slave frame */
+  VVAS_XMETAAFFIXER_INTERPOLATE_LINEAR,
+} VVAS_XMETAAFFIXER_INTERPOLATE;
+
+typedef struct
+{
+  /** Presentation timestamp of the master frame */
+  GstClockTime pts;
+  /** Buffer holding meta data of the master frame only but not data */
+  GstBuffer *meta_buf;
+} GstVvas_XMetaAffixerHistoryEntry;
+
+typedef struct
+{
+  /** Number of slave buffers meta data was attached to */
+  guint64 attached;
+  /** Number of them which were writable and got meta data in place */
+  guint64 in_place;
+  /** Number of them still referenced elsewhere, which were wrapped in a new
+   *  buffer sharing their memory */
+  guint64 shared;
+  /** Number of them still referenced elsewhere whose memory can not be
+   *  shared, which were copied */
+  guint64 copied;
+} GstVvas_XMetaAffixerAttachStats;
+
 struct _GstVvas_XMetaAffixerCollectData
 {
   /* we extend the CollectData */
@@ -150,9 +181,20 @@ struct _GstVvas_XMetaAffixer
   gboolean sync;
   /** End time of previous buffer on master sink pad */
   GstClockTime prev_m_end_ts;
-  /** Buffer holding meta data of previous buffer on master sink pad
-   * buffer holds metadata only but not data */
-  GstBuffer *prev_meta_buf;
+  /** Ring of meta data of previous buffers on master sink pad, ordered
+   *  by PTS */
+  GstVvas_XMetaAffixerHistoryEntry *history;
+  /** Maximum number of entries in history */
+  guint history_size;
+  /** Index of the oldest entry in history */
+  guint history_start;
+  /** Number of valid entries in history */
+  guint history_len;
+  /** Interpolation of meta data attached to slave buffers */
+  VVAS_XMETAAFFIXER_INTERPOLATE interpolate;
+  /** Counters of meta data attachment to slave buffers, protected by
+   *  object lock */
+  GstVvas_XMetaAffixerAttachStats attach_stats;
   /** Pointer to GThread onject */
   GThread *timeout_thread;
   /** Duration to wait before triggering recovery action in case
@@ -32,6 +32,7 @@
 
 #include <gst/gst.h>
 #include <gst/vvas/gstvvassrcidmeta.h>
+#include <gst/vvas/gstvvastrace.h>
 #include "gstvvas_xreorderframe.h"
 
 /** @def GST_CAT_DEFAULT
@@ -923,6 +924,8 @@ gst_vvas_xreorderframe_infer_chain (GstPad * pad, GstObject * parent,
         /* Infer queue is available for that srcId. Push the buffer to infer queue */
         reorderframe->infer_buffers_len++;
         g_queue_push_tail (infer_queue, buf);
+        gst_vvas_trace_value (GST_OBJECT (pad), GST_VVAS_TRACE_QUEUE_DEPTH,
+            reorderframe->infer_buffers_len);
         /* Unblock the processing thread, if it is waiting for infer buffers */
         if (reorderframe->is_waiting_for_buffer) {
           g_cond_signal (&reorderframe->infer_cond);
@@ -995,6 +998,8 @@ gst_vvas_xreorderframe_skip_chain (GstPad * pad, GstObject * parent,
           g_cond_wait (&reorderframe->skip_cond, &reorderframe->skip_lock);
         }
         g_queue_push_tail (skip_queue, buf);
+        gst_vvas_trace_value (GST_OBJECT (pad), GST_VVAS_TRACE_QUEUE_DEPTH,
+            reorderframe->skip_buffers_len);
       }
     } else {
       GST_ERROR_OBJECT (reorderframe,
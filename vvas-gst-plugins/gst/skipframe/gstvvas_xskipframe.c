@@ -31,6 +31,7 @@
 
 #include <gst/gst.h>
 #include <gst/vvas/gstvvassrcidmeta.h>
+#include <gst/vvas/gstinferencemeta.h>
 #include "gstvvas_xskipframe.h"
 
 /* These might be added to glib in the future, but in the meantime they're defined here. */
@@ -341,6 +342,25 @@ gst_vvas_xskip_frame_query (GstPad * pad, GstObject * parent, GstQuery * query)
   return ret;
 }
 
+/**
+ *  @fn static gboolean vvas_xskipframe_is_gated (GstBuffer * buffer)
+ *  @param [in] buffer  - Chained GstBuffer
+ *  @return TRUE if an upstream element such as vvas_xgate disabled the
+ *          inference of this frame
+ *  @brief  Checks the root prediction of the inference meta data
+ */
+static gboolean
+vvas_xskipframe_is_gated (GstBuffer * buffer)
+{
+  GstInferenceMeta *infer_meta;
+
+  infer_meta = (GstInferenceMeta *) gst_buffer_get_meta (buffer,
+      gst_inference_meta_api_get_type ());
+
+  return infer_meta && infer_meta->prediction &&
+      !infer_meta->prediction->prediction.enabled;
+}
+
 /**
  *  @fn static GstFlowReturn gst_vvas_xskipframe_sink_chain (GstPad * pad,
  *                             GstObject * parent, GstBuffer * buffer)
@@ -449,6 +469,18 @@ gst_vvas_xskipframe_sink_chain (GstPad * pad, GstObject * parent,
     goto error;
   }
 
+  /* A gated frame does not use the inference slot of its source, the next
+   * frame of the batch takes it */
+  if (srcpad == vvas_xskipframe->inference_srcpad &&
+      vvas_xskipframe_is_gated (buffer)) {
+    GST_DEBUG_OBJECT (vvas_xskipframe,
+        "Gated: source id - %u frame id - %lu batch_id - %d", meta->src_id,
+        meta->frame_id, vvas_xskipframe->batch_id);
+    g_hash_table_insert (vvas_xskipframe->infer_pair,
+        GUINT_TO_POINTER (src_id), GUINT_TO_POINTER (1));
+    srcpad = vvas_xskipframe->skip_srcpad;
+  }
+
   /* pushes the buffer on selected srcpad */
   return gst_pad_push (srcpad, buffer);
 
@@ -0,0 +1,897 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * vvas_xstereo gives the distance of detected objects from a rectified
+ * stereo pair, e.g.
+ *
+ *   vvas_xstereo name=st focal-length=700 baseline=0.12 ! ...
+ *   left_src ! ... ! vvas_xinfer ... ! st.left
+ *   right_src ! ... ! st.right
+ *
+ * Left and right buffers are paired by the running time of their PTS. When
+ * they are more than pair-tolerance apart, an older right buffer is dropped
+ * and an older left buffer is pushed unchanged, as is every left buffer after
+ * the right stream ended. Buffers without PTS are paired in arrival order. The disparity of the
+ * left luma plane is computed by block matching (SAD window, the algorithm of
+ * hls::FindStereoCorrespondenceBM) on the lines covered by the bounding boxes
+ * of the GstInferenceMeta of the left buffer only, in bands on a pool of
+ * threads. Each prediction gets a classification holding the median
+ * disparity of its box: class_id in 1/16 pixel, -16 if no pixel of the box
+ * has a reliable disparity, class_prob the share of the box, clipped to the
+ * frame, that has one, class_label "disparity <px>" or, with focal-length and
+ * baseline set, "depth <focal-length * baseline / disparity>" in the unit of
+ * baseline. The left buffer is pushed, the right one dropped.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include <string.h>
+#include "gstvvas_xstereo.h"
+#include <gst/vvas/gstinferencemeta.h>
+
+GST_DEBUG_CATEGORY_STATIC (gst_vvas_xstereo_debug_category);
+#define GST_CAT_DEFAULT gst_vvas_xstereo_debug_category
+
+#define gst_vvas_xstereo_parent_class parent_class
+
+static GstFlowReturn gst_vvas_xstereo_aggregate (GstAggregator * agg,
+    gboolean timeout);
+static GstFlowReturn gst_vvas_xstereo_update_src_caps (GstAggregator * agg,
+    GstCaps * caps, GstCaps ** ret);
+static gboolean gst_vvas_xstereo_sink_event (GstAggregator * agg,
+    GstAggregatorPad * pad, GstEvent * event);
+static gboolean gst_vvas_xstereo_start (GstAggregator * agg);
+static gboolean gst_vvas_xstereo_stop (GstAggregator * agg);
+static void gst_vvas_xstereo_finalize (GObject * gobject);
+
+enum
+{
+  PROP_0,
+  PROP_SAD_WINDOW,
+  PROP_NUM_DISPARITIES,
+  PROP_PREFILTER_CAP,
+  PROP_TEXTURE_THRESHOLD,
+  PROP_UNIQUENESS_RATIO,
+  PROP_FOCAL_LENGTH,
+  PROP_BASELINE,
+  PROP_NUM_THREADS,
+  PROP_PAIR_TOLERANCE
+};
+
+G_DEFINE_TYPE_WITH_CODE (GstVvas_XStereo, gst_vvas_xstereo,
+    GST_TYPE_AGGREGATOR,
+    GST_DEBUG_CATEGORY_INIT (gst_vvas_xstereo_debug_category, "vvas_xstereo",
+        0, "debug category for VVAS stereo depth element"));
+
+#define VVAS_XSTEREO_CAPS \
+    GST_VIDEO_CAPS_MAKE ("{ GRAY8, NV12, NV16, I420 }")
+
+static GstStaticPadTemplate left_template = GST_STATIC_PAD_TEMPLATE ("left",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VVAS_XSTEREO_CAPS));
+
+static GstStaticPadTemplate right_template = GST_STATIC_PAD_TEMPLATE ("right",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VVAS_XSTEREO_CAPS));
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VVAS_XSTEREO_CAPS));
+
+#define GSTVVAS_XSTEREO_DEFAULT_FOCAL_LENGTH 0.0
+#define GSTVVAS_XSTEREO_DEFAULT_BASELINE 0.0
+#define GSTVVAS_XSTEREO_DEFAULT_NUM_THREADS 0
+#define GSTVVAS_XSTEREO_DEFAULT_PAIR_TOLERANCE 0
+/* Pair tolerance when neither the framerate nor the buffer duration is known */
+#define GSTVVAS_XSTEREO_FALLBACK_PAIR_TOLERANCE (10 * GST_MSECOND)
+/* Lines matched by a band at least, keeps thread overhead low on small
+ * objects */
+#define GSTVVAS_XSTEREO_MIN_BAND_LINES 16
+
+static void
+gst_vvas_xstereo_set_property (GObject * object,
+    guint prop_id, const GValue * value, GParamSpec * pspec)
+{
+  GstVvas_XStereo *self = GST_VVAS_XSTEREO (object);
+  guint val;
+
+  GST_OBJECT_LOCK (self);
+  switch (prop_id) {
+    case PROP_SAD_WINDOW:
+      val = g_value_get_uint (value);
+      if (!(val & 1)) {
+        g_warning ("sad-window must be odd");
+        break;
+      }
+      self->params.sad_window = val;
+      break;
+    case PROP_NUM_DISPARITIES:
+      self->params.num_disparities = GST_ROUND_UP_16 (g_value_get_uint (value));
+      break;
+    case PROP_PREFILTER_CAP:
+      self->params.prefilter_cap = g_value_get_uint (value);
+      break;
+    case PROP_TEXTURE_THRESHOLD:
+      self->params.texture_threshold = g_value_get_uint (value);
+      break;
+    case PROP_UNIQUENESS_RATIO:
+      self->params.uniqueness_ratio = g_value_get_uint (value);
+      break;
+    case PROP_FOCAL_LENGTH:
+      self->focal_length = g_value_get_double (value);
+      break;
+    case PROP_BASELINE:
+      self->baseline = g_value_get_double (value);
+      break;
+    case PROP_NUM_THREADS:
+      self->num_threads = g_value_get_uint (value);
+      break;
+    case PROP_PAIR_TOLERANCE:
+      self->pair_tolerance = g_value_get_uint64 (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gst_vvas_xstereo_get_property (GObject * object,
+    guint prop_id, GValue * value, GParamSpec * pspec)
+{
+  GstVvas_XStereo *self = GST_VVAS_XSTEREO (object);
+
+  GST_OBJECT_LOCK (self);
+  switch (prop_id) {
+    case PROP_SAD_WINDOW:
+      g_value_set_uint (value, self->params.sad_window);
+      break;
+    case PROP_NUM_DISPARITIES:
+      g_value_set_uint (value, self->params.num_disparities);
+      break;
+    case PROP_PREFILTER_CAP:
+      g_value_set_uint (value, self->params.prefilter_cap);
+      break;
+    case PROP_TEXTURE_THRESHOLD:
+      g_value_set_uint (value, self->params.texture_threshold);
+      break;
+    case PROP_UNIQUENESS_RATIO:
+      g_value_set_uint (value, self->params.uniqueness_ratio);
+      break;
+    case PROP_FOCAL_LENGTH:
+      g_value_set_double (value, self->focal_length);
+      break;
+    case PROP_BASELINE:
+      g_value_set_double (value, self->baseline);
+      break;
+    case PROP_NUM_THREADS:
+      g_value_set_uint (value, self->num_threads);
+      break;
+    case PROP_PAIR_TOLERANCE:
+      g_value_set_uint64 (value, self->pair_tolerance);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gst_vvas_xstereo_class_init (GstVvas_XStereoClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstAggregatorClass *aggregator_class = GST_AGGREGATOR_CLASS (klass);
+  VvasXStereoBMParams defaults;
+
+  vvas_xstereo_bm_params_init (&defaults);
+
+  gobject_class->set_property = gst_vvas_xstereo_set_property;
+  gobject_class->get_property = gst_vvas_xstereo_get_property;
+  gobject_class->finalize = gst_vvas_xstereo_finalize;
+
+  gst_element_class_add_static_pad_template_with_gtype (GST_ELEMENT_CLASS
+      (klass), &left_template, GST_TYPE_AGGREGATOR_PAD);
+  gst_element_class_add_static_pad_template_with_gtype (GST_ELEMENT_CLASS
+      (klass), &right_template, GST_TYPE_AGGREGATOR_PAD);
+  gst_element_class_add_static_pad_template_with_gtype (GST_ELEMENT_CLASS
+      (klass), &src_template, GST_TYPE_AGGREGATOR_PAD);
+
+  g_object_class_install_property (gobject_class, PROP_SAD_WINDOW,
+      g_param_spec_uint ("sad-window", "SAD window",
+          "Odd size of the square window compared between the frames",
+          VVAS_XSTEREO_BM_MIN_WINDOW, VVAS_XSTEREO_BM_MAX_WINDOW,
+          defaults.sad_window,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_NUM_DISPARITIES,
+      g_param_spec_uint ("num-disparities", "Number of disparities",
+          "Disparities searched from 0, rounded up to a multiple of 16. "
+          "Objects closer than focal-length * baseline / num-disparities "
+          "get wrong depths",
+          VVAS_XSTEREO_BM_DISP_UNIT, VVAS_XSTEREO_BM_MAX_DISPARITIES,
+          defaults.num_disparities,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_PREFILTER_CAP,
+      g_param_spec_uint ("prefilter-cap", "Prefilter cap",
+          "Horizontal Sobel responses are clipped to [-cap, cap] before "
+          "matching", 1, VVAS_XSTEREO_BM_MAX_CAP, defaults.prefilter_cap,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_TEXTURE_THRESHOLD,
+      g_param_spec_uint ("texture-threshold", "Texture threshold",
+          "Windows with less texture have no disparity", 0, G_MAXUINT16,
+          defaults.texture_threshold,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_UNIQUENESS_RATIO,
+      g_param_spec_uint ("uniqueness-ratio", "Uniqueness ratio",
+          "Percentage by which the best match must beat other disparities, "
+          "0 to disable", 0, 100, defaults.uniqueness_ratio,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_FOCAL_LENGTH,
+      g_param_spec_double ("focal-length", "Focal length",
+          "Focal length of the rectified cameras in pixels, 0 to give "
+          "disparities instead of depths", 0, G_MAXDOUBLE,
+          GSTVVAS_XSTEREO_DEFAULT_FOCAL_LENGTH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_BASELINE,
+      g_param_spec_double ("baseline", "Baseline",
+          "Distance between the cameras, depths are given in its unit, 0 to "
+          "give disparities instead of depths", 0, G_MAXDOUBLE,
+          GSTVVAS_XSTEREO_DEFAULT_BASELINE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_NUM_THREADS,
+      g_param_spec_uint ("num-threads", "Number of threads",
+          "Threads matching a frame, 0 for one per CPU",
+          0, GST_VVAS_BAND_WORKER_MAX_THREADS,
+          GSTVVAS_XSTEREO_DEFAULT_NUM_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_PAIR_TOLERANCE,
+      g_param_spec_uint64 ("pair-tolerance", "Pair tolerance",
+          "Largest difference in ns between the running times of a left and "
+          "a right buffer paired. An older right buffer is dropped otherwise, "
+          "an older left one pushed without depth. 0 for half a left frame "
+          "duration", 0, G_MAXUINT64,
+          GSTVVAS_XSTEREO_DEFAULT_PAIR_TOLERANCE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  gst_element_class_set_static_metadata (GST_ELEMENT_CLASS (klass),
+      "VVAS stereo depth",
+      "Filter/Analyzer/Video", "Adds the stereo depth of detected objects "
+      "to their inference meta data", "Xilinx Inc");
+
+  aggregator_class->aggregate = GST_DEBUG_FUNCPTR (gst_vvas_xstereo_aggregate);
+  aggregator_class->update_src_caps =
+      GST_DEBUG_FUNCPTR (gst_vvas_xstereo_update_src_caps);
+  aggregator_class->sink_event =
+      GST_DEBUG_FUNCPTR (gst_vvas_xstereo_sink_event);
+  aggregator_class->start = GST_DEBUG_FUNCPTR (gst_vvas_xstereo_start);
+  aggregator_class->stop = GST_DEBUG_FUNCPTR (gst_vvas_xstereo_stop);
+}
+
+/**
+ *  @fn static GstAggregatorPad * vvas_xstereo_add_pad (GstVvas_XStereo * self,
+ *                                                      const gchar * name)
+ *  @param [in] self - Element
+ *  @param [in] name - Name of the pad and of its template
+ *  @return Always sink pad added to \p self
+ */
+static GstAggregatorPad *
+vvas_xstereo_add_pad (GstVvas_XStereo * self, const gchar * name)
+{
+  GstPadTemplate *templ =
+      gst_element_class_get_pad_template (GST_ELEMENT_GET_CLASS (self), name);
+  GstAggregatorPad *pad = g_object_new (GST_TYPE_AGGREGATOR_PAD, "name", name,
+      "direction", GST_PAD_SINK, "template", templ, NULL);
+
+  gst_element_add_pad (GST_ELEMENT (self), GST_PAD (pad));
+
+  return pad;
+}
+
+static void
+gst_vvas_xstereo_init (GstVvas_XStereo * self)
+{
+  vvas_xstereo_bm_params_init (&self->params);
+  self->focal_length = GSTVVAS_XSTEREO_DEFAULT_FOCAL_LENGTH;
+  self->baseline = GSTVVAS_XSTEREO_DEFAULT_BASELINE;
+  self->num_threads = GSTVVAS_XSTEREO_DEFAULT_NUM_THREADS;
+  self->pair_tolerance = GSTVVAS_XSTEREO_DEFAULT_PAIR_TOLERANCE;
+  gst_video_info_init (&self->left_info);
+  gst_video_info_init (&self->right_info);
+  self->width = self->height = self->num_disparities = 0;
+  self->left_pf = self->right_pf = NULL;
+  self->disp = NULL;
+  self->hist = NULL;
+  self->worker = NULL;
+  self->bands = NULL;
+  self->num_bands = 0;
+
+  self->left_pad = vvas_xstereo_add_pad (self, "left");
+  self->right_pad = vvas_xstereo_add_pad (self, "right");
+}
+
+/**
+ *  @fn static void vvas_xstereo_free_buffers (GstVvas_XStereo * self)
+ *  @param [in] self - Element
+ *  @return None
+ */
+static void
+vvas_xstereo_free_buffers (GstVvas_XStereo * self)
+{
+  guint b;
+
+  g_free (self->left_pf);
+  g_free (self->right_pf);
+  g_free (self->disp);
+  g_free (self->hist);
+  self->left_pf = self->right_pf = NULL;
+  self->disp = NULL;
+  self->hist = NULL;
+  for (b = 0; b < self->num_bands; b++) {
+    g_free (self->bands[b].scratch);
+    self->bands[b].scratch = NULL;
+  }
+  self->width = self->height = self->num_disparities = 0;
+}
+
+static void
+gst_vvas_xstereo_finalize (GObject * gobject)
+{
+  GstVvas_XStereo *self = GST_VVAS_XSTEREO (gobject);
+
+  vvas_xstereo_free_buffers (self);
+  g_free (self->bands);
+
+  G_OBJECT_CLASS (parent_class)->finalize (gobject);
+}
+
+/**
+ *  @fn static void vvas_xstereo_band_func (gpointer data, gpointer user_data)
+ *  @param [in] data - GstVvasXStereoBand to compute
+ *  @param [in] user_data - Element
+ *  @return None
+ */
+static void
+vvas_xstereo_band_func (gpointer data, gpointer user_data)
+{
+  GstVvasXStereoBand *band = (GstVvasXStereoBand *) data;
+  GstVvas_XStereo *self = GST_VVAS_XSTEREO (user_data);
+
+  if (self->stage == GST_VVAS_XSTEREO_STAGE_PREFILTER) {
+    vvas_xstereo_bm_prefilter (GST_VIDEO_FRAME_PLANE_DATA (self->left_frame,
+            0), GST_VIDEO_FRAME_PLANE_STRIDE (self->left_frame, 0),
+        self->width, self->height, self->frame_params.prefilter_cap,
+        self->left_pf, band->first_line, band->num_lines);
+    vvas_xstereo_bm_prefilter (GST_VIDEO_FRAME_PLANE_DATA (self->right_frame,
+            0), GST_VIDEO_FRAME_PLANE_STRIDE (self->right_frame, 0),
+        self->width, self->height, self->frame_params.prefilter_cap,
+        self->right_pf, band->first_line, band->num_lines);
+  } else {
+    vvas_xstereo_bm_match (&self->frame_params, self->left_pf,
+        self->right_pf, self->width, self->height, self->disp,
+        band->first_line, band->num_lines, band->scratch);
+  }
+}
+
+/**
+ *  @fn static void vvas_xstereo_run (GstVvas_XStereo * self,
+ *                                    GstVvasXStereoStage stage,
+ *                                    guint first_line, guint last_line)
+ *  @param [in] self - Element
+ *  @param [in] stage - Work to do
+ *  @param [in] first_line - First line to compute
+ *  @param [in] last_line - Line after the last one to compute
+ *  @return None
+ *  @brief  Splits the lines in bands, one per thread at most, and waits
+ *          until all are computed. The streaming thread computes the last
+ *          band itself.
+ */
+static void
+vvas_xstereo_run (GstVvas_XStereo * self, GstVvasXStereoStage stage,
+    guint first_line, guint last_line)
+{
+  guint lines = last_line - first_line;
+  guint bands = gst_vvas_band_worker_num_bands (self->worker, lines,
+      GSTVVAS_XSTEREO_MIN_BAND_LINES);
+  guint b, first = first_line;
+
+  if (!lines)
+    return;
+
+  self->stage = stage;
+
+  for (b = 0; b < bands; b++) {
+    GstVvasXStereoBand *band = &self->bands[b];
+    guint last = first_line + (b + 1) * lines / bands;
+
+    band->first_line = first;
+    band->num_lines = last - first;
+    first = last;
+  }
+
+  gst_vvas_band_worker_run (self->worker, self->bands,
+      sizeof (GstVvasXStereoBand), bands);
+}
+
+static gboolean
+gst_vvas_xstereo_start (GstAggregator * agg)
+{
+  GstVvas_XStereo *self = GST_VVAS_XSTEREO (agg);
+  GError *error = NULL;
+  guint num_threads;
+
+  GST_OBJECT_LOCK (self);
+  num_threads = self->num_threads;
+  GST_OBJECT_UNLOCK (self);
+
+  /* The streaming thread computes the last band itself */
+  self->worker = gst_vvas_band_worker_new (num_threads,
+      vvas_xstereo_band_func, self, &error);
+  if (!self->worker) {
+    GST_ERROR_OBJECT (self, "failed to create matching threads: %s",
+        error->message);
+    g_error_free (error);
+    return FALSE;
+  }
+
+  num_threads = gst_vvas_band_worker_get_num_threads (self->worker);
+  self->bands = g_new0 (GstVvasXStereoBand, num_threads);
+  self->num_bands = num_threads;
+
+  GST_DEBUG_OBJECT (self, "matching on %u threads", num_threads);
+
+  return TRUE;
+}
+
+static gboolean
+gst_vvas_xstereo_stop (GstAggregator * agg)
+{
+  GstVvas_XStereo *self = GST_VVAS_XSTEREO (agg);
+
+  gst_vvas_band_worker_free (self->worker);
+  self->worker = NULL;
+  vvas_xstereo_free_buffers (self);
+  g_free (self->bands);
+  self->bands = NULL;
+  self->num_bands = 0;
+  gst_video_info_init (&self->left_info);
+  gst_video_info_init (&self->right_info);
+
+  return TRUE;
+}
+
+static gboolean
+gst_vvas_xstereo_sink_event (GstAggregator * agg, GstAggregatorPad * pad,
+    GstEvent * event)
+{
+  GstVvas_XStereo *self = GST_VVAS_XSTEREO (agg);
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_CAPS) {
+    GstVideoInfo *vinfo = pad == self->left_pad ?
+        &self->left_info : &self->right_info;
+    GstCaps *caps;
+
+    gst_event_parse_caps (event, &caps);
+    if (!gst_video_info_from_caps (vinfo, caps)) {
+      GST_ERROR_OBJECT (pad, "Failed to parse caps %" GST_PTR_FORMAT, caps);
+      gst_event_unref (event);
+      return FALSE;
+    }
+    GST_DEBUG_OBJECT (pad, "caps %" GST_PTR_FORMAT, caps);
+
+    /* Output caps are the left ones, negotiated again before the next
+     * aggregate */
+    if (pad == self->left_pad)
+      gst_pad_mark_reconfigure (GST_AGGREGATOR_SRC_PAD (agg));
+  }
+
+  return GST_AGGREGATOR_CLASS (parent_class)->sink_event (agg, pad, event);
+}
+
+static GstFlowReturn
+gst_vvas_xstereo_update_src_caps (GstAggregator * agg, GstCaps * caps,
+    GstCaps ** ret)
+{
+  GstVvas_XStereo *self = GST_VVAS_XSTEREO (agg);
+  GstCaps *left_caps = gst_pad_get_current_caps (GST_PAD (self->left_pad));
+
+  if (!left_caps)
+    return GST_AGGREGATOR_FLOW_NEED_DATA;
+
+  /* Left buffers are pushed as they are */
+  if (!gst_caps_can_intersect (left_caps, caps)) {
+    GST_ERROR_OBJECT (self, "downstream does not accept %" GST_PTR_FORMAT,
+        left_caps);
+    gst_caps_unref (left_caps);
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+
+  *ret = left_caps;
+
+  return GST_FLOW_OK;
+}
+
+/**
+ *  @fn static gboolean vvas_xstereo_ensure_buffers (GstVvas_XStereo * self)
+ *  @param [in] self - Element
+ *  @return FALSE if frames cannot be matched with the current parameters
+ *  @brief  Takes the parameters of the next frame and allocates the buffers
+ *          they need
+ */
+static gboolean
+vvas_xstereo_ensure_buffers (GstVvas_XStereo * self)
+{
+  guint width = GST_VIDEO_INFO_WIDTH (&self->left_info);
+  guint height = GST_VIDEO_INFO_HEIGHT (&self->left_info);
+  gsize scratch_size;
+  guint b;
+
+  GST_OBJECT_LOCK (self);
+  self->frame_params = self->params;
+  GST_OBJECT_UNLOCK (self);
+
+  if (!vvas_xstereo_bm_params_valid (&self->frame_params, width, height)) {
+    GST_ELEMENT_ERROR (self, STREAM, FAILED, (NULL),
+        ("%ux%u frames cannot be matched with a %u window and %u disparities",
+            width, height, self->frame_params.sad_window,
+            self->frame_params.num_disparities));
+    return FALSE;
+  }
+
+  if (width == self->width && height == self->height &&
+      self->frame_params.num_disparities == self->num_disparities)
+    return TRUE;
+
+  vvas_xstereo_free_buffers (self);
+  self->width = width;
+  self->height = height;
+  self->num_disparities = self->frame_params.num_disparities;
+  self->left_pf = g_new (guint8, (gsize) width * height);
+  self->right_pf = g_new (guint8, (gsize) width * height);
+  self->disp = g_new (gint16, (gsize) width * height);
+  self->hist = g_new (guint32,
+      self->num_disparities << VVAS_XSTEREO_BM_DISP_SHIFT);
+  scratch_size = vvas_xstereo_bm_scratch_size (&self->frame_params, width);
+  for (b = 0; b < self->num_bands; b++)
+    self->bands[b].scratch = g_malloc (scratch_size);
+
+  return TRUE;
+}
+
+/**
+ *  @fn static void vvas_xstereo_classify (GstVvas_XStereo * self,
+ *                                         GSList * preds)
+ *  @param [in] self - Element
+ *  @param [in] preds - Predictions to add the depth of
+ *  @return None
+ */
+static void
+vvas_xstereo_classify (GstVvas_XStereo * self, GSList * preds)
+{
+  gdouble focal_baseline;
+  GSList *iter;
+
+  GST_OBJECT_LOCK (self);
+  focal_baseline = self->focal_length * self->baseline;
+  GST_OBJECT_UNLOCK (self);
+
+  for (iter = preds; iter; iter = g_slist_next (iter)) {
+    GstInferencePrediction *pred = (GstInferencePrediction *) iter->data;
+    VvasBoundingBox *bbox = &pred->prediction.bbox;
+    GstInferenceClassification *classification;
+    gdouble disparity, share = 0.0;
+    gint64 width, height;
+    gchar *label;
+    guint valid;
+    gint median;
+
+    median = vvas_xstereo_bm_median (self->disp, self->width, self->height,
+        bbox->x, bbox->y, bbox->width, bbox->height,
+        self->num_disparities, self->hist, &valid);
+    /* Share of the part of the box inside the frame, as the median */
+    width = CLAMP ((gint64) bbox->x + bbox->width, 0, (gint64) self->width) -
+        CLAMP ((gint64) bbox->x, 0, (gint64) self->width);
+    height = CLAMP ((gint64) bbox->y + bbox->height, 0,
+        (gint64) self->height) - CLAMP ((gint64) bbox->y, 0,
+        (gint64) self->height);
+    if (width > 0 && height > 0)
+      share = (gdouble) valid / ((gdouble) width * height);
+
+    if (median == VVAS_XSTEREO_BM_FILTERED)
+      label = g_strdup ("disparity unknown");
+    else if (focal_baseline <= 0)
+      label = g_strdup_printf ("disparity %.2f",
+          (gdouble) median / (1 << VVAS_XSTEREO_BM_DISP_SHIFT));
+    else if (!median)
+      label = g_strdup ("depth infinite");
+    else {
+      disparity = (gdouble) median / (1 << VVAS_XSTEREO_BM_DISP_SHIFT);
+      label = g_strdup_printf ("depth %.2f", focal_baseline / disparity);
+    }
+
+    GST_LOG_OBJECT (self, "%ux%u@%d,%d: %s, %u pixels", bbox->width,
+        bbox->height, bbox->x, bbox->y, label, valid);
+
+    classification = gst_inference_classification_new_full (median, share,
+        label, 0, NULL, NULL, NULL);
+    gst_inference_prediction_append_classification (pred, classification);
+    g_free (label);
+  }
+}
+
+/**
+ *  @fn static GstClockTime vvas_xstereo_running_time (GstAggregatorPad * pad,
+ *                                                     GstBuffer * buf)
+ *  @param [in] pad - Sink pad \p buf is queued on
+ *  @param [in] buf - Buffer
+ *  @return Running time of the PTS of \p buf, GST_CLOCK_TIME_NONE if unknown
+ */
+static GstClockTime
+vvas_xstereo_running_time (GstAggregatorPad * pad, GstBuffer * buf)
+{
+  GstClockTime running_time = GST_CLOCK_TIME_NONE;
+
+  if (GST_BUFFER_PTS_IS_VALID (buf)) {
+    GST_OBJECT_LOCK (pad);
+    running_time = gst_segment_to_running_time (&pad->segment,
+        GST_FORMAT_TIME, GST_BUFFER_PTS (buf));
+    GST_OBJECT_UNLOCK (pad);
+  }
+
+  return running_time;
+}
+
+/**
+ *  @fn static GstClockTime vvas_xstereo_pair_tolerance (GstVvas_XStereo * self,
+ *                                                       GstBuffer * left)
+ *  @param [in] self - Element
+ *  @param [in] left - Left buffer to pair
+ *  @return Largest running time difference of a pair
+ */
+static GstClockTime
+vvas_xstereo_pair_tolerance (GstVvas_XStereo * self, GstBuffer * left)
+{
+  GstClockTime tolerance;
+
+  GST_OBJECT_LOCK (self);
+  tolerance = self->pair_tolerance;
+  GST_OBJECT_UNLOCK (self);
+
+  if (tolerance)
+    return tolerance;
+  if (GST_VIDEO_INFO_FPS_N (&self->left_info) > 0)
+    return gst_util_uint64_scale (GST_SECOND,
+        GST_VIDEO_INFO_FPS_D (&self->left_info),
+        2 * GST_VIDEO_INFO_FPS_N (&self->left_info));
+  if (GST_BUFFER_DURATION_IS_VALID (left))
+    return GST_BUFFER_DURATION (left) / 2;
+
+  return GSTVVAS_XSTEREO_FALLBACK_PAIR_TOLERANCE;
+}
+
+/**
+ *  @fn static GstFlowReturn vvas_xstereo_push_unpaired (GstVvas_XStereo * self)
+ *  @param [in] self - Element
+ *  @return Flow return of the push
+ *  @brief  Pushes the next left buffer unchanged, no right buffer pairs with it
+ */
+static GstFlowReturn
+vvas_xstereo_push_unpaired (GstVvas_XStereo * self)
+{
+  GstBuffer *left = gst_aggregator_pad_pop_buffer (self->left_pad);
+
+  return gst_aggregator_finish_buffer (GST_AGGREGATOR (self), left);
+}
+
+static GstFlowReturn
+gst_vvas_xstereo_aggregate (GstAggregator * agg, gboolean timeout)
+{
+  GstVvas_XStereo *self = GST_VVAS_XSTEREO (agg);
+  GstBuffer *left, *right;
+  GstInferenceMeta *infer_meta;
+  GstVideoFrame left_frame, right_frame;
+  GSList *preds = NULL, *iter;
+  GstClockTime left_time, right_time, tolerance;
+  guint first_line, last_line, r;
+
+  left = gst_aggregator_pad_peek_buffer (self->left_pad);
+  right = gst_aggregator_pad_peek_buffer (self->right_pad);
+  if (!left) {
+    if (right)
+      gst_buffer_unref (right);
+    return gst_aggregator_pad_is_eos (self->left_pad) ? GST_FLOW_EOS :
+        GST_AGGREGATOR_FLOW_NEED_DATA;
+  }
+  if (!right) {
+    gst_buffer_unref (left);
+    if (!gst_aggregator_pad_is_eos (self->right_pad))
+      return GST_AGGREGATOR_FLOW_NEED_DATA;
+    /* No pair can be made anymore, left frames still pass */
+    return vvas_xstereo_push_unpaired (self);
+  }
+
+  /* A buffer lost on one side must not shift all following pairs */
+  left_time = vvas_xstereo_running_time (self->left_pad, left);
+  right_time = vvas_xstereo_running_time (self->right_pad, right);
+  if (GST_CLOCK_TIME_IS_VALID (left_time) &&
+      GST_CLOCK_TIME_IS_VALID (right_time)) {
+    tolerance = vvas_xstereo_pair_tolerance (self, left);
+
+    /* Left frames are the output, only right ones may be lost */
+    if (left_time + tolerance < right_time) {
+      GST_DEBUG_OBJECT (self->left_pad, "no buffer to pair with, left %"
+          GST_TIME_FORMAT " right %" GST_TIME_FORMAT ", pushing unchanged",
+          GST_TIME_ARGS (left_time), GST_TIME_ARGS (right_time));
+      gst_buffer_unref (left);
+      gst_buffer_unref (right);
+      return vvas_xstereo_push_unpaired (self);
+    }
+    if (right_time + tolerance < left_time) {
+      GST_DEBUG_OBJECT (self->right_pad, "no buffer to pair with, left %"
+          GST_TIME_FORMAT " right %" GST_TIME_FORMAT ", dropping",
+          GST_TIME_ARGS (left_time), GST_TIME_ARGS (right_time));
+      gst_buffer_unref (left);
+      gst_buffer_unref (right);
+      gst_aggregator_pad_drop_buffer (self->right_pad);
+      return GST_FLOW_OK;
+    }
+  }
+
+  gst_buffer_unref (left);
+  gst_buffer_unref (right);
+  left = gst_aggregator_pad_pop_buffer (self->left_pad);
+  right = gst_aggregator_pad_pop_buffer (self->right_pad);
+
+  infer_meta = (GstInferenceMeta *) gst_buffer_get_meta (left,
+      gst_inference_meta_api_get_type ());
+  if (!infer_meta)
+    goto push;
+
+  if (GST_VIDEO_INFO_WIDTH (&self->left_info) !=
+      GST_VIDEO_INFO_WIDTH (&self->right_info) ||
+      GST_VIDEO_INFO_HEIGHT (&self->left_info) !=
+      GST_VIDEO_INFO_HEIGHT (&self->right_info)) {
+    GST_ELEMENT_ERROR (self, STREAM, FORMAT, (NULL),
+        ("left %dx%d and right %dx%d frames differ",
+            GST_VIDEO_INFO_WIDTH (&self->left_info),
+            GST_VIDEO_INFO_HEIGHT (&self->left_info),
+            GST_VIDEO_INFO_WIDTH (&self->right_info),
+            GST_VIDEO_INFO_HEIGHT (&self->right_info)));
+    goto error;
+  }
+
+  /* Classifications are added to the meta data of the pushed buffer */
+  left = gst_buffer_make_writable (left);
+  infer_meta = (GstInferenceMeta *) gst_buffer_get_meta (left,
+      gst_inference_meta_api_get_type ());
+  if (infer_meta->prediction)
+    preds = gst_inference_prediction_get_boxes (infer_meta->prediction, FALSE);
+  if (!preds)
+    goto push;
+
+  if (!vvas_xstereo_ensure_buffers (self))
+    goto error;
+
+  /* Only lines of objects are matched */
+  first_line = self->height;
+  last_line = 0;
+  for (iter = preds; iter; iter = g_slist_next (iter)) {
+    VvasBoundingBox *bbox =
+        &((GstInferencePrediction *) iter->data)->prediction.bbox;
+
+    first_line = MIN (first_line, (guint) CLAMP (bbox->y, 0,
+            (gint) self->height));
+    last_line = MAX (last_line, (guint) CLAMP ((gint64) bbox->y +
+            bbox->height, 0, (gint) self->height));
+  }
+
+  if (!gst_video_frame_map (&left_frame, &self->left_info, left,
+          GST_MAP_READ)) {
+    GST_ELEMENT_ERROR (self, RESOURCE, READ, (NULL),
+        ("failed to map left frame"));
+    goto error;
+  }
+  if (!gst_video_frame_map (&right_frame, &self->right_info, right,
+          GST_MAP_READ)) {
+    gst_video_frame_unmap (&left_frame);
+    GST_ELEMENT_ERROR (self, RESOURCE, READ, (NULL),
+        ("failed to map right frame"));
+    goto error;
+  }
+
+  if (first_line < last_line) {
+    r = self->frame_params.sad_window / 2;
+    self->left_frame = &left_frame;
+    self->right_frame = &right_frame;
+    vvas_xstereo_run (self, GST_VVAS_XSTEREO_STAGE_PREFILTER,
+        first_line > r ? first_line - r : 0, MIN (last_line + r,
+            self->height));
+    vvas_xstereo_run (self, GST_VVAS_XSTEREO_STAGE_MATCH, first_line,
+        last_line);
+    self->left_frame = self->right_frame = NULL;
+  }
+
+  gst_video_frame_unmap (&right_frame);
+  gst_video_frame_unmap (&left_frame);
+
+  vvas_xstereo_classify (self, preds);
+
+push:
+  g_slist_free (preds);
+  gst_buffer_unref (right);
+
+  return gst_aggregator_finish_buffer (agg, left);
+
+error:
+  g_slist_free (preds);
+  gst_buffer_unref (right);
+  gst_buffer_unref (left);
+
+  return GST_FLOW_ERROR;
+}
+
+static gboolean
+vvas_xstereo_init (GstPlugin * vvas_xstereo)
+{
+  return gst_element_register (vvas_xstereo, "vvas_xstereo",
+      GST_RANK_PRIMARY, GST_TYPE_VVAS_XSTEREO);
+}
+
+/* PACKAGE: this is usually set by autotools depending on some _INIT macro
+ * in configure.ac and then written into and defined in config.h, but we can
+ * just set it ourselves here in case someone doesn't use autotools to
+ * compile this code. GST_PLUGIN_DEFINE needs PACKAGE to be defined.
+ */
+#ifndef PACKAGE
+#define PACKAGE "vvas_xstereo"
+#endif
+
+GST_PLUGIN_DEFINE (GST_VERSION_MAJOR, GST_VERSION_MINOR, vvas_xstereo,
+    "Xilinx VVAS SDK plugin for stereo depth of detected objects",
+    vvas_xstereo_init, VVAS_API_VERSION, "MIT/X11", "Xilinx VVAS SDK plugin",
+    "http://xilinx.com/")
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+#ifndef _GST_VVAS_XSTEREO_H_
+#define _GST_VVAS_XSTEREO_H_
+
+#include <gst/base/gstaggregator.h>
+#include <gst/video/video.h>
+#include <gst/vvas/gstvvasutils.h>
+#include "vvas_xstereo_bm.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_VVAS_XSTEREO   (gst_vvas_xstereo_get_type())
+#define GST_VVAS_XSTEREO(obj)   (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_VVAS_XSTEREO,GstVvas_XStereo))
+#define GST_VVAS_XSTEREO_CLASS(klass)   (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_VVAS_XSTEREO,GstVvas_XStereoClass))
+#define GST_IS_VVAS_XSTEREO(obj)   (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_VVAS_XSTEREO))
+#define GST_IS_VVAS_XSTEREO_CLASS(obj)   (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_VVAS_XSTEREO))
+
+typedef struct _GstVvas_XStereo GstVvas_XStereo;
+typedef struct _GstVvas_XStereoClass GstVvas_XStereoClass;
+
+/**
+ *  @brief Work of one thread
+ */
+typedef enum
+{
+  /** Prefilter lines of both frames */
+  GST_VVAS_XSTEREO_STAGE_PREFILTER,
+  /** Match prefiltered lines */
+  GST_VVAS_XSTEREO_STAGE_MATCH,
+} GstVvasXStereoStage;
+
+/**
+ *  @brief Band of lines computed by one thread
+ */
+typedef struct
+{
+  /** First line */
+  guint first_line;
+  /** Number of lines */
+  guint num_lines;
+  /** vvas_xstereo_bm_match() scratch of this band */
+  gpointer scratch;
+} GstVvasXStereoBand;
+
+struct _GstVvas_XStereo
+{
+  GstAggregator parent;
+  /** Left camera, its buffers are pushed with the depth of their objects */
+  GstAggregatorPad *left_pad;
+  /** Right camera */
+  GstAggregatorPad *right_pad;
+  /** Block matching properties */
+  VvasXStereoBMParams params;
+  /** Focal length in pixels, depth is given when set with baseline */
+  gdouble focal_length;
+  /** Distance between the cameras */
+  gdouble baseline;
+  /** Threads matching a frame, 0 for one per CPU */
+  guint num_threads;
+  /** Running times of paired buffers differ by this much at most, 0 for
+   *  half a left frame duration */
+  GstClockTime pair_tolerance;
+  /** Negotiated left video info */
+  GstVideoInfo left_info;
+  /** Negotiated right video info */
+  GstVideoInfo right_info;
+  /** Parameters of the current frame */
+  VvasXStereoBMParams frame_params;
+  /** Frame size buffers were allocated for */
+  guint width;
+  guint height;
+  /** Disparities buffers were allocated for */
+  guint num_disparities;
+  /** Prefiltered frames */
+  guint8 *left_pf;
+  guint8 *right_pf;
+  /** Disparity map, valid on lines of objects only */
+  gint16 *disp;
+  /** Histogram of disparities of an object */
+  guint32 *hist;
+  /** Luma planes being matched */
+  GstVideoFrame *left_frame;
+  GstVideoFrame *right_frame;
+  /** Work of the bands being computed */
+  GstVvasXStereoStage stage;
+  /** Matching threads */
+  GstVvasBandWorker *worker;
+  /** One band per thread */
+  GstVvasXStereoBand *bands;
+  /** Number of bands */
+  guint num_bands;
+};
+
+struct _GstVvas_XStereoClass
+{
+  GstAggregatorClass parentclass;
+};
+
+GType gst_vvas_xstereo_get_type (void);
+
+G_END_DECLS
+
+#endif
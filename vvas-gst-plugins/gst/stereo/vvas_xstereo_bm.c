@@ -0,0 +1,546 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Block matching stereo correspondence, the CPU counterpart of
+ * hls::FindStereoCorrespondenceBM with the X Sobel prefilter. Both frames are
+ * prefiltered, then for each left pixel the SAD of the window around it is
+ * computed against the right frame shifted by every disparity. Window SADs
+ * are kept incrementally: column sums are updated by one line in and one out
+ * when moving down, window sums by one column in and one out when moving
+ * right. Sums fit 16 bits (2 * 63 * 21 * 21 < 65536) and disparities are
+ * stored innermost by groups of VVAS_XSTEREO_BM_DISP_UNIT: on x86 (SSE2) and
+ * aarch64 (NEON) a group is updated and searched with two 8 lane vectors,
+ * other targets use the scalar loops. Both give the same disparities, which
+ * have 4 fraction bits from the parabola through the best SAD and its
+ * neighbours, as the HLS kernel does.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include "vvas_xstereo_bm.h"
+
+#if defined(__GNUC__) && defined(__SSE2__)
+#define VVAS_XSTEREO_BM_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#define VVAS_XSTEREO_BM_NEON 1
+#include <arm_neon.h>
+#endif
+
+/**
+ *  @fn void vvas_xstereo_bm_params_init (VvasXStereoBMParams * params)
+ *  @param [out] params - Parameters to initialize
+ *  @return None
+ *  @brief  Defaults of hls::StereoBMState with a 15x15 window and 64
+ *          disparities
+ */
+void
+vvas_xstereo_bm_params_init (VvasXStereoBMParams * params)
+{
+  params->sad_window = 15;
+  params->num_disparities = 64;
+  params->prefilter_cap = 31;
+  params->texture_threshold = 10;
+  params->uniqueness_ratio = 15;
+}
+
+/**
+ *  @fn gboolean vvas_xstereo_bm_params_valid (const VvasXStereoBMParams * params,
+ *                                             guint width, guint height)
+ *  @param [in] params - Parameters to check
+ *  @param [in] width - Frame width
+ *  @param [in] height - Frame height
+ *  @return TRUE if frames of \p width x \p height can be matched with
+ *          \p params
+ */
+gboolean
+vvas_xstereo_bm_params_valid (const VvasXStereoBMParams * params,
+    guint width, guint height)
+{
+  if (params->sad_window < VVAS_XSTEREO_BM_MIN_WINDOW ||
+      params->sad_window > VVAS_XSTEREO_BM_MAX_WINDOW ||
+      !(params->sad_window & 1))
+    return FALSE;
+  if (!params->num_disparities ||
+      params->num_disparities > VVAS_XSTEREO_BM_MAX_DISPARITIES ||
+      params->num_disparities % VVAS_XSTEREO_BM_DISP_UNIT)
+    return FALSE;
+  if (!params->prefilter_cap ||
+      params->prefilter_cap > VVAS_XSTEREO_BM_MAX_CAP)
+    return FALSE;
+
+  /* At least one pixel must have a full window at every disparity */
+  return width >= params->num_disparities + params->sad_window - 1 &&
+      height >= params->sad_window;
+}
+
+/**
+ *  @fn void vvas_xstereo_bm_prefilter (const guint8 * src, guint stride,
+ *                                      guint width, guint height, guint cap,
+ *                                      guint8 * dst, guint first_line,
+ *                                      guint num_lines)
+ *  @param [in] src - Luma plane
+ *  @param [in] stride - Line stride of \p src
+ *  @param [in] width - Frame width
+ *  @param [in] height - Frame height
+ *  @param [in] cap - Prefilter cap
+ *  @param [out] dst - Prefiltered frame, \p width bytes per line
+ *  @param [in] first_line - First line to prefilter
+ *  @param [in] num_lines - Number of lines to prefilter
+ *  @return None
+ *  @brief  3x3 X Sobel with replicated borders, clipped to [-cap, cap] and
+ *          offset by cap
+ */
+void
+vvas_xstereo_bm_prefilter (const guint8 * src, guint stride, guint width,
+    guint height, guint cap, guint8 * dst, guint first_line, guint num_lines)
+{
+  const gint icap = cap;
+  guint x, y;
+
+  for (y = first_line; y < first_line + num_lines; y++) {
+    const guint8 *above = src + (gsize) (y ? y - 1 : 0) * stride;
+    const guint8 *line = src + (gsize) y * stride;
+    const guint8 *below = src + (gsize) (y + 1 < height ? y + 1 : y) * stride;
+    guint8 *out = dst + (gsize) y * width;
+
+    for (x = 0; x < width; x++) {
+      guint l = x ? x - 1 : 0;
+      guint r = x + 1 < width ? x + 1 : x;
+      gint gx = (above[r] - above[l]) + 2 * (line[r] - line[l]) +
+          (below[r] - below[l]);
+
+      out[x] = CLAMP (gx, -icap, icap) + icap;
+    }
+  }
+}
+
+/**
+ *  @fn gsize vvas_xstereo_bm_scratch_size (const VvasXStereoBMParams * params,
+ *                                          guint width)
+ *  @param [in] params - Parameters
+ *  @param [in] width - Frame width
+ *  @return Bytes of scratch memory vvas_xstereo_bm_match() needs
+ */
+gsize
+vvas_xstereo_bm_scratch_size (const VvasXStereoBMParams * params, guint width)
+{
+  return ((gsize) width * params->num_disparities + width +
+      params->num_disparities) * sizeof (guint16);
+}
+
+/**
+ *  @fn static void vvas_xstereo_bm_column_line (guint16 * col, guint16 * tex,
+ *                                               const guint8 * left,
+ *                                               const guint8 * right,
+ *                                               guint width, guint nd,
+ *                                               guint8 cap, gboolean add)
+ *  @param [inout] col - Column SADs, nd per column
+ *  @param [inout] tex - Column textures
+ *  @param [in] left - Prefiltered left line
+ *  @param [in] right - Prefiltered right line
+ *  @param [in] width - Frame width
+ *  @param [in] nd - Number of disparities
+ *  @param [in] cap - Prefilter cap, value of a flat pixel
+ *  @param [in] add - Adds the line to the column sums if TRUE, subtracts it
+ *                    otherwise
+ *  @return None
+ *  @brief  Entry j of column x holds disparity nd - 1 - j, so right pixels
+ *          are read in increasing order. Columns left of nd - 1 cannot be
+ *          matched at every disparity and are not kept.
+ */
+static inline void
+vvas_xstereo_bm_column_line (guint16 * col, guint16 * tex, const guint8 * left,
+    const guint8 * right, guint width, guint nd, guint8 cap, gboolean add)
+{
+  guint x, j;
+
+  for (x = nd - 1; x < width; x++) {
+    const guint8 lv = left[x];
+    const guint8 *rv = right + x - (nd - 1);
+    guint16 *c = col + (gsize) x * nd;
+    guint16 t = lv > cap ? lv - cap : cap - lv;
+#if defined(VVAS_XSTEREO_BM_SSE2)
+    const __m128i l = _mm_set1_epi8 (lv);
+    const __m128i zero = _mm_setzero_si128 ();
+
+    tex[x] += add ? t : -t;
+    for (j = 0; j < nd; j += VVAS_XSTEREO_BM_DISP_UNIT) {
+      __m128i r = _mm_loadu_si128 ((const __m128i *) (rv + j));
+      __m128i ad = _mm_or_si128 (_mm_subs_epu8 (l, r), _mm_subs_epu8 (r, l));
+      __m128i lo = _mm_loadu_si128 ((__m128i *) (c + j));
+      __m128i hi = _mm_loadu_si128 ((__m128i *) (c + j + 8));
+
+      if (add) {
+        lo = _mm_add_epi16 (lo, _mm_unpacklo_epi8 (ad, zero));
+        hi = _mm_add_epi16 (hi, _mm_unpackhi_epi8 (ad, zero));
+      } else {
+        lo = _mm_sub_epi16 (lo, _mm_unpacklo_epi8 (ad, zero));
+        hi = _mm_sub_epi16 (hi, _mm_unpackhi_epi8 (ad, zero));
+      }
+      _mm_storeu_si128 ((__m128i *) (c + j), lo);
+      _mm_storeu_si128 ((__m128i *) (c + j + 8), hi);
+    }
+#elif defined(VVAS_XSTEREO_BM_NEON)
+    const uint8x16_t l = vdupq_n_u8 (lv);
+
+    tex[x] += add ? t : -t;
+    for (j = 0; j < nd; j += VVAS_XSTEREO_BM_DISP_UNIT) {
+      uint8x16_t ad = vabdq_u8 (l, vld1q_u8 (rv + j));
+      uint16x8_t lo = vld1q_u16 (c + j);
+      uint16x8_t hi = vld1q_u16 (c + j + 8);
+
+      if (add) {
+        lo = vaddw_u8 (lo, vget_low_u8 (ad));
+        hi = vaddw_u8 (hi, vget_high_u8 (ad));
+      } else {
+        lo = vsubw_u8 (lo, vget_low_u8 (ad));
+        hi = vsubw_u8 (hi, vget_high_u8 (ad));
+      }
+      vst1q_u16 (c + j, lo);
+      vst1q_u16 (c + j + 8, hi);
+    }
+#else
+    tex[x] += add ? t : -t;
+    for (j = 0; j < nd; j++) {
+      guint16 ad = lv > rv[j] ? lv - rv[j] : rv[j] - lv;
+
+      c[j] += add ? ad : -ad;
+    }
+#endif
+  }
+}
+
+/**
+ *  @fn static void vvas_xstereo_bm_slide (guint16 * sad, const guint16 * in,
+ *                                         const guint16 * gone, guint nd)
+ *  @param [inout] sad - Window SADs
+ *  @param [in] in - Column SADs entering the window
+ *  @param [in] gone - Column SADs leaving the window
+ *  @param [in] nd - Number of disparities
+ *  @return None
+ */
+static inline void
+vvas_xstereo_bm_slide (guint16 * sad, const guint16 * in,
+    const guint16 * gone, guint nd)
+{
+  guint j;
+
+#if defined(VVAS_XSTEREO_BM_SSE2)
+  for (j = 0; j < nd; j += 8) {
+    __m128i s = _mm_loadu_si128 ((__m128i *) (sad + j));
+    __m128i i = _mm_loadu_si128 ((const __m128i *) (in + j));
+    __m128i g = _mm_loadu_si128 ((const __m128i *) (gone + j));
+
+    _mm_storeu_si128 ((__m128i *) (sad + j),
+        _mm_add_epi16 (s, _mm_sub_epi16 (i, g)));
+  }
+#elif defined(VVAS_XSTEREO_BM_NEON)
+  for (j = 0; j < nd; j += 8)
+    vst1q_u16 (sad + j, vaddq_u16 (vld1q_u16 (sad + j),
+            vsubq_u16 (vld1q_u16 (in + j), vld1q_u16 (gone + j))));
+#else
+  for (j = 0; j < nd; j++)
+    sad[j] += in[j] - gone[j];
+#endif
+}
+
+/**
+ *  @fn static guint16 vvas_xstereo_bm_min (const guint16 * sad, guint nd)
+ *  @param [in] sad - Window SADs
+ *  @param [in] nd - Number of disparities
+ *  @return Smallest SAD
+ */
+static inline guint16
+vvas_xstereo_bm_min (const guint16 * sad, guint nd)
+{
+  guint j;
+#if defined(VVAS_XSTEREO_BM_SSE2)
+  /* SSE2 only has a signed 16 bit minimum, flip the sign bit around it */
+  const __m128i bias = _mm_set1_epi16 ((gint16) 0x8000);
+  __m128i m = _mm_set1_epi16 (G_MAXINT16);
+  gint16 lanes[8];
+  gint16 min = G_MAXINT16;
+
+  for (j = 0; j < nd; j += 8)
+    m = _mm_min_epi16 (m, _mm_xor_si128 (bias,
+            _mm_loadu_si128 ((const __m128i *) (sad + j))));
+  _mm_storeu_si128 ((__m128i *) lanes, m);
+  for (j = 0; j < 8; j++)
+    min = MIN (min, lanes[j]);
+
+  return (guint16) min ^ 0x8000;
+#elif defined(VVAS_XSTEREO_BM_NEON)
+  uint16x8_t m = vdupq_n_u16 (G_MAXUINT16);
+
+  for (j = 0; j < nd; j += 8)
+    m = vminq_u16 (m, vld1q_u16 (sad + j));
+
+  return vminvq_u16 (m);
+#else
+  guint16 min = G_MAXUINT16;
+
+  for (j = 0; j < nd; j++)
+    min = MIN (min, sad[j]);
+
+  return min;
+#endif
+}
+
+/**
+ *  @fn static guint vvas_xstereo_bm_count_le (const guint16 * sad, guint nd,
+ *                                             guint16 thresh)
+ *  @param [in] sad - Window SADs
+ *  @param [in] nd - Number of disparities
+ *  @param [in] thresh - Threshold
+ *  @return Number of SADs lower than or equal to \p thresh
+ */
+static inline guint
+vvas_xstereo_bm_count_le (const guint16 * sad, guint nd, guint16 thresh)
+{
+  guint j, count = 0;
+#if defined(VVAS_XSTEREO_BM_SSE2)
+  const __m128i t = _mm_set1_epi16 (thresh);
+  const __m128i zero = _mm_setzero_si128 ();
+
+  /* sad <= thresh when the saturated difference is 0 */
+  for (j = 0; j < nd; j += 8) {
+    __m128i s = _mm_loadu_si128 ((const __m128i *) (sad + j));
+
+    count += __builtin_popcount (_mm_movemask_epi8 (_mm_cmpeq_epi16 (zero,
+                _mm_subs_epu16 (s, t))));
+  }
+
+  return count / 2;
+#elif defined(VVAS_XSTEREO_BM_NEON)
+  const uint16x8_t t = vdupq_n_u16 (thresh);
+
+  for (j = 0; j < nd; j += 8)
+    count += vaddvq_u16 (vshrq_n_u16 (vcleq_u16 (vld1q_u16 (sad + j), t),
+            15));
+
+  return count;
+#else
+  for (j = 0; j < nd; j++)
+    count += sad[j] <= thresh;
+
+  return count;
+#endif
+}
+
+/**
+ *  @fn static gint16 vvas_xstereo_bm_select (const VvasXStereoBMParams * params,
+ *                                            const guint16 * sad)
+ *  @param [in] params - Parameters
+ *  @param [in] sad - Window SADs, entry j for disparity nd - 1 - j
+ *  @return Disparity with VVAS_XSTEREO_BM_DISP_SHIFT fraction bits, or
+ *          VVAS_XSTEREO_BM_FILTERED when another disparity than the
+ *          neighbours of the best one is within the uniqueness ratio
+ */
+static inline gint16
+vvas_xstereo_bm_select (const VvasXStereoBMParams * params,
+    const guint16 * sad)
+{
+  const guint nd = params->num_disparities;
+  guint16 min = vvas_xstereo_bm_min (sad, nd);
+  guint d, k, close;
+  gint p, n, num, den, val;
+
+  /* Lowest disparity on ties, as OpenCV */
+  for (d = 0; sad[nd - 1 - d] != min; d++);
+
+  if (params->uniqueness_ratio) {
+    guint thresh = MIN (min + min * params->uniqueness_ratio / 100,
+        G_MAXUINT16);
+
+    close = vvas_xstereo_bm_count_le (sad, nd, thresh);
+    for (k = d ? d - 1 : d; k <= d + 1 && k < nd; k++)
+      close -= sad[nd - 1 - k] <= thresh;
+    if (close)
+      return VVAS_XSTEREO_BM_FILTERED;
+  }
+
+  p = sad[nd - 1 - (d ? d - 1 : d + 1)];
+  n = sad[nd - 1 - (d + 1 < nd ? d + 1 : d - 1)];
+  den = p + n - 2 * min + ABS (p - n);
+  num = (p - n) * 256;
+  val = d * 256 + (den ? num / den : 0) + 15;
+
+  return MAX (val, 0) >> (8 - VVAS_XSTEREO_BM_DISP_SHIFT);
+}
+
+/**
+ *  @fn void vvas_xstereo_bm_match (const VvasXStereoBMParams * params,
+ *                                  const guint8 * left, const guint8 * right,
+ *                                  guint width, guint height, gint16 * disp,
+ *                                  guint first_line, guint num_lines,
+ *                                  gpointer scratch)
+ *  @param [in] params - Valid parameters
+ *  @param [in] left - Prefiltered left frame, \p width bytes per line
+ *  @param [in] right - Prefiltered right frame, \p width bytes per line
+ *  @param [in] width - Frame width
+ *  @param [in] height - Frame height
+ *  @param [out] disp - Disparity of the left frame, \p width entries per
+ *                      line, VVAS_XSTEREO_BM_FILTERED without a reliable
+ *                      match
+ *  @param [in] first_line - First line to compute
+ *  @param [in] num_lines - Number of lines to compute
+ *  @param [in] scratch - vvas_xstereo_bm_scratch_size() bytes
+ *  @return None
+ *  @brief  Reads the prefiltered lines within half a window of the computed
+ *          ones, bands of lines can be computed on different threads with a
+ *          scratch each
+ */
+void
+vvas_xstereo_bm_match (const VvasXStereoBMParams * params,
+    const guint8 * left, const guint8 * right, guint width, guint height,
+    gint16 * disp, guint first_line, guint num_lines, gpointer scratch)
+{
+  const guint nd = params->num_disparities;
+  const guint r = params->sad_window / 2;
+  const guint8 cap = params->prefilter_cap;
+  const guint x_first = nd - 1 + r;
+  guint16 *col = (guint16 *) scratch;
+  guint16 *tex = col + (gsize) width * nd;
+  guint16 *sad = tex + width;
+  gboolean have_columns = FALSE;
+  guint x, y, i, j;
+
+  for (y = first_line; y < first_line + num_lines; y++) {
+    gint16 *out = disp + (gsize) y * width;
+    guint16 texture;
+
+    for (x = 0; x < width; x++)
+      out[x] = VVAS_XSTEREO_BM_FILTERED;
+    if (y < r || y + r >= height)
+      continue;
+
+    if (!have_columns) {
+      memset (col, 0, (gsize) width * nd * sizeof (guint16));
+      memset (tex, 0, width * sizeof (guint16));
+      for (i = y - r; i <= y + r; i++)
+        vvas_xstereo_bm_column_line (col, tex, left + (gsize) i * width,
+            right + (gsize) i * width, width, nd, cap, TRUE);
+      have_columns = TRUE;
+    } else {
+      vvas_xstereo_bm_column_line (col, tex,
+          left + (gsize) (y + r) * width, right + (gsize) (y + r) * width,
+          width, nd, cap, TRUE);
+      vvas_xstereo_bm_column_line (col, tex,
+          left + (gsize) (y - r - 1) * width,
+          right + (gsize) (y - r - 1) * width, width, nd, cap, FALSE);
+    }
+
+    memset (sad, 0, nd * sizeof (guint16));
+    texture = 0;
+    for (x = nd - 1; x <= x_first + r; x++) {
+      const guint16 *c = col + (gsize) x * nd;
+
+      texture += tex[x];
+      for (j = 0; j < nd; j++)
+        sad[j] += c[j];
+    }
+
+    for (x = x_first; x + r < width; x++) {
+      if (x > x_first) {
+        texture += tex[x + r] - tex[x - r - 1];
+        vvas_xstereo_bm_slide (sad, col + (gsize) (x + r) * nd,
+            col + (gsize) (x - r - 1) * nd, nd);
+      }
+
+      if (texture >= params->texture_threshold)
+        out[x] = vvas_xstereo_bm_select (params, sad);
+    }
+  }
+}
+
+/**
+ *  @fn gint vvas_xstereo_bm_median (const gint16 * disp, guint width,
+ *                                   guint height, gint x, gint y, guint w,
+ *                                   guint h, guint num_disparities,
+ *                                   guint32 * hist, guint * num_valid)
+ *  @param [in] disp - Disparity map
+ *  @param [in] width - Frame width
+ *  @param [in] height - Frame height
+ *  @param [in] x - Left column of the region
+ *  @param [in] y - Top line of the region
+ *  @param [in] w - Region width
+ *  @param [in] h - Region height
+ *  @param [in] num_disparities - Disparities the map was computed with
+ *  @param [in] hist - num_disparities << VVAS_XSTEREO_BM_DISP_SHIFT entries
+ *  @param [out] num_valid - Pixels of the region with a disparity
+ *  @return Median disparity of the region with VVAS_XSTEREO_BM_DISP_SHIFT
+ *          fraction bits, VVAS_XSTEREO_BM_FILTERED if no pixel has one
+ *  @brief  Region is clipped to the frame. Filtered pixels, i.e. textureless
+ *          or ambiguous ones, are left out.
+ */
+gint
+vvas_xstereo_bm_median (const gint16 * disp, guint width, guint height,
+    gint x, gint y, guint w, guint h, guint num_disparities, guint32 * hist,
+    guint * num_valid)
+{
+  const guint bins = num_disparities << VVAS_XSTEREO_BM_DISP_SHIFT;
+  gint x0 = CLAMP (x, 0, (gint) width);
+  gint y0 = CLAMP (y, 0, (gint) height);
+  gint x1 = CLAMP ((gint64) x + w, 0, (gint) width);
+  gint y1 = CLAMP ((gint64) y + h, 0, (gint) height);
+  guint count = 0, seen = 0, b;
+  gint i, j;
+
+  memset (hist, 0, bins * sizeof (guint32));
+  for (j = y0; j < y1; j++) {
+    const gint16 *line = disp + (gsize) j * width;
+
+    for (i = x0; i < x1; i++) {
+      if (line[i] >= 0 && (guint) line[i] < bins) {
+        hist[line[i]]++;
+        count++;
+      }
+    }
+  }
+
+  *num_valid = count;
+  if (!count)
+    return VVAS_XSTEREO_BM_FILTERED;
+
+  for (b = 0; b < bins; b++) {
+    seen += hist[b];
+    if (seen > (count - 1) / 2)
+      break;
+  }
+
+  return b;
+}
+
+/**
+ *  @fn const gchar * vvas_xstereo_bm_impl (void)
+ *  @return Name of the SAD kernels implementation
+ */
+const gchar *
+vvas_xstereo_bm_impl (void)
+{
+#if defined(VVAS_XSTEREO_BM_SSE2)
+  return "sse2";
+#elif defined(VVAS_XSTEREO_BM_NEON)
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __VVAS_XSTEREO_BM_H__
+#define __VVAS_XSTEREO_BM_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/** @def VVAS_XSTEREO_BM_DISP_SHIFT
+ *  @brief Fraction bits of disparities, 4 as in hls::FindStereoCorrespondenceBM
+ */
+#define VVAS_XSTEREO_BM_DISP_SHIFT 4
+/** @def VVAS_XSTEREO_BM_FILTERED
+ *  @brief Disparity of pixels without a reliable match
+ */
+#define VVAS_XSTEREO_BM_FILTERED (-(1 << VVAS_XSTEREO_BM_DISP_SHIFT))
+/** @def VVAS_XSTEREO_BM_DISP_UNIT
+ *  @brief Number of disparities must be a multiple of this
+ */
+#define VVAS_XSTEREO_BM_DISP_UNIT 16
+/** @def VVAS_XSTEREO_BM_MIN_WINDOW
+ *  @brief Smallest SAD window
+ */
+#define VVAS_XSTEREO_BM_MIN_WINDOW 5
+/** @def VVAS_XSTEREO_BM_MAX_WINDOW
+ *  @brief Largest SAD window, HLS_STEREO_BM_MAX_WIN_SIZE
+ */
+#define VVAS_XSTEREO_BM_MAX_WINDOW 21
+/** @def VVAS_XSTEREO_BM_MAX_DISPARITIES
+ *  @brief Largest number of disparities
+ */
+#define VVAS_XSTEREO_BM_MAX_DISPARITIES 256
+/** @def VVAS_XSTEREO_BM_MAX_CAP
+ *  @brief Largest prefilter cap
+ */
+#define VVAS_XSTEREO_BM_MAX_CAP 63
+
+/**
+ *  @brief Block matching parameters, the ones of hls::StereoBMState
+ */
+typedef struct
+{
+  /** Odd SAD window size, VVAS_XSTEREO_BM_MIN_WINDOW to
+   *  VVAS_XSTEREO_BM_MAX_WINDOW */
+  guint sad_window;
+  /** Disparities searched, 0 to num_disparities - 1, a multiple of
+   *  VVAS_XSTEREO_BM_DISP_UNIT */
+  guint num_disparities;
+  /** Sobel responses are clipped to [-cap, cap], 1 to
+   *  VVAS_XSTEREO_BM_MAX_CAP */
+  guint prefilter_cap;
+  /** Windows whose texture, sum of |response|, is lower are filtered */
+  guint texture_threshold;
+  /** Matches not better by this percentage than any other disparity but
+   *  their neighbours are filtered, 0 disables the check */
+  guint uniqueness_ratio;
+} VvasXStereoBMParams;
+
+void vvas_xstereo_bm_params_init (VvasXStereoBMParams * params);
+gboolean vvas_xstereo_bm_params_valid (const VvasXStereoBMParams * params,
+    guint width, guint height);
+
+void vvas_xstereo_bm_prefilter (const guint8 * src, guint stride, guint width,
+    guint height, guint cap, guint8 * dst, guint first_line, guint num_lines);
+
+gsize vvas_xstereo_bm_scratch_size (const VvasXStereoBMParams * params,
+    guint width);
+void vvas_xstereo_bm_match (const VvasXStereoBMParams * params,
+    const guint8 * left, const guint8 * right, guint width, guint height,
+    gint16 * disp, guint first_line, guint num_lines, gpointer scratch);
+
+gint vvas_xstereo_bm_median (const gint16 * disp, guint width, guint height,
+    gint x, gint y, guint w, guint h, guint num_disparities, guint32 * hist,
+    guint * num_valid);
+
+const gchar *vvas_xstereo_bm_impl (void);
+
+G_END_DECLS
+
+#endif /* __VVAS_XSTEREO_BM_H__ */
@@ -0,0 +1,504 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* GstVvasTracer
+ * The vvas tracer aggregates values VVAS elements and libraries report
+ * through the gst/vvas/gstvvastrace.h hooks and logs them periodically as
+ * "vvas-stats" tracer records.
+ *
+ * GST_TRACERS="vvas(interval=1000)" GST_DEBUG=GST_TRACER:7 gst-launch-1.0 ...
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/vvas/gstvvastrace.h>
+#include "gstvvastracer.h"
+
+/** @def DEFAULT_INTERVAL
+ *  @brief Default time between two records in milliseconds
+ */
+#define DEFAULT_INTERVAL 1000
+
+GST_DEBUG_CATEGORY_STATIC (gst_vvas_tracer_debug);
+#define GST_CAT_DEFAULT gst_vvas_tracer_debug
+
+/** @struct GstVvasTracerPointStats
+ *  @brief  Values of one measurement point aggregated over an interval
+ */
+typedef struct
+{
+  /** Number of values reported */
+  guint64 count;
+  /** Sum of values */
+  guint64 total;
+  /** Smallest value */
+  guint64 min;
+  /** Largest value */
+  guint64 max;
+  /** Latest value */
+  guint64 last;
+  /** Time the latest value was reported */
+  GstClockTime last_time;
+} GstVvasTracerPointStats;
+
+/** @struct GstVvasTracerObjStats
+ *  @brief  Aggregated values of all measurement points of one object
+ */
+typedef struct
+{
+  /** Name of the object, pads are named as element:pad */
+  gchar *name;
+  /** Statistics indexed by GstVvasTracePoint */
+  GstVvasTracerPointStats points[GST_VVAS_TRACE_NUM_POINTS];
+} GstVvasTracerObjStats;
+
+/** @struct GstVvasTracerThreadStats
+ *  @brief  Values reported by one streaming thread. Only the owning thread
+ *          and flushes take the lock, so threads never contend with each
+ *          other while reporting values.
+ */
+typedef struct
+{
+  /** Held by the owning thread and by the tracer, accessed atomically */
+  gint refcount;
+  /** Serial of the tracer instance this belongs to */
+  gint serial;
+  /** Protects stats */
+  GMutex lock;
+  /** GstVvasTracerObjStats of reporting objects, keyed by object */
+  GHashTable *stats;
+} GstVvasTracerThreadStats;
+
+static void gst_vvas_tracer_thread_stats_unref (gpointer data);
+
+/** Statistics of the calling thread */
+static GPrivate thread_stats =
+G_PRIVATE_INIT (gst_vvas_tracer_thread_stats_unref);
+
+/** Last serial given to a tracer instance */
+static gint tracer_serial = 0;
+
+/** Record logged per object and measurement point at every interval */
+static GstTracerRecord *tr_stats;
+
+#define gst_vvas_tracer_parent_class parent_class
+G_DEFINE_TYPE (GstVvasTracer, gst_vvas_tracer, GST_TYPE_TRACER);
+
+/**
+ *  @fn static void gst_vvas_tracer_obj_stats_free (gpointer data)
+ *  @param [in] data - GstVvasTracerObjStats to be freed
+ *  @return None
+ *  @brief  Frees statistics of one object
+ */
+static void
+gst_vvas_tracer_obj_stats_free (gpointer data)
+{
+  GstVvasTracerObjStats *obj_stats = (GstVvasTracerObjStats *) data;
+
+  g_free (obj_stats->name);
+  g_slice_free (GstVvasTracerObjStats, obj_stats);
+}
+
+/**
+ *  @fn static void gst_vvas_tracer_thread_stats_unref (gpointer data)
+ *  @param [in] data - GstVvasTracerThreadStats to be released
+ *  @return None
+ *  @brief  Drops a reference to statistics of one thread and frees them
+ *          once neither the thread nor the tracer holds them anymore
+ */
+static void
+gst_vvas_tracer_thread_stats_unref (gpointer data)
+{
+  GstVvasTracerThreadStats *ts = (GstVvasTracerThreadStats *) data;
+
+  if (!g_atomic_int_dec_and_test (&ts->refcount))
+    return;
+
+  g_hash_table_destroy (ts->stats);
+  g_mutex_clear (&ts->lock);
+  g_slice_free (GstVvasTracerThreadStats, ts);
+}
+
+/**
+ *  @fn static GstVvasTracerThreadStats * gst_vvas_tracer_thread_stats_new (GstVvasTracer * self)
+ *  @param [in] self - Handle to GstVvasTracer instance
+ *  @return Statistics of the calling thread
+ *  @brief  Creates statistics of the calling thread and registers them with
+ *          the tracer, so they are logged by whichever thread flushes
+ */
+static GstVvasTracerThreadStats *
+gst_vvas_tracer_thread_stats_new (GstVvasTracer * self)
+{
+  GstVvasTracerThreadStats *ts = g_slice_new0 (GstVvasTracerThreadStats);
+
+  ts->refcount = 2;
+  ts->serial = self->serial;
+  g_mutex_init (&ts->lock);
+  ts->stats = g_hash_table_new_full (NULL, NULL, NULL,
+      gst_vvas_tracer_obj_stats_free);
+
+  g_mutex_lock (&self->lock);
+  g_ptr_array_add (self->threads, ts);
+  g_mutex_unlock (&self->lock);
+
+  /* drops the reference to statistics of a previous tracer instance */
+  g_private_replace (&thread_stats, ts);
+
+  return ts;
+}
+
+/**
+ *  @fn static void gst_vvas_tracer_merge (GstVvasTracerObjStats * dst, const GstVvasTracerObjStats * src)
+ *  @param [in, out] dst - Statistics to update
+ *  @param [in] src - Statistics of the same object reported by another thread
+ *  @return None
+ *  @brief  Adds values another thread reported for the same object
+ */
+static void
+gst_vvas_tracer_merge (GstVvasTracerObjStats * dst,
+    const GstVvasTracerObjStats * src)
+{
+  guint i;
+
+  for (i = 0; i < GST_VVAS_TRACE_NUM_POINTS; i++) {
+    GstVvasTracerPointStats *d = &dst->points[i];
+    const GstVvasTracerPointStats *s = &src->points[i];
+
+    if (!s->count)
+      continue;
+
+    if (!d->count || s->min < d->min)
+      d->min = s->min;
+    if (s->max > d->max)
+      d->max = s->max;
+    if (!d->count || s->last_time >= d->last_time) {
+      d->last = s->last;
+      d->last_time = s->last_time;
+    }
+    d->total += s->total;
+    d->count += s->count;
+  }
+}
+
+/**
+ *  @fn static void gst_vvas_tracer_flush (GstVvasTracer * self)
+ *  @param [in] self - Handle to GstVvasTracer instance
+ *  @return None
+ *  @brief  Logs one record per object and measurement point which received
+ *          values since the last flush and starts a new interval
+ *  @note   Must be called with self->lock held
+ */
+static void
+gst_vvas_tracer_flush (GstVvasTracer * self)
+{
+  GHashTable *merged;
+  GHashTableIter iter;
+  gpointer key, value;
+  guint i;
+
+  merged = g_hash_table_new_full (NULL, NULL, NULL,
+      gst_vvas_tracer_obj_stats_free);
+
+  for (i = self->threads->len; i > 0; i--) {
+    GstVvasTracerThreadStats *ts = g_ptr_array_index (self->threads, i - 1);
+
+    g_mutex_lock (&ts->lock);
+    g_hash_table_iter_init (&iter, ts->stats);
+    while (g_hash_table_iter_next (&iter, &key, &value)) {
+      GstVvasTracerObjStats *dst = g_hash_table_lookup (merged, key);
+
+      if (dst) {
+        gst_vvas_tracer_merge (dst, value);
+        g_hash_table_iter_remove (&iter);
+      } else {
+        g_hash_table_iter_steal (&iter);
+        g_hash_table_insert (merged, key, value);
+      }
+    }
+    g_mutex_unlock (&ts->lock);
+
+    /* only the tracer still holds statistics of threads which exited */
+    if (g_atomic_int_get (&ts->refcount) == 1)
+      g_ptr_array_remove_index_fast (self->threads, i - 1);
+  }
+
+  g_hash_table_iter_init (&iter, merged);
+  while (g_hash_table_iter_next (&iter, NULL, &value)) {
+    GstVvasTracerObjStats *obj_stats = (GstVvasTracerObjStats *) value;
+
+    for (i = 0; i < GST_VVAS_TRACE_NUM_POINTS; i++) {
+      GstVvasTracerPointStats *ps = &obj_stats->points[i];
+
+      if (!ps->count)
+        continue;
+
+      gst_tracer_record_log (tr_stats, obj_stats->name,
+          gst_vvas_trace_point_get_name (i), ps->count, ps->total, ps->min,
+          ps->max, ps->total / ps->count, ps->last);
+    }
+  }
+
+  /* objects are looked up by address, dropping them every interval keeps
+   * names valid when an address gets reused by a new object */
+  g_hash_table_destroy (merged);
+}
+
+/**
+ *  @fn static void gst_vvas_tracer_hook (GstObject * object, GstVvasTracePoint point,
+ *                                        guint64 value, gpointer user_data)
+ *  @param [in] object - Object reporting the value
+ *  @param [in] point - Measurement point
+ *  @param [in] value - Measured value
+ *  @param [in] user_data - Handle to GstVvasTracer instance
+ *  @return None
+ *  @brief  Aggregates a reported value in statistics of the calling thread
+ *          and logs records when an interval has elapsed
+ */
+static void
+gst_vvas_tracer_hook (GstObject * object, GstVvasTracePoint point,
+    guint64 value, gpointer user_data)
+{
+  GstVvasTracer *self = GST_VVAS_TRACER (user_data);
+  GstVvasTracerThreadStats *ts;
+  GstVvasTracerObjStats *obj_stats;
+  GstVvasTracerPointStats *ps;
+  GstClockTime now = gst_util_get_timestamp ();
+  gint flushed, elapsed;
+
+  if (point >= GST_VVAS_TRACE_NUM_POINTS)
+    return;
+
+  ts = g_private_get (&thread_stats);
+  if (G_UNLIKELY (!ts || ts->serial != self->serial))
+    ts = gst_vvas_tracer_thread_stats_new (self);
+
+  g_mutex_lock (&ts->lock);
+
+  obj_stats = g_hash_table_lookup (ts->stats, object);
+  if (!obj_stats) {
+    obj_stats = g_slice_new0 (GstVvasTracerObjStats);
+    if (GST_IS_PAD (object))
+      obj_stats->name = g_strdup_printf ("%s:%s",
+          GST_DEBUG_PAD_NAME (GST_PAD_CAST (object)));
+    else
+      obj_stats->name = g_strdup (GST_STR_NULL (GST_OBJECT_NAME (object)));
+    g_hash_table_insert (ts->stats, object, obj_stats);
+  }
+
+  ps = &obj_stats->points[point];
+  if (!ps->count || value < ps->min)
+    ps->min = value;
+  if (value > ps->max)
+    ps->max = value;
+  ps->total += value;
+  ps->last = value;
+  ps->last_time = now;
+  ps->count++;
+
+  g_mutex_unlock (&ts->lock);
+
+  if (now <= self->start)
+    return;
+
+  /* only the thread moving the interval count forward logs records */
+  elapsed = (now - self->start) / self->interval;
+  flushed = g_atomic_int_get (&self->flushed);
+  if (elapsed > flushed
+      && g_atomic_int_compare_and_exchange (&self->flushed, flushed, elapsed)) {
+    g_mutex_lock (&self->lock);
+    gst_vvas_tracer_flush (self);
+    g_mutex_unlock (&self->lock);
+  }
+}
+
+/**
+ *  @fn static void gst_vvas_tracer_parse_params (GstVvasTracer * self)
+ *  @param [in] self - Handle to GstVvasTracer instance
+ *  @return None
+ *  @brief  Reads tracer parameters given as vvas(interval=<ms>)
+ */
+static void
+gst_vvas_tracer_parse_params (GstVvasTracer * self)
+{
+  GstStructure *params_struct = NULL;
+  gchar *params, *tmp;
+  guint interval = DEFAULT_INTERVAL;
+
+  g_object_get (self, "params", &params, NULL);
+  if (!params)
+    goto done;
+
+  tmp = g_strdup_printf ("vvas,%s", params);
+  params_struct = gst_structure_from_string (tmp, NULL);
+  g_free (tmp);
+
+  if (!params_struct) {
+    GST_WARNING_OBJECT (self, "failed to parse params '%s'", params);
+  } else if (gst_structure_has_field (params_struct, "interval")
+      && !gst_structure_get_uint (params_struct, "interval", &interval)) {
+    gint val;
+
+    /* "interval=500" is parsed as int */
+    if (gst_structure_get_int (params_struct, "interval", &val) && val > 0)
+      interval = val;
+    else
+      GST_WARNING_OBJECT (self, "invalid interval, using %u ms",
+          DEFAULT_INTERVAL);
+  }
+
+  if (params_struct)
+    gst_structure_free (params_struct);
+  g_free (params);
+
+done:
+  if (!interval)
+    interval = DEFAULT_INTERVAL;
+  self->interval = interval * GST_MSECOND;
+  GST_INFO_OBJECT (self, "logging records every %u ms", interval);
+}
+
+/**
+ *  @fn static void gst_vvas_tracer_constructed (GObject * object)
+ *  @param [in] object - Handle to GstVvasTracer instance
+ *  @return None
+ *  @brief  Parses parameters and starts receiving values from VVAS hooks
+ */
+static void
+gst_vvas_tracer_constructed (GObject * object)
+{
+  GstVvasTracer *self = GST_VVAS_TRACER (object);
+
+  gst_vvas_tracer_parse_params (self);
+  self->start = gst_util_get_timestamp ();
+
+  self->registered = gst_vvas_trace_set_func (gst_vvas_tracer_hook, self);
+  if (!self->registered)
+    GST_WARNING_OBJECT (self, "another vvas tracer is already active");
+
+  G_OBJECT_CLASS (parent_class)->constructed (object);
+}
+
+/**
+ *  @fn static void gst_vvas_tracer_finalize (GObject * object)
+ *  @param [in] object - Handle to GstVvasTracer instance
+ *  @return None
+ *  @brief  Stops receiving values and logs statistics of the last interval
+ */
+static void
+gst_vvas_tracer_finalize (GObject * object)
+{
+  GstVvasTracer *self = GST_VVAS_TRACER (object);
+
+  /* waits for streaming threads still running the hook */
+  if (self->registered)
+    gst_vvas_trace_set_func (NULL, NULL);
+
+  g_mutex_lock (&self->lock);
+  gst_vvas_tracer_flush (self);
+  g_mutex_unlock (&self->lock);
+
+  g_ptr_array_unref (self->threads);
+  g_mutex_clear (&self->lock);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ *  @fn static void gst_vvas_tracer_class_init (GstVvasTracerClass * klass)
+ *  @param [in] klass - Handle to GstVvasTracerClass
+ *  @return None
+ *  @brief  Registers the tracer record format
+ */
+static void
+gst_vvas_tracer_class_init (GstVvasTracerClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->constructed = gst_vvas_tracer_constructed;
+  gobject_class->finalize = gst_vvas_tracer_finalize;
+
+  tr_stats = gst_tracer_record_new ("vvas-stats.class",
+      "element", GST_TYPE_STRUCTURE, gst_structure_new ("scope",
+          "type", G_TYPE_GTYPE, G_TYPE_STRING,
+          "related-to", GST_TYPE_TRACER_VALUE_SCOPE,
+          GST_TRACER_VALUE_SCOPE_ELEMENT, NULL),
+      "point", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, G_TYPE_STRING,
+          "description", G_TYPE_STRING, "measurement point", NULL),
+      "count", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, G_TYPE_UINT64,
+          "description", G_TYPE_STRING, "number of values in interval", NULL),
+      "total", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, G_TYPE_UINT64,
+          "description", G_TYPE_STRING, "sum of values in interval", NULL),
+      "min", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, G_TYPE_UINT64,
+          "description", G_TYPE_STRING, "smallest value", NULL),
+      "max", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, G_TYPE_UINT64,
+          "description", G_TYPE_STRING, "largest value", NULL),
+      "avg", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, G_TYPE_UINT64,
+          "description", G_TYPE_STRING, "average value", NULL),
+      "last", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, G_TYPE_UINT64,
+          "description", G_TYPE_STRING, "latest value", NULL), NULL);
+  GST_OBJECT_FLAG_SET (tr_stats, GST_OBJECT_FLAG_MAY_BE_LEAKED);
+}
+
+/**
+ *  @fn static void gst_vvas_tracer_init (GstVvasTracer * self)
+ *  @param [in] self - Handle to GstVvasTracer instance
+ *  @return None
+ *  @brief  Initializes the tracer instance
+ */
+static void
+gst_vvas_tracer_init (GstVvasTracer * self)
+{
+  g_mutex_init (&self->lock);
+  self->threads =
+      g_ptr_array_new_with_free_func (gst_vvas_tracer_thread_stats_unref);
+  self->serial = g_atomic_int_add (&tracer_serial, 1) + 1;
+  self->interval = DEFAULT_INTERVAL * GST_MSECOND;
+}
+
+/**
+ *  @fn static gboolean vvas_tracers_plugin_init (GstPlugin * plugin)
+ *  @param [in] plugin - Handle to vvas_tracers plugin
+ *  @return TRUE if plugin initialized successfully
+ *  @brief  This is a callback function that will be called by the loader at startup to register the plugin
+ *  @note   It registers the tracer 'vvas' of type 'GST_TYPE_VVAS_TRACER'
+ */
+static gboolean
+vvas_tracers_plugin_init (GstPlugin * plugin)
+{
+  GST_DEBUG_CATEGORY_INIT (gst_vvas_tracer_debug, "vvastracer", 0,
+      "VVAS tracer");
+
+  return gst_tracer_register (plugin, "vvas", GST_TYPE_VVAS_TRACER);
+}
+
+/**
+ *  @brief This macro is used to define the entry point and meta data of a plugin.
+ *         This macro exports a plugin, so that it can be used by other applications
+ */
+GST_PLUGIN_DEFINE (GST_VERSION_MAJOR, GST_VERSION_MINOR, vvas_tracers,
+    "VVAS tracer logging accelerator timings, DMA transfers and queue depths",
+    vvas_tracers_plugin_init, VVAS_API_VERSION, "MIT/X11",
+    "Xilinx VVAS SDK plugin", "https://www.xilinx.com/")
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GST_VVAS_TRACER_H_
+#define _GST_VVAS_TRACER_H_
+
+#include <gst/gst.h>
+#include <gst/gsttracer.h>
+
+G_BEGIN_DECLS
+
+/** @def GST_TYPE_VVAS_TRACER
+ *  @brief Macro to get GstVvasTracer object type
+ */
+#define GST_TYPE_VVAS_TRACER (gst_vvas_tracer_get_type())
+
+G_DECLARE_FINAL_TYPE (GstVvasTracer, gst_vvas_tracer, GST, VVAS_TRACER,
+    GstTracer)
+
+typedef struct _GstVvasTracer GstVvasTracer;
+
+struct _GstVvasTracer
+{
+  /** parent of _GstVvasTracer object structure */
+  GstTracer parent;
+  /** Protects threads and serializes flushes */
+  GMutex lock;
+  /** Per thread statistics of all threads which reported values */
+  GPtrArray *threads;
+  /** Identifies per thread statistics created for this instance */
+  gint serial;
+  /** Whether this instance is the registered consumer of VVAS hooks */
+  gboolean registered;
+  /** Time between two records of the same object and point */
+  GstClockTime interval;
+  /** Time the tracer started receiving values */
+  GstClockTime start;
+  /** Number of intervals logged so far, accessed atomically */
+  gint flushed;
+};
+
+G_END_DECLS
+
+#endif /* _GST_VVAS_TRACER_H_ */
@@ -107,8 +107,20 @@ enum
   PROP_CONFIDENCE_SCORE_THRESHOLD,
   /** Flag to enable marking of inactive objects */
   PROP_SKIP_INACTIVE_OBJS,
+  /** Number of threads tracking sources in parallel */
+  PROP_NUM_WORKERS,
 };
 
+/** @def STOP_COMMAND
+ *  @brief Command to stop the worker threads.
+ */
+#define STOP_COMMAND ((gpointer)GINT_TO_POINTER (g_quark_from_string("STOP")))
+
+/** @def VVAS_XTRACKER_MAX_PENDING_PER_WORKER
+ *  @brief Buffers queued per worker before the streaming thread waits.
+ */
+#define VVAS_XTRACKER_MAX_PENDING_PER_WORKER 4
+
 /** @struct TrackerInstances
  *  @brief  Holds tracker instances
  */
@@ -116,6 +128,21 @@ struct TrackerInstances
 {
   /** pointer to base tracker */
   VvasTracker *vvasbase_tracker;
+  /** Boxes tracked in last frame, only kept at LOG level */
+  GArray *prev_boxes;
+};
+
+/** @struct TrackerWorker
+ *  @brief  Thread tracking and pushing buffers of the sources assigned to it
+ */
+struct TrackerWorker
+{
+  /** Back pointer to tracker element */
+  GstVvas_XTracker *self;
+  /** Worker thread */
+  GThread *thread;
+  /** Buffers to track in arrival order, or STOP_COMMAND */
+  GAsyncQueue *queue;
 };
 
 /** @struct _GstVvas_XTrackerPrivate
@@ -131,6 +158,21 @@ struct _GstVvas_XTrackerPrivate
   GHashTable *tracker_instances_hash;
   /** global context for vvas tracker */
   VvasContext *vvas_gctx;
+  /** Number of worker threads, 0 to track on streaming thread */
+  guint num_workers;
+  /** Worker threads, buffers of source src_id go to
+   *  workers[src_id % num_workers] */
+  struct TrackerWorker *workers;
+  /** Protects pending, worker_ret and flushing */
+  GMutex worker_lock;
+  /** Signalled when a worker completes a buffer */
+  GCond worker_cond;
+  /** Number of buffers queued to or being processed by workers */
+  guint pending;
+  /** First non-OK flow return of workers */
+  GstFlowReturn worker_ret;
+  /** Workers drop buffers instead of tracking them */
+  gboolean flushing;
 };
 
 /**
@@ -170,6 +212,11 @@ static void gst_vvas_xtracker_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 static GstFlowReturn gst_vvas_xtracker_transform_ip (GstBaseTransform * base,
     GstBuffer * outbuf);
+static GstFlowReturn gst_vvas_xtracker_generate_output (GstBaseTransform *
+    trans, GstBuffer ** outbuf);
+static void gst_vvas_xtracker_finalize (GObject * object);
+static GstFlowReturn vvas_xtracker_track (GstVvas_XTracker * self,
+    GstBuffer * buf);
 static gboolean gst_vvas_xtracker_sink_event (GstBaseTransform * trans,
     GstEvent * event);
 
@@ -434,6 +481,77 @@ gst_vvas_tracker_match_color_space (void)
  */
 #define GST_VVAS_TRACKER_SKIP_INACTIVE_OBJS_DEFAULT FALSE
 
+/** @def GST_VVAS_TRACKER_NUM_WORKERS_DEFAULT
+ *  @brief Default number of worker threads, sources are tracked on streaming
+ *         thread.
+ */
+#define GST_VVAS_TRACKER_NUM_WORKERS_DEFAULT 0
+
+/**
+ *  @fn static void vvas_xtracker_instance_free (gpointer data)
+ *  @param [in] data - TrackerInstances to free
+ *  @return None
+ *  @brief  Frees tracker instance entry of tracker_instances_hash. Tracker
+ *          itself is destroyed with vvas_tracker_destroy() before.
+ */
+static void
+vvas_xtracker_instance_free (gpointer data)
+{
+  struct TrackerInstances *instance = (struct TrackerInstances *) data;
+
+  if (instance->prev_boxes)
+    g_array_unref (instance->prev_boxes);
+  free (instance);
+}
+
+/**
+ *  @fn static gboolean vvas_xtracker_boxes_overlap (const VvasBoundingBox * a,
+ *                                                   const VvasBoundingBox * b)
+ *  @param [in] a - First box
+ *  @param [in] b - Second box
+ *  @return TRUE if the boxes have a common area
+ */
+static gboolean
+vvas_xtracker_boxes_overlap (const VvasBoundingBox * a,
+    const VvasBoundingBox * b)
+{
+  return a->x < b->x + (gint) b->width && b->x < a->x + (gint) a->width &&
+      a->y < b->y + (gint) b->height && b->y < a->y + (gint) a->height;
+}
+
+/**
+ *  @fn static void vvas_xtracker_log_associations (GstVvas_XTracker * self,
+ *                                                  GArray * prev, GArray * cur)
+ *  @param [in] self - Pointer to GstVvas_XTracker structure.
+ *  @param [in] prev - Boxes tracked in previous frame, may be NULL
+ *  @param [in] cur - Boxes tracked in current frame
+ *  @return None
+ *  @brief  Logs tracked objects which do not overlap any object tracked in
+ *          previous frame, a hint of lost or switched tracks
+ */
+static void
+vvas_xtracker_log_associations (GstVvas_XTracker * self, GArray * prev,
+    GArray * cur)
+{
+  guint det, idx, unmatched = 0;
+
+  if (!prev || !prev->len || !cur->len)
+    return;
+
+  for (det = 0; det < cur->len; det++) {
+    for (idx = 0; idx < prev->len; idx++) {
+      if (vvas_xtracker_boxes_overlap (&g_array_index (cur, VvasBoundingBox,
+                  det), &g_array_index (prev, VvasBoundingBox, idx)))
+        break;
+    }
+    if (idx == prev->len)
+      unmatched++;
+  }
+
+  GST_LOG_OBJECT (self, "%u of %u tracked objects do not overlap the %u of "
+      "previous frame", unmatched, cur->len, prev->len);
+}
+
 /**
  *  @fn gboolean vvas_xtracker_deinit (GstVvas_XTracker * self)
  *  @param [inout] self - Pointer to GstVvas_XTracker structure.
@@ -471,6 +589,161 @@ vvas_xtracker_deinit (GstVvas_XTracker * self)
   return iret;
 }
 
+/**
+ *  @fn static gpointer vvas_xtracker_worker_thread (gpointer data)
+ *  @param [in] data - Pointer to TrackerWorker of this thread
+ *  @return NULL when STOP_COMMAND is received
+ *  @brief  Tracks objects in buffers of the sources assigned to this worker
+ *          and pushes them downstream. All buffers of a source go through the
+ *          same worker, so they are tracked and pushed in their order.
+ */
+static gpointer
+vvas_xtracker_worker_thread (gpointer data)
+{
+  struct TrackerWorker *worker = (struct TrackerWorker *) data;
+  GstVvas_XTracker *self = worker->self;
+  GstVvas_XTrackerPrivate *priv = self->priv;
+  GstBaseTransform *trans = GST_BASE_TRANSFORM (self);
+
+  while (1) {
+    GstBuffer *buf;
+    GstFlowReturn fret;
+    gboolean flushing;
+
+    buf = (GstBuffer *) g_async_queue_pop (worker->queue);
+    if (buf == STOP_COMMAND) {
+      GST_DEBUG_OBJECT (self, "received stop command. exit worker thread");
+      break;
+    }
+
+    g_mutex_lock (&priv->worker_lock);
+    flushing = priv->flushing;
+    g_mutex_unlock (&priv->worker_lock);
+
+    if (flushing) {
+      gst_buffer_unref (buf);
+      fret = GST_FLOW_FLUSHING;
+    } else {
+      fret = vvas_xtracker_track (self, buf);
+      if (fret == GST_FLOW_OK) {
+        fret = gst_pad_push (trans->srcpad, buf);
+      } else {
+        GST_ELEMENT_ERROR (self, STREAM, FAILED, (NULL),
+            ("failed to track objects of buffer %p", buf));
+        gst_buffer_unref (buf);
+      }
+    }
+
+    g_mutex_lock (&priv->worker_lock);
+    if (fret != GST_FLOW_OK && priv->worker_ret == GST_FLOW_OK)
+      priv->worker_ret = fret;
+    priv->pending--;
+    g_cond_broadcast (&priv->worker_cond);
+    g_mutex_unlock (&priv->worker_lock);
+  }
+
+  return NULL;
+}
+
+/**
+ *  @fn static void vvas_xtracker_workers_drain (GstVvas_XTracker * self)
+ *  @param [in] self - Pointer to GstVvas_XTracker structure.
+ *  @return None
+ *  @brief  Waits until workers pushed or dropped all buffers queued to them
+ */
+static void
+vvas_xtracker_workers_drain (GstVvas_XTracker * self)
+{
+  GstVvas_XTrackerPrivate *priv = self->priv;
+
+  g_mutex_lock (&priv->worker_lock);
+  while (priv->pending)
+    g_cond_wait (&priv->worker_cond, &priv->worker_lock);
+  g_mutex_unlock (&priv->worker_lock);
+}
+
+/**
+ *  @fn static void vvas_xtracker_workers_set_flushing (GstVvas_XTracker * self, gboolean flushing)
+ *  @param [in] self - Pointer to GstVvas_XTracker structure.
+ *  @param [in] flushing - TRUE to drop queued buffers, FALSE to track them again
+ *  @return None
+ *  @brief  Starts or stops flushing of worker threads. Stopping flushing
+ *          also clears flow return of workers.
+ */
+static void
+vvas_xtracker_workers_set_flushing (GstVvas_XTracker * self, gboolean flushing)
+{
+  GstVvas_XTrackerPrivate *priv = self->priv;
+
+  g_mutex_lock (&priv->worker_lock);
+  priv->flushing = flushing;
+  if (!flushing)
+    priv->worker_ret = GST_FLOW_OK;
+  g_cond_broadcast (&priv->worker_cond);
+  g_mutex_unlock (&priv->worker_lock);
+}
+
+/**
+ *  @fn static void vvas_xtracker_workers_start (GstVvas_XTracker * self)
+ *  @param [in] self - Pointer to GstVvas_XTracker structure.
+ *  @return None
+ *  @brief  Creates num-workers worker threads
+ */
+static void
+vvas_xtracker_workers_start (GstVvas_XTracker * self)
+{
+  GstVvas_XTrackerPrivate *priv = self->priv;
+  guint idx;
+
+  priv->pending = 0;
+  priv->worker_ret = GST_FLOW_OK;
+  priv->flushing = FALSE;
+  priv->workers = g_new0 (struct TrackerWorker, priv->num_workers);
+
+  for (idx = 0; idx < priv->num_workers; idx++) {
+    struct TrackerWorker *worker = &priv->workers[idx];
+    gchar *thread_name = g_strdup_printf ("tracker-worker-%u", idx);
+
+    worker->self = self;
+    worker->queue = g_async_queue_new ();
+    worker->thread = g_thread_new (thread_name, vvas_xtracker_worker_thread,
+        worker);
+    g_free (thread_name);
+  }
+
+  GST_INFO_OBJECT (self, "tracking sources on %u worker threads",
+      priv->num_workers);
+}
+
+/**
+ *  @fn static void vvas_xtracker_workers_stop (GstVvas_XTracker * self)
+ *  @param [in] self - Pointer to GstVvas_XTracker structure.
+ *  @return None
+ *  @brief  Drops buffers still queued to workers and joins worker threads
+ */
+static void
+vvas_xtracker_workers_stop (GstVvas_XTracker * self)
+{
+  GstVvas_XTrackerPrivate *priv = self->priv;
+  guint idx;
+
+  if (!priv->workers)
+    return;
+
+  vvas_xtracker_workers_set_flushing (self, TRUE);
+  for (idx = 0; idx < priv->num_workers; idx++) {
+    struct TrackerWorker *worker = &priv->workers[idx];
+
+    g_async_queue_push (worker->queue, STOP_COMMAND);
+    g_thread_join (worker->thread);
+    g_async_queue_unref (worker->queue);
+  }
+
+  g_free (priv->workers);
+  priv->workers = NULL;
+  priv->pending = 0;
+}
+
 /**
  *  @fn gboolean gst_vvas_xtracker_start (GstBaseTransform * trans)
  *  @param [in] trans - Pointer to GstBaseTransform object.
@@ -500,11 +773,15 @@ gst_vvas_xtracker_start (GstBaseTransform * trans)
   /* create tracker instances hash map, if not available */
   if (!priv->tracker_instances_hash) {
     priv->tracker_instances_hash =
-        g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+        g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
+        vvas_xtracker_instance_free);
   }
 
   gst_base_transform_set_in_place (trans, true);
 
+  if (priv->num_workers)
+    vvas_xtracker_workers_start (self);
+
   return TRUE;
 }
 
@@ -525,6 +802,9 @@ gst_vvas_xtracker_stop (GstBaseTransform * trans)
   GstVvas_XTracker *self = GST_VVAS_XTRACKER (trans);
   GST_DEBUG_OBJECT (self, "stopping");
 
+  /* Workers may still use trackers and context */
+  vvas_xtracker_workers_stop (self);
+
   if (self->priv->vvas_gctx) {
     vvas_context_destroy (self->priv->vvas_gctx);
   }
@@ -556,10 +836,12 @@ gst_vvas_xtracker_class_init (GstVvas_XTrackerClass * klass)
 
   gobject_class->set_property = gst_vvas_xtracker_set_property;
   gobject_class->get_property = gst_vvas_xtracker_get_property;
+  gobject_class->finalize = gst_vvas_xtracker_finalize;
 
   transform_class->start = gst_vvas_xtracker_start;
   transform_class->stop = gst_vvas_xtracker_stop;
   transform_class->transform_ip = gst_vvas_xtracker_transform_ip;
+  transform_class->generate_output = gst_vvas_xtracker_generate_output;
   transform_class->sink_event = gst_vvas_xtracker_sink_event;
 
   /* Tracker algorithm */
@@ -749,6 +1031,17 @@ gst_vvas_xtracker_class_init (GstVvas_XTrackerClass * klass)
           "Flag to enable or disable marking of inactive objects. This marking of \
            inactive objects helps downstream plugins to process further or not", GST_VVAS_TRACKER_SKIP_INACTIVE_OBJS_DEFAULT, (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
+  /* Worker threads */
+  g_object_class_install_property (gobject_class, PROP_NUM_WORKERS,
+      g_param_spec_uint ("num-workers", "Number of worker threads",
+          "Number of threads tracking sources of muxed streams in parallel. "
+          "Buffers of a source are always tracked by the same worker and "
+          "pushed in their order, buffers of different sources may be "
+          "reordered. 0 tracks all sources on the streaming thread",
+          0, 64, GST_VVAS_TRACKER_NUM_WORKERS_DEFAULT,
+          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
   gst_element_class_set_details_simple (gstelement_class,
       "VVAS Tracker Plugin",
       "Object Tracking",
@@ -832,6 +1125,27 @@ gst_vvas_xtracker_init (GstVvas_XTracker * self)
   priv->tconfig.skip_inactive_objs =
       GST_VVAS_TRACKER_SKIP_INACTIVE_OBJS_DEFAULT;
   priv->tracker_instances_hash = NULL;
+  priv->num_workers = GST_VVAS_TRACKER_NUM_WORKERS_DEFAULT;
+  priv->workers = NULL;
+  g_mutex_init (&priv->worker_lock);
+  g_cond_init (&priv->worker_cond);
+}
+
+/**
+ *  @fn static void gst_vvas_xtracker_finalize (GObject * object)
+ *  @param [in] object - Handle to GstVvas_XTracker typecast to GObject
+ *  @return None
+ *  @brief  Frees resources of GstVvas_XTracker instance
+ */
+static void
+gst_vvas_xtracker_finalize (GObject * object)
+{
+  GstVvas_XTracker *self = GST_VVAS_XTRACKER (object);
+
+  g_mutex_clear (&self->priv->worker_lock);
+  g_cond_clear (&self->priv->worker_cond);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
 /**
@@ -944,6 +1258,9 @@ gst_vvas_xtracker_set_property (GObject * object, guint prop_id,
     case PROP_SKIP_INACTIVE_OBJS:
       priv->tconfig.skip_inactive_objs = g_value_get_boolean (value);
       break;
+    case PROP_NUM_WORKERS:
+      priv->num_workers = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1037,6 +1354,9 @@ gst_vvas_xtracker_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_SKIP_INACTIVE_OBJS:
       g_value_set_boolean (value, priv->tconfig.skip_inactive_objs);
       break;
+    case PROP_NUM_WORKERS:
+      g_value_set_uint (value, priv->num_workers);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1061,6 +1381,18 @@ gst_vvas_xtracker_sink_event (GstBaseTransform * trans, GstEvent * event)
   const GstStructure *structure = NULL;
   guint pad_idx;
 
+  if (priv->workers) {
+    if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_START) {
+      vvas_xtracker_workers_set_flushing (self, TRUE);
+    } else if (GST_EVENT_IS_SERIALIZED (event)) {
+      /* Buffers received before a serialized event are pushed before it and
+       * trackers are not created or destroyed while workers use them */
+      vvas_xtracker_workers_drain (self);
+      if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_STOP)
+        vvas_xtracker_workers_set_flushing (self, FALSE);
+    }
+  }
+
   switch (GST_EVENT_TYPE (event)) {
     case GST_EVENT_CAPS:
     {
@@ -1087,6 +1419,7 @@ gst_vvas_xtracker_sink_event (GstBaseTransform * trans, GstEvent * event)
       }
       instance =
           (struct TrackerInstances *) malloc (sizeof (struct TrackerInstances));
+      instance->prev_boxes = NULL;
 
       /* calling tracker initialization function */
       instance->vvasbase_tracker =
@@ -1144,20 +1477,17 @@ gst_vvas_xtracker_sink_event (GstBaseTransform * trans, GstEvent * event)
 }
 
 /**
- *  @fn gboolean gst_vvas_xtracker_transform_ip (GstBaseTransform * base, GstBuffer * buf)
- *  @param [inout] base - Pointer to GstBaseTransform object.
- *  @param [in] buf - Pointer to input buffer of type GstBuffer.
- *  @return TRUE on success \n
- *          FALSE on failure
- *  @brief  This API called every frame for inplace processing to updates the tracking objects info
- *  @details This API is registered with GObjectClass by overriding GstBaseTransform::transform_ip function pointer and
- *          this will be called for every frame for inplace processing. It prepares the input buffer
- *          for processing then invokes tracker. Upon processing updates prediction metadata with tracked objects.
+ *  @fn static GstFlowReturn vvas_xtracker_track (GstVvas_XTracker * self, GstBuffer * buf)
+ *  @param [in] self - Pointer to GstVvas_XTracker structure.
+ *  @param [in] buf - Writable buffer to track objects in
+ *  @return GST_FLOW_OK on success \n
+ *          GST_FLOW_ERROR on failure
+ *  @brief  Invokes tracker instance of source of \p buf and updates prediction
+ *          metadata with tracked objects.
  */
 static GstFlowReturn
-gst_vvas_xtracker_transform_ip (GstBaseTransform * base, GstBuffer * buf)
+vvas_xtracker_track (GstVvas_XTracker * self, GstBuffer * buf)
 {
-  GstVvas_XTracker *self = GST_VVAS_XTRACKER (base);
   VvasReturnType vvas_ret = VVAS_RET_ERROR;
   VvasVideoFrame *pFrame;
   GstInferenceMeta *infer_meta = NULL;
@@ -1220,6 +1550,12 @@ gst_vvas_xtracker_transform_ip (GstBaseTransform * base, GstBuffer * buf)
     GstInferencePrediction *new_gst_pred = NULL;
     VvasList *iter = NULL;
     VvasList *pred_nodes = NULL;
+    GArray *boxes = NULL;
+
+    /* Association itself happens in vvas-core tracker, boxes only feed the
+     * log of lost tracks */
+    if (gst_debug_category_get_threshold (GST_CAT_DEFAULT) >= GST_LEVEL_LOG)
+      boxes = g_array_new (FALSE, FALSE, sizeof (VvasBoundingBox));
 
     if (infer_meta == NULL) {
       infer_meta = (GstInferenceMeta *) gst_buffer_add_meta (buf,
@@ -1232,10 +1568,21 @@ gst_vvas_xtracker_transform_ip (GstBaseTransform * base, GstBuffer * buf)
     /** Convert all leaf nodes and append to root */
     for (iter = pred_nodes; iter != NULL; iter = iter->next) {
       VvasInferPrediction *leaf = (VvasInferPrediction *) iter->data;
+
+      if (boxes)
+        g_array_append_val (boxes, leaf->bbox);
+
       gst_inference_prediction_append (new_gst_pred,
           gst_infer_node_from_vvas_infer (leaf));
     }
     vvas_list_free (pred_nodes);
+
+    if (boxes)
+      vvas_xtracker_log_associations (self, instance->prev_boxes, boxes);
+    /* Never compare with a frame tracked before logging was enabled */
+    if (instance->prev_boxes)
+      g_array_unref (instance->prev_boxes);
+    instance->prev_boxes = boxes;
     if (infer_meta->prediction)
       gst_inference_prediction_unref (infer_meta->prediction);
     infer_meta->prediction = new_gst_pred;
@@ -1251,6 +1598,88 @@ gst_vvas_xtracker_transform_ip (GstBaseTransform * base, GstBuffer * buf)
   return GST_FLOW_OK;
 }
 
+/**
+ *  @fn gboolean gst_vvas_xtracker_transform_ip (GstBaseTransform * base, GstBuffer * buf)
+ *  @param [inout] base - Pointer to GstBaseTransform object.
+ *  @param [in] buf - Pointer to input buffer of type GstBuffer.
+ *  @return TRUE on success \n
+ *          FALSE on failure
+ *  @brief  This API called every frame for inplace processing to updates the tracking objects info
+ *  @details This API is registered with GObjectClass by overriding GstBaseTransform::transform_ip function pointer and
+ *          this will be called for every frame for inplace processing. It prepares the input buffer
+ *          for processing then invokes tracker. Upon processing updates prediction metadata with tracked objects.
+ */
+static GstFlowReturn
+gst_vvas_xtracker_transform_ip (GstBaseTransform * base, GstBuffer * buf)
+{
+  return vvas_xtracker_track (GST_VVAS_XTRACKER (base), buf);
+}
+
+/**
+ *  @fn static GstFlowReturn gst_vvas_xtracker_generate_output (GstBaseTransform * trans, GstBuffer ** outbuf)
+ *  @param [in] trans - Pointer to GstBaseTransform object.
+ *  @param [out] outbuf - Buffer to push, always NULL with worker threads
+ *  @return GST_FLOW_OK on success \n
+ *          Flow return of worker threads otherwise
+ *  @brief  Queues input buffer to worker thread of its source, which tracks
+ *          and pushes it. Without worker threads, buffer is tracked by
+ *          transform_ip on streaming thread.
+ *  @details This API is registered with GObjectClass by overriding GstBaseTransform::generate_output
+ *           function pointer and this will be called for every frame.
+ */
+static GstFlowReturn
+gst_vvas_xtracker_generate_output (GstBaseTransform * trans,
+    GstBuffer ** outbuf)
+{
+  GstVvas_XTracker *self = GST_VVAS_XTRACKER (trans);
+  GstVvas_XTrackerPrivate *priv = self->priv;
+  GstVvasSrcIDMeta *srcId_meta;
+  GstBuffer *inbuf;
+  GstFlowReturn fret;
+  guint src_id = 0;
+
+  if (!priv->workers)
+    return GST_BASE_TRANSFORM_CLASS (parent_class)->generate_output (trans,
+        outbuf);
+
+  *outbuf = NULL;
+  inbuf = trans->queued_buf;
+  trans->queued_buf = NULL;
+  if (inbuf == NULL)
+    return GST_FLOW_OK;
+
+  /* Worker updates inference metadata */
+  inbuf = gst_buffer_make_writable (inbuf);
+
+  srcId_meta = ((GstVvasSrcIDMeta *) gst_buffer_get_meta (inbuf,
+          gst_vvas_srcid_meta_api_get_type ()));
+  if (srcId_meta)
+    src_id = srcId_meta->src_id;
+
+  g_mutex_lock (&priv->worker_lock);
+  while (priv->pending >=
+      priv->num_workers * VVAS_XTRACKER_MAX_PENDING_PER_WORKER
+      && !priv->flushing && priv->worker_ret == GST_FLOW_OK)
+    g_cond_wait (&priv->worker_cond, &priv->worker_lock);
+  fret = priv->flushing ? GST_FLOW_FLUSHING : priv->worker_ret;
+  if (fret == GST_FLOW_OK)
+    priv->pending++;
+  g_mutex_unlock (&priv->worker_lock);
+
+  if (fret != GST_FLOW_OK) {
+    GST_DEBUG_OBJECT (self, "dropping buffer %p, workers returned %s", inbuf,
+        gst_flow_get_name (fret));
+    gst_buffer_unref (inbuf);
+    return fret;
+  }
+
+  GST_LOG_OBJECT (self, "queueing buffer %p of source %u to worker %u", inbuf,
+      src_id, src_id % priv->num_workers);
+  g_async_queue_push (priv->workers[src_id % priv->num_workers].queue, inbuf);
+
+  return GST_FLOW_OK;
+}
+
 /* entry point to initialize the plug-in
  * initialize the plug-in itself
  * register the element factories and other features
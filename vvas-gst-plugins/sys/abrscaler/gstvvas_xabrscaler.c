@@ -59,6 +59,7 @@
 #include <gst/vvas/gstinferencemeta.h>
 #include <gst/vvas/gstvvashdrmeta.h>
 #include <gst/vvas/gstvvasoverlaymeta.h>
+#include <gst/vvas/gstvvasframestatsmeta.h>
 #ifdef XLNX_PCIe_PLATFORM
 #include <experimental/xrt-next.h>
 #else
@@ -121,10 +122,18 @@
  *  @brief Default value for software-scaling property.
  */
 #define VVAS_XABRSCALER_ENABLE_SOFTWARE_SCALING_DEFAULT FALSE
+/** @def VVAS_XABRSCALER_FRAME_STATS_DEFAULT
+ *  @brief Default value for frame-stats property.
+ */
+#define VVAS_XABRSCALER_FRAME_STATS_DEFAULT FALSE
 /** @def STOP_COMMAND
- *  @brief Command to stop the input copy thread.
+ *  @brief Command to stop the input and output copy threads.
  */
 #define STOP_COMMAND ((gpointer)GINT_TO_POINTER (g_quark_from_string("STOP")))
+/** @def COPY_FAILED
+ *  @brief Returned by output copy thread when a buffer could not be copied.
+ */
+#define COPY_FAILED ((gpointer)GINT_TO_POINTER (g_quark_from_string("COPY_FAILED")))
 
 /** @def WIDTH_ALIGN
  *  @brief Alignment for width must be 8 * pixel per clock in case of embedded.
@@ -238,6 +247,10 @@ typedef enum
   PROP_CROP_HEIGHT,
   /** Software scaling */
   PROP_SOFTWARE_SCALING,
+  /** Memory transfer statistics */
+  PROP_MEM_STATS,
+  /** Attach luma statistics of the input frame */
+  PROP_FRAME_STATS,
 } VvasXAbrscalerProperties;
 
 /** @enum ColorDomain
@@ -296,6 +309,14 @@ struct _GstVvasXAbrScalerPad
   GstVideoInfo *in_vinfo;
   /** Video Info of output buffer */
   GstVideoInfo *out_vinfo;
+  /** Pool of system memory buffers, used when output has to be copied */
+  GstBufferPool *copy_pool;
+  /** Thread copying output buffers into copy_pool buffers */
+  GThread *copy_thread;
+  /** Queue to hold output buffers to be copied */
+  GAsyncQueue *copy_inqueue;
+  /** Queue to hold copied buffers ready to be pushed */
+  GAsyncQueue *copy_outqueue;
 };
 
 /** @struct _GstVvasXAbrScalerPadClass
@@ -408,7 +429,7 @@ static GstPad *gst_vvas_xabrscaler_request_new_pad (GstElement * element,
 static void gst_vvas_xabrscaler_release_pad (GstElement * element,
     GstPad * pad);
 
-static gboolean remove_infer_meta (GstBuffer * buffer, GstMeta ** meta,
+static gboolean copy_unscaled_meta (GstBuffer * buffer, GstMeta ** meta,
     gpointer user_data);
 
 /** @struct _GstVvasXAbrScalerPrivate
@@ -446,6 +467,8 @@ struct _GstVvasXAbrScalerPrivate
   VvasVideoFrame *input_frame[MAX_CHANNELS];
   /** Reference of output VvasVideoFrames */
   VvasVideoFrame *output_frame[MAX_CHANNELS];
+  /** DMA transfers and slow copies of input and output frames */
+  GstVvasMemStats mem_stats;
 #ifdef ENABLE_XRM_SUPPORT
   /** XRM Context handle */
   xrmContext xrm_ctx;
@@ -1342,11 +1365,13 @@ error:
 
 /** @fn gboolean vvas_xabrscaler_validate_buffer_import (GstVvasXAbrScaler * scaler,
  *                                                       GstBuffer * inbuf,
- *                                                       gboolean * use_inpool)
+ *                                                       gboolean * use_inpool,
+ *                                                       GstVvasCopyReason * reason)
  *
  *  @param [in] scaler - scaler context
  *  @param [in] inbuf - Input buffer
  *  @param [out] use_inpool - Set to true to use internal pool, false to use upstream pool
+ *  @param [out] reason - Why internal pool is needed, valid when \p use_inpool is TRUE
  *
  *  @return On Success returns true
  *          On Failure returns false
@@ -1355,7 +1380,7 @@ error:
 */
 static gboolean
 vvas_xabrscaler_validate_buffer_import (GstVvasXAbrScaler * self,
-    GstBuffer * inbuf, gboolean * use_inpool)
+    GstBuffer * inbuf, gboolean * use_inpool, GstVvasCopyReason * reason)
 {
   gboolean bret = TRUE;
   GstMemory *in_mem = NULL;
@@ -1375,6 +1400,7 @@ vvas_xabrscaler_validate_buffer_import (GstVvasXAbrScaler * self,
             self->in_mem_bank)) {
       /* VVAS memory, but can't avoid copy, so use internal pool */
       *use_inpool = TRUE;
+      *reason = GST_VVAS_COPY_REASON_BANK_MISMATCH;
       goto exit;
     }
   } else if (gst_is_dmabuf_memory (in_mem)) {
@@ -1382,6 +1408,7 @@ vvas_xabrscaler_validate_buffer_import (GstVvasXAbrScaler * self,
     /* In case of PCIe, there are issues in DMA buffer import BO
      * Hence copy the data into vvas buffer */
     *use_inpool = TRUE;
+    *reason = GST_VVAS_COPY_REASON_FOREIGN_MEMORY;
     goto exit;
 #else
     /* Embedded Platform */
@@ -1405,6 +1432,7 @@ vvas_xabrscaler_validate_buffer_import (GstVvasXAbrScaler * self,
       GST_WARNING_OBJECT (self,
           "failed to get XRT BO...fall back to copy input");
       *use_inpool = TRUE;
+      *reason = GST_VVAS_COPY_REASON_FOREIGN_MEMORY;
       goto exit;
     }
 
@@ -1414,6 +1442,7 @@ vvas_xabrscaler_validate_buffer_import (GstVvasXAbrScaler * self,
   } else {
     /* Software buffer, so need to copy */
     *use_inpool = TRUE;
+    *reason = GST_VVAS_COPY_REASON_FOREIGN_MEMORY;
     goto exit;
   }
 
@@ -1434,6 +1463,7 @@ vvas_xabrscaler_validate_buffer_import (GstVvasXAbrScaler * self,
 
     if (vmeta->stride[0] % WIDTH_ALIGN || align_elevation % HEIGHT_ALIGN) {
       *use_inpool = TRUE;
+      *reason = GST_VVAS_COPY_REASON_STRIDE;
       GST_DEBUG_OBJECT (self,
           "strides & offsets are not matching, use our internal pool");
       goto exit;
@@ -1441,6 +1471,7 @@ vvas_xabrscaler_validate_buffer_import (GstVvasXAbrScaler * self,
   } else {
     /* vmeta not present, so use internal pool */
     *use_inpool = TRUE;
+    *reason = GST_VVAS_COPY_REASON_STRIDE;
   }
 
 exit:
@@ -1474,6 +1505,7 @@ vvas_xabrscaler_prepare_input_buffer (GstVvasXAbrScaler * self,
   GstBuffer *own_inbuf;
   GstFlowReturn fret;
   gboolean use_inpool = FALSE;
+  GstVvasCopyReason reason = GST_VVAS_COPY_REASON_FOREIGN_MEMORY;
 
   memset (&in_vframe, 0x0, sizeof (GstVideoFrame));
   memset (&own_vframe, 0x0, sizeof (GstVideoFrame));
@@ -1489,7 +1521,8 @@ vvas_xabrscaler_prepare_input_buffer (GstVvasXAbrScaler * self,
   in_mem = NULL;
 
   /* Check if input buffer is meeting hardware requirements or not */
-  bret = vvas_xabrscaler_validate_buffer_import (self, *inbuf, &use_inpool);
+  bret = vvas_xabrscaler_validate_buffer_import (self, *inbuf, &use_inpool,
+      &reason);
 
   if (!bret)
     goto error;
@@ -1517,7 +1550,10 @@ vvas_xabrscaler_prepare_input_buffer (GstVvasXAbrScaler * self,
       }
 
       priv->is_first_frame = FALSE;
-      /* Push the incoming buffer to input queue */
+      /* Push the incoming buffer to input queue, copied by
+       * vvas_xabrscaler_input_copy_thread */
+      gst_vvas_mem_stats_add_copy (&priv->mem_stats, reason,
+          GST_VIDEO_INFO_SIZE (priv->in_vinfo));
       g_async_queue_push (priv->copy_inqueue, *inbuf);
 
       if (!own_inbuf) {
@@ -1554,6 +1590,8 @@ vvas_xabrscaler_prepare_input_buffer (GstVvasXAbrScaler * self,
         goto error;
       }
       gst_video_frame_copy (&own_vframe, &in_vframe);
+      gst_vvas_mem_stats_add_copy (&priv->mem_stats, reason,
+          GST_VIDEO_INFO_SIZE (priv->in_vinfo));
 
       gst_video_frame_unmap (&in_vframe);
       gst_video_frame_unmap (&own_vframe);
@@ -1574,7 +1612,7 @@ vvas_xabrscaler_prepare_input_buffer (GstVvasXAbrScaler * self,
     goto error;
   }
 
-  bret = gst_vvas_memory_sync_bo (in_mem);
+  bret = gst_vvas_memory_sync_bo_full (in_mem, &priv->mem_stats);
   if (!bret)
     goto error;
 
@@ -1745,6 +1783,194 @@ error:
   return NULL;
 }
 
+/**
+ *  @fn static GstBuffer *vvas_xabrscaler_copy_output_buffer (GstVvasXAbrScalerPad * srcpad,
+ *                                                            GstBuffer * outbuf)
+ *
+ *  @param [in] srcpad  - Source pad on which buffer will be pushed.
+ *  @param [in] outbuf  - Scaled output buffer, ownership is taken.
+ *  @return Returns copied buffer on success\n NULL on failure.
+ *
+ *  @brief   Copies scaled output buffer into a buffer from srcpad's copy pool.
+ *  @details Copy pool buffers have the default stride and elevation of the
+ *           output caps, so downstream can read them without video meta.
+ */
+static GstBuffer *
+vvas_xabrscaler_copy_output_buffer (GstVvasXAbrScalerPad * srcpad,
+    GstBuffer * outbuf)
+{
+  GstBuffer *new_outbuf = NULL;
+  GstVideoFrame new_frame, out_frame;
+  GstFlowReturn fret;
+
+  fret = gst_buffer_pool_acquire_buffer (srcpad->copy_pool, &new_outbuf, NULL);
+  if (fret != GST_FLOW_OK) {
+    GST_ERROR_OBJECT (srcpad, "failed to allocate buffer from pool %p",
+        srcpad->copy_pool);
+    goto error;
+  }
+
+  /* Map the new buffers in write mode and output buffer (out_frame) in read mode
+   * for enabling copy */
+  if (!gst_video_frame_map (&out_frame, srcpad->out_vinfo, outbuf,
+          GST_MAP_READ)) {
+    GST_ERROR_OBJECT (srcpad, "failed to map output buffer");
+    goto error;
+  }
+  if (!gst_video_frame_map (&new_frame, srcpad->out_vinfo, new_outbuf,
+          GST_MAP_WRITE)) {
+    GST_ERROR_OBJECT (srcpad, "failed to map copy buffer");
+    gst_video_frame_unmap (&out_frame);
+    goto error;
+  }
+  GST_CAT_LOG_OBJECT (GST_CAT_PERFORMANCE, srcpad,
+      "slow copy data from %p to %p", outbuf, new_outbuf);
+  gst_video_frame_copy (&new_frame, &out_frame);
+  gst_video_frame_unmap (&out_frame);
+  gst_video_frame_unmap (&new_frame);
+
+  /* Copy all the meta data as well */
+  gst_buffer_copy_into (new_outbuf, outbuf, GST_BUFFER_COPY_METADATA, 0, -1);
+  gst_buffer_unref (outbuf);
+
+  return new_outbuf;
+
+error:
+  if (new_outbuf)
+    gst_buffer_unref (new_outbuf);
+  gst_buffer_unref (outbuf);
+  return NULL;
+}
+
+/**
+ *  @fn static gpointer vvas_xabrscaler_output_copy_thread (gpointer data)
+ *
+ *  @param [In] data  - Handle to GstVvasXAbrScalerPad, passed as callback argument.
+ *  @return Returns NULL when STOP_COMMAND is received.
+ *
+ *  @brief   Thread to copy the output buffers of one source pad.
+ *  @details One thread runs per source pad which needs output copy, so that
+ *           the outputs of all the pads of a frame are copied in parallel.
+ *           Copied buffers are returned in the order they are queued.
+ */
+static gpointer
+vvas_xabrscaler_output_copy_thread (gpointer data)
+{
+  GstVvasXAbrScalerPad *srcpad = GST_VVAS_XABRSCALER_PAD_CAST (data);
+
+  while (1) {
+    GstBuffer *outbuf, *new_outbuf;
+
+    outbuf = (GstBuffer *) g_async_queue_pop (srcpad->copy_inqueue);
+    /* We run until STOP_COMMAND is received */
+    if (outbuf == STOP_COMMAND) {
+      GST_DEBUG_OBJECT (srcpad, "received stop command. exit copy thread");
+      break;
+    }
+
+    new_outbuf = vvas_xabrscaler_copy_output_buffer (srcpad, outbuf);
+    g_async_queue_push (srcpad->copy_outqueue,
+        new_outbuf ? (gpointer) new_outbuf : COPY_FAILED);
+  }
+
+  return NULL;
+}
+
+/**
+ *  @fn static gboolean vvas_xabrscaler_start_output_copy (GstVvasXAbrScaler * self,
+ *                                                         GstVvasXAbrScalerPad * srcpad,
+ *                                                         GstCaps * outcaps)
+ *
+ *  @param [in] self     - Handle to GstVvasXAbrScaler instance.
+ *  @param [in] srcpad   - Source pad whose output has to be copied.
+ *  @param [in] outcaps  - Caps negotiated on srcpad.
+ *  @return On Success returns TRUE\n On Failure returns FALSE
+ *
+ *  @brief   Prepares copy pool and copy thread of srcpad.
+ *  @details Called from decide_allocation, when no output buffer of srcpad is
+ *           waiting to be copied, so the copy pool can be replaced safely.
+ */
+static gboolean
+vvas_xabrscaler_start_output_copy (GstVvasXAbrScaler * self,
+    GstVvasXAbrScalerPad * srcpad, GstCaps * outcaps)
+{
+  GstStructure *config;
+  GstVideoInfo vinfo;
+  gchar *thread_name;
+
+  if (!gst_video_info_from_caps (&vinfo, outcaps)) {
+    GST_ERROR_OBJECT (srcpad, "failed to get video info from outcaps");
+    return FALSE;
+  }
+
+  if (srcpad->copy_pool) {
+    gst_buffer_pool_set_active (srcpad->copy_pool, FALSE);
+    gst_clear_object (&srcpad->copy_pool);
+  }
+
+  srcpad->copy_pool = gst_video_buffer_pool_new ();
+  config = gst_buffer_pool_get_config (srcpad->copy_pool);
+  gst_buffer_pool_config_set_params (config, outcaps, vinfo.size, 3, 0);
+  if (!gst_buffer_pool_set_config (srcpad->copy_pool, config) ||
+      !gst_buffer_pool_set_active (srcpad->copy_pool, TRUE)) {
+    GST_ERROR_OBJECT (srcpad, "failed to configure copy pool");
+    gst_clear_object (&srcpad->copy_pool);
+    return FALSE;
+  }
+
+  if (!srcpad->copy_thread) {
+    srcpad->copy_inqueue = g_async_queue_new ();
+    srcpad->copy_outqueue = g_async_queue_new ();
+    thread_name = g_strdup_printf ("abr-%s-copy-thread",
+        GST_PAD_NAME (srcpad));
+    srcpad->copy_thread = g_thread_new (thread_name,
+        vvas_xabrscaler_output_copy_thread, srcpad);
+    g_free (thread_name);
+  }
+
+  GST_INFO_OBJECT (srcpad, "output copy pool %" GST_PTR_FORMAT " ready",
+      srcpad->copy_pool);
+  return TRUE;
+}
+
+/**
+ *  @fn static void vvas_xabrscaler_stop_output_copy (GstVvasXAbrScaler * self,
+ *                                                    GstVvasXAbrScalerPad * srcpad)
+ *
+ *  @param [in] self     - Handle to GstVvasXAbrScaler instance.
+ *  @param [in] srcpad   - Source pad whose copy resources has to be freed.
+ *  @return None
+ *
+ *  @brief   Terminates copy thread of srcpad and frees its copy pool.
+ */
+static void
+vvas_xabrscaler_stop_output_copy (GstVvasXAbrScaler * self,
+    GstVvasXAbrScalerPad * srcpad)
+{
+  gpointer item;
+
+  if (srcpad->copy_thread) {
+    g_async_queue_push (srcpad->copy_inqueue, STOP_COMMAND);
+    GST_LOG_OBJECT (srcpad, "waiting for output copy thread join");
+    g_thread_join (srcpad->copy_thread);
+    srcpad->copy_thread = NULL;
+
+    while ((item = g_async_queue_try_pop (srcpad->copy_outqueue))) {
+      if (item != COPY_FAILED)
+        gst_buffer_unref (GST_BUFFER_CAST (item));
+    }
+    g_async_queue_unref (srcpad->copy_inqueue);
+    g_async_queue_unref (srcpad->copy_outqueue);
+    srcpad->copy_inqueue = NULL;
+    srcpad->copy_outqueue = NULL;
+  }
+
+  if (srcpad->copy_pool) {
+    gst_buffer_pool_set_active (srcpad->copy_pool, FALSE);
+    gst_clear_object (&srcpad->copy_pool);
+  }
+}
+
 /**
  *  @fn static gboolean vvas_xabrscaler_sync_buffer (GstVvasXAbrScaler * self)
  *  @param [In] self   - Handle to GstVvasXAbrScaler instance.
@@ -1798,6 +2024,7 @@ gst_vvas_xabrscaler_finalize (GObject * object)
 
   g_free (self->kern_name);
   g_free (self->xclbin_path);
+  gst_vvas_mem_stats_clear (&self->priv->mem_stats);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -1991,6 +2218,21 @@ gst_vvas_xabrscaler_class_init (GstVvasXAbrScalerClass * klass)
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
           GST_PARAM_MUTABLE_READY));
 
+  g_object_class_install_property (gobject_class, PROP_MEM_STATS,
+      g_param_spec_boxed ("mem-stats", "Memory transfer statistics",
+          "DMA transfers and slow copies done by the element with the reason "
+          "of each copy", GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_FRAME_STATS,
+      g_param_spec_boolean ("frame-stats", "Attach frame statistics",
+          "Attach GstVvasFrameStatsMeta with the luma histogram and block "
+          "means of the input frame to all output buffers. The input frame "
+          "is read by the CPU for it",
+          VVAS_XABRSCALER_FRAME_STATS_DEFAULT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
 #ifdef ENABLE_PPE_SUPPORT
   g_object_class_install_property (gobject_class, PROP_ALPHA_R,
       g_param_spec_float ("alpha-r",
@@ -2048,6 +2290,7 @@ gst_vvas_xabrscaler_init (GstVvasXAbrScaler * self)
   GstPadTemplate *pad_template;
 
   self->priv = GST_VVAS_XABRSCALER_PRIVATE (self);
+  gst_vvas_mem_stats_init (&self->priv->mem_stats);
   klass = GST_VVAS_XABRSCALER_GET_CLASS (self);
 
   pad_template =
@@ -2076,6 +2319,7 @@ gst_vvas_xabrscaler_init (GstVvasXAbrScaler * self)
   self->coef_load_type = VVAS_XABRSCALER_DEFAULT_COEF_LOAD_TYPE;
   self->avoid_output_copy = VVAS_XABRSCALER_AVOID_OUTPUT_COPY_DEFAULT;
   self->software_scaling = VVAS_XABRSCALER_ENABLE_SOFTWARE_SCALING_DEFAULT;
+  self->frame_stats = VVAS_XABRSCALER_FRAME_STATS_DEFAULT;
 #ifdef ENABLE_PPE_SUPPORT
   self->alpha_r = PP_ALPHA_DEFAULT_VALUE;
   self->alpha_g = PP_ALPHA_DEFAULT_VALUE;
@@ -2340,6 +2584,9 @@ gst_vvas_xabrscaler_set_property (GObject * object, guint prop_id,
     case PROP_SOFTWARE_SCALING:
       self->software_scaling = g_value_get_boolean (value);
       break;
+    case PROP_FRAME_STATS:
+      self->frame_stats = g_value_get_boolean (value);
+      break;
 #ifdef ENABLE_PPE_SUPPORT
     case PROP_ALPHA_R:
       self->alpha_r = g_value_get_float (value);
@@ -2443,6 +2690,13 @@ gst_vvas_xabrscaler_get_property (GObject * object, guint prop_id,
     case PROP_SOFTWARE_SCALING:
       g_value_set_boolean (value, self->software_scaling);
       break;
+    case PROP_MEM_STATS:
+      g_value_take_boxed (value,
+          gst_vvas_mem_stats_to_structure (&self->priv->mem_stats));
+      break;
+    case PROP_FRAME_STATS:
+      g_value_set_boolean (value, self->frame_stats);
+      break;
 #ifdef ENABLE_PPE_SUPPORT
     case PROP_ALPHA_R:
       g_value_set_float (value, self->alpha_r);
@@ -2598,6 +2852,8 @@ gst_vvas_xabrscaler_change_state (GstElement * element,
       for (idx = 0; idx < g_list_length (self->srcpads); idx++) {
         GstVvasXAbrScalerPad *srcpad =
             gst_vvas_xabrscaler_srcpad_at_index (self, idx);
+
+        vvas_xabrscaler_stop_output_copy (self, srcpad);
         if (srcpad->pool && gst_buffer_pool_is_active (srcpad->pool)) {
           if (!gst_buffer_pool_set_active (srcpad->pool, FALSE))
             GST_ERROR_OBJECT (self,
@@ -3434,8 +3690,9 @@ vvas_xabrscaler_decide_allocation (GstVvasXAbrScaler * self,
   GstBufferPool *pool = NULL;
   guint size, min, max;
   gboolean update_allocator, update_pool, bret, have_new_allocator = FALSE;
+  gboolean default_layout = FALSE;
   GstStructure *config = NULL;
-  GstVideoInfo out_vinfo;
+  GstVideoInfo out_vinfo, default_vinfo;
   gint srcpadIdx = gst_vvas_xabrscaler_srcpad_get_index (self, srcpad);
 
   if (!outcaps) {
@@ -3589,6 +3846,9 @@ vvas_xabrscaler_decide_allocation (GstVvasXAbrScaler * self,
           NEED_DMABUF, self->out_mem_bank);
       params.flags = GST_MEMORY_FLAG_PHYSICALLY_CONTIGUOUS;
       params.flags |= GST_VVAS_ALLOCATOR_FLAG_MEM_INIT;
+      /* output frames are written by CPU in software scaling mode */
+      if (self->software_scaling)
+        params.flags |= GST_VVAS_ALLOCATOR_FLAG_PREFAULT;
       GST_INFO_OBJECT (srcpad, "creating new xrt allocator %" GST_PTR_FORMAT
           "at mem bank %d", allocator, self->out_mem_bank);
       have_new_allocator = TRUE;
@@ -3630,10 +3890,22 @@ vvas_xabrscaler_decide_allocation (GstVvasXAbrScaler * self,
       }
       /* Adjust output video info with respect to new alignment. Stride, offset etc will be
        * ajusted accordingly */
+      default_vinfo = out_vinfo;
       gst_video_info_align (&out_vinfo, &align);
       /* size updated in vinfo based on alignment */
       size = out_vinfo.size;
 
+      /* When scaler alignment does not add any padding, buffers of this pool
+       * can be read even by downstream not supporting video meta */
+      default_layout = TRUE;
+      for (int idx = 0; idx < GST_VIDEO_INFO_N_PLANES (&out_vinfo); idx++) {
+        if (GST_VIDEO_INFO_PLANE_STRIDE (&out_vinfo, idx) !=
+            GST_VIDEO_INFO_PLANE_STRIDE (&default_vinfo, idx) ||
+            GST_VIDEO_INFO_PLANE_OFFSET (&out_vinfo, idx) !=
+            GST_VIDEO_INFO_PLANE_OFFSET (&default_vinfo, idx))
+          default_layout = FALSE;
+      }
+
       /* A bufferpool option to enable extra padding */
       gst_buffer_pool_config_add_option (config,
           GST_BUFFER_POOL_OPTION_VIDEO_ALIGNMENT);
@@ -3763,6 +4035,13 @@ vvas_xabrscaler_decide_allocation (GstVvasXAbrScaler * self,
     if (gst_query_find_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL)) {
       self->priv->need_copy[srcpadIdx] = FALSE;
       GST_INFO_OBJECT (srcpad, "no need to copy output frames");
+    } else if (default_layout) {
+      self->priv->need_copy[srcpadIdx] = FALSE;
+      GST_INFO_OBJECT (srcpad, "output buffers have default layout, "
+          "no need to copy output frames");
+    } else if (self->priv->need_copy[srcpadIdx]) {
+      if (!vvas_xabrscaler_start_output_copy (self, srcpad, outcaps))
+        goto error;
     }
   } else {
     self->priv->need_copy[srcpadIdx] = FALSE;
@@ -4134,6 +4413,7 @@ gst_vvas_xabrscaler_sink_event (GstPad * pad, GstObject * parent,
             return FALSE;
         }
       }
+      gst_vvas_mem_stats_dump (&self->priv->mem_stats, GST_ELEMENT (self));
       ret = gst_pad_event_default (pad, parent, event);
       break;
     }
@@ -4627,21 +4907,80 @@ gst_vvas_xabrscaler_free_vvas_video_frame (GstVvasXAbrScaler * self)
 
 
 /**
- *  @fn static gboolean remove_infer_meta (GstBuffer * buffer, GstMeta ** meta, gpointer user_data) 
- *  @param [in] buffer       - Buffer handle to which meta has to be removed
- *  @param [in] meta         - meta to be removed
- *  @param [in] user_data    - user data to be passed
- *  @return On Success returns TRUE, indicates meta data has been removed.
- *  @brief  This is a callback function registered for removing meta data.
- *  @details This function will be triggered via gst_buffer_foreach_meta.
- *
+ *  @fn static gboolean vvas_xabrscaler_frame_stats (GstVvasXAbrScaler * self,
+ *                                                  GstBuffer * inbuf,
+ *                                                  GstVvasFrameStats * stats)
+ *  @param [in] self - Handle to GstVvasXAbrScaler instance
+ *  @param [in] inbuf - Input buffer
+ *  @param [out] stats - Luma statistics of \p inbuf
+ *  @return FALSE if no statistics are to be attached
+ *  @brief  Computes the statistics of the input frame on the CPU, with the
+ *          reference implementation of the image_processing kernel.
  */
 static gboolean
-remove_infer_meta (GstBuffer * buffer, GstMeta ** meta, gpointer user_data)
+vvas_xabrscaler_frame_stats (GstVvasXAbrScaler * self, GstBuffer * inbuf,
+    GstVvasFrameStats * stats)
 {
-  if (meta && *meta && (*meta)->info->api == GST_INFERENCE_META_API_TYPE) {
-    *meta = NULL;
+  GstVideoFrame frame;
+  gboolean bret;
+
+  /* Statistics of upstream are copied with the other metadata */
+  if (gst_buffer_get_vvas_frame_stats_meta (inbuf))
+    return FALSE;
+
+  if (!gst_vvas_frame_stats_format_supported (GST_VIDEO_INFO_FORMAT
+          (self->priv->in_vinfo))) {
+    GST_LOG_OBJECT (self, "no frame statistics for format %s",
+        GST_VIDEO_INFO_NAME (self->priv->in_vinfo));
+    return FALSE;
+  }
+
+  if (!gst_video_frame_map (&frame, self->priv->in_vinfo, inbuf,
+          GST_MAP_READ)) {
+    GST_WARNING_OBJECT (self, "failed to map input buffer for statistics");
+    return FALSE;
   }
+  bret = gst_vvas_frame_stats_compute (stats, &frame);
+  gst_video_frame_unmap (&frame);
+
+  GST_LOG_OBJECT (self, "input frame mean luma %.1f", stats->mean);
+
+  return bret;
+}
+
+/**
+ *  @fn static gboolean copy_unscaled_meta (GstBuffer * buffer, GstMeta ** meta, gpointer user_data)
+ *  @param [in] buffer       - Input buffer handle owning the meta
+ *  @param [in] meta         - meta to be copied
+ *  @param [in] user_data    - Output buffer to which meta has to be copied
+ *  @return Returns TRUE to continue with next meta.
+ *  @brief  This is a callback function registered for copying input meta data.
+ *  @details This function will be triggered via gst_buffer_foreach_meta. It
+ *           copies metas same as gst_buffer_copy_into, except inference and
+ *           overlay metas which are scaled separately for each output. Copying
+ *           those first would deep copy the whole prediction tree only to
+ *           throw it away.
+ *
+ */
+static gboolean
+copy_unscaled_meta (GstBuffer * buffer, GstMeta ** meta, gpointer user_data)
+{
+  GstBuffer *outbuf = GST_BUFFER_CAST (user_data);
+  const GstMetaInfo *info = (*meta)->info;
+  GstMetaTransformCopy copy_data = { FALSE, 0, -1 };
+
+  if (info->api == GST_INFERENCE_META_API_TYPE ||
+      info->api == GST_VVAS_OVERLAY_META_API_TYPE)
+    return TRUE;
+
+  /* memory metas are not copied when memory is not copied */
+  if (gst_meta_api_type_has_tag (info->api,
+          g_quark_from_static_string (GST_META_TAG_MEMORY_STR)))
+    return TRUE;
+
+  if (info->transform_func)
+    info->transform_func (outbuf, *meta, buffer, _gst_meta_transform_copy,
+        &copy_data);
 
   return TRUE;
 }
@@ -4664,6 +5003,10 @@ gst_vvas_xabrscaler_chain (GstPad * pad, GstObject * parent, GstBuffer * inbuf)
   guint chan_id = 0;
   gboolean bret = FALSE;
   VvasReturnType vret;
+  GstInferenceMeta *in_infer_meta;
+  GstInferencePrediction *scaled_predictions[MAX_CHANNELS];
+  GstVvasFrameStats frame_stats;
+  gboolean has_frame_stats = FALSE;
 
 #ifdef ENABLE_PPE_SUPPORT
   if (G_UNLIKELY (self->get_pp_config)) {
@@ -4720,7 +5063,28 @@ gst_vvas_xabrscaler_chain (GstPad * pad, GstObject * parent, GstBuffer * inbuf)
       goto error;
   }
 
-  /* pad push of each output buffer to respective srcpad */
+  /* Scale inference metadata for all the outputs in one go */
+  in_infer_meta = (GstInferenceMeta *) gst_buffer_get_meta (inbuf,
+      gst_inference_meta_api_get_type ());
+  if (in_infer_meta) {
+    GstVideoInfo *out_vinfos[MAX_CHANNELS];
+
+    for (chan_id = 0; chan_id < self->num_request_pads; chan_id++)
+      out_vinfos[chan_id] =
+          gst_vvas_xabrscaler_srcpad_at_index (self, chan_id)->out_vinfo;
+
+    GST_DEBUG_OBJECT (self, "scaling inference metadata for %u outputs",
+        self->num_request_pads);
+    gst_inference_prediction_scale_batch (in_infer_meta->prediction,
+        self->priv->in_vinfo, out_vinfos, self->num_request_pads,
+        scaled_predictions);
+  }
+
+  /* One set of statistics of the input frame for all the outputs */
+  if (self->frame_stats)
+    has_frame_stats = vvas_xabrscaler_frame_stats (self, inbuf, &frame_stats);
+
+  /* attach metadata of input buffer on each output buffer */
   for (chan_id = 0; chan_id < self->num_request_pads; chan_id++) {
     GstBuffer *outbuf = self->priv->outbufs[chan_id];
     GstVvasXAbrScalerPad *srcpad =
@@ -4728,25 +5092,19 @@ gst_vvas_xabrscaler_chain (GstPad * pad, GstObject * parent, GstBuffer * inbuf)
     GstMeta *in_meta;
 
     gst_buffer_copy_into (outbuf, inbuf,
-        (GstBufferCopyFlags) (GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_META |
+        (GstBufferCopyFlags) (GST_BUFFER_COPY_FLAGS |
             GST_BUFFER_COPY_TIMESTAMPS), 0, -1);
+    gst_buffer_foreach_meta (inbuf, copy_unscaled_meta, outbuf);
 
-    /* we are removing infer meta data from outbuf because while performing
-     * transform operation, both inbuf & outbuf meta data are same
-     * and due to that "need_scale" flag is not set and scaling is not happening
-     */
-    gst_buffer_foreach_meta (outbuf, remove_infer_meta, NULL);
-
-    /* Scaling of input vvas metadata based on output resolution */
-    in_meta = gst_buffer_get_meta (inbuf, gst_inference_meta_api_get_type ());
-
-    if (in_meta) {
-      GstVideoMetaTransform trans = { self->priv->in_vinfo, srcpad->out_vinfo };
-      GQuark scale_quark = gst_video_meta_transform_scale_get_quark ();
+    if (in_infer_meta) {
+      GstInferenceMeta *out_meta = (GstInferenceMeta *)
+          gst_buffer_add_meta (outbuf, gst_inference_meta_get_info (), NULL);
 
       GST_DEBUG_OBJECT (srcpad, "attaching scaled inference metadata");
-      in_meta->info->transform_func (outbuf, (GstMeta *) in_meta,
-          inbuf, scale_quark, &trans);
+      gst_inference_prediction_unref (out_meta->prediction);
+      out_meta->prediction = scaled_predictions[chan_id];
+      scaled_predictions[chan_id] = NULL;
+      out_meta->stream_id = g_strdup (in_infer_meta->stream_id);
     }
 
     in_meta = gst_buffer_get_meta (inbuf, GST_VVAS_OVERLAY_META_API_TYPE);
@@ -4759,6 +5117,13 @@ gst_vvas_xabrscaler_chain (GstPad * pad, GstObject * parent, GstBuffer * inbuf)
           inbuf, scale_quark, &trans);
     }
 
+    if (has_frame_stats) {
+      GstVvasFrameStatsMeta *stats_meta =
+          gst_buffer_add_vvas_frame_stats_meta (outbuf);
+
+      stats_meta->stats = frame_stats;
+    }
+
     /* Copying of input HDR metadata */
     in_meta = (GstMeta *) gst_buffer_get_vvas_hdr_meta (inbuf);
     if (in_meta) {
@@ -4769,81 +5134,78 @@ gst_vvas_xabrscaler_chain (GstPad * pad, GstObject * parent, GstBuffer * inbuf)
           inbuf, _gst_meta_transform_copy, &copy_data);
     }
 
-    /* If the "need_copy" flag is enabled for the channel, create new host
-     * buffer and copy the content and meta data into it from device buffer
-     * and push out the host buffer */
+    /* If the "need_copy" flag is enabled for the channel, hand the device
+     * buffer to the pad's copy thread, which copies it into a host buffer.
+     * All the channels are copied in parallel, results are collected below */
     if (self->priv->need_copy[chan_id]) {
-      GstBuffer *new_outbuf;
-      GstVideoFrame new_frame, out_frame;
-      new_outbuf =
-          gst_buffer_new_and_alloc (GST_VIDEO_INFO_SIZE (srcpad->out_vinfo));
-      if (!new_outbuf) {
-        GST_ERROR_OBJECT (srcpad, "failed to allocate output buffer");
-        fret = GST_FLOW_ERROR;
-        goto error2;
-      }
+      gst_vvas_mem_stats_add_copy (&self->priv->mem_stats,
+          GST_VVAS_COPY_REASON_STRIDE,
+          GST_VIDEO_INFO_SIZE (srcpad->out_vinfo));
+      g_async_queue_push (srcpad->copy_inqueue, outbuf);
+      self->priv->outbufs[chan_id] = NULL;
+    }
+  }
 
-      /* Map the new buffers in write mode and output buffer (out_frame) in read mode
-       * for enabling copy */
-      gst_video_frame_map (&out_frame, srcpad->out_vinfo, outbuf, GST_MAP_READ);
-      gst_video_frame_map (&new_frame, srcpad->out_vinfo, new_outbuf,
-          GST_MAP_WRITE);
-      GST_CAT_LOG_OBJECT (GST_CAT_PERFORMANCE, srcpad,
-          "slow copy data from %p to %p", outbuf, new_outbuf);
-      gst_video_frame_copy (&new_frame, &out_frame);
-      gst_video_frame_unmap (&out_frame);
-      gst_video_frame_unmap (&new_frame);
-
-      /* Copy all the meta data as well */
-      gst_buffer_copy_into (new_outbuf, outbuf, GST_BUFFER_COPY_METADATA, 0,
-          -1);
-      gst_buffer_unref (outbuf);
-      GST_LOG_OBJECT (srcpad,
-          "pushing outbuf %p with pts = %" GST_TIME_FORMAT " dts = %"
-          GST_TIME_FORMAT " duration = %" GST_TIME_FORMAT, new_outbuf,
-          GST_TIME_ARGS (GST_BUFFER_PTS (new_outbuf)),
-          GST_TIME_ARGS (GST_BUFFER_DTS (new_outbuf)),
-          GST_TIME_ARGS (GST_BUFFER_DURATION (new_outbuf)));
-
-      /* Push out the newly created and copied buffer to source pad */
-      fret = gst_pad_push (GST_PAD_CAST (srcpad), new_outbuf);
-      if (G_UNLIKELY (fret != GST_FLOW_OK)) {
-        if (fret == GST_FLOW_EOS)
-          GST_DEBUG_OBJECT (self, "failed to push buffer. reason : %s",
-              gst_flow_get_name (fret));
-        else
-          GST_ERROR_OBJECT (self, "failed to push buffer. reason : %s",
-              gst_flow_get_name (fret));
-        goto error2;
-      }
+  /* pad push of each output buffer to respective srcpad */
+  for (chan_id = 0; chan_id < self->num_request_pads; chan_id++) {
+    GstVvasXAbrScalerPad *srcpad =
+        gst_vvas_xabrscaler_srcpad_at_index (self, chan_id);
+    GstBuffer *outbuf;
 
-    } else {
-      GST_LOG_OBJECT (srcpad,
-          "pushing outbuf %p with pts = %" GST_TIME_FORMAT " dts = %"
-          GST_TIME_FORMAT " duration = %" GST_TIME_FORMAT, outbuf,
-          GST_TIME_ARGS (GST_BUFFER_PTS (outbuf)),
-          GST_TIME_ARGS (GST_BUFFER_DTS (outbuf)),
-          GST_TIME_ARGS (GST_BUFFER_DURATION (outbuf)));
-
-      /* Push out the output buffer onto source pad */
-      fret = gst_pad_push (GST_PAD_CAST (srcpad), outbuf);
-      if (G_UNLIKELY (fret != GST_FLOW_OK)) {
-        if (fret == GST_FLOW_EOS)
-          GST_DEBUG_OBJECT (self, "failed to push buffer. reason : %s",
-              gst_flow_get_name (fret));
-        else
-          GST_ERROR_OBJECT (self, "failed to push buffer. reason : %s",
-              gst_flow_get_name (fret));
+    if (self->priv->need_copy[chan_id]) {
+      /* wait for copy thread to give back the copied host buffer */
+      outbuf = (GstBuffer *) g_async_queue_pop (srcpad->copy_outqueue);
+      if (outbuf == COPY_FAILED) {
+        GST_ERROR_OBJECT (srcpad, "failed to copy output buffer");
+        fret = GST_FLOW_ERROR;
         goto error2;
       }
+    } else {
+      outbuf = self->priv->outbufs[chan_id];
+      self->priv->outbufs[chan_id] = NULL;
+    }
+
+    GST_LOG_OBJECT (srcpad,
+        "pushing outbuf %p with pts = %" GST_TIME_FORMAT " dts = %"
+        GST_TIME_FORMAT " duration = %" GST_TIME_FORMAT, outbuf,
+        GST_TIME_ARGS (GST_BUFFER_PTS (outbuf)),
+        GST_TIME_ARGS (GST_BUFFER_DTS (outbuf)),
+        GST_TIME_ARGS (GST_BUFFER_DURATION (outbuf)));
+
+    /* Push out the output buffer onto source pad */
+    fret = gst_pad_push (GST_PAD_CAST (srcpad), outbuf);
+    if (G_UNLIKELY (fret != GST_FLOW_OK)) {
+      if (fret == GST_FLOW_EOS)
+        GST_DEBUG_OBJECT (self, "failed to push buffer. reason : %s",
+            gst_flow_get_name (fret));
+      else
+        GST_ERROR_OBJECT (self, "failed to push buffer. reason : %s",
+            gst_flow_get_name (fret));
+      goto error2;
     }
   }
 
   gst_buffer_unref (inbuf);
   return fret;
 
-error:
 error2:
+  /* drop outputs of the channels which are not pushed yet, copy threads
+   * must not carry them over to the next frame */
+  for (chan_id++; chan_id < self->num_request_pads; chan_id++) {
+    GstVvasXAbrScalerPad *srcpad =
+        gst_vvas_xabrscaler_srcpad_at_index (self, chan_id);
+
+    if (self->priv->need_copy[chan_id]) {
+      gpointer copied = g_async_queue_pop (srcpad->copy_outqueue);
+      if (copied != COPY_FAILED)
+        gst_buffer_unref (GST_BUFFER_CAST (copied));
+    } else if (self->priv->outbufs[chan_id]) {
+      gst_buffer_unref (self->priv->outbufs[chan_id]);
+      self->priv->outbufs[chan_id] = NULL;
+    }
+  }
+
+error:
   gst_buffer_unref (inbuf);
   gst_vvas_xabrscaler_free_vvas_video_frame (self);
   return fret;
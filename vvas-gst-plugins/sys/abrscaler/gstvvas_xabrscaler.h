@@ -130,6 +130,8 @@ struct _GstVvasXAbrScaler
   gboolean enabled_pipeline;
   /** Flag to enable software scaling flow */
   gboolean software_scaling;
+  /** Attach GstVvasFrameStatsMeta of the input frame to the outputs */
+  gboolean frame_stats;
 #ifdef ENABLE_PPE_SUPPORT
   /** PreProcessing parameter alpha red channel value */
   gfloat alpha_r;
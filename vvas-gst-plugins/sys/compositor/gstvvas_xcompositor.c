@@ -139,6 +139,17 @@
  */
 #define VVAS_XCOMPOSITOR_ENABLE_SOFTWARE_SCALING_DEFAULT FALSE
 
+/** @def VVAS_XCOMPOSITOR_PERSISTENT_CANVAS_DEFAULT
+ *  @brief Default value for persistent-canvas property.
+ */
+#define VVAS_XCOMPOSITOR_PERSISTENT_CANVAS_DEFAULT FALSE
+
+/** @def VVAS_XCOMPOSITOR_MAX_CANVASES
+ *  @brief Maximum number of persistent canvases, one is pushed downstream
+ *         while the others can be composed
+ */
+#define VVAS_XCOMPOSITOR_MAX_CANVASES 4
+
 /** @def STOP_COMMAND
  *  @brief Macro to replace the STOP quark
  */
@@ -350,6 +361,10 @@ enum
   PROP_ENABLE_PIPELINE,
   /** Software scaling */
   PROP_SOFTWARE_SCALING,
+  /** Re-render only the tiles having new frames */
+  PROP_PERSISTENT_CANVAS,
+  /** Memory transfer statistics */
+  PROP_MEM_STATS,
 #ifdef ENABLE_XRM_SUPPORT
   /** Property to set xrm reservation id */
   PROP_RESERVATION_ID,
@@ -413,6 +428,38 @@ struct _GstVvasXCompositorPadClass
   GstVideoAggregatorPadClass compositor_pad_class;
 };
 
+/** @struct VvasXCompositorTile
+ *  @brief  Placement of a pad on the composed frame
+ */
+typedef struct
+{
+  /** Index of the pad rendered in this tile */
+  gint pad_idx;
+  /** x position of the tile */
+  guint x;
+  /** y position of the tile */
+  guint y;
+  /** width of the tile */
+  guint width;
+  /** height of the tile */
+  guint height;
+} VvasXCompositorTile;
+
+/** @struct VvasXCompositorCanvas
+ *  @brief  Persistent canvas and the content composed on it
+ */
+typedef struct
+{
+  /** Canvas buffer, its memory is shared with the output buffers pushed */
+  GstBuffer *buffer;
+  /** Layout the canvas was composed with, 0 if not composed yet */
+  guint layout;
+  /** Content serial of each pad when it was last composed on the canvas */
+  guint64 content[MAX_CHANNELS];
+  /** Aggregation in which the canvas was last composed */
+  guint64 age;
+} VvasXCompositorCanvas;
+
 /** @struct _GstVvasXCompositorPrivate
  *  @brief  Holds private members related VVAS Compositor instance
  */
@@ -454,6 +501,32 @@ struct _GstVvasXCompositorPrivate
   VvasVideoFrame *input_frames[MAX_CHANNELS];
   /** Reference of output VvasVideoFrame */
   VvasVideoFrame *output_frame;
+  /** Pool of the persistent canvas buffers */
+  GstBufferPool *canvas_pool;
+  /** Persistent canvases holding the last composed frames */
+  VvasXCompositorCanvas canvases[VVAS_XCOMPOSITOR_MAX_CANVASES];
+  /** Number of canvases allocated */
+  guint num_canvases;
+  /** Canvas composed in the current aggregation, NULL if none */
+  VvasXCompositorCanvas *canvas;
+  /** Tiles of the current layout, in zorder */
+  VvasXCompositorTile canvas_tiles[MAX_CHANNELS];
+  /** Number of tiles of the current layout */
+  guint canvas_num_tiles;
+  /** Serial of the current layout, changed when tiles move */
+  guint layout;
+  /** Number of aggregations done with persistent canvases */
+  guint64 aggregations;
+  /** Last input buffer received on each pad */
+  GstBuffer *canvas_inbufs[MAX_CHANNELS];
+  /** Number of aggregations for which the pad delivers new content */
+  guint render_count[MAX_CHANNELS];
+  /** Serial of the content delivered by each pad */
+  guint64 content[MAX_CHANNELS];
+  /** Whether the pad is rendered in the current aggregation */
+  gboolean render[MAX_CHANNELS];
+  /** DMA transfers and slow copies of input and output frames */
+  GstVvasMemStats mem_stats;
 
 #ifdef ENABLE_XRM_SUPPORT
   /** XRM Context */
@@ -511,6 +584,8 @@ static void gst_vvas_xcompositor_set_property (GObject * object,
 static void gst_vvas_xcompositor_get_property (GObject * object,
     guint prop_id, GValue * value, GParamSpec * pspec);
 static void gst_vvas_xcompositor_finalize (GObject * object);
+static gboolean gst_vvas_xcompositor_sink_event (GstAggregator * agg,
+    GstAggregatorPad * bpad, GstEvent * event);
 static GstFlowReturn gst_vvas_xcompositor_aggregate_frames (GstVideoAggregator
     * vagg, GstBuffer * outbuffer);
 static GstFlowReturn
@@ -523,6 +598,7 @@ vvas_xcompositor_set_zorder_from_pads (GstVvasXCompositor * self);
 static void
 vvas_xcompositor_adjust_zorder_after_eos (GstVvasXCompositor * self,
     guint index);
+static void vvas_xcompositor_free_canvas (GstVvasXCompositor * self);
 
 GType gst_vvas_xcompositor_pad_get_type (void);
 
@@ -1062,6 +1138,9 @@ vvas_xcompositor_hw_scaling_decide_allocation (GstVvasXCompositor * self,
         NEED_DMABUF, self->out_mem_bank);
     params.flags = GST_MEMORY_FLAG_PHYSICALLY_CONTIGUOUS;
     params.flags |= GST_VVAS_ALLOCATOR_FLAG_MEM_INIT;
+    /* output frames are written by CPU in software scaling mode */
+    if (self->software_scaling)
+      params.flags |= GST_VVAS_ALLOCATOR_FLAG_PREFAULT;
     GST_INFO_OBJECT (self, "creating new xrt allocator %" GST_PTR_FORMAT
         "at mem bank %d", allocator, self->out_mem_bank);
     have_new_allocator = TRUE;
@@ -1221,6 +1300,9 @@ vvas_xcompositor_decide_allocation (GstAggregator * agg, GstQuery * query)
 
   self->priv->output_pool = pool;
 
+  /* output caps might have changed, canvas is allocated again on next frame */
+  vvas_xcompositor_free_canvas (self);
+
   self->srcpad = agg->srcpad;
 
 #ifdef ENABLE_XRM_SUPPORT
@@ -2304,6 +2386,7 @@ gst_vvas_xcompositor_class_init (GstVvasXCompositorClass * klass)
 
   agg_class->src_query = gst_vvas_xcompositor_src_query;
   agg_class->sink_query = gst_vvas_xcompositor_sink_query;
+  agg_class->sink_event = gst_vvas_xcompositor_sink_event;
 
   agg_class->decide_allocation = vvas_xcompositor_decide_allocation;
 
@@ -2417,6 +2500,19 @@ gst_vvas_xcompositor_class_init (GstVvasXCompositorClass * klass)
           VVAS_XCOMPOSITOR_ENABLE_SOFTWARE_SCALING_DEFAULT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
           GST_PARAM_MUTABLE_READY));
+  g_object_class_install_property (gobject_class, PROP_PERSISTENT_CANVAS,
+      g_param_spec_boolean ("persistent-canvas",
+          "Persistent canvas",
+          "Keep the composed frame across aggregations and re-render only "
+          "the tiles which received a new frame",
+          VVAS_XCOMPOSITOR_PERSISTENT_CANVAS_DEFAULT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+  g_object_class_install_property (gobject_class, PROP_MEM_STATS,
+      g_param_spec_boxed ("mem-stats", "Memory transfer statistics",
+          "DMA transfers and slow copies done by the element with the reason "
+          "of each copy", GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 }
 
 /**
@@ -2447,6 +2543,7 @@ gst_vvas_xcompositor_init (GstVvasXCompositor * self)
   self->avoid_output_copy = VVAS_XCOMPOSITOR_AVOID_OUTPUT_COPY_DEFAULT;
   self->enabled_pipeline = VVAS_XCOMPOSITOR_ENABLE_PIPELINE_DEFAULT;
   self->software_scaling = VVAS_XCOMPOSITOR_ENABLE_SOFTWARE_SCALING_DEFAULT;
+  self->persistent_canvas = VVAS_XCOMPOSITOR_PERSISTENT_CANVAS_DEFAULT;
 #ifdef ENABLE_XRM_SUPPORT
   self->priv->xrm_ctx = NULL;
   self->priv->cu_resource = NULL;
@@ -2462,6 +2559,7 @@ gst_vvas_xcompositor_init (GstVvasXCompositor * self)
     self->priv->in_vinfo[chan_id] = gst_video_info_new ();
     self->priv->pad_of_zorder[chan_id] = chan_id;
   }
+  gst_vvas_mem_stats_init (&self->priv->mem_stats);
 }
 
 /**
@@ -2490,9 +2588,47 @@ gst_vvas_xcompositor_finalize (GObject * object)
   if (self->priv->vvas_ctx) {
     vvas_context_destroy (self->priv->vvas_ctx);
   }
+  gst_vvas_mem_stats_clear (&self->priv->mem_stats);
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/**
+ *  @fn static gboolean gst_vvas_xcompositor_sink_event (GstAggregator * agg,
+ *                                                       GstAggregatorPad * bpad,
+ *                                                       GstEvent * event)
+ *  @param [in] agg     - Pointer to GstAggregator holding compositor instance pointer
+ *  @param [in] bpad    - Pad on which event has been received
+ *  @param [in] event   - Event received
+ *  @return TRUE if the event was handled
+ *  @brief  Reports memory transfer statistics once the last sink pad got EOS and
+ *          lets the parent class handle the event
+ */
+static gboolean
+gst_vvas_xcompositor_sink_event (GstAggregator * agg, GstAggregatorPad * bpad,
+    GstEvent * event)
+{
+  GstVvasXCompositor *self = GST_VVAS_XCOMPOSITOR (agg);
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_EOS) {
+    gboolean all_eos = TRUE;
+    GList *l;
+
+    GST_OBJECT_LOCK (self);
+    for (l = GST_ELEMENT (self)->sinkpads; l; l = l->next) {
+      if (l->data != (gpointer) bpad && !GST_PAD_IS_EOS (l->data)) {
+        all_eos = FALSE;
+        break;
+      }
+    }
+    GST_OBJECT_UNLOCK (self);
+
+    if (all_eos)
+      gst_vvas_mem_stats_dump (&self->priv->mem_stats, GST_ELEMENT (self));
+  }
+
+  return GST_AGGREGATOR_CLASS (parent_class)->sink_event (agg, bpad, event);
+}
+
 /**
  *  @fn static gboolean gst_vvas_xcompositor_query_caps (GstPad * pad, GstAggregator * agg, GstQuery * query)
  *  @param [in] pad     - Pointer to GstPad on which query has been received.
@@ -2891,6 +3027,7 @@ vvas_xcompositor_prepare_input_buffer (GstVvasXCompositor * self,
   GstBuffer *own_inbuf;
   GstFlowReturn fret;
   gboolean use_inpool = FALSE;
+  GstVvasCopyReason reason = GST_VVAS_COPY_REASON_FOREIGN_MEMORY;
   guint pad_idx = sinkpad->index;
 
   /* Clear the video frames */
@@ -2940,6 +3077,8 @@ vvas_xcompositor_prepare_input_buffer (GstVvasXCompositor * self,
   } else {
     /* If not a vvas or dma memory, use internal pool buffers */
     use_inpool = TRUE;
+    if (gst_is_vvas_memory (in_mem))
+      reason = GST_VVAS_COPY_REASON_BANK_MISMATCH;
   }
 
   gst_memory_unref (in_mem);
@@ -2966,6 +3105,9 @@ vvas_xcompositor_prepare_input_buffer (GstVvasXCompositor * self,
       }
 
       priv->is_first_frame[sinkpad->index] = FALSE;
+      /* copied by vvas_xcompositor_input_copy_thread */
+      gst_vvas_mem_stats_add_copy (&priv->mem_stats, reason,
+          GST_VIDEO_INFO_SIZE (priv->in_vinfo[pad_idx]));
       g_async_queue_push (priv->copy_inqueue[sinkpad->index], *inbuf);
 
       if (!own_inbuf) {
@@ -3001,6 +3143,8 @@ vvas_xcompositor_prepare_input_buffer (GstVvasXCompositor * self,
         goto error;
       }
       gst_video_frame_copy (&own_vframe, &in_vframe);
+      gst_vvas_mem_stats_add_copy (&priv->mem_stats, reason,
+          GST_VIDEO_INFO_SIZE (priv->in_vinfo[pad_idx]));
 
       gst_video_frame_unmap (&in_vframe);
       gst_video_frame_unmap (&own_vframe);
@@ -3036,7 +3180,7 @@ vvas_xcompositor_prepare_input_buffer (GstVvasXCompositor * self,
     phy_addr = gst_vvas_allocator_get_paddr (in_mem);
   }
   /* syncs data when XLNX_SYNC_TO_DEVICE flag is enabled */
-  bret = gst_vvas_memory_sync_bo (in_mem);
+  bret = gst_vvas_memory_sync_bo_full (in_mem, &priv->mem_stats);
   if (!bret)
     goto error;
 
@@ -3147,40 +3291,161 @@ vvas_xcompositor_free_vvas_video_frame (GstVvasXCompositor * self)
   }
 }
 
+/**
+ *  @fn static bool vvas_xcompositor_get_channel_rect (GstVvasXCompositor * self,
+ *                                                     guint chan_id,
+ *                                                     VvasScalerRect * src_rect,
+ *                                                     VvasScalerRect * dst_rect)
+ *  @param [in] self        - Handle to GstVvasXCompositor instance.
+ *  @param [in] chan_id     - Zorder of the channel.
+ *  @param [out] src_rect   - Region of the input frame to be composed.
+ *  @param [out] dst_rect   - Region of the output frame to compose into.
+ *  @return On Success returns TRUE\n On Failure returns FALSE
+ *  @brief  This function computes where the pad at zorder \p chan_id is placed on the output frame.
+ *  @details The frame members of \p src_rect and \p dst_rect are left untouched.
+ */
+static bool
+vvas_xcompositor_get_channel_rect (GstVvasXCompositor * self, guint chan_id,
+    VvasScalerRect * src_rect, VvasScalerRect * dst_rect)
+{
+  guint quad_in_each_row_column = (guint) ceil (sqrt (self->num_request_pads));
+  guint composition_output_height = 0, composition_output_width = 0;
+  gfloat in_width_scale_factor = 1, in_height_scale_factor = 1;
+  GstVvasXCompositorPrivate *priv = self->priv;
+  /* setting input output values based on zoder for that pad */
+  GstVvasXCompositorPad *pad;
+  uint32_t out_width = 0, out_height = 0;
+  uint32_t in_width, in_height;
+  uint32_t xpos_offset = 0;
+  uint32_t ypos_offset = 0;
+
+  in_width = priv->in_vinfo[self->priv->pad_of_zorder[chan_id]]->width;
+  in_height = priv->in_vinfo[self->priv->pad_of_zorder[chan_id]]->height;
+
+  pad = gst_vvas_xcompositor_sinkpad_at_index (self,
+      self->priv->pad_of_zorder[chan_id]);
+
+  composition_output_width = GST_VIDEO_INFO_WIDTH (self->priv->out_vinfo);
+  composition_output_height = GST_VIDEO_INFO_HEIGHT (self->priv->out_vinfo);
+
+  if (self->best_fit) {
+    guint quadrant_height, quadrant_width;
+    quadrant_width = (int) (composition_output_width / quad_in_each_row_column);
+    quadrant_height =
+        (int) (composition_output_height / quad_in_each_row_column);
+    out_width = quadrant_width;
+    out_height = quadrant_height;
+    xpos_offset = quadrant_width * (chan_id % quad_in_each_row_column);
+    ypos_offset = quadrant_height * (chan_id / quad_in_each_row_column);
+  } else {
+    if (pad->width != -1) {
+      out_width = pad->width;
+      if (pad->width < -1 || pad->width > composition_output_width
+          || pad->width == 0) {
+        GST_ERROR_OBJECT (self, "width of sink_%d is invalid",
+            self->priv->pad_of_zorder[chan_id]);
+        return false;
+      }
+    } else {
+      out_width = in_width;
+    }
+
+    if (pad->height != -1) {
+      out_height = pad->height;
+      if (pad->height < -1 || pad->height > composition_output_height
+          || pad->height == 0) {
+        GST_ERROR_OBJECT (self, "height of sink_%d is invalid",
+            self->priv->pad_of_zorder[chan_id]);
+        return false;
+      }
+    } else {
+      out_height = in_height;
+    }
+
+    xpos_offset = pad->xpos;
+    ypos_offset = pad->ypos;
+
+    if (xpos_offset > composition_output_width) {
+      GST_ERROR_OBJECT (self, "xpos of sink_%d is invalid",
+          self->priv->pad_of_zorder[chan_id]);
+      return false;
+    }
+    if (ypos_offset > composition_output_height) {
+      GST_ERROR_OBJECT (self, "ypos of sink_%d is invalid",
+          self->priv->pad_of_zorder[chan_id]);
+      return false;
+    }
+
+    /* cropping the image  at right corner if xpos exceeds output width */
+    if (xpos_offset + out_width > composition_output_width) {
+      in_width_scale_factor = ((float) in_width / out_width);
+      in_width =
+          (int) ((composition_output_width -
+              xpos_offset) * in_width_scale_factor);
+      out_width = composition_output_width - xpos_offset;
+    }
+    /* cropping the image  at bottom corner if ypos exceeds output height */
+    if (ypos_offset + out_height > composition_output_height) {
+      in_height_scale_factor = ((float) in_height / out_height);
+      in_height =
+          (int) ((composition_output_height -
+              ypos_offset) * in_height_scale_factor);
+      out_height = composition_output_height - ypos_offset;
+    }
+
+  }
+
+  GST_INFO_OBJECT (self,
+      "Height scale factor %f and Width scale factor %f ",
+      in_height_scale_factor, in_width_scale_factor);
+  GST_INFO_OBJECT (self, "Input height %d and width %d ", in_height, in_width);
+  GST_INFO_OBJECT (self,
+      "Aligned params are for sink_%d xpos %d ypos %d out_width %d out_height %d ",
+      self->priv->pad_of_zorder[chan_id], xpos_offset, ypos_offset,
+      out_width, out_height);
+
+  /* Fill rect parameters */
+  src_rect->x = 0;
+  src_rect->y = 0;
+  src_rect->width = in_width;
+  src_rect->height = in_height;
+
+  dst_rect->x = xpos_offset;
+  dst_rect->y = ypos_offset;
+  dst_rect->width = out_width;
+  dst_rect->height = out_height;
+
+  return true;
+}
+
 /**
  *  @fn static bool vvas_xcompsitor_add_processing_channels (GstVvasXCompositor * self)
  *  @param [in] self    - Handle to GstVvasXCompositor instance.
  *  @return On Success returns TRUE\n On Failure returns FALSE
  *  @brief  This function will add the channels into the VVAS CORE Scaler library for processing.
+ *  @details With persistent canvas, only the pads to be rendered are composed on the
+ *           canvas, which is the output frame.
  */
 static bool
 vvas_xcompsitor_add_processing_channels (GstVvasXCompositor * self)
 {
   guint chan_id;
-  guint quad_in_each_row_column = (guint) ceil (sqrt (self->num_request_pads));
-  guint composition_output_height = 0, composition_output_width = 0;
-  gfloat in_width_scale_factor = 1, in_height_scale_factor = 1;
   GstVvasXCompositorPrivate *priv = self->priv;
+  VvasReturnType vret;
 
   for (chan_id = 0; chan_id < self->num_request_pads; chan_id++) {
-    /* setting input output values based on zoder for that pad */
-    GstVvasXCompositorPad *pad;
-    uint32_t out_width = 0, out_height = 0;
-    uint32_t in_width, in_height;
-    uint32_t xpos_offset = 0;
-    uint32_t ypos_offset = 0;
+    guint pad_idx = self->priv->pad_of_zorder[chan_id];
     GstBuffer *input_buffer;
     GstVideoInfo *vinfo;
     VvasVideoFrame *input_frame;
-    VvasReturnType vret;
     VvasScalerRect src_rect = { 0 };
     VvasScalerRect dst_rect = { 0 };
 
-    in_width = priv->in_vinfo[self->priv->pad_of_zorder[chan_id]]->width;
-    in_height = priv->in_vinfo[self->priv->pad_of_zorder[chan_id]]->height;
+    if (self->persistent_canvas && !priv->render[pad_idx])
+      continue;
 
-    input_buffer = priv->inbufs[self->priv->pad_of_zorder[chan_id]];
-    vinfo = priv->in_vinfo[self->priv->pad_of_zorder[chan_id]];
+    input_buffer = priv->inbufs[pad_idx];
+    vinfo = priv->in_vinfo[pad_idx];
 
     /* Convert GstBuffer to VvasVideoFrame required for Vvas Core Scaler */
     input_frame = vvas_videoframe_from_gstbuffer (self->priv->vvas_ctx,
@@ -3191,103 +3456,13 @@ vvas_xcompsitor_add_processing_channels (GstVvasXCompositor * self)
       return FALSE;
     }
 
-    priv->input_frames[self->priv->pad_of_zorder[chan_id]] = input_frame;
-
-    pad = gst_vvas_xcompositor_sinkpad_at_index (self,
-        self->priv->pad_of_zorder[chan_id]);
+    priv->input_frames[pad_idx] = input_frame;
 
-    composition_output_width = GST_VIDEO_INFO_WIDTH (self->priv->out_vinfo);
-    composition_output_height = GST_VIDEO_INFO_HEIGHT (self->priv->out_vinfo);
+    if (!vvas_xcompositor_get_channel_rect (self, chan_id, &src_rect,
+            &dst_rect))
+      return false;
 
-    if (self->best_fit) {
-      guint quadrant_height, quadrant_width;
-      quadrant_width =
-          (int) (composition_output_width / quad_in_each_row_column);
-      quadrant_height =
-          (int) (composition_output_height / quad_in_each_row_column);
-      out_width = quadrant_width;
-      out_height = quadrant_height;
-      xpos_offset = quadrant_width * (chan_id % quad_in_each_row_column);
-      ypos_offset = quadrant_height * (chan_id / quad_in_each_row_column);
-    } else {
-      if (pad->width != -1) {
-        out_width = pad->width;
-        if (pad->width < -1 || pad->width > composition_output_width
-            || pad->width == 0) {
-          GST_ERROR_OBJECT (self, "width of sink_%d is invalid",
-              self->priv->pad_of_zorder[chan_id]);
-          return false;
-        }
-      } else {
-        out_width = in_width;
-      }
-
-      if (pad->height != -1) {
-        out_height = pad->height;
-        if (pad->height < -1 || pad->height > composition_output_height
-            || pad->height == 0) {
-          GST_ERROR_OBJECT (self, "height of sink_%d is invalid",
-              self->priv->pad_of_zorder[chan_id]);
-          return false;
-        }
-      } else {
-        out_height = in_height;
-      }
-
-      xpos_offset = pad->xpos;
-      ypos_offset = pad->ypos;
-
-      if (xpos_offset > composition_output_width) {
-        GST_ERROR_OBJECT (self, "xpos of sink_%d is invalid",
-            self->priv->pad_of_zorder[chan_id]);
-        return false;
-      }
-      if (ypos_offset > composition_output_height) {
-        GST_ERROR_OBJECT (self, "ypos of sink_%d is invalid",
-            self->priv->pad_of_zorder[chan_id]);
-        return false;
-      }
-
-      /* cropping the image  at right corner if xpos exceeds output width */
-      if (xpos_offset + out_width > composition_output_width) {
-        in_width_scale_factor = ((float) in_width / out_width);
-        in_width =
-            (int) ((composition_output_width -
-                xpos_offset) * in_width_scale_factor);
-        out_width = composition_output_width - xpos_offset;
-      }
-      /* cropping the image  at bottom corner if ypos exceeds output height */
-      if (ypos_offset + out_height > composition_output_height) {
-        in_height_scale_factor = ((float) in_height / out_height);
-        in_height =
-            (int) ((composition_output_height -
-                ypos_offset) * in_height_scale_factor);
-        out_height = composition_output_height - ypos_offset;
-      }
-
-    }
-
-    GST_INFO_OBJECT (self,
-        "Height scale factor %f and Width scale factor %f ",
-        in_height_scale_factor, in_width_scale_factor);
-    GST_INFO_OBJECT (self, "Input height %d and width %d ", in_height,
-        in_width);
-    GST_INFO_OBJECT (self,
-        "Aligned params are for sink_%d xpos %d ypos %d out_width %d out_height %d ",
-        self->priv->pad_of_zorder[chan_id], xpos_offset, ypos_offset,
-        out_width, out_height);
-
-    /* Fill rect parameters */
-    src_rect.x = 0;
-    src_rect.y = 0;
-    src_rect.width = in_width;
-    src_rect.height = in_height;
     src_rect.frame = input_frame;
-
-    dst_rect.x = xpos_offset;
-    dst_rect.y = ypos_offset;
-    dst_rect.width = out_width;
-    dst_rect.height = out_height;
     dst_rect.frame = priv->output_frame;
 
     /* Add processing channel into Core Scaler */
@@ -3301,6 +3476,7 @@ vvas_xcompsitor_add_processing_channels (GstVvasXCompositor * self)
     }
     GST_DEBUG_OBJECT (self, "Added processing channel for idx: %u", chan_id);
   }
+
   return TRUE;
 }
 
@@ -3318,6 +3494,19 @@ vvas_xcompositor_process (GstVvasXCompositor * self)
   bool ret;
   VvasReturnType vret;
 
+  if (priv->canvas) {
+    guint pad_idx;
+
+    for (pad_idx = 0; pad_idx < self->num_request_pads; pad_idx++)
+      if (priv->render[pad_idx])
+        break;
+
+    if (pad_idx == self->num_request_pads) {
+      GST_LOG_OBJECT (self, "canvas is up to date, nothing to compose");
+      return TRUE;
+    }
+  }
+
   /* Convert output GstBuffer to VvasVideoFrame */
   if (!self->software_scaling) {
     /* When we are working with hardware scaling no need to sync
@@ -3413,6 +3602,324 @@ vvas_xcompositor_get_empty_buffer (GstVvasXCompositor * self,
   gst_buffer_unref (*inbuf);
 }
 
+/**
+ *  @fn static void vvas_xcompositor_free_canvas (GstVvasXCompositor * self)
+ *  @param [in] self  - Handle that holds the GstVvasXCompositor instance.
+ *  @return None
+ *  @brief  Frees the persistent canvases and forgets the tiles composed on them.
+ *  @details Output buffers still downstream keep the memory of their canvas.
+ */
+static void
+vvas_xcompositor_free_canvas (GstVvasXCompositor * self)
+{
+  GstVvasXCompositorPrivate *priv = self->priv;
+  guint idx;
+
+  for (idx = 0; idx < priv->num_canvases; idx++)
+    gst_clear_buffer (&priv->canvases[idx].buffer);
+  memset (priv->canvases, 0x0, sizeof (priv->canvases));
+  priv->num_canvases = 0;
+  priv->canvas = NULL;
+
+  if (priv->canvas_pool) {
+    if (gst_buffer_pool_is_active (priv->canvas_pool))
+      gst_buffer_pool_set_active (priv->canvas_pool, FALSE);
+    gst_clear_object (&priv->canvas_pool);
+  }
+
+  for (idx = 0; idx < MAX_CHANNELS; idx++) {
+    gst_clear_buffer (&priv->canvas_inbufs[idx]);
+    priv->render_count[idx] = 0;
+  }
+  priv->canvas_num_tiles = 0;
+}
+
+/**
+ *  @fn static gboolean vvas_xcompositor_allocate_canvas_pool (GstVvasXCompositor * self)
+ *  @param [in] self  - Handle that holds the GstVvasXCompositor instance.
+ *  @return On Success returns TRUE\n
+ *          On Failure returns FALSE
+ *  @brief  Allocates the pool of the persistent canvases on which the tiles are composed.
+ *  @details In hardware scaling the canvases are allocated from device memory with
+ *           multiscaler alignment, so they never leave the device.
+ */
+static gboolean
+vvas_xcompositor_allocate_canvas_pool (GstVvasXCompositor * self)
+{
+  GstVvasXCompositorPrivate *priv = self->priv;
+  GstVideoInfo info = *priv->out_vinfo;
+  GstBufferPool *pool = NULL;
+  GstStructure *config;
+  GstCaps *caps;
+
+  caps = gst_video_info_to_caps (&info);
+
+  if (!self->software_scaling) {
+    GstAllocator *allocator;
+    GstAllocationParams alloc_params;
+    GstVideoAlignment align;
+
+    pool = gst_vvas_buffer_pool_new (WIDTH_ALIGN, HEIGHT_ALIGN);
+    config = gst_buffer_pool_get_config (pool);
+
+    gst_video_alignment_reset (&align);
+    align.padding_bottom =
+        ALIGN (GST_VIDEO_INFO_HEIGHT (&info),
+        HEIGHT_ALIGN) - GST_VIDEO_INFO_HEIGHT (&info);
+    for (int idx = 0; idx < GST_VIDEO_INFO_N_PLANES (&info); idx++) {
+      align.stride_align[idx] = (WIDTH_ALIGN - 1);
+    }
+    gst_video_info_align (&info, &align);
+
+    gst_buffer_pool_config_add_option (config,
+        GST_BUFFER_POOL_OPTION_VIDEO_ALIGNMENT);
+    gst_buffer_pool_config_set_video_alignment (config, &align);
+
+    allocator = gst_vvas_allocator_new (self->dev_index,
+        NEED_DMABUF, self->out_mem_bank);
+    gst_allocation_params_init (&alloc_params);
+    alloc_params.flags = GST_MEMORY_FLAG_PHYSICALLY_CONTIGUOUS;
+    alloc_params.flags |= GST_VVAS_ALLOCATOR_FLAG_MEM_INIT;
+    gst_buffer_pool_config_set_allocator (config, allocator, &alloc_params);
+    gst_object_unref (allocator);
+  } else {
+    pool = gst_video_buffer_pool_new ();
+    config = gst_buffer_pool_get_config (pool);
+  }
+
+  /* canvases are held for the lifetime of the negotiated caps */
+  gst_buffer_pool_config_set_params (config, caps, GST_VIDEO_INFO_SIZE (&info),
+      0, VVAS_XCOMPOSITOR_MAX_CANVASES);
+  gst_buffer_pool_config_add_option (config, GST_BUFFER_POOL_OPTION_VIDEO_META);
+  gst_caps_unref (caps);
+
+  if (!gst_buffer_pool_set_config (pool, config)) {
+    GST_ERROR_OBJECT (self, "Failed to set config on canvas pool");
+    gst_object_unref (pool);
+    return FALSE;
+  }
+
+  if (!gst_buffer_pool_set_active (pool, TRUE)) {
+    GST_ERROR_OBJECT (self, "failed to activate canvas pool");
+    gst_object_unref (pool);
+    return FALSE;
+  }
+
+  priv->canvas_pool = pool;
+  GST_INFO_OBJECT (self, "allocated canvas pool %" GST_PTR_FORMAT, pool);
+
+  return TRUE;
+}
+
+/**
+ *  @fn static gboolean vvas_xcompositor_get_canvas (GstVvasXCompositor * self,
+ *                                                   VvasXCompositorCanvas ** canvas)
+ *  @param [in] self      - Handle that holds the GstVvasXCompositor instance.
+ *  @param [out] canvas   - Canvas to compose on, NULL when all of them are still
+ *                          used downstream.
+ *  @return On Success returns TRUE\n
+ *          On Failure returns FALSE
+ *  @brief  Picks the canvas to compose the next output frame on.
+ *  @details A canvas is free once downstream released the last output buffer sharing
+ *           its memory. The most recently composed free canvas is preferred as it has
+ *           the fewest tiles to compose again.
+ */
+static gboolean
+vvas_xcompositor_get_canvas (GstVvasXCompositor * self,
+    VvasXCompositorCanvas ** canvas)
+{
+  GstVvasXCompositorPrivate *priv = self->priv;
+  VvasXCompositorCanvas *free_canvas = NULL;
+  GstFlowReturn fret;
+  guint idx;
+
+  for (idx = 0; idx < priv->num_canvases; idx++) {
+    VvasXCompositorCanvas *cur = &priv->canvases[idx];
+
+    if (!gst_buffer_is_all_memory_writable (cur->buffer))
+      continue;
+    if (!free_canvas || cur->age > free_canvas->age)
+      free_canvas = cur;
+  }
+
+  if (free_canvas || priv->num_canvases == VVAS_XCOMPOSITOR_MAX_CANVASES) {
+    if (!free_canvas)
+      GST_LOG_OBJECT (self, "all %u canvases are still used downstream",
+          priv->num_canvases);
+    *canvas = free_canvas;
+    return TRUE;
+  }
+
+  if (!priv->canvas_pool && !vvas_xcompositor_allocate_canvas_pool (self))
+    return FALSE;
+
+  free_canvas = &priv->canvases[priv->num_canvases];
+  fret = gst_buffer_pool_acquire_buffer (priv->canvas_pool,
+      &free_canvas->buffer, NULL);
+  if (fret != GST_FLOW_OK) {
+    GST_ERROR_OBJECT (self, "failed to allocate canvas from pool %p",
+        priv->canvas_pool);
+    return FALSE;
+  }
+  /* nothing is composed on the new canvas yet */
+  free_canvas->layout = 0;
+  free_canvas->age = 0;
+  priv->num_canvases++;
+  GST_INFO_OBJECT (self, "allocated canvas %u: %p", priv->num_canvases,
+      free_canvas->buffer);
+
+  *canvas = free_canvas;
+  return TRUE;
+}
+
+/**
+ *  @fn static gboolean vvas_xcompositor_clear_canvas (GstVvasXCompositor * self,
+ *                                                     VvasXCompositorCanvas * canvas)
+ *  @param [in] self    - Handle that holds the GstVvasXCompositor instance.
+ *  @param [in] canvas  - Canvas to clear.
+ *  @return On Success returns TRUE\n
+ *          On Failure returns FALSE
+ *  @brief  Clears the background of a persistent canvas.
+ */
+static gboolean
+vvas_xcompositor_clear_canvas (GstVvasXCompositor * self,
+    VvasXCompositorCanvas * canvas)
+{
+  GstVvasXCompositorPrivate *priv = self->priv;
+  GstMapInfo info;
+
+  if (!gst_buffer_map (canvas->buffer, &info, GST_MAP_WRITE)) {
+    GST_ERROR_OBJECT (self, "failed to map canvas");
+    return FALSE;
+  }
+  memset (info.data, 0x00, info.size);
+  gst_buffer_unmap (canvas->buffer, &info);
+
+  if (!self->software_scaling) {
+    GstMemory *mem = gst_buffer_peek_memory (canvas->buffer, 0);
+
+    /* tiles are composed by the kernel from now on */
+    if (!gst_vvas_memory_sync_bo_full (mem, &priv->mem_stats)) {
+      GST_ERROR_OBJECT (self, "failed to sync canvas to device");
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ *  @fn static inline gboolean vvas_xcompositor_tiles_overlap (const VvasXCompositorTile * a,
+ *                                                             const VvasXCompositorTile * b)
+ *  @param [in] a   - First tile.
+ *  @param [in] b   - Second tile.
+ *  @return TRUE if the tiles overlap, FALSE otherwise
+ *  @brief  Checks whether two tiles of the composed frame overlap.
+ */
+static inline gboolean
+vvas_xcompositor_tiles_overlap (const VvasXCompositorTile * a,
+    const VvasXCompositorTile * b)
+{
+  return a->x < b->x + b->width && b->x < a->x + a->width &&
+      a->y < b->y + b->height && b->y < a->y + a->height;
+}
+
+/**
+ *  @fn static gboolean vvas_xcompositor_update_damage (GstVvasXCompositor * self,
+ *                                                      GstBuffer ** new_inbufs)
+ *  @param [in] self        - Handle that holds the GstVvasXCompositor instance.
+ *  @param [in] new_inbufs  - Buffers prepared on each sink pad for this aggregation,
+ *                            NULL for pads without any.
+ *  @return On Success returns TRUE\n
+ *          On Failure returns FALSE
+ *  @brief  Decides which pads have to be composed again on the canvas of this aggregation.
+ *  @details A pad is rendered when the canvas does not hold its latest content yet.
+ *           Tiles above a rendered tile in zorder which overlap it are rendered too,
+ *           as composing the lower tile overwrites them. A canvas composed with another
+ *           layout is cleared and all the pads are rendered, as are all the pads when
+ *           no canvas is free.
+ */
+static gboolean
+vvas_xcompositor_update_damage (GstVvasXCompositor * self,
+    GstBuffer ** new_inbufs)
+{
+  GstVvasXCompositorPrivate *priv = self->priv;
+  VvasXCompositorCanvas *canvas = priv->canvas;
+  VvasXCompositorTile tiles[MAX_CHANNELS];
+  /* pipelined input copies deliver the frame of the previous aggregation */
+  guint render_times = self->enabled_pipeline ? 2 : 1;
+  gboolean layout_changed, full_redraw;
+  guint chan_id, lower, pad_idx, num_render = 0;
+
+  memset (tiles, 0x0, sizeof (tiles));
+  layout_changed = (priv->canvas_num_tiles != self->num_request_pads);
+
+  for (chan_id = 0; chan_id < self->num_request_pads; chan_id++) {
+    VvasScalerRect src_rect = { 0 };
+    VvasScalerRect dst_rect = { 0 };
+
+    if (!vvas_xcompositor_get_channel_rect (self, chan_id, &src_rect,
+            &dst_rect))
+      return FALSE;
+
+    tiles[chan_id].pad_idx = priv->pad_of_zorder[chan_id];
+    tiles[chan_id].x = dst_rect.x;
+    tiles[chan_id].y = dst_rect.y;
+    tiles[chan_id].width = dst_rect.width;
+    tiles[chan_id].height = dst_rect.height;
+
+    if (memcmp (&tiles[chan_id], &priv->canvas_tiles[chan_id],
+            sizeof (VvasXCompositorTile)))
+      layout_changed = TRUE;
+  }
+
+  if (layout_changed) {
+    GST_DEBUG_OBJECT (self, "layout changed, canvases are composed again");
+    memcpy (priv->canvas_tiles, tiles, sizeof (tiles));
+    priv->canvas_num_tiles = self->num_request_pads;
+    priv->layout++;
+  }
+
+  for (pad_idx = 0; pad_idx < self->num_request_pads; pad_idx++) {
+    /* reference is held, so a different pointer is always a new buffer */
+    if (new_inbufs[pad_idx] != priv->canvas_inbufs[pad_idx]) {
+      gst_buffer_replace (&priv->canvas_inbufs[pad_idx], new_inbufs[pad_idx]);
+      priv->render_count[pad_idx] = render_times;
+    }
+
+    if (priv->render_count[pad_idx]) {
+      priv->content[pad_idx]++;
+      priv->render_count[pad_idx]--;
+    }
+  }
+
+  full_redraw = !canvas || canvas->layout != priv->layout;
+  if (canvas && full_redraw && !vvas_xcompositor_clear_canvas (self, canvas))
+    return FALSE;
+
+  for (pad_idx = 0; pad_idx < self->num_request_pads; pad_idx++)
+    priv->render[pad_idx] = full_redraw ||
+        canvas->content[pad_idx] != priv->content[pad_idx];
+
+  for (chan_id = 0; chan_id < self->num_request_pads; chan_id++) {
+    pad_idx = tiles[chan_id].pad_idx;
+
+    for (lower = 0; lower < chan_id && !priv->render[pad_idx]; lower++) {
+      if (priv->render[tiles[lower].pad_idx] &&
+          vvas_xcompositor_tiles_overlap (&tiles[lower], &tiles[chan_id]))
+        priv->render[pad_idx] = TRUE;
+    }
+
+    if (priv->render[pad_idx])
+      num_render++;
+  }
+
+  GST_LOG_OBJECT (self, "rendering %u of %u tiles on canvas %p", num_render,
+      self->num_request_pads, canvas ? canvas->buffer : NULL);
+
+  return TRUE;
+}
+
 /**
  *  @fn static GstFlowReturn  gst_vvas_xcompositor_create_output_buffer (GstVideoAggregator * videoaggregator,
  *                                                                       GstBuffer ** outbuf)
@@ -3423,7 +3930,8 @@ vvas_xcompositor_get_empty_buffer (GstVvasXCompositor * self,
  *  @brief  This is a callback function which provides output buffer.
  *  @details This is a callback function which is called by
  *           VideoAggregator class provides output buffer to be used as @outbuffer of
- *           the gst_vvas_xcompositor_aggregate_frames method.
+ *           the gst_vvas_xcompositor_aggregate_frames method. With persistent canvas,
+ *           the output buffer is empty and gets the memory of the canvas once composed.
  */
 static GstFlowReturn
 gst_vvas_xcompositor_create_output_buffer (GstVideoAggregator * videoaggregator,
@@ -3434,6 +3942,17 @@ gst_vvas_xcompositor_create_output_buffer (GstVideoAggregator * videoaggregator,
   GstFlowReturn ret = GST_FLOW_OK;
   GstVvasXCompositor *self = GST_VVAS_XCOMPOSITOR (videoaggregator);
 
+  if (self->persistent_canvas) {
+    if (!vvas_xcompositor_get_canvas (self, &self->priv->canvas))
+      return GST_FLOW_ERROR;
+
+    /* canvas is copied on to the output buffer when a copy is needed */
+    if (self->priv->canvas && !self->priv->need_copy) {
+      *outbuf = gst_buffer_new ();
+      return GST_FLOW_OK;
+    }
+  }
+
   pool = gst_aggregator_get_buffer_pool (aggregator);
 
   /* Allocate buffers from the pool */
@@ -3493,6 +4012,9 @@ gst_vvas_xcompositor_aggregate_frames (GstVideoAggregator * vagg,
   GstFlowReturn fret = GST_FLOW_OK;
   gboolean bret = FALSE;
   guint pad_id = 0;
+  guint num_prepared = 0;
+  GstBuffer *new_inbufs[MAX_CHANNELS] = { NULL };
+
   for (list = self->sinkpads; list; list = list->next) {
     GstVideoAggregatorPad *pad = list->data;
     GstVvasXCompositorPad *sinkpad = (GstVvasXCompositorPad *) pad;
@@ -3516,11 +4038,33 @@ gst_vvas_xcompositor_aggregate_frames (GstVideoAggregator * vagg,
           &self->priv->inbufs[pad_id]);
     } else {
       self->priv->inbufs[pad_id] = prepared_frame->buffer;
+      new_inbufs[pad_id] = prepared_frame->buffer;
     }
-    /* Lets go with incoming buffer itself, as we don't have any stride alignment
-     * requirement for software scaling.
-     */
-    if (!self->software_scaling) {
+
+    pad_id++;
+  }
+
+  if (self->persistent_canvas) {
+    /* Find out the tiles which are to be composed again */
+    if (!vvas_xcompositor_update_damage (self, new_inbufs))
+      goto error;
+  }
+
+  /* Lets go with incoming buffer itself, as we don't have any stride alignment
+   * requirement for software scaling.
+   */
+  if (!self->software_scaling) {
+    for (pad_id = 0; pad_id < self->num_request_pads; pad_id++) {
+      GstVvasXCompositorPad *sinkpad =
+          gst_vvas_xcompositor_sinkpad_at_index (self, pad_id);
+
+      if (self->persistent_canvas && !self->priv->render[pad_id]) {
+        /* tile on the canvas is up to date */
+        self->priv->inbufs[pad_id] = NULL;
+        num_prepared++;
+        continue;
+      }
+
       /* prepare input buffer from the data on sinkpad */
       bret =
           vvas_xcompositor_prepare_input_buffer (self, sinkpad,
@@ -3528,9 +4072,8 @@ gst_vvas_xcompositor_aggregate_frames (GstVideoAggregator * vagg,
 
       if (!bret)
         goto error;
+      num_prepared++;
     }
-
-    pad_id++;
   }
   /* Lets go with the decided output software buffer itself, as we don't
    * have any stride alignment requirement for software scaling and memset
@@ -3541,7 +4084,12 @@ gst_vvas_xcompositor_aggregate_frames (GstVideoAggregator * vagg,
   /** Creating a hw multi scaler aligned buffer, as the default buffer allocated is
    *  unaligned to multiscaler if the downstream does not understand video meta
    */
-    if (self->priv->need_copy && self->priv->output_pool) {
+    if (self->priv->canvas) {
+      /* Compose on the canvas, which is already multiscaler aligned */
+      bret =
+          vvas_xcompositor_prepare_output_buffer (self,
+          self->priv->canvas->buffer);
+    } else if (self->priv->need_copy && self->priv->output_pool) {
       GstBuffer *aligned_buffer = NULL;
       if (!gst_buffer_pool_is_active (self->priv->output_pool)) {
         if (!gst_buffer_pool_set_active (self->priv->output_pool, TRUE)) {
@@ -3572,12 +4120,17 @@ gst_vvas_xcompositor_aggregate_frames (GstVideoAggregator * vagg,
     if (!bret)
       goto error;
   } else {
-    /* memset the output software buffer */
-    GstMapInfo info;
-    gst_buffer_map (outbuf, &info, GST_MAP_WRITE);
-    memset (info.data, 0x00, info.size);
-    gst_buffer_unmap (outbuf, &info);
-    self->priv->outbuf = outbuf;
+    /* memset the output software buffer, the background of a canvas is
+     * cleared only when its layout changes */
+    if (self->priv->canvas) {
+      self->priv->outbuf = self->priv->canvas->buffer;
+    } else {
+      GstMapInfo info;
+      gst_buffer_map (outbuf, &info, GST_MAP_WRITE);
+      memset (info.data, 0x00, info.size);
+      gst_buffer_unmap (outbuf, &info);
+      self->priv->outbuf = outbuf;
+    }
   }
 
   /** Aggregate the frames using multi scaler kernel after
@@ -3586,6 +4139,22 @@ gst_vvas_xcompositor_aggregate_frames (GstVideoAggregator * vagg,
   bret = vvas_xcompositor_process (self);
   if (!bret)
     goto error;
+
+  if (self->priv->canvas) {
+    VvasXCompositorCanvas *canvas = self->priv->canvas;
+
+    /* canvas holds the latest content of all the pads now */
+    canvas->layout = self->priv->layout;
+    memcpy (canvas->content, self->priv->content, sizeof (canvas->content));
+    canvas->age = ++self->priv->aggregations;
+
+    /* Push the canvas memory itself. As it is shared, downstream writing to
+     * it gets a copy and the canvas is composed again only once released */
+    if (!self->priv->need_copy)
+      gst_buffer_copy_into (outbuf, canvas->buffer,
+          GST_BUFFER_COPY_MEMORY | GST_BUFFER_COPY_META, 0, -1);
+  }
+
   /* If copy is needed, copy the aligned buffer' s data to unaligned buffer */
   if (self->priv->need_copy) {
     GstVideoFrame new_frame, out_frame;
@@ -3601,12 +4170,19 @@ gst_vvas_xcompositor_aggregate_frames (GstVideoAggregator * vagg,
     gst_video_frame_copy (&new_frame, &out_frame);
     gst_video_frame_unmap (&out_frame);
     gst_video_frame_unmap (&new_frame);
-
-    gst_buffer_copy_into (outbuf, self->priv->outbuf,
-        GST_BUFFER_COPY_METADATA | GST_BUFFER_COPY_TIMESTAMPS |
-        GST_BUFFER_COPY_FLAGS, 0, -1);
-    if (self->priv->outbuf)
-      gst_buffer_unref (self->priv->outbuf);
+    /* downstream can not handle the stride required by the kernel */
+    gst_vvas_mem_stats_add_copy (&self->priv->mem_stats,
+        GST_VVAS_COPY_REASON_STRIDE,
+        GST_VIDEO_INFO_SIZE (self->priv->out_vinfo));
+
+    /* canvas is kept and its metadata is not the one of outbuf */
+    if (!self->priv->canvas) {
+      gst_buffer_copy_into (outbuf, self->priv->outbuf,
+          GST_BUFFER_COPY_METADATA | GST_BUFFER_COPY_TIMESTAMPS |
+          GST_BUFFER_COPY_FLAGS, 0, -1);
+      if (self->priv->outbuf)
+        gst_buffer_unref (self->priv->outbuf);
+    }
   }
 
   GST_LOG_OBJECT (self,
@@ -3622,23 +4198,31 @@ gst_vvas_xcompositor_aggregate_frames (GstVideoAggregator * vagg,
    * So no need to unref in sw scaling as we are not calling prepatre_input_buffer function */
   if (!self->software_scaling) {
     for (pad_id = 0; pad_id < self->num_request_pads; pad_id++) {
-      gst_buffer_unref (self->priv->inbufs[pad_id]);
+      if (self->priv->inbufs[pad_id])
+        gst_buffer_unref (self->priv->inbufs[pad_id]);
     }
   }
 
   vvas_xcompositor_free_vvas_video_frame (self);
+  self->priv->canvas = NULL;
   return GST_FLOW_OK;
 
 error:
   fret = GST_FLOW_ERROR;
   vvas_xcompositor_free_vvas_video_frame (self);
+  /* tiles may be half composed, compose the whole canvas next time */
+  if (self->priv->canvas) {
+    self->priv->canvas->layout = 0;
+    self->priv->canvas = NULL;
+  }
   /* In case of hw scaling we are increasing the
    * ref count of input buffer in prepare_input_buffer function
    * and unreffing after usage.
    * So no need to unref in sw scaling as we are not calling prepatre_input_buffer function */
   if (!self->software_scaling) {
-    for (pad_id = 0; pad_id < self->num_request_pads; pad_id++)
-      gst_buffer_unref (self->priv->inbufs[pad_id]);
+    for (pad_id = 0; pad_id < num_prepared; pad_id++)
+      if (self->priv->inbufs[pad_id])
+        gst_buffer_unref (self->priv->inbufs[pad_id]);
   }
   return fret;
 }
@@ -3705,6 +4289,13 @@ gst_vvas_xcompositor_get_property (GObject * object, guint prop_id,
     case PROP_SOFTWARE_SCALING:
       g_value_set_boolean (value, self->software_scaling);
       break;
+    case PROP_PERSISTENT_CANVAS:
+      g_value_set_boolean (value, self->persistent_canvas);
+      break;
+    case PROP_MEM_STATS:
+      g_value_take_boxed (value,
+          gst_vvas_mem_stats_to_structure (&self->priv->mem_stats));
+      break;
 #ifdef ENABLE_XRM_SUPPORT
     case PROP_RESERVATION_ID:
       g_value_set_uint64 (value, self->priv->reservation_id);
@@ -3794,6 +4385,9 @@ gst_vvas_xcompositor_set_property (GObject * object, guint prop_id,
     case PROP_SOFTWARE_SCALING:
       self->software_scaling = g_value_get_boolean (value);
       break;
+    case PROP_PERSISTENT_CANVAS:
+      self->persistent_canvas = g_value_get_boolean (value);
+      break;
 #ifdef ENABLE_XRM_SUPPORT
     case PROP_RESERVATION_ID:
       self->priv->reservation_id = g_value_get_uint64 (value);
@@ -3921,6 +4515,10 @@ gst_vvas_xcompositor_start (GstAggregator * agg)
 static gboolean
 gst_vvas_xcompositor_stop (GstAggregator * agg)
 {
+  GstVvasXCompositor *self = GST_VVAS_XCOMPOSITOR (agg);
+
+  /* release the canvas and the input buffers referred by it */
+  vvas_xcompositor_free_canvas (self);
   return TRUE;
 }
 
@@ -125,6 +125,8 @@ struct _GstVvasXCompositor
   gboolean enabled_pipeline;
   /** Flag to enable software scaling flow */
   gboolean software_scaling;
+  /** Flag to keep the composed frame and re-render only updated tiles */
+  gboolean persistent_canvas;
 };
 
 struct _GstVvasXCompositorClass
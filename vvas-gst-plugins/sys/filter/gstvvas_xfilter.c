@@ -35,6 +35,7 @@
 #include <gst/gst.h>
 #include <gst/vvas/gstvvasallocator.h>
 #include <gst/vvas/gstvvasbufferpool.h>
+#include <gst/vvas/gstvvastrace.h>
 #include <gst/allocators/gstdmabuf.h>
 #include <dlfcn.h>              /* for dlXXX APIs */
 #include <sys/mman.h>           /* for munmap */
@@ -112,6 +113,7 @@ enum
   PROP_DEVICE_INDEX,
   PROP_SK_CURRENT_INDEX,
 #endif
+  PROP_MEM_STATS,
 };
 
 typedef enum
@@ -144,6 +146,8 @@ struct _GstVvas_XFilterPrivate
 #ifdef XLNX_PCIe_PLATFORM
   gint sk_cur_idx;
 #endif                          /* XLNX_PCIe_PLATFORM */
+  GstVvasMemStats mem_stats;
+  GstVvasCopyReason in_copy_reason;
 };
 
 static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
@@ -183,6 +187,8 @@ static GstFlowReturn
 gst_vvas_xfilter_transform (GstBaseTransform * base, GstBuffer * inbuf,
     GstBuffer * outbuf);
 static void gst_vvas_xfilter_finalize (GObject * obj);
+static gboolean gst_vvas_xfilter_sink_event (GstBaseTransform * trans,
+    GstEvent * event);
 
 static Vvas_XFilterMode
 get_kernel_mode (const gchar * mode)
@@ -1761,6 +1767,7 @@ gst_vvas_xfilter_class_init (GstVvas_XFilterClass * klass)
   transform_class->generate_output = gst_vvas_xfilter_generate_output;
   transform_class->transform_ip = gst_vvas_xfilter_transform_ip;
   transform_class->transform = gst_vvas_xfilter_transform;
+  transform_class->sink_event = gst_vvas_xfilter_sink_event;
 
   g_object_class_install_property (gobject_class, PROP_CONFIG_LOCATION,
       g_param_spec_string ("kernels-config",
@@ -1787,6 +1794,12 @@ gst_vvas_xfilter_class_init (GstVvas_XFilterClass * klass)
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 #endif
 
+  g_object_class_install_property (gobject_class, PROP_MEM_STATS,
+      g_param_spec_boxed ("mem-stats", "Memory transfer statistics",
+          "DMA transfers and slow copies done by the element with the reason "
+          "of each copy", GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_details_simple (gstelement_class,
       "VVAS Generic Filter Plugin",
       "Filter/Effect/Video",
@@ -1825,6 +1838,7 @@ gst_vvas_xfilter_init (GstVvas_XFilter * self)
   priv->need_copy = FALSE;
   priv->dyn_json_config = NULL;
   priv->kern_handle = NULL;
+  gst_vvas_mem_stats_init (&priv->mem_stats);
 }
 
 static void
@@ -1885,6 +1899,10 @@ gst_vvas_xfilter_get_property (GObject * object, guint prop_id, GValue * value,
       g_value_set_int (value, self->priv->dev_idx);
       break;
 #endif
+    case PROP_MEM_STATS:
+      g_value_take_boxed (value,
+          gst_vvas_mem_stats_to_structure (&self->priv->mem_stats));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1908,13 +1926,25 @@ gst_vvas_xfilter_finalize (GObject * obj)
     g_free (self->dyn_config);
   if (self->priv->dyn_json_config)
     json_decref (self->priv->dyn_json_config);
+  gst_vvas_mem_stats_clear (&self->priv->mem_stats);
 
   G_OBJECT_CLASS (parent_class)->finalize (obj);
 }
 
+static gboolean
+gst_vvas_xfilter_sink_event (GstBaseTransform * trans, GstEvent * event)
+{
+  GstVvas_XFilter *self = GST_VVAS_XFILTER (trans);
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_EOS)
+    gst_vvas_mem_stats_dump (&self->priv->mem_stats, GST_ELEMENT (self));
+
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->sink_event (trans, event);
+}
+
 static gboolean
 vvas_xfilter_copy_input_buffer (GstVvas_XFilter * self, GstBuffer * inbuf,
-    GstBuffer ** internal_inbuf)
+    GstBuffer ** internal_inbuf, GstVvasCopyReason reason)
 {
   GstBuffer *new_inbuf;
   GstFlowReturn fret;
@@ -1961,6 +1991,9 @@ vvas_xfilter_copy_input_buffer (GstVvas_XFilter * self, GstBuffer * inbuf,
       "slow copy to internal buffer");
 
   gst_video_frame_copy (&new_vframe, &in_vframe);
+  gst_vvas_mem_stats_add_copy (&self->priv->mem_stats, reason,
+      GST_VIDEO_INFO_SIZE (self->priv->in_vinfo));
+  self->priv->in_copy_reason = reason;
   gst_video_frame_unmap (&in_vframe);
   gst_video_frame_unmap (&new_vframe);
   gst_buffer_copy_into (new_inbuf, inbuf,
@@ -2081,6 +2114,7 @@ vvas_xfilter_prepare_input_frame (GstVvas_XFilter * self, GstBuffer * inbuf,
   GstMapFlags map_flags;
   guint stride;
   gboolean use_inpool = FALSE;
+  GstVvasCopyReason reason;
 
   use_inpool = vvas_xfilter_validate_inbuf (self, inbuf, &stride);
   GST_LOG_OBJECT (self, "use inpool = %d and stride = %d", use_inpool, stride);
@@ -2133,7 +2167,13 @@ vvas_xfilter_prepare_input_frame (GstVvas_XFilter * self, GstBuffer * inbuf,
     if (!phy_addr || use_inpool == TRUE) {
       GST_DEBUG_OBJECT (self,
           "could not get phy_addr, copy input buffer to internal pool buffer");
-      bret = vvas_xfilter_copy_input_buffer (self, inbuf, new_inbuf);
+      if (use_inpool)
+        reason = GST_VVAS_COPY_REASON_STRIDE;
+      else if (gst_is_vvas_memory (in_mem))
+        reason = GST_VVAS_COPY_REASON_BANK_MISMATCH;
+      else
+        reason = GST_VVAS_COPY_REASON_FOREIGN_MEMORY;
+      bret = vvas_xfilter_copy_input_buffer (self, inbuf, new_inbuf, reason);
       if (!bret)
         goto error;
 
@@ -2161,7 +2201,7 @@ vvas_xfilter_prepare_input_frame (GstVvas_XFilter * self, GstBuffer * inbuf,
       inbuf = *new_inbuf;
     }
     /* syncs data when VVAS_SYNC_TO_DEVICE flag is enabled */
-    bret = gst_vvas_memory_sync_bo (in_mem);
+    bret = gst_vvas_memory_sync_bo_full (in_mem, &priv->mem_stats);
     if (!bret)
       goto error;
 
@@ -2174,7 +2214,8 @@ vvas_xfilter_prepare_input_frame (GstVvas_XFilter * self, GstBuffer * inbuf,
     if (use_inpool) {
       /* If it is a soft-ip xfilter is using s/w video buffer pool
        * sync bo is not required as the memory is not a vvas memory */
-      bret = vvas_xfilter_copy_input_buffer (self, inbuf, new_inbuf);
+      bret = vvas_xfilter_copy_input_buffer (self, inbuf, new_inbuf,
+          GST_VVAS_COPY_REASON_STRIDE);
       if (!bret) {
         GST_ERROR_OBJECT (self, "failed to copy input buffer");
         goto error;
@@ -2442,6 +2483,7 @@ gst_vvas_xfilter_generate_output (GstBaseTransform * trans, GstBuffer ** outbuf)
   GstBuffer *cur_outbuf = NULL;
   guint plane_id = 0;
   gboolean need_inplace_copy = false;
+  GstClockTime trace_ts;
 
   *outbuf = NULL;
 
@@ -2505,7 +2547,7 @@ gst_vvas_xfilter_generate_output (GstBaseTransform * trans, GstBuffer ** outbuf)
       }
       if (!(self->priv->kernel->name || self->priv->kernel->is_softkernel)) {
         gst_vvas_memory_set_sync_flag (outmem, VVAS_SYNC_TO_DEVICE);
-        bret = gst_vvas_memory_sync_bo (outmem);
+        bret = gst_vvas_memory_sync_bo_full (outmem, &priv->mem_stats);
         if (!bret)
           goto exit;
       } else
@@ -2518,6 +2560,7 @@ gst_vvas_xfilter_generate_output (GstBaseTransform * trans, GstBuffer ** outbuf)
   /* update dynamic json config to kernel */
   kernel->vvas_handle->kernel_dyn_config = priv->dyn_json_config;
 
+  trace_ts = gst_vvas_trace_start ();
   ret = kernel->kernel_start_func (kernel->vvas_handle, 0, kernel->input,
       kernel->output);
   if (ret < 0) {
@@ -2532,6 +2575,8 @@ gst_vvas_xfilter_generate_output (GstBaseTransform * trans, GstBuffer ** outbuf)
     fret = GST_FLOW_ERROR;
     goto exit;
   }
+  gst_vvas_trace_stop (GST_OBJECT (self), GST_VVAS_TRACE_KERNEL_TIME,
+      trace_ts);
 #ifdef XLNX_PCIe_PLATFORM
   /* If Hard IP/Soft kernel is accessing the buffer in place, then
      sync the buffer from device as the buffer has been modified by the IP */
@@ -2582,6 +2627,8 @@ gst_vvas_xfilter_generate_output (GstBaseTransform * trans, GstBuffer ** outbuf)
     GST_CAT_LOG_OBJECT (GST_CAT_PERFORMANCE, self,
         "slow copy data from %p to %p", new_inbuf, inbuf);
     gst_video_frame_copy (&inbuf_vframe, &newinbuf_vframe);
+    gst_vvas_mem_stats_add_copy (&priv->mem_stats, priv->in_copy_reason,
+        GST_VIDEO_INFO_SIZE (priv->in_vinfo));
     gst_video_frame_unmap (&inbuf_vframe);
     gst_video_frame_unmap (&newinbuf_vframe);
 
@@ -2622,6 +2669,9 @@ gst_vvas_xfilter_generate_output (GstBaseTransform * trans, GstBuffer ** outbuf)
     gst_video_frame_copy (&new_frame, &out_frame);
     gst_video_frame_unmap (&out_frame);
     gst_video_frame_unmap (&new_frame);
+    /* downstream neither accepts our alignment nor video meta */
+    gst_vvas_mem_stats_add_copy (&priv->mem_stats,
+        GST_VVAS_COPY_REASON_STRIDE, GST_VIDEO_INFO_SIZE (priv->out_vinfo));
 
     gst_buffer_copy_into (new_outbuf, cur_outbuf, GST_BUFFER_COPY_FLAGS, 0, -1);
     gst_buffer_unref (cur_outbuf);
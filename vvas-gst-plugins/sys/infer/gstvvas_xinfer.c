@@ -41,6 +41,7 @@
 #include <gst/gst.h>
 #include <gst/vvas/gstvvasallocator.h>
 #include <gst/vvas/gstvvasbufferpool.h>
+#include <gst/vvas/gstvvastrace.h>
 #include <gst/allocators/gstdmabuf.h>
 #include <dlfcn.h>              /* for dlXXX APIs */
 #include <sys/mman.h>           /* for munmap */
@@ -54,8 +55,11 @@
 #endif
 #include <vvas/vvas_kernel.h>
 #include "gstvvas_xinfer.h"
+#include "vvas_xinfer_project.h"
 #include <gst/vvas/gstvvasutils.h>
 #include <gst/vvas/gstinferencemeta.h>
+#include <gst/vvas/gstvvassrcidmeta.h>
+#include <gst/vvas/gstvvascommon.h>
 
 #include <vvas_core/vvas_log.h>
 #include <vvas_core/vvas_context.h>
@@ -151,6 +155,32 @@ GST_DEBUG_CATEGORY_STATIC (GST_CAT_PERFORMANCE);
  *   */
 #define DEFAULT_BATCH_SUBMIT_TIMEOUT  2000
 
+/** @def DEFAULT_LATENCY_BUDGET
+ *  *  @brief Latency budget in milliseconds, 0 disables deadline based skipping
+ *   */
+#define DEFAULT_LATENCY_BUDGET  0
+
+/** @def DEFAULT_BATCH_SCHEDULING
+ *  @brief Batches are filled in arrival order by default
+ */
+#define DEFAULT_BATCH_SCHEDULING GST_VVAS_XINFER_SCHEDULING_FIFO
+
+/** @def DEFAULT_MAX_SOURCE_QUEUE
+ *  @brief Frames of a source allowed in infer queue, 0 means no limit
+ */
+#define DEFAULT_MAX_SOURCE_QUEUE 0
+
+/** @def GST_TYPE_VVAS_XINFER_SCHEDULING
+ *  @brief Get GstVvasXInferScheduling GType
+ */
+#define GST_TYPE_VVAS_XINFER_SCHEDULING (vvas_xinfer_scheduling_get_type ())
+
+/** @def VVAS_XINFER_SRC_ACTIVE_WINDOW
+ *  @brief Sources which did not send a frame for this long are not
+ *         considered while sharing the skipped frames among sources
+ */
+#define VVAS_XINFER_SRC_ACTIVE_WINDOW GST_SECOND
+
 #include <vvas_core/vvas_device.h>
 
 GQuark _scale_quark;
@@ -188,6 +218,37 @@ typedef struct
   void *handle;
 } VvasCoreModule;
 
+/** @struct Vvas_XInferRunner
+ *  @brief  DPU inference handle along with the configuration it is created
+ *          with, so that it can be shared by all xinfer instances of the
+ *          process running the same model
+ */
+typedef struct
+{
+  /** Key built from the DPU configuration used to create handle */
+  gchar *key;
+  /** Handle to DPU inference library */
+  VvasDpuInfer *handle;
+  /** Model configuration reported by DPU inference library */
+  VvasModelConf model_conf;
+  /** Instances using the runner, 0 when it is only kept loaded in the cache.
+   * Protected by runner_cache_lock */
+  guint users;
+  /** Serializes the batches of the instances sharing the runner */
+  GMutex lock;
+} Vvas_XInferRunner;
+
+/** @def VVAS_XINFER_RUNNER_CACHE_SIZE
+ *  @brief Number of unused DPU runners kept loaded in the process so that
+ *         switching back to a recently used model does not reload it
+ */
+#define VVAS_XINFER_RUNNER_CACHE_SIZE 2
+
+/** Protects runner_cache */
+static GMutex runner_cache_lock;
+/** Runners of the process, in use or not, most recently used at head */
+static GQueue runner_cache = G_QUEUE_INIT;
+
 enum
 {
   PROP_0,
@@ -199,6 +260,18 @@ enum
   PROP_ATTACH_EMPTY_METADATA,
   /** Property ID for timeout to submit batch */
   PROP_BATCH_SUBMIT_TIMEOUT,
+  /** Property ID of memory transfer statistics */
+  PROP_MEM_STATS,
+  /** Property ID of latency budget */
+  PROP_LATENCY_BUDGET,
+  /** Property ID of batch scheduling mode */
+  PROP_BATCH_SCHEDULING,
+  /** Property ID of per source weights */
+  PROP_SOURCE_WEIGHTS,
+  /** Property ID of per source infer queue limit */
+  PROP_MAX_SOURCE_QUEUE,
+  /** Property ID of per source statistics */
+  PROP_SOURCE_STATS,
 };
 
 /** @enum VvasThreadState
@@ -244,6 +317,69 @@ typedef struct _vvas_xinfer_nodeinfo
   gboolean use_roi_data;
 } Vvas_XInferNodeInfo;
 
+/** @struct Vvas_XInferCoordDest
+ *  @brief  Location where a back-projected coordinate is written
+ */
+typedef struct _vvas_xinfer_coord_dest
+{
+  /** Address of x (or width) member in metadata */
+  gpointer x;
+  /** Address of y (or height) member in metadata */
+  gpointer y;
+  /** TRUE when destination is a float point, FALSE for int32 bbox member */
+  gboolean is_float;
+} Vvas_XInferCoordDest;
+
+/** @struct Vvas_XInferCoordBox
+ *  @brief  Bounding box to be clipped against its parent frame after
+ *          back-projection
+ */
+typedef struct _vvas_xinfer_coord_box
+{
+  /** Prediction owning the bounding box */
+  GstInferencePrediction *prediction;
+  /** Width of parent frame */
+  guint max_width;
+  /** Height of parent frame */
+  guint max_height;
+} Vvas_XInferCoordBox;
+
+/** @struct Vvas_XInferCoords
+ *  @brief  Structure of arrays holding all child coordinates of a batch which
+ *          need to be back-projected to their parent frames
+ */
+typedef struct _vvas_xinfer_coords
+{
+  /** Number of valid entries */
+  guint len;
+  /** Number of allocated entries */
+  guint size;
+  /** x coordinate (or width) in child resolution */
+  gfloat *x;
+  /** y coordinate (or height) in child resolution */
+  gfloat *y;
+  /** Horizontal scale factor child -> parent */
+  gfloat *hfactor;
+  /** Vertical scale factor child -> parent */
+  gfloat *vfactor;
+  /** x position of parent bbox */
+  gint32 *xbase;
+  /** y position of parent bbox */
+  gint32 *ybase;
+  /** x offset due to ROI and scaler alignment */
+  gint32 *xoffset;
+  /** y offset due to ROI and scaler alignment */
+  gint32 *yoffset;
+  /** Back-projected x */
+  gint32 *out_x;
+  /** Back-projected y */
+  gint32 *out_y;
+  /** Destination of each entry */
+  Vvas_XInferCoordDest *dest;
+  /** Array of Vvas_XInferCoordBox to be clipped after projection */
+  GArray *boxes;
+} Vvas_XInferCoords;
+
 /** @struct Vvas_XInferNumSubs
  *  @brief  Contains sub buffer information
  */
@@ -282,8 +418,37 @@ struct _Vvas_XInferFrame
   vvas_ms_roi output_roi;
   /** Use input and output roi info for scale metadata*/
   gboolean use_roi_data;
+  /** Source id from GstVvasSrcIDMeta of parent buffer */
+  guint src_id;
+  /** Time at which frame is added to infer_batch_queue */
+  GstClockTime queued_ts;
 };
 
+/** @struct Vvas_XInferSource
+ *  @brief  Scheduling and statistics of one GstVvasSrcIDMeta source
+ */
+typedef struct
+{
+  /** Frames skipped since the last frame of this source was inferred */
+  guint deficit;
+  /** Total frames of this source skipped to meet the latency budget */
+  guint64 skipped;
+  /** Running time of the pipeline when last frame of this source arrived */
+  GstClockTime last_seen;
+  /** Frames of this source waiting in infer_batch_queue */
+  guint queued;
+  /** Weight of this source in weighted fair queuing */
+  guint weight;
+  /** Virtual finish time of last frame of this source taken in a batch */
+  gdouble vtime;
+  /** Frames of this source inferred and pushed */
+  guint64 frames;
+  /** Sum of latencies from infer queue to push of inferred frames */
+  GstClockTime latency_total;
+  /** Maximum latency from infer queue to push of an inferred frame */
+  GstClockTime latency_max;
+} Vvas_XInferSource;
+
 /** @struct _GstVvas_XInferPrivate
  *  @brief  Contains private member of xinfer
  */
@@ -338,6 +503,10 @@ struct _GstVvas_XInferPrivate
   GstBufferPool *ppe_outpool;
   /** number of bbox/sub_buffer at inference level */
   guint nframes_in_level;
+  /** PPE output buffers acquired in one batch for the nodes at inference level */
+  GstBuffer *ppe_outbufs[MAX_NUM_OBJECT];
+  /** number of valid entries in ppe_outbufs */
+  guint n_ppe_outbufs;
   /** State of PPE thread */
   VvasThreadState ppe_thread_state;
   /** PPC requirement of scaler HW */
@@ -397,8 +566,44 @@ struct _GstVvas_XInferPrivate
   gint infer_log_level;
   /** Model configuration */
   VvasModelConf model_conf;
-  /** DPU input configuration */
+  /** DPU input configuration, replaced by model swaps under infer_lock, so
+   * threads other than the infer thread read it holding infer_lock */
   VvasDpuInferConf *dpu_conf;
+  /** DPU runner from the process wide runner cache */
+  Vvas_XInferRunner *runner;
+  /** Moving average of the time taken by infer thread for one batch */
+  GstClockTime batch_time;
+  /** Moving average of the DPU time of one frame or object, answered to
+   *  vvas-inference-time queries, protected by the object lock */
+  GstClockTime frame_infer_time;
+  /** Submit queued frames without waiting for a full batch */
+  gboolean flush_batch;
+  /** Infer thread holds frames of a batch not submitted yet, protected by
+   * infer_lock */
+  gboolean batch_building;
+  /** Protects sources and Vvas_XInferSource in it */
+  GMutex sources_lock;
+  /** Vvas_XInferSource of each source, keyed by source id */
+  GHashTable *sources;
+  /** Source weights parsed from source-weights, keyed by source id */
+  GHashTable *source_weights;
+  /** Virtual time of weighted fair queuing */
+  gdouble vclock;
+  /** Source id of the last frame taken in round-robin scheduling */
+  guint rr_last;
+  /** Running time till which frames are being skipped for latency budget */
+  GstClockTime pressure_until;
+  /** Total frames skipped to meet the latency budget */
+  guint64 deadline_skipped;
+  /** Protects pending_runner, pending_dpu_conf and loader_generation, lives
+   * as long as the instance as model loaders are not joined */
+  GMutex loader_lock;
+  /** Latest model load requested, loads of older generations are dropped */
+  guint loader_generation;
+  /** Runner of the new model, swapped in at the next batch boundary */
+  Vvas_XInferRunner *pending_runner;
+  /** DPU configuration of pending_runner */
+  VvasDpuInferConf *pending_dpu_conf;
 #ifdef DUMP_INFER_INPUT
   /** pointer to output FILE used for dumping all input frame to infer */
   FILE *fp;
@@ -421,6 +626,8 @@ struct _GstVvas_XInferPrivate
   VvasInferPrediction *(*postprocess_run) (VvasPostProcessor *,
       VvasInferPrediction *);
     VvasReturnType (*postprocess_destroy) (VvasPostProcessor *);
+  /** DMA transfers and slow copies of input frames */
+  GstVvasMemStats mem_stats;
 };
 
 /**
@@ -468,6 +675,32 @@ static void gst_vvas_xinfer_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 static void gst_vvas_xinfer_finalize (GObject * obj);
 
+/**
+ *  @fn static GType vvas_xinfer_scheduling_get_type (void)
+ *  @param void
+ *  @return Returns the GEnumValue for all batch scheduling modes.
+ *  @brief  This function just returns the GEnumValue for the ways frames of
+ *          different sources are taken into an inference batch.
+ */
+static GType
+vvas_xinfer_scheduling_get_type (void)
+{
+  static GType scheduling = 0;
+  /* Register batch scheduling enum type */
+  if (!scheduling) {
+    static const GEnumValue modes[] = {
+      {GST_VVAS_XINFER_SCHEDULING_FIFO, "Frames in arrival order", "fifo"},
+      {GST_VVAS_XINFER_SCHEDULING_ROUND_ROBIN,
+          "Oldest frame of each source in turn", "round-robin"},
+      {GST_VVAS_XINFER_SCHEDULING_WFQ,
+          "Weighted fair queuing as per source-weights", "wfq"},
+      {0, NULL, NULL}
+    };
+    scheduling = g_enum_register_static ("GstVvasXInferScheduling", modes);
+  }
+  return scheduling;
+}
+
 /**
  *  @fn static inline GstVideoFormat get_gst_format (VVASVideoFormat kernel_fmt)
  *  @param [in] kernel_fmt - VVAS Video format
@@ -663,6 +896,61 @@ printf_all_nodes (GNode * node, gpointer data)
 }
 #endif
 
+/**
+ * @fn static gboolean vvas_xinfer_is_ppe_node (GstVvas_XInfer * self, GNode * node)
+ * @param [in] self - handle to GstVvas_XInfer
+ * @param [in] node - node in a tree
+ * @return TRUE when node needs a PPE output frame\n FALSE otherwise
+ *
+ * @brief Checks whether @node is at current inference level and its
+ *        bounding box can be preprocessed
+ */
+static gboolean
+vvas_xinfer_is_ppe_node (GstVvas_XInfer * self, GNode * node)
+{
+  GstInferencePrediction *prediction = (GstInferencePrediction *) node->data;
+
+  /* Process node only if current inference level and node depth are same */
+  if (g_node_depth (node) != self->priv->infer_level)
+    return FALSE;
+
+  if ((prediction->prediction.bbox.width < VVAS_SCALER_MIN_WIDTH)
+      || (prediction->prediction.bbox.height < VVAS_SCALER_MIN_HEIGHT)) {
+    GST_DEBUG_OBJECT (self,
+        "Width/Height of the ROI is less the minimum supported(%dx%d), discarding",
+        VVAS_SCALER_MIN_WIDTH, VVAS_SCALER_MIN_HEIGHT);
+    return FALSE;
+  }
+
+  if (!prediction->prediction.enabled) {
+    GST_DEBUG_OBJECT (self,
+        "Skipping inference on this node as it is disabled");
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @fn static gboolean count_ppe_outbuf_at_level (GNode * node, gpointer data)
+ * @param [in] node - node in a tree
+ * @param [in] data - pointer to guint counter
+ * @return FALSE to continue the traversal
+ *
+ * @brief Counts the nodes which need a PPE output frame, so that
+ *        output buffers can be acquired from the pool in one batch
+ */
+static gboolean
+count_ppe_outbuf_at_level (GNode * node, gpointer data)
+{
+  GstVvas_XInfer *self = GST_VVAS_XINFER (data);
+
+  if (vvas_xinfer_is_ppe_node (self, node))
+    self->priv->n_ppe_outbufs++;
+
+  return FALSE;
+}
+
 /**
  * @fn static gboolean prepare_ppe_outbuf_at_level (GNode * node, gpointer data)
  * @param [in] node - node in a tree
@@ -683,8 +971,7 @@ prepare_ppe_outbuf_at_level (GNode * node, gpointer data)
 
   GST_LOG_OBJECT (self, "node = %p at level %d", node, g_node_depth (node));
 
-  /* Process node only if current inference level and node depth are same */
-  if (g_node_depth (node) == priv->infer_level) {
+  if (vvas_xinfer_is_ppe_node (self, node)) {
     GstBuffer *outbuf;
     GstFlowReturn fret;
     VvasVideoFrame *out_vvas_frame;
@@ -694,30 +981,23 @@ prepare_ppe_outbuf_at_level (GNode * node, gpointer data)
     GstInferenceMeta *infer_meta;
     gboolean bret;
 
-    if ((prediction->prediction.bbox.width < VVAS_SCALER_MIN_WIDTH)
-        || (prediction->prediction.bbox.height < VVAS_SCALER_MIN_HEIGHT)) {
-      GST_DEBUG_OBJECT (self,
-          "Width/Height of the ROI is less the minimum supported(%dx%d), discarding",
-          VVAS_SCALER_MIN_WIDTH, VVAS_SCALER_MIN_HEIGHT);
-      return FALSE;
-    }
-
-    if (!prediction->prediction.enabled) {
-      GST_DEBUG_OBJECT (self,
-          "Skipping inference on this node as it is disabled");
-      return FALSE;
-    }
-
     GST_LOG_OBJECT (self, "found node %p at level inference level %d", node,
         priv->infer_level);
 
-    /* acquire ppe output buffer */
-    fret = gst_buffer_pool_acquire_buffer (priv->ppe_outpool, &outbuf, NULL);
-    if (fret != GST_FLOW_OK) {
-      GST_ERROR_OBJECT (self, "failed to allocate buffer from pool %p",
-          priv->ppe_outpool);
-      priv->is_error = TRUE;
-      return TRUE;
+    if (priv->nframes_in_level < priv->n_ppe_outbufs) {
+      /* take the buffer acquired in batch for this level */
+      outbuf = priv->ppe_outbufs[priv->nframes_in_level];
+      priv->ppe_outbufs[priv->nframes_in_level] = NULL;
+    } else {
+      /* acquire ppe output buffer */
+      fret =
+          gst_buffer_pool_acquire_buffer (priv->ppe_outpool, &outbuf, NULL);
+      if (fret != GST_FLOW_OK) {
+        GST_ERROR_OBJECT (self, "failed to allocate buffer from pool %p",
+            priv->ppe_outpool);
+        priv->is_error = TRUE;
+        return TRUE;
+      }
     }
     /* Prepare VvasVideoFrame from GstBuffer required by core for pre-processing */
     bret =
@@ -879,10 +1159,11 @@ error:
 
 /**
  * @fn static gboolean vvas_xinfer_copy_input_buffer (GstVvas_XInfer * self, GstBuffer * inbuf,
- *						      GstBuffer ** internal_inbuf)
+ *						      GstBuffer ** internal_inbuf, GstVvasCopyReason reason)
  * @param [in] self - handle to GstVvas_XInfer
  * @param [in] inbuf - input buffer on sink pad of xinfer
  * @param [out] internal_inbuf - new buffer based on kernel requirement
+ * @param [in] reason - why the input buffer can not be used, for statistics
  * @return TRUE on success
  *         FALSE on failure
  *
@@ -893,7 +1174,7 @@ error:
  */
 static gboolean
 vvas_xinfer_copy_input_buffer (GstVvas_XInfer * self, GstBuffer * inbuf,
-    GstBuffer ** internal_inbuf)
+    GstBuffer ** internal_inbuf, GstVvasCopyReason reason)
 {
   GstBuffer *new_inbuf;
   GstFlowReturn fret;
@@ -942,6 +1223,8 @@ vvas_xinfer_copy_input_buffer (GstVvas_XInfer * self, GstBuffer * inbuf,
 
   /* frame_copy will take care of stride too */
   gst_video_frame_copy (&new_vframe, &in_vframe);
+  gst_vvas_mem_stats_add_copy (&self->priv->mem_stats, reason,
+      GST_VIDEO_INFO_SIZE (self->priv->in_vinfo));
   gst_video_frame_unmap (&in_vframe);
   gst_video_frame_unmap (&new_vframe);
   gst_buffer_copy_into (new_inbuf, inbuf,
@@ -979,6 +1262,190 @@ free_dpuinfer_conf (VvasDpuInferConf * dpu_conf)
   free (dpu_conf);
 }
 
+/**
+ * @fn static gchar *vvas_xinfer_runner_key (VvasDpuInferConf * dpu_conf, gint log_level)
+ * @param [in] dpu_conf - DPU configuration used to create the runner
+ * @param [in] log_level - log level of DPU inference library
+ * @return key identifying the runner, to be freed using g_free
+ *
+ * @brief Builds the runner cache key from all the parameters which change
+ *        the behaviour of a DPU inference handle
+ */
+static gchar *
+vvas_xinfer_runner_key (VvasDpuInferConf * dpu_conf, gint log_level)
+{
+  GString *key = g_string_new (NULL);
+
+  g_string_append_printf (key, "%s/%s:%s:%d:%d:%d:%d:%u:%d:%d:%d:%d",
+      dpu_conf->model_path, dpu_conf->model_name, dpu_conf->modelclass,
+      dpu_conf->model_format, dpu_conf->batch_size, dpu_conf->need_preprocess,
+      dpu_conf->performance_test, dpu_conf->objs_detection_max,
+      dpu_conf->float_feature, dpu_conf->segoutfmt, dpu_conf->segoutfactor,
+      log_level);
+  for (int i = 0; i < dpu_conf->num_filter_labels; i++)
+    g_string_append_printf (key, ":%s",
+        dpu_conf->filter_labels[i] ? dpu_conf->filter_labels[i] : "");
+
+  return g_string_free (key, FALSE);
+}
+
+/**
+ * @fn static void vvas_xinfer_runner_free (Vvas_XInferRunner * runner)
+ * @param [in] runner - runner to be destroyed
+ * @return None
+ *
+ * @brief Destroys DPU inference handle and frees the runner
+ */
+static void
+vvas_xinfer_runner_free (Vvas_XInferRunner * runner)
+{
+  if (runner->handle && vvas_dpuinfer_destroy (runner->handle) !=
+      VVAS_RET_SUCCESS) {
+    GST_ERROR ("failed to destroy DPU runner %s", runner->key);
+  }
+  g_free (runner->key);
+  g_mutex_clear (&runner->lock);
+  g_slice_free (Vvas_XInferRunner, runner);
+}
+
+/**
+ * @fn static Vvas_XInferRunner *vvas_xinfer_runner_lookup (const gchar * key)
+ * @param [in] key - key of the runner
+ * @return runner with one more user, NULL when not loaded
+ *
+ * @brief Looks up the runner cache, runner_cache_lock must be held
+ */
+static Vvas_XInferRunner *
+vvas_xinfer_runner_lookup (const gchar * key)
+{
+  GList *iter;
+
+  for (iter = runner_cache.head; iter != NULL; iter = iter->next) {
+    Vvas_XInferRunner *runner = (Vvas_XInferRunner *) iter->data;
+
+    if (!g_strcmp0 (runner->key, key)) {
+      runner->users++;
+      g_queue_unlink (&runner_cache, iter);
+      g_queue_push_head_link (&runner_cache, iter);
+      return runner;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @fn static Vvas_XInferRunner *vvas_xinfer_runner_acquire (GstVvas_XInfer * self,
+ *                                                           VvasDpuInferConf * dpu_conf,
+ *                                                           gint log_level)
+ * @param [in] self - Handle to GstVvas_XInfer
+ * @param [in] dpu_conf - DPU configuration of the model to be loaded
+ * @param [in] log_level - log level of DPU inference library
+ * @return runner on success
+ *         NULL on failure
+ *
+ * @brief Gets a DPU runner for @dpu_conf
+ * @details Returns the runner of the process wide runner cache having the
+ *          same configuration, whether other instances use it or it is only
+ *          kept loaded, otherwise creates a new DPU inference handle. Runner
+ *          is given back using vvas_xinfer_runner_release. Instances sharing
+ *          a runner submit their batches under Vvas_XInferRunner::lock.
+ */
+static Vvas_XInferRunner *
+vvas_xinfer_runner_acquire (GstVvas_XInfer * self,
+    VvasDpuInferConf * dpu_conf, gint log_level)
+{
+  Vvas_XInferRunner *runner, *loaded;
+  gchar *key = vvas_xinfer_runner_key (dpu_conf, log_level);
+
+  g_mutex_lock (&runner_cache_lock);
+  runner = vvas_xinfer_runner_lookup (key);
+  g_mutex_unlock (&runner_cache_lock);
+
+  if (runner) {
+    GST_INFO_OBJECT (self, "sharing loaded DPU runner of model %s",
+        dpu_conf->model_name);
+    g_free (key);
+    return runner;
+  }
+
+  runner = g_slice_new0 (Vvas_XInferRunner);
+  runner->key = key;
+  g_mutex_init (&runner->lock);
+
+  /* created outside lock, loading a model can take long */
+  runner->handle = vvas_dpuinfer_create (dpu_conf, log_level);
+  if (!runner->handle) {
+    GST_ERROR_OBJECT (self, "failed to create DPU runner of model %s",
+        dpu_conf->model_name);
+    vvas_xinfer_runner_free (runner);
+    return NULL;
+  }
+
+  if (vvas_dpuinfer_get_config (runner->handle, &runner->model_conf) !=
+      VVAS_RET_SUCCESS) {
+    GST_ERROR_OBJECT (self, "couldn't get DPU kernel configuration");
+    vvas_xinfer_runner_free (runner);
+    return NULL;
+  }
+
+  /* another instance may have loaded the same model meanwhile */
+  g_mutex_lock (&runner_cache_lock);
+  loaded = vvas_xinfer_runner_lookup (key);
+  if (!loaded) {
+    runner->users = 1;
+    g_queue_push_head (&runner_cache, runner);
+  }
+  g_mutex_unlock (&runner_cache_lock);
+
+  if (loaded) {
+    GST_INFO_OBJECT (self, "sharing DPU runner of model %s loaded "
+        "concurrently", dpu_conf->model_name);
+    vvas_xinfer_runner_free (runner);
+    runner = loaded;
+  }
+
+  return runner;
+}
+
+/**
+ * @fn static void vvas_xinfer_runner_release (Vvas_XInferRunner * runner)
+ * @param [in] runner - runner acquired using vvas_xinfer_runner_acquire
+ * @return None
+ *
+ * @brief Drops one user of @runner
+ * @details Runner stays loaded in the cache when its last user releases it.
+ *          Least recently used runners without users are destroyed when more
+ *          than VVAS_XINFER_RUNNER_CACHE_SIZE of them are kept.
+ */
+static void
+vvas_xinfer_runner_release (Vvas_XInferRunner * runner)
+{
+  GSList *evicted = NULL;
+  GList *iter, *prev;
+  guint unused = 0;
+
+  g_mutex_lock (&runner_cache_lock);
+  runner->users--;
+  for (iter = runner_cache.head; iter != NULL; iter = iter->next) {
+    if (!((Vvas_XInferRunner *) iter->data)->users)
+      unused++;
+  }
+  for (iter = runner_cache.tail; iter && unused > VVAS_XINFER_RUNNER_CACHE_SIZE;
+      iter = prev) {
+    prev = iter->prev;
+    if (!((Vvas_XInferRunner *) iter->data)->users) {
+      evicted = g_slist_prepend (evicted, iter->data);
+      g_queue_delete_link (&runner_cache, iter);
+      unused--;
+    }
+  }
+  g_mutex_unlock (&runner_cache_lock);
+
+  /* destroy outside lock, unloading a model can take long */
+  g_slist_free_full (evicted, (GDestroyNotify) vvas_xinfer_runner_free);
+}
+
 /**
  * @fn static gboolean vvas_xinfer_ppe_init (GstVvas_XInfer * self)
  * @param [in] self - Handle to GstVvas_XInfer
@@ -1128,7 +1595,6 @@ vvas_xinfer_infer_init (GstVvas_XInfer * self)
 {
   GstVvas_XInferPrivate *priv = self->priv;
   VvasReturnType vret;
-  VvasDpuInfer *infer_handle = NULL;
 
   VvasLogLevel core_log_level =
       vvas_get_core_log_level (gst_debug_category_get_threshold
@@ -1140,22 +1606,16 @@ vvas_xinfer_infer_init (GstVvas_XInfer * self)
     return FALSE;
   }
 
-  infer_handle = vvas_dpuinfer_create (priv->dpu_conf, priv->infer_log_level);
-  if (!infer_handle) {
+  priv->runner =
+      vvas_xinfer_runner_acquire (self, priv->dpu_conf, priv->infer_log_level);
+  if (!priv->runner) {
     GST_ERROR_OBJECT (self, "failed to do inference init..");
     return FALSE;
   }
-  priv->infer_handle->handle = infer_handle;
+  priv->infer_handle->handle = priv->runner->handle;
+  priv->model_conf = priv->runner->model_conf;
   GST_INFO_OBJECT (self, "completed inference kernel init");
 
-  vret = vvas_dpuinfer_get_config (infer_handle, &priv->model_conf);
-  if (vret == VVAS_RET_SUCCESS) {
-    GST_DEBUG_OBJECT (self, "Got DPU kernel configuration");
-  } else {
-    GST_ERROR_OBJECT (self, "couldn't get DPU kernel configuration");
-    return FALSE;
-  }
-
   priv->dpu_kernel_config = vvas_structure_new ("pp_config",
       "alpha_r", G_TYPE_FLOAT, priv->model_conf.mean_r,
       "alpha_g", G_TYPE_FLOAT, priv->model_conf.mean_g,
@@ -1423,195 +1883,87 @@ get_vvas_video_fmt (char *name)
 }
 
 /**
- * @fn static gboolean vvas_xinfer_read_infer_config (GstVvas_XInfer * self)
+ * @fn static VvasDpuInferConf *vvas_xinfer_parse_dpu_conf (GstVvas_XInfer * self, json_t * config)
  * @param [in] self - Handle to GstVvas_XInfer
- * @return TRUE when reads all mandatory parameter from json
- *         FALSE when not able to read mandatory parameter from json
+ * @param [in] config - "config" object of the kernel in infer json
+ * @return Newly allocated VvasDpuInferConf on success
+ *         NULL when a mandatory parameter is missing or invalid
  *
- * @brief This function reads infer json file and populate infer private
- *        parameters
+ * @brief Parses DPU specific parameters of infer json into a new
+ *        VvasDpuInferConf
+ * @details Does not touch instance state, so it is also used to parse a new
+ *          infer config while the current model is still running.
  *
  */
-static gboolean
-vvas_xinfer_read_infer_config (GstVvas_XInfer * self)
+static VvasDpuInferConf *
+vvas_xinfer_parse_dpu_conf (GstVvas_XInfer * self, json_t * config)
 {
-  GstVvas_XInferPrivate *priv = self->priv;
-  json_t *root = NULL, *kernel, *value, *config, *label;
-  json_error_t error;
+  json_t *value, *label;
   VvasDpuInferConf *dpu_conf;
 
-  /* Set default values for non mandatory parameter */
-  priv->infer_level = DEFAULT_INFER_LEVEL;
-  priv->infer_batch_size = BATCH_SIZE_ZERO;
-  priv->low_latency_infer = TRUE;
-  priv->infer_attach_ppebuf = FALSE;
-
-  /* get root json object */
-  root = json_load_file (self->infer_json_file, JSON_DECODE_ANY, &error);
-  if (!root) {
-    GST_ERROR_OBJECT (self, "failed to load json file. reason %s", error.text);
-
-    /* print to console */
-    GST_ELEMENT_ERROR (self, RESOURCE, FAILED,
-        ("failed to load json file. reason %s", error.text), (NULL));
-    return FALSE;
+  dpu_conf = (VvasDpuInferConf *) calloc (1, sizeof (VvasDpuInferConf));
+  if (!dpu_conf) {
+    GST_ERROR_OBJECT (self, "failed to allocate memory");
+    return NULL;
   }
 
-
-  /* get kernels object */
-  kernel = json_object_get (root, "kernel");
-  if (!json_is_object (kernel)) {
-    GST_ERROR_OBJECT (self, "failed to find kernel object");
+  value = json_object_get (config, "model-path");
+  if (json_is_string (value)) {
+    dpu_conf->model_path = g_strdup ((char *) json_string_value (value));
+    GST_DEBUG_OBJECT (self, "model-path is %s",
+        (char *) json_string_value (value));
+  } else {
+    if (!value) {
+      GST_ERROR_OBJECT (self, "model-path missing");
+    } else {
+      GST_ERROR_OBJECT (self, "model-path is not of string type");
+    }
     goto error;
   }
 
-  priv->infer_handle = (VvasCoreModule *) calloc (1, sizeof (VvasCoreModule));
-  if (!priv->infer_handle) {
-    GST_ERROR_OBJECT (self, "failed to allocate memory");
+  value = json_object_get (config, "model-name");
+  if (json_is_string (value)) {
+    dpu_conf->model_name = g_strdup ((char *) json_string_value (value));
+    GST_DEBUG_OBJECT (self, "model-name is %s",
+        (char *) json_string_value (value));
+  } else {
+    if (!value) {
+      GST_ERROR_OBJECT (self, "model-name missing");
+    } else {
+      GST_ERROR_OBJECT (self, "model-name is not of string type");
+    }
     goto error;
   }
 
-  /* get vvas kernel lib internal configuration */
-  config = json_object_get (kernel, "config");
-  if (!json_is_object (config)) {
-    GST_ERROR_OBJECT (self, "config is not of object type");
+  value = json_object_get (config, "model-format");
+  if (!json_is_string (value)) {
+    GST_WARNING_OBJECT (self,
+        "model-format is not proper, taking BGR as default");
+    dpu_conf->model_format = VVAS_VIDEO_FORMAT_BGR;
+  } else {
+    dpu_conf->model_format =
+        get_vvas_video_fmt ((char *) json_string_value (value));
+    GST_DEBUG_OBJECT (self, "model-format %s",
+        (char *) json_string_value (value));
+  }
+  if (dpu_conf->model_format == VVAS_VIDEO_FORMAT_UNKNOWN) {
+    GST_ERROR_OBJECT (self, "SORRY NOT SUPPORTED MODEL FORMAT %s",
+        (char *) json_string_value (value));
     goto error;
   }
 
-  GST_DEBUG_OBJECT (self, "kernel config size = %lu",
-      json_object_size (config));
-
-  value = json_object_get (config, "batch-size");
-  if (json_is_integer (value)) {
-    priv->infer_batch_size = json_integer_value (value);
-    if (priv->infer_batch_size >= MAX_NUM_OBJECT) {
-      GST_ERROR_OBJECT (self, "batch-size should not >= %d",
-          MAX_NUM_OBJECT - 1);
-      goto error;
+  value = json_object_get (config, "model-class");
+  if (json_is_string (value)) {
+    dpu_conf->modelclass = g_strdup ((char *) json_string_value (value));
+    GST_DEBUG_OBJECT (self, "model-class is %s",
+        (char *) json_string_value (value));
+  } else {
+    if (!value) {
+      GST_ERROR_OBJECT (self, "model-class is missing");
+    } else {
+      GST_ERROR_OBJECT (self, "model-class is not of string type");
     }
-  }
-
-  value = json_object_get (root, "inference-level");
-  if (json_is_integer (value)) {
-    priv->infer_level = json_integer_value (value);
-    if (priv->infer_level < 1) {
-      GST_ERROR_OBJECT (self,
-          "inference-level %d can't be less than 1", priv->infer_level);
-      goto error;
-    }
-  }
-
-  /* making batch size as default max-queue-size */
-  priv->max_infer_queue = priv->infer_batch_size;
-
-  value = json_object_get (root, "low-latency");
-  if (value) {
-    if (!json_is_boolean (value)) {
-      GST_ERROR_OBJECT (self, "low-latency is not a boolean type");
-      goto error;
-    }
-
-    priv->low_latency_infer = json_boolean_value (value);
-    GST_INFO_OBJECT (self, "setting low-latency to %d",
-        priv->low_latency_infer);
-  }
-
-  value = json_object_get (root, "inference-max-queue");
-  if (!json_is_integer (value)) {
-    GST_WARNING_OBJECT (self, "inference-max-queue is not set."
-        "taking batch-size %d as default", priv->infer_batch_size);
-  } else {
-    priv->max_infer_queue = json_integer_value (value);
-    if (priv->max_infer_queue < priv->infer_batch_size) {
-      GST_WARNING_OBJECT (self, "inference-max-queue can't be less than "
-          "batch-size. taking batch-size %d as default queue length",
-          priv->infer_batch_size);
-      priv->max_infer_queue = priv->infer_batch_size;
-    } else {
-      GST_INFO_OBJECT (self, "setting inference-max-queue to %d",
-          priv->max_infer_queue);
-    }
-  }
-
-  value = json_object_get (root, "attach-ppe-outbuf");
-  if (value) {
-    if (!json_is_boolean (value)) {
-      GST_ERROR_OBJECT (self, "attach-ppe-outbuf is not a boolean type");
-      goto error;
-    }
-
-    priv->infer_attach_ppebuf = json_boolean_value (value);
-    GST_INFO_OBJECT (self, "setting attach-ppe-outbuf to %d",
-        priv->infer_attach_ppebuf);
-  }
-
-  /* Fill VvasDpuInferConf here to call core API's */
-  priv->dpu_conf = (VvasDpuInferConf *) calloc (1, sizeof (VvasDpuInferConf));
-  dpu_conf = priv->dpu_conf;
-  if (!dpu_conf) {
-    GST_ERROR_OBJECT (self, "failed to allocate memory");
-    goto error;
-  }
-
-  value = json_object_get (config, "model-path");
-  if (json_is_string (value)) {
-    dpu_conf->model_path = g_strdup ((char *) json_string_value (value));
-    priv->postproc_conf.model_path = dpu_conf->model_path;
-    GST_DEBUG_OBJECT (self, "model-path is %s",
-        (char *) json_string_value (value));
-  } else {
-    if (!value) {
-      GST_ERROR_OBJECT (self, "model-path missing");
-    } else {
-      GST_ERROR_OBJECT (self, "model-path is not of string type");
-    }
-    goto error;
-  }
-
-  value = json_object_get (config, "model-name");
-  if (json_is_string (value)) {
-    dpu_conf->model_name = g_strdup ((char *) json_string_value (value));
-    priv->postproc_conf.model_name = dpu_conf->model_name;
-    GST_DEBUG_OBJECT (self, "model-name is %s",
-        (char *) json_string_value (value));
-  } else {
-    if (!value) {
-      GST_ERROR_OBJECT (self, "model-name missing");
-    } else {
-      GST_ERROR_OBJECT (self, "model-name is not of string type");
-    }
-    goto error;
-  }
-
-  value = json_object_get (config, "model-format");
-  if (!json_is_string (value)) {
-    GST_WARNING_OBJECT (self,
-        "model-format is not proper, taking BGR as default");
-    dpu_conf->model_format = VVAS_VIDEO_FORMAT_BGR;
-  } else {
-    dpu_conf->model_format =
-        get_vvas_video_fmt ((char *) json_string_value (value));
-    GST_DEBUG_OBJECT (self, "model-format %s",
-        (char *) json_string_value (value));
-  }
-  if (dpu_conf->model_format == VVAS_VIDEO_FORMAT_UNKNOWN) {
-    GST_ERROR_OBJECT (self, "SORRY NOT SUPPORTED MODEL FORMAT %s",
-        (char *) json_string_value (value));
-    goto error;
-  }
-
-  value = json_object_get (config, "model-class");
-  if (json_is_string (value)) {
-    dpu_conf->modelclass = g_strdup ((char *) json_string_value (value));
-    GST_DEBUG_OBJECT (self, "model-class is %s",
-        (char *) json_string_value (value));
-  } else {
-    if (!value) {
-      GST_ERROR_OBJECT (self, "model-class is missing");
-    } else {
-      GST_ERROR_OBJECT (self, "model-class is not of string type");
-    }
-    goto error;
+    goto error;
   }
 
   value = json_object_get (config, "vitis-ai-preprocess");
@@ -1712,6 +2064,144 @@ vvas_xinfer_read_infer_config (GstVvas_XInfer * self)
     GST_DEBUG_OBJECT (self, "No filter labels given");
   }
 
+  return dpu_conf;
+
+error:
+  free_dpuinfer_conf (dpu_conf);
+  return NULL;
+}
+
+/**
+ * @fn static gboolean vvas_xinfer_read_infer_config (GstVvas_XInfer * self)
+ * @param [in] self - Handle to GstVvas_XInfer
+ * @return TRUE when reads all mandatory parameter from json
+ *         FALSE when not able to read mandatory parameter from json
+ *
+ * @brief This function reads infer json file and populate infer private
+ *        parameters
+ *
+ */
+static gboolean
+vvas_xinfer_read_infer_config (GstVvas_XInfer * self)
+{
+  GstVvas_XInferPrivate *priv = self->priv;
+  json_t *root = NULL, *kernel, *value, *config;
+  json_error_t error;
+  VvasDpuInferConf *dpu_conf;
+
+  /* Set default values for non mandatory parameter */
+  priv->infer_level = DEFAULT_INFER_LEVEL;
+  priv->infer_batch_size = BATCH_SIZE_ZERO;
+  priv->low_latency_infer = TRUE;
+  priv->infer_attach_ppebuf = FALSE;
+
+  /* get root json object */
+  root = json_load_file (self->infer_json_file, JSON_DECODE_ANY, &error);
+  if (!root) {
+    GST_ERROR_OBJECT (self, "failed to load json file. reason %s", error.text);
+
+    /* print to console */
+    GST_ELEMENT_ERROR (self, RESOURCE, FAILED,
+        ("failed to load json file. reason %s", error.text), (NULL));
+    return FALSE;
+  }
+
+
+  /* get kernels object */
+  kernel = json_object_get (root, "kernel");
+  if (!json_is_object (kernel)) {
+    GST_ERROR_OBJECT (self, "failed to find kernel object");
+    goto error;
+  }
+
+  priv->infer_handle = (VvasCoreModule *) calloc (1, sizeof (VvasCoreModule));
+  if (!priv->infer_handle) {
+    GST_ERROR_OBJECT (self, "failed to allocate memory");
+    goto error;
+  }
+
+  /* get vvas kernel lib internal configuration */
+  config = json_object_get (kernel, "config");
+  if (!json_is_object (config)) {
+    GST_ERROR_OBJECT (self, "config is not of object type");
+    goto error;
+  }
+
+  GST_DEBUG_OBJECT (self, "kernel config size = %lu",
+      json_object_size (config));
+
+  value = json_object_get (config, "batch-size");
+  if (json_is_integer (value)) {
+    priv->infer_batch_size = json_integer_value (value);
+    if (priv->infer_batch_size >= MAX_NUM_OBJECT) {
+      GST_ERROR_OBJECT (self, "batch-size should not >= %d",
+          MAX_NUM_OBJECT - 1);
+      goto error;
+    }
+  }
+
+  value = json_object_get (root, "inference-level");
+  if (json_is_integer (value)) {
+    priv->infer_level = json_integer_value (value);
+    if (priv->infer_level < 1) {
+      GST_ERROR_OBJECT (self,
+          "inference-level %d can't be less than 1", priv->infer_level);
+      goto error;
+    }
+  }
+
+  /* making batch size as default max-queue-size */
+  priv->max_infer_queue = priv->infer_batch_size;
+
+  value = json_object_get (root, "low-latency");
+  if (value) {
+    if (!json_is_boolean (value)) {
+      GST_ERROR_OBJECT (self, "low-latency is not a boolean type");
+      goto error;
+    }
+
+    priv->low_latency_infer = json_boolean_value (value);
+    GST_INFO_OBJECT (self, "setting low-latency to %d",
+        priv->low_latency_infer);
+  }
+
+  value = json_object_get (root, "inference-max-queue");
+  if (!json_is_integer (value)) {
+    GST_WARNING_OBJECT (self, "inference-max-queue is not set."
+        "taking batch-size %d as default", priv->infer_batch_size);
+  } else {
+    priv->max_infer_queue = json_integer_value (value);
+    if (priv->max_infer_queue < priv->infer_batch_size) {
+      GST_WARNING_OBJECT (self, "inference-max-queue can't be less than "
+          "batch-size. taking batch-size %d as default queue length",
+          priv->infer_batch_size);
+      priv->max_infer_queue = priv->infer_batch_size;
+    } else {
+      GST_INFO_OBJECT (self, "setting inference-max-queue to %d",
+          priv->max_infer_queue);
+    }
+  }
+
+  value = json_object_get (root, "attach-ppe-outbuf");
+  if (value) {
+    if (!json_is_boolean (value)) {
+      GST_ERROR_OBJECT (self, "attach-ppe-outbuf is not a boolean type");
+      goto error;
+    }
+
+    priv->infer_attach_ppebuf = json_boolean_value (value);
+    GST_INFO_OBJECT (self, "setting attach-ppe-outbuf to %d",
+        priv->infer_attach_ppebuf);
+  }
+
+  /* Fill VvasDpuInferConf here to call core API's */
+  priv->dpu_conf = vvas_xinfer_parse_dpu_conf (self, config);
+  if (!priv->dpu_conf)
+    goto error;
+  dpu_conf = priv->dpu_conf;
+  priv->postproc_conf.model_path = dpu_conf->model_path;
+  priv->postproc_conf.model_name = dpu_conf->model_name;
+
   value = json_object_get (config, "debug-level");
   if (json_is_integer (value)) {
     priv->infer_log_level = json_integer_value (value);
@@ -1851,14 +2341,28 @@ vvas_xinfer_infer_deinit (GstVvas_XInfer * self)
 {
   GstVvas_XInferPrivate *priv = self->priv;
   VvasCoreModule *infer_handle = priv->infer_handle;
-  VvasReturnType vret;
+  Vvas_XInferRunner *pending_runner;
+  VvasDpuInferConf *pending_dpu_conf;
+
+  /* models still loading are dropped once loaded */
+  g_mutex_lock (&priv->loader_lock);
+  priv->loader_generation++;
+  pending_runner = priv->pending_runner;
+  pending_dpu_conf = priv->pending_dpu_conf;
+  g_atomic_pointer_set (&priv->pending_runner, NULL);
+  priv->pending_dpu_conf = NULL;
+  g_mutex_unlock (&priv->loader_lock);
+
+  if (pending_runner) {
+    vvas_xinfer_runner_release (pending_runner);
+    free_dpuinfer_conf (pending_dpu_conf);
+  }
 
   if (infer_handle) {
-    if (infer_handle->handle) {
-      vret = vvas_dpuinfer_destroy (infer_handle->handle);
-      if (vret != VVAS_RET_SUCCESS) {
-        GST_ERROR_OBJECT (self, "failed to do inference kernel deinit..");
-      }
+    if (priv->runner) {
+      vvas_xinfer_runner_release (priv->runner);
+      priv->runner = NULL;
+      infer_handle->handle = NULL;
       GST_DEBUG_OBJECT (self, "successfully completed inference deinit");
     }
 
@@ -1883,6 +2387,242 @@ vvas_xinfer_infer_deinit (GstVvas_XInfer * self)
   return TRUE;
 }
 
+/** @struct Vvas_XInferModelLoad
+ *  @brief  Model load requested by setting infer-config while streaming
+ */
+typedef struct
+{
+  /** Instance, referenced till the load completes */
+  GstVvas_XInfer *self;
+  /** Value of loader_generation when the load was requested */
+  guint generation;
+  /** Model configuration of the running model */
+  VvasModelConf model_conf;
+  /** DPU pre-processing of the running model */
+  gboolean need_preprocess;
+  /** Input format of the running model */
+  VvasVideoFormat model_format;
+  /** Hardware pre-processing in use */
+  gboolean do_preprocess;
+  /** Post-processing library in use */
+  gboolean do_postprocess;
+  /** Negotiated batch size */
+  guint batch_size;
+} Vvas_XInferModelLoad;
+
+static gpointer vvas_xinfer_model_loader (gpointer data);
+
+/**
+ * @fn static void vvas_xinfer_request_model_load (GstVvas_XInfer * self)
+ * @param [in] self - Handle to GstVvas_XInfer
+ * @return None
+ *
+ * @brief Starts loading the model of infer-config in a detached thread
+ * @details The thread is never joined, neither here nor on state change,
+ *          so that neither setting the property nor stopping the element
+ *          blocks on a model load. A load requested later or a stop make the
+ *          result of this one be dropped.
+ */
+static void
+vvas_xinfer_request_model_load (GstVvas_XInfer * self)
+{
+  GstVvas_XInferPrivate *priv = self->priv;
+  Vvas_XInferModelLoad *load = g_slice_new0 (Vvas_XInferModelLoad);
+
+  load->self = gst_object_ref (self);
+
+  /* current model configuration, invariant across swaps */
+  g_mutex_lock (&priv->infer_lock);
+  load->model_conf = priv->model_conf;
+  load->need_preprocess = priv->dpu_conf->need_preprocess;
+  load->model_format = priv->dpu_conf->model_format;
+  load->do_preprocess = priv->do_preprocess;
+  load->do_postprocess = priv->do_postprocess;
+  load->batch_size = priv->infer_batch_size;
+  g_mutex_unlock (&priv->infer_lock);
+
+  g_mutex_lock (&priv->loader_lock);
+  load->generation = ++priv->loader_generation;
+  g_mutex_unlock (&priv->loader_lock);
+
+  g_thread_unref (g_thread_new ("xinfer-model-loader",
+          vvas_xinfer_model_loader, load));
+}
+
+/**
+ * @fn static gpointer vvas_xinfer_model_loader (gpointer data)
+ * @param [in] data - Vvas_XInferModelLoad, freed here
+ * @return NULL
+ *
+ * @brief Loads the model of a new infer-config set while streaming
+ * @details Runs in its own thread so that inference on the current model
+ *          continues while the new one is loaded. Only models which are
+ *          compatible with the negotiated caps, pre-processing and batch size
+ *          are accepted, as these are not renegotiated on a swap. The loaded
+ *          runner is handed to the inference thread which swaps it in at the
+ *          next batch boundary.
+ */
+static gpointer
+vvas_xinfer_model_loader (gpointer data)
+{
+  Vvas_XInferModelLoad *load = (Vvas_XInferModelLoad *) data;
+  GstVvas_XInfer *self = load->self;
+  GstVvas_XInferPrivate *priv = self->priv;
+  json_t *root = NULL, *kernel, *config, *value;
+  json_error_t error;
+  VvasDpuInferConf *dpu_conf = NULL;
+  Vvas_XInferRunner *runner = NULL, *dropped = NULL;
+  VvasDpuInferConf *dropped_conf = NULL;
+  VvasModelConf cur_model_conf = load->model_conf;
+  gboolean cur_need_preprocess = load->need_preprocess;
+  VvasVideoFormat cur_model_format = load->model_format;
+  gchar *json_file;
+  gint log_level;
+
+  GST_OBJECT_LOCK (self);
+  json_file = g_strdup (self->infer_json_file);
+  GST_OBJECT_UNLOCK (self);
+
+  root = json_load_file (json_file, JSON_DECODE_ANY, &error);
+  if (!root) {
+    GST_ERROR_OBJECT (self, "failed to load json file %s. reason %s",
+        json_file, error.text);
+    goto out;
+  }
+
+  kernel = json_object_get (root, "kernel");
+  config = json_object_get (kernel, "config");
+  if (!json_is_object (config)) {
+    GST_ERROR_OBJECT (self, "failed to find kernel config object in %s",
+        json_file);
+    goto out;
+  }
+
+  value = json_object_get (config, "postprocess-lib-path");
+  if (load->do_postprocess || json_is_string (value)) {
+    GST_ERROR_OBJECT (self, "model swap is not supported along with "
+        "post-processing library, set infer-config in NULL state");
+    goto out;
+  }
+
+  dpu_conf = vvas_xinfer_parse_dpu_conf (self, config);
+  if (!dpu_conf)
+    goto out;
+  dpu_conf->batch_size = load->batch_size;
+
+  value = json_object_get (config, "debug-level");
+  log_level = json_is_integer (value) ? json_integer_value (value) : 1;
+
+  if (dpu_conf->need_preprocess != cur_need_preprocess ||
+      dpu_conf->model_format != cur_model_format) {
+    GST_ERROR_OBJECT (self, "model %s needs different pre-processing than "
+        "current model", dpu_conf->model_name);
+    goto out;
+  }
+
+  runner = vvas_xinfer_runner_acquire (self, dpu_conf, log_level);
+  if (!runner)
+    goto out;
+
+  if (runner->model_conf.model_width != cur_model_conf.model_width ||
+      runner->model_conf.model_height != cur_model_conf.model_height ||
+      runner->model_conf.batch_size < load->batch_size ||
+      (load->do_preprocess && !cur_need_preprocess &&
+          (runner->model_conf.mean_r != cur_model_conf.mean_r ||
+              runner->model_conf.mean_g != cur_model_conf.mean_g ||
+              runner->model_conf.mean_b != cur_model_conf.mean_b ||
+              runner->model_conf.scale_r != cur_model_conf.scale_r ||
+              runner->model_conf.scale_g != cur_model_conf.scale_g ||
+              runner->model_conf.scale_b != cur_model_conf.scale_b))) {
+    GST_ERROR_OBJECT (self, "model %s (%dx%d, batch %d) is not compatible "
+        "with current model (%dx%d, batch %u)", dpu_conf->model_name,
+        runner->model_conf.model_width, runner->model_conf.model_height,
+        runner->model_conf.batch_size, cur_model_conf.model_width,
+        cur_model_conf.model_height, load->batch_size);
+    vvas_xinfer_runner_release (runner);
+    goto out;
+  }
+
+  g_mutex_lock (&priv->loader_lock);
+  if (load->generation == priv->loader_generation) {
+    /* replaces a model of an older request not yet swapped in */
+    dropped = priv->pending_runner;
+    dropped_conf = priv->pending_dpu_conf;
+    priv->pending_dpu_conf = dpu_conf;
+    g_atomic_pointer_set (&priv->pending_runner, runner);
+    GST_INFO_OBJECT (self, "model %s loaded, swapping at next batch",
+        dpu_conf->model_name);
+  } else {
+    GST_INFO_OBJECT (self, "dropping model %s, superseded or stopped",
+        dpu_conf->model_name);
+    dropped = runner;
+    dropped_conf = dpu_conf;
+  }
+  dpu_conf = NULL;
+  g_mutex_unlock (&priv->loader_lock);
+
+  if (dropped) {
+    vvas_xinfer_runner_release (dropped);
+    free_dpuinfer_conf (dropped_conf);
+  }
+
+out:
+  if (dpu_conf)
+    free_dpuinfer_conf (dpu_conf);
+  if (root)
+    json_decref (root);
+  g_free (json_file);
+  gst_object_unref (self);
+  g_slice_free (Vvas_XInferModelLoad, load);
+  return NULL;
+}
+
+/**
+ * @fn static void vvas_xinfer_swap_model (GstVvas_XInfer * self)
+ * @param [in] self - Handle to GstVvas_XInfer
+ * @return None
+ *
+ * @brief Swaps in the model loaded by vvas_xinfer_model_loader
+ * @details Called by inference thread between two batches, so no frame is in
+ *          flight on the runner being replaced. Other threads only read
+ *          dpu_conf under infer_lock, so the replaced one is freed here.
+ */
+static void
+vvas_xinfer_swap_model (GstVvas_XInfer * self)
+{
+  GstVvas_XInferPrivate *priv = self->priv;
+  Vvas_XInferRunner *old_runner, *runner;
+  VvasDpuInferConf *old_conf, *dpu_conf;
+
+  g_mutex_lock (&priv->loader_lock);
+  runner = priv->pending_runner;
+  dpu_conf = priv->pending_dpu_conf;
+  g_atomic_pointer_set (&priv->pending_runner, NULL);
+  priv->pending_dpu_conf = NULL;
+  g_mutex_unlock (&priv->loader_lock);
+
+  if (!runner)
+    return;
+
+  g_mutex_lock (&priv->infer_lock);
+  old_runner = priv->runner;
+  old_conf = priv->dpu_conf;
+
+  priv->runner = runner;
+  priv->dpu_conf = dpu_conf;
+
+  priv->infer_handle->handle = priv->runner->handle;
+  priv->model_conf = priv->runner->model_conf;
+  priv->postproc_conf.model_path = priv->dpu_conf->model_path;
+  priv->postproc_conf.model_name = priv->dpu_conf->model_name;
+  g_mutex_unlock (&priv->infer_lock);
+
+  GST_INFO_OBJECT (self, "switched to model %s", dpu_conf->model_name);
+
+  vvas_xinfer_runner_release (old_runner);
+  free_dpuinfer_conf (old_conf);
+}
+
 /**
  * @fn static gboolean vvas_xinfer_prepare_ppe_input_frame (GstVvas_XInfer * self, GstBuffer * inbuf,
  *                                                          GstVideoInfo * in_vinfo, GstBuffer ** new_inbuf,
@@ -1961,7 +2701,9 @@ vvas_xinfer_prepare_ppe_input_frame (GstVvas_XInfer * self, GstBuffer * inbuf,
     if (!phy_addr) {
       GST_DEBUG_OBJECT (self,
           "could not get phy_addr, copy input buffer to internal pool buffer");
-      bret = vvas_xinfer_copy_input_buffer (self, inbuf, new_inbuf);
+      bret = vvas_xinfer_copy_input_buffer (self, inbuf, new_inbuf,
+          gst_is_vvas_memory (in_mem) ? GST_VVAS_COPY_REASON_BANK_MISMATCH :
+          GST_VVAS_COPY_REASON_FOREIGN_MEMORY);
       if (!bret)
         goto error;
 
@@ -1981,7 +2723,7 @@ vvas_xinfer_prepare_ppe_input_frame (GstVvas_XInfer * self, GstBuffer * inbuf,
       inbuf = *new_inbuf;
     }
     /* syncs data when VVAS_SYNC_TO_DEVICE flag is enabled */
-    bret = gst_vvas_memory_sync_bo (in_mem);
+    bret = gst_vvas_memory_sync_bo_full (in_mem, &priv->mem_stats);
     if (!bret)
       goto error;
 
@@ -2094,10 +2836,16 @@ xlnx_multiscaler_descriptor_create (GstVvas_XInfer * self,
   VvasScalerPpe ppe = { 0 };
   VvasVideoInfo out_vinfo = { 0 };
   VvasScalerParam param = { 0 };
+  gboolean need_preprocess;
 
   GST_DEBUG_OBJECT (self,
       "Creating descriptor for %d scaling tasks", roi_data->nobj);
 
+  /* dpu_conf may be replaced by a model swap */
+  g_mutex_lock (&priv->infer_lock);
+  need_preprocess = priv->dpu_conf->need_preprocess;
+  g_mutex_unlock (&priv->infer_lock);
+
   priv->ppe_frame->input_roi.nobj = priv->roi_data.nobj;
   priv->ppe_frame->output_roi.nobj = priv->roi_data.nobj;
 
@@ -2127,7 +2875,7 @@ xlnx_multiscaler_descriptor_create (GstVvas_XInfer * self,
 
     param = priv->param;
 
-    if (!priv->dpu_conf->need_preprocess) {
+    if (!need_preprocess) {
       /* Add the channel for scaler */
       vret =
           vvas_scaler_channel_add (priv->ppe_handle->handle, &src_rect,
@@ -2268,42 +3016,325 @@ xlnx_ppe_start (GstVvas_XInfer * self, VvasVideoFrame * input[MAX_NUM_OBJECT],
  * @return TRUE on success
  *         FALSE - GstMemory or GstVideoMeta is not available
  *
- * @brief This function populate the vvas_frame with required information extracted
- *        from outbuf and out_vinfo
+ * @brief This function populate the vvas_frame with required information extracted
+ *        from outbuf and out_vinfo
+ */
+static gboolean
+vvas_xinfer_prepare_ppe_output_frame (GstVvas_XInfer * self, GstBuffer * outbuf,
+    GstVideoInfo * out_vinfo, VvasVideoFrame ** vvas_frame)
+{
+  GstMemory *out_mem = NULL;
+  GstMapFlags map_flags;
+  GstVvas_XInferPrivate *priv = self->priv;
+
+  if (!priv->software_ppe) {
+    out_mem = gst_buffer_get_memory (outbuf, 0);
+    if (out_mem == NULL) {
+      GST_ERROR_OBJECT (self, "failed to get memory from output buffer");
+      goto error;
+    }
+
+    map_flags = GST_MAP_WRITE | GST_VIDEO_FRAME_MAP_FLAG_NO_REF;
+    *vvas_frame =
+        vvas_videoframe_from_gstbuffer (priv->ppe_vvas_ctx,
+        priv->ppe_out_mem_bank, outbuf, out_vinfo, map_flags);
+    /* setting SYNC_FROM_DEVICE here to avoid work by kernel lib */
+    gst_vvas_memory_set_sync_flag (out_mem, VVAS_SYNC_FROM_DEVICE);
+    gst_memory_unref (out_mem);
+    GST_LOG_OBJECT (self, "successfully prepared output vvas frame");
+  } else {
+    map_flags = GST_MAP_WRITE | GST_VIDEO_FRAME_MAP_FLAG_NO_REF;
+    *vvas_frame =
+        vvas_videoframe_from_gstbuffer (priv->ppe_vvas_ctx, -1, outbuf,
+        out_vinfo, map_flags);
+  }
+  return TRUE;
+
+error:
+  return FALSE;
+}
+
+/**
+ * @fn static Vvas_XInferSource * vvas_xinfer_get_source (GstVvas_XInfer * self, guint src_id)
+ * @param [in] self - handle to GstVvas_XInfer
+ * @param [in] src_id - source id from GstVvasSrcIDMeta
+ *
+ * @return Vvas_XInferSource of \p src_id
+ *
+ * @brief Looks up a source, creating it on its first frame. The caller must
+ *        hold sources_lock.
+ */
+static Vvas_XInferSource *
+vvas_xinfer_get_source (GstVvas_XInfer * self, guint src_id)
+{
+  GstVvas_XInferPrivate *priv = self->priv;
+  Vvas_XInferSource *src;
+  gpointer weight;
+
+  src = (Vvas_XInferSource *) g_hash_table_lookup (priv->sources,
+      GUINT_TO_POINTER (src_id));
+  if (!src) {
+    src = g_new0 (Vvas_XInferSource, 1);
+    src->weight = 1;
+    if (priv->source_weights && g_hash_table_lookup_extended
+        (priv->source_weights, GUINT_TO_POINTER (src_id), NULL, &weight))
+      src->weight = GPOINTER_TO_UINT (weight);
+    /* new source starts at current virtual time, not with a backlog */
+    src->vtime = priv->vclock;
+    g_hash_table_insert (priv->sources, GUINT_TO_POINTER (src_id), src);
+  }
+  return src;
+}
+
+/**
+ * @fn static void vvas_xinfer_queue_frame (GstVvas_XInfer * self, Vvas_XInferFrame * frame)
+ * @param [in] self - handle to GstVvas_XInfer
+ * @param [in] frame - frame to be inferred or event to be passed
+ *
+ * @return None
+ *
+ * @brief Adds a frame at the tail of infer_batch_queue after tagging it with
+ *        its source. The caller must hold infer_lock.
+ */
+static void
+vvas_xinfer_queue_frame (GstVvas_XInfer * self, Vvas_XInferFrame * frame)
+{
+  GstVvas_XInferPrivate *priv = self->priv;
+  GstVvasSrcIDMeta *srcid_meta = NULL;
+
+  if (frame->parent_buf)
+    srcid_meta = gst_buffer_get_vvas_srcid_meta (frame->parent_buf);
+  frame->src_id = srcid_meta ? srcid_meta->src_id : 0;
+  frame->queued_ts = gst_util_get_timestamp ();
+
+  if (!frame->event) {
+    g_mutex_lock (&priv->sources_lock);
+    vvas_xinfer_get_source (self, frame->src_id)->queued++;
+    g_mutex_unlock (&priv->sources_lock);
+  }
+  g_queue_push_tail (priv->infer_batch_queue, frame);
+}
+
+/**
+ * @fn static gboolean vvas_xinfer_only_skipped_pending (GstVvas_XInfer * self)
+ * @param [in] self - handle to GstVvas_XInfer
+ *
+ * @return TRUE if no frame waiting for inference is queued or held by the
+ *         infer thread
+ *
+ * @brief Tells whether frames skipped for latency budget can be pushed right
+ *        away. Otherwise they wait behind the batch being built, which is
+ *        not cut short for them. The caller must hold infer_lock.
+ */
+static gboolean
+vvas_xinfer_only_skipped_pending (GstVvas_XInfer * self)
+{
+  GstVvas_XInferPrivate *priv = self->priv;
+  GList *node;
+
+  if (priv->batch_building)
+    return FALSE;
+
+  for (node = priv->infer_batch_queue->head; node; node = node->next) {
+    Vvas_XInferFrame *frame = (Vvas_XInferFrame *) node->data;
+    if (!frame->skip_processing)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @fn static Vvas_XInferFrame * vvas_xinfer_pop_frame (GstVvas_XInfer * self)
+ * @param [in] self - handle to GstVvas_XInfer
+ *
+ * @return Next frame to be added to the batch, NULL if queue is empty
+ *
+ * @brief Takes the next frame for the batch from infer_batch_queue as per
+ *        batch-scheduling. The caller must hold infer_lock.
+ * @detail In fifo mode, or at inference level > 1 where the frames of a parent
+ *         have to stay together, the head of the queue is taken. Otherwise
+ *         the oldest frame of the source chosen by round-robin over source ids
+ *         or by weighted fair queuing is taken. Frames are never taken ahead
+ *         of an event queued before them, nor ahead of an older frame of
+ *         their own source.
+ */
+static Vvas_XInferFrame *
+vvas_xinfer_pop_frame (GstVvas_XInfer * self)
+{
+  GstVvas_XInferPrivate *priv = self->priv;
+  GList *node, *best;
+  Vvas_XInferFrame *frame;
+  Vvas_XInferSource *src, *best_src = NULL;
+  gdouble finish, best_finish = 0;
+  guint dist, best_dist = 0;
+
+  best = priv->infer_batch_queue->head;
+  if (!best)
+    return NULL;
+
+  g_mutex_lock (&priv->sources_lock);
+  if (self->batch_scheduling != GST_VVAS_XINFER_SCHEDULING_FIFO &&
+      priv->infer_level == 1) {
+    for (node = best; node; node = node->next) {
+      frame = (Vvas_XInferFrame *) node->data;
+      if (frame->event)
+        break;
+
+      src = vvas_xinfer_get_source (self, frame->src_id);
+      /* comparisons are strict, so oldest frame of a source wins */
+      if (self->batch_scheduling == GST_VVAS_XINFER_SCHEDULING_WFQ) {
+        finish = MAX (src->vtime, priv->vclock) + 1.0 / src->weight;
+        if (!best_src || finish < best_finish) {
+          best = node;
+          best_src = src;
+          best_finish = finish;
+        }
+      } else {
+        /* distance to the source after the last one served */
+        dist = frame->src_id - priv->rr_last - 1;
+        if (!best_src || dist < best_dist) {
+          best = node;
+          best_src = src;
+          best_dist = dist;
+        }
+      }
+    }
+  }
+
+  frame = (Vvas_XInferFrame *) best->data;
+  g_queue_delete_link (priv->infer_batch_queue, best);
+
+  /* frames skipped for latency budget do not use the share of a source */
+  if (best_src && !frame->skip_processing) {
+    if (self->batch_scheduling == GST_VVAS_XINFER_SCHEDULING_WFQ) {
+      priv->vclock = MAX (best_src->vtime, priv->vclock);
+      best_src->vtime = best_finish;
+    } else {
+      priv->rr_last = frame->src_id;
+    }
+  }
+
+  if (!frame->event) {
+    src = vvas_xinfer_get_source (self, frame->src_id);
+    src->queued--;
+    if (self->max_source_queue && src->queued < self->max_source_queue)
+      g_cond_signal (&priv->infer_batch_full);
+  }
+  g_mutex_unlock (&priv->sources_lock);
+
+  return frame;
+}
+
+/**
+ * @fn static void vvas_xinfer_account_latency (GstVvas_XInfer * self, guint src_id,
+ *                                              GstClockTime queued_ts)
+ * @param [in] self - handle to GstVvas_XInfer
+ * @param [in] src_id - source id of the pushed frame
+ * @param [in] queued_ts - time at which the frame was added to infer queue
+ *
+ * @return None
+ *
+ * @brief Updates latency statistics of a source on push of an inferred frame
+ */
+static void
+vvas_xinfer_account_latency (GstVvas_XInfer * self, guint src_id,
+    GstClockTime queued_ts)
+{
+  GstVvas_XInferPrivate *priv = self->priv;
+  GstClockTime latency = gst_util_get_timestamp () - queued_ts;
+  Vvas_XInferSource *src;
+
+  g_mutex_lock (&priv->sources_lock);
+  src = vvas_xinfer_get_source (self, src_id);
+  src->frames++;
+  src->latency_total += latency;
+  src->latency_max = MAX (src->latency_max, latency);
+  g_mutex_unlock (&priv->sources_lock);
+}
+
+/**
+ * @fn static GstStructure * vvas_xinfer_sources_to_structure (GstVvas_XInfer * self)
+ * @param [in] self - handle to GstVvas_XInfer
+ *
+ * @return New GstStructure, free with gst_structure_free
+ *
+ * @brief Converts statistics of all sources to a "vvas-infer-sources"
+ *        structure, having a "source-<id>" structure field per source
+ */
+static GstStructure *
+vvas_xinfer_sources_to_structure (GstVvas_XInfer * self)
+{
+  GstVvas_XInferPrivate *priv = self->priv;
+  GstStructure *st = gst_structure_new_empty ("vvas-infer-sources");
+  GHashTableIter iter;
+  gpointer key, value;
+
+  g_mutex_lock (&priv->sources_lock);
+  g_hash_table_iter_init (&iter, priv->sources);
+  while (g_hash_table_iter_next (&iter, &key, &value)) {
+    Vvas_XInferSource *src = (Vvas_XInferSource *) value;
+    GstStructure *src_st;
+    gchar *name;
+
+    src_st = gst_structure_new ("source",
+        "frames", G_TYPE_UINT64, src->frames,
+        "skipped", G_TYPE_UINT64, src->skipped,
+        "queued", G_TYPE_UINT, src->queued,
+        "weight", G_TYPE_UINT, src->weight,
+        "latency-avg", G_TYPE_UINT64,
+        src->frames ? src->latency_total / src->frames : 0,
+        "latency-max", G_TYPE_UINT64, src->latency_max, NULL);
+    name = g_strdup_printf ("source-%u", GPOINTER_TO_UINT (key));
+    gst_structure_take (st, name, src_st);
+    g_free (name);
+  }
+  g_mutex_unlock (&priv->sources_lock);
+
+  return st;
+}
+
+/**
+ * @fn static void vvas_xinfer_parse_source_weights (GstVvas_XInfer * self)
+ * @param [in] self - handle to GstVvas_XInfer
+ *
+ * @return None
+ *
+ * @brief Parses source-weights property, a comma separated list of
+ *        "<source id>:<weight>" pairs, into source_weights table
  */
-static gboolean
-vvas_xinfer_prepare_ppe_output_frame (GstVvas_XInfer * self, GstBuffer * outbuf,
-    GstVideoInfo * out_vinfo, VvasVideoFrame ** vvas_frame)
+static void
+vvas_xinfer_parse_source_weights (GstVvas_XInfer * self)
 {
-  GstMemory *out_mem = NULL;
-  GstMapFlags map_flags;
   GstVvas_XInferPrivate *priv = self->priv;
+  gchar **pairs;
+  guint i;
 
-  if (!priv->software_ppe) {
-    out_mem = gst_buffer_get_memory (outbuf, 0);
-    if (out_mem == NULL) {
-      GST_ERROR_OBJECT (self, "failed to get memory from output buffer");
-      goto error;
-    }
+  g_hash_table_remove_all (priv->source_weights);
+  if (!self->source_weights)
+    return;
 
-    map_flags = GST_MAP_WRITE | GST_VIDEO_FRAME_MAP_FLAG_NO_REF;
-    *vvas_frame =
-        vvas_videoframe_from_gstbuffer (priv->ppe_vvas_ctx,
-        priv->ppe_out_mem_bank, outbuf, out_vinfo, map_flags);
-    /* setting SYNC_FROM_DEVICE here to avoid work by kernel lib */
-    gst_vvas_memory_set_sync_flag (out_mem, VVAS_SYNC_FROM_DEVICE);
-    gst_memory_unref (out_mem);
-    GST_LOG_OBJECT (self, "successfully prepared output vvas frame");
-  } else {
-    map_flags = GST_MAP_WRITE | GST_VIDEO_FRAME_MAP_FLAG_NO_REF;
-    *vvas_frame =
-        vvas_videoframe_from_gstbuffer (priv->ppe_vvas_ctx, -1, outbuf,
-        out_vinfo, map_flags);
-  }
-  return TRUE;
+  pairs = g_strsplit (self->source_weights, ",", -1);
+  for (i = 0; pairs[i]; i++) {
+    guint64 src_id, weight;
+    gchar *end;
 
-error:
-  return FALSE;
+    src_id = g_ascii_strtoull (pairs[i], &end, 10);
+    if (end == pairs[i] || *end != ':')
+      goto invalid;
+    weight = g_ascii_strtoull (end + 1, &end, 10);
+    if (*end != '\0' || !weight || weight > G_MAXUINT)
+      goto invalid;
+
+    g_hash_table_insert (priv->source_weights,
+        GUINT_TO_POINTER ((guint) src_id), GUINT_TO_POINTER ((guint) weight));
+    continue;
+
+  invalid:
+    GST_WARNING_OBJECT (self, "ignoring invalid source weight \"%s\"",
+        pairs[i]);
+  }
+  g_strfreev (pairs);
 }
 
 /**
@@ -2364,13 +3395,18 @@ vvas_xinfer_ppe_loop (gpointer data)
       event_frame->skip_processing = TRUE;
 
       g_mutex_lock (&priv->infer_lock);
-      g_queue_push_tail (priv->infer_batch_queue, event_frame);
+      vvas_xinfer_queue_frame (self, event_frame);
       g_mutex_unlock (&priv->infer_lock);
       GST_INFO_OBJECT (self, "received EOS event, push frame %p and exit",
           event_frame);
       goto exit;
     }
 
+    if (priv->ppe_frame->skip_processing) {
+      GST_DEBUG_OBJECT (self, "Skipping inference to meet latency budget");
+      goto skipframe;
+    }
+
     /* PPE get metadata at level > 1 */
     parent_meta = (GstInferenceMeta *) gst_buffer_get_meta
         (priv->ppe_frame->parent_buf, gst_inference_meta_api_get_type ());
@@ -2421,7 +3457,7 @@ vvas_xinfer_ppe_loop (gpointer data)
         infer_frame->use_roi_data = FALSE;
 
         g_mutex_lock (&priv->infer_lock);
-        g_queue_push_tail (priv->infer_batch_queue, infer_frame);
+        vvas_xinfer_queue_frame (self, infer_frame);
         g_mutex_unlock (&priv->infer_lock);
 
         gst_video_info_free (child_vinfo);
@@ -2547,18 +3583,43 @@ vvas_xinfer_ppe_loop (gpointer data)
 
             g_mutex_lock (&priv->infer_lock);
             /* add frame for infer processing */
-            g_queue_push_tail (priv->infer_batch_queue, infer_frame);
+            vvas_xinfer_queue_frame (self, infer_frame);
             g_mutex_unlock (&priv->infer_lock);
           }
           gst_video_info_free (child_vinfo);
           do_ppe = FALSE;
         } else {
           priv->nframes_in_level = 0;
+          priv->n_ppe_outbufs = 0;
+
+          /* acquire PPE output buffers of all nodes at this level at once */
+          g_node_traverse ((GNode *) parent_meta->prediction->prediction.node,
+              G_PRE_ORDER, G_TRAVERSE_ALL, priv->infer_level,
+              count_ppe_outbuf_at_level, self);
+          priv->n_ppe_outbufs = MIN (priv->n_ppe_outbufs, MAX_NUM_OBJECT);
+          fret = gst_vvas_buffer_pool_acquire_buffers (priv->ppe_outpool,
+              priv->ppe_outbufs, priv->n_ppe_outbufs, NULL);
+          if (fret != GST_FLOW_OK) {
+            GST_ERROR_OBJECT (self, "failed to allocate %u buffers from pool %p",
+                priv->n_ppe_outbufs, priv->ppe_outpool);
+            priv->n_ppe_outbufs = 0;
+            goto error;
+          }
 
           /* ppe_kernel->output array will be filled on node traversal */
           g_node_traverse ((GNode *) parent_meta->prediction->prediction.node,
               G_PRE_ORDER, G_TRAVERSE_ALL, priv->infer_level,
               prepare_ppe_outbuf_at_level, self);
+
+          /* drop batched buffers left over by an error in the traversal */
+          for (oidx = priv->nframes_in_level; oidx < priv->n_ppe_outbufs;
+              oidx++) {
+            if (priv->ppe_outbufs[oidx])
+              gst_buffer_unref (priv->ppe_outbufs[oidx]);
+            priv->ppe_outbufs[oidx] = NULL;
+          }
+          priv->n_ppe_outbufs = 0;
+
           if (priv->is_error)
             goto error;
 
@@ -2598,9 +3659,14 @@ vvas_xinfer_ppe_loop (gpointer data)
           goto exit;
         }
         /* send input frame to inference thread */
-        g_queue_push_tail (priv->infer_batch_queue, infer_frame);
+        vvas_xinfer_queue_frame (self, infer_frame);
 
-        if (priv->infer_batch_size ==
+        if (priv->ppe_frame->skip_processing
+            && vvas_xinfer_only_skipped_pending (self)) {
+          /* skipped for latency budget and no batch to wait for */
+          priv->flush_batch = TRUE;
+          g_cond_signal (&priv->infer_cond);
+        } else if (priv->infer_batch_size ==
             g_queue_get_length (priv->infer_batch_queue)) {
           g_cond_signal (&priv->infer_cond);
         }
@@ -2609,13 +3675,18 @@ vvas_xinfer_ppe_loop (gpointer data)
     }
 
     if (do_ppe) {
+      GstClockTime trace_ts;
+
       /* Add parent frame as input */
       priv->ppe_handle->input[0] = priv->ppe_frame->vvas_frame;
 
       /* Run PPE */
+      trace_ts = gst_vvas_trace_start ();
       ret =
           xlnx_ppe_start (self, priv->ppe_handle->input,
           priv->ppe_handle->output, priv->ppe_frame->child_buf);
+      gst_vvas_trace_stop (GST_OBJECT (self), GST_VVAS_TRACE_PPE_TIME,
+          trace_ts);
       if (!ret) {
         GST_ERROR_OBJECT (self, "kernel start failed");
         goto error;
@@ -2656,7 +3727,7 @@ vvas_xinfer_ppe_loop (gpointer data)
         g_mutex_lock (&priv->infer_lock);
         GST_LOG_OBJECT (self, "pushing child_buf %p in infer_frame %p to queue",
             infer_frame->child_buf, infer_frame);
-        g_queue_push_tail (priv->infer_batch_queue, infer_frame);
+        vvas_xinfer_queue_frame (self, infer_frame);
         g_mutex_unlock (&priv->infer_lock);
       }
     }
@@ -2717,177 +3788,133 @@ error:
 }
 
 /**
- * @fn static void transform_coordinates (GstVvas_XInfer * self,VvasBoundingBox * c_bbox,
- *					  VvasBoundingBox * p_bbox, gdouble hfactor, gdouble vfactor)
- * @param [in] self - Handle to GstVvas_XInfer
- * @param [inout] c_bbox - child bbox which need to transform to new values
- * @param [in] p_bbox - Parent bbox to which child has to transform
+ * @fn static void vvas_xinfer_coords_add (Vvas_XInferCoords * coords, gfloat x, gfloat y,
+ *                                         gfloat hfactor, gfloat vfactor, gint32 xbase,
+ *                                         gint32 ybase, gint32 xoffset, gint32 yoffset,
+ *                                         gpointer dest_x, gpointer dest_y, gboolean is_float)
+ * @param [inout] coords - Batch of coordinates
+ * @param [in] x - x coordinate (or width) in child resolution
+ * @param [in] y - y coordinate (or height) in child resolution
  * @param [in] hfactor - x transform factor
  * @param [in] vfactor - y transform factor
- * @param [in] xOffset - x offset value
- * @param [in] yOffset - y offset value
+ * @param [in] xbase - x position of parent bbox
+ * @param [in] ybase - y position of parent bbox
+ * @param [in] xoffset - x offset value
+ * @param [in] yoffset - y offset value
+ * @param [in] dest_x - Where to write back-projected x
+ * @param [in] dest_y - Where to write back-projected y
+ * @param [in] is_float - TRUE if destination is float, FALSE if int32
  * @return None
  *
- * @brief Transform child bbox to Parent bbox resolution
+ * @brief Append one coordinate pair to batch of coordinates to be
+ *        back-projected
  */
 static void
-transform_coordinates (GstVvas_XInfer * self,
-    VvasBoundingBox * c_bbox, VvasBoundingBox * p_bbox,
-    gdouble hfactor, gdouble vfactor, int32_t xOffset, int32_t yOffset)
+vvas_xinfer_coords_add (Vvas_XInferCoords * coords, gfloat x, gfloat y,
+    gfloat hfactor, gfloat vfactor, gint32 xbase, gint32 ybase,
+    gint32 xoffset, gint32 yoffset, gpointer dest_x, gpointer dest_y,
+    gboolean is_float)
 {
-  GST_LOG_OBJECT (self, "bbox : x = %d, y = %d, w = %d, h = %d",
-      c_bbox->x, c_bbox->y, c_bbox->width, c_bbox->height);
-
-  c_bbox->x = nearbyintf (c_bbox->x * hfactor);
-  c_bbox->y = nearbyintf (c_bbox->y * vfactor);
-
-  c_bbox->width = nearbyintf (c_bbox->width * hfactor);
-  c_bbox->height = nearbyintf (c_bbox->height * vfactor);
-
-  GST_LOG_OBJECT (self, "hfactor = %f vfactor = %f", hfactor, vfactor);
-  GST_LOG_OBJECT (self, "bbox add factor : x = %d, y = %d, w = %d, h = %d",
-      c_bbox->x, c_bbox->y, c_bbox->width, c_bbox->height);
-
-  GST_LOG_OBJECT (self, "(x,y) : (%d, %d) -> (%d, %d)",
-      c_bbox->x, c_bbox->y, c_bbox->x + p_bbox->x, c_bbox->y + p_bbox->y);
-
-  /* scale x offset to parent bbox resolution */
-  c_bbox->x += p_bbox->x;
-  c_bbox->y += p_bbox->y;
-
-  if (xOffset < 0 && abs (xOffset) > c_bbox->x)
-    c_bbox->x = 0;
-  else
-    c_bbox->x += xOffset;
-
-  if (yOffset < 0 && abs (yOffset) > c_bbox->y)
-    c_bbox->y = 0;
-  else
-    c_bbox->y += yOffset;
+  guint i;
+
+  if (coords->len == coords->size) {
+    coords->size = MAX (64, coords->size * 2);
+    coords->x = g_renew (gfloat, coords->x, coords->size);
+    coords->y = g_renew (gfloat, coords->y, coords->size);
+    coords->hfactor = g_renew (gfloat, coords->hfactor, coords->size);
+    coords->vfactor = g_renew (gfloat, coords->vfactor, coords->size);
+    coords->xbase = g_renew (gint32, coords->xbase, coords->size);
+    coords->ybase = g_renew (gint32, coords->ybase, coords->size);
+    coords->xoffset = g_renew (gint32, coords->xoffset, coords->size);
+    coords->yoffset = g_renew (gint32, coords->yoffset, coords->size);
+    coords->out_x = g_renew (gint32, coords->out_x, coords->size);
+    coords->out_y = g_renew (gint32, coords->out_y, coords->size);
+    coords->dest = g_renew (Vvas_XInferCoordDest, coords->dest, coords->size);
+  }
+
+  i = coords->len++;
+  coords->x[i] = x;
+  coords->y[i] = y;
+  coords->hfactor[i] = hfactor;
+  coords->vfactor[i] = vfactor;
+  coords->xbase[i] = xbase;
+  coords->ybase[i] = ybase;
+  coords->xoffset[i] = xoffset;
+  coords->yoffset[i] = yoffset;
+  coords->dest[i].x = dest_x;
+  coords->dest[i].y = dest_y;
+  coords->dest[i].is_float = is_float;
 }
 
 /**
- * @fn static void transform_landmark (GstVvas_XInfer * self, GstInferencePrediction * cur_prediction,
- *				       GstInferencePrediction * parent_prediction, gdouble hfactor, gdouble vfactor)
- * @param [in] self - Handle to GstVvas_XInfer
- * @param [inout] cur_prediction - current prediction which need to transform
- * @param [in] parent_prediction - parent prediction
- * @param [in] hfactor - x transform factor
- * @param [in] vfactor - y transform factor
- * @param [in] xOffset - x offset value
- * @param [in] yOffset - y offset value 
+ * @fn static void vvas_xinfer_coords_reset (Vvas_XInferCoords * coords)
+ * @param [inout] coords - Batch of coordinates
  * @return None
  *
- * @brief Build bbox from landmark points and send for transform
+ * @brief Drop all entries of batch, allocated memory is kept for next batch
  */
 static void
-transform_landmark (GstVvas_XInfer * self,
-    GstInferencePrediction * cur_prediction,
-    GstInferencePrediction * parent_prediction,
-    gdouble hfactor, gdouble vfactor, int32_t xOffset, int32_t yOffset)
-{
-  gint num;
-  VvasBoundingBox c_bbox;
-
-  for (num = 0; num < NUM_LANDMARK_POINT; num++) {
-    Pointf *point_ptr =
-        (Pointf *) & (cur_prediction->prediction.feature.landmark[num].x);
-    c_bbox.x = point_ptr->x;
-    c_bbox.y = point_ptr->y;
-    c_bbox.width = 0;
-    c_bbox.height = 0;
-
-    transform_coordinates (self, &c_bbox, &parent_prediction->prediction.bbox,
-        hfactor, vfactor, xOffset, yOffset);
-    point_ptr->x = c_bbox.x;
-    point_ptr->y = c_bbox.y;
-  }
-}
-
-static void
-transform_roadlines (GstVvas_XInfer * self,
-    GstInferencePrediction * cur_prediction,
-    GstInferencePrediction * parent_prediction,
-    gdouble hfactor, gdouble vfactor, int32_t xOffset, int32_t yOffset)
+vvas_xinfer_coords_reset (Vvas_XInferCoords * coords)
 {
-  gint num;
-  VvasBoundingBox c_bbox;
-
-  for (num = 0; num < cur_prediction->prediction.feature.line_size; num++) {
-    Pointf *point_ptr =
-        (Pointf *) & (cur_prediction->prediction.feature.road_line[num].x);
-    c_bbox.x = point_ptr->x;
-    c_bbox.y = point_ptr->y;
-    c_bbox.width = 0;
-    c_bbox.height = 0;
-
-    transform_coordinates (self, &c_bbox, &parent_prediction->prediction.bbox,
-        hfactor, vfactor, xOffset, yOffset);
-    point_ptr->x = c_bbox.x;
-    point_ptr->y = c_bbox.y;
-  }
+  coords->len = 0;
+  if (!coords->boxes)
+    coords->boxes = g_array_new (FALSE, FALSE, sizeof (Vvas_XInferCoordBox));
+  else
+    g_array_set_size (coords->boxes, 0);
 }
 
 /**
- * @fn static void transform_pose14pt (GstVvas_XInfer * self, GstInferencePrediction * cur_prediction,
- *				       GstInferencePrediction * parent_prediction, gdouble hfactor, gdouble vfactor)
- * @param [in] self - Handle to GstVvas_XInfer
- * @param [inout] cur_prediction - current prediction which need to transform
- * @param [in] parent_prediction - parent prediction
- * @param [in] hfactor - x transform factor
- * @param [in] vfactor - y transform factor
- * @param [in] xOffset - x offset value
- * @param [in] yOffset - y offset value
+ * @fn static void vvas_xinfer_coords_free (Vvas_XInferCoords * coords)
+ * @param [inout] coords - Batch of coordinates
  * @return None
  *
- * @brief Build bbox from Pose14Pt points and send for transform
+ * @brief Free memory held by batch of coordinates
  */
 static void
-transform_pose14pt (GstVvas_XInfer * self,
-    GstInferencePrediction * cur_prediction,
-    GstInferencePrediction * parent_prediction,
-    gdouble hfactor, gdouble vfactor, int32_t xOffset, int32_t yOffset)
+vvas_xinfer_coords_free (Vvas_XInferCoords * coords)
 {
-  gint num;
-  VvasBoundingBox c_bbox;
-  Pose14Pt *pose14pt = &cur_prediction->prediction.pose14pt;
-  Pointf *point_ptr = (Pointf *) pose14pt;
-
-  for (num = 0; num < NUM_POSE_POINT; num++) {
-    c_bbox.x = point_ptr->x;
-    c_bbox.y = point_ptr->y;
-    c_bbox.width = 0;
-    c_bbox.height = 0;
-
-    transform_coordinates (self, &c_bbox, &parent_prediction->prediction.bbox,
-        hfactor, vfactor, xOffset, yOffset);
-    point_ptr->x = c_bbox.x;
-    point_ptr->y = c_bbox.y;
-
-    point_ptr++;
-  }
+  g_free (coords->x);
+  g_free (coords->y);
+  g_free (coords->hfactor);
+  g_free (coords->vfactor);
+  g_free (coords->xbase);
+  g_free (coords->ybase);
+  g_free (coords->xoffset);
+  g_free (coords->yoffset);
+  g_free (coords->out_x);
+  g_free (coords->out_y);
+  g_free (coords->dest);
+  if (coords->boxes)
+    g_array_free (coords->boxes, TRUE);
+  memset (coords, 0x0, sizeof (Vvas_XInferCoords));
 }
 
 /**
- * @fn static void update_child_bbox (GNode * node, gpointer data)
- * @param [in] node - a node in tree
- * @param [inout] data - used to typecast to Vvas_XInferNodeInfo
+ * @fn static void vvas_xinfer_gather_child_coords (Vvas_XInferCoords * coords,
+ *                                                  Vvas_XInferNodeInfo * node_info,
+ *                                                  GNode * parent)
+ * @param [inout] coords - Batch of coordinates
+ * @param [in] node_info - Video and ROI information of parent and child frames
+ * @param [in] parent - Node whose children need to be transformed
  * @return None
  *
- * @brief Transform child prediction coordinate as per parent coordinates
+ * @brief Collect bbox, pose, landmark and roadline coordinates of all
+ *        children of @parent which are not scaled yet
+ * @details Coordinates are only gathered here, they are back-projected to
+ *          parent resolution by vvas_xinfer_project_coords for whole batch
  */
 static void
-update_child_bbox (GNode * node, gpointer data)
+vvas_xinfer_gather_child_coords (Vvas_XInferCoords * coords,
+    Vvas_XInferNodeInfo * node_info, GNode * parent)
 {
-  Vvas_XInferNodeInfo *node_info = (Vvas_XInferNodeInfo *) data;
-  GstVvas_XInfer *self = node_info->self;
-  gdouble hfactor, vfactor;
+  GstInferencePrediction *parent_prediction =
+      (GstInferencePrediction *) parent->data;
+  VvasBoundingBox *p_bbox = &parent_prediction->prediction.bbox;
+  gfloat hfactor, vfactor;
   gint fw = 1, fh = 1, tw, th;
   int32_t xOffset = 0, yOffset = 0;
-  GstInferencePrediction *cur_prediction =
-      (GstInferencePrediction *) node->data;
-  GstInferencePrediction *parent_prediction =
-      (GstInferencePrediction *) node->parent->data;
+  GNode *node;
+  gint num;
 
   /* Aligned coordinates from Scaler */
   int tx = 0;
@@ -2897,9 +3924,11 @@ update_child_bbox (GNode * node, gpointer data)
   int bx = 0;
   int by = 0;
 
-  if (cur_prediction->prediction.bbox_scaled)
+  if (!parent->children)
     return;
 
+  /* Factors and offsets depend only on parent, compute them once for all
+   * children */
   if (node_info->use_roi_data) {
     tw = node_info->input_roi.roi[0].width;
     th = node_info->input_roi.roi[0].height;
@@ -2909,8 +3938,8 @@ update_child_bbox (GNode * node, gpointer data)
     tx = node_info->input_roi.roi[0].x_cord;
     ty = node_info->input_roi.roi[0].y_cord;
 
-    bx = parent_prediction->prediction.bbox.x;
-    by = parent_prediction->prediction.bbox.y;
+    bx = p_bbox->x;
+    by = p_bbox->y;
 
   } else {
     tw = GST_VIDEO_INFO_WIDTH (node_info->parent_vinfo);
@@ -2923,8 +3952,7 @@ update_child_bbox (GNode * node, gpointer data)
   vfactor = th * 1.0 / fh;
 
   if (node_info->use_roi_data) {
-    if (!parent_prediction->prediction.bbox.width
-        && !parent_prediction->prediction.bbox.height) {
+    if (!p_bbox->width && !p_bbox->height) {
       xOffset = node_info->input_roi.roi[0].x_cord;
       yOffset = node_info->input_roi.roi[0].y_cord;
     }
@@ -2943,48 +3971,138 @@ update_child_bbox (GNode * node, gpointer data)
     yOffset -= (by - ty);
   }
 
-  if (cur_prediction->prediction.bbox.width
-      && cur_prediction->prediction.bbox.height) {
-    transform_coordinates (self, &cur_prediction->prediction.bbox,
-        &parent_prediction->prediction.bbox, hfactor, vfactor,
-        xOffset, yOffset);
+  for (node = parent->children; node; node = node->next) {
+    GstInferencePrediction *cur_prediction =
+        (GstInferencePrediction *) node->data;
+    VvasBoundingBox *c_bbox = &cur_prediction->prediction.bbox;
 
-    /* check if updated coordinates are extended beyong original image
-     * and clip it to make within image boudary. */
-    if (GST_VIDEO_INFO_WIDTH (node_info->parent_vinfo) <
-        (cur_prediction->prediction.bbox.width +
-            cur_prediction->prediction.bbox.x)) {
-      cur_prediction->prediction.bbox.width -=
-          (cur_prediction->prediction.bbox.width +
-          cur_prediction->prediction.bbox.x -
-          GST_VIDEO_INFO_WIDTH (node_info->parent_vinfo));
+    if (cur_prediction->prediction.bbox_scaled)
+      continue;
+
+    if (c_bbox->width && c_bbox->height) {
+      Vvas_XInferCoordBox box;
+
+      vvas_xinfer_coords_add (coords, c_bbox->x, c_bbox->y, hfactor, vfactor,
+          p_bbox->x, p_bbox->y, xOffset, yOffset, &c_bbox->x, &c_bbox->y,
+          FALSE);
+      /* width and height are only scaled */
+      vvas_xinfer_coords_add (coords, c_bbox->width, c_bbox->height,
+          hfactor, vfactor, 0, 0, 0, 0, &c_bbox->width, &c_bbox->height,
+          FALSE);
+
+      box.prediction = cur_prediction;
+      box.max_width = GST_VIDEO_INFO_WIDTH (node_info->parent_vinfo);
+      box.max_height = GST_VIDEO_INFO_HEIGHT (node_info->parent_vinfo);
+      g_array_append_val (coords->boxes, box);
     }
-    if (GST_VIDEO_INFO_HEIGHT (node_info->parent_vinfo) <
-        (cur_prediction->prediction.bbox.height +
-            cur_prediction->prediction.bbox.y)) {
-      cur_prediction->prediction.bbox.height -=
-          (cur_prediction->prediction.bbox.height +
-          cur_prediction->prediction.bbox.y -
-          GST_VIDEO_INFO_HEIGHT (node_info->parent_vinfo));
+
+    if (cur_prediction->prediction.model_class == VVAS_XCLASS_POSEDETECT) {
+      Pointf *point_ptr = (Pointf *) & cur_prediction->prediction.pose14pt;
+
+      for (num = 0; num < NUM_POSE_POINT; num++, point_ptr++) {
+        /* points are transformed at integer precision */
+        vvas_xinfer_coords_add (coords, (gint32) point_ptr->x,
+            (gint32) point_ptr->y, hfactor, vfactor, p_bbox->x, p_bbox->y,
+            xOffset, yOffset, &point_ptr->x, &point_ptr->y, TRUE);
+      }
+    }
+
+    if (cur_prediction->prediction.feature.type == LANDMARK) {
+      for (num = 0; num < NUM_LANDMARK_POINT; num++) {
+        Pointf *point_ptr =
+            (Pointf *) & (cur_prediction->prediction.feature.landmark[num].x);
+
+        vvas_xinfer_coords_add (coords, (gint32) point_ptr->x,
+            (gint32) point_ptr->y, hfactor, vfactor, p_bbox->x, p_bbox->y,
+            xOffset, yOffset, &point_ptr->x, &point_ptr->y, TRUE);
+      }
+    }
+
+    if (cur_prediction->prediction.feature.type == ROADLINE
+        || cur_prediction->prediction.feature.type == ULTRAFAST) {
+      for (num = 0; num < cur_prediction->prediction.feature.line_size; num++) {
+        Pointf *point_ptr =
+            (Pointf *) & (cur_prediction->prediction.feature.road_line[num].x);
+
+        vvas_xinfer_coords_add (coords, (gint32) point_ptr->x,
+            (gint32) point_ptr->y, hfactor, vfactor, p_bbox->x, p_bbox->y,
+            xOffset, yOffset, &point_ptr->x, &point_ptr->y, TRUE);
+      }
+    }
+
+    cur_prediction->prediction.bbox_scaled = TRUE;
+  }
+}
+
+/**
+ * @fn static void vvas_xinfer_project_coords (GstVvas_XInfer * self, Vvas_XInferCoords * coords)
+ * @param [in] self - Handle to GstVvas_XInfer
+ * @param [inout] coords - Batch of coordinates gathered by
+ *                         vvas_xinfer_gather_child_coords
+ * @return None
+ *
+ * @brief Transform all gathered child coordinates of a batch to parent
+ *        resolution and write them back into metadata
+ * @details Projection runs over flat float/int32 arrays with SSE2 or NEON
+ *          when available, see vvas_xinfer_project(). Results are scattered
+ *          back to metadata afterwards and bounding boxes are clipped to
+ *          parent frame boundary.
+ */
+static void
+vvas_xinfer_project_coords (GstVvas_XInfer * self, Vvas_XInferCoords * coords)
+{
+  gint32 *out_x = coords->out_x;
+  gint32 *out_y = coords->out_y;
+  guint i;
+
+  if (!coords->len)
+    return;
+
+  vvas_xinfer_project (coords->x, coords->hfactor, coords->xbase,
+      coords->xoffset, out_x, coords->len);
+  vvas_xinfer_project (coords->y, coords->vfactor, coords->ybase,
+      coords->yoffset, out_y, coords->len);
+
+  for (i = 0; i < coords->len; i++) {
+    Vvas_XInferCoordDest *dest = &coords->dest[i];
+
+    if (dest->is_float) {
+      *(gfloat *) dest->x = out_x[i];
+      *(gfloat *) dest->y = out_y[i];
+    } else {
+      *(gint32 *) dest->x = out_x[i];
+      *(gint32 *) dest->y = out_y[i];
     }
   }
 
-  if (cur_prediction->prediction.model_class == VVAS_XCLASS_POSEDETECT) {
-    transform_pose14pt (self, cur_prediction,
-        parent_prediction, hfactor, vfactor, xOffset, yOffset);
+  for (i = 0; i < coords->boxes->len; i++) {
+    Vvas_XInferCoordBox *box =
+        &g_array_index (coords->boxes, Vvas_XInferCoordBox, i);
+    VvasBoundingBox *bbox = &box->prediction->prediction.bbox;
+
+    /* check if updated coordinates are extended beyong original image
+     * and clip it to make within image boudary. */
+    if (box->max_width < (bbox->width + bbox->x)) {
+      bbox->width -= (bbox->width + bbox->x - box->max_width);
+    }
+    if (box->max_height < (bbox->height + bbox->y)) {
+      bbox->height -= (bbox->height + bbox->y - box->max_height);
+    }
   }
 
-  if (cur_prediction->prediction.feature.type == LANDMARK)
-    transform_landmark (self, cur_prediction,
-        parent_prediction, hfactor, vfactor, xOffset, yOffset);
+  if (G_UNLIKELY (gst_debug_category_get_threshold (GST_CAT_DEFAULT) >=
+          GST_LEVEL_LOG)) {
+    for (i = 0; i < coords->boxes->len; i++) {
+      VvasBoundingBox *bbox = &g_array_index (coords->boxes,
+          Vvas_XInferCoordBox, i).prediction->prediction.bbox;
 
-  if (cur_prediction->prediction.feature.type == ROADLINE
-      || cur_prediction->prediction.feature.type == ULTRAFAST) {
-    transform_roadlines (self, cur_prediction,
-        parent_prediction, hfactor, vfactor, xOffset, yOffset);
+      GST_LOG_OBJECT (self, "bbox in parent : x = %d, y = %d, w = %d, h = %d",
+          bbox->x, bbox->y, bbox->width, bbox->height);
+    }
   }
 
-  cur_prediction->prediction.bbox_scaled = TRUE;
+  GST_LOG_OBJECT (self, "transformed %u coordinates of %u bboxes",
+      coords->len, coords->boxes->len);
 }
 
 /**
@@ -3094,7 +4212,14 @@ vvas_xinfer_infer_loop (gpointer data)
   vvas_ms_roi *input_roi = NULL;
   vvas_ms_roi *output_roi = NULL;
   gboolean *use_roi_data = NULL;
+  guint *src_ids = NULL;
+  GstClockTime *queued_ts = NULL;
   gboolean timeout_triggered = FALSE;
+  gboolean flush_triggered = FALSE;
+  Vvas_XInferCoords coords = { 0 };
+  GstClockTime trace_ts;
+  GstClockTime batch_start = GST_CLOCK_TIME_NONE;
+  GstClockTime infer_start, infer_elapsed;
   VvasReturnType vret;
 
   /* Mark thread is running */
@@ -3178,19 +4303,37 @@ vvas_xinfer_infer_loop (gpointer data)
     goto error;
   }
 
+  src_ids = (guint *) calloc (priv->max_infer_queue, sizeof (guint));
+  if (src_ids == NULL) {
+    GST_ERROR_OBJECT (self, "failed to allocate memory");
+    goto error;
+  }
+
+  queued_ts =
+      (GstClockTime *) calloc (priv->max_infer_queue, sizeof (GstClockTime));
+  if (queued_ts == NULL) {
+    GST_ERROR_OBJECT (self, "failed to allocate memory");
+    goto error;
+  }
+
   /* Execute till stop raised */
   while (!priv->stop) {
     Vvas_XInferFrame *inframe = NULL;
     guint idx, tmp_idx;
     guint min_batch = 0;
 
+    /* previous batch is completely processed, safe to swap the model */
+    if (g_atomic_pointer_get (&priv->pending_runner))
+      vvas_xinfer_swap_model (self);
+
     g_mutex_lock (&priv->infer_lock);
     batch_len = g_queue_get_length (priv->infer_batch_queue);
+    priv->batch_building = cur_batch_size > 0;
 
     g_cond_signal (&priv->infer_batch_full);
     if (!priv->stop && batch_len < priv->infer_batch_size &&
         priv->ppe_thread_state != VVAS_THREAD_EXITED && !priv->is_eos
-        && !priv->is_pad_eos) {
+        && !priv->is_pad_eos && !priv->flush_batch) {
       /* wait for batch size frames */
       GST_DEBUG_OBJECT (self, "wait for the next batch");
       if (self->batch_timeout) {
@@ -3209,6 +4352,10 @@ vvas_xinfer_infer_loop (gpointer data)
         g_cond_wait (&priv->infer_cond, &priv->infer_lock);
       }
     }
+    /* only frames skipped for latency budget are pending, or a source
+     * waits for free space */
+    flush_triggered = priv->flush_batch;
+    priv->flush_batch = FALSE;
     g_mutex_unlock (&priv->infer_lock);
 
     if (priv->stop)
@@ -3218,7 +4365,7 @@ vvas_xinfer_infer_loop (gpointer data)
       if ((g_queue_get_length (priv->infer_batch_queue) <
               priv->infer_batch_size)
           && priv->ppe_thread_state != VVAS_THREAD_EXITED && !priv->is_eos
-          && !priv->is_pad_eos && !timeout_triggered) {
+          && !priv->is_pad_eos && !timeout_triggered && !flush_triggered) {
         GST_ERROR_OBJECT (self,
             "unexpected behaviour!!! "
             "batch length (%d) < required batch size %d",
@@ -3252,7 +4399,7 @@ vvas_xinfer_infer_loop (gpointer data)
 
     for (idx = 0; idx < min_batch; idx++) {
       g_mutex_lock (&priv->infer_lock);
-      inframe = g_queue_pop_head (priv->infer_batch_queue);
+      inframe = vvas_xinfer_pop_frame (self);
       GST_LOG_OBJECT (self,
           "popped frame %p from batch queue with skip_processing = %d", inframe,
           inframe->skip_processing);
@@ -3291,6 +4438,8 @@ vvas_xinfer_infer_loop (gpointer data)
       input_roi[total_queued_size + idx] = inframe->input_roi;
       output_roi[total_queued_size + idx] = inframe->output_roi;
       use_roi_data[total_queued_size + idx] = inframe->use_roi_data;
+      src_ids[total_queued_size + idx] = inframe->src_id;
+      queued_ts[total_queued_size + idx] = inframe->queued_ts;
 
       g_slice_free1 (sizeof (Vvas_XInferFrame), inframe);
 
@@ -3323,7 +4472,8 @@ vvas_xinfer_infer_loop (gpointer data)
 
     if (!priv->low_latency_infer && cur_batch_size < priv->infer_batch_size &&
         !priv->is_eos && !priv->is_pad_eos
-        && total_queued_size < priv->max_infer_queue && !timeout_triggered) {
+        && total_queued_size < priv->max_infer_queue && !timeout_triggered
+        && !flush_triggered) {
       GST_DEBUG_OBJECT (self,
           "current batch %d is not enough. " "continue to fetch data",
           cur_batch_size);
@@ -3332,18 +4482,43 @@ vvas_xinfer_infer_loop (gpointer data)
 
     /* Reset for next iteration */
     timeout_triggered = FALSE;
+    flush_triggered = FALSE;
 
     GST_LOG_OBJECT (self, "sending batch of %u frames", cur_batch_size);
 
+    trace_ts = gst_vvas_trace_start ();
+
     if (cur_batch_size && priv->last_fret == GST_FLOW_OK) {
+      gst_vvas_trace_value (GST_OBJECT (self), GST_VVAS_TRACE_BATCH_FILL,
+          cur_batch_size);
+      if (self->latency_budget)
+        batch_start = gst_util_get_timestamp ();
+
+      /* runner may be shared with other instances of the same model */
+      g_mutex_lock (&priv->runner->lock);
+      infer_start = gst_util_get_timestamp ();
       vret =
           vvas_dpuinfer_process_frames (infer_handle->handle,
           infer_handle->input, predictions, cur_batch_size);
+      infer_elapsed = gst_util_get_timestamp () - infer_start;
+      g_mutex_unlock (&priv->runner->lock);
       if (vret != VVAS_RET_SUCCESS) {
         GST_ERROR_OBJECT (self, "DPU failed to process frames");
         goto error;
       }
 
+      /* DPU time one more frame or object costs, which gating elements
+       * upstream save when they skip one */
+      infer_elapsed /= cur_batch_size;
+      GST_OBJECT_LOCK (self);
+      priv->frame_infer_time =
+          GST_CLOCK_TIME_IS_VALID (priv->frame_infer_time) ?
+          (priv->frame_infer_time * 7 + infer_elapsed) / 8 : infer_elapsed;
+      GST_OBJECT_UNLOCK (self);
+      gst_vvas_trace_stop (GST_OBJECT (self), GST_VVAS_TRACE_INFER_TIME,
+          trace_ts);
+      trace_ts = gst_vvas_trace_start ();
+
       tmp_idx = 0;
       /** Convert vvasinfer predictions to gstinfer here */
       for (idx = 0; idx < total_queued_size; idx++) {
@@ -3442,7 +4617,41 @@ vvas_xinfer_infer_loop (gpointer data)
       g_signal_emit (self, vvas_signals[SIGNAL_VVAS], 0);
     }
 
+    /* collect child coordinates of whole batch and scale them to parent
+     * resolution in one pass */
+    vvas_xinfer_coords_reset (&coords);
     for (idx = 0; idx < total_queued_size; idx++) {
+      GstInferenceMeta *child_meta;
+      Vvas_XInferNodeInfo node_info = { 0 };
+
+      /* parent_buf and child_buf same, then dpu library itself will
+       * provide scaled metadata */
+      if (!child_bufs[idx] || (priv->infer_level == 1
+              && parent_bufs[idx] == child_bufs[idx]))
+        continue;
+
+      child_meta = (GstInferenceMeta *) gst_buffer_get_meta (child_bufs[idx],
+          gst_inference_meta_api_get_type ());
+      if (!child_meta)
+        continue;
+
+      node_info.self = self;
+      node_info.parent_vinfo = parent_vinfos[idx];
+      node_info.child_vinfo = child_vinfos[idx];
+      node_info.input_roi = input_roi[idx];
+      node_info.output_roi = output_roi[idx];
+      node_info.use_roi_data = use_roi_data[idx];
+
+      vvas_xinfer_gather_child_coords (&coords, &node_info,
+          (GNode *) child_meta->prediction->prediction.node);
+    }
+    vvas_xinfer_project_coords (self, &coords);
+    gst_vvas_trace_stop (GST_OBJECT (self), GST_VVAS_TRACE_POSTPROC_TIME,
+        trace_ts);
+
+    for (idx = 0; idx < total_queued_size; idx++) {
+      /* frames skipped from inference do not have vvas_frame */
+      gboolean inferred = vvas_frames[idx] != NULL;
 
       if (vvas_frames[idx]) {
         vvas_video_frame_free (vvas_frames[idx]);
@@ -3457,14 +4666,6 @@ vvas_xinfer_infer_loop (gpointer data)
              * when parent_buf != child_buf
              */
             GstInferenceMeta *child_meta;
-            Vvas_XInferNodeInfo node_info = { 0 };
-
-            node_info.self = self;
-            node_info.parent_vinfo = parent_vinfos[idx];
-            node_info.child_vinfo = child_vinfos[idx];
-            node_info.input_roi = input_roi[idx];
-            node_info.output_roi = output_roi[idx];
-            node_info.use_roi_data = use_roi_data[idx];
 
             /* child_buf received from PPE, so update metadata in parent buf */
             child_meta =
@@ -3476,11 +4677,7 @@ vvas_xinfer_infer_loop (gpointer data)
                 GstBuffer *writable_buf = NULL;
                 GstInferenceMeta *parent_meta;
 
-                /*scale child prediction to match with parent */
-                g_node_children_foreach ((GNode *) child_meta->prediction->
-                    prediction.node, G_TRAVERSE_ALL, update_child_bbox,
-                    &node_info);
-
+                /* child prediction is already scaled to match with parent */
                 if (!gst_buffer_is_writable (parent_bufs[idx])) {
                   GST_DEBUG_OBJECT (self, "create writable buffer of %p",
                       parent_bufs[idx]);
@@ -3528,14 +4725,6 @@ vvas_xinfer_infer_loop (gpointer data)
         } else {                /* inference level > 1 */
           GstInferenceMeta *child_meta = NULL;
           GstInferencePrediction *parent_prediction = NULL;
-          Vvas_XInferNodeInfo node_info = { 0 };
-
-          node_info.self = self;
-          node_info.parent_vinfo = parent_vinfos[idx];
-          node_info.child_vinfo = child_vinfos[idx];
-          node_info.input_roi = input_roi[idx];
-          node_info.output_roi = output_roi[idx];
-          node_info.use_roi_data = use_roi_data[idx];
 
           child_meta =
               (GstInferenceMeta *) gst_buffer_get_meta (child_bufs[idx],
@@ -3544,9 +4733,6 @@ vvas_xinfer_infer_loop (gpointer data)
             parent_prediction = (GstInferencePrediction *)
                 child_meta->prediction->prediction.node->parent->data;
 
-            g_node_children_foreach ((GNode *) child_meta->
-                prediction->prediction.node, G_TRAVERSE_ALL, update_child_bbox,
-                &node_info);
             gst_inference_prediction_unref (parent_prediction);
             child_meta->prediction = gst_inference_prediction_new ();
           }
@@ -3606,6 +4792,9 @@ vvas_xinfer_infer_loop (gpointer data)
 #endif
           GST_DEBUG_OBJECT (self, "pushing %" GST_PTR_FORMAT, parent_bufs[idx]);
 
+          if (inferred)
+            vvas_xinfer_account_latency (self, src_ids[idx], queued_ts[idx]);
+
           priv->last_fret = gst_pad_push (GST_BASE_TRANSFORM_SRC_PAD (self),
               parent_bufs[idx]);
           /* Pushed buffer will be disposed once we submit it to gst_pad_push either
@@ -3658,6 +4847,18 @@ vvas_xinfer_infer_loop (gpointer data)
       }
     }                           /*end of for loop */
 
+    if (GST_CLOCK_TIME_IS_VALID (batch_start)) {
+      /* time taken to infer and push one batch, used to predict how long a
+       * new frame has to wait for its inference */
+      GstClockTime elapsed = gst_util_get_timestamp () - batch_start;
+
+      g_mutex_lock (&priv->infer_lock);
+      priv->batch_time = GST_CLOCK_TIME_IS_VALID (priv->batch_time) ?
+          (priv->batch_time * 7 + elapsed) / 8 : elapsed;
+      g_mutex_unlock (&priv->infer_lock);
+      batch_start = GST_CLOCK_TIME_NONE;
+    }
+
     memset (infer_handle->input, 0x0,
         sizeof (VvasVideoFrame *) * MAX_NUM_OBJECT);
     memset (infer_handle->output, 0x0,
@@ -3749,6 +4950,11 @@ exit:
     free (output_roi);
   if (use_roi_data)
     free (use_roi_data);
+  if (src_ids)
+    free (src_ids);
+  if (queued_ts)
+    free (queued_ts);
+  vvas_xinfer_coords_free (&coords);
   priv->infer_thread_state = VVAS_THREAD_EXITED;
 
   return NULL;
@@ -3825,6 +5031,157 @@ vvas_xinfer_send_ppe_frame (GstVvas_XInfer * self, GstBuffer * parent_buf,
   return TRUE;
 }
 
+/**
+ * @fn static gboolean vvas_xinfer_check_deadline (GstVvas_XInfer * self, GstBuffer * inbuf)
+ * @param [in] self - handle to GstVvas_XInfer
+ * @param [in] inbuf - input buffer from upstream
+ *
+ * @return TRUE if inference of \p inbuf has to be skipped
+ *         FALSE otherwise
+ *
+ * @brief Decides whether inference of an input buffer has to be skipped to
+ *        meet the latency budget.
+ * @detail Age of the buffer is the difference between current running time of
+ *         the pipeline clock and running time of the buffer. The wait for its
+ *         inference is predicted from the frames already queued for inference
+ *         and the average time taken by one batch. A buffer whose age would
+ *         exceed latency-budget by then is skipped. While buffers are being
+ *         skipped, a source skipped less often than others gives up its turn
+ *         so that skips are shared fairly among GstVvasSrcIDMeta sources.
+ */
+static gboolean
+vvas_xinfer_check_deadline (GstVvas_XInfer * self, GstBuffer * inbuf)
+{
+  GstVvas_XInferPrivate *priv = self->priv;
+  GstVvasSrcIDMeta *srcid_meta;
+  Vvas_XInferSource *src;
+  GstClock *clock;
+  GstClockTime budget, now, base_time, running_time, age, wait = 0;
+  GHashTableIter iter;
+  gpointer value;
+  GList *node;
+  guint src_id = 0, pending = 0, max_deficit = 0;
+  gboolean skip;
+
+  budget = self->latency_budget * GST_MSECOND;
+  if (!budget || !GST_BUFFER_PTS_IS_VALID (inbuf))
+    return FALSE;
+
+  clock = gst_element_get_clock (GST_ELEMENT (self));
+  if (!clock)
+    return FALSE;
+  now = gst_clock_get_time (clock);
+  gst_object_unref (clock);
+
+  base_time = gst_element_get_base_time (GST_ELEMENT (self));
+  running_time =
+      gst_segment_to_running_time (&GST_BASE_TRANSFORM (self)->segment,
+      GST_FORMAT_TIME, GST_BUFFER_PTS (inbuf));
+  if (now < base_time || !GST_CLOCK_TIME_IS_VALID (running_time))
+    return FALSE;
+  now -= base_time;
+  age = now > running_time ? now - running_time : 0;
+
+  g_mutex_lock (&priv->infer_lock);
+  for (node = priv->infer_batch_queue->head; node; node = node->next) {
+    Vvas_XInferFrame *frame = (Vvas_XInferFrame *) node->data;
+    if (!frame->skip_processing)
+      pending++;
+  }
+  /* frames ahead of this one plus the batch this one goes into */
+  if (GST_CLOCK_TIME_IS_VALID (priv->batch_time))
+    wait = (pending / priv->infer_batch_size + 1) * priv->batch_time;
+  g_mutex_unlock (&priv->infer_lock);
+
+  srcid_meta = gst_buffer_get_vvas_srcid_meta (inbuf);
+  if (srcid_meta)
+    src_id = srcid_meta->src_id;
+
+  g_mutex_lock (&priv->sources_lock);
+  src = vvas_xinfer_get_source (self, src_id);
+  src->last_seen = now;
+
+  skip = age + wait > budget;
+  if (skip) {
+    priv->pressure_until = now + budget;
+  } else if (now < priv->pressure_until) {
+    /* frames are being skipped, let the source skipped most get inferred */
+    g_hash_table_iter_init (&iter, priv->sources);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+      Vvas_XInferSource *other = (Vvas_XInferSource *) value;
+      if (other->last_seen + VVAS_XINFER_SRC_ACTIVE_WINDOW >= now)
+        max_deficit = MAX (max_deficit, other->deficit);
+    }
+    skip = src->deficit < max_deficit;
+  }
+
+  if (skip) {
+    src->deficit++;
+    src->skipped++;
+    priv->deadline_skipped++;
+    GST_LOG_OBJECT (self, "skip inference of source %u frame with age %"
+        GST_TIME_FORMAT " and expected wait %" GST_TIME_FORMAT, src_id,
+        GST_TIME_ARGS (age), GST_TIME_ARGS (wait));
+  } else {
+    src->deficit = 0;
+  }
+  g_mutex_unlock (&priv->sources_lock);
+
+  return skip;
+}
+
+/**
+ * @fn static GstFlowReturn vvas_xinfer_skip_input_buffer (GstVvas_XInfer * self, GstBuffer * inbuf)
+ * @param [in] self - handle to GstVvas_XInfer
+ * @param [in] inbuf - input buffer from upstream
+ *
+ * @return GST_FLOW_OK on success
+ *         GST_FLOW_FLUSHING when stopped
+ *
+ * @brief Passes an input buffer downstream without inference.
+ * @detail Buffer is marked with GST_VVAS_BUFFER_FLAG_INFER_SKIPPED and queued
+ *         behind the frames under processing, so that output order is kept.
+ *         It is pushed right away only when no frame waits for inference,
+ *         a batch being built is never submitted early because of a skip.
+ */
+static GstFlowReturn
+vvas_xinfer_skip_input_buffer (GstVvas_XInfer * self, GstBuffer * inbuf)
+{
+  GstVvas_XInferPrivate *priv = self->priv;
+
+  inbuf = gst_buffer_make_writable (inbuf);
+  GST_BUFFER_FLAG_SET (inbuf, GST_VVAS_BUFFER_FLAG_INFER_SKIPPED);
+
+  if (priv->do_preprocess) {
+    GstVideoInfo *parent_vinfo = gst_video_info_copy (priv->in_vinfo);
+
+    /* frames ahead of this one can still be in PPE thread */
+    if (!vvas_xinfer_send_ppe_frame (self, inbuf, parent_vinfo, NULL, NULL,
+            NULL, TRUE, TRUE, NULL)) {
+      gst_video_info_free (parent_vinfo);
+      gst_buffer_unref (inbuf);
+      return GST_FLOW_FLUSHING;
+    }
+  } else {
+    Vvas_XInferFrame *infer_frame = g_slice_new0 (Vvas_XInferFrame);
+
+    infer_frame->parent_buf = inbuf;
+    infer_frame->parent_vinfo = gst_video_info_copy (priv->in_vinfo);
+    infer_frame->last_parent_buf = TRUE;
+    infer_frame->skip_processing = TRUE;
+
+    g_mutex_lock (&priv->infer_lock);
+    vvas_xinfer_queue_frame (self, infer_frame);
+    if (vvas_xinfer_only_skipped_pending (self)) {
+      priv->flush_batch = TRUE;
+      g_cond_signal (&priv->infer_cond);
+    }
+    g_mutex_unlock (&priv->infer_lock);
+  }
+
+  return GST_FLOW_OK;
+}
+
 /**
  * @fn static GstFlowReturn gst_vvas_xinfer_submit_input_buffer (GstBaseTransform * trans,
  *								 gboolean is_discont, GstBuffer * inbuf)
@@ -3855,6 +5212,10 @@ vvas_xinfer_send_ppe_frame (GstVvas_XInfer * self, GstBuffer * parent_buf,
  *           Skip inbuffer if previous infer do not detect anything
  *           Check either previous infer sub-buffer can be used and if yes add
  *           them to infer_batch_queue after mapping to infer_frame.
+ *        When latency-budget is set, buffers which would miss it are passed
+ *        downstream without inference instead of waiting for free space.
+ *        When max-source-queue is set, buffer waits till its source has less
+ *        than that many frames waiting for inference.
  *
  */
 static GstFlowReturn
@@ -3864,15 +5225,40 @@ gst_vvas_xinfer_submit_input_buffer (GstBaseTransform * trans,
   GstVvas_XInfer *self = GST_VVAS_XINFER (trans);
   GstVvas_XInferPrivate *priv = self->priv;
   gboolean bret = FALSE;
+  gboolean deadline_skip;
 
   GST_LOG_OBJECT (self, "received %" GST_PTR_FORMAT, inbuf);
 
+  deadline_skip = vvas_xinfer_check_deadline (self, inbuf);
+
   g_mutex_lock (&priv->infer_lock);
-  if (!priv->stop && g_queue_get_length (priv->infer_batch_queue) >=
+  if (!deadline_skip && !priv->stop &&
+      g_queue_get_length (priv->infer_batch_queue) >=
       (priv->infer_batch_size << 1)) {
     GST_LOG_OBJECT (self, "inference batch queue is full. Wait for free space");
     g_cond_wait (&priv->infer_batch_full, &priv->infer_lock);
   }
+
+  if (!deadline_skip && self->max_source_queue && priv->infer_level == 1) {
+    GstVvasSrcIDMeta *srcid_meta = gst_buffer_get_vvas_srcid_meta (inbuf);
+    guint src_id = srcid_meta ? srcid_meta->src_id : 0;
+    guint queued;
+
+    while (!priv->stop) {
+      g_mutex_lock (&priv->sources_lock);
+      queued = vvas_xinfer_get_source (self, src_id)->queued;
+      g_mutex_unlock (&priv->sources_lock);
+      if (queued < self->max_source_queue)
+        break;
+
+      GST_LOG_OBJECT (self, "source %u has %u frames queued. Wait for free "
+          "space", src_id, queued);
+      /* do not let the source wait for a full batch of other sources */
+      priv->flush_batch = TRUE;
+      g_cond_signal (&priv->infer_cond);
+      g_cond_wait (&priv->infer_batch_full, &priv->infer_lock);
+    }
+  }
   g_mutex_unlock (&priv->infer_lock);
 
   if (priv->stop) {
@@ -3880,6 +5266,9 @@ gst_vvas_xinfer_submit_input_buffer (GstBaseTransform * trans,
     return GST_FLOW_FLUSHING;
   }
 
+  if (deadline_skip)
+    return vvas_xinfer_skip_input_buffer (self, inbuf);
+
   if (priv->do_preprocess) {    /* send frames to PPE thread */
     GstBuffer *new_inbuf = NULL;
     VvasVideoFrame *vvas_frame = NULL;
@@ -4000,7 +5389,7 @@ gst_vvas_xinfer_submit_input_buffer (GstBaseTransform * trans,
 
       /* send input frame to inference thread */
       g_mutex_lock (&priv->infer_lock);
-      g_queue_push_tail (priv->infer_batch_queue, infer_frame);
+      vvas_xinfer_queue_frame (self, infer_frame);
       g_mutex_unlock (&priv->infer_lock);
     }
 
@@ -4057,14 +5446,21 @@ gst_vvas_xinfer_set_property (GObject * object, guint prop_id,
       self->ppe_json_file = g_value_dup_string (value);
       break;
     case PROP_INFER_CONFIG_LOCATION:
-      if (GST_STATE (self) != GST_STATE_NULL) {
+      if (GST_STATE (self) != GST_STATE_NULL && !self->priv->infer_thread) {
         g_warning
-            ("can't set inference json_file path when instance is NOT in NULL state");
+            ("can't set inference json_file path when instance is in READY state");
         return;
       }
+      GST_OBJECT_LOCK (self);
       if (self->infer_json_file)
         g_free (self->infer_json_file);
       self->infer_json_file = g_value_dup_string (value);
+      GST_OBJECT_UNLOCK (self);
+
+      if (self->priv->infer_thread && self->infer_json_file) {
+        /* streaming, load new model without stopping current one */
+        vvas_xinfer_request_model_load (self);
+      }
       break;
     case PROP_ATTACH_EMPTY_METADATA:
       self->flag_attach_empty_infer = g_value_get_boolean (value);
@@ -4072,6 +5468,19 @@ gst_vvas_xinfer_set_property (GObject * object, guint prop_id,
     case PROP_BATCH_SUBMIT_TIMEOUT:
       self->batch_timeout = g_value_get_uint (value);
       break;
+    case PROP_LATENCY_BUDGET:
+      self->latency_budget = g_value_get_uint (value);
+      break;
+    case PROP_BATCH_SCHEDULING:
+      self->batch_scheduling = g_value_get_enum (value);
+      break;
+    case PROP_SOURCE_WEIGHTS:
+      g_free (self->source_weights);
+      self->source_weights = g_value_dup_string (value);
+      break;
+    case PROP_MAX_SOURCE_QUEUE:
+      self->max_source_queue = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -4111,6 +5520,25 @@ gst_vvas_xinfer_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_BATCH_SUBMIT_TIMEOUT:
       g_value_set_uint (value, self->batch_timeout);
       break;
+    case PROP_LATENCY_BUDGET:
+      g_value_set_uint (value, self->latency_budget);
+      break;
+    case PROP_BATCH_SCHEDULING:
+      g_value_set_enum (value, self->batch_scheduling);
+      break;
+    case PROP_SOURCE_WEIGHTS:
+      g_value_set_string (value, self->source_weights);
+      break;
+    case PROP_MAX_SOURCE_QUEUE:
+      g_value_set_uint (value, self->max_source_queue);
+      break;
+    case PROP_SOURCE_STATS:
+      g_value_take_boxed (value, vvas_xinfer_sources_to_structure (self));
+      break;
+    case PROP_MEM_STATS:
+      g_value_take_boxed (value,
+          gst_vvas_mem_stats_to_structure (&self->priv->mem_stats));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -4388,6 +5816,26 @@ gst_vvas_xinfer_query (GstBaseTransform * trans,
               "batch_size", G_TYPE_UINT, self->priv->infer_batch_size, NULL);
         }
         return TRUE;
+      } else if (gst_structure_has_name (s, "vvas-inference-time")) {
+        GstClockTime frame_time;
+
+        GST_OBJECT_LOCK (self);
+        frame_time = priv->frame_infer_time;
+        GST_OBJECT_UNLOCK (self);
+
+        /* Not measured yet, an instance further downstream may know */
+        if (!GST_CLOCK_TIME_IS_VALID (frame_time))
+          break;
+
+        GST_LOG_OBJECT (self, "received vvas-inference-time query, %"
+            GST_TIME_FORMAT " per frame", GST_TIME_ARGS (frame_time));
+        query = gst_query_make_writable (query);
+        st = gst_query_writable_structure (query);
+        if (st) {
+          gst_structure_set (st, "frame-time", G_TYPE_UINT64, frame_time,
+              NULL);
+        }
+        return TRUE;
       }
       break;
     }
@@ -4421,6 +5869,7 @@ gst_vvas_xinfer_sink_event (GstBaseTransform * trans, GstEvent * event)
     case GST_EVENT_EOS:{
       GST_INFO_OBJECT (self, "received EOS event");
       priv->is_eos = TRUE;
+      gst_vvas_mem_stats_dump (&priv->mem_stats, GST_ELEMENT (self));
 
       if (priv->ppe_thread) {
         g_mutex_lock (&priv->ppe_lock);
@@ -4459,7 +5908,7 @@ gst_vvas_xinfer_sink_event (GstBaseTransform * trans, GstEvent * event)
         g_cond_signal (&self->priv->infer_cond);
         GST_INFO_OBJECT (self, "signalled infer thread to exit");
         /* send input frame to inference thread */
-        g_queue_push_tail (priv->infer_batch_queue, event_frame);
+        vvas_xinfer_queue_frame (self, event_frame);
         g_mutex_unlock (&self->priv->infer_lock);
       }
 
@@ -4511,7 +5960,7 @@ gst_vvas_xinfer_sink_event (GstBaseTransform * trans, GstEvent * event)
         /* send input frame to inference thread */
         priv->is_pad_eos = TRUE;
         g_cond_signal (&self->priv->infer_cond);
-        g_queue_push_tail (priv->infer_batch_queue, event_frame);
+        vvas_xinfer_queue_frame (self, event_frame);
         g_mutex_unlock (&self->priv->infer_lock);
         return TRUE;
       }
@@ -4718,11 +6167,19 @@ gst_vvas_xinfer_set_caps (GstBaseTransform * trans, GstCaps * incaps,
   gint32 max_width, stride_align;
   gfloat max_scale_factor;
   gint32 max_height;
+  VvasVideoFormat model_format;
+  gboolean efficientnet;
 
   GST_INFO_OBJECT (self,
       "incaps = %" GST_PTR_FORMAT " and outcaps = %" GST_PTR_FORMAT, incaps,
       outcaps);
 
+  /* dpu_conf may be replaced by a model swap */
+  g_mutex_lock (&priv->infer_lock);
+  model_format = priv->dpu_conf->model_format;
+  efficientnet = strstr (priv->dpu_conf->model_name, "efficientnet") != NULL;
+  g_mutex_unlock (&priv->infer_lock);
+
   if (!gst_video_info_from_caps (priv->in_vinfo, incaps)) {
     GST_ERROR_OBJECT (self, "Failed to parse input caps");
     return FALSE;
@@ -4730,7 +6187,7 @@ gst_vvas_xinfer_set_caps (GstBaseTransform * trans, GstCaps * incaps,
 
   priv->pref_infer_width = priv->model_conf.model_width;
   priv->pref_infer_height = priv->model_conf.model_height;
-  priv->pref_infer_format = get_gst_format (priv->dpu_conf->model_format);
+  priv->pref_infer_format = get_gst_format (model_format);
   format = gst_video_format_to_string (priv->pref_infer_format);
 
   GST_INFO_OBJECT (self,
@@ -4749,9 +6206,7 @@ gst_vvas_xinfer_set_caps (GstBaseTransform * trans, GstCaps * incaps,
 
     width = priv->pref_infer_width;
     height = priv->pref_infer_height;
-    format =
-        gst_video_format_to_string (get_gst_format (priv->
-            dpu_conf->model_format));
+    format = gst_video_format_to_string (get_gst_format (model_format));
 
     /* Changing width according to worst case scenario */
     stride_align = 8 * priv->ppc;
@@ -4783,7 +6238,7 @@ gst_vvas_xinfer_set_caps (GstBaseTransform * trans, GstCaps * incaps,
 
     if (self->ppe_json_file) {
       if (priv->param.type == VVAS_SCALER_ENVELOPE_CROPPED) {
-        if (strstr (priv->dpu_conf->model_name, "efficientnet")) {
+        if (efficientnet) {
           priv->param.smallest_side_num = 256;
         } else {
           priv->param.smallest_side_num =
@@ -4794,7 +6249,7 @@ gst_vvas_xinfer_set_caps (GstBaseTransform * trans, GstCaps * incaps,
       }
     }
 
-    switch (get_gst_format (priv->dpu_conf->model_format)) {
+    switch (get_gst_format (model_format)) {
       case GST_VIDEO_FORMAT_GRAY8:
         size = ALIGN (max_width, stride_align);
         break;
@@ -4942,6 +6397,21 @@ gst_vvas_xinfer_start (GstBaseTransform * trans)
   priv->infer_batch_queue = g_queue_new ();
   priv->infer_sub_buffers = g_queue_new ();
 
+  priv->batch_time = GST_CLOCK_TIME_NONE;
+  priv->frame_infer_time = GST_CLOCK_TIME_NONE;
+  priv->flush_batch = FALSE;
+  priv->batch_building = FALSE;
+  priv->pressure_until = 0;
+  priv->deadline_skipped = 0;
+
+  g_mutex_lock (&priv->sources_lock);
+  g_hash_table_remove_all (priv->sources);
+  vvas_xinfer_parse_source_weights (self);
+  priv->vclock = 0;
+  /* first round-robin turn goes to source 0 */
+  priv->rr_last = G_MAXUINT;
+  g_mutex_unlock (&priv->sources_lock);
+
   priv->ppe_frame = g_slice_new0 (Vvas_XInferFrame);
   /* wait on event ppe_need_input or ppe_has_input as per ppe_need_data */
   priv->ppe_need_data = TRUE;
@@ -5071,6 +6541,18 @@ gst_vvas_xinfer_stop (GstBaseTransform * trans)
     g_queue_free (priv->infer_batch_queue);
   }
 
+  if (priv->deadline_skipped) {
+    GST_INFO_OBJECT (self, "skipped inference of %" G_GUINT64_FORMAT
+        " frames to meet latency budget", priv->deadline_skipped);
+  }
+  if (gst_debug_category_get_threshold (gst_vvas_xinfer_debug) >=
+      GST_LEVEL_INFO) {
+    GstStructure *stats = vvas_xinfer_sources_to_structure (self);
+
+    GST_INFO_OBJECT (self, "source statistics %" GST_PTR_FORMAT, stats);
+    gst_structure_free (stats);
+  }
+
   /* buf inside infer_sub_buffers get freed when prediction
    * node get freed, so here just remove the queue */
   if (priv->infer_sub_buffers) {
@@ -5179,6 +6661,14 @@ gst_vvas_xinfer_finalize (GObject * obj)
     self->infer_json_file = NULL;
   }
 
+  gst_vvas_mem_stats_clear (&self->priv->mem_stats);
+
+  g_free (self->source_weights);
+  g_hash_table_destroy (self->priv->sources);
+  g_hash_table_destroy (self->priv->source_weights);
+  g_mutex_clear (&self->priv->sources_lock);
+  g_mutex_clear (&self->priv->loader_lock);
+
   G_OBJECT_CLASS (parent_class)->finalize (obj);
 }
 
@@ -5285,9 +6775,12 @@ gst_vvas_xinfer_class_init (GstVvas_XInferClass * klass)
   g_object_class_install_property (gobject_class, PROP_INFER_CONFIG_LOCATION,
       g_param_spec_string ("infer-config",
           "Inference library json file path",
-          "Location of the inference config file in json format "
-          "(Note : Changable only in NULL state)", NULL,
-          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+          "Location of the inference config file in json format. "
+          "Changing it in PAUSED/PLAYING state loads the new model in "
+          "background and switches to it at the next batch. The new model "
+          "must have the same input resolution, format and pre-processing",
+          NULL, (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_PLAYING)));
 
   g_object_class_install_property (gobject_class, PROP_ATTACH_EMPTY_METADATA,
       g_param_spec_boolean ("attach-empty-metadata",
@@ -5304,6 +6797,57 @@ gst_vvas_xinfer_class_init (GstVvas_XInferClass * klass)
           UINT_MAX, DEFAULT_BATCH_SUBMIT_TIMEOUT,
           (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
+  g_object_class_install_property (gobject_class, PROP_MEM_STATS,
+      g_param_spec_boxed ("mem-stats", "Memory transfer statistics",
+          "DMA transfers and slow copies of input frames with the reason "
+          "of each copy", GST_TYPE_STRUCTURE,
+          (GParamFlags) (G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+
+  g_object_class_install_property (gobject_class, PROP_LATENCY_BUDGET,
+      g_param_spec_uint ("latency-budget",
+          "Latency budget in milliseconds",
+          "Maximum age (in milliseconds) of a frame, against the pipeline "
+          "clock, by the time its inference completes. Frames which would "
+          "exceed it are pushed without inference and flagged with "
+          "GST_VVAS_BUFFER_FLAG_INFER_SKIPPED, sharing the skips fairly among "
+          "sources. Meant for live sources, 0 disables it", 0, UINT_MAX,
+          DEFAULT_LATENCY_BUDGET,
+          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_PLAYING)));
+
+  g_object_class_install_property (gobject_class, PROP_BATCH_SCHEDULING,
+      g_param_spec_enum ("batch-scheduling", "Batch scheduling",
+          "How frames of sources identified by GstVvasSrcIDMeta are taken "
+          "into a batch. Applies at inference level 1 only, higher levels "
+          "always fill batches in arrival order",
+          GST_TYPE_VVAS_XINFER_SCHEDULING, DEFAULT_BATCH_SCHEDULING,
+          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_PLAYING)));
+
+  g_object_class_install_property (gobject_class, PROP_SOURCE_WEIGHTS,
+      g_param_spec_string ("source-weights", "Source weights",
+          "Comma separated \"<source id>:<weight>\" pairs used by wfq "
+          "batch-scheduling, e.g. \"0:4,1:2\". Sources not listed have "
+          "weight 1", NULL,
+          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_MAX_SOURCE_QUEUE,
+      g_param_spec_uint ("max-source-queue", "Max frames of a source queued",
+          "Maximum number of frames of one source waiting for inference, "
+          "further frames of the source wait for free space. Applies at "
+          "inference level 1 only, 0 means no limit", 0, UINT_MAX,
+          DEFAULT_MAX_SOURCE_QUEUE,
+          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_PLAYING)));
+
+  g_object_class_install_property (gobject_class, PROP_SOURCE_STATS,
+      g_param_spec_boxed ("source-stats", "Per source statistics",
+          "Frames inferred and skipped, frames queued, weight and latency "
+          "from inference queue to push (in nanoseconds) of every source",
+          GST_TYPE_STRUCTURE,
+          (GParamFlags) (G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+
   gst_element_class_set_details_simple (gstelement_class,
       "VVAS Generic Filter Plugin",
       "Filter/Effect/Video",
@@ -5349,14 +6893,26 @@ gst_vvas_xinfer_init (GstVvas_XInfer * self)
   priv->do_init = TRUE;
   priv->do_preprocess = FALSE;
   priv->is_error = FALSE;
+  priv->frame_infer_time = GST_CLOCK_TIME_NONE;
   self->flag_attach_empty_infer = DEFAULT_ATTACH_EMPTY_METADATA;
   self->batch_timeout = DEFAULT_BATCH_SUBMIT_TIMEOUT;
+  self->latency_budget = DEFAULT_LATENCY_BUDGET;
+  self->batch_scheduling = DEFAULT_BATCH_SCHEDULING;
+  self->max_source_queue = DEFAULT_MAX_SOURCE_QUEUE;
+  self->source_weights = NULL;
+
+  g_mutex_init (&priv->sources_lock);
+  g_mutex_init (&priv->loader_lock);
+  priv->sources = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+      NULL, g_free);
+  priv->source_weights = g_hash_table_new (g_direct_hash, g_direct_equal);
 
   priv->last_fret = GST_FLOW_OK;
   priv->dpu_kernel_config = NULL;
 #ifdef DUMP_INFER_INPUT
   priv->fp = NULL;
 #endif
+  gst_vvas_mem_stats_init (&priv->mem_stats);
 
   gst_base_transform_set_in_place (GST_BASE_TRANSFORM (btrans), TRUE);
   gst_base_transform_set_passthrough (GST_BASE_TRANSFORM (btrans), TRUE);
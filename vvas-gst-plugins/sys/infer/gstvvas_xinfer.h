@@ -41,6 +41,12 @@ typedef struct _GstVvas_XInfer GstVvas_XInfer;
 typedef struct _GstVvas_XInferClass GstVvas_XInferClass;
 typedef struct _GstVvas_XInferPrivate GstVvas_XInferPrivate;
 
+typedef enum {
+  GST_VVAS_XINFER_SCHEDULING_FIFO,
+  GST_VVAS_XINFER_SCHEDULING_ROUND_ROBIN,
+  GST_VVAS_XINFER_SCHEDULING_WFQ,
+} GstVvasXInferScheduling;
+
 struct _GstVvas_XInfer {
   GstBaseTransform element;
   GstVvas_XInferPrivate *priv;
@@ -49,6 +55,10 @@ struct _GstVvas_XInfer {
   gchar *ppe_json_file;
   gboolean flag_attach_empty_infer;
   guint batch_timeout;
+  guint latency_budget;
+  GstVvasXInferScheduling batch_scheduling;
+  guint max_source_queue;
+  gchar *source_weights;
 };
 
 struct _GstVvas_XInferClass {
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Back-projection of child coordinates to their parent frame for the whole
+ * batch of vvas_xinfer. Each coordinate is scaled, rounded to nearest even,
+ * moved by the parent position and offset, and clamped to 0 when a negative
+ * offset moved it out of the frame. On x86 (SSE2) and aarch64 (NEON) four
+ * coordinates are projected at once with the same single precision product
+ * and rounding as the scalar code, so both paths are bit exact.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <math.h>
+#include "vvas_xinfer_project.h"
+
+#if defined(__GNUC__) && defined(__SSE2__)
+#define VVAS_XINFER_PROJECT_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#define VVAS_XINFER_PROJECT_NEON 1
+#include <arm_neon.h>
+#endif
+
+/**
+ *  @fn static inline gint32 vvas_xinfer_project_one (gfloat coord,
+ *                                                    gfloat factor,
+ *                                                    gint32 base,
+ *                                                    gint32 offset)
+ *  @param [in] coord - Coordinate in child resolution
+ *  @param [in] factor - Scale factor child -> parent
+ *  @param [in] base - Position of the parent box
+ *  @param [in] offset - Offset due to ROI and scaler alignment
+ *  @return Coordinate in parent resolution
+ */
+static inline gint32
+vvas_xinfer_project_one (gfloat coord, gfloat factor, gint32 base,
+    gint32 offset)
+{
+  gint32 t = (gint32) nearbyintf (coord * factor) + base + offset;
+
+  /* negative offset must not move coordinate out of frame */
+  return (offset < 0 && t < 0) ? 0 : t;
+}
+
+/**
+ *  @fn void vvas_xinfer_project_scalar (const gfloat * coord,
+ *                                       const gfloat * factor,
+ *                                       const gint32 * base,
+ *                                       const gint32 * offset, gint32 * out,
+ *                                       guint len)
+ *  @param [in] coord - Coordinates in child resolution
+ *  @param [in] factor - Scale factors child -> parent
+ *  @param [in] base - Positions of the parent boxes
+ *  @param [in] offset - Offsets due to ROI and scaler alignment
+ *  @param [out] out - Coordinates in parent resolution
+ *  @param [in] len - Number of coordinates
+ *  @return None
+ *  @brief  Reference of vvas_xinfer_project()
+ */
+void
+vvas_xinfer_project_scalar (const gfloat * coord, const gfloat * factor,
+    const gint32 * base, const gint32 * offset, gint32 * out, guint len)
+{
+  guint i;
+
+  for (i = 0; i < len; i++)
+    out[i] = vvas_xinfer_project_one (coord[i], factor[i], base[i], offset[i]);
+}
+
+/**
+ *  @fn void vvas_xinfer_project (const gfloat * coord, const gfloat * factor,
+ *                                const gint32 * base, const gint32 * offset,
+ *                                gint32 * out, guint len)
+ *  @param [in] coord - Coordinates in child resolution
+ *  @param [in] factor - Scale factors child -> parent
+ *  @param [in] base - Positions of the parent boxes
+ *  @param [in] offset - Offsets due to ROI and scaler alignment
+ *  @param [out] out - Coordinates in parent resolution
+ *  @param [in] len - Number of coordinates
+ *  @return None
+ *  @brief  Projects coordinates of one axis to parent resolution
+ */
+void
+vvas_xinfer_project (const gfloat * coord, const gfloat * factor,
+    const gint32 * base, const gint32 * offset, gint32 * out, guint len)
+{
+  guint i = 0;
+
+#if defined(VVAS_XINFER_PROJECT_SSE2)
+  const __m128i zero = _mm_setzero_si128 ();
+
+  for (; i + 4 <= len; i += 4) {
+    /* rounds to nearest even, the default mode nearbyintf() uses */
+    __m128i t = _mm_cvtps_epi32 (_mm_mul_ps (_mm_loadu_ps (coord + i),
+            _mm_loadu_ps (factor + i)));
+    __m128i off = _mm_loadu_si128 ((const __m128i *) (offset + i));
+    __m128i clamp;
+
+    t = _mm_add_epi32 (_mm_add_epi32 (t,
+            _mm_loadu_si128 ((const __m128i *) (base + i))), off);
+    clamp = _mm_and_si128 (_mm_cmplt_epi32 (off, zero),
+        _mm_cmplt_epi32 (t, zero));
+    _mm_storeu_si128 ((__m128i *) (out + i), _mm_andnot_si128 (clamp, t));
+  }
+#elif defined(VVAS_XINFER_PROJECT_NEON)
+  const int32x4_t zero = vdupq_n_s32 (0);
+
+  for (; i + 4 <= len; i += 4) {
+    int32x4_t t = vcvtnq_s32_f32 (vmulq_f32 (vld1q_f32 (coord + i),
+            vld1q_f32 (factor + i)));
+    int32x4_t off = vld1q_s32 (offset + i);
+    uint32x4_t clamp;
+
+    t = vaddq_s32 (vaddq_s32 (t, vld1q_s32 (base + i)), off);
+    clamp = vandq_u32 (vcltq_s32 (off, zero), vcltq_s32 (t, zero));
+    vst1q_s32 (out + i, vbicq_s32 (t, vreinterpretq_s32_u32 (clamp)));
+  }
+#endif
+
+  for (; i < len; i++)
+    out[i] = vvas_xinfer_project_one (coord[i], factor[i], base[i], offset[i]);
+}
+
+/**
+ *  @fn const gchar * vvas_xinfer_project_impl (void)
+ *  @return Name of the projection implementation
+ */
+const gchar *
+vvas_xinfer_project_impl (void)
+{
+#if defined(VVAS_XINFER_PROJECT_SSE2)
+  return "sse2";
+#elif defined(VVAS_XINFER_PROJECT_NEON)
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __VVAS_XINFER_PROJECT_H__
+#define __VVAS_XINFER_PROJECT_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+void vvas_xinfer_project (const gfloat * coord, const gfloat * factor,
+    const gint32 * base, const gint32 * offset, gint32 * out, guint len);
+void vvas_xinfer_project_scalar (const gfloat * coord, const gfloat * factor,
+    const gint32 * base, const gint32 * offset, gint32 * out, guint len);
+const gchar *vvas_xinfer_project_impl (void);
+
+G_END_DECLS
+
+#endif /* __VVAS_XINFER_PROJECT_H__ */
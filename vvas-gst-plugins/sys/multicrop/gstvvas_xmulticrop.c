@@ -310,10 +310,10 @@ struct _GstVvasXMultiCropPrivate
   vvasDeviceHandle dev_handle;
   /** Output buffer */
   GstBuffer *outbuf;
-  /** Dynamically cropped buffers */
-  GstBuffer *sub_buf[MAX_CHANNELS - 1];
-  /** dynamic crop buffer counter */
-  guint sub_buffer_counter;
+  /** Dynamically cropped buffers of the current input buffer */
+  GPtrArray *sub_bufs;
+  /** Interned roi_type of the dynamic crop metadata */
+  GQuark roi_crop_quark;
   /** Input buffer pool */
   GstBufferPool *input_pool;
   /* when user has set sub buffer(dynamically cropped buffer) output resolution,
@@ -344,8 +344,10 @@ struct _GstVvasXMultiCropPrivate
   VvasScaler *vvas_scaler;
   /** Reference of input VvasVideoFrame */
   VvasVideoFrame *input_frame;
-  /** Reference of output VvasVideoFrames */
+  /** Reference of output VvasVideoFrames of the current scaler batch */
   VvasVideoFrame *output_frames[MAX_CHANNELS];
+  /** Number of channels added in the current scaler batch */
+  guint num_batch_channels;
 };
 
 /**
@@ -1174,7 +1176,9 @@ gst_vvas_xmulticrop_init (GstVvasXMultiCrop * self)
   self->subbuffer_width = 0;
   self->subbuffer_height = 0;
   self->ppe_on_main_buffer = VVAS_XMULTICROP_PPE_ON_MAIN_BUF_DEFAULT;
-  self->priv->sub_buffer_counter = 0;
+  self->priv->sub_bufs =
+      g_ptr_array_new_with_free_func ((GDestroyNotify) gst_buffer_unref);
+  self->priv->roi_crop_quark = g_quark_from_static_string ("roi-crop-meta");
   self->priv->in_vinfo = gst_video_info_new ();
   self->priv->out_vinfo = gst_video_info_new ();
   self->priv->validate_import = TRUE;
@@ -2950,6 +2954,57 @@ error:
   return FALSE;
 }
 
+/**
+ *  @fn static void vvas_xmulticrop_free_batch_frames (GstVvasXMultiCrop * self)
+ *  @param [in] self    - GstVvasXMultiCrop object
+ *  @return None
+ *  @brief  This function frees the output VvasVideoFrames of the current scaler batch.
+ */
+static void
+vvas_xmulticrop_free_batch_frames (GstVvasXMultiCrop * self)
+{
+  GstVvasXMultiCropPrivate *priv = self->priv;
+  guint idx;
+
+  for (idx = 0; idx < priv->num_batch_channels; idx++) {
+    if (priv->output_frames[idx]) {
+      vvas_video_frame_free (priv->output_frames[idx]);
+      priv->output_frames[idx] = NULL;
+    }
+  }
+  priv->num_batch_channels = 0;
+}
+
+/**
+ *  @fn static gboolean vvas_xmulticrop_process_batch (GstVvasXMultiCrop * self)
+ *  @param [in] self    - GstVvasXMultiCrop object
+ *  @return TRUE on success\n FALSE on failure
+ *  @brief  This function processes the channels added in the current scaler batch.
+ *  @details IP can process only MAX_CHANNELS channels in one go, so when there
+ *           are more dynamic crops than that, channels are processed in multiple
+ *           batches from the same input frame.
+ */
+static gboolean
+vvas_xmulticrop_process_batch (GstVvasXMultiCrop * self)
+{
+  VvasReturnType vret;
+
+  if (!self->priv->num_batch_channels)
+    return TRUE;
+
+  GST_LOG_OBJECT (self, "processing batch of %u channels",
+      self->priv->num_batch_channels);
+
+  vret = vvas_scaler_process_frame (self->priv->vvas_scaler);
+  vvas_xmulticrop_free_batch_frames (self);
+  if (VVAS_IS_ERROR (vret)) {
+    GST_ERROR_OBJECT (self, "Failed to process frame in scaler");
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  *  @fn static gboolean vvas_xmulticrop_process (GstVvasXMultiCrop * self)
  *  @param [in] self    - GstVvasXMultiCrop object
@@ -2962,17 +3017,14 @@ vvas_xmulticrop_process (GstVvasXMultiCrop * self)
   GstVvasXMultiCropPrivate *priv = self->priv;
   uint32_t chan_id = 0;
   GstMemory *mem = NULL;
-  VvasReturnType vret;
 
-  /* We will be always processing number of dynamic crop buffers + input buffer
-   * And at max it will be 40 */
-  guint buffer_count = self->priv->sub_buffer_counter + 1;      //+1 for main buffer
+  /* We will be always processing number of dynamic crop buffers + input buffer */
+  guint buffer_count = priv->sub_bufs->len + 1;      //+1 for main buffer
 
-  vret = vvas_scaler_process_frame (self->priv->vvas_scaler);
-  if (VVAS_IS_ERROR (vret)) {
-    GST_ERROR_OBJECT (self, "Failed to process frame in scaler");
+  /* Process the last batch, earlier ones are already processed */
+  if (!vvas_xmulticrop_process_batch (self))
     return FALSE;
-  }
+
   for (chan_id = 0; chan_id < buffer_count; chan_id++) {
     if (0 == chan_id) {
       mem = gst_buffer_get_memory (priv->outbuf, 0);
@@ -2983,7 +3035,8 @@ vvas_xmulticrop_process (GstVvasXMultiCrop * self)
         gst_vvas_memory_set_sync_flag (mem, VVAS_SYNC_TO_DEVICE);
       }
     } else {
-      mem = gst_buffer_get_memory (priv->sub_buf[chan_id - 1], 0);
+      mem = gst_buffer_get_memory (g_ptr_array_index (priv->sub_bufs,
+              chan_id - 1), 0);
     }
     if (mem == NULL) {
       GST_ERROR_OBJECT (self,
@@ -3187,20 +3240,21 @@ gst_vvas_xmulticrop_fill_video_meta (GstBaseTransform * trans,
 
 /**
  *  @fn static GstBuffer * gst_xmulticrop_prepare_subbuffer (GstBaseTransform * trans,
- *                                                           GstVideoRegionOfInterestMeta * roi_meta)
+ *                                                           GstVideoRegionOfInterestMeta * roi_meta,
+ *                                                           GstBuffer * sub_buffer)
  *  @param [in] trans       - GstVvasXMultiCrop object typecasted to GstBaseTransform
  *  @param [in] roi_meta    - dynamic crop meta (GstVideoRegionOfInterestMeta meta)
+ *  @param [in] sub_buffer  - Buffer already acquired from the sub buffer pool, NULL to acquire one
  *  @return Allocated SubBuffer or NULL on failure
  *  @brief  This function gets sub buffer from buffer pool and fills the required metadata
  */
 static GstBuffer *
 gst_xmulticrop_prepare_subbuffer (GstBaseTransform * trans,
-    GstVideoRegionOfInterestMeta * roi_meta)
+    GstVideoRegionOfInterestMeta * roi_meta, GstBuffer * sub_buffer)
 {
   GstVvasXMultiCrop *self = GST_VVAS_XMULTICROP (trans);
   GstVvasXMultiCropPrivate *priv = self->priv;
   GstBufferPool *subbuffer_pool = NULL;
-  GstBuffer *sub_buffer = NULL;
   GstVideoMeta *vmeta = NULL;
   GstFlowReturn fret;
   gboolean add_meta = FALSE;
@@ -3225,11 +3279,13 @@ gst_xmulticrop_prepare_subbuffer (GstBaseTransform * trans,
   }
 
   /* Acquire the sub buffer from the selected buffer pool */
-  fret = gst_buffer_pool_acquire_buffer (subbuffer_pool, &sub_buffer, NULL);
-  if (fret != GST_FLOW_OK) {
-    GST_ERROR_OBJECT (self, "failed to allocate buffer from pool %p",
-        subbuffer_pool);
-    goto error;
+  if (!sub_buffer) {
+    fret = gst_buffer_pool_acquire_buffer (subbuffer_pool, &sub_buffer, NULL);
+    if (fret != GST_FLOW_OK) {
+      GST_ERROR_OBJECT (self, "failed to allocate buffer from pool %p",
+          subbuffer_pool);
+      goto error;
+    }
   }
 
   GST_DEBUG_OBJECT (self, "Got sub buffer %p from pool %p with size: %ld",
@@ -3267,8 +3323,7 @@ gst_xmulticrop_prepare_subbuffer (GstBaseTransform * trans,
 
   /* store this sub_buffer into our context and keep track of number of
    * such buffers allocated */
-  priv->sub_buf[priv->sub_buffer_counter] = sub_buffer;
-  priv->sub_buffer_counter++;
+  g_ptr_array_add (priv->sub_bufs, sub_buffer);
   return sub_buffer;
 
 error:
@@ -3348,7 +3403,7 @@ vvas_xmulticrop_add_scaler_output_buffer_chnnels (GstVvasXMultiCrop * self)
 
   GST_DEBUG_OBJECT (self, "Added processing channel for idx: 0");
 
-  priv->output_frames[0] = output_frame;
+  priv->output_frames[priv->num_batch_channels++] = output_frame;
   return TRUE;
 }
 
@@ -3406,6 +3461,12 @@ vvas_xmulticrop_add_scaler_processing_chnnels (GstVvasXMultiCrop * self,
   }
   gst_caps_unref (caps);
 
+  /* IP can't take more channels, process the ones added so far and
+   * continue with a new batch */
+  if (priv->num_batch_channels == MAX_CHANNELS &&
+      !vvas_xmulticrop_process_batch (self))
+    return FALSE;
+
   /* Convert GstBuffer to VvasVideoFrame which is needed by VVAS Core Scaler */
   output_frame = vvas_videoframe_from_gstbuffer (self->priv->vvas_ctx,
       self->out_mem_bank, sub_buffer, &vinfo, GST_MAP_READ);
@@ -3415,9 +3476,7 @@ vvas_xmulticrop_add_scaler_processing_chnnels (GstVvasXMultiCrop * self,
     return FALSE;
   }
 
-  /* 0th index for main buffer processing */
-  idx++;
-  priv->output_frames[idx] = output_frame;
+  priv->output_frames[priv->num_batch_channels++] = output_frame;
 
   /* Prepare Source and Destination rects */
   src_rect.x = roi_meta->x;
@@ -3447,7 +3506,7 @@ vvas_xmulticrop_add_scaler_processing_chnnels (GstVvasXMultiCrop * self,
     GST_ERROR_OBJECT (self, "failed to add processing channel in scaler");
     return FALSE;
   }
-  GST_DEBUG_OBJECT (self, "Added processing channel for idx: %u", idx);
+  GST_DEBUG_OBJECT (self, "Added processing channel for roi: %u", idx);
 
   return TRUE;
 }
@@ -3460,6 +3519,8 @@ vvas_xmulticrop_add_scaler_processing_chnnels (GstVvasXMultiCrop * self,
  *  @brief  This function validates all the dynamic crop metadata (GstVideoRegionOfInterestMeta)
  *          and prepares the output buffers for storing them, attaches them into the
  *          same dynamic crop meta and prepares the descriptor for processing them using IP.
+ *  @details When all sub buffers have the same size, they come from one pool and are
+ *           acquired together once the valid crops are known.
  */
 static gboolean
 vvas_xmulticrop_prepare_crop_buffers (GstBaseTransform * trans,
@@ -3467,14 +3528,17 @@ vvas_xmulticrop_prepare_crop_buffers (GstBaseTransform * trans,
 {
   GstVvasXMultiCrop *self = GST_VVAS_XMULTICROP (trans);
   GstBuffer *sub_buffer = NULL;
+  GstBuffer **sub_buffers = NULL;
+  GPtrArray *crops;
   GstStructure *s;
-  guint roi_meta_counter = 0;
+  guint roi_meta_counter = 0, idx;
   gboolean ret = TRUE;
-  VvasReturnType vret;
 
   gpointer state = NULL;
   GstMeta *_meta;
 
+  crops = g_ptr_array_new ();
+
   /* Iterate all GstVideoRegionOfInterestMeta */
   while ((_meta = gst_buffer_iterate_meta_filtered (inbuf, &state,
               GST_VIDEO_REGION_OF_INTEREST_META_API_TYPE))) {
@@ -3482,25 +3546,16 @@ vvas_xmulticrop_prepare_crop_buffers (GstBaseTransform * trans,
     GstVideoRegionOfInterestMeta *roi_meta;
     VvasCropParams subcrop_params = { 0 };
 
-    /* we can process only limited number of dynamic crops, if use has given
-     * more number of dynamic crops, we can't handle them
-     */
-    if (roi_meta_counter >= (MAX_CHANNELS - 1)) {
-      GST_DEBUG_OBJECT (self, "we can process only %d crop meta",
-          (MAX_CHANNELS - 1));
-      break;
-    }
-
     roi_meta = (GstVideoRegionOfInterestMeta *) _meta;
 
-    if (g_strcmp0 ("roi-crop-meta", g_quark_to_string (roi_meta->roi_type))) {
+    if (roi_meta->roi_type != self->priv->roi_crop_quark) {
       /* This is not the metadata we are looking for */
       continue;
     }
     /* Got the ROI crop metadata, prepare output buffer */
     GST_DEBUG_OBJECT (self, "Got roi-crop-meta[%u], parent_id:%d, id:%d, "
         "x:%u, y:%u, w:%u, h:%u",
-        roi_meta_counter, roi_meta->parent_id, roi_meta->id, roi_meta->x,
+        crops->len, roi_meta->parent_id, roi_meta->id, roi_meta->x,
         roi_meta->y, roi_meta->w, roi_meta->h);
 
     subcrop_params.x = roi_meta->x;
@@ -3530,8 +3585,28 @@ vvas_xmulticrop_prepare_crop_buffers (GstBaseTransform * trans,
     roi_meta->w = subcrop_params.width;
     roi_meta->h = subcrop_params.height;
 
+    g_ptr_array_add (crops, roi_meta);
+  }
+
+  if (crops->len && self->subbuffer_width && self->subbuffer_height) {
+    sub_buffers = g_new0 (GstBuffer *, crops->len);
+    if (gst_vvas_buffer_pool_acquire_buffers (self->priv->subbuffer_pools[0],
+            sub_buffers, crops->len, NULL) != GST_FLOW_OK) {
+      GST_ERROR_OBJECT (self, "failed to allocate %u sub buffers",
+          crops->len);
+      ret = FALSE;
+      goto exit;
+    }
+  }
+
+  for (idx = 0; idx < crops->len; idx++) {
+    GstVideoRegionOfInterestMeta *roi_meta = g_ptr_array_index (crops, idx);
+
     /* Prepare sub buffers to store dynamically cropped buffers */
-    sub_buffer = gst_xmulticrop_prepare_subbuffer (trans, roi_meta);
+    sub_buffer = gst_xmulticrop_prepare_subbuffer (trans, roi_meta,
+        sub_buffers ? sub_buffers[idx] : NULL);
+    if (sub_buffers)
+      sub_buffers[idx] = NULL;
     if (!sub_buffer) {
       GST_ERROR_OBJECT (self, "couldn't get sub buffer");
       ret = FALSE;
@@ -3546,21 +3621,31 @@ vvas_xmulticrop_prepare_crop_buffers (GstBaseTransform * trans,
     }
 
     /* GstStructure will take the ownership of buffer, hence sub_buffer must
-     * be unrefd, As sub_buffer/priv->sub_buf[x] is needed, once it is used,
+     * be unrefd, As sub_buffer/priv->sub_bufs is needed, once it is used,
      * unref it
      */
     gst_video_region_of_interest_meta_add_param (roi_meta, s);
 
     /* Add Processing channels to the Core Scaler */
-    vret =
-        vvas_xmulticrop_add_scaler_processing_chnnels (self, sub_buffer,
-        roi_meta, roi_meta_counter);
-    if (VVAS_IS_ERROR (vret)) {
+    if (!vvas_xmulticrop_add_scaler_processing_chnnels (self, sub_buffer,
+            roi_meta, roi_meta_counter)) {
       GST_ERROR_OBJECT (self, "Failed to process frame in scaler");
-      return FALSE;
+      ret = FALSE;
+      break;
     }
     roi_meta_counter++;
   }
+
+exit:
+  if (sub_buffers) {
+    /* buffers not handed out because of an error go back to the pool */
+    for (idx = 0; idx < crops->len; idx++) {
+      if (sub_buffers[idx])
+        gst_buffer_unref (sub_buffers[idx]);
+    }
+    g_free (sub_buffers);
+  }
+  g_ptr_array_free (crops, TRUE);
   return ret;
 }
 
@@ -3573,7 +3658,8 @@ vvas_xmulticrop_prepare_crop_buffers (GstBaseTransform * trans,
  *          having their roi_type field set to roi-crop-meta.
  */
 static inline guint
-gst_vvas_xmultirop_get_roi_meta_count (GstBuffer * buffer)
+gst_vvas_xmultirop_get_roi_meta_count (GstVvasXMultiCrop * self,
+    GstBuffer * buffer)
 {
   gpointer state = NULL;
   GstMeta *_meta;
@@ -3587,7 +3673,7 @@ gst_vvas_xmultirop_get_roi_meta_count (GstBuffer * buffer)
               GST_VIDEO_REGION_OF_INTEREST_META_API_TYPE))) {
     GstVideoRegionOfInterestMeta *roi_meta;
     roi_meta = (GstVideoRegionOfInterestMeta *) _meta;
-    if (!g_strcmp0 ("roi-crop-meta", g_quark_to_string (roi_meta->roi_type))) {
+    if (roi_meta->roi_type == self->priv->roi_crop_quark) {
       crop_roi_meta_count++;
     }
   }
@@ -3612,7 +3698,7 @@ gst_vvas_xmulticrop_generate_output (GstBaseTransform * trans,
   GstBuffer *cur_outbuf = NULL;
   GstMeta *in_meta;
   GstFlowReturn fret = GST_FLOW_OK;
-  guint roi_meta_count, idx;
+  guint roi_meta_count;
   gboolean bret;
 
   *outbuf = NULL;
@@ -3678,7 +3764,7 @@ gst_vvas_xmulticrop_generate_output (GstBaseTransform * trans,
 
   if (roi_meta_count) {
     /* Get total count of roi-crop-meta metadata for dynamic crop */
-    roi_meta_count = gst_vvas_xmultirop_get_roi_meta_count (inbuf);
+    roi_meta_count = gst_vvas_xmultirop_get_roi_meta_count (self, inbuf);
     GST_DEBUG_OBJECT (self, "input buffer has %u roi_meta", roi_meta_count);
     bret = vvas_xmulticrop_prepare_crop_buffers (trans, inbuf);
     if (!bret) {
@@ -3696,12 +3782,7 @@ gst_vvas_xmulticrop_generate_output (GstBaseTransform * trans,
 
   /* Free all the VvasVideoFrames, as only GstBuffer is going to be pushed
    * downstream */
-  for (idx = 0; idx < priv->sub_buffer_counter + 1; idx++) {
-    if (self->priv->output_frames[idx]) {
-      vvas_video_frame_free (self->priv->output_frames[idx]);
-      self->priv->output_frames[idx] = NULL;
-    }
-  }
+  vvas_xmulticrop_free_batch_frames (self);
   if (self->priv->input_frame) {
     vvas_video_frame_free (self->priv->input_frame);
     self->priv->input_frame = NULL;
@@ -3774,17 +3855,17 @@ gst_vvas_xmulticrop_generate_output (GstBaseTransform * trans,
 
 error:
   gst_buffer_unref (inbuf);
+  /* channels not processed due to error are dropped along with their frames */
+  vvas_xmulticrop_free_batch_frames (self);
+  if (priv->input_frame) {
+    vvas_video_frame_free (priv->input_frame);
+    priv->input_frame = NULL;
+  }
   /* sub_buffer's were attached into the ROI metadata's structure, hence
    * structure has taken the reference to these buffers, we can safely
    * unref them to avoid any memory leak.
    */
-  for (idx = 0; idx < priv->sub_buffer_counter; idx++) {
-    if (priv->sub_buf[idx]) {
-      gst_buffer_unref (priv->sub_buf[idx]);
-      priv->sub_buf[idx] = NULL;
-    }
-  }
-  priv->sub_buffer_counter = 0;
+  g_ptr_array_set_size (priv->sub_bufs, 0);
   return fret;
 }
 
@@ -4083,6 +4164,8 @@ gst_vvas_xmulticrop_finalize (GObject * object)
     gst_video_info_free (self->priv->out_vinfo);
   }
 
+  g_ptr_array_free (self->priv->sub_bufs, TRUE);
+
   /* Destroy Core Scaler and VVAS Context */
   if (self->priv->vvas_scaler) {
     vvas_scaler_destroy (self->priv->vvas_scaler);
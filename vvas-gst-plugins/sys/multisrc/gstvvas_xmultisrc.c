@@ -51,6 +51,7 @@
 #include <gst/allocators/gstdmabuf.h>
 #include <gst/video/video.h>
 #include <gst/vvas/gstvvasbufferpool.h>
+#include <gst/vvas/gstvvastrace.h>
 #include <sys/mman.h>
 #include <dlfcn.h>
 #include <jansson.h>
@@ -1143,6 +1144,7 @@ vvas_xmultisrc_process (GstVvasXMSRC * self)
 {
   size_t start = 0x1;
   int ret;
+  GstClockTime trace_ts;
   json_t *value, *kernel;
 
   /* Update the kernel parameters if changed dynamically through
@@ -1188,6 +1190,7 @@ vvas_xmultisrc_process (GstVvasXMSRC * self)
   }
 
   /* Start kernel for processing of current buffer */
+  trace_ts = gst_vvas_trace_start ();
   ret =
       self->priv->kernel.kernel_start_func (self->priv->kernel.vvas_handle,
       start, &(self->priv->input), self->priv->output);
@@ -1204,6 +1207,8 @@ vvas_xmultisrc_process (GstVvasXMSRC * self)
     GST_ERROR_OBJECT (self, "kernel done failed");
     goto error;
   }
+  gst_vvas_trace_stop (GST_OBJECT (self), GST_VVAS_TRACE_KERNEL_TIME,
+      trace_ts);
   return TRUE;
 
 error:
@@ -134,6 +134,41 @@ typedef struct _xlnx_output_buf
   GstBuffer *gstbuf;
 } XlnxOutputBuffer;
 
+/** @struct _xlnx_frame_cache_set
+ *  @brief  Video frame wrappers created by one decoder instance.
+ *  @details Referenced by the decoder and by every wrapper still attached to
+ *           a buffer, as buffers may outlive the decoder when downstream
+ *           holds them. Wrappers leave the set when their buffer is freed, so
+ *           it never holds more entries than the pool has buffers.
+ */
+typedef struct _xlnx_frame_cache_set
+{
+  /** Reference count */
+  gint refcount;
+  /** Lock protecting entries and XlnxFrameCache::vframe of its entries */
+  GMutex lock;
+  /** Wrappers whose video frame is valid, not owned */
+  GPtrArray *entries;
+} XlnxFrameCacheSet;
+
+/** @struct _xlnx_frame_cache
+ *  @brief  VvasVideoFrame wrapper cached on a pooled output buffer.
+ *  @details Wrapper is created once and attached to the buffer as qdata, so
+ *           it is reused every time the buffer comes back from the pool. It is
+ *           owned by the buffer, decoder invalidates its video frame before
+ *           VVAS context is destroyed or the output resolution changes.
+ */
+typedef struct _xlnx_frame_cache
+{
+  /** Set of the decoder instance which created the wrapper */
+  XlnxFrameCacheSet *set;
+  /** Video frame wrapping the buffer, NULL once invalidated */
+  VvasVideoFrame *vframe;
+} XlnxFrameCache;
+
+/** @brief Quark to attach XlnxFrameCache on output buffers */
+static GQuark xlnx_frame_cache_quark;
+
 /** @struct _GstVvas_XVideoDecPrivate
  *  @brief  Decoder private data.
  */
@@ -180,8 +215,17 @@ struct _GstVvas_XVideoDecPrivate
   VvasContext *vvas_ctx;
   VvasDecoder *vvas_dec;
   GHashTable *vf_to_gstbuf_map;
-  GList *free_vframe_list;
+  /** Free video frames to be handed over to decoder */
+  GQueue free_vframe_queue;
+  /** Video frame wrappers cached on output buffers */
+  XlnxFrameCacheSet *frame_cache;
   VvasCodecType dec_type;
+  /** Output width reported by the decoder configuration */
+  guint out_width;
+  /** Output height reported by the decoder configuration */
+  guint out_height;
+  /** Flag to renegotiate output caps after in-place reconfiguration */
+  gboolean renegotiate;
 };
 #define gstvvas_xvideodec_parent_class parent_class
 
@@ -192,6 +236,8 @@ G_DEFINE_TYPE_WITH_PRIVATE (GstVvas_XVideoDec, gstvvas_xvideodec,
 GST_DEBUG_CATEGORY_STATIC (GST_CAT_PERFORMANCE);
 
 static gboolean vvas_xvideodec_destroy_context (GstVvas_XVideoDec * dec);
+static GstFlowReturn gstvvas_xvideodec_finish (GstVideoDecoder * decoder);
+static void vvas_xvideodec_release_output_frames (GstVvas_XVideoDec * dec);
 
 /**
  * @brief Contains properties related to Decoder plugin
@@ -524,6 +570,203 @@ vvas_xvideodec_get_push_command_retry_timeout (guint width, guint height,
   return max_timeout_ms / (max_pixel_rate / pixel_rate);
 }
 
+/** @fn XlnxFrameCacheSet *xlnx_frame_cache_set_new (void)
+ *
+ *  @return New empty set, with one reference for the decoder
+ */
+static XlnxFrameCacheSet *
+xlnx_frame_cache_set_new (void)
+{
+  XlnxFrameCacheSet *set = g_new0 (XlnxFrameCacheSet, 1);
+
+  set->refcount = 1;
+  g_mutex_init (&set->lock);
+  set->entries = g_ptr_array_new ();
+
+  return set;
+}
+
+/** @fn void xlnx_frame_cache_set_unref (XlnxFrameCacheSet * set)
+ *
+ *  @param [in] set - Set to be unreferenced
+ *
+ *  @return void
+ */
+static void
+xlnx_frame_cache_set_unref (XlnxFrameCacheSet * set)
+{
+  if (!g_atomic_int_dec_and_test (&set->refcount))
+    return;
+
+  g_ptr_array_unref (set->entries);
+  g_mutex_clear (&set->lock);
+  g_free (set);
+}
+
+/** @fn void xlnx_frame_cache_set_invalidate (XlnxFrameCacheSet * set)
+ *
+ *  @param [in] set - Set whose video frames are freed
+ *
+ *  @return void
+ *
+ *  @brief  Frees the video frames of all the wrappers of a decoder
+ *  @details Wrappers stay attached to their buffers and get a new video frame
+ *           when the buffer is handed to the decoder again.
+ */
+static void
+xlnx_frame_cache_set_invalidate (XlnxFrameCacheSet * set)
+{
+  guint i;
+
+  g_mutex_lock (&set->lock);
+  for (i = 0; i < set->entries->len; i++) {
+    XlnxFrameCache *cache = g_ptr_array_index (set->entries, i);
+
+    vvas_video_frame_free (cache->vframe);
+    cache->vframe = NULL;
+  }
+  g_ptr_array_set_size (set->entries, 0);
+  g_mutex_unlock (&set->lock);
+}
+
+/** @fn void xlnx_frame_cache_release (gpointer data)
+ *
+ *  @param [in] data - XlnxFrameCache to be released
+ *
+ *  @return void
+ *
+ *  @brief  Frees the wrapper of a buffer which is being freed
+ */
+static void
+xlnx_frame_cache_release (gpointer data)
+{
+  XlnxFrameCache *cache = (XlnxFrameCache *) data;
+  XlnxFrameCacheSet *set = cache->set;
+
+  g_mutex_lock (&set->lock);
+  if (cache->vframe) {
+    vvas_video_frame_free (cache->vframe);
+    g_ptr_array_remove_fast (set->entries, cache);
+  }
+  g_mutex_unlock (&set->lock);
+
+  xlnx_frame_cache_set_unref (set);
+  g_free (cache);
+}
+
+/** @fn VvasVideoFrame *vvas_xvideodec_get_vframe (GstVvas_XVideoDec * dec,
+ *                                               GstBuffer * outbuf,
+ *                                               GstVideoInfo * vinfo)
+ *
+ *  @param [in] dec - Decoder context
+ *  @param [in] outbuf - Output buffer acquired from the pool
+ *  @param [in] vinfo - Output video info
+ *
+ *  @return On Success returns VvasVideoFrame wrapping @outbuf
+ *          On Failure returns NULL
+ *
+ *  @brief  Gets the video frame cached on @outbuf, creates one if not present
+ */
+static VvasVideoFrame *
+vvas_xvideodec_get_vframe (GstVvas_XVideoDec * dec, GstBuffer * outbuf,
+    GstVideoInfo * vinfo)
+{
+  GstVvas_XVideoDecPrivate *priv = dec->priv;
+  XlnxFrameCacheSet *set = priv->frame_cache;
+  XlnxFrameCache *cache;
+  VvasVideoFrame *vframe;
+  guint num_cached;
+
+  cache = gst_mini_object_get_qdata (GST_MINI_OBJECT_CAST (outbuf),
+      xlnx_frame_cache_quark);
+  /* buffers of a previous decoder instance get a wrapper of this one */
+  if (cache && cache->set != set)
+    cache = NULL;
+
+  g_mutex_lock (&set->lock);
+  vframe = cache ? cache->vframe : NULL;
+  g_mutex_unlock (&set->lock);
+  if (vframe)
+    return vframe;
+
+  vframe = vvas_videoframe_from_gstbuffer (priv->vvas_ctx,
+      dec->out_mem_bank, outbuf, vinfo, GST_MAP_READ);
+  if (!vframe)
+    return NULL;
+
+  if (!cache) {
+    cache = g_new0 (XlnxFrameCache, 1);
+    cache->set = set;
+    g_atomic_int_inc (&set->refcount);
+    gst_mini_object_set_qdata (GST_MINI_OBJECT_CAST (outbuf),
+        xlnx_frame_cache_quark, cache, xlnx_frame_cache_release);
+  }
+
+  g_mutex_lock (&set->lock);
+  cache->vframe = vframe;
+  g_ptr_array_add (set->entries, cache);
+  num_cached = set->entries->len;
+  g_mutex_unlock (&set->lock);
+
+  GST_DEBUG_OBJECT (dec, "cached vframe %p on buffer %p, %u cached", vframe,
+      outbuf, num_cached);
+
+  return vframe;
+}
+
+/** @fn void vvas_xvideodec_update_video_meta (GstVvas_XVideoDec * dec,
+ *                                             GstBuffer * outbuf,
+ *                                             GstVideoInfo * vinfo)
+ *
+ *  @param [in] dec - Decoder context
+ *  @param [in] outbuf - Output buffer acquired from the pool
+ *  @param [in] vinfo - Negotiated output video info
+ *
+ *  @return void
+ *
+ *  @brief  Updates GstVideoMeta of a pooled buffer to current resolution
+ *
+ *  @details When the pool is kept across an in-place resolution change, its
+ *           buffers still carry the video meta of the previous resolution.
+ *           Rewrite plane layout and alignment as per new resolution so that
+ *           decoder and downstream see correct strides and offsets.
+ */
+static void
+vvas_xvideodec_update_video_meta (GstVvas_XVideoDec * dec, GstBuffer * outbuf,
+    GstVideoInfo * vinfo)
+{
+  GstVideoMeta *vmeta;
+  GstVideoInfo align_info;
+  GstVideoAlignment align;
+  guint i;
+
+  vmeta = gst_buffer_get_video_meta (outbuf);
+  if (!vmeta || (vmeta->width == GST_VIDEO_INFO_WIDTH (vinfo) &&
+          vmeta->height == GST_VIDEO_INFO_HEIGHT (vinfo) &&
+          vmeta->format == GST_VIDEO_INFO_FORMAT (vinfo)))
+    return;
+
+  align_info = *vinfo;
+  set_align_param (dec, &align_info, &align);
+  if (!gst_video_info_align (&align_info, &align)) {
+    GST_WARNING_OBJECT (dec, "failed to align video info of buffer %p", outbuf);
+    return;
+  }
+
+  vmeta->format = GST_VIDEO_INFO_FORMAT (&align_info);
+  vmeta->width = GST_VIDEO_INFO_WIDTH (&align_info);
+  vmeta->height = GST_VIDEO_INFO_HEIGHT (&align_info);
+  vmeta->n_planes = GST_VIDEO_INFO_N_PLANES (&align_info);
+  for (i = 0; i < vmeta->n_planes; i++) {
+    vmeta->offset[i] = GST_VIDEO_INFO_PLANE_OFFSET (&align_info, i);
+    vmeta->stride[i] = GST_VIDEO_INFO_PLANE_STRIDE (&align_info, i);
+  }
+  gst_video_meta_set_alignment (vmeta, align);
+
+  GST_LOG_OBJECT (dec, "updated video meta of %p to %ux%u", outbuf,
+      vmeta->width, vmeta->height);
+}
+
 /** @fn gboolean vvas_video_dec_outbuffer_alloc_and_map (GstVvas_XVideoDec * dec,
  *                                                     GstVideoInfo *vinfo)
  *
@@ -570,12 +813,14 @@ vvas_video_dec_outbuffer_alloc_and_map (GstVvas_XVideoDec * dec,
       goto error;
     }
 
-    /* create a video-frame from the gstbuf as video-frame is expected by
+    vvas_xvideodec_update_video_meta (dec, outbuf, vinfo);
+
+    /* get the video-frame wrapping the gstbuf as video-frame is expected by
        the decoder library */
-    output_frame = vvas_videoframe_from_gstbuffer (priv->vvas_ctx,
-        dec->out_mem_bank, outbuf, vinfo, GST_MAP_READ);
+    output_frame = vvas_xvideodec_get_vframe (dec, outbuf, vinfo);
     if (!output_frame) {
       GST_ERROR_OBJECT (dec, "Could convert input GstBuffer to VvasVideoFrame");
+      gst_buffer_unref (outbuf);
       goto error;
     }
 
@@ -588,8 +833,7 @@ vvas_video_dec_outbuffer_alloc_and_map (GstVvas_XVideoDec * dec,
        would be used to setup the decoder library at very first invocation of
        vvas_decoder_submit_frames */
     g_mutex_lock (&priv->obuf_lock);
-    priv->free_vframe_list
-        = g_list_append (priv->free_vframe_list, output_frame);
+    g_queue_push_tail (&priv->free_vframe_queue, output_frame);
     g_mutex_unlock (&priv->obuf_lock);
 
     GST_DEBUG_OBJECT (dec,
@@ -620,6 +864,9 @@ vvas_xvideodec_reset (GstVvas_XVideoDec * dec)
   priv->need_copy = TRUE;
   priv->last_pts = GST_CLOCK_TIME_NONE;
   priv->genpts = 0;
+  priv->out_width = 0;
+  priv->out_height = 0;
+  priv->renegotiate = FALSE;
 #ifdef ENABLE_XRM_SUPPORT
   priv->xrm_ctx = NULL;
   priv->cu_list_res = NULL;
@@ -684,6 +931,71 @@ vvas_xvideodec_set_pts (GstVvas_XVideoDec * dec, GstVideoCodecFrame * frame,
   return;
 }
 
+/** @fn GstFlowReturn vvas_xvideodec_negotiate (GstVvas_XVideoDec * dec)
+ *
+ *  @param [in] dec - Decoder context
+ *
+ *  @return On Success returns GST_FLOW_OK
+ *          On Failure returns GST_FLOW_NOT_NEGOTIATED
+ *
+ *  @brief Sets the output state and negotiates caps with downstream
+ *  @details Output resolution is taken from the decoder configuration when
+ *           available, else from the input caps. This is invoked for the very
+ *           first frame and again after an in-place resolution change.
+ */
+static GstFlowReturn
+vvas_xvideodec_negotiate (GstVvas_XVideoDec * dec)
+{
+  GstVvas_XVideoDecPrivate *priv = dec->priv;
+  GstVideoCodecState *out_state = NULL;
+  GstCaps *outcaps = NULL;
+  GstVideoFormat format;
+  guint width, height;
+
+  width = priv->out_width ? priv->out_width :
+      GST_VIDEO_INFO_WIDTH (&dec->input_state->info);
+  height = priv->out_height ? priv->out_height :
+      GST_VIDEO_INFO_HEIGHT (&dec->input_state->info);
+  format = dec->bit_depth == 10 ? GST_VIDEO_FORMAT_NV12_10LE32 :
+      GST_VIDEO_FORMAT_NV12;
+
+  out_state = gst_video_decoder_set_output_state (GST_VIDEO_DECODER (dec),
+      format, width, height, dec->input_state);
+
+  /* In case if one of the parameters is zero, base class will override with
+     default values. To avoid this, we are passing on the same incoming
+     colorimetry information to downstream as well.
+     Refer https://jira.xilinx.com/browse/CR-1114507 for more information */
+  out_state->info.colorimetry.range = dec->input_state->info.colorimetry.range;
+  out_state->info.colorimetry.matrix =
+      dec->input_state->info.colorimetry.matrix;
+  out_state->info.colorimetry.transfer =
+      dec->input_state->info.colorimetry.transfer;
+  out_state->info.colorimetry.primaries =
+      dec->input_state->info.colorimetry.primaries;
+
+  if (!gst_video_decoder_negotiate (GST_VIDEO_DECODER (dec))) {
+    GST_ERROR_OBJECT (dec, "Failed to negotiate with downstream elements");
+    gst_video_codec_state_unref (out_state);
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+  gst_video_codec_state_unref (out_state);
+
+  outcaps = gst_pad_get_current_caps (GST_VIDEO_DECODER_SRC_PAD (dec));
+  if (!outcaps || !gst_video_info_from_caps (&dec->out_vinfo, outcaps)) {
+    GST_ERROR_OBJECT (dec, "failed to get out video info from caps");
+    if (outcaps)
+      gst_caps_unref (outcaps);
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+  GST_INFO_OBJECT (dec,
+      "negotiated caps on source pad : %" GST_PTR_FORMAT, outcaps);
+  gst_caps_unref (outcaps);
+
+  priv->renegotiate = FALSE;
+  return GST_FLOW_OK;
+}
+
 /** @fn GstFlowReturn receive_out_frame (GstVvas_XVideoDec * dec,
  *                                       VvasVideoFrame *voframe)
  *
@@ -700,70 +1012,20 @@ vvas_xvideodec_set_pts (GstVvas_XVideoDec * dec, GstVideoCodecFrame * frame,
 static GstFlowReturn
 receive_out_frame (GstVvas_XVideoDec * dec, VvasVideoFrame * voframe)
 {
-  GstVideoCodecState *out_state = NULL;
   GstVideoCodecFrame *frame;
   GstFlowReturn fret;
   GstBuffer *outbuf;
   GstMemory *outmem;
   VvasMetadata vmeta;
-  // TODO: get width and height from softkernel
-  if (gst_pad_is_active (GST_VIDEO_DECODER_SRC_PAD (dec)) &&
-      !gst_pad_has_current_caps (GST_VIDEO_DECODER_SRC_PAD (dec))) {
-    GstVideoInfo vinfo;
-    GstCaps *outcaps = NULL;
-    // TODO: add check for resolution change
-
-    /* HACK: taking input resolution and setting instead of taking from
-       softkernel output */
-    vinfo = dec->input_state->info;
-
-    if (dec->bit_depth == 10)
-      out_state =
-          gst_video_decoder_set_output_state (GST_VIDEO_DECODER (dec),
-          GST_VIDEO_FORMAT_NV12_10LE32,
-          GST_VIDEO_INFO_WIDTH (&vinfo),
-          GST_VIDEO_INFO_HEIGHT (&vinfo), dec->input_state);
-    else
-      out_state =
-          gst_video_decoder_set_output_state (GST_VIDEO_DECODER (dec),
-          GST_VIDEO_FORMAT_NV12,
-          GST_VIDEO_INFO_WIDTH (&vinfo),
-          GST_VIDEO_INFO_HEIGHT (&vinfo), dec->input_state);
-
-    /* In case if one of the parameters is zero, base class will override with
-       default values. To avoid this, we are passing on the same incoming
-       colorimetry information to downstream as well.
-       Refer https://jira.xilinx.com/browse/CR-1114507 for more information */
-    out_state->info.colorimetry.range =
-        dec->input_state->info.colorimetry.range;
-    out_state->info.colorimetry.matrix =
-        dec->input_state->info.colorimetry.matrix;
-    out_state->info.colorimetry.transfer =
-        dec->input_state->info.colorimetry.transfer;
-    out_state->info.colorimetry.primaries =
-        dec->input_state->info.colorimetry.primaries;
-
-    if (!gst_video_decoder_negotiate (GST_VIDEO_DECODER (dec))) {
-      GST_ERROR_OBJECT (dec, "Failed to negotiate with downstream elements");
-      gst_video_codec_state_unref (out_state);
-      return GST_FLOW_NOT_NEGOTIATED;
-    }
-
-    outcaps = gst_pad_get_current_caps (GST_VIDEO_DECODER_SRC_PAD (dec));
 
-    if (!gst_video_info_from_caps (&dec->out_vinfo, outcaps)) {
-      GST_ERROR_OBJECT (dec, "failed to get out video info from caps");
-      fret = GST_FLOW_ERROR;
-      goto error;
-    }
-    GST_INFO_OBJECT (dec,
-        "negotiated caps on source pad : %" GST_PTR_FORMAT, outcaps);
-  } else {
-    out_state = gst_video_decoder_get_output_state (GST_VIDEO_DECODER (dec));
+  if (gst_pad_is_active (GST_VIDEO_DECODER_SRC_PAD (dec)) &&
+      (!gst_pad_has_current_caps (GST_VIDEO_DECODER_SRC_PAD (dec)) ||
+          dec->priv->renegotiate)) {
+    fret = vvas_xvideodec_negotiate (dec);
+    if (fret != GST_FLOW_OK)
+      return fret;
   }
 
-  gst_video_codec_state_unref (out_state);
-
   frame = gst_video_decoder_get_oldest_frame (GST_VIDEO_DECODER (dec));
   if (!frame) {
     /* Can only happen in finish() */
@@ -823,9 +1085,6 @@ receive_out_frame (GstVvas_XVideoDec * dec, VvasVideoFrame * voframe)
     gst_memory_unref (outmem);
   }
 
-  /* free so that associated gstbuf can be unref'ed */
-  vvas_video_frame_free (voframe);
-
   GST_LOG_OBJECT (dec, "processing buffer %" GST_PTR_FORMAT,
       frame->output_buffer);
 
@@ -867,6 +1126,7 @@ gstvvas_xvideodec_start (GstVideoDecoder * decoder)
 
   dec->priv->vf_to_gstbuf_map
       = g_hash_table_new (g_direct_hash, g_direct_equal);
+  dec->priv->frame_cache = xlnx_frame_cache_set_new ();
 #ifdef ENABLE_XRM_SUPPORT
 
   /* create XRM context for managing the decode instances as device has limited
@@ -887,7 +1147,7 @@ gstvvas_xvideodec_start (GstVideoDecoder * decoder)
 static gboolean
 free_output_bufs (gpointer key, gpointer value, gpointer user_data)
 {
-  vvas_video_frame_free (key);
+  /* video frame is cached on the buffer, released along with it */
   gst_buffer_unref (value);
   return TRUE;
 }
@@ -921,8 +1181,11 @@ gstvvas_xvideodec_stop (GstVideoDecoder * decoder)
     priv->init_done = FALSE;
   }
 
-  g_hash_table_foreach_remove (priv->vf_to_gstbuf_map, free_output_bufs, dec);
+  /* cached video frames must go before VVAS context is destroyed */
+  vvas_xvideodec_release_output_frames (dec);
   g_hash_table_destroy (priv->vf_to_gstbuf_map);
+  xlnx_frame_cache_set_unref (priv->frame_cache);
+  priv->frame_cache = NULL;
   gst_clear_object (&priv->allocator);
 
   if (priv->pool)
@@ -1312,8 +1575,9 @@ recycle_vframe (GstVvas_XVideoDec * dec)
       break;
     }
 
-    output_frame = vvas_videoframe_from_gstbuffer (priv->vvas_ctx,
-        dec->out_mem_bank, outbuf, &(dec->out_vinfo), GST_MAP_READ);
+    vvas_xvideodec_update_video_meta (dec, outbuf, &dec->out_vinfo);
+
+    output_frame = vvas_xvideodec_get_vframe (dec, outbuf, &(dec->out_vinfo));
     if (!output_frame) {
       GST_ERROR_OBJECT (dec, "Could convert input GstBuffer to VvasVideoFrame");
       gst_buffer_unref (outbuf);
@@ -1326,8 +1590,7 @@ recycle_vframe (GstVvas_XVideoDec * dec)
        decoder library */
     g_mutex_lock (&priv->obuf_lock);
     g_hash_table_insert (priv->vf_to_gstbuf_map, output_frame, outbuf);
-    priv->free_vframe_list
-        = g_list_append (priv->free_vframe_list, output_frame);
+    g_queue_push_tail (&priv->free_vframe_queue, output_frame);
     g_mutex_unlock (&priv->obuf_lock);
     i++;
   }
@@ -1474,6 +1737,71 @@ compose_dec_config (GstVvas_XVideoDec * dec, VvasDecoderInCfg * dec_cfg)
   return TRUE;
 }
 
+/** @fn gboolean vvas_xvideodec_create_decoder (GstVvas_XVideoDec * dec,
+ *                                             VvasLogLevel core_log_level)
+ *
+ *  @param [in] dec - Decoder context
+ *  @param [in] core_log_level - Log level for VVAS core decoder
+ *
+ *  @return  On Success returns true
+ *           On Failure returns false
+ *
+ *  @brief   Creates and configures decoder instance on existing VVAS context
+ *  @details Decoder instance is created on the CU already reserved for this
+ *           session, hence the same can be used to re-create the decoder on
+ *           stream parameter change without releasing the CU.
+ */
+static gboolean
+vvas_xvideodec_create_decoder (GstVvas_XVideoDec * dec,
+    VvasLogLevel core_log_level)
+{
+  GstVvas_XVideoDecPrivate *priv = dec->priv;
+  VvasReturnType vret;
+  VvasDecoderInCfg incfg;
+  VvasDecoderOutCfg outcfg;
+
+  /* Create a decode instance */
+  GST_DEBUG_OBJECT (dec, "Creating VVAS Decoder");
+#ifdef XLNX_V70_PLATFORM
+  priv->vvas_dec = vvas_decoder_create (priv->vvas_ctx,
+      (uint8_t *) dec->kernel_name, priv->dec_type,
+      dec->hw_instance_id, core_log_level);
+#else
+  priv->vvas_dec = vvas_decoder_create (priv->vvas_ctx,
+      (uint8_t *) dec->kernel_name, priv->dec_type,
+      dec->sk_cur_idx, core_log_level);
+#endif
+  if (!priv->vvas_dec) {
+    GST_ERROR_OBJECT (dec, "Couldn't create VVAS Decoder");
+    return FALSE;
+  }
+
+  /* Compose the decoder config */
+  memset (&incfg, 0, sizeof (incfg));
+  memset (&outcfg, 0, sizeof (outcfg));
+  compose_dec_config (dec, &incfg);
+
+  /* Configure decoder */
+  vret = vvas_decoder_config (priv->vvas_dec, &incfg, &outcfg);
+  if (vret != VVAS_RET_SUCCESS) {
+    vvas_decoder_destroy (priv->vvas_dec);
+    priv->vvas_dec = NULL;
+    GST_ERROR_OBJECT (dec, "vvas_decoder_config Failed vret = %d", vret);
+    return FALSE;
+  }
+
+  /* outcfg returns the video-frame info and number of such frame needed by
+     decoder */
+  priv->num_out_bufs = outcfg.min_out_buf;
+  priv->out_width = outcfg.vinfo.width;
+  priv->out_height = outcfg.vinfo.height;
+
+  GST_INFO_OBJECT (dec, "decoder output %ux%u, minimum output buffers %u",
+      priv->out_width, priv->out_height, priv->num_out_bufs);
+
+  return TRUE;
+}
+
 /** @fn gboolean vvas_xvideodec_create_context (GstVvas_XVideoDec * dec)
  *
  *  @param [in] dec Decoder - context
@@ -1491,8 +1819,6 @@ static gboolean
 vvas_xvideodec_create_context (GstVvas_XVideoDec * dec)
 {
   VvasReturnType vret;
-  VvasDecoderInCfg incfg;
-  VvasDecoderOutCfg outcfg;
   GstVvas_XVideoDecPrivate *priv = dec->priv;
   VvasLogLevel core_log_level =
       vvas_get_core_log_level (gst_debug_category_get_threshold
@@ -1553,43 +1879,12 @@ vvas_xvideodec_create_context (GstVvas_XVideoDec * dec)
     return FALSE;
   }
 
-  /* Create a decode instance */
-  GST_DEBUG_OBJECT (dec, "Creating VVAS Decoder");
-#ifdef XLNX_V70_PLATFORM
-  priv->vvas_dec = vvas_decoder_create (priv->vvas_ctx,
-      (uint8_t *) dec->kernel_name, priv->dec_type,
-      dec->hw_instance_id, core_log_level);
-#else
-  priv->vvas_dec = vvas_decoder_create (priv->vvas_ctx,
-      (uint8_t *) dec->kernel_name, priv->dec_type,
-      dec->sk_cur_idx, core_log_level);
-#endif
-  if (!priv->vvas_dec) {
-    GST_ERROR_OBJECT (dec, "Couldn't create VVAS Decoder");
-    vvas_context_destroy (priv->vvas_ctx);
-    priv->vvas_ctx = NULL;
-    return FALSE;
-  }
-
-  /* Compose the decoder config */
-  memset (&incfg, 0, sizeof (incfg));
-  compose_dec_config (dec, &incfg);
-
-  /* Configure decoder */
-  vret = vvas_decoder_config (priv->vvas_dec, &incfg, &outcfg);
-  if (vret != VVAS_RET_SUCCESS) {
-    vvas_decoder_destroy (priv->vvas_dec);
+  if (!vvas_xvideodec_create_decoder (dec, core_log_level)) {
     vvas_context_destroy (priv->vvas_ctx);
-    priv->vvas_dec = NULL;
     priv->vvas_ctx = NULL;
-    GST_ERROR_OBJECT (dec, "vvas_decoder_config Failed vret = %d", vret);
     return FALSE;
   }
 
-  /* outcfg returns the video-frame info and number of such frame needed by
-     decoder */
-  priv->num_out_bufs = outcfg.min_out_buf;
-
   return TRUE;
 }
 
@@ -1673,6 +1968,110 @@ vvas_xvideodec_destroy_context (GstVvas_XVideoDec * dec)
   return has_error ? FALSE : TRUE;
 }
 
+/** @fn void vvas_xvideodec_release_output_frames (GstVvas_XVideoDec * dec)
+ *
+ *  @param [in] dec - Decoder context
+ *
+ *  @return void
+ *
+ *  @brief  Releases output frames which are still owned by decoder instance
+ *  @details Buffers of frames which are not pushed downstream go back to the
+ *           pool and video frames cached on output buffers are invalidated.
+ *           Must be called only after decoder has been drained or destroyed.
+ */
+static void
+vvas_xvideodec_release_output_frames (GstVvas_XVideoDec * dec)
+{
+  GstVvas_XVideoDecPrivate *priv = dec->priv;
+
+  g_mutex_lock (&priv->obuf_lock);
+  g_queue_clear (&priv->free_vframe_queue);
+  g_mutex_unlock (&priv->obuf_lock);
+
+  g_hash_table_foreach_remove (priv->vf_to_gstbuf_map, free_output_bufs, dec);
+  /* invalidate wrappers, they refer to current context and resolution */
+  xlnx_frame_cache_set_invalidate (priv->frame_cache);
+  priv->init_done = FALSE;
+  priv->last_pts = GST_CLOCK_TIME_NONE;
+  priv->genpts = 0;
+}
+
+/** @fn gboolean vvas_xvideodec_is_resolution_change (GstVideoCodecState * old_state,
+ *                                                  GstVideoCodecState * new_state)
+ *
+ *  @param [in] old_state - Current input state
+ *  @param [in] new_state - New input state
+ *
+ *  @return TRUE if resolution or bit depth changed within the same codec
+ *          FALSE otherwise
+ *
+ *  @brief  Checks whether new caps carry a mid-stream resolution change
+ */
+static gboolean
+vvas_xvideodec_is_resolution_change (GstVideoCodecState * old_state,
+    GstVideoCodecState * new_state)
+{
+  const GstStructure *old_s, *new_s;
+  guint old_depth = 8, new_depth = 8;
+
+  old_s = gst_caps_get_structure (old_state->caps, 0);
+  new_s = gst_caps_get_structure (new_state->caps, 0);
+
+  if (!gst_structure_has_name (new_s, gst_structure_get_name (old_s)))
+    return FALSE;
+
+  gst_structure_get_uint (old_s, "bit-depth-luma", &old_depth);
+  gst_structure_get_uint (new_s, "bit-depth-luma", &new_depth);
+
+  return GST_VIDEO_INFO_WIDTH (&old_state->info) !=
+      GST_VIDEO_INFO_WIDTH (&new_state->info) ||
+      GST_VIDEO_INFO_HEIGHT (&old_state->info) !=
+      GST_VIDEO_INFO_HEIGHT (&new_state->info) || old_depth != new_depth;
+}
+
+/** @fn gboolean vvas_xvideodec_reconfigure_decoder (GstVvas_XVideoDec * dec)
+ *
+ *  @param [in] dec - Decoder context
+ *
+ *  @return  On Success returns true
+ *           On Failure returns false
+ *
+ *  @brief   Reconfigures decoder for new stream parameters in place
+ *  @details Decoder must be drained before calling this. Only the decoder
+ *           instance is re-created, VVAS context and the reserved CU are kept.
+ *           Output caps are renegotiated when next frame is handled, at which
+ *           point buffer pool is reused if its buffers are large enough.
+ */
+static gboolean
+vvas_xvideodec_reconfigure_decoder (GstVvas_XVideoDec * dec)
+{
+  GstVvas_XVideoDecPrivate *priv = dec->priv;
+  VvasLogLevel core_log_level =
+      vvas_get_core_log_level (gst_debug_category_get_threshold
+      (gstvvas_xvideodec_debug_category));
+  VvasReturnType vret;
+
+  GST_INFO_OBJECT (dec, "reconfiguring decoder for new stream resolution");
+
+  if (priv->vvas_dec) {
+    vret = vvas_decoder_destroy (priv->vvas_dec);
+    priv->vvas_dec = NULL;
+    if (vret != VVAS_RET_SUCCESS) {
+      GST_ERROR_OBJECT (dec, "failed to destroy vvas-core decoder, vret=%d",
+          vret);
+      return FALSE;
+    }
+  }
+
+  vvas_xvideodec_release_output_frames (dec);
+
+  if (!vvas_xvideodec_create_decoder (dec, core_log_level))
+    return FALSE;
+
+  priv->renegotiate = TRUE;
+  return TRUE;
+}
+
 /** @fn gboolean gstvvas_xvideodec_set_format (GstVideoDecoder * decoder,
  *                                           GstVideoCodecState * state)
  *
@@ -1684,7 +2083,9 @@ vvas_xvideodec_destroy_context (GstVvas_XVideoDec * dec)
 
  *  @brief   Sets the current decoder format and reconfigures it if changed.
  *  @details If the new format is different from current one(if present), all
- *           the buffers are freed, context is destroyed.
+ *           the buffers are freed, context is destroyed. On a mid-stream
+ *           resolution change, decoder is drained and reconfigured in place
+ *           keeping the reserved CU.
  */
 static gboolean
 gstvvas_xvideodec_set_format (GstVideoDecoder * decoder,
@@ -1695,6 +2096,8 @@ gstvvas_xvideodec_set_format (GstVideoDecoder * decoder,
   const gchar *mimetype;
   gboolean bret = TRUE;
   gboolean do_reconfigure = FALSE;
+  gboolean do_resize = FALSE;
+  GstFlowReturn fret;
 
   GST_DEBUG_OBJECT (dec, "input caps: %" GST_PTR_FORMAT, state->caps);
 
@@ -1702,6 +2105,26 @@ gstvvas_xvideodec_set_format (GstVideoDecoder * decoder,
       !gst_caps_is_equal (dec->input_state->caps, state->caps))
     do_reconfigure = TRUE;
 
+  if (do_reconfigure && dec->input_state && priv->init_done &&
+      vvas_xvideodec_is_resolution_change (dec->input_state, state)) {
+    GST_INFO_OBJECT (dec, "resolution changed from %dx%d to %dx%d",
+        GST_VIDEO_INFO_WIDTH (&dec->input_state->info),
+        GST_VIDEO_INFO_HEIGHT (&dec->input_state->info),
+        GST_VIDEO_INFO_WIDTH (&state->info),
+        GST_VIDEO_INFO_HEIGHT (&state->info));
+
+    /* push out all the frames decoded with previous stream parameters */
+    fret = gstvvas_xvideodec_finish (decoder);
+    if (fret != GST_FLOW_OK) {
+      /* frames of previous resolution could not be pushed, reconfiguring
+       * now would drop them */
+      GST_ERROR_OBJECT (dec, "failed to drain decoder on resolution change, "
+          "reason %s", gst_flow_get_name (fret));
+      return FALSE;
+    }
+    do_resize = TRUE;
+  }
+
   if (dec->input_state) {
     gst_video_codec_state_unref (dec->input_state);
     dec->input_state = NULL;
@@ -1746,10 +2169,21 @@ gstvvas_xvideodec_set_format (GstVideoDecoder * decoder,
       goto error;
     }
 
-    if (priv->cur_load != load) {
+    if (do_resize && load <= priv->cur_load) {
+      /* CU reserved for current stream can handle the new load as well */
+      bret = vvas_xvideodec_reconfigure_decoder (dec);
+      if (!bret) {
+        goto error;
+      }
+    } else if (priv->cur_load != load) {
 
       priv->cur_load = load;
 
+      if (do_resize) {
+        vvas_xvideodec_release_output_frames (dec);
+        priv->renegotiate = TRUE;
+      }
+
       /* destroy XRT context as new load received */
       bret = vvas_xvideodec_destroy_context (dec);
       if (!bret) {
@@ -1769,6 +2203,11 @@ gstvvas_xvideodec_set_format (GstVideoDecoder * decoder,
       if (!bret) {
         goto error;
       }
+    } else if (do_resize) {
+      bret = vvas_xvideodec_reconfigure_decoder (dec);
+      if (!bret) {
+        goto error;
+      }
     }
 #endif
   }
@@ -1937,6 +2376,109 @@ gstvvas_xvideodec_get_property (GObject * object, guint prop_id,
   }
 }
 
+/** @fn gboolean vvas_xvideodec_can_reuse_pool (GstVvas_XVideoDec * dec,
+ *                                             GstVideoInfo * vinfo,
+ *                                             guint size, guint * min,
+ *                                             guint * max)
+ *
+ *  @param [in] dec - Decoder context
+ *  @param [in] vinfo - New output video info
+ *  @param [in] size - Aligned frame size required for new resolution
+ *  @param [inout] min - Minimum buffers required, updated with pool's value
+ *  @param [inout] max - Maximum buffers required, updated with pool's value
+ *
+ *  @return TRUE if current pool can serve the new resolution
+ *          FALSE otherwise
+ *
+ *  @brief  Checks whether current pool can be kept after resolution change
+ *  @details Pool is reused when format is unchanged, its buffers are large
+ *           enough for the new aligned frame size and it can provide the
+ *           number of buffers required by decoder.
+ */
+static gboolean
+vvas_xvideodec_can_reuse_pool (GstVvas_XVideoDec * dec, GstVideoInfo * vinfo,
+    guint size, guint * min, guint * max)
+{
+  GstStructure *config;
+  GstCaps *caps = NULL;
+  GstVideoInfo pool_vinfo;
+  guint pool_size, pool_min, pool_max;
+  gboolean bret = FALSE;
+
+  if (!dec->priv->pool || !gst_buffer_pool_is_active (dec->priv->pool))
+    return FALSE;
+
+  config = gst_buffer_pool_get_config (dec->priv->pool);
+  if (gst_buffer_pool_config_get_params (config, &caps, &pool_size, &pool_min,
+          &pool_max) && caps && gst_video_info_from_caps (&pool_vinfo, caps)) {
+    bret = GST_VIDEO_INFO_FORMAT (&pool_vinfo) == GST_VIDEO_INFO_FORMAT (vinfo)
+        && size <= pool_size && (!pool_max || *min <= pool_max);
+    if (bret) {
+      *min = MAX (*min, pool_min);
+      *max = pool_max;
+    }
+  }
+  gst_structure_free (config);
+
+  GST_DEBUG_OBJECT (dec, "pool %s be reused for frame size %u",
+      bret ? "can" : "can not", size);
+  return bret;
+}
+
+/** @fn gboolean vvas_xvideodec_update_pool_caps (GstVvas_XVideoDec * dec,
+ *                                               GstCaps * outcaps,
+ *                                               guint * size, guint min,
+ *                                               guint max)
+ *
+ *  @param [in] dec - Decoder context
+ *  @param [in] outcaps - Newly negotiated output caps
+ *  @param [out] size - Buffer size of the pool
+ *  @param [in] min - Minimum buffers required
+ *  @param [in] max - Maximum buffers required
+ *
+ *  @return TRUE if the pool now carries @outcaps in its config
+ *          FALSE otherwise, pool is then left inactive
+ *
+ *  @brief  Puts the new caps in the config of the pool kept across
+ *          renegotiation
+ *  @details Pool allocates buffers and their video meta as per the caps of
+ *           its config, so a stale config must not be kept even when only
+ *           colorimetry or framerate changed. An active pool only accepts
+ *           the config it already has, else it has to be stopped, which is
+ *           possible only when downstream has returned all its buffers.
+ */
+static gboolean
+vvas_xvideodec_update_pool_caps (GstVvas_XVideoDec * dec, GstCaps * outcaps,
+    guint * size, guint min, guint max)
+{
+  GstBufferPool *pool = dec->priv->pool;
+  GstStructure *config;
+
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_get_params (config, NULL, size, NULL, NULL);
+  gst_buffer_pool_config_set_params (config, outcaps, *size, min, max);
+
+  /* unchanged config is accepted by an active pool as well */
+  if (gst_buffer_pool_set_config (pool, gst_structure_copy (config))) {
+    gst_structure_free (config);
+    return TRUE;
+  }
+
+  if (!gst_buffer_pool_set_active (pool, FALSE) ||
+      !gst_buffer_pool_set_config (pool, config)) {
+    GST_INFO_OBJECT (dec, "pool %" GST_PTR_FORMAT " can not take new caps "
+        "while its buffers are held downstream", pool);
+    return FALSE;
+  }
+
+  if (!gst_buffer_pool_set_active (pool, TRUE)) {
+    GST_ERROR_OBJECT (dec, "failed to activate pool with new caps");
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
 /** @fn gboolean gstvvas_xvideodec_decide_allocation (GstVideoDecoder * decoder,
                                                     GstQuery * query)
  *
@@ -2107,13 +2649,29 @@ gstvvas_xvideodec_decide_allocation (GstVideoDecoder * decoder,
     return FALSE;
   }
 
+  size = set_align_param (dec, &vinfo, &align);
+
+  if (vvas_xvideodec_can_reuse_pool (dec, &vinfo, size, &min, &max) &&
+      vvas_xvideodec_update_pool_caps (dec, outcaps, &size, min, max)) {
+    /* Keep the pool of previous resolution, its buffers are large enough
+     * to hold the frames of new resolution */
+    GST_INFO_OBJECT (dec, "reusing pool %" GST_PTR_FORMAT
+        " for new resolution %dx%d", dec->priv->pool,
+        GST_VIDEO_INFO_WIDTH (&vinfo), GST_VIDEO_INFO_HEIGHT (&vinfo));
+    gst_object_unref (pool);
+    pool = dec->priv->pool;
+
+    /* Buffers of this pool may still be held by downstream, so hand over only
+     * the minimum required by decoder, rest are handed over as they return */
+    goto alloc_out_bufs;
+  }
+
   if (dec->avoid_dynamic_alloc)
     dec->priv->num_out_bufs = max;
   else
     dec->priv->num_out_bufs = min;
 
   config = gst_buffer_pool_get_config (pool);
-  size = set_align_param (dec, &vinfo, &align);
 
   gst_buffer_pool_config_add_option (config,
       GST_BUFFER_POOL_OPTION_VIDEO_ALIGNMENT);
@@ -2137,11 +2695,15 @@ gstvvas_xvideodec_decide_allocation (GstVideoDecoder * decoder,
     return FALSE;
   }
 
-  if (dec->priv->pool)
+  if (dec->priv->pool) {
+    /* buffers still held by downstream are freed once they are returned */
+    gst_buffer_pool_set_active (dec->priv->pool, FALSE);
     gst_object_unref (dec->priv->pool);
+  }
 
   dec->priv->pool = pool;
 
+alloc_out_bufs:
   if (!vvas_video_dec_outbuffer_alloc_and_map (dec, &vinfo)) {
     GST_ERROR_OBJECT (dec, "failed to allocate & map output buffers");
     return FALSE;
@@ -2212,54 +2774,11 @@ gstvvas_xvideodec_handle_frame (GstVideoDecoder * decoder,
   GST_LOG_OBJECT (dec, "input %" GST_PTR_FORMAT, frame ? frame->input_buffer :
       NULL);
   if (gst_pad_is_active (GST_VIDEO_DECODER_SRC_PAD (dec)) &&
-      !gst_pad_has_current_caps (GST_VIDEO_DECODER_SRC_PAD (dec))) {
-    GstVideoInfo vinfo;
-    GstCaps *outcaps = NULL;
-    GstVideoCodecState *out_state = NULL;
-
-    // TODO: add check for resolution change
-    vinfo = dec->input_state->info;
-
-    if (dec->bit_depth == 10)
-      out_state =
-          gst_video_decoder_set_output_state (GST_VIDEO_DECODER (dec),
-          GST_VIDEO_FORMAT_NV12_10LE32,
-          GST_VIDEO_INFO_WIDTH (&vinfo),
-          GST_VIDEO_INFO_HEIGHT (&vinfo), dec->input_state);
-    else
-      out_state =
-          gst_video_decoder_set_output_state (GST_VIDEO_DECODER (dec),
-          GST_VIDEO_FORMAT_NV12,
-          GST_VIDEO_INFO_WIDTH (&vinfo),
-          GST_VIDEO_INFO_HEIGHT (&vinfo), dec->input_state);
-
-    /* In case if one of the parameters is zero, base class will override with
-       default default values. To avoid this, we are passing on the same
-       incoming colorimetry information to downstream as well.
-       Refer https://jira.xilinx.com/browse/CR-1114507 for more information */
-    out_state->info.colorimetry.range =
-        dec->input_state->info.colorimetry.range;
-    out_state->info.colorimetry.matrix =
-        dec->input_state->info.colorimetry.matrix;
-    out_state->info.colorimetry.transfer =
-        dec->input_state->info.colorimetry.transfer;
-    out_state->info.colorimetry.primaries =
-        dec->input_state->info.colorimetry.primaries;
-
-    if (!gst_video_decoder_negotiate (GST_VIDEO_DECODER (dec))) {
-      GST_ERROR_OBJECT (dec, "Failed to negotiate with downstream elements");
-      gst_video_codec_state_unref (out_state);
-      return GST_FLOW_NOT_NEGOTIATED;
-    }
-    outcaps = gst_pad_get_current_caps (GST_VIDEO_DECODER_SRC_PAD (dec));
-    if (!outcaps || !gst_video_info_from_caps (&dec->out_vinfo, outcaps)) {
-      GST_ERROR_OBJECT (dec, "failed to get out video info from caps");
-      return GST_FLOW_NOT_NEGOTIATED;
-    }
-    GST_INFO_OBJECT (dec,
-        "negotiated caps on source pad : %" GST_PTR_FORMAT, outcaps);
-    gst_video_codec_state_unref (out_state);
-    gst_caps_unref (outcaps);
+      (!gst_pad_has_current_caps (GST_VIDEO_DECODER_SRC_PAD (dec)) ||
+          priv->renegotiate)) {
+    fret = vvas_xvideodec_negotiate (dec);
+    if (fret != GST_FLOW_OK)
+      return fret;
   }
 
   if (!frame) {
@@ -2290,7 +2809,7 @@ gstvvas_xvideodec_handle_frame (GstVideoDecoder * decoder,
 try_again:
   /* Sumbit the encoded frame to decoder */
   vret = vvas_decoder_submit_frames (priv->vvas_dec, in_mem,
-      (VvasList *) priv->free_vframe_list);
+      (VvasList *) priv->free_vframe_queue.head);
   if (vret == VVAS_RET_SEND_AGAIN) {
     /* Decoder didn't consume the encoded frame, may be bacause there are no
        room for output buffer. encoded frames required to be sent again once
@@ -2305,8 +2824,7 @@ try_again:
   dec->priv->init_done = TRUE;
 
   g_mutex_lock (&priv->obuf_lock);
-  g_list_free (priv->free_vframe_list);
-  priv->free_vframe_list = NULL;
+  g_queue_clear (&priv->free_vframe_queue);
   g_mutex_unlock (&priv->obuf_lock);
 
   /* Get the decoded frame from decoder, one frame at a time  */
@@ -2328,7 +2846,7 @@ try_again:
     fret = GST_FLOW_OK;
 
     g_mutex_lock (&dec->priv->obuf_lock);
-    num_free_obuf = g_list_length (priv->free_vframe_list);
+    num_free_obuf = g_queue_get_length (&priv->free_vframe_queue);
 
     if (num_free_obuf) {
       /* send again may get success when free outbufs available */
@@ -2400,7 +2918,7 @@ gstvvas_xvideodec_finish (GstVideoDecoder * decoder)
   VvasVideoFrame *voframe = NULL;
   guint num_free_obuf = 0;
   GstVvas_XVideoDecPrivate *priv = dec->priv;
-
+  GstFlowReturn fret = GST_FLOW_ERROR;
 
   GST_DEBUG_OBJECT (dec, "finish");
 
@@ -2411,10 +2929,12 @@ gstvvas_xvideodec_finish (GstVideoDecoder * decoder)
   do {
     vret = vvas_decoder_get_decoded_frame (priv->vvas_dec, &voframe);
     if (vret == VVAS_RET_SUCCESS) {
-      if (receive_out_frame (dec, voframe) != GST_FLOW_OK)
+      fret = receive_out_frame (dec, voframe);
+      if (fret != GST_FLOW_OK)
         goto error;
     } else if (vret == VVAS_RET_ERROR) {
       GST_ERROR_OBJECT (dec, "get_decoded_frame failed inside finish\n");
+      fret = GST_FLOW_ERROR;
       goto error;
     }
   }
@@ -2423,20 +2943,20 @@ gstvvas_xvideodec_finish (GstVideoDecoder * decoder)
   recycle_vframe (dec);
 
   g_mutex_lock (&priv->obuf_lock);
-  num_free_obuf = g_list_length (priv->free_vframe_list);
+  num_free_obuf = g_queue_get_length (&priv->free_vframe_queue);
   g_mutex_unlock (&priv->obuf_lock);
 
   /* Invoke decoder flush */
   vret = vvas_decoder_submit_frames (priv->vvas_dec, NULL,
-      (VvasList *) priv->free_vframe_list);
+      (VvasList *) priv->free_vframe_queue.head);
   if (vret != VVAS_RET_SUCCESS) {
     GST_ERROR_OBJECT (dec, "submit_frames/FLUSH Failed vret = %d", vret);
+    fret = GST_FLOW_ERROR;
     goto error;
   }
 
   g_mutex_lock (&priv->obuf_lock);
-  g_list_free (priv->free_vframe_list);
-  priv->free_vframe_list = NULL;
+  g_queue_clear (&priv->free_vframe_queue);
   g_mutex_unlock (&priv->obuf_lock);
 
   /* Collect all the output video-frame post flush call untill output EOS
@@ -2444,25 +2964,26 @@ gstvvas_xvideodec_finish (GstVideoDecoder * decoder)
   do {
     vret = vvas_decoder_get_decoded_frame (priv->vvas_dec, &voframe);
     if (vret == VVAS_RET_SUCCESS) {
-      if (receive_out_frame (dec, voframe) != GST_FLOW_OK)
+      fret = receive_out_frame (dec, voframe);
+      if (fret != GST_FLOW_OK)
         goto error;
     } else if (vret == VVAS_RET_ERROR) {
       GST_ERROR_OBJECT (dec, "get_decoded_frame failed inside finish loop\n");
+      fret = GST_FLOW_ERROR;
       goto error;
     }
 
     recycle_vframe (dec);
 
     g_mutex_lock (&priv->obuf_lock);
-    num_free_obuf = g_list_length (priv->free_vframe_list);
+    num_free_obuf = g_queue_get_length (&priv->free_vframe_queue);
     g_mutex_unlock (&priv->obuf_lock);
 
     if (num_free_obuf) {
       vvas_decoder_submit_frames (priv->vvas_dec, NULL,
-          (VvasList *) priv->free_vframe_list);
+          (VvasList *) priv->free_vframe_queue.head);
       g_mutex_lock (&priv->obuf_lock);
-      g_list_free (priv->free_vframe_list);
-      priv->free_vframe_list = NULL;
+      g_queue_clear (&priv->free_vframe_queue);
       g_mutex_unlock (&priv->obuf_lock);
     }
   }
@@ -2471,7 +2992,7 @@ gstvvas_xvideodec_finish (GstVideoDecoder * decoder)
   return GST_FLOW_OK;
 
 error:
-  return GST_FLOW_ERROR;
+  return fret;
 }
 
 /** @fn gboolean gstvvas_xvideodec_src_event_default (GstVideoDecoder * decoder, GstEvent * event)
@@ -2704,6 +3225,9 @@ gstvvas_xvideodec_class_init (GstVvas_XVideoDecClass * klass)
   GST_DEBUG_CATEGORY_INIT (gstvvas_xvideodec_debug_category, "vvas_xvideodec",
       0, "debug category for video h264/h265 decoder element");
   GST_DEBUG_CATEGORY_GET (GST_CAT_PERFORMANCE, "GST_PERFORMANCE");
+
+  xlnx_frame_cache_quark =
+      g_quark_from_static_string ("GstVvasXVideoDecFrameCache");
 }
 
 /** @fn void gstvvas_xvideodec_init (GstVvas_XVideoDec * dec)
@@ -2752,7 +3276,8 @@ gstvvas_xvideodec_init (GstVvas_XVideoDec * dec)
   priv->vvas_ctx = NULL;
   priv->vvas_dec = NULL;
   priv->vf_to_gstbuf_map = NULL;
-  priv->free_vframe_list = NULL;
+  g_queue_init (&priv->free_vframe_queue);
+  priv->frame_cache = NULL;
   priv->dec_type = VVAS_CODEC_UNKNOWN;
   vvas_xvideodec_reset (dec);
 }
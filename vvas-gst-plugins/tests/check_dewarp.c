@@ -0,0 +1,364 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * Functional check of the vvas_xdewarp remap. A smooth grid is rendered as
+ * seen through a distorting lens: every input pixel is undistorted by the
+ * iterative inverse of the lens model and the grid is evaluated there.
+ * Dewarping must give back the grid, within a bounded error per pixel, for
+ * barrel, pincushion, tangential and rational lenses. A lens without
+ * distortion must copy the frame exactly, and remapping in bands, as the
+ * element threads do, must match a single pass. With --bench, map
+ * computation and remap are timed on a 1080p luma plane instead.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <glib.h>
+#include "vvas_xdewarp_remap.h"
+
+/* Period of the grid in pixels */
+#define CHECK_PERIOD 24.0
+/* Largest error of a pixel and of the mean over the frame */
+#define CHECK_MAX_ERROR 4
+#define CHECK_MAX_MEAN_ERROR 0.75
+/* Iterations of the inverse lens model and its residual in pixels */
+#define CHECK_UNDISTORT_ITERATIONS 50
+#define CHECK_UNDISTORT_RESIDUAL 1e-3
+#define CHECK_BANDS 7
+#define BENCH_WIDTH 1920
+#define BENCH_HEIGHT 1080
+#define BENCH_ITERATIONS 20
+
+typedef struct
+{
+  /** Name printed in the result */
+  const gchar *name;
+  /** Frame width */
+  guint width;
+  /** Frame height */
+  guint height;
+  /** Focal length relative to the width */
+  gdouble focal;
+  /** k1, k2, p1, p2, k3, k4, k5, k6 */
+  gdouble coeffs[VVAS_XDEWARP_MAX_COEFFS];
+} CheckCase;
+
+static const CheckCase check_cases[] = {
+  {"barrel", 320, 240, 0.8, {-0.28, 0.07}},
+  {"pincushion", 320, 240, 1.0, {0.15, 0.02}},
+  {"tangential", 352, 288, 0.9, {-0.1, 0.0, 0.002, -0.003}},
+  {"rational", 640, 360, 0.7, {0.4, 0.05, 0.0, 0.0, 0.0, 0.6, 0.12, 0.0}},
+  {"fisheye", 640, 480, 0.5, {-0.32, 0.12, 0.0, 0.0, -0.02}},
+};
+
+/**
+ *  @fn static gdouble check_grid (gdouble x, gdouble y)
+ *  @param [in] x - Column
+ *  @param [in] y - Line
+ *  @return Luma of the undistorted test grid at (x, y)
+ */
+static gdouble
+check_grid (gdouble x, gdouble y)
+{
+  return 128.0 + 50.0 * (cos (2 * G_PI * x / CHECK_PERIOD) +
+      cos (2 * G_PI * y / CHECK_PERIOD));
+}
+
+/**
+ *  @fn static void check_camera (const CheckCase * test,
+ *                                VvasXDewarpCamera * cam)
+ *  @param [in] test - Test case
+ *  @param [out] cam - Camera of the case, principal point off centre
+ *  @return None
+ */
+static void
+check_camera (const CheckCase * test, VvasXDewarpCamera * cam)
+{
+  memset (cam, 0, sizeof (*cam));
+  cam->fx = cam->fy = test->focal * test->width;
+  cam->cx = test->width / 2.0 + 3.5;
+  cam->cy = test->height / 2.0 - 2.25;
+  memcpy (cam->coeffs, test->coeffs, sizeof (cam->coeffs));
+}
+
+/**
+ *  @fn static gboolean check_undistort_point (const VvasXDewarpCamera * cam,
+ *                                             gdouble u, gdouble v,
+ *                                             gdouble * x, gdouble * y)
+ *  @param [in] cam - Camera
+ *  @param [in] u - Column in the distorted frame
+ *  @param [in] v - Line in the distorted frame
+ *  @param [out] x - Column in the undistorted frame
+ *  @param [out] y - Line in the undistorted frame
+ *  @return TRUE if the iteration converged
+ */
+static gboolean
+check_undistort_point (const VvasXDewarpCamera * cam, gdouble u, gdouble v,
+    gdouble * x, gdouble * y)
+{
+  const gdouble *k = cam->coeffs;
+  gdouble du = (u - cam->cx) / cam->fx, dv = (v - cam->cy) / cam->fy;
+  gdouble nx = du, ny = dv, ru, rv;
+  guint i;
+
+  for (i = 0; i < CHECK_UNDISTORT_ITERATIONS; i++) {
+    gdouble r2 = nx * nx + ny * ny;
+    gdouble icdist = (1 + ((k[7] * r2 + k[6]) * r2 + k[5]) * r2) /
+        (1 + ((k[4] * r2 + k[1]) * r2 + k[0]) * r2);
+    gdouble tx = 2 * k[2] * nx * ny + k[3] * (r2 + 2 * nx * nx);
+    gdouble ty = k[2] * (r2 + 2 * ny * ny) + 2 * k[3] * nx * ny;
+
+    nx = (du - tx) * icdist;
+    ny = (dv - ty) * icdist;
+  }
+
+  *x = nx * cam->fx + cam->cx;
+  *y = ny * cam->fy + cam->cy;
+  vvas_xdewarp_distort_point (cam, *x, *y, &ru, &rv);
+
+  return fabs (ru - u) < CHECK_UNDISTORT_RESIDUAL &&
+      fabs (rv - v) < CHECK_UNDISTORT_RESIDUAL;
+}
+
+/**
+ *  @fn static gboolean check_case (const CheckCase * test)
+ *  @param [in] test - Test case
+ *  @return TRUE if the dewarped grid is within the error bounds
+ */
+static gboolean
+check_case (const CheckCase * test)
+{
+  guint width = test->width, height = test->height;
+  guint8 *src = g_new (guint8, width * height);
+  guint8 *dst = g_new (guint8, width * height);
+  gboolean *valid = g_new (gboolean, width * height);
+  VvasXDewarpCamera cam;
+  VvasXDewarpMap map;
+  guint x, y, checked = 0, max_err = 0;
+  guint64 sum_err = 0;
+  gdouble mean_err;
+  gboolean ok;
+
+  check_camera (test, &cam);
+
+  /* The distorted input, pixels whose inverse does not converge are left
+   * out of the check together with the output pixels reading them */
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x++) {
+      gdouble ux, uy;
+
+      valid[y * width + x] = check_undistort_point (&cam, x, y, &ux, &uy);
+      src[y * width + x] = (guint8) lround (check_grid (ux, uy));
+    }
+  }
+
+  vvas_xdewarp_map_init (&map, &cam, width, height);
+  vvas_xdewarp_remap (&map, src, width, dst, width, 1, 0, 0, height);
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x++) {
+      gdouble u, v;
+      guint err, iu, iv;
+
+      vvas_xdewarp_distort_point (&cam, x, y, &u, &v);
+      if (u < 0 || v < 0 || u > width - 2 || v > height - 2)
+        continue;
+      iu = (guint) u;
+      iv = (guint) v;
+      if (!valid[iv * width + iu] || !valid[iv * width + iu + 1] ||
+          !valid[(iv + 1) * width + iu] || !valid[(iv + 1) * width + iu + 1])
+        continue;
+
+      err = ABS ((gint) dst[y * width + x] - (gint) lround (check_grid (x,
+                  y)));
+      max_err = MAX (max_err, err);
+      sum_err += err;
+      checked++;
+    }
+  }
+
+  mean_err = checked ? (gdouble) sum_err / checked : 0.0;
+  ok = checked > width * height / 4 && max_err <= CHECK_MAX_ERROR &&
+      mean_err <= CHECK_MAX_MEAN_ERROR;
+
+  printf ("{\"benchmark\": \"dewarp\", \"case\": \"%s\", \"width\": %u, "
+      "\"height\": %u, \"checked_pixels\": %u, \"max_error\": %u, "
+      "\"mean_error\": %.3f, \"status\": \"%s\"}\n", test->name, width,
+      height, checked, max_err, mean_err, ok ? "ok" : "failed");
+  if (!ok)
+    g_printerr ("%s: %u pixels checked, max error %u, mean error %.3f\n",
+        test->name, checked, max_err, mean_err);
+
+  vvas_xdewarp_map_clear (&map);
+  g_free (valid);
+  g_free (dst);
+  g_free (src);
+
+  return ok;
+}
+
+/**
+ *  @fn static gboolean check_identity (void)
+ *  @return TRUE if a lens without distortion copies the frame
+ */
+static gboolean
+check_identity (void)
+{
+  const guint width = 333, height = 101, channels = 2;
+  guint8 *src = g_new (guint8, width * height * channels);
+  guint8 *dst = g_new0 (guint8, width * height * channels);
+  VvasXDewarpCamera cam = { 0 };
+  VvasXDewarpMap map;
+  gboolean same;
+  guint i;
+
+  for (i = 0; i < width * height * channels; i++)
+    src[i] = (i * 7 + i / 13) & 0xff;
+
+  cam.fx = cam.fy = width;
+  cam.cx = width / 2.0;
+  cam.cy = height / 2.0;
+  vvas_xdewarp_map_init (&map, &cam, width, height);
+  vvas_xdewarp_remap (&map, src, width * channels, dst, width * channels,
+      channels, 0, 0, height);
+
+  same = vvas_xdewarp_camera_is_identity (&cam) &&
+      !memcmp (src, dst, width * height * channels);
+  if (!same)
+    g_printerr ("identity: frame not copied\n");
+
+  vvas_xdewarp_map_clear (&map);
+  g_free (dst);
+  g_free (src);
+
+  return same;
+}
+
+/**
+ *  @fn static gboolean check_bands (void)
+ *  @return TRUE if remapping in bands gives the output of a single pass
+ */
+static gboolean
+check_bands (void)
+{
+  const CheckCase *test = &check_cases[0];
+  guint width = test->width, height = test->height;
+  guint8 *src = g_new (guint8, width * height);
+  guint8 *ref = g_new (guint8, width * height);
+  guint8 *dst = g_new (guint8, width * height);
+  VvasXDewarpCamera cam;
+  VvasXDewarpMap map;
+  guint i, first = 0;
+  gboolean same;
+
+  for (i = 0; i < width * height; i++)
+    src[i] = (i * 31 + i / 7) & 0xff;
+
+  check_camera (test, &cam);
+  vvas_xdewarp_map_init (&map, &cam, width, height);
+  vvas_xdewarp_remap (&map, src, width, ref, width, 1, 16, 0, height);
+  for (i = 0; i < CHECK_BANDS; i++) {
+    guint last = (i + 1) * height / CHECK_BANDS;
+
+    vvas_xdewarp_remap (&map, src, width, dst, width, 1, 16, first,
+        last - first);
+    first = last;
+  }
+
+  same = !memcmp (ref, dst, width * height);
+  if (!same)
+    g_printerr ("bands: output differs from single pass\n");
+
+  vvas_xdewarp_map_clear (&map);
+  g_free (dst);
+  g_free (ref);
+  g_free (src);
+
+  return same;
+}
+
+/**
+ *  @fn static void bench_remap (void)
+ *  @return None
+ *  @brief  Times map computation and remap of a 1080p luma plane
+ */
+static void
+bench_remap (void)
+{
+  guint8 *src = g_new (guint8, BENCH_WIDTH * BENCH_HEIGHT);
+  guint8 *dst = g_new (guint8, BENCH_WIDTH * BENCH_HEIGHT);
+  CheckCase test = { "bench", BENCH_WIDTH, BENCH_HEIGHT, 0.6, {-0.3, 0.09} };
+  VvasXDewarpCamera cam;
+  VvasXDewarpMap map;
+  gint64 start, map_us, remap_us = 0;
+  guint i;
+
+  for (i = 0; i < BENCH_WIDTH * BENCH_HEIGHT; i++)
+    src[i] = i & 0xff;
+
+  check_camera (&test, &cam);
+  start = g_get_monotonic_time ();
+  vvas_xdewarp_map_init (&map, &cam, BENCH_WIDTH, BENCH_HEIGHT);
+  map_us = g_get_monotonic_time () - start;
+
+  for (i = 0; i < BENCH_ITERATIONS; i++) {
+    start = g_get_monotonic_time ();
+    vvas_xdewarp_remap (&map, src, BENCH_WIDTH, dst, BENCH_WIDTH, 1, 16, 0,
+        BENCH_HEIGHT);
+    remap_us += g_get_monotonic_time () - start;
+  }
+
+  printf ("{\"benchmark\": \"dewarp\", \"case\": \"bench\", \"width\": %u, "
+      "\"height\": %u, \"map_init_us\": %" G_GINT64_FORMAT ", "
+      "\"remap_us\": %.2f}\n", BENCH_WIDTH, BENCH_HEIGHT, map_us,
+      (gdouble) remap_us / BENCH_ITERATIONS);
+
+  vvas_xdewarp_map_clear (&map);
+  g_free (dst);
+  g_free (src);
+}
+
+int
+main (int argc, char *argv[])
+{
+  guint i, failed = 0;
+
+  /* Only timed when run as a benchmark */
+  if (argc > 1 && !g_strcmp0 (argv[1], "--bench")) {
+    bench_remap ();
+    return 0;
+  }
+
+  for (i = 0; i < G_N_ELEMENTS (check_cases); i++)
+    if (!check_case (&check_cases[i]))
+      failed++;
+
+  if (!check_identity ())
+    failed++;
+  if (!check_bands ())
+    failed++;
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,377 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * Golden check of the vvas_xfeatures detectors on synthetic frames whose
+ * corners are known by construction: bright squares on a dark background for
+ * FAST, a black and white checkerboard on grey for Harris. After non maximum
+ * suppression every corner must have a keypoint close by and every keypoint
+ * must lie close to a corner. The SIMD FAST path is also compared with the
+ * scalar one on textured frames, keypoints must be identical. With --bench,
+ * both are timed on 1080p instead.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <glib.h>
+#include "vvas_xfeatures_detect.h"
+
+#define CHECK_WIDTH 320
+#define CHECK_HEIGHT 240
+/* Side of the squares of both synthetic frames */
+#define CHECK_SQUARE 32
+/* Distance from a corner within which a keypoint must be found */
+#define CHECK_FOUND_DIST 2
+/* Distance from the nearest corner a keypoint may lie at */
+#define CHECK_STRAY_DIST 3
+#define CHECK_NMS_RADIUS 4
+#define CHECK_FAST_THRESHOLD 20
+#define CHECK_HARRIS_THRESHOLD 1000
+#define BENCH_WIDTH 1920
+#define BENCH_HEIGHT 1080
+#define BENCH_ITERATIONS 20
+
+typedef struct
+{
+  /** Column */
+  gint x;
+  /** Line */
+  gint y;
+} CheckCorner;
+
+/**
+ *  @fn static guint check_squares (guint8 * luma, CheckCorner * corners)
+ *  @param [out] luma - CHECK_WIDTH x CHECK_HEIGHT frame
+ *  @param [out] corners - Corners of the squares
+ *  @return Number of corners
+ *  @brief  Separate bright squares on a dark background. A FAST corner lies
+ *          on the corner pixel of a square.
+ */
+static guint
+check_squares (guint8 * luma, CheckCorner * corners)
+{
+  guint n = 0, y, sx, sy;
+
+  memset (luma, 40, CHECK_WIDTH * CHECK_HEIGHT);
+  for (sy = 24; sy + CHECK_SQUARE < CHECK_HEIGHT; sy += 2 * CHECK_SQUARE) {
+    for (sx = 24; sx + CHECK_SQUARE < CHECK_WIDTH; sx += 2 * CHECK_SQUARE) {
+      for (y = sy; y < sy + CHECK_SQUARE; y++)
+        memset (luma + y * CHECK_WIDTH + sx, 200, CHECK_SQUARE);
+
+      corners[n++] = (CheckCorner) {
+      sx, sy};
+      corners[n++] = (CheckCorner) {
+      sx + CHECK_SQUARE - 1, sy};
+      corners[n++] = (CheckCorner) {
+      sx, sy + CHECK_SQUARE - 1};
+      corners[n++] = (CheckCorner) {
+      sx + CHECK_SQUARE - 1, sy + CHECK_SQUARE - 1};
+    }
+  }
+
+  return n;
+}
+
+/**
+ *  @fn static guint check_checkerboard (guint8 * luma, CheckCorner * corners)
+ *  @param [out] luma - CHECK_WIDTH x CHECK_HEIGHT frame
+ *  @param [out] corners - Vertices of the board
+ *  @return Number of vertices
+ *  @brief  6 x 4 squares on a grey background. Harris responds at the
+ *          crossings inside the board as well as at the junctions of its
+ *          border, all vertices are corners.
+ */
+static guint
+check_checkerboard (guint8 * luma, CheckCorner * corners)
+{
+  const guint cols = 6, rows = 4, ox = 64, oy = 56;
+  guint n = 0, x, y;
+
+  memset (luma, 128, CHECK_WIDTH * CHECK_HEIGHT);
+  for (y = 0; y < rows * CHECK_SQUARE; y++)
+    for (x = 0; x < cols * CHECK_SQUARE; x++)
+      luma[(oy + y) * CHECK_WIDTH + ox + x] =
+          ((x / CHECK_SQUARE + y / CHECK_SQUARE) & 1) ? 230 : 20;
+
+  for (y = 0; y <= rows; y++) {
+    for (x = 0; x <= cols; x++) {
+      corners[n++] = (CheckCorner) {
+      ox + x * CHECK_SQUARE, oy + y * CHECK_SQUARE};
+    }
+  }
+
+  return n;
+}
+
+/**
+ *  @fn static gboolean check_geometry (const gchar * name,
+ *                                      const VvasXFeaturesPoints * pts,
+ *                                      const CheckCorner * corners, guint num)
+ *  @param [in] name - Case name for error messages
+ *  @param [in] pts - Detected keypoints
+ *  @param [in] corners - Corners of the synthetic frame
+ *  @param [in] num - Number of corners
+ *  @return TRUE if every corner was found and no keypoint is stray
+ */
+static gboolean
+check_geometry (const gchar * name, const VvasXFeaturesPoints * pts,
+    const CheckCorner * corners, guint num)
+{
+  gboolean ok = TRUE;
+  guint i, c;
+
+  for (c = 0; c < num; c++) {
+    for (i = 0; i < pts->len; i++) {
+      if (ABS ((gint) pts->points[i].x - corners[c].x) <= CHECK_FOUND_DIST &&
+          ABS ((gint) pts->points[i].y - corners[c].y) <= CHECK_FOUND_DIST)
+        break;
+    }
+    if (i == pts->len) {
+      g_printerr ("%s: corner (%d, %d) not found\n", name, corners[c].x,
+          corners[c].y);
+      ok = FALSE;
+    }
+  }
+
+  for (i = 0; i < pts->len; i++) {
+    for (c = 0; c < num; c++) {
+      if (ABS ((gint) pts->points[i].x - corners[c].x) <= CHECK_STRAY_DIST &&
+          ABS ((gint) pts->points[i].y - corners[c].y) <= CHECK_STRAY_DIST)
+        break;
+    }
+    if (c == num) {
+      g_printerr ("%s: keypoint (%u, %u) is not a corner\n", name,
+          pts->points[i].x, pts->points[i].y);
+      ok = FALSE;
+    }
+  }
+
+  return ok;
+}
+
+/**
+ *  @fn static void check_texture (guint8 * luma, guint width, guint height,
+ *                                 guint stride, GRand * rand)
+ *  @param [out] luma - Frame to fill
+ *  @param [in] width - Frame width
+ *  @param [in] height - Frame height
+ *  @param [in] stride - Line stride
+ *  @param [in] rand - Random numbers
+ *  @return None
+ *  @brief  Random blobs with noise, a few percent of the pixels pass the
+ *          compass test, as on natural images
+ */
+static void
+check_texture (guint8 * luma, guint width, guint height, guint stride,
+    GRand * rand)
+{
+  guint x, y, i;
+
+  for (y = 0; y < height; y++)
+    for (x = 0; x < width; x++)
+      luma[y * stride + x] = 100 + g_rand_int_range (rand, 0, 8);
+
+  for (i = 0; i < width * height / 2000; i++) {
+    guint bw = g_rand_int_range (rand, 2, 24);
+    guint bh = g_rand_int_range (rand, 2, 24);
+    guint bx = g_rand_int_range (rand, 0, width - bw);
+    guint by = g_rand_int_range (rand, 0, height - bh);
+    guint8 v = g_rand_int_range (rand, 0, 256);
+
+    for (y = by; y < by + bh; y++)
+      memset (luma + y * stride + bx, v, bw);
+  }
+}
+
+/**
+ *  @fn static gboolean check_simd (GRand * rand, guint width, guint height,
+ *                                  guint stride, guint8 threshold)
+ *  @param [in] rand - Random numbers
+ *  @param [in] width - Frame width
+ *  @param [in] height - Frame height
+ *  @param [in] stride - Line stride
+ *  @param [in] threshold - FAST threshold
+ *  @return TRUE if the SIMD and scalar keypoints are identical
+ */
+static gboolean
+check_simd (GRand * rand, guint width, guint height, guint stride,
+    guint8 threshold)
+{
+  guint8 *luma = g_new (guint8, (gsize) stride * height);
+  VvasXFeaturesPoints ref, pts;
+  gboolean same;
+
+  vvas_xfeatures_points_init (&ref);
+  vvas_xfeatures_points_init (&pts);
+  check_texture (luma, width, height, stride, rand);
+
+  vvas_xfeatures_fast_scalar (luma, width, height, stride, threshold, &ref);
+  vvas_xfeatures_fast (luma, width, height, stride, threshold, &pts);
+
+  same = ref.len == pts.len && (!ref.len ||
+      !memcmp (ref.points, pts.points, ref.len * sizeof (*ref.points)));
+  if (!same)
+    g_printerr ("fast %ux%u threshold %u: %s found %u keypoints, scalar %u\n",
+        width, height, threshold, vvas_xfeatures_impl (), pts.len, ref.len);
+
+  vvas_xfeatures_points_clear (&ref);
+  vvas_xfeatures_points_clear (&pts);
+  g_free (luma);
+
+  return same;
+}
+
+/**
+ *  @fn static void bench_fast (GRand * rand, gdouble * scalar_us,
+ *                              gdouble * simd_us, guint * keypoints)
+ *  @param [in] rand - Random numbers
+ *  @param [out] scalar_us - Mean time of the scalar FAST
+ *  @param [out] simd_us - Mean time of vvas_xfeatures_fast()
+ *  @param [out] keypoints - Keypoints found
+ *  @return None
+ */
+static void
+bench_fast (GRand * rand, gdouble * scalar_us, gdouble * simd_us,
+    guint * keypoints)
+{
+  guint8 *luma = g_new (guint8, BENCH_WIDTH * BENCH_HEIGHT);
+  VvasXFeaturesPoints pts;
+  gint64 scalar = 0, simd = 0;
+  guint i;
+
+  vvas_xfeatures_points_init (&pts);
+  check_texture (luma, BENCH_WIDTH, BENCH_HEIGHT, BENCH_WIDTH, rand);
+
+  for (i = 0; i < BENCH_ITERATIONS; i++) {
+    gint64 start = g_get_monotonic_time ();
+
+    vvas_xfeatures_fast_scalar (luma, BENCH_WIDTH, BENCH_HEIGHT, BENCH_WIDTH,
+        CHECK_FAST_THRESHOLD, &pts);
+    scalar += g_get_monotonic_time () - start;
+
+    start = g_get_monotonic_time ();
+    vvas_xfeatures_fast (luma, BENCH_WIDTH, BENCH_HEIGHT, BENCH_WIDTH,
+        CHECK_FAST_THRESHOLD, &pts);
+    simd += g_get_monotonic_time () - start;
+  }
+
+  *scalar_us = (gdouble) scalar / BENCH_ITERATIONS;
+  *simd_us = (gdouble) simd / BENCH_ITERATIONS;
+  *keypoints = pts.len;
+
+  vvas_xfeatures_points_clear (&pts);
+  g_free (luma);
+}
+
+int
+main (int argc, char *argv[])
+{
+  /* Widths not multiple of the vector size exercise the scalar tails */
+  static const guint sizes[][3] = {
+    {64, 48, 64}, {333, 101, 352}, {640, 480, 640}, {1921, 37, 1984}
+  };
+  static const guint8 thresholds[] = { 1, 10, 20, 60, 250 };
+  CheckCorner corners[256], first, last;
+  VvasXFeaturesScratch scratch;
+  VvasXFeaturesPoints pts;
+  guint8 *luma;
+  GRand *rand;
+  guint i, t, num, checked = 0, failed = 0, fast_keypoints = 0,
+      harris_keypoints = 0;
+  gboolean ok;
+
+  rand = g_rand_new_with_seed (0xfea7);
+
+  /* Only timed when run as a benchmark */
+  if (argc > 1 && !g_strcmp0 (argv[1], "--bench")) {
+    gdouble scalar_us, simd_us;
+    guint bench_keypoints;
+
+    bench_fast (rand, &scalar_us, &simd_us, &bench_keypoints);
+    printf ("{\"benchmark\": \"features\", \"impl\": \"%s\", "
+        "\"width\": %u, \"height\": %u, \"keypoints\": %u, "
+        "\"scalar_us\": %.2f, \"simd_us\": %.2f, \"speedup\": %.2f}\n",
+        vvas_xfeatures_impl (), BENCH_WIDTH, BENCH_HEIGHT, bench_keypoints,
+        scalar_us, simd_us, simd_us > 0 ? scalar_us / simd_us : 0.0);
+    g_rand_free (rand);
+    return 0;
+  }
+
+  luma = g_new (guint8, CHECK_WIDTH * CHECK_HEIGHT);
+  vvas_xfeatures_points_init (&pts);
+  vvas_xfeatures_scratch_init (&scratch, CHECK_WIDTH, CHECK_HEIGHT);
+
+  num = check_squares (luma, corners);
+  vvas_xfeatures_fast (luma, CHECK_WIDTH, CHECK_HEIGHT, CHECK_WIDTH,
+      CHECK_FAST_THRESHOLD, &pts);
+  vvas_xfeatures_nms (&pts, CHECK_NMS_RADIUS, &scratch);
+  fast_keypoints = pts.len;
+  if (!check_geometry ("fast-squares", &pts, corners, num))
+    failed++;
+  checked++;
+
+  num = check_checkerboard (luma, corners);
+  vvas_xfeatures_harris (luma, CHECK_WIDTH, CHECK_HEIGHT, CHECK_WIDTH,
+      CHECK_HARRIS_THRESHOLD, &scratch, &pts);
+  vvas_xfeatures_nms (&pts, CHECK_NMS_RADIUS, &scratch);
+  harris_keypoints = pts.len;
+  if (!check_geometry ("harris-checkerboard", &pts, corners, num))
+    failed++;
+  checked++;
+
+  /* The strongest corners of the board are its inner crossings */
+  first = corners[0];
+  last = corners[num - 1];
+  for (i = 0, t = 0; i < num; i++) {
+    if (corners[i].x > first.x && corners[i].x < last.x &&
+        corners[i].y > first.y && corners[i].y < last.y)
+      corners[t++] = corners[i];
+  }
+  vvas_xfeatures_keep_strongest (&pts, t);
+  if (pts.len != t || !check_geometry ("harris-strongest", &pts, corners, t))
+    failed++;
+  checked++;
+
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+    for (t = 0; t < G_N_ELEMENTS (thresholds); t++) {
+      if (!check_simd (rand, sizes[i][0], sizes[i][1], sizes[i][2],
+              thresholds[t]))
+        failed++;
+      checked++;
+    }
+  }
+
+  vvas_xfeatures_scratch_clear (&scratch);
+  vvas_xfeatures_points_clear (&pts);
+  g_free (luma);
+  g_rand_free (rand);
+
+  ok = !failed;
+  printf ("{\"benchmark\": \"features\", \"impl\": \"%s\", \"status\": \"%s\", "
+      "\"cases\": %u, \"failed\": %u, \"fast_keypoints\": %u, "
+      "\"harris_keypoints\": %u}\n", vvas_xfeatures_impl (),
+      ok ? "ok" : "failed", checked, failed, fast_keypoints,
+      harris_keypoints);
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * Functional check of the frame statistics. The CPU reference,
+ * gst_vvas_frame_stats_compute(), is compared with v_frame_stats() of the
+ * image_processing kernel on synthetic test vectors. The frame is walked as
+ * the kernel's multi-pixel stream, every sample goes through the per sample
+ * steps of the kernel from v_frame_stats.h: one histogram bank per sample
+ * with the same short update window, block columns and rows found by edge
+ * counters instead of divisions. Histograms and block means must be
+ * identical.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include <gst/vvas/gstvvasframestatsmeta.h>
+#include "v_frame_stats.h"
+
+#define MODEL_MAX_SAMPLES 4
+
+G_STATIC_ASSERT (FRAME_STATS_WORDS == GST_VVAS_FRAME_STATS_WORDS);
+G_STATIC_ASSERT (FRAME_STATS_BINS == GST_VVAS_FRAME_STATS_BINS);
+G_STATIC_ASSERT (FRAME_STATS_BLOCKS_X == GST_VVAS_FRAME_STATS_BLOCKS_X);
+G_STATIC_ASSERT (FRAME_STATS_BLOCKS_Y == GST_VVAS_FRAME_STATS_BLOCKS_Y);
+
+typedef enum
+{
+  VECTOR_RAMP,
+  VECTOR_CHECKERBOARD,
+  VECTOR_RANDOM,
+  VECTOR_FLAT_BLACK,
+  VECTOR_FLAT_WHITE,
+} CheckVector;
+
+typedef struct
+{
+  /** Name printed in the result */
+  const gchar *name;
+  /** Content of the frame */
+  CheckVector vector;
+  /** Frame format */
+  GstVideoFormat format;
+  /** Frame width, multiple of the samples per clock and at least 64 */
+  guint width;
+  /** Frame height */
+  guint height;
+} CheckCase;
+
+static const CheckCase check_cases[] = {
+  {"ramp-gray8", VECTOR_RAMP, GST_VIDEO_FORMAT_GRAY8, 64, 64},
+  {"checkerboard-nv12", VECTOR_CHECKERBOARD, GST_VIDEO_FORMAT_NV12, 1920,
+      1080},
+  {"random-i420", VECTOR_RANDOM, GST_VIDEO_FORMAT_I420, 352, 288},
+  {"random-rgb", VECTOR_RANDOM, GST_VIDEO_FORMAT_RGB, 320, 240},
+  {"ramp-bgr", VECTOR_RAMP, GST_VIDEO_FORMAT_BGR, 200, 120},
+  {"black-nv16", VECTOR_FLAT_BLACK, GST_VIDEO_FORMAT_NV16, 100, 70},
+  {"white-gray8", VECTOR_FLAT_WHITE, GST_VIDEO_FORMAT_GRAY8, 100, 70},
+};
+
+/**
+ *  @fn static void check_fill (GstVideoFrame * frame, CheckVector vector,
+ *                              GRand * rand)
+ *  @param [in] frame - Mapped frame to fill, plane 0 only
+ *  @param [in] vector - Content
+ *  @param [in] rand - Random numbers for VECTOR_RANDOM
+ *  @return None
+ */
+static void
+check_fill (GstVideoFrame * frame, CheckVector vector, GRand * rand)
+{
+  guint8 *line = GST_VIDEO_FRAME_PLANE_DATA (frame, 0);
+  guint stride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0);
+  guint bytes = GST_VIDEO_FRAME_COMP_PSTRIDE (frame, 0) *
+      GST_VIDEO_FRAME_WIDTH (frame);
+  guint x, y;
+
+  for (y = 0; y < GST_VIDEO_FRAME_HEIGHT (frame); y++, line += stride) {
+    for (x = 0; x < bytes; x++) {
+      switch (vector) {
+        case VECTOR_RAMP:
+          line[x] = (x + 3 * y) & 0xff;
+          break;
+        case VECTOR_CHECKERBOARD:
+          line[x] = ((x / 16 + y / 16) & 1) ? 235 : 16;
+          break;
+        case VECTOR_RANDOM:
+          line[x] = g_rand_int_range (rand, 0, 256);
+          break;
+        case VECTOR_FLAT_BLACK:
+          line[x] = 0;
+          break;
+        case VECTOR_FLAT_WHITE:
+          line[x] = 255;
+          break;
+      }
+    }
+  }
+}
+
+/**
+ *  @fn static void check_model (const GstVideoFrame * frame, guint samples,
+ *                               guint32 * words)
+ *  @param [in] frame - Mapped frame, kernel input
+ *  @param [in] samples - Samples per clock of the kernel
+ *  @param [out] words - GST_VVAS_FRAME_STATS_WORDS statistics words
+ *  @return None
+ *  @brief  v_frame_stats() on a frame, the multi-pixel stream of the kernel
+ *          replaced by plane 0 of \p frame
+ */
+static void
+check_model (const GstVideoFrame * frame, guint samples, guint32 * words)
+{
+  static guint hist[MODEL_MAX_SAMPLES][FRAME_STATS_BINS];
+  GstVideoFormat format = GST_VIDEO_FRAME_FORMAT (frame);
+  gboolean rgb = format == GST_VIDEO_FORMAT_RGB ||
+      format == GST_VIDEO_FORMAT_BGR;
+  guint width = GST_VIDEO_FRAME_WIDTH (frame);
+  guint height = GST_VIDEO_FRAME_HEIGHT (frame);
+  guint stride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0);
+  const guint8 *data = GST_VIDEO_FRAME_PLANE_DATA (frame, 0);
+  guint32 *block_sum = words + GST_VVAS_FRAME_STATS_BINS;
+  guint32 line_sum[FRAME_STATS_BLOCKS_X];
+  guint8 last_bin[MODEL_MAX_SAMPLES][FRAME_STATS_NUM_STATES];
+  guint last_cnt[MODEL_MAX_SAMPLES][FRAME_STATS_NUM_STATES];
+  guint line_edge, col_edge;
+  guint x, y, i, k;
+  guint8 by, bx;
+
+  memset (hist, 0, sizeof (hist));
+  memset (words, 0, GST_VVAS_FRAME_STATS_WORDS * sizeof (guint32));
+  for (k = 0; k < samples; k++)
+    frame_stats_window_init (last_bin[k], last_cnt[k]);
+
+  by = 0;
+  line_edge = height;
+  for (y = 0; y < height; y++) {
+    const guint8 *line = data + y * stride;
+
+    frame_stats_block_step (y, FRAME_STATS_BLOCKS_Y, height, &line_edge, &by);
+    memset (line_sum, 0, sizeof (line_sum));
+
+    bx = 0;
+    col_edge = width;
+    for (x = 0; x < width / samples; x++) {
+      for (k = 0; k < samples; k++) {
+        guint col = x * samples + k;
+        guint bin;
+
+        if (rgb) {
+          /* the kernel stream carries R, G, B for both formats */
+          const guint8 *pix = line + 3 * col;
+          guint r = format == GST_VIDEO_FORMAT_RGB ? pix[0] : pix[2];
+          guint b = format == GST_VIDEO_FORMAT_RGB ? pix[2] : pix[0];
+
+          bin = frame_stats_bin (TRUE, r, pix[1], b, 0);
+        } else {
+          bin = frame_stats_bin (FALSE, line[col], 0, 0, 0);
+        }
+
+        frame_stats_block_step (col, FRAME_STATS_BLOCKS_X, width, &col_edge,
+            &bx);
+        line_sum[bx] += bin;
+
+        frame_stats_count (hist[k], last_bin[k], last_cnt[k], bin);
+      }
+    }
+
+    for (k = 0; k < FRAME_STATS_BLOCKS_X; k++)
+      block_sum[by * FRAME_STATS_BLOCKS_X + k] += line_sum[k];
+  }
+
+  for (i = 0; i < FRAME_STATS_BINS; i++)
+    for (k = 0; k < samples; k++)
+      words[i] += hist[k][i];
+}
+
+/**
+ *  @fn static gboolean check_case (const CheckCase * test, guint samples,
+ *                                  GRand * rand, GstVvasFrameStats * ref)
+ *  @param [in] test - Test vector
+ *  @param [in] samples - Samples per clock of the kernel model
+ *  @param [in] rand - Random numbers
+ *  @param [out] ref - Statistics of the CPU reference
+ *  @return TRUE if the model and the reference are identical
+ */
+static gboolean
+check_case (const CheckCase * test, guint samples, GRand * rand,
+    GstVvasFrameStats * ref)
+{
+  guint32 words[GST_VVAS_FRAME_STATS_WORDS];
+  GstVvasFrameStats model;
+  GstVideoFrame frame;
+  GstVideoInfo info;
+  GstBuffer *buf;
+  gboolean ok;
+
+  gst_video_info_set_format (&info, test->format, test->width, test->height);
+  buf = gst_buffer_new_allocate (NULL, GST_VIDEO_INFO_SIZE (&info), NULL);
+  gst_video_frame_map (&frame, &info, buf, GST_MAP_READWRITE);
+  check_fill (&frame, test->vector, rand);
+
+  gst_vvas_frame_stats_compute (ref, &frame);
+  check_model (&frame, samples, words);
+  gst_vvas_frame_stats_from_words (&model, words, test->width, test->height);
+
+  gst_video_frame_unmap (&frame);
+  gst_buffer_unref (buf);
+
+  ok = !memcmp (ref->histogram, model.histogram, sizeof (ref->histogram)) &&
+      !memcmp (ref->block_mean, model.block_mean, sizeof (ref->block_mean));
+  if (!ok)
+    g_printerr ("%s: %u samples per clock, model differs from reference\n",
+        test->name, samples);
+
+  return ok;
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const guint samples[] = { 1, 2, 4 };
+  GstVvasFrameStats ref, black = { 0 };
+  GRand *rand;
+  guint i, s, checked = 0, failed = 0;
+  gdouble same, cut;
+  gboolean ok;
+
+  gst_init (&argc, &argv);
+  rand = g_rand_new_with_seed (0x5eed);
+
+  for (i = 0; i < G_N_ELEMENTS (check_cases); i++) {
+    for (s = 0; s < G_N_ELEMENTS (samples); s++) {
+      if (!check_case (&check_cases[i], samples[s], rand, &ref))
+        failed++;
+      checked++;
+    }
+    if (check_cases[i].vector == VECTOR_FLAT_BLACK)
+      black = ref;
+  }
+
+  /* ref holds the last case, a white frame */
+  same = gst_vvas_frame_stats_distance (&ref, &ref);
+  cut = gst_vvas_frame_stats_distance (&black, &ref);
+  if (same != 0.0 || cut != 1.0) {
+    g_printerr ("histogram distance same %f, black to white %f\n", same, cut);
+    failed++;
+  }
+
+  g_rand_free (rand);
+
+  ok = !failed;
+  printf ("{\"benchmark\": \"frame-stats\", \"status\": \"%s\", "
+      "\"cases\": %u, \"failed\": %u}\n", ok ? "ok" : "failed", checked,
+      failed);
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,840 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * Functional check of the vvas_xgate detectors on synthetic frames
+ * containing or lacking their target pattern.
+ *
+ * Hough: frames with a straight line must get at least a third of its length
+ * in votes whatever its angle, lines between two of the 1 degree angles
+ * spreading their votes over several distances; frames of noise, blobs or a
+ * large circle must stay below the gate threshold, regions must only see
+ * their own lines and votes must match a brute force Hough over whole frame
+ * gradients.
+ *
+ * Haar: a two stage cascade looking for a bright square must find squares of
+ * several sizes at any position and must not fire on flat frames, noise,
+ * edges or thin lines; single windows must get the decision of a brute force
+ * evaluation without integral images and unsupported cascades must be
+ * refused. With --bench, both detectors are timed on 1080p frames instead.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <glib.h>
+#include "vvas_xgate_detect.h"
+
+#define CHECK_WIDTH 640
+#define CHECK_HEIGHT 360
+/* Step edge contrast of 50 */
+#define CHECK_EDGE_THRESHOLD 200
+/* Votes of the element default, frames below are skipped */
+#define CHECK_MIN_VOTES 100
+#define CHECK_LINE_LENGTH 300
+#define CHECK_WINDOWS 400
+#define BENCH_WIDTH 1920
+#define BENCH_HEIGHT 1080
+#define BENCH_ITERATIONS 5
+
+/* Bright square on a darker surround, symmetric top/bottom and left/right */
+static const gchar check_cascade[] =
+    "<?xml version=\"1.0\"?>\n"
+    "<opencv_storage>\n"
+    "<cascade type_id=\"opencv-cascade-classifier\">\n"
+    "  <stageType>BOOST</stageType>\n"
+    "  <featureType>HAAR</featureType>\n"
+    "  <height>24</height>\n"
+    "  <width>24</width>\n"
+    "  <stageParams><maxWeakCount>4</maxWeakCount></stageParams>\n"
+    "  <featureParams><maxCatCount>0</maxCatCount></featureParams>\n"
+    "  <stageNum>2</stageNum>\n"
+    "  <stages>\n"
+    "    <_>\n"
+    "      <maxWeakCount>1</maxWeakCount>\n"
+    "      <stageThreshold>0.</stageThreshold>\n"
+    "      <weakClassifiers>\n"
+    "        <_>\n"
+    "          <internalNodes>0 -1 0 1.</internalNodes>\n"
+    "          <leafValues>-1. 1.</leafValues></_></weakClassifiers></_>\n"
+    "    <_>\n"
+    "      <maxWeakCount>4</maxWeakCount>\n"
+    "      <stageThreshold>0.9</stageThreshold>\n"
+    "      <weakClassifiers>\n"
+    "        <_>\n"
+    "          <internalNodes>0 -1 1 0.3</internalNodes>\n"
+    "          <leafValues>0.25 -0.25</leafValues></_>\n"
+    "        <_>\n"
+    "          <internalNodes>0 -1 2 0.3</internalNodes>\n"
+    "          <leafValues>0.25 -0.25</leafValues></_>\n"
+    "        <_>\n"
+    "          <internalNodes>0 -1 3 0.3</internalNodes>\n"
+    "          <leafValues>0.25 -0.25</leafValues></_>\n"
+    "        <_>\n"
+    "          <internalNodes>0 -1 4 0.3</internalNodes>\n"
+    "          <leafValues>0.25 -0.25</leafValues></_></weakClassifiers></_>\n"
+    "  </stages>\n"
+    "  <features>\n"
+    "    <_>\n"
+    "      <rects>\n"
+    "        <_>0 0 24 24 -1.</_>\n"
+    "        <_>6 6 12 12 4.</_></rects>\n"
+    "      <tilted>0</tilted></_>\n"
+    "    <_>\n"
+    "      <rects>\n"
+    "        <_>0 0 24 12 -1.</_>\n"
+    "        <_>0 12 24 12 1.</_></rects></_>\n"
+    "    <_>\n"
+    "      <rects>\n"
+    "        <_>0 0 24 12 1.</_>\n"
+    "        <_>0 12 24 12 -1.</_></rects></_>\n"
+    "    <_>\n"
+    "      <rects>\n"
+    "        <_>0 0 12 24 -1.</_>\n"
+    "        <_>12 0 12 24 1.</_></rects></_>\n"
+    "    <_>\n"
+    "      <rects>\n"
+    "        <_>0 0 12 24 1.</_>\n"
+    "        <_>12 0 12 24 -1.</_></rects></_>\n"
+    "  </features>\n" "</cascade>\n" "</opencv_storage>\n";
+
+/**
+ *  @brief Synthetic luma frame
+ */
+typedef struct
+{
+  guint width;
+  guint height;
+  guint8 *luma;
+} CheckFrame;
+
+/**
+ *  @fn static void check_frame_init (CheckFrame * frame, guint width,
+ *                                    guint height, guint8 base,
+ *                                    guint noise, guint seed)
+ *  @param [out] frame - Frame
+ *  @param [in] width - Frame width
+ *  @param [in] height - Frame height
+ *  @param [in] base - Mean luma
+ *  @param [in] noise - Largest deviation from \p base
+ *  @param [in] seed - Noise
+ *  @return None
+ */
+static void
+check_frame_init (CheckFrame * frame, guint width, guint height, guint8 base,
+    guint noise, guint seed)
+{
+  GRand *rand = g_rand_new_with_seed (seed);
+  guint i;
+
+  frame->width = width;
+  frame->height = height;
+  frame->luma = g_new (guint8, width * height);
+  for (i = 0; i < width * height; i++)
+    frame->luma[i] = noise ?
+        base + g_rand_int_range (rand, -(gint) noise, noise + 1) : base;
+  g_rand_free (rand);
+}
+
+/**
+ *  @fn static void check_frame_clear (CheckFrame * frame)
+ *  @param [in] frame - Frame
+ *  @return None
+ */
+static void
+check_frame_clear (CheckFrame * frame)
+{
+  g_free (frame->luma);
+  frame->luma = NULL;
+}
+
+/**
+ *  @fn static void check_put (CheckFrame * frame, gint x, gint y,
+ *                             guint8 value)
+ *  @param [in] frame - Frame
+ *  @param [in] x - Column, ignored outside of the frame
+ *  @param [in] y - Line
+ *  @param [in] value - Luma
+ *  @return None
+ */
+static void
+check_put (CheckFrame * frame, gint x, gint y, guint8 value)
+{
+  if (x >= 0 && y >= 0 && x < (gint) frame->width && y < (gint) frame->height)
+    frame->luma[y * frame->width + x] = value;
+}
+
+/**
+ *  @fn static void check_draw_line (CheckFrame * frame, gdouble x0,
+ *                                   gdouble y0, gdouble angle,
+ *                                   guint length, guint8 value)
+ *  @param [in] frame - Frame
+ *  @param [in] x0 - Column of the start
+ *  @param [in] y0 - Line of the start
+ *  @param [in] angle - Direction in degrees
+ *  @param [in] length - Length in pixels
+ *  @param [in] value - Luma of the 3 pixels wide line
+ *  @return None
+ */
+static void
+check_draw_line (CheckFrame * frame, gdouble x0, gdouble y0, gdouble angle,
+    guint length, guint8 value)
+{
+  gdouble dx = cos (angle * G_PI / 180), dy = sin (angle * G_PI / 180);
+  guint i;
+  gint k;
+
+  for (i = 0; i < 4 * length; i++) {
+    gdouble x = x0 + dx * i / 4.0, y = y0 + dy * i / 4.0;
+
+    /* Widened across the line */
+    for (k = -1; k <= 1; k++)
+      check_put (frame, (gint) floor (x - dy * k + 0.5),
+          (gint) floor (y + dx * k + 0.5), value);
+  }
+}
+
+/**
+ *  @fn static void check_draw_disc (CheckFrame * frame, gint cx, gint cy,
+ *                                   gint r, gint thickness, guint8 value)
+ *  @param [in] frame - Frame
+ *  @param [in] cx - Column of the centre
+ *  @param [in] cy - Line of the centre
+ *  @param [in] r - Radius
+ *  @param [in] thickness - Width of the ring, 0 for a disc
+ *  @param [in] value - Luma
+ *  @return None
+ */
+static void
+check_draw_disc (CheckFrame * frame, gint cx, gint cy, gint r,
+    gint thickness, guint8 value)
+{
+  gint x, y;
+
+  for (y = -r; y <= r; y++) {
+    for (x = -r; x <= r; x++) {
+      gint d2 = x * x + y * y;
+
+      if (d2 <= r * r && (!thickness ||
+              d2 >= (r - thickness) * (r - thickness)))
+        check_put (frame, cx + x, cy + y, value);
+    }
+  }
+}
+
+/**
+ *  @fn static void check_draw_rect (CheckFrame * frame, gint x, gint y,
+ *                                   gint w, gint h, guint8 value)
+ *  @param [in] frame - Frame
+ *  @param [in] x - Left
+ *  @param [in] y - Top
+ *  @param [in] w - Width
+ *  @param [in] h - Height
+ *  @param [in] value - Luma
+ *  @return None
+ */
+static void
+check_draw_rect (CheckFrame * frame, gint x, gint y, gint w, gint h,
+    guint8 value)
+{
+  gint i, j;
+
+  for (j = y; j < y + h; j++)
+    for (i = x; i < x + w; i++)
+      check_put (frame, i, j, value);
+}
+
+/**
+ *  @fn static guint check_hough_reference (const CheckFrame * frame,
+ *                                          guint * num_points)
+ *  @param [in] frame - Frame
+ *  @param [out] num_points - Edge points
+ *  @return Votes of the strongest line, computed on whole frame gradients
+ *          with a double precision accumulator of every angle
+ */
+static guint
+check_hough_reference (const CheckFrame * frame, guint * num_points)
+{
+  guint w = frame->width, h = frame->height;
+  guint num_rho = 2 * (w + h) + 1;
+  gint *mag = g_new0 (gint, w * h);
+  gint *gxs = g_new0 (gint, w * h);
+  gint *gys = g_new0 (gint, w * h);
+  guint *acc = g_new0 (guint, num_rho * VVAS_XGATE_HOUGH_THETA_BINS);
+  guint x, y, t, n = 0, max = 0;
+
+  for (y = 1; y + 1 < h; y++) {
+    for (x = 1; x + 1 < w; x++) {
+      const guint8 *p = frame->luma + y * w + x;
+      gint s = w;
+      gint gx = p[-s + 1] + 2 * p[1] + p[s + 1] - p[-s - 1] - 2 * p[-1] -
+          p[s - 1];
+      gint gy = p[s - 1] + 2 * p[s] + p[s + 1] - p[-s - 1] - 2 * p[-s] -
+          p[-s + 1];
+
+      gxs[y * w + x] = ABS (gx);
+      gys[y * w + x] = ABS (gy);
+      mag[y * w + x] = ABS (gx) + ABS (gy);
+    }
+  }
+
+  for (y = 1; y + 1 < h; y++) {
+    for (x = 1; x + 1 < w; x++) {
+      gint m = mag[y * w + x];
+      gboolean keep;
+
+      if (m < CHECK_EDGE_THRESHOLD)
+        continue;
+      if (gxs[y * w + x] >= gys[y * w + x])
+        keep = m >= mag[y * w + x - 1] && m > mag[y * w + x + 1];
+      else
+        keep = m >= mag[(y - 1) * w + x] && m > mag[(y + 1) * w + x];
+      if (!keep)
+        continue;
+
+      n++;
+      /* Distances are rounded as with the Q12 angles of the detector */
+      for (t = 0; t < VVAS_XGATE_HOUGH_THETA_BINS; t++) {
+        gdouble theta = t * G_PI / VVAS_XGATE_HOUGH_THETA_BINS;
+        gint rho = (gint) floor ((x * lround (cos (theta) * 4096) +
+                y * lround (sin (theta) * 4096)) / 4096.0 + 0.5);
+        guint v = ++acc[t * num_rho + rho + w + h];
+
+        max = MAX (max, v);
+      }
+    }
+  }
+
+  g_free (mag);
+  g_free (gxs);
+  g_free (gys);
+  g_free (acc);
+  *num_points = n;
+
+  return max;
+}
+
+/**
+ *  @fn static gboolean check_hough_case (VvasXGateHough * hough,
+ *                                        const gchar * name,
+ *                                        const CheckFrame * frame,
+ *                                        gboolean has_line)
+ *  @param [in] hough - Detector
+ *  @param [in] name - Case name
+ *  @param [in] frame - Frame
+ *  @param [in] has_line - Whether \p frame holds a CHECK_LINE_LENGTH line
+ *  @return TRUE if the gate decision is right and the votes are the ones of
+ *          the reference
+ */
+static gboolean
+check_hough_case (VvasXGateHough * hough, const gchar * name,
+    const CheckFrame * frame, gboolean has_line)
+{
+  guint points, ref_points, votes, ref_votes, stopped;
+  gboolean ok;
+
+  votes = vvas_xgate_hough_votes (hough, frame->luma, frame->width,
+      frame->width, frame->height, CHECK_EDGE_THRESHOLD, 0, &points);
+  stopped = vvas_xgate_hough_votes (hough, frame->luma, frame->width,
+      frame->width, frame->height, CHECK_EDGE_THRESHOLD, CHECK_MIN_VOTES,
+      NULL);
+  ref_votes = check_hough_reference (frame, &ref_points);
+
+  ok = points == ref_points && votes == ref_votes;
+  if (has_line)
+    ok &= votes >= CHECK_LINE_LENGTH / 3 && stopped >= CHECK_MIN_VOTES &&
+        stopped <= votes;
+  else
+    ok &= votes < CHECK_MIN_VOTES && stopped == votes;
+
+  printf ("{\"benchmark\": \"gate\", \"case\": \"hough-%s\", "
+      "\"edge_points\": %u, \"votes\": %u, \"reference_votes\": %u, "
+      "\"pass\": %s, \"status\": \"%s\"}\n", name, points, votes, ref_votes,
+      votes >= CHECK_MIN_VOTES ? "true" : "false", ok ? "ok" : "failed");
+
+  return ok;
+}
+
+/**
+ *  @fn static gboolean check_hough (void)
+ *  @return TRUE if every Hough case passes
+ */
+static gboolean
+check_hough (void)
+{
+  static const gdouble angles[] = { 0, 90, 35, 62.5, 148 };
+  VvasXGateHough hough;
+  CheckFrame frame;
+  gboolean ok = TRUE;
+  guint i, left, right;
+  gchar name[32];
+
+  vvas_xgate_hough_init (&hough);
+
+  for (i = 0; i < G_N_ELEMENTS (angles); i++) {
+    gdouble a = angles[i] * G_PI / 180;
+
+    check_frame_init (&frame, CHECK_WIDTH, CHECK_HEIGHT, 90, 8, i);
+    check_draw_line (&frame, CHECK_WIDTH / 2 - cos (a) * CHECK_LINE_LENGTH / 2,
+        CHECK_HEIGHT / 2 - sin (a) * CHECK_LINE_LENGTH / 2, angles[i],
+        CHECK_LINE_LENGTH, 170);
+    snprintf (name, sizeof (name), "line-%g", angles[i]);
+    ok &= check_hough_case (&hough, name, &frame, TRUE);
+    check_frame_clear (&frame);
+  }
+
+  check_frame_init (&frame, CHECK_WIDTH, CHECK_HEIGHT, 128, 0, 0);
+  ok &= check_hough_case (&hough, "flat", &frame, FALSE);
+  check_frame_clear (&frame);
+
+  check_frame_init (&frame, CHECK_WIDTH, CHECK_HEIGHT, 128, 20, 10);
+  ok &= check_hough_case (&hough, "noise", &frame, FALSE);
+  check_frame_clear (&frame);
+
+  check_frame_init (&frame, CHECK_WIDTH, CHECK_HEIGHT, 90, 8, 11);
+  {
+    GRand *rand = g_rand_new_with_seed (11);
+
+    for (i = 0; i < 60; i++)
+      check_draw_disc (&frame, g_rand_int_range (rand, 0, CHECK_WIDTH),
+          g_rand_int_range (rand, 0, CHECK_HEIGHT),
+          g_rand_int_range (rand, 3, 13), 0, 180);
+    g_rand_free (rand);
+  }
+  ok &= check_hough_case (&hough, "blobs", &frame, FALSE);
+  check_frame_clear (&frame);
+
+  check_frame_init (&frame, CHECK_WIDTH, CHECK_HEIGHT, 90, 8, 12);
+  check_draw_disc (&frame, CHECK_WIDTH / 2, CHECK_HEIGHT / 2, 150, 3, 170);
+  ok &= check_hough_case (&hough, "circle", &frame, FALSE);
+  check_frame_clear (&frame);
+
+  /* A region only votes with its own edges */
+  check_frame_init (&frame, CHECK_WIDTH, CHECK_HEIGHT, 90, 8, 13);
+  check_draw_line (&frame, 40, 60, 75, CHECK_LINE_LENGTH / 2 + 50, 170);
+  left = vvas_xgate_hough_votes (&hough, frame.luma, frame.width,
+      CHECK_WIDTH / 2, CHECK_HEIGHT, CHECK_EDGE_THRESHOLD, 0, NULL);
+  right = vvas_xgate_hough_votes (&hough,
+      frame.luma + CHECK_WIDTH / 2, frame.width, CHECK_WIDTH / 2,
+      CHECK_HEIGHT, CHECK_EDGE_THRESHOLD, 0, NULL);
+  check_frame_clear (&frame);
+  printf ("{\"benchmark\": \"gate\", \"case\": \"hough-region\", "
+      "\"line_votes\": %u, \"other_votes\": %u, \"status\": \"%s\"}\n",
+      left, right, left >= CHECK_MIN_VOTES && right < CHECK_MIN_VOTES / 4 ?
+      "ok" : "failed");
+  ok &= left >= CHECK_MIN_VOTES && right < CHECK_MIN_VOTES / 4;
+
+  vvas_xgate_hough_clear (&hough);
+
+  return ok;
+}
+
+/**
+ *  @fn static gdouble check_rect_sum (const CheckFrame * frame, guint x0,
+ *                                     guint y0, gint x, gint y, gint w,
+ *                                     gint h)
+ *  @param [in] frame - Frame
+ *  @param [in] x0 - Left of the window
+ *  @param [in] y0 - Top of the window
+ *  @param [in] x - Left of the rectangle in the window
+ *  @param [in] y - Top of the rectangle in the window
+ *  @param [in] w - Width
+ *  @param [in] h - Height
+ *  @return Sum of the pixels of the rectangle
+ */
+static gdouble
+check_rect_sum (const CheckFrame * frame, guint x0, guint y0, gint x, gint y,
+    gint w, gint h)
+{
+  gdouble sum = 0;
+  gint i, j;
+
+  for (j = y; j < y + h; j++)
+    for (i = x; i < x + w; i++)
+      sum += frame->luma[(y0 + j) * frame->width + x0 + i];
+
+  return sum;
+}
+
+/**
+ *  @fn static gboolean check_haar_reference (const VvasXGateHaarCascade *
+ *                                            cascade,
+ *                                            const CheckFrame * frame,
+ *                                            gdouble scale, gdouble * margin)
+ *  @param [in] cascade - Cascade
+ *  @param [in] frame - Frame of one window at \p scale
+ *  @param [in] scale - Window size over the cascade window size
+ *  @param [out] margin - Smallest distance of a value to its threshold
+ *  @return TRUE if the window passes the cascade, evaluated with direct sums
+ */
+static gboolean
+check_haar_reference (const VvasXGateHaarCascade * cascade,
+    const CheckFrame * frame, gdouble scale, gdouble * margin)
+{
+  gint win_w = (gint) (cascade->width * scale + 0.5);
+  gint win_h = (gint) (cascade->height * scale + 0.5);
+  gint edge = (gint) (scale + 0.5);
+  gint equ_w = (gint) ((cascade->width - 2) * scale + 0.5);
+  gint equ_h = (gint) ((cascade->height - 2) * scale + 0.5);
+  gdouble area = equ_w * equ_h;
+  gdouble sum = check_rect_sum (frame, 0, 0, edge, edge, equ_w, equ_h);
+  gdouble sq = 0, var, norm;
+  guint s, i, k;
+  gint x, y;
+
+  for (y = edge; y < edge + equ_h; y++)
+    for (x = edge; x < edge + equ_w; x++)
+      sq += frame->luma[y * frame->width + x] *
+          frame->luma[y * frame->width + x];
+  /* Area squared times the variance, exact for these window sizes */
+  var = area * sq - sum * sum;
+  norm = var > 0 ? sqrt (var) / area : 1.0;
+  *margin = G_MAXDOUBLE;
+
+  for (s = 0; s < cascade->num_stages; s++) {
+    const VvasXGateHaarStage *stage = &cascade->stages[s];
+    gdouble stage_sum = 0;
+
+    for (i = stage->first; i < stage->first + stage->count; i++) {
+      const VvasXGateHaarStump *stump = &cascade->stumps[i];
+      const VvasXGateHaarFeature *feature =
+          &cascade->features[stump->feature];
+      gdouble value = 0, area0 = 0, sum0 = 0, rect0 = 0;
+
+      for (k = 0; k < feature->num_rects; k++) {
+        const VvasXGateHaarRect *r = &feature->rects[k];
+        gint rx = (gint) (r->x * scale + 0.5);
+        gint ry = (gint) (r->y * scale + 0.5);
+        gint rw = MIN ((gint) (r->w * scale + 0.5), win_w - rx);
+        gint rh = MIN ((gint) (r->h * scale + 0.5), win_h - ry);
+        gdouble sum = check_rect_sum (frame, 0, 0, rx, ry, rw, rh);
+
+        if (!k) {
+          area0 = rw * rh;
+          rect0 = sum;
+        } else {
+          sum0 += r->weight * rw * rh;
+          value += r->weight * sum;
+        }
+      }
+      /* Balanced features stay balanced at any scale */
+      value += (feature->num_rects > 1 ? -sum0 / area0 :
+          feature->rects[0].weight) * rect0;
+      value /= area;
+
+      *margin = MIN (*margin, fabs (value - stump->threshold * norm));
+      stage_sum += value < stump->threshold * norm ? stump->left :
+          stump->right;
+    }
+
+    *margin = MIN (*margin, fabs (stage_sum - stage->threshold));
+    if (stage_sum < stage->threshold - 0.0001)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ *  @fn static gboolean check_haar_windows (VvasXGateHaar * haar,
+ *                                          const VvasXGateHaarCascade *
+ *                                          cascade, gdouble scale)
+ *  @param [in] haar - Detector
+ *  @param [in] cascade - Cascade
+ *  @param [in] scale - Window size over the cascade window size
+ *  @return TRUE if single windows of random squares get the decision of
+ *          check_haar_reference()
+ */
+static gboolean
+check_haar_windows (VvasXGateHaar * haar,
+    const VvasXGateHaarCascade * cascade, gdouble scale)
+{
+  guint size = (guint) (cascade->width * scale + 0.5);
+  /* Scale the detector starts at for a window of size */
+  gdouble size_scale = (gdouble) size / cascade->width;
+  GRand *rand = g_rand_new_with_seed ((guint) (scale * 100));
+  guint i, passed = 0, compared = 0, mismatches = 0;
+  gboolean ok;
+
+  for (i = 0; i < CHECK_WINDOWS; i++) {
+    CheckFrame frame;
+    gint sq = g_rand_int_range (rand, size / 4, size * 3 / 4);
+    gboolean found, expected;
+    gdouble margin;
+
+    check_frame_init (&frame, size, size, g_rand_int_range (rand, 40, 120),
+        g_rand_int_range (rand, 0, 30), i);
+    check_draw_rect (&frame, (size - sq) / 2 + g_rand_int_range (rand, -3, 4),
+        (size - sq) / 2 + g_rand_int_range (rand, -3, 4), sq, sq,
+        g_rand_int_range (rand, 60, 250));
+    found = vvas_xgate_haar_detect (haar, cascade, frame.luma, size, size,
+        size, size, 1.25, NULL);
+    expected = check_haar_reference (cascade, &frame, size_scale, &margin);
+    check_frame_clear (&frame);
+
+    /* Rounding of float weights may flip values on their threshold */
+    if (margin < 1e-3)
+      continue;
+    compared++;
+    passed += expected;
+    mismatches += found != expected;
+  }
+  g_rand_free (rand);
+
+  /* Both decisions must be exercised */
+  ok = !mismatches && passed > compared / 10 &&
+      passed < compared - compared / 10;
+  printf ("{\"benchmark\": \"gate\", \"case\": \"haar-windows\", "
+      "\"scale\": %.2f, \"compared\": %u, \"passed\": %u, "
+      "\"mismatches\": %u, \"status\": \"%s\"}\n", scale, compared, passed,
+      mismatches, ok ? "ok" : "failed");
+
+  return ok;
+}
+
+/**
+ *  @fn static gboolean check_haar_case (VvasXGateHaar * haar,
+ *                                       const VvasXGateHaarCascade * cascade,
+ *                                       const gchar * name,
+ *                                       const CheckFrame * frame,
+ *                                       gboolean has_square)
+ *  @param [in] haar - Detector
+ *  @param [in] cascade - Cascade
+ *  @param [in] name - Case name
+ *  @param [in] frame - Frame
+ *  @param [in] has_square - Whether \p frame holds a bright square
+ *  @return TRUE if the gate decision is right
+ */
+static gboolean
+check_haar_case (VvasXGateHaar * haar, const VvasXGateHaarCascade * cascade,
+    const gchar * name, const CheckFrame * frame, gboolean has_square)
+{
+  guint windows;
+  gboolean found = vvas_xgate_haar_detect (haar, cascade, frame->luma,
+      frame->width, frame->width, frame->height, 24, 1.25, &windows);
+
+  printf ("{\"benchmark\": \"gate\", \"case\": \"haar-%s\", "
+      "\"windows\": %u, \"pass\": %s, \"status\": \"%s\"}\n", name, windows,
+      found ? "true" : "false", found == has_square ? "ok" : "failed");
+
+  return found == has_square;
+}
+
+/**
+ *  @fn static gboolean check_haar_parse_error (const gchar * name,
+ *                                              const gchar * from,
+ *                                              const gchar * to)
+ *  @param [in] name - Case name
+ *  @param [in] from - Part of check_cascade replaced
+ *  @param [in] to - Replacement making the cascade unsupported
+ *  @return TRUE if parsing the modified cascade fails with an error
+ */
+static gboolean
+check_haar_parse_error (const gchar * name, const gchar * from,
+    const gchar * to)
+{
+  const gchar *at = strstr (check_cascade, from);
+  VvasXGateHaarCascade cascade;
+  GError *error = NULL;
+  gboolean ok;
+  gchar *xml;
+
+  if (!at)
+    return FALSE;
+  xml = g_new (gchar, sizeof (check_cascade) + strlen (to));
+  memcpy (xml, check_cascade, at - check_cascade);
+  strcpy (xml + (at - check_cascade), to);
+  strcat (xml, at + strlen (from));
+
+  ok = !vvas_xgate_haar_cascade_parse (&cascade, xml, -1, &error) && error;
+  printf ("{\"benchmark\": \"gate\", \"case\": \"haar-refuse-%s\", "
+      "\"error\": \"%s\", \"status\": \"%s\"}\n", name,
+      error ? error->message : "", ok ? "ok" : "failed");
+  if (!ok && !error)
+    vvas_xgate_haar_cascade_clear (&cascade);
+  g_clear_error (&error);
+  g_free (xml);
+
+  return ok;
+}
+
+/**
+ *  @fn static gboolean check_haar (void)
+ *  @return TRUE if every Haar case passes
+ */
+static gboolean
+check_haar (void)
+{
+  static const gint squares[][3] = { {101, 57, 12}, {400, 201, 18},
+  {13, 290, 30}, {500, 40, 47}
+  };
+  VvasXGateHaarCascade cascade;
+  VvasXGateHaar haar;
+  CheckFrame frame;
+  GError *error = NULL;
+  gboolean ok = TRUE;
+  gchar name[32];
+  guint i;
+
+  if (!vvas_xgate_haar_cascade_parse (&cascade, check_cascade, -1, &error)) {
+    printf ("{\"benchmark\": \"gate\", \"case\": \"haar-parse\", "
+        "\"error\": \"%s\", \"status\": \"failed\"}\n", error->message);
+    g_error_free (error);
+    return FALSE;
+  }
+  ok = cascade.width == 24 && cascade.height == 24 &&
+      cascade.num_stages == 2 && cascade.num_stumps == 5 &&
+      cascade.num_features == 5 && cascade.features[0].num_rects == 2 &&
+      cascade.features[0].rects[1].weight == 4.0f &&
+      cascade.stumps[4].feature == 4 && cascade.stages[1].first == 1;
+  printf ("{\"benchmark\": \"gate\", \"case\": \"haar-parse\", "
+      "\"stages\": %u, \"stumps\": %u, \"features\": %u, \"status\": \"%s\"}\n",
+      cascade.num_stages, cascade.num_stumps, cascade.num_features,
+      ok ? "ok" : "failed");
+
+  vvas_xgate_haar_init (&haar);
+
+  ok &= check_haar_windows (&haar, &cascade, 1.0);
+  ok &= check_haar_windows (&haar, &cascade, 2.0);
+  ok &= check_haar_windows (&haar, &cascade, 2.7);
+
+  for (i = 0; i < G_N_ELEMENTS (squares); i++) {
+    check_frame_init (&frame, CHECK_WIDTH, CHECK_HEIGHT, 90, 8, 20 + i);
+    check_draw_rect (&frame, squares[i][0], squares[i][1], squares[i][2],
+        squares[i][2], 160);
+    snprintf (name, sizeof (name), "square-%d", squares[i][2]);
+    ok &= check_haar_case (&haar, &cascade, name, &frame, TRUE);
+    check_frame_clear (&frame);
+  }
+
+  check_frame_init (&frame, CHECK_WIDTH, CHECK_HEIGHT, 128, 0, 0);
+  ok &= check_haar_case (&haar, &cascade, "flat", &frame, FALSE);
+  check_frame_clear (&frame);
+
+  check_frame_init (&frame, CHECK_WIDTH, CHECK_HEIGHT, 128, 40, 30);
+  ok &= check_haar_case (&haar, &cascade, "noise", &frame, FALSE);
+  check_frame_clear (&frame);
+
+  check_frame_init (&frame, CHECK_WIDTH, CHECK_HEIGHT, 90, 8, 31);
+  check_draw_rect (&frame, CHECK_WIDTH / 2, 0, CHECK_WIDTH / 2, CHECK_HEIGHT,
+      170);
+  ok &= check_haar_case (&haar, &cascade, "edge", &frame, FALSE);
+  check_frame_clear (&frame);
+
+  check_frame_init (&frame, CHECK_WIDTH, CHECK_HEIGHT, 90, 8, 32);
+  check_draw_line (&frame, 20, 30, 28, 600, 170);
+  check_draw_line (&frame, 300, 10, 90, 340, 170);
+  ok &= check_haar_case (&haar, &cascade, "lines", &frame, FALSE);
+  check_frame_clear (&frame);
+
+  /* Too small for a window */
+  check_frame_init (&frame, 20, 20, 90, 0, 0);
+  check_draw_rect (&frame, 5, 5, 10, 10, 160);
+  ok &= check_haar_case (&haar, &cascade, "small", &frame, FALSE);
+  check_frame_clear (&frame);
+
+  vvas_xgate_haar_clear (&haar);
+  vvas_xgate_haar_cascade_clear (&cascade);
+
+  ok &= check_haar_parse_error ("tilted", "<tilted>0</tilted>",
+      "<tilted>1</tilted>");
+  ok &= check_haar_parse_error ("tree", "0 -1 1 0.3", "1 2 1 0.3 0 -1 2 0.1");
+  ok &= check_haar_parse_error ("feature", "0 -1 4 0.3", "0 -1 5 0.3");
+  ok &= check_haar_parse_error ("lbp", "<featureType>HAAR",
+      "<featureType>LBP");
+  ok &= check_haar_parse_error ("outside", "12 0 12 24 1.", "14 0 12 24 1.");
+  ok &= check_haar_parse_error ("truncated", "</cascade>", "");
+
+  return ok;
+}
+
+/**
+ *  @fn static void bench_gate (void)
+ *  @return None
+ *  @brief  Times both detectors on a 1080p frame of dark blobs, no bright
+ *          square and no long line, where they cannot stop early
+ */
+static void
+bench_gate (void)
+{
+  VvasXGateHaarCascade cascade;
+  VvasXGateHaar haar;
+  VvasXGateHough hough;
+  CheckFrame frame;
+  GRand *rand = g_rand_new_with_seed (40);
+  gint64 start, hough_us = 0, haar_us = 0;
+  guint i, votes = 0, points = 0, windows = 0;
+
+  check_frame_init (&frame, BENCH_WIDTH, BENCH_HEIGHT, 160, 8, 40);
+  for (i = 0; i < 400; i++)
+    check_draw_disc (&frame, g_rand_int_range (rand, 0, BENCH_WIDTH),
+        g_rand_int_range (rand, 0, BENCH_HEIGHT),
+        g_rand_int_range (rand, 3, 16), 0, g_rand_int_range (rand, 20, 100));
+  g_rand_free (rand);
+
+  vvas_xgate_hough_init (&hough);
+  vvas_xgate_haar_init (&haar);
+  vvas_xgate_haar_cascade_parse (&cascade, check_cascade, -1, NULL);
+
+  for (i = 0; i < BENCH_ITERATIONS; i++) {
+    start = g_get_monotonic_time ();
+    votes = vvas_xgate_hough_votes (&hough, frame.luma, frame.width,
+        frame.width, frame.height, CHECK_EDGE_THRESHOLD, CHECK_MIN_VOTES,
+        &points);
+    hough_us += g_get_monotonic_time () - start;
+
+    start = g_get_monotonic_time ();
+    vvas_xgate_haar_detect (&haar, &cascade, frame.luma, frame.width,
+        frame.width, frame.height, 24, 1.25, &windows);
+    haar_us += g_get_monotonic_time () - start;
+  }
+
+  printf ("{\"benchmark\": \"gate\", \"case\": \"bench\", \"width\": %u, "
+      "\"height\": %u, \"edge_points\": %u, \"votes\": %u, "
+      "\"hough_us\": %.2f, \"haar_windows\": %u, \"haar_us\": %.2f}\n",
+      BENCH_WIDTH, BENCH_HEIGHT, points, votes,
+      (gdouble) hough_us / BENCH_ITERATIONS, windows,
+      (gdouble) haar_us / BENCH_ITERATIONS);
+
+  vvas_xgate_haar_cascade_clear (&cascade);
+  vvas_xgate_haar_clear (&haar);
+  vvas_xgate_hough_clear (&hough);
+  check_frame_clear (&frame);
+}
+
+int
+main (int argc, char *argv[])
+{
+  guint failed = 0;
+
+  /* Only timed when run as a benchmark */
+  if (argc > 1 && !g_strcmp0 (argv[1], "--bench")) {
+    bench_gate ();
+    return 0;
+  }
+
+  failed += !check_hough ();
+  failed += !check_haar ();
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Check of the coordinate back-projection of vvas_xinfer. The SSE2 or NEON
+ * path must give the same coordinates as the scalar reference on random
+ * batches of every length up to a few vectors, with rounding ties, negative
+ * offsets clamping coordinates to 0 and the largest frame sizes. Known
+ * values, rounded to nearest even, are checked on both. With --bench, both
+ * are timed on a batch of 2^20 coordinates instead.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <glib.h>
+#include "vvas_xinfer_project.h"
+
+#define CHECK_MAX_LEN 67
+#define CHECK_ROUNDS 2000
+#define BENCH_LEN (1 << 20)
+#define BENCH_ITERATIONS 50
+
+/**
+ *  @brief One batch of coordinates of one axis
+ */
+typedef struct
+{
+  /** Coordinates in child resolution */
+  gfloat *coord;
+  /** Scale factors */
+  gfloat *factor;
+  /** Positions of the parent boxes */
+  gint32 *base;
+  /** Offsets */
+  gint32 *offset;
+  /** Result of the scalar reference */
+  gint32 *ref;
+  /** Result of vvas_xinfer_project() */
+  gint32 *out;
+} CheckBatch;
+
+/**
+ *  @fn static void check_batch_init (CheckBatch * batch, guint len)
+ *  @param [out] batch - Batch to allocate
+ *  @param [in] len - Number of coordinates
+ *  @return None
+ */
+static void
+check_batch_init (CheckBatch * batch, guint len)
+{
+  batch->coord = g_new0 (gfloat, len);
+  batch->factor = g_new0 (gfloat, len);
+  batch->base = g_new0 (gint32, len);
+  batch->offset = g_new0 (gint32, len);
+  batch->ref = g_new0 (gint32, len);
+  batch->out = g_new0 (gint32, len);
+}
+
+/**
+ *  @fn static void check_batch_clear (CheckBatch * batch)
+ *  @param [in] batch - Batch to free
+ *  @return None
+ */
+static void
+check_batch_clear (CheckBatch * batch)
+{
+  g_free (batch->coord);
+  g_free (batch->factor);
+  g_free (batch->base);
+  g_free (batch->offset);
+  g_free (batch->ref);
+  g_free (batch->out);
+}
+
+/**
+ *  @fn static void check_batch_fill (CheckBatch * batch, guint len,
+ *                                    GRand * rand)
+ *  @param [inout] batch - Batch to fill
+ *  @param [in] len - Number of coordinates
+ *  @param [in] rand - Random numbers
+ *  @return None
+ *  @brief  Fills a batch with coordinates like those of the element: child
+ *          coordinates up to 4K, factors of usual scaler ratios, a quarter
+ *          of them landing on rounding ties, parent positions and offsets
+ *          of either sign
+ */
+static void
+check_batch_fill (CheckBatch * batch, guint len, GRand * rand)
+{
+  static const gfloat factors[] = {
+    0.25f, 0.5f, 1.0f, 1.5f, 2.0f, 3.0f, 1920.0f / 416, 1080.0f / 416,
+    3840.0f / 640, 0.3333333f
+  };
+  guint i;
+
+  for (i = 0; i < len; i++) {
+    batch->factor[i] = factors[g_rand_int_range (rand, 0,
+            G_N_ELEMENTS (factors))];
+    if (g_rand_int_range (rand, 0, 4) == 0) {
+      /* x.5 products, ties must round to even on both paths */
+      batch->factor[i] = 0.5f;
+      batch->coord[i] = 2 * g_rand_int_range (rand, 0, 4096) + 1;
+    } else {
+      batch->coord[i] = g_rand_double_range (rand, 0, 4096);
+    }
+    batch->base[i] = g_rand_int_range (rand, 0, 4096);
+    batch->offset[i] = g_rand_int_range (rand, -8192, 256);
+  }
+}
+
+/**
+ *  @fn static gboolean check_known (void)
+ *  @return TRUE when both paths give the expected coordinates
+ *  @brief  Checks values whose projection is known
+ */
+static gboolean
+check_known (void)
+{
+  /* coord, factor, base, offset, expected */
+  static const gint cases[][5] = {
+    {5, 1, 10, 0, 12}, {7, 1, 0, 0, 4}, {3, 1, 0, 0, 2}, {1, 1, 0, 0, 0},
+    {100, 4, 7, -3, 204}, {10, 4, 0, -100, 0}, {10, 4, 0, 100, 120},
+    {0, 4, -20, 0, -20}, {3, 4, 1, -10, 0}
+  };
+  guint num = G_N_ELEMENTS (cases), i, failed = 0;
+  CheckBatch batch;
+
+  check_batch_init (&batch, num);
+  for (i = 0; i < num; i++) {
+    batch.coord[i] = cases[i][0];
+    /* 1 is a factor of 0.5, 4 of 2, so halves are exact */
+    batch.factor[i] = cases[i][1] == 1 ? 0.5f : 2.0f;
+    batch.base[i] = cases[i][2];
+    batch.offset[i] = cases[i][3];
+  }
+
+  vvas_xinfer_project_scalar (batch.coord, batch.factor, batch.base,
+      batch.offset, batch.ref, num);
+  vvas_xinfer_project (batch.coord, batch.factor, batch.base, batch.offset,
+      batch.out, num);
+
+  for (i = 0; i < num; i++) {
+    if (batch.ref[i] != cases[i][4] || batch.out[i] != cases[i][4]) {
+      g_printerr ("known %u: expected %d, scalar %d, %s %d\n", i,
+          cases[i][4], batch.ref[i], vvas_xinfer_project_impl (),
+          batch.out[i]);
+      failed++;
+    }
+  }
+  check_batch_clear (&batch);
+
+  printf ("{\"benchmark\": \"infer-project\", \"case\": \"known\", "
+      "\"values\": %u, \"status\": \"%s\"}\n", num, failed ? "failed" : "ok");
+
+  return !failed;
+}
+
+/**
+ *  @fn static gboolean check_random (void)
+ *  @return TRUE when both paths are bit exact
+ *  @brief  Compares both paths on random batches of every length
+ */
+static gboolean
+check_random (void)
+{
+  GRand *rand = g_rand_new_with_seed (0x1f3);
+  guint len, round, i, checked = 0, mismatches = 0;
+  CheckBatch batch;
+
+  check_batch_init (&batch, CHECK_MAX_LEN);
+
+  for (round = 0; round < CHECK_ROUNDS; round++) {
+    for (len = 1; len <= CHECK_MAX_LEN; len += 1 + round % 5) {
+      check_batch_fill (&batch, len, rand);
+      vvas_xinfer_project_scalar (batch.coord, batch.factor, batch.base,
+          batch.offset, batch.ref, len);
+      vvas_xinfer_project (batch.coord, batch.factor, batch.base,
+          batch.offset, batch.out, len);
+
+      for (i = 0; i < len; i++, checked++) {
+        if (batch.ref[i] == batch.out[i])
+          continue;
+        if (!mismatches)
+          g_printerr ("%g * %g + %d + %d: scalar %d, %s %d\n",
+              batch.coord[i], batch.factor[i], batch.base[i],
+              batch.offset[i], batch.ref[i], vvas_xinfer_project_impl (),
+              batch.out[i]);
+        mismatches++;
+      }
+    }
+  }
+
+  check_batch_clear (&batch);
+  g_rand_free (rand);
+
+  printf ("{\"benchmark\": \"infer-project\", \"case\": \"random\", "
+      "\"impl\": \"%s\", \"coordinates\": %u, \"mismatches\": %u, "
+      "\"status\": \"%s\"}\n", vvas_xinfer_project_impl (), checked,
+      mismatches, mismatches ? "failed" : "ok");
+
+  return !mismatches;
+}
+
+/**
+ *  @fn static void bench_project (void)
+ *  @return None
+ *  @brief  Times both paths on one large batch
+ */
+static void
+bench_project (void)
+{
+  GRand *rand = g_rand_new_with_seed (0x1f4);
+  gint64 start, scalar_us = 0, simd_us = 0;
+  CheckBatch batch;
+  guint i;
+
+  check_batch_init (&batch, BENCH_LEN);
+  check_batch_fill (&batch, BENCH_LEN, rand);
+
+  for (i = 0; i < BENCH_ITERATIONS; i++) {
+    start = g_get_monotonic_time ();
+    vvas_xinfer_project_scalar (batch.coord, batch.factor, batch.base,
+        batch.offset, batch.ref, BENCH_LEN);
+    scalar_us += g_get_monotonic_time () - start;
+
+    start = g_get_monotonic_time ();
+    vvas_xinfer_project (batch.coord, batch.factor, batch.base, batch.offset,
+        batch.out, BENCH_LEN);
+    simd_us += g_get_monotonic_time () - start;
+  }
+
+  printf ("{\"benchmark\": \"infer-project\", \"case\": \"bench\", "
+      "\"impl\": \"%s\", \"coordinates\": %u, \"scalar_us\": %.2f, "
+      "\"simd_us\": %.2f, \"speedup\": %.2f}\n", vvas_xinfer_project_impl (),
+      BENCH_LEN, (gdouble) scalar_us / BENCH_ITERATIONS,
+      (gdouble) simd_us / BENCH_ITERATIONS,
+      simd_us ? (gdouble) scalar_us / simd_us : 0.0);
+
+  check_batch_clear (&batch);
+  g_rand_free (rand);
+}
+
+int
+main (int argc, char *argv[])
+{
+  guint failed = 0;
+
+  /* Only timed when run as a benchmark */
+  if (argc > 1 && !g_strcmp0 (argv[1], "--bench")) {
+    bench_project ();
+    return 0;
+  }
+
+  failed += !check_known ();
+  failed += !check_random ();
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * Functional check of vvas_xmetaaffixer interpolate=linear. A 10 fps master
+ * stream carries one detection moving at constant speed, a 60 fps slave
+ * stream carries none. Both are fed through appsrc and the bounding box
+ * attached to every slave frame is compared with the linear interpolation
+ * of the two master frames around the middle of the slave frame.
+ */
+
+#include <stdio.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+#include <gst/app/gstappsink.h>
+#include <gst/vvas/gstinferencemeta.h>
+
+/* Exit code meson reports as skipped */
+#define CHECK_EXIT_SKIP 77
+
+#define CHECK_MASTER_FPS 10
+#define CHECK_SLAVE_FPS 60
+#define CHECK_MASTER_FRAMES 5
+#define CHECK_SLAVE_FRAMES \
+  (CHECK_MASTER_FRAMES * CHECK_SLAVE_FPS / CHECK_MASTER_FPS)
+#define CHECK_SIZE 64
+
+/**
+ *  @fn static void check_master_bbox (guint n, VvasBoundingBox * bbox)
+ *  @param [in] n - Master frame number
+ *  @param [out] bbox - Bounding box of the detection in frame \p n
+ *  @return None
+ *  @brief  Detection moves right and grows at constant speed
+ */
+static void
+check_master_bbox (guint n, VvasBoundingBox * bbox)
+{
+  bbox->x = 2 + 10 * n;
+  bbox->y = 4;
+  bbox->width = 6 + 2 * n;
+  bbox->height = 8;
+}
+
+/**
+ *  @fn static gint check_lerp (gint from, gint to, gdouble alpha)
+ *  @param [in] from - Value at alpha 0
+ *  @param [in] to - Value at alpha 1
+ *  @param [in] alpha - Position between both values
+ *  @return Rounded linear interpolation
+ */
+static gint
+check_lerp (gint from, gint to, gdouble alpha)
+{
+  gdouble val = from + (to - from) * alpha;
+
+  return (gint) (val < 0 ? val - 0.5 : val + 0.5);
+}
+
+/**
+ *  @fn static GstBuffer * check_make_buffer (guint n, guint fps,
+ *                                            GstInferencePrediction * det)
+ *  @param [in] n - Frame number
+ *  @param [in] fps - Frame rate of the stream
+ *  @param [in] det - Detection to attach, NULL for none
+ *  @return New GRAY8 frame
+ */
+static GstBuffer *
+check_make_buffer (guint n, guint fps, GstInferencePrediction * det)
+{
+  GstBuffer *buf = gst_buffer_new_allocate (NULL, CHECK_SIZE * CHECK_SIZE,
+      NULL);
+  GstClockTime pts = gst_util_uint64_scale (n, GST_SECOND, fps);
+
+  gst_buffer_memset (buf, 0, 0x80, CHECK_SIZE * CHECK_SIZE);
+  GST_BUFFER_PTS (buf) = pts;
+  GST_BUFFER_DURATION (buf) =
+      gst_util_uint64_scale (n + 1, GST_SECOND, fps) - pts;
+
+  if (det) {
+    GstInferenceMeta *meta = (GstInferenceMeta *) gst_buffer_add_meta (buf,
+        gst_inference_meta_get_info (), NULL);
+
+    meta->prediction->prediction.bbox.width = CHECK_SIZE;
+    meta->prediction->prediction.bbox.height = CHECK_SIZE;
+    gst_inference_prediction_append (meta->prediction, det);
+  }
+
+  return buf;
+}
+
+/**
+ *  @fn static gboolean check_frame (GstBuffer * buf, guint n, guint64 id,
+ *                                   gint * error)
+ *  @param [in] buf - Slave output buffer
+ *  @param [in] n - Slave frame number
+ *  @param [in] id - prediction_id of the detection
+ *  @param [out] error - Largest coordinate error of this frame
+ *  @return FALSE if the detection is missing
+ */
+static gboolean
+check_frame (GstBuffer * buf, guint n, guint64 id, gint * error)
+{
+  GstInferenceMeta *meta = (GstInferenceMeta *) gst_buffer_get_meta (buf,
+      gst_inference_meta_api_get_type ());
+  GstClockTime mid = GST_BUFFER_PTS (buf) + GST_BUFFER_DURATION (buf) / 2;
+  GstClockTime period = GST_SECOND / CHECK_MASTER_FPS;
+  guint k = MIN (mid / period, CHECK_MASTER_FRAMES - 1);
+  VvasBoundingBox from, to, *got;
+  GstInferencePrediction *det;
+  gdouble alpha = 0.0;
+  gint x, width;
+
+  if (!meta)
+    return FALSE;
+  det = gst_inference_prediction_find (meta->prediction, id);
+  if (!det)
+    return FALSE;
+
+  check_master_bbox (k, &from);
+  check_master_bbox (MIN (k + 1, CHECK_MASTER_FRAMES - 1), &to);
+  /* No master frame follows the last one, its box is kept as is */
+  if (k + 1 < CHECK_MASTER_FRAMES)
+    alpha = (gdouble) (mid - k * period) / period;
+
+  x = check_lerp (from.x, to.x, alpha);
+  width = check_lerp (from.width, to.width, alpha);
+  got = &det->prediction.bbox;
+  *error = MAX (ABS (got->x - x), ABS ((gint) got->width - width));
+  *error = MAX (*error, ABS (got->y - from.y));
+
+  if (*error > 1)
+    g_printerr ("slave frame %u: got x %d width %u, expected x %d width %d\n",
+        n, got->x, got->width, x, width);
+
+  gst_inference_prediction_unref (det);
+
+  return TRUE;
+}
+
+int
+main (int argc, char *argv[])
+{
+  GstElement *pipeline, *master, *slave, *sink;
+  GstInferencePrediction *det = NULL;
+  GError *error = NULL;
+  GstCaps *caps;
+  guint64 id;
+  guint n, checked = 0, missing = 0;
+  gint max_error = 0;
+  gboolean ok;
+
+  gst_init (&argc, &argv);
+
+  pipeline = gst_parse_launch ("vvas_xmetaaffixer name=ma interpolate=linear "
+      "timeout=-1 appsrc name=master format=time ! ma.sink_master "
+      "ma.src_master ! fakesink sync=false appsrc name=slave format=time ! "
+      "ma.sink_slave_0 ma.src_slave_0 ! appsink name=out sync=false", &error);
+  if (!pipeline) {
+    g_printerr ("%s\n", error->message);
+    g_clear_error (&error);
+    return CHECK_EXIT_SKIP;
+  }
+
+  master = gst_bin_get_by_name (GST_BIN (pipeline), "master");
+  slave = gst_bin_get_by_name (GST_BIN (pipeline), "slave");
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "out");
+
+  caps = gst_caps_new_simple ("video/x-raw", "format", G_TYPE_STRING, "GRAY8",
+      "width", G_TYPE_INT, CHECK_SIZE, "height", G_TYPE_INT, CHECK_SIZE,
+      "framerate", GST_TYPE_FRACTION, CHECK_MASTER_FPS, 1, NULL);
+  gst_app_src_set_caps (GST_APP_SRC (master), caps);
+  gst_caps_set_simple (caps, "framerate", GST_TYPE_FRACTION, CHECK_SLAVE_FPS,
+      1, NULL);
+  gst_app_src_set_caps (GST_APP_SRC (slave), caps);
+  gst_caps_unref (caps);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  for (n = 0; n < CHECK_MASTER_FRAMES; n++) {
+    /* Same detection tracked in all frames, copies keep its prediction_id */
+    GstInferencePrediction *pred = det ? gst_inference_prediction_copy (det) :
+        gst_inference_prediction_new ();
+
+    check_master_bbox (n, &pred->prediction.bbox);
+    if (!det)
+      det = gst_inference_prediction_ref (pred);
+    gst_app_src_push_buffer (GST_APP_SRC (master),
+        check_make_buffer (n, CHECK_MASTER_FPS, pred));
+  }
+  gst_app_src_end_of_stream (GST_APP_SRC (master));
+  id = det->prediction.prediction_id;
+  gst_inference_prediction_unref (det);
+
+  for (n = 0; n < CHECK_SLAVE_FRAMES; n++)
+    gst_app_src_push_buffer (GST_APP_SRC (slave),
+        check_make_buffer (n, CHECK_SLAVE_FPS, NULL));
+  gst_app_src_end_of_stream (GST_APP_SRC (slave));
+
+  for (n = 0; n < CHECK_SLAVE_FRAMES; n++) {
+    GstSample *sample = gst_app_sink_try_pull_sample (GST_APP_SINK (sink),
+        10 * GST_SECOND);
+    gint frame_error = 0;
+
+    if (!sample)
+      break;
+
+    /* First slave frame is sent ahead of sync to complete preroll */
+    if (n) {
+      if (check_frame (gst_sample_get_buffer (sample), n, id, &frame_error)) {
+        max_error = MAX (max_error, frame_error);
+        checked++;
+      } else {
+        g_printerr ("slave frame %u: detection missing\n", n);
+        missing++;
+      }
+    }
+    gst_sample_unref (sample);
+  }
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (master);
+  gst_object_unref (slave);
+  gst_object_unref (sink);
+  gst_object_unref (pipeline);
+
+  ok = checked == CHECK_SLAVE_FRAMES - 1 && !missing && max_error <= 1;
+  printf ("{\"benchmark\": \"metaaffixer-interpolate\", \"element\": "
+      "\"vvas_xmetaaffixer\", \"status\": \"%s\", \"frames\": %u, "
+      "\"checked\": %u, \"missing\": %u, \"max_error\": %d}\n",
+      ok ? "ok" : "failed", CHECK_SLAVE_FRAMES, checked, missing, max_error);
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+
+/*
+ * Functional check of meta data attachment in vvas_xmetaaffixer. Every slave
+ * frame pushed through appsrc stays referenced by the check, as a tee or a
+ * second consumer would do, and the memory of every other frame is flagged
+ * not shareable. The element must attach the master meta data without
+ * duplicating shareable frame memory: those slave output buffers have to
+ * carry the very GstMemory of their input buffer. Memory flagged
+ * GST_MEMORY_FLAG_NO_SHARE must never end up in a second buffer.
+ */
+
+#include <stdio.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+#include <gst/app/gstappsink.h>
+#include <gst/vvas/gstinferencemeta.h>
+
+/* Exit code meson reports as skipped */
+#define CHECK_EXIT_SKIP 77
+
+#define CHECK_FPS 30
+#define CHECK_FRAMES 30
+#define CHECK_SIZE 64
+#define CHECK_FILL 0x80
+
+/* Head of every frame, compared after attachment */
+static const guint8 check_pattern[16] = {
+  CHECK_FILL, CHECK_FILL, CHECK_FILL, CHECK_FILL, CHECK_FILL, CHECK_FILL,
+  CHECK_FILL, CHECK_FILL, CHECK_FILL, CHECK_FILL, CHECK_FILL, CHECK_FILL,
+  CHECK_FILL, CHECK_FILL, CHECK_FILL, CHECK_FILL
+};
+
+/**
+ *  @fn static gboolean check_no_share (guint n)
+ *  @param [in] n - Frame number
+ *  @return TRUE when the memory of slave frame \p n is flagged not shareable
+ */
+static gboolean
+check_no_share (guint n)
+{
+  return !(n & 1);
+}
+
+/**
+ *  @fn static GstBuffer * check_make_buffer (guint n, gboolean detection,
+ *                                            gboolean no_share)
+ *  @param [in] n - Frame number
+ *  @param [in] detection - Attach one detection when TRUE
+ *  @param [in] no_share - Flag the frame memory not shareable when TRUE
+ *  @return New GRAY8 frame
+ */
+static GstBuffer *
+check_make_buffer (guint n, gboolean detection, gboolean no_share)
+{
+  GstBuffer *buf = gst_buffer_new_allocate (NULL, CHECK_SIZE * CHECK_SIZE,
+      NULL);
+  GstClockTime pts = gst_util_uint64_scale (n, GST_SECOND, CHECK_FPS);
+
+  gst_buffer_memset (buf, 0, CHECK_FILL, CHECK_SIZE * CHECK_SIZE);
+  /* Like memory of devices which can't be sub-allocated, a writable copy of
+   * this buffer needs a copy of its memory */
+  if (no_share)
+    GST_MINI_OBJECT_FLAG_SET (gst_buffer_peek_memory (buf, 0),
+        GST_MEMORY_FLAG_NO_SHARE);
+  GST_BUFFER_PTS (buf) = pts;
+  GST_BUFFER_DURATION (buf) =
+      gst_util_uint64_scale (n + 1, GST_SECOND, CHECK_FPS) - pts;
+
+  if (detection) {
+    GstInferenceMeta *meta = (GstInferenceMeta *) gst_buffer_add_meta (buf,
+        gst_inference_meta_get_info (), NULL);
+    GstInferencePrediction *det = gst_inference_prediction_new ();
+
+    meta->prediction->prediction.bbox.width = CHECK_SIZE;
+    meta->prediction->prediction.bbox.height = CHECK_SIZE;
+    det->prediction.bbox.x = n;
+    det->prediction.bbox.y = 4;
+    det->prediction.bbox.width = 16;
+    det->prediction.bbox.height = 16;
+    gst_inference_prediction_append (meta->prediction, det);
+  }
+
+  return buf;
+}
+
+int
+main (int argc, char *argv[])
+{
+  GstElement *pipeline, *affixer, *master, *slave, *sink;
+  GstBuffer *inputs[CHECK_FRAMES];
+  GstStructure *stats = NULL;
+  GError *error = NULL;
+  GstCaps *caps;
+  guint64 shared = 0, copied = 0;
+  guint n, pulled = 0, with_meta = 0, duplicated = 0, leaked = 0;
+  guint n_no_share = 0;
+  gboolean ok;
+
+  gst_init (&argc, &argv);
+
+  pipeline = gst_parse_launch ("vvas_xmetaaffixer name=ma timeout=-1 "
+      "appsrc name=master format=time ! ma.sink_master "
+      "ma.src_master ! fakesink sync=false appsrc name=slave format=time ! "
+      "ma.sink_slave_0 ma.src_slave_0 ! appsink name=out sync=false", &error);
+  if (!pipeline) {
+    g_printerr ("%s\n", error->message);
+    g_clear_error (&error);
+    return CHECK_EXIT_SKIP;
+  }
+
+  affixer = gst_bin_get_by_name (GST_BIN (pipeline), "ma");
+  master = gst_bin_get_by_name (GST_BIN (pipeline), "master");
+  slave = gst_bin_get_by_name (GST_BIN (pipeline), "slave");
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "out");
+
+  caps = gst_caps_new_simple ("video/x-raw", "format", G_TYPE_STRING, "GRAY8",
+      "width", G_TYPE_INT, CHECK_SIZE, "height", G_TYPE_INT, CHECK_SIZE,
+      "framerate", GST_TYPE_FRACTION, CHECK_FPS, 1, NULL);
+  gst_app_src_set_caps (GST_APP_SRC (master), caps);
+  gst_app_src_set_caps (GST_APP_SRC (slave), caps);
+  gst_caps_unref (caps);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  for (n = 0; n < CHECK_FRAMES; n++)
+    gst_app_src_push_buffer (GST_APP_SRC (master), check_make_buffer (n,
+            TRUE, FALSE));
+  gst_app_src_end_of_stream (GST_APP_SRC (master));
+
+  /* Extra reference keeps every slave buffer not writable in the element */
+  for (n = 0; n < CHECK_FRAMES; n++) {
+    inputs[n] = check_make_buffer (n, FALSE, check_no_share (n));
+    if (check_no_share (n))
+      n_no_share++;
+    gst_app_src_push_buffer (GST_APP_SRC (slave), gst_buffer_ref (inputs[n]));
+  }
+  gst_app_src_end_of_stream (GST_APP_SRC (slave));
+
+  for (n = 0; n < CHECK_FRAMES; n++) {
+    GstSample *sample = gst_app_sink_try_pull_sample (GST_APP_SINK (sink),
+        10 * GST_SECOND);
+    GstBuffer *buf;
+    gboolean same;
+    guint idx;
+
+    if (!sample)
+      break;
+
+    buf = gst_sample_get_buffer (sample);
+    idx = gst_util_uint64_scale_round (GST_BUFFER_PTS (buf), CHECK_FPS,
+        GST_SECOND);
+    pulled++;
+
+    if (idx >= CHECK_FRAMES || gst_buffer_n_memory (buf) != 1) {
+      g_printerr ("slave frame %u: unexpected output buffer\n", idx);
+      duplicated++;
+      gst_sample_unref (sample);
+      continue;
+    }
+
+    same = gst_buffer_peek_memory (buf, 0) ==
+        gst_buffer_peek_memory (inputs[idx], 0);
+    if (check_no_share (idx) && same) {
+      g_printerr ("slave frame %u: not shareable memory was shared\n", idx);
+      leaked++;
+    } else if (!check_no_share (idx) && !same) {
+      g_printerr ("slave frame %u: memory not shared with the input\n", idx);
+      duplicated++;
+    }
+    if (gst_buffer_memcmp (buf, 0, check_pattern, sizeof (check_pattern))) {
+      g_printerr ("slave frame %u: frame content changed\n", idx);
+      duplicated++;
+    }
+    if (gst_buffer_get_meta (buf, gst_inference_meta_api_get_type ()))
+      with_meta++;
+
+    gst_sample_unref (sample);
+  }
+
+  g_object_get (affixer, "attach-stats", &stats, NULL);
+  if (stats) {
+    gst_structure_get_uint64 (stats, "shared", &shared);
+    gst_structure_get_uint64 (stats, "copied", &copied);
+    gst_structure_free (stats);
+  }
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  for (n = 0; n < CHECK_FRAMES; n++)
+    gst_buffer_unref (inputs[n]);
+  gst_object_unref (affixer);
+  gst_object_unref (master);
+  gst_object_unref (slave);
+  gst_object_unref (sink);
+  gst_object_unref (pipeline);
+
+  /* The first slave frame completes preroll ahead of the master meta data */
+  ok = pulled == CHECK_FRAMES && !duplicated && !leaked
+      && with_meta >= CHECK_FRAMES - 1
+      && shared + 1 >= CHECK_FRAMES - n_no_share && copied + 1 >= n_no_share
+      && shared + copied >= with_meta;
+  printf ("{\"benchmark\": \"metaaffixer-zero-copy\", \"element\": "
+      "\"vvas_xmetaaffixer\", \"status\": \"%s\", \"frames\": %u, "
+      "\"no_share\": %u, \"pulled\": %u, \"with_meta\": %u, "
+      "\"duplicated\": %u, \"leaked\": %u, \"shared\": %"
+      G_GUINT64_FORMAT ", \"copied\": %" G_GUINT64_FORMAT "}\n",
+      ok ? "ok" : "failed", CHECK_FRAMES, n_no_share, pulled, with_meta,
+      duplicated, leaked, shared, copied);
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,541 @@
+/*
+ * Copyright (C) 2022-2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software
+ * is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL XILINX BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. Except as contained in this notice, the name of the Xilinx shall
+ * not be used in advertising or otherwise to promote the sale, use or other
+ * dealings in this Software without prior written authorization from Xilinx.
+ */
+
+/*
+ * Functional check of the vvas_xstereo block matching. Stereo pairs are
+ * synthesized from random texture: the right frame is the left one shifted
+ * by a known disparity, per pixel, with an object in front of the
+ * background. The incremental matcher must give the same disparity map as a
+ * brute force SAD over every window, the disparity of shifted frames and the
+ * median disparity of the object and background boxes must be the shifts,
+ * half pixel shifts must be found within a quarter pixel, textureless frames
+ * must have no disparity and matching in bands, as the element threads do,
+ * must equal a single pass. With --bench, prefilter and matching are timed
+ * on 720p instead.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <glib.h>
+#include "vvas_xstereo_bm.h"
+
+/* Disparity units per pixel */
+#define CHECK_ONE (1 << VVAS_XSTEREO_BM_DISP_SHIFT)
+/* Share of the matchable pixels of a shifted pair within half a pixel of the
+ * shift, subpixel refinement moves whole pixel matches a little */
+#define CHECK_MIN_EXACT 0.98
+/* Error allowed on half pixel shifts, in disparity units */
+#define CHECK_SUBPIXEL_ERROR (CHECK_ONE / 4)
+#define CHECK_BANDS 5
+#define BENCH_WIDTH 1280
+#define BENCH_HEIGHT 720
+#define BENCH_ITERATIONS 5
+
+/**
+ *  @brief Synthetic stereo pair
+ */
+typedef struct
+{
+  /** Frame width */
+  guint width;
+  /** Frame height */
+  guint height;
+  /** Left frame */
+  guint8 *left;
+  /** Right frame */
+  guint8 *right;
+} CheckPair;
+
+/**
+ *  @fn static guint8 check_texture (gint x, gint y, guint seed)
+ *  @param [in] x - Column, may lie outside the frame
+ *  @param [in] y - Line
+ *  @param [in] seed - Texture
+ *  @return Random but reproducible value of the texture at \p x, \p y
+ */
+static guint8
+check_texture (gint x, gint y, guint seed)
+{
+  guint32 h = (guint32) x * 0x9e3779b1u ^ (guint32) y * 0x85ebca77u ^
+      seed * 0xc2b2ae3du;
+
+  h ^= h >> 15;
+  h *= 0x2c1b3c6du;
+  h ^= h >> 12;
+  h *= 0x297a2d39u;
+  h ^= h >> 15;
+
+  return h >> 24;
+}
+
+/**
+ *  @fn static void check_pair_init (CheckPair * pair, guint width,
+ *                                   guint height, guint bg_disp,
+ *                                   guint obj_disp, const gint * obj)
+ *  @param [out] pair - Pair to synthesize
+ *  @param [in] width - Frame width
+ *  @param [in] height - Frame height
+ *  @param [in] bg_disp - Disparity of the background, in disparity units
+ *                        so that half pixels can be tested
+ *  @param [in] obj_disp - Disparity of the object, in whole pixels
+ *  @param [in] obj - Object box in the left frame, x, y, w, h, or NULL
+ *  @return None
+ *  @brief  Left pixel x, y shows the scene point the right frame shows at
+ *          x - disparity. Fractional background disparities average the
+ *          two nearest texture columns.
+ */
+static void
+check_pair_init (CheckPair * pair, guint width, guint height, guint bg_disp,
+    guint obj_disp, const gint * obj)
+{
+  guint x, y;
+
+  pair->width = width;
+  pair->height = height;
+  pair->left = g_new (guint8, (gsize) width * height);
+  pair->right = g_new (guint8, (gsize) width * height);
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x++) {
+      gint bx = x + bg_disp / CHECK_ONE;
+      guint frac = bg_disp % CHECK_ONE;
+      gint ox = x + obj_disp;
+      guint8 *l = &pair->left[(gsize) y * width + x];
+      guint8 *r = &pair->right[(gsize) y * width + x];
+
+      *l = check_texture (x, y, 1);
+      *r = (check_texture (bx, y, 1) * (CHECK_ONE - frac) +
+          check_texture (bx + 1, y, 1) * frac + CHECK_ONE / 2) / CHECK_ONE;
+
+      if (obj && (gint) x >= obj[0] && (gint) x < obj[0] + obj[2] &&
+          (gint) y >= obj[1] && (gint) y < obj[1] + obj[3])
+        *l = check_texture (x, y, 2);
+      if (obj && ox >= obj[0] && ox < obj[0] + obj[2] &&
+          (gint) y >= obj[1] && (gint) y < obj[1] + obj[3])
+        *r = check_texture (ox, y, 2);
+    }
+  }
+}
+
+/**
+ *  @fn static void check_pair_clear (CheckPair * pair)
+ *  @param [in] pair - Pair to free
+ *  @return None
+ */
+static void
+check_pair_clear (CheckPair * pair)
+{
+  g_free (pair->left);
+  g_free (pair->right);
+}
+
+/**
+ *  @fn static gint16 * check_disparity (const VvasXStereoBMParams * params,
+ *                                       const CheckPair * pair, guint bands)
+ *  @param [in] params - Matching parameters
+ *  @param [in] pair - Stereo pair
+ *  @param [in] bands - Number of bands to match in
+ *  @return Disparity map, free with g_free()
+ */
+static gint16 *
+check_disparity (const VvasXStereoBMParams * params, const CheckPair * pair,
+    guint bands)
+{
+  gsize size = (gsize) pair->width * pair->height;
+  guint8 *left = g_new (guint8, size);
+  guint8 *right = g_new (guint8, size);
+  gint16 *disp = g_new (gint16, size);
+  gpointer scratch =
+      g_malloc (vvas_xstereo_bm_scratch_size (params, pair->width));
+  guint b, first = 0;
+
+  vvas_xstereo_bm_prefilter (pair->left, pair->width, pair->width,
+      pair->height, params->prefilter_cap, left, 0, pair->height);
+  vvas_xstereo_bm_prefilter (pair->right, pair->width, pair->width,
+      pair->height, params->prefilter_cap, right, 0, pair->height);
+
+  for (b = 0; b < bands; b++) {
+    guint last = (b + 1) * pair->height / bands;
+
+    vvas_xstereo_bm_match (params, left, right, pair->width, pair->height,
+        disp, first, last - first, scratch);
+    first = last;
+  }
+
+  g_free (scratch);
+  g_free (right);
+  g_free (left);
+
+  return disp;
+}
+
+/**
+ *  @fn static gint16 check_reference_pixel (const VvasXStereoBMParams * params,
+ *                                           const guint8 * left,
+ *                                           const guint8 * right, guint width,
+ *                                           guint x, guint y)
+ *  @param [in] params - Matching parameters
+ *  @param [in] left - Prefiltered left frame
+ *  @param [in] right - Prefiltered right frame
+ *  @param [in] width - Frame width
+ *  @param [in] x - Column with a full window at every disparity
+ *  @param [in] y - Line with a full window
+ *  @return Disparity of \p x, \p y from SADs summed over every window
+ */
+static gint16
+check_reference_pixel (const VvasXStereoBMParams * params,
+    const guint8 * left, const guint8 * right, guint width, guint x, guint y)
+{
+  const gint r = params->sad_window / 2;
+  const guint nd = params->num_disparities;
+  guint sad[VVAS_XSTEREO_BM_MAX_DISPARITIES] = { 0 };
+  guint texture = 0, min = G_MAXINT, best = 0, d;
+  gint i, j, p, n, den, val;
+
+  for (j = -r; j <= r; j++)
+    for (i = -r; i <= r; i++)
+      texture += ABS (left[(gsize) (y + j) * width + x + i] -
+          (gint) params->prefilter_cap);
+
+  for (d = 0; d < nd; d++) {
+    sad[d] = 0;
+    for (j = -r; j <= r; j++)
+      for (i = -r; i <= r; i++)
+        sad[d] += ABS (left[(gsize) (y + j) * width + x + i] -
+            right[(gsize) (y + j) * width + x + i - d]);
+    if (sad[d] < min) {
+      min = sad[d];
+      best = d;
+    }
+  }
+
+  if (texture < params->texture_threshold)
+    return VVAS_XSTEREO_BM_FILTERED;
+
+  if (params->uniqueness_ratio) {
+    guint thresh = min + min * params->uniqueness_ratio / 100;
+
+    for (d = 0; d < nd; d++)
+      if (sad[d] <= thresh && (d + 1 < best || d > best + 1))
+        return VVAS_XSTEREO_BM_FILTERED;
+  }
+
+  p = sad[best ? best - 1 : best + 1];
+  n = sad[best + 1 < nd ? best + 1 : best - 1];
+  den = p + n - 2 * (gint) min + ABS (p - n);
+  val = best * 256 + (den ? (p - n) * 256 / den : 0) + 15;
+
+  return MAX (val, 0) >> (8 - VVAS_XSTEREO_BM_DISP_SHIFT);
+}
+
+/**
+ *  @fn static gboolean check_reference (guint sad_window, guint nd,
+ *                                       guint texture, guint uniqueness)
+ *  @param [in] sad_window - SAD window
+ *  @param [in] nd - Number of disparities
+ *  @param [in] texture - Texture threshold
+ *  @param [in] uniqueness - Uniqueness ratio
+ *  @return TRUE if the matcher gives the brute force disparity map
+ */
+static gboolean
+check_reference (guint sad_window, guint nd, guint texture, guint uniqueness)
+{
+  const gint obj[4] = { 70, 10, 30, 30 };
+  VvasXStereoBMParams params;
+  CheckPair pair;
+  guint8 *left, *right;
+  gint16 *disp;
+  guint x, y, r = sad_window / 2, mismatches = 0, valid = 0;
+  gboolean ok;
+
+  vvas_xstereo_bm_params_init (&params);
+  params.sad_window = sad_window;
+  params.num_disparities = nd;
+  params.texture_threshold = texture;
+  params.uniqueness_ratio = uniqueness;
+
+  check_pair_init (&pair, nd + 120, 64, 5 * CHECK_ONE, 11, obj);
+  disp = check_disparity (&params, &pair, 1);
+
+  left = g_new (guint8, pair.width * pair.height);
+  right = g_new (guint8, pair.width * pair.height);
+  vvas_xstereo_bm_prefilter (pair.left, pair.width, pair.width, pair.height,
+      params.prefilter_cap, left, 0, pair.height);
+  vvas_xstereo_bm_prefilter (pair.right, pair.width, pair.width, pair.height,
+      params.prefilter_cap, right, 0, pair.height);
+
+  for (y = 0; y < pair.height; y++) {
+    for (x = 0; x < pair.width; x++) {
+      gint16 expected = VVAS_XSTEREO_BM_FILTERED;
+
+      if (y >= r && y + r < pair.height && x >= nd - 1 + r &&
+          x + r < pair.width)
+        expected = check_reference_pixel (&params, left, right, pair.width,
+            x, y);
+      valid += expected != VVAS_XSTEREO_BM_FILTERED;
+      if (disp[y * pair.width + x] != expected) {
+        if (!mismatches)
+          g_printerr ("reference: %u,%u is %d, expected %d\n", x, y,
+              disp[y * pair.width + x], expected);
+        mismatches++;
+      }
+    }
+  }
+
+  ok = !mismatches && valid;
+  printf ("{\"benchmark\": \"stereo\", \"case\": \"reference\", "
+      "\"sad_window\": %u, \"num_disparities\": %u, \"texture\": %u, "
+      "\"uniqueness\": %u, \"valid_pixels\": %u, \"mismatches\": %u, "
+      "\"status\": \"%s\"}\n", sad_window, nd, texture, uniqueness, valid,
+      mismatches, ok ? "ok" : "failed");
+
+  g_free (right);
+  g_free (left);
+  g_free (disp);
+  check_pair_clear (&pair);
+
+  return ok;
+}
+
+/**
+ *  @fn static gboolean check_shift (guint disparity)
+ *  @param [in] disparity - Shift between the frames, in disparity units
+ *  @return TRUE if matchable pixels get the shift within half a pixel and
+ *          their median is exactly a whole pixel shift or within
+ *          CHECK_SUBPIXEL_ERROR of a fractional one
+ */
+static gboolean
+check_shift (guint disparity)
+{
+  VvasXStereoBMParams params;
+  CheckPair pair;
+  gint16 *disp;
+  guint32 hist[64 << VVAS_XSTEREO_BM_DISP_SHIFT];
+  guint x, y, r, exact = 0, matchable = 0, valid;
+  gint median;
+  gdouble share;
+  gboolean ok;
+
+  vvas_xstereo_bm_params_init (&params);
+  r = params.sad_window / 2;
+  check_pair_init (&pair, 320, 120, disparity, 0, NULL);
+  disp = check_disparity (&params, &pair, 1);
+
+  for (y = r; y + r < pair.height; y++) {
+    for (x = params.num_disparities - 1 + r; x + r < pair.width; x++) {
+      matchable++;
+      exact += ABS (disp[y * pair.width + x] - (gint) disparity) <
+          CHECK_ONE / 2;
+    }
+  }
+  share = (gdouble) exact / matchable;
+  median = vvas_xstereo_bm_median (disp, pair.width, pair.height, 0, 0,
+      pair.width, pair.height, params.num_disparities, hist, &valid);
+
+  if (disparity % CHECK_ONE)
+    ok = ABS (median - (gint) disparity) <= CHECK_SUBPIXEL_ERROR;
+  else
+    ok = share >= CHECK_MIN_EXACT && median == (gint) disparity;
+
+  printf ("{\"benchmark\": \"stereo\", \"case\": \"shift\", "
+      "\"disparity\": %.4f, \"matchable_pixels\": %u, \"exact\": %.4f, "
+      "\"median\": %.4f, \"status\": \"%s\"}\n",
+      (gdouble) disparity / CHECK_ONE, matchable, share,
+      (gdouble) median / CHECK_ONE, ok ? "ok" : "failed");
+
+  g_free (disp);
+  check_pair_clear (&pair);
+
+  return ok;
+}
+
+/**
+ *  @fn static gboolean check_boxes (void)
+ *  @return TRUE if the medians of an object box and a background box are the
+ *          disparities they were synthesized with
+ */
+static gboolean
+check_boxes (void)
+{
+  const gint obj[4] = { 150, 40, 80, 90 };
+  const gint bg[4] = { 260, 20, 50, 60 };
+  const guint bg_disp = 9, obj_disp = 37;
+  VvasXStereoBMParams params;
+  CheckPair pair;
+  gint16 *disp;
+  guint32 hist[64 << VVAS_XSTEREO_BM_DISP_SHIFT];
+  guint obj_valid, bg_valid;
+  gint obj_median, bg_median;
+  gboolean ok;
+
+  vvas_xstereo_bm_params_init (&params);
+  check_pair_init (&pair, 352, 160, bg_disp * CHECK_ONE, obj_disp, obj);
+  disp = check_disparity (&params, &pair, 1);
+
+  obj_median = vvas_xstereo_bm_median (disp, pair.width, pair.height, obj[0],
+      obj[1], obj[2], obj[3], params.num_disparities, hist, &obj_valid);
+  bg_median = vvas_xstereo_bm_median (disp, pair.width, pair.height, bg[0],
+      bg[1], bg[2], bg[3], params.num_disparities, hist, &bg_valid);
+
+  ok = obj_median == (gint) obj_disp * CHECK_ONE &&
+      bg_median == (gint) bg_disp * CHECK_ONE &&
+      obj_valid > (guint) (obj[2] * obj[3] / 2) &&
+      bg_valid > (guint) (bg[2] * bg[3] / 2);
+
+  printf ("{\"benchmark\": \"stereo\", \"case\": \"boxes\", "
+      "\"object_median\": %.4f, \"object_valid\": %u, "
+      "\"background_median\": %.4f, \"background_valid\": %u, "
+      "\"status\": \"%s\"}\n", (gdouble) obj_median / CHECK_ONE, obj_valid,
+      (gdouble) bg_median / CHECK_ONE, bg_valid, ok ? "ok" : "failed");
+
+  g_free (disp);
+  check_pair_clear (&pair);
+
+  return ok;
+}
+
+/**
+ *  @fn static gboolean check_flat (void)
+ *  @return TRUE if a pair without texture has no disparity
+ */
+static gboolean
+check_flat (void)
+{
+  VvasXStereoBMParams params;
+  CheckPair pair;
+  gint16 *disp;
+  guint32 hist[64 << VVAS_XSTEREO_BM_DISP_SHIFT];
+  guint valid;
+  gint median;
+
+  vvas_xstereo_bm_params_init (&params);
+  check_pair_init (&pair, 160, 48, 0, 0, NULL);
+  memset (pair.left, 90, pair.width * pair.height);
+  memset (pair.right, 90, pair.width * pair.height);
+  disp = check_disparity (&params, &pair, 1);
+
+  median = vvas_xstereo_bm_median (disp, pair.width, pair.height, 0, 0,
+      pair.width, pair.height, params.num_disparities, hist, &valid);
+
+  printf ("{\"benchmark\": \"stereo\", \"case\": \"flat\", "
+      "\"valid_pixels\": %u, \"status\": \"%s\"}\n", valid,
+      !valid ? "ok" : "failed");
+
+  g_free (disp);
+  check_pair_clear (&pair);
+
+  return !valid && median == VVAS_XSTEREO_BM_FILTERED;
+}
+
+/**
+ *  @fn static gboolean check_bands (void)
+ *  @return TRUE if matching in CHECK_BANDS bands gives the map of a single
+ *          pass
+ */
+static gboolean
+check_bands (void)
+{
+  const gint obj[4] = { 100, 30, 60, 50 };
+  VvasXStereoBMParams params;
+  CheckPair pair;
+  gint16 *single, *banded;
+  gboolean ok;
+
+  vvas_xstereo_bm_params_init (&params);
+  check_pair_init (&pair, 256, 101, 3 * CHECK_ONE, 20, obj);
+  single = check_disparity (&params, &pair, 1);
+  banded = check_disparity (&params, &pair, CHECK_BANDS);
+
+  ok = !memcmp (single, banded,
+      (gsize) pair.width * pair.height * sizeof (gint16));
+  printf ("{\"benchmark\": \"stereo\", \"case\": \"bands\", \"bands\": %u, "
+      "\"status\": \"%s\"}\n", CHECK_BANDS, ok ? "ok" : "failed");
+
+  g_free (banded);
+  g_free (single);
+  check_pair_clear (&pair);
+
+  return ok;
+}
+
+/**
+ *  @fn static void bench_match (void)
+ *  @return None
+ *  @brief  Times prefilter and matching of a 720p pair on one thread with
+ *          the default parameters
+ */
+static void
+bench_match (void)
+{
+  VvasXStereoBMParams params;
+  CheckPair pair;
+  gint64 start, elapsed = 0;
+  guint i;
+
+  vvas_xstereo_bm_params_init (&params);
+  check_pair_init (&pair, BENCH_WIDTH, BENCH_HEIGHT, 17 * CHECK_ONE, 0, NULL);
+
+  for (i = 0; i < BENCH_ITERATIONS; i++) {
+    gint16 *disp;
+
+    start = g_get_monotonic_time ();
+    disp = check_disparity (&params, &pair, 1);
+    elapsed += g_get_monotonic_time () - start;
+    g_free (disp);
+  }
+
+  printf ("{\"benchmark\": \"stereo\", \"case\": \"bench\", \"width\": %u, "
+      "\"height\": %u, \"sad_window\": %u, \"num_disparities\": %u, "
+      "\"frame_us\": %.2f}\n", BENCH_WIDTH, BENCH_HEIGHT, params.sad_window,
+      params.num_disparities, (gdouble) elapsed / BENCH_ITERATIONS);
+
+  check_pair_clear (&pair);
+}
+
+int
+main (int argc, char *argv[])
+{
+  guint failed = 0;
+
+  g_printerr ("SAD kernels: %s\n", vvas_xstereo_bm_impl ());
+
+  /* Only timed when run as a benchmark */
+  if (argc > 1 && !g_strcmp0 (argv[1], "--bench")) {
+    bench_match ();
+    return 0;
+  }
+
+  failed += !check_reference (5, 16, 0, 0);
+  failed += !check_reference (9, 32, 10, 15);
+  failed += !check_reference (21, 48, 40, 5);
+  failed += !check_shift (0);
+  failed += !check_shift (7 * CHECK_ONE);
+  failed += !check_shift (23 * CHECK_ONE);
+  failed += !check_shift (63 * CHECK_ONE);
+  failed += !check_shift (12 * CHECK_ONE + CHECK_ONE / 2);
+  failed += !check_boxes ();
+  failed += !check_flat ();
+  failed += !check_bands ();
+
+  return failed ? 1 : 0;
+}